@@ -22,7 +22,10 @@
 #include "fdbclient/BlobGranuleFiles.h"
 #include "fdbclient/FDBTypes.h"
 #include "flow/ProtocolVersion.h"
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #define FDB_API_VERSION 730
 #define FDB_INCLUDE_LEGACY_TYPES
 
@@ -230,6 +233,109 @@ extern "C" DLLEXPORT fdb_error_t fdb_future_set_callback(FDBFuture* f,
 	CATCH_AND_RETURN(TSAVB(f)->callOrSetAsCallback(cb, ignore, 0););
 }
 
+// Futures are added to a completion queue as they become ready, so that an application thread can wait for many of them
+// and handle them in bulk instead of being woken once per future. The thread completing a future only signals the
+// queue when it was empty and someone is waiting, so completions arriving while a batch is handled cost no wakeups.
+class CAPICompletionQueue : public ThreadSafeReferenceCounted<CAPICompletionQueue> {
+public:
+	void push(FDBFuture* f, void* userdata) {
+		bool wake;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			wake = completed.empty() && waiters > 0;
+			completed.emplace_back(f, userdata);
+		}
+		if (wake) {
+			ready.notify_one();
+		}
+	}
+
+	// Waits up to timeout seconds (forever if negative) for a future to complete, then takes up to maxCount of them
+	int poll(double timeout, int maxCount, FDBFuture** outFutures, void** outUserdata) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (completed.empty() && timeout != 0) {
+			++waiters;
+			auto hasCompleted = [this]() { return !completed.empty(); };
+			if (timeout < 0) {
+				ready.wait(lock, hasCompleted);
+			} else {
+				ready.wait_for(lock, std::chrono::duration<double>(timeout), hasCompleted);
+			}
+			--waiters;
+		}
+
+		int count = 0;
+		while (count < maxCount && !completed.empty()) {
+			outFutures[count] = completed.front().first;
+			if (outUserdata) {
+				outUserdata[count] = completed.front().second;
+			}
+			completed.pop_front();
+			++count;
+		}
+		if (!completed.empty() && waiters > 0) {
+			ready.notify_one();
+		}
+		return count;
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable ready;
+	std::deque<std::pair<FDBFuture*, void*>> completed;
+	int waiters = 0;
+};
+
+#define COMPLETION_QUEUE(q) ((CAPICompletionQueue*)(q))
+
+class CAPICompletionQueueCallback final : public ThreadCallback {
+public:
+	CAPICompletionQueueCallback(Reference<CAPICompletionQueue> queue, FDBFuture* f, void* userdata)
+	  : queue(queue), f(f), userdata(userdata) {}
+
+	bool canFire(int notMadeActive) const override { return true; }
+	void fire(const Void& unused, int& userParam) override {
+		queue->push(f, userdata);
+		delete this;
+	}
+	void error(const Error&, int& userParam) override {
+		queue->push(f, userdata);
+		delete this;
+	}
+
+private:
+	Reference<CAPICompletionQueue> queue;
+	FDBFuture* f;
+	void* userdata;
+};
+
+extern "C" DLLEXPORT fdb_error_t fdb_create_completion_queue(FDBCompletionQueue** out_queue) {
+	CATCH_AND_RETURN(*out_queue = (FDBCompletionQueue*)new CAPICompletionQueue(););
+}
+
+extern "C" DLLEXPORT void fdb_completion_queue_destroy(FDBCompletionQueue* q) {
+	// Futures that have yet to complete keep the queue alive
+	CATCH_AND_DIE(COMPLETION_QUEUE(q)->delref(););
+}
+
+extern "C" DLLEXPORT fdb_error_t fdb_future_set_completion_queue(FDBFuture* f,
+                                                                 FDBCompletionQueue* q,
+                                                                 void* callback_parameter) {
+	CAPICompletionQueueCallback* cb = new CAPICompletionQueueCallback(
+	    Reference<CAPICompletionQueue>::addRef(COMPLETION_QUEUE(q)), f, callback_parameter);
+	int ignore;
+	CATCH_AND_RETURN(TSAVB(f)->callOrSetAsCallback(cb, ignore, 0););
+}
+
+extern "C" DLLEXPORT fdb_error_t fdb_completion_queue_poll(FDBCompletionQueue* q,
+                                                           double timeout,
+                                                           int max_count,
+                                                           FDBFuture** out_futures,
+                                                           void** out_parameters,
+                                                           int* out_count) {
+	CATCH_AND_RETURN(*out_count = COMPLETION_QUEUE(q)->poll(timeout, max_count, out_futures, out_parameters););
+}
+
 fdb_error_t fdb_future_get_error_impl(FDBFuture* f) {
 	return TSAVB(f)->getErrorCode();
 }
@@ -510,6 +616,29 @@ extern "C" DLLEXPORT FDBResult* fdb_readbg_parse_snapshot_file(const uint8_t* fi
 	                           bgReadSnapshotFile(StringRef(file_data, file_len), tenantPrefix, encryptionCtx);
 	                       return ((FDBResult*)(ThreadResult<RangeResult>(parsedSnapshotData)).extractPtr()););
 }
+extern "C" DLLEXPORT FDBResult* fdb_readbg_parse_snapshot_file_projected(const uint8_t* file_data,
+                                                                         int file_len,
+                                                                         FDBBGTenantPrefix const* tenant_prefix,
+                                                                         FDBBGEncryptionCtx const* encryption_ctx,
+                                                                         uint8_t const* begin_key_name,
+                                                                         int begin_key_name_length,
+                                                                         uint8_t const* end_key_name,
+                                                                         int end_key_name_length,
+                                                                         int const* fields,
+                                                                         int field_count) {
+	RETURN_RESULT_ON_ERROR(
+	    RangeResult, Optional<KeyRef> tenantPrefix; Optional<BlobGranuleCipherKeysCtx> encryptionCtx;
+	    parseGetTenant(tenantPrefix, tenant_prefix);
+	    parseGetEncryptionKeyCtx(encryptionCtx, encryption_ctx);
+	    KeyRangeRef keys(KeyRef(begin_key_name, begin_key_name_length), KeyRef(end_key_name, end_key_name_length));
+	    RangeResult parsedSnapshotData = bgReadSnapshotFileProjected(StringRef(file_data, file_len),
+	                                                                 tenantPrefix,
+	                                                                 encryptionCtx,
+	                                                                 keys,
+	                                                                 std::vector<int>(fields, fields + field_count));
+	    return ((FDBResult*)(ThreadResult<RangeResult>(parsedSnapshotData)).extractPtr()););
+}
+
 extern "C" DLLEXPORT FDBResult* fdb_readbg_parse_delta_file(const uint8_t* file_data,
                                                             int file_len,
                                                             FDBBGTenantPrefix const* tenant_prefix,
@@ -772,6 +901,10 @@ extern "C" DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_statu
 	return (FDBFuture*)(DB(db)->getClientStatus().extractPtr());
 }
 
+extern "C" DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_metrics(FDBDatabase* db) {
+	return (FDBFuture*)(DB(db)->getClientMetrics().extractPtr());
+}
+
 extern "C" DLLEXPORT fdb_error_t fdb_tenant_create_transaction(FDBTenant* tenant, FDBTransaction** out_transaction) {
 	CATCH_AND_RETURN(*out_transaction = (FDBTransaction*)TENANT(tenant)->createTransaction().extractPtr(););
 }
@@ -972,6 +1105,11 @@ FDBFuture* validate_and_update_parameters(int& limit,
 
 		iteration = std::min(iteration, max_iteration);
 		mode_bytes = iteration_progression[iteration - 1];
+	} else if (mode == FDB_STREAMING_MODE_PREFETCH) {
+		/* Sized like _ITERATOR, but the iteration is optional since the
+		   prefetched batches grow on their own */
+		iteration = std::max(std::min(iteration, max_iteration), 1);
+		mode_bytes = iteration_progression[iteration - 1];
 	} else if (mode >= 0 && mode <= FDB_STREAMING_MODE_SERIAL)
 		mode_bytes = mode_bytes_array[mode];
 	else
@@ -1003,12 +1141,14 @@ FDBFuture* fdb_transaction_get_range_impl(FDBTransaction* tr,
 	FDBFuture* r = validate_and_update_parameters(limit, target_bytes, mode, iteration, reverse);
 	if (r != nullptr)
 		return r;
+	GetRangeLimits limits(limit, target_bytes);
+	limits.prefetch = mode == FDB_STREAMING_MODE_PREFETCH;
 	return (
 	    FDBFuture*)(TXN(tr)
 	                    ->getRange(
 	                        KeySelectorRef(KeyRef(begin_key_name, begin_key_name_length), begin_or_equal, begin_offset),
 	                        KeySelectorRef(KeyRef(end_key_name, end_key_name_length), end_or_equal, end_offset),
-	                        GetRangeLimits(limit, target_bytes),
+	                        limits,
 	                        snapshot,
 	                        reverse)
 	                    .extractPtr());
@@ -285,6 +285,21 @@ DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_set_callback(FDBFuture* f,
                                                                  FDBCallback callback,
                                                                  void* callback_parameter);
 
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_create_completion_queue(FDBCompletionQueue** out_queue);
+
+DLLEXPORT void fdb_completion_queue_destroy(FDBCompletionQueue* q);
+
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_set_completion_queue(FDBFuture* f,
+                                                                         FDBCompletionQueue* q,
+                                                                         void* callback_parameter);
+
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_completion_queue_poll(FDBCompletionQueue* q,
+                                                                   double timeout,
+                                                                   int max_count,
+                                                                   FDBFuture** out_futures,
+                                                                   void** out_parameters,
+                                                                   int* out_count);
+
 #if FDB_API_VERSION >= 23
 DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_error(FDBFuture* f);
 #endif
@@ -340,6 +355,20 @@ DLLEXPORT WARN_UNUSED_RESULT FDBResult* fdb_readbg_parse_snapshot_file(const uin
                                                                        FDBBGTenantPrefix const* tenant_prefix,
                                                                        FDBBGEncryptionCtx const* encryption_ctx);
 
+/* Like fdb_readbg_parse_snapshot_file, but only decodes the rows in [begin_key, end_key). Each value must be a packed
+ * tuple, and is returned as a tuple of just its elements at fields, in that order. */
+DLLEXPORT WARN_UNUSED_RESULT FDBResult*
+fdb_readbg_parse_snapshot_file_projected(const uint8_t* file_data,
+                                         int file_len,
+                                         FDBBGTenantPrefix const* tenant_prefix,
+                                         FDBBGEncryptionCtx const* encryption_ctx,
+                                         uint8_t const* begin_key_name,
+                                         int begin_key_name_length,
+                                         uint8_t const* end_key_name,
+                                         int end_key_name_length,
+                                         int const* fields,
+                                         int field_count);
+
 DLLEXPORT WARN_UNUSED_RESULT FDBResult* fdb_readbg_parse_delta_file(const uint8_t* file_data,
                                                                     int file_len,
                                                                     FDBBGTenantPrefix const* tenant_prefix,
@@ -445,6 +474,8 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_verify_blob_range(FDBDataba
 
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_status(FDBDatabase* db);
 
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_metrics(FDBDatabase* db);
+
 DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_tenant_create_transaction(FDBTenant* tenant,
                                                                        FDBTransaction** out_transaction);
 
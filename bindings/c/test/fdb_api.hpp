@@ -778,6 +778,24 @@ public:
 		    native::fdb_readbg_parse_snapshot_file(fileData.data(), intSize(fileData), tenantPrefix, encryptionCtx));
 	}
 
+	Result parseSnapshotFileProjected(BytesRef fileData,
+	                                  native::FDBBGTenantPrefix const* tenantPrefix,
+	                                  native::FDBBGEncryptionCtx const* encryptionCtx,
+	                                  KeyRef begin,
+	                                  KeyRef end,
+	                                  const std::vector<int>& fields) {
+		return Result(native::fdb_readbg_parse_snapshot_file_projected(fileData.data(),
+		                                                               intSize(fileData),
+		                                                               tenantPrefix,
+		                                                               encryptionCtx,
+		                                                               begin.data(),
+		                                                               intSize(begin),
+		                                                               end.data(),
+		                                                               intSize(end),
+		                                                               fields.data(),
+		                                                               static_cast<int>(fields.size())));
+	}
+
 	Result parseDeltaFile(BytesRef fileData,
 	                      native::FDBBGTenantPrefix const* tenantPrefix,
 	                      native::FDBBGEncryptionCtx const* encryptionCtx) {
@@ -1070,6 +1088,8 @@ public:
 	}
 
 	TypedFuture<future_var::KeyRef> getClientStatus() { return native::fdb_database_get_client_status(db.get()); }
+
+	TypedFuture<future_var::KeyRef> getClientMetrics() { return native::fdb_database_get_client_metrics(db.get()); }
 };
 
 inline Error selectApiVersionNothrow(int version) {
@@ -195,6 +195,7 @@ class ClientConfigTest:
             "StorageServers",
             "Connections",
             "NumConnectionsFailed",
+            "ReadVersionPool",
         }
         db_status = self.status_json["DatabaseStatus"]
         self.tc.assertEqual(expected_db_attributes, set(db_status.keys()))
@@ -31,6 +31,7 @@
 #include <new>
 #include <numeric>
 #include <optional>
+#include <random>
 #if defined(__linux__)
 #include <pthread.h>
 #endif
@@ -61,6 +62,7 @@
 #include "mako.hpp"
 #include "operations.hpp"
 #include "process.hpp"
+#include "replay.hpp"
 #include "utils.hpp"
 #include "shm.hpp"
 #include "stats.hpp"
@@ -79,6 +81,7 @@ struct alignas(64) ThreadArgs {
 	int total_tenants;
 	pid_t parent_id;
 	Arguments const* args;
+	std::vector<replay::Transaction> const* replay_transactions;
 	shared_memory::Access shm;
 	fdb::Database database; // database to work with
 };
@@ -304,16 +307,18 @@ void updateErrorStatsRunMode(WorkflowStatistics& stats, fdb::Error err, int op)
 	}
 }
 
-/* run one iteration of configured transaction */
+/* run one iteration of configured transaction.
+ * its latency is measured from tx_start, which in open-loop mode is when it was due to start */
 int runOneTransaction(Transaction& tx,
                       std::optional<std::string> const& token,
                       Arguments const& args,
                       WorkflowStatistics& stats,
                       ByteString& key1,
                       ByteString& key2,
-                      ByteString& val) {
+                      ByteString& val,
+                      timepoint_t tx_start) {
 	const auto do_sample = (stats.getOpCount(OP_TRANSACTION) % args.sampling) == 0;
-	auto watch_tx = Stopwatch(StartAtCtor{});
+	auto watch_tx = Stopwatch(tx_start);
 	auto watch_op = Stopwatch{};
 
 	auto op_iter = getOpBegin(args);
@@ -438,6 +443,8 @@ int runWorkload(Database db,
 
 	auto time_prev = steady_clock::now();
 	auto time_last_trace = time_prev;
+	auto next_arrival = time_prev;
+	auto arrival_rng = std::mt19937_64(std::random_device{}());
 
 	auto rc = 0;
 	auto xacts = 0;
@@ -455,7 +462,19 @@ int runWorkload(Database db,
 
 	/* main transaction loop */
 	while (1) {
-		if ((thread_tps > 0 /* iff throttling on */) && (xacts >= current_tps)) {
+		if (args.open_loop) {
+			/* start at the next Poisson arrival, or right away if behind schedule; a transaction that waits
+			 * for the previous ones to finish is charged for that wait, as an independent client would be */
+			current_tps = static_cast<int>(thread_tps * throttle_factor.load());
+			if (current_tps > 0) {
+				const auto interval = std::exponential_distribution<double>(current_tps)(arrival_rng);
+				next_arrival += std::chrono::duration_cast<timediff_t>(std::chrono::duration<double>(interval));
+				std::this_thread::sleep_until(next_arrival);
+			} else {
+				usleep(1000);
+				next_arrival = steady_clock::now();
+			}
+		} else if ((thread_tps > 0 /* iff throttling on */) && (xacts >= current_tps)) {
 			/* throttle on */
 			auto time_now = steady_clock::now();
 			while (toDoubleSeconds(time_now - time_prev) < 1.0) {
@@ -509,7 +528,14 @@ int runWorkload(Database db,
 				}
 			}
 
-			rc = runOneTransaction(tx, token, args, workflow_stats, key1, key2, val);
+			rc = runOneTransaction(tx,
+			                       token,
+			                       args,
+			                       workflow_stats,
+			                       key1,
+			                       key2,
+			                       val,
+			                       args.open_loop ? next_arrival : steady_clock::now());
 			if (rc) {
 				logr.warn("runOneTransaction failed ({})", rc);
 			}
@@ -531,6 +557,98 @@ int runWorkload(Database db,
 	return rc;
 }
 
+/* replay the recorded transactions whose index matches this thread (worker_idx of num_workers),
+ * each starting at its recorded time scaled by --replay_speedup */
+int runReplayWorkload(Database db,
+                      Arguments const& args,
+                      std::vector<replay::Transaction> const& transactions,
+                      int const worker_idx,
+                      int const num_workers,
+                      std::atomic<int> const& signal,
+                      WorkflowStatistics& stats) {
+	const auto time_start = steady_clock::now();
+	auto val = ByteString{};
+	for (auto i = static_cast<size_t>(worker_idx); i < transactions.size(); i += num_workers) {
+		const auto& recorded = transactions[i];
+		const auto tx_start = time_start + std::chrono::duration_cast<timediff_t>(
+		                                       std::chrono::duration<double>(recorded.start / args.replay_speedup));
+		/* wake up regularly to notice the end of the run during long gaps in the trace */
+		while (steady_clock::now() < tx_start && signal.load() != SIGNAL_RED) {
+			std::this_thread::sleep_until(std::min(tx_start, steady_clock::now() + std::chrono::milliseconds(100)));
+		}
+		if (signal.load() == SIGNAL_RED) {
+			break;
+		}
+
+		const auto do_sample = (stats.getOpCount(OP_TRANSACTION) % args.sampling) == 0;
+		auto tx = db.createTransaction();
+		setTransactionTimeoutIfEnabled(args, tx);
+		auto watch_tx = Stopwatch(tx_start);
+		while (true) {
+			auto rc = FutureRC::OK;
+			for (const auto& key : recorded.gets) {
+				auto watch_op = Stopwatch(StartAtCtor{});
+				auto f = tx.get(key, false /*snapshot*/);
+				rc = waitAndHandleError(tx, f, "REPLAY_GET", args.isAnyTimeoutEnabled());
+				updateErrorStatsRunMode(stats, f.error(), OP_GET);
+				if (rc != FutureRC::OK)
+					break;
+				if (do_sample)
+					stats.addLatency(OP_GET, watch_op.stop().diff());
+				stats.incrOpCount(OP_GET);
+			}
+			for (auto it = recorded.get_ranges.begin(); rc == FutureRC::OK && it != recorded.get_ranges.end(); ++it) {
+				auto watch_op = Stopwatch(StartAtCtor{});
+				auto f = tx.getRange(key_select::firstGreaterOrEqual(it->first),
+				                     key_select::firstGreaterOrEqual(it->second),
+				                     0 /*limit*/,
+				                     0 /*target_bytes*/,
+				                     args.streaming_mode,
+				                     0 /*iteration*/,
+				                     false /*snapshot*/,
+				                     false /*reverse*/);
+				rc = waitAndHandleError(tx, f, "REPLAY_GETRANGE", args.isAnyTimeoutEnabled());
+				updateErrorStatsRunMode(stats, f.error(), OP_GETRANGE);
+				if (rc != FutureRC::OK)
+					break;
+				if (do_sample)
+					stats.addLatency(OP_GETRANGE, watch_op.stop().diff());
+				stats.incrOpCount(OP_GETRANGE);
+			}
+			if (rc == FutureRC::OK) {
+				for (const auto& [key, value_size] : recorded.sets) {
+					val.resize(value_size);
+					randomString(val.data(), value_size);
+					tx.set(key, val);
+					stats.incrOpCount(OP_INSERT);
+				}
+				for (const auto& [begin, end] : recorded.clears) {
+					tx.clearRange(begin, end);
+					stats.incrOpCount(OP_CLEARRANGE);
+				}
+				auto watch_commit = Stopwatch(StartAtCtor{});
+				auto f = tx.commit();
+				rc = waitAndHandleError(tx, f, "REPLAY_COMMIT", args.isAnyTimeoutEnabled());
+				updateErrorStatsRunMode(stats, f.error(), OP_COMMIT);
+				if (rc == FutureRC::OK) {
+					if (do_sample)
+						stats.addLatency(OP_COMMIT, watch_commit.stop().diff());
+					stats.incrOpCount(OP_COMMIT);
+				}
+			}
+			if (rc == FutureRC::OK)
+				break;
+			if (rc == FutureRC::ABORT)
+				return -1;
+			/* on_error() has reset the transaction; run it again */
+		}
+		if (do_sample)
+			stats.addLatency(OP_TRANSACTION, watch_tx.stop().diff());
+		stats.incrOpCount(OP_TRANSACTION);
+	}
+	return 0;
+}
+
 std::string getStatsFilename(std::string_view dirname, int process_idx, int thread_id, int op) {
 
 	return fmt::format("{}/{}_{}_{}", dirname, process_idx + 1, thread_id + 1, opTable[op].name());
@@ -689,6 +807,17 @@ void workerThread(const ThreadArgs& thread_args) {
 		if (rc < 0) {
 			logr.error("populate failed");
 		}
+	} else if (args.mode == MODE_RUN && thread_args.replay_transactions) {
+		auto rc = runReplayWorkload(database,
+		                            args,
+		                            *thread_args.replay_transactions,
+		                            process_idx * args.num_threads + thread_idx,
+		                            args.num_processes * args.num_threads,
+		                            signal,
+		                            workflow_stats);
+		if (rc < 0) {
+			logr.error("runReplayWorkload failed");
+		}
 	} else if (args.mode == MODE_RUN) {
 		auto rc = runWorkload(
 		    database, args, thread_tps, throttle_factor, thread_iters, signal, workflow_stats, dotrace, dotagging);
@@ -767,6 +896,14 @@ int workerProcessMain(Arguments const& args, int process_idx, shared_memory::Acc
 		}
 	}
 
+	auto replay_transactions = std::vector<replay::Transaction>{};
+	if (args.mode == MODE_RUN && args.replay_file[0] != '\0') {
+		if (!replay::loadFile(args.replay_file, replay_transactions)) {
+			return -1;
+		}
+		logr.debug("loaded {} transactions to replay", replay_transactions.size());
+	}
+
 	if (!args.async_xacts) {
 		logr.debug("creating {} worker threads", args.num_threads);
 		auto worker_threads = std::vector<std::thread>(args.num_threads);
@@ -782,6 +919,7 @@ int workerProcessMain(Arguments const& args, int process_idx, shared_memory::Acc
 			this_args.active_tenants = args.active_tenants;
 			this_args.total_tenants = args.total_tenants;
 			this_args.args = &args;
+			this_args.replay_transactions = args.replay_file[0] != '\0' ? &replay_transactions : nullptr;
 			this_args.shm = shm;
 			this_args.database = databases[i % args.num_databases];
 			worker_threads[i] = std::thread(workerThread, std::ref(this_args));
@@ -849,6 +987,9 @@ Arguments::Arguments() {
 	tpsmin = -1;
 	tpsinterval = 10;
 	tpschange = TPS_SIN;
+	open_loop = false;
+	replay_file[0] = '\0';
+	replay_speedup = 1.0;
 	sampling = 1000;
 	key_length = 32;
 	value_length = 16;
@@ -1157,6 +1298,13 @@ void usage() {
 	printf("%-24s %s\n", "    --tpsmin=TPS", "Specify the target min TPS");
 	printf("%-24s %s\n", "    --tpsinterval=SEC", "Specify the TPS change interval (Default: 10 seconds)");
 	printf("%-24s %s\n", "    --tpschange=<sin|square|pulse>", "Specify the TPS change type (Default: sin)");
+	printf("%-24s %s\n",
+	       "    --open_loop",
+	       "Start transactions at random (Poisson) arrival times for the target TPS, and measure latency from then");
+	printf("%-24s %s\n",
+	       "    --replay_file=PATH",
+	       "Replay the transactions recorded in PATH by transaction_profiling_analyzer.py --replay-output");
+	printf("%-24s %s\n", "    --replay_speedup=X", "Replay the recorded transactions X times faster (Default: 1.0)");
 	printf("%-24s %s\n", "    --sampling=RATE", "Specify the sampling rate for latency stats");
 	printf("%-24s %s\n", "-m, --mode=MODE", "Specify the mode (build, run, clean, report)");
 	printf("%-24s %s\n", "-z, --zipf", "Use zipfian distribution instead of uniform distribution");
@@ -1238,6 +1386,9 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 			{ "tpsmin", required_argument, NULL, ARG_TPSMIN },
 			{ "tpsinterval", required_argument, NULL, ARG_TPSINTERVAL },
 			{ "tpschange", required_argument, NULL, ARG_TPSCHANGE },
+			{ "open_loop", no_argument, NULL, ARG_OPEN_LOOP },
+			{ "replay_file", required_argument, NULL, ARG_REPLAY_FILE },
+			{ "replay_speedup", required_argument, NULL, ARG_REPLAY_SPEEDUP },
 			{ "sampling", required_argument, NULL, ARG_SAMPLING },
 			{ "verbose", required_argument, NULL, 'v' },
 			{ "mode", required_argument, NULL, 'm' },
@@ -1403,6 +1554,15 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 				return -1;
 			}
 			break;
+		case ARG_OPEN_LOOP:
+			args.open_loop = true;
+			break;
+		case ARG_REPLAY_FILE:
+			strncpy(args.replay_file, optarg, std::min(sizeof(args.replay_file), strlen(optarg) + 1));
+			break;
+		case ARG_REPLAY_SPEEDUP:
+			args.replay_speedup = atof(optarg);
+			break;
 		case ARG_SAMPLING:
 			args.sampling = atoi(optarg);
 			break;
@@ -1667,6 +1827,20 @@ int Arguments::validate() {
 			}
 		}
 	}
+	if (open_loop && (mode != MODE_RUN || tpsmax <= 0 || async_xacts > 0)) {
+		logr.error("--open_loop requires run mode, a target --tpsmax|--tps and no --async_xacts");
+		return -1;
+	}
+	if (replay_file[0] != '\0') {
+		if (mode != MODE_RUN || async_xacts > 0 || open_loop || total_tenants > 0) {
+			logr.error("--replay_file requires run mode and no --async_xacts, --open_loop or tenants");
+			return -1;
+		}
+		if (replay_speedup <= 0) {
+			logr.error("--replay_speedup must be positive");
+			return -1;
+		}
+	}
 
 	// ensure that all of the files provided to mako are valid and exist
 	if (mode == MODE_REPORT) {
@@ -2182,6 +2356,8 @@ void printReport(Arguments const& args,
 			break;
 		}
 	}
+	if (args.open_loop)
+		fmt::printf("Arrivals:          %8s\n", "POISSON");
 	const auto tps_f = final_worker_stats.getOpCount(OP_TRANSACTION) / duration_sec;
 	const auto tps_i = static_cast<uint64_t>(tps_f);
 
@@ -2360,6 +2536,7 @@ int statsProcessMain(Arguments const& args,
 		fmt::fprintf(fp, "\"tpsmin\": %d,", args.tpsmin);
 		fmt::fprintf(fp, "\"tpsinterval\": %d,", args.tpsinterval);
 		fmt::fprintf(fp, "\"tpschange\": %d,", args.tpschange);
+		fmt::fprintf(fp, "\"open_loop\": %s,", args.open_loop ? "true" : "false");
 		fmt::fprintf(fp, "\"sampling\": %d,", args.sampling);
 		fmt::fprintf(fp, "\"key_length\": %d,", args.key_length);
 		fmt::fprintf(fp, "\"value_length\": %d,", args.value_length);
@@ -2547,6 +2724,13 @@ int main(int argc, char* argv[]) {
 		}
 	}
 
+	if (args.mode == MODE_RUN && args.replay_file[0] != '\0') {
+		/* report the operations a replay issues */
+		for (auto op : { OP_GET, OP_GETRANGE, OP_INSERT, OP_CLEARRANGE }) {
+			args.txnspec.ops[op][OP_COUNT] = 1;
+		}
+	}
+
 	if (args.mode == MODE_REPORT) {
 		WorkflowStatistics stats = mergeSketchReport(args);
 		printWorkerStats(stats, args, NULL, true);
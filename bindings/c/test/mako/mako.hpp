@@ -72,6 +72,7 @@ enum ArgKind {
 	ARG_TPSMIN,
 	ARG_TPSINTERVAL,
 	ARG_TPSCHANGE,
+	ARG_OPEN_LOOP,
 	ARG_TXNTRACE,
 	ARG_TXNTAGGING,
 	ARG_TXNTAGGINGPREFIX,
@@ -80,6 +81,8 @@ enum ArgKind {
 	ARG_CLIENT_THREADS_PER_VERSION,
 	ARG_DISABLE_CLIENT_BYPASS,
 	ARG_JSON_REPORT,
+	ARG_REPLAY_FILE,
+	ARG_REPLAY_SPEEDUP,
 	ARG_BG_FILE_PATH, // if blob granule files are stored locally, mako will read and materialize them if this is set
 	ARG_EXPORT_PATH,
 	ARG_DISTRIBUTED_TRACER_CLIENT,
@@ -169,6 +172,9 @@ struct Arguments {
 	int tpsmin;
 	int tpsinterval;
 	int tpschange;
+	bool open_loop;
+	char replay_file[PATH_MAX];
+	double replay_speedup;
 	int sampling;
 	int key_length;
 	int value_length;
@@ -0,0 +1,159 @@
+/*
+ * replay.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "replay.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <string>
+#include "logger.hpp"
+#include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
+
+extern thread_local mako::Logger logr;
+
+namespace mako::replay {
+
+namespace {
+
+std::optional<fdb::ByteString> fromHex(rapidjson::Value const& v) {
+	if (!v.IsString() || v.GetStringLength() % 2) {
+		return {};
+	}
+	auto out = fdb::ByteString{};
+	const auto str = std::string_view(v.GetString(), v.GetStringLength());
+	for (size_t i = 0; i < str.size(); i += 2) {
+		auto byte = 0;
+		for (auto c : str.substr(i, 2)) {
+			byte <<= 4;
+			if (c >= '0' && c <= '9') {
+				byte |= c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				byte |= c - 'a' + 10;
+			} else if (c >= 'A' && c <= 'F') {
+				byte |= c - 'A' + 10;
+			} else {
+				return {};
+			}
+		}
+		out.push_back(static_cast<uint8_t>(byte));
+	}
+	return out;
+}
+
+std::optional<std::pair<fdb::ByteString, fdb::ByteString>> keyRange(rapidjson::Value const& v) {
+	if (!v.IsArray() || v.Size() < 2) {
+		return {};
+	}
+	auto begin = fromHex(v[0]);
+	auto end = fromHex(v[1]);
+	if (!begin || !end) {
+		return {};
+	}
+	return std::make_pair(std::move(*begin), std::move(*end));
+}
+
+bool parseTransaction(rapidjson::Document const& doc, Transaction& tx) {
+	if (!doc.IsObject() || !doc.HasMember("start") || !doc["start"].IsNumber()) {
+		return false;
+	}
+	tx.start = doc["start"].GetDouble();
+	auto array = [&doc](char const* name) -> rapidjson::Value const* {
+		auto it = doc.FindMember(name);
+		return it != doc.MemberEnd() && it->value.IsArray() ? &it->value : nullptr;
+	};
+	if (auto gets = array("gets")) {
+		for (auto const& v : gets->GetArray()) {
+			auto key = fromHex(v);
+			if (!key)
+				return false;
+			tx.gets.push_back(std::move(*key));
+		}
+	}
+	if (auto get_ranges = array("get_ranges")) {
+		for (auto const& v : get_ranges->GetArray()) {
+			auto range = keyRange(v);
+			if (!range)
+				return false;
+			tx.get_ranges.push_back(std::move(*range));
+		}
+	}
+	if (auto sets = array("sets")) {
+		for (auto const& v : sets->GetArray()) {
+			if (!v.IsArray() || v.Size() < 2 || !v[1].IsInt())
+				return false;
+			auto key = fromHex(v[0]);
+			if (!key)
+				return false;
+			tx.sets.emplace_back(std::move(*key), v[1].GetInt());
+		}
+	}
+	if (auto clears = array("clears")) {
+		for (auto const& v : clears->GetArray()) {
+			auto range = keyRange(v);
+			if (!range)
+				return false;
+			tx.clears.push_back(std::move(*range));
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+bool loadFile(char const* path, std::vector<Transaction>& transactions) {
+	auto in = std::ifstream(path);
+	if (!in) {
+		logr.error("cannot open replay file {}", path);
+		return false;
+	}
+	auto line = std::string{};
+	auto line_no = 0;
+	while (std::getline(in, line)) {
+		line_no++;
+		if (line.empty())
+			continue;
+		auto doc = rapidjson::Document{};
+		doc.Parse(line.c_str());
+		if (doc.HasParseError()) {
+			logr.error("{}:{}: {}", path, line_no, rapidjson::GetParseError_En(doc.GetParseError()));
+			return false;
+		}
+		auto tx = Transaction{};
+		if (!parseTransaction(doc, tx)) {
+			logr.error("{}:{}: malformed transaction", path, line_no);
+			return false;
+		}
+		transactions.push_back(std::move(tx));
+	}
+	std::stable_sort(transactions.begin(), transactions.end(), [](auto const& a, auto const& b) {
+		return a.start < b.start;
+	});
+	if (!transactions.empty()) {
+		const auto first = transactions.front().start;
+		for (auto& tx : transactions) {
+			tx.start -= first;
+		}
+	}
+	return true;
+}
+
+} // namespace mako::replay
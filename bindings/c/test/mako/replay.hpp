@@ -0,0 +1,45 @@
+/*
+ * replay.hpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAKO_REPLAY_HPP
+#define MAKO_REPLAY_HPP
+
+#include <utility>
+#include <vector>
+#include <fdb_api.hpp>
+
+namespace mako::replay {
+
+// One transaction sampled by the client transaction profiler, as written by
+// contrib/transaction_profiling_analyzer/transaction_profiling_analyzer.py --replay-output
+struct Transaction {
+	double start; // seconds after the start of the first transaction in the trace
+	std::vector<fdb::ByteString> gets;
+	std::vector<std::pair<fdb::ByteString, fdb::ByteString>> get_ranges;
+	std::vector<std::pair<fdb::ByteString, int>> sets; // key and the size of the value written
+	std::vector<std::pair<fdb::ByteString, fdb::ByteString>> clears;
+};
+
+// Reads the transactions in path ordered by start time. Returns false if the file could not be read.
+bool loadFile(char const* path, std::vector<Transaction>& transactions);
+
+} // namespace mako::replay
+
+#endif /*MAKO_REPLAY_HPP*/
@@ -42,6 +42,10 @@ bool Future::is_ready() {
 	return fdb_future_set_callback(future_, callback, callback_parameter);
 }
 
+[[nodiscard]] fdb_error_t Future::set_completion_queue(FDBCompletionQueue* q, void* callback_parameter) {
+	return fdb_future_set_completion_queue(future_, q, callback_parameter);
+}
+
 [[nodiscard]] fdb_error_t Future::get_error() {
 	return fdb_future_get_error(future_);
 }
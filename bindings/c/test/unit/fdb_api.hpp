@@ -59,6 +59,8 @@ public:
 	fdb_error_t block_until_ready();
 	// Wrapper around fdb_future_set_callback.
 	fdb_error_t set_callback(FDBCallback callback, void* callback_parameter);
+	// Wrapper around fdb_future_set_completion_queue.
+	fdb_error_t set_completion_queue(FDBCompletionQueue* q, void* callback_parameter);
 	// Wrapper around fdb_future_get_error.
 	fdb_error_t get_error();
 	// Wrapper around fdb_future_release_memory.
@@ -381,6 +381,53 @@ TEST_CASE("fdb_future_set_callback") {
 	}
 }
 
+TEST_CASE("fdb_future_set_completion_queue") {
+	FDBCompletionQueue* q;
+	fdb_check(fdb_create_completion_queue(&q));
+
+	FDBFuture* out_futures[4];
+	void* out_parameters[4];
+	int out_count;
+	fdb_check(fdb_completion_queue_poll(q, 0, 4, out_futures, out_parameters, &out_count));
+	CHECK(out_count == 0);
+
+	fdb::Transaction tr(db);
+	while (1) {
+		fdb::ValueFuture f1 = tr.get("foo", /*snapshot*/ true);
+		fdb::ValueFuture f2 = tr.get("bar", /*snapshot*/ true);
+		int params[2] = { 1, 2 };
+		fdb_check(f1.set_completion_queue(q, &params[0]));
+		fdb_check(f2.set_completion_queue(q, &params[1]));
+
+		int completed = 0;
+		int paramSum = 0;
+		while (completed < 2) {
+			fdb_check(fdb_completion_queue_poll(q, -1, 4, out_futures, out_parameters, &out_count));
+			CHECK(out_count > 0);
+			for (int i = 0; i < out_count; ++i) {
+				CHECK(fdb_future_is_ready(out_futures[i]));
+				paramSum += *static_cast<int*>(out_parameters[i]);
+			}
+			completed += out_count;
+		}
+		CHECK(completed == 2);
+		CHECK(paramSum == 3);
+
+		fdb_error_t err = wait_future(f1);
+		if (!err) {
+			err = wait_future(f2);
+		}
+		if (err) {
+			fdb::EmptyFuture f3 = tr.on_error(err);
+			fdb_check(wait_future(f3));
+			continue;
+		}
+		break;
+	}
+
+	fdb_completion_queue_destroy(q);
+}
+
 TEST_CASE("fdb_future_cancel after future completion") {
 	fdb::Transaction tr(db);
 	while (1) {
@@ -1337,6 +1384,74 @@ TEST_CASE("fdb_transaction_get_range FDB_STREAMING_MODE_EXACT") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_range FDB_STREAMING_MODE_PREFETCH") {
+	std::map<std::string, std::string> data;
+	for (int i = 0; i < 200; ++i) {
+		data[key("k" + std::to_string(1000 + i))] = std::string(64, 'a' + i % 26);
+	}
+	insert_data(db, data);
+
+	// Continue each read after the last key returned, in both directions, so
+	// that reads are served by the prefetched batches.
+	for (fdb_bool_t reverse : { 0, 1 }) {
+		fdb::Transaction tr(db);
+		while (1) {
+			std::vector<std::pair<std::string, std::string>> kvs;
+			std::string begin = key("k");
+			std::string end = key("l");
+			fdb_bool_t begin_or_equal = false;
+			fdb_error_t err = 0;
+			bool more = true;
+			while (more) {
+				auto result = get_range(tr,
+				                        (const uint8_t*)begin.c_str(),
+				                        begin.size(),
+				                        begin_or_equal,
+				                        1,
+				                        (const uint8_t*)end.c_str(),
+				                        end.size(),
+				                        /* end_or_equal */ false,
+				                        /* end_offset */ 1,
+				                        /* limit */ 0,
+				                        /* target_bytes */ 0,
+				                        /* FDBStreamingMode */ FDB_STREAMING_MODE_PREFETCH,
+				                        /* iteration */ 0,
+				                        /* snapshot */ false,
+				                        reverse);
+				if (result.err) {
+					err = result.err;
+					break;
+				}
+				kvs.insert(kvs.end(), result.kvs.begin(), result.kvs.end());
+				more = result.more && !result.kvs.empty();
+				if (more) {
+					if (reverse) {
+						end = result.kvs.back().first;
+					} else {
+						begin = result.kvs.back().first;
+						begin_or_equal = true;
+					}
+				}
+			}
+
+			if (err) {
+				fdb::EmptyFuture f1 = tr.on_error(err);
+				fdb_check(wait_future(f1));
+				continue;
+			}
+
+			CHECK(kvs.size() == data.size());
+			auto it = data.begin();
+			for (int i = 0; i < kvs.size() && it != data.end(); ++i, ++it) {
+				const auto& kv = kvs[reverse ? kvs.size() - 1 - i : i];
+				CHECK(kv.first == it->first);
+				CHECK(kv.second == it->second);
+			}
+			break;
+		}
+	}
+}
+
 TEST_CASE("fdb_transaction_clear") {
 	insert_data(db, create_data({ { "foo", "bar" } }));
 
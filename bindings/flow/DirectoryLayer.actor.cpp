@@ -31,13 +31,20 @@ const int64_t DirectoryLayer::SUB_DIR_KEY = 0;
 const uint32_t DirectoryLayer::VERSION[3] = { 1, 0, 0 };
 
 const StringRef DirectoryLayer::DEFAULT_NODE_SUBSPACE_PREFIX = "\xfe"_sr;
+const StringRef DirectoryLayer::METADATA_VERSION_KEY = "\xff/metadataVersion"_sr;
+// A versionstamp at offset 0, as needed by a versionstamped set of METADATA_VERSION_KEY
+const uint8_t DirectoryLayer::METADATA_VERSION_REQUIRED_VALUE[14] = { 0 };
+const int DirectoryLayer::MAX_CACHED_DIRECTORIES = 10000;
 const Subspace DirectoryLayer::DEFAULT_NODE_SUBSPACE = Subspace(DEFAULT_NODE_SUBSPACE_PREFIX);
 const Subspace DirectoryLayer::DEFAULT_CONTENT_SUBSPACE = Subspace();
 const StringRef DirectoryLayer::PARTITION_LAYER = "partition"_sr;
 
-DirectoryLayer::DirectoryLayer(Subspace nodeSubspace, Subspace contentSubspace, bool allowManualPrefixes)
+DirectoryLayer::DirectoryLayer(Subspace nodeSubspace,
+                               Subspace contentSubspace,
+                               bool allowManualPrefixes,
+                               bool useCache)
   : rootNode(nodeSubspace.get(nodeSubspace.key())), nodeSubspace(nodeSubspace), contentSubspace(contentSubspace),
-    allocator(rootNode.get(HIGH_CONTENTION_KEY)), allowManualPrefixes(allowManualPrefixes) {}
+    allocator(rootNode.get(HIGH_CONTENTION_KEY)), allowManualPrefixes(allowManualPrefixes), useCache(useCache) {}
 
 Subspace DirectoryLayer::nodeWithPrefix(StringRef const& prefix) const {
 	return nodeSubspace.get(prefix);
@@ -129,6 +136,48 @@ void DirectoryLayer::initializeDirectory(Reference<Transaction> const& tr) const
 	tr->set(rootNode.pack(VERSION_KEY), StringRef((uint8_t*)VERSION, 12));
 }
 
+// Invalidates the caches of all clients once tr commits
+void DirectoryLayer::updateMetadataVersion(Reference<Transaction> const& tr) const {
+	if (useCache) {
+		tr->atomicOp(METADATA_VERSION_KEY,
+		             StringRef(METADATA_VERSION_REQUIRED_VALUE, sizeof(METADATA_VERSION_REQUIRED_VALUE)),
+		             FDB_MUTATION_TYPE_SET_VERSIONSTAMPED_VALUE);
+	}
+}
+
+Reference<DirectorySubspace> DirectoryLayer::getCached(Standalone<StringRef> const& metadataVersion,
+                                                       Path const& path) const {
+	if (metadataVersion != cacheMetadataVersion) {
+		return Reference<DirectorySubspace>();
+	}
+	auto it = cache.find(path);
+	return it != cache.end() ? it->second : Reference<DirectorySubspace>();
+}
+
+void DirectoryLayer::addToCache(Standalone<StringRef> const& metadataVersion,
+                                Path const& path,
+                                Reference<DirectorySubspace> const& directory) {
+	if (metadataVersion != cacheMetadataVersion || cache.size() >= MAX_CACHED_DIRECTORIES) {
+		cache.clear();
+		cacheMetadataVersion = metadataVersion;
+	}
+	cache[path] = directory;
+}
+
+// The value of \xff/metadataVersion (empty if it has never been set), or nothing if tr has changed it and so cannot
+// read it
+ACTOR Future<Optional<Standalone<StringRef>>> getMetadataVersion(Reference<Transaction> tr) {
+	try {
+		Optional<FDBStandalone<ValueRef>> version = wait(tr->get(DirectoryLayer::METADATA_VERSION_KEY));
+		return version.present() ? Standalone<StringRef>(version.get()) : Standalone<StringRef>();
+	} catch (Error& e) {
+		if (e.code() == error_code_accessed_unreadable) {
+			return Optional<Standalone<StringRef>>();
+		}
+		throw;
+	}
+}
+
 ACTOR Future<Void> checkVersionInternal(const DirectoryLayer* dirLayer, Reference<Transaction> tr, bool writeAccess) {
 	Optional<FDBStandalone<ValueRef>> versionBytes =
 	    wait(tr->get(dirLayer->rootNode.pack(DirectoryLayer::VERSION_KEY)));
@@ -255,6 +304,7 @@ ACTOR Future<Reference<DirectorySubspace>> createInternal(Reference<DirectoryLay
 
 	tr->set(parentNode.get(DirectoryLayer::SUB_DIR_KEY).get(path.back(), true).key(), newPrefix);
 	tr->set(node.get(DirectoryLayer::LAYER_KEY).key(), layer);
+	dirLayer->updateMetadataVersion(tr);
 	return dirLayer->contentsOfNode(node, path, layer);
 }
 
@@ -266,6 +316,23 @@ ACTOR Future<Reference<DirectorySubspace>> _createOrOpenInternal(Reference<Direc
                                                                  bool allowCreate,
                                                                  bool allowOpen) {
 	ASSERT(!prefix.present() || allowCreate);
+
+	state Optional<Standalone<StringRef>> metadataVersion;
+	if (dirLayer->useCache && allowOpen && !prefix.present() && path.size()) {
+		Optional<Standalone<StringRef>> version = wait(getMetadataVersion(tr));
+		metadataVersion = version;
+		Reference<DirectorySubspace> cached;
+		if (metadataVersion.present()) {
+			cached = dirLayer->getCached(metadataVersion.get(), path);
+		}
+		if (cached) {
+			if (layer.size() > 0 && layer != cached->getLayer()) {
+				throw mismatched_layer();
+			}
+			return cached;
+		}
+	}
+
 	wait(dirLayer->checkVersion(tr, false));
 
 	if (prefix.present() && !dirLayer->allowManualPrefixes) {
@@ -289,7 +356,11 @@ ACTOR Future<Reference<DirectorySubspace>> _createOrOpenInternal(Reference<Direc
 			        tr, subpath, layer, prefix, allowCreate, allowOpen));
 			return dirSpace;
 		}
-		return dirLayer->openInternal(layer, existingNode, allowOpen);
+		Reference<DirectorySubspace> dirSpace = dirLayer->openInternal(layer, existingNode, allowOpen);
+		if (metadataVersion.present()) {
+			dirLayer->addToCache(metadataVersion.get(), path, dirSpace);
+		}
+		return dirSpace;
 	} else {
 		Reference<DirectorySubspace> dirSpace = wait(createInternal(dirLayer, tr, path, layer, prefix, allowCreate));
 		return dirSpace;
@@ -432,6 +503,7 @@ ACTOR Future<Reference<DirectorySubspace>> moveInternal(Reference<DirectoryLayer
 	tr->set(parentNode.subspace.get().get(DirectoryLayer::SUB_DIR_KEY).get(newPath.back(), true).key(),
 	        dirLayer->nodeSubspace.unpack(oldNode.subspace.get().key()).getString(0));
 	wait(removeFromParent(dirLayer, tr, oldPath));
+	dirLayer->updateMetadataVersion(tr);
 
 	return dirLayer->contentsOfNode(oldNode.subspace.get(), newPath, oldNode.layer);
 }
@@ -513,6 +585,7 @@ ACTOR Future<bool> removeInternal(Reference<DirectoryLayer> dirLayer,
 	futures.push_back(removeFromParent(dirLayer, tr, path));
 
 	wait(waitForAll(futures));
+	dirLayer->updateMetadataVersion(tr);
 
 	return true;
 }
@@ -30,9 +30,14 @@
 namespace FDB {
 class DirectoryLayer : public IDirectory {
 public:
+	// With useCache, directories opened by this layer are kept in memory for as long as \xff/metadataVersion is
+	// unchanged, and every change this layer makes to the directory tree updates that key. Caching is only correct if
+	// all clients modifying the directory tree do the same, and a transaction that has changed a directory can no
+	// longer read \xff/metadataVersion itself.
 	DirectoryLayer(Subspace nodeSubspace = DEFAULT_NODE_SUBSPACE,
 	               Subspace contentSubspace = DEFAULT_CONTENT_SUBSPACE,
-	               bool allowManualPrefixes = false);
+	               bool allowManualPrefixes = false,
+	               bool useCache = false);
 
 	Future<Reference<DirectorySubspace>> create(
 	    Reference<Transaction> const& tr,
@@ -73,6 +78,9 @@ public:
 	static const int64_t SUB_DIR_KEY;
 	static const uint32_t VERSION[3];
 	static const StringRef DEFAULT_NODE_SUBSPACE_PREFIX;
+	static const StringRef METADATA_VERSION_KEY;
+	static const uint8_t METADATA_VERSION_REQUIRED_VALUE[14];
+	static const int MAX_CACHED_DIRECTORIES;
 
 	struct Node {
 		Node() {}
@@ -110,6 +118,7 @@ public:
 	                                                          bool allowOpen);
 
 	void initializeDirectory(Reference<Transaction> const& tr) const;
+	void updateMetadataVersion(Reference<Transaction> const& tr) const;
 	Future<Void> checkVersion(Reference<Transaction> const& tr, bool writeAccess) const;
 
 	template <class T>
@@ -122,11 +131,21 @@ public:
 
 	Path toAbsolutePath(Path const& subpath) const;
 
+	Reference<DirectorySubspace> getCached(Standalone<StringRef> const& metadataVersion, Path const& path) const;
+	void addToCache(Standalone<StringRef> const& metadataVersion,
+	                Path const& path,
+	                Reference<DirectorySubspace> const& directory);
+
 	Subspace rootNode;
 	Subspace nodeSubspace;
 	Subspace contentSubspace;
 	HighContentionAllocator allocator;
 	bool allowManualPrefixes;
+	bool useCache;
+
+	// Opened directories by path, valid while \xff/metadataVersion has the value cacheMetadataVersion
+	std::map<Path, Reference<DirectorySubspace>> cache;
+	Standalone<StringRef> cacheMetadataVersion;
 
 	Path path;
 };
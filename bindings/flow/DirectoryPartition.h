@@ -40,6 +40,7 @@ public:
 	                      DirectoryLayer::PARTITION_LAYER),
 	    parentDirectoryLayer(parentDirectoryLayer) {
 		this->directoryLayer->path = path;
+		this->directoryLayer->useCache = parentDirectoryLayer->useCache;
 	}
 	virtual ~DirectoryPartition() {}
 
@@ -25,16 +25,47 @@ package fdb
 //  #cgo LDFLAGS: -lfdb_c -lm
 //  #define FDB_API_VERSION 720
 //  #include <foundationdb/fdb_c.h>
+//  #include <pthread.h>
+//  #include <stdint.h>
+//  #include <stdlib.h>
 //  #include <string.h>
 //
-//  extern void unlockMutex(void*);
+//  // Futures become ready on the network thread, which only records the waiter's token here; a single
+//  // goroutine takes the tokens in batches, so there is no call from C into Go per future.
+//  static pthread_mutex_t go_completions_lock = PTHREAD_MUTEX_INITIALIZER;
+//  static pthread_cond_t go_completions_cond = PTHREAD_COND_INITIALIZER;
+//  static uintptr_t* go_completions = NULL;
+//  static int go_completions_count = 0;
+//  static int go_completions_capacity = 0;
 //
-//  void go_callback(FDBFuture* f, void* m) {
-//      unlockMutex(m);
+//  void go_callback(FDBFuture* f, void* token) {
+//      pthread_mutex_lock(&go_completions_lock);
+//      if (go_completions_count == go_completions_capacity) {
+//          go_completions_capacity = go_completions_capacity ? 2 * go_completions_capacity : 1024;
+//          go_completions = realloc(go_completions, go_completions_capacity * sizeof(uintptr_t));
+//      }
+//      go_completions[go_completions_count++] = (uintptr_t)token;
+//      if (go_completions_count == 1) {
+//          pthread_cond_signal(&go_completions_cond);
+//      }
+//      pthread_mutex_unlock(&go_completions_lock);
 //  }
 //
-//  void go_set_callback(void* f, void* m) {
-//      fdb_future_set_callback(f, (FDBCallback)&go_callback, m);
+//  void go_set_callback(void* f, uintptr_t token) {
+//      fdb_future_set_callback(f, (FDBCallback)&go_callback, (void*)token);
+//  }
+//
+//  int go_wait_completions(uintptr_t* out, int max) {
+//      pthread_mutex_lock(&go_completions_lock);
+//      while (go_completions_count == 0) {
+//          pthread_cond_wait(&go_completions_cond, &go_completions_lock);
+//      }
+//      int n = go_completions_count < max ? go_completions_count : max;
+//      memcpy(out, go_completions, n * sizeof(uintptr_t));
+//      go_completions_count -= n;
+//      memmove(go_completions, go_completions + n, go_completions_count * sizeof(uintptr_t));
+//      pthread_mutex_unlock(&go_completions_lock);
+//      return n;
 //  }
 import "C"
 
@@ -44,6 +75,47 @@ import (
 	"unsafe"
 )
 
+// Goroutines blocked on a future, keyed by the token given to its callback
+var completions struct {
+	sync.Mutex
+	next    uintptr
+	waiters map[uintptr]chan struct{}
+	poller  sync.Once
+}
+
+// completionBatchSize bounds how many ready futures the poller takes from C at once
+const completionBatchSize = 256
+
+func pollCompletions() {
+	var batch [completionBatchSize]C.uintptr_t
+	for {
+		n := int(C.go_wait_completions(&batch[0], completionBatchSize))
+		completions.Lock()
+		for _, token := range batch[:n] {
+			if ch, ok := completions.waiters[uintptr(token)]; ok {
+				delete(completions.waiters, uintptr(token))
+				close(ch)
+			}
+		}
+		completions.Unlock()
+	}
+}
+
+func addCompletionWaiter() (uintptr, chan struct{}) {
+	completions.poller.Do(func() {
+		completions.waiters = make(map[uintptr]chan struct{})
+		go pollCompletions()
+	})
+
+	ch := make(chan struct{})
+	completions.Lock()
+	completions.next++
+	token := completions.next
+	completions.waiters[token] = ch
+	completions.Unlock()
+	return token, ch
+}
+
 // A Future represents a value (or error) to be available at some later
 // time. Asynchronous FDB API functions return one of the types that implement
 // the Future interface. All Future types additionally implement Get and MustGet
@@ -86,17 +158,11 @@ func fdb_future_block_until_ready(f *C.FDBFuture) {
 		return
 	}
 
-	// The mutex here is used as a signal that the callback is complete.
-	// We first lock it, then pass it to the callback, and then lock it
-	// again. The second call to lock won't return until the callback has
-	// fired.
-	//
-	// See https://groups.google.com/forum/#!topic/golang-nuts/SPjQEcsdORA
-	// for the history of why this pattern came to be used.
-	m := &sync.Mutex{}
-	m.Lock()
-	C.go_set_callback(unsafe.Pointer(f), unsafe.Pointer(m))
-	m.Lock()
+	// The callback only queues the token; the channel is closed once the
+	// poller goroutine picks it up along with any other ready futures.
+	token, ch := addCompletionWaiter()
+	C.go_set_callback(unsafe.Pointer(f), C.uintptr_t(token))
+	<-ch
 }
 
 func (f *future) BlockUntilReady() {
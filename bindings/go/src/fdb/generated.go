@@ -291,6 +291,20 @@ func (o NetworkOptions) SetDisableClientBypass() error {
 	return o.setOpt(72, nil)
 }
 
+// Pins the client threads spawned by client_threads_per_version to CPUs, the i-th thread of each client version to the (i mod n)-th of the n CPUs listed. Must be set before setting up the network.
+//
+// Parameter: Comma separated list of CPU numbers
+func (o NetworkOptions) SetClientThreadsCpuAffinity(param string) error {
+	return o.setOpt(73, []byte(param))
+}
+
+// Sets how databases are assigned to the client threads spawned by client_threads_per_version. With round_robin, the default, each new database uses the next thread. With cluster, all databases of a cluster use the same thread, sharing its connections, and different clusters are spread over the threads.
+//
+// Parameter: round_robin or cluster
+func (o NetworkOptions) SetClientThreadsAssignment(param string) error {
+	return o.setOpt(74, []byte(param))
+}
+
 // Enable client buggify - will make requests randomly fail (intended for client testing)
 func (o NetworkOptions) SetClientBuggifyEnable() error {
 	return o.setOpt(80, nil)
@@ -336,6 +350,25 @@ func (o DatabaseOptions) SetLocationCacheSize(param int64) error {
 	return o.setOpt(10, int64ToBytes(param))
 }
 
+// Fill the client location cache with the locations of all shards in the background, up to the location cache size, instead of looking them up as keys are first accessed.
+func (o DatabaseOptions) SetLocationCachePrewarm() error {
+	return o.setOpt(12, nil)
+}
+
+// Load the client location cache from the given file if it was written by this client version for this cluster, then save the cache to it every minute. A client that restarts with the same file does not have to look up the locations of the keys it used before. Locations that have changed since are looked up again when they are used.
+//
+// Parameter: Path to the location cache file
+func (o DatabaseOptions) SetLocationCacheFile(param string) error {
+	return o.setOpt(13, []byte(param))
+}
+
+// Set the size of the client read cache, which keeps the values read by this database's transactions by the version they were read at. A later transaction reading the same key at the same read version, for instance one sharing a read version through ``bounded_stale_read_version``, gets the value without contacting a storage server. Defaults to 0, which disables the cache.
+//
+// Parameter: Max cached bytes
+func (o DatabaseOptions) SetReadCacheSize(param int64) error {
+	return o.setOpt(11, int64ToBytes(param))
+}
+
 // Set the maximum number of watches allowed to be outstanding on a database connection. Increasing this number could result in increased resource usage. Reducing this number will not cancel any outstanding watches. Defaults to 10000 and cannot be larger than 1000000.
 //
 // Parameter: Max outstanding watches
@@ -449,6 +482,11 @@ func (o TransactionOptions) SetCausalReadDisable() error {
 	return o.setOpt(21, nil)
 }
 
+// The read version will be committed, but may be older than the latest committed version by up to a server configured bound (50 milliseconds by default), which allows a GRV proxy to answer without contacting the master. If the client knob grv_share_window is set, the transaction may also share the read version of a request made by another transaction on the same database up to that many seconds earlier. Reads may not observe transactions that committed shortly before this transaction started. Only use this option for read-only or otherwise staleness tolerant transactions.
+func (o TransactionOptions) SetBoundedStaleReadVersion() error {
+	return o.setOpt(24, nil)
+}
+
 // Addresses returned by get_addresses_for_key include the port when enabled. As of api version 630, this option is enabled by default and setting this has no effect.
 func (o TransactionOptions) SetIncludePortInAddress() error {
 	return o.setOpt(23, nil)
@@ -721,6 +759,15 @@ const (
 	// get reasonable read bandwidth from the database. If the client stops
 	// iteration early, considerable disk and network bandwidth may be wasted.
 	StreamingModeSerial StreamingMode = 5
+
+	// The client intends to read the range batch by batch, continuing each read
+	// right after the last key returned. Batches start at the size used by
+	// “ITERATOR“, and the following batches are requested from the storage
+	// servers before the caller asks for them, so a large scan is limited by
+	// bandwidth instead of by round trips. If the client stops iteration early,
+	// the prefetched batches are wasted. Prefetching only applies to reads with
+	// no row limit; other reads behave like “ITERATOR“.
+	StreamingModePrefetch StreamingMode = 6
 )
 
 // Performs an addition of little-endian integers. If the existing value in the database is not present or shorter than ``param``, it is first extended to the length of ``param`` with zero bytes.  If ``param`` is shorter than the existing value in the database, the existing value is truncated to match the length of ``param``. The integers to be added must be stored in a little-endian representation.  They can be signed in two's complement representation or unsigned. You can add to an integer at a known offset in the value by prepending the appropriate number of zero bytes to ``param`` and padding with zero bytes to match the length of the value. However, this offset technique requires that you know the addition will not cause the integer field within the value to overflow.
@@ -798,6 +845,11 @@ func (t Transaction) CompareAndClear(key KeyConvertible, param []byte) {
 	t.atomicOp(key.FDBKey(), param, 20)
 }
 
+// Sets a key made of ``key`` followed by the versionstamp of the transaction and a 2 byte big-Endian sequence number to ``param``. The sequence number counts the appends in the transaction from 0, so appends under the same prefix sort in the order they were committed and made, and a transaction can make up to 65536 of them. The key is made when the transaction is committed, without needing a counter or the conflicts on it; the appended keys cannot be read by the transaction that writes them.
+func (t Transaction) AppendVersionstamped(key KeyConvertible, param []byte) {
+	t.atomicOp(key.FDBKey(), param, 24)
+}
+
 type conflictRangeType int
 
 const (
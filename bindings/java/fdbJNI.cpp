@@ -1591,21 +1591,22 @@ JNIEXPORT jlong JNICALL Java_com_apple_foundationdb_FDBTransaction_Transaction_1
 	return (jlong)f;
 }
 
-JNIEXPORT void JNICALL Java_com_apple_foundationdb_FutureResults_FutureResults_1getDirect(JNIEnv* jenv,
+// Returns the capacity the whole chunk needed if it had to be truncated to fit the buffer, 0 otherwise
+JNIEXPORT jint JNICALL Java_com_apple_foundationdb_FutureResults_FutureResults_1getDirect(JNIEnv* jenv,
                                                                                           jobject,
                                                                                           jlong future,
                                                                                           jobject jbuffer,
                                                                                           jint bufferCapacity) {
 	if (!future) {
 		throwParamNotNull(jenv);
-		return;
+		return 0;
 	}
 
 	uint8_t* buffer = (uint8_t*)jenv->GetDirectBufferAddress(jbuffer);
 	if (!buffer) {
 		if (!jenv->ExceptionOccurred())
 			throwRuntimeEx(jenv, "Error getting handle to native resources");
-		return;
+		return 0;
 	}
 
 	FDBFuture* f = (FDBFuture*)future;
@@ -1615,7 +1616,7 @@ JNIEXPORT void JNICALL Java_com_apple_foundationdb_FutureResults_FutureResults_1
 	fdb_error_t err = fdb_future_get_keyvalue_array(f, &kvs, &count, &more);
 	if (err) {
 		safeThrow(jenv, getThrowable(jenv, err));
-		return;
+		return 0;
 	}
 
 	// Capacity for Metadata+Keys+Values
@@ -1624,14 +1625,19 @@ JNIEXPORT void JNICALL Java_com_apple_foundationdb_FutureResults_FutureResults_1
 	//  => sizeof(jint) to store key length per KV pair
 	//  => sizeof(jint) to store value length per KV pair
 	int totalCapacityNeeded = 2 * sizeof(jint);
+	int fits = count;
 	for (int i = 0; i < count; i++) {
 		totalCapacityNeeded += kvs[i].key_length + kvs[i].value_length + 2 * sizeof(jint);
-		if (bufferCapacity < totalCapacityNeeded) {
-			count = i; /* Only fit first `i` K/V pairs */
-			more = true;
-			break;
+		if (bufferCapacity < totalCapacityNeeded && fits == count) {
+			fits = i; /* Only fit first `i` K/V pairs */
 		}
 	}
+	jint truncatedCapacity = 0;
+	if (fits < count) {
+		truncatedCapacity = totalCapacityNeeded;
+		count = fits;
+		more = true;
+	}
 
 	int offset = 0;
 
@@ -1653,6 +1659,8 @@ JNIEXPORT void JNICALL Java_com_apple_foundationdb_FutureResults_FutureResults_1
 		memcpy(buffer + offset, kvs[i].value, kvs[i].value_length);
 		offset += kvs[i].value_length;
 	}
+
+	return truncatedCapacity;
 }
 
 void memcpyStringInner(uint8_t* buffer, int& offset, const uint8_t* data, const int& length) {
@@ -1666,7 +1674,7 @@ void memcpyString(uint8_t* buffer, int& offset, const FDBKey& key) {
 	memcpyStringInner(buffer, offset, key.key, key.key_length);
 }
 
-JNIEXPORT void JNICALL
+JNIEXPORT jint JNICALL
 Java_com_apple_foundationdb_FutureMappedResults_FutureMappedResults_1getDirect(JNIEnv* jenv,
                                                                                jobject,
                                                                                jlong future,
@@ -1675,14 +1683,14 @@ Java_com_apple_foundationdb_FutureMappedResults_FutureMappedResults_1getDirect(J
 
 	if (!future) {
 		throwParamNotNull(jenv);
-		return;
+		return 0;
 	}
 
 	uint8_t* buffer = (uint8_t*)jenv->GetDirectBufferAddress(jbuffer);
 	if (!buffer) {
 		if (!jenv->ExceptionOccurred())
 			throwRuntimeEx(jenv, "Error getting handle to native resources");
-		return;
+		return 0;
 	}
 
 	FDBFuture* f = (FDBFuture*)future;
@@ -1692,10 +1700,11 @@ Java_com_apple_foundationdb_FutureMappedResults_FutureMappedResults_1getDirect(J
 	fdb_error_t err = fdb_future_get_mappedkeyvalue_array(f, &kvms, &count, &more);
 	if (err) {
 		safeThrow(jenv, getThrowable(jenv, err));
-		return;
+		return 0;
 	}
 
 	int totalCapacityNeeded = 2 * sizeof(jint);
+	int fits = count;
 	for (int i = 0; i < count; i++) {
 		const FDBMappedKeyValue& kvm = kvms[i];
 		totalCapacityNeeded += kvm.key.key_length + kvm.value.key_length + kvm.getRange.begin.key.key_length +
@@ -1706,12 +1715,16 @@ Java_com_apple_foundationdb_FutureMappedResults_FutureMappedResults_1getDirect(J
 			auto kv = kvm.getRange.data[i];
 			totalCapacityNeeded += kv.key_length + kv.value_length + 2 * sizeof(jint);
 		}
-		if (bufferCapacity < totalCapacityNeeded) {
-			count = i; /* Only fit first `i` K/V pairs */
-			more = true;
-			break;
+		if (bufferCapacity < totalCapacityNeeded && fits == count) {
+			fits = i; /* Only fit first `i` K/V pairs */
 		}
 	}
+	jint truncatedCapacity = 0;
+	if (fits < count) {
+		truncatedCapacity = totalCapacityNeeded;
+		count = fits;
+		more = true;
+	}
 
 	int offset = 0;
 
@@ -1739,6 +1752,8 @@ Java_com_apple_foundationdb_FutureMappedResults_FutureMappedResults_1getDirect(J
 			memcpyStringInner(buffer, offset, kv.value, kv.value_length);
 		}
 	}
+
+	return truncatedCapacity;
 }
 
 JNIEXPORT jlong JNICALL
@@ -0,0 +1,58 @@
+/*
+ * DirectBufferPoolTest.java
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.apple.foundationdb;
+
+import java.nio.ByteBuffer;
+
+import org.junit.jupiter.api.Assertions;
+import org.junit.jupiter.api.Test;
+
+class DirectBufferPoolTest {
+
+	@Test
+	void growsWhenChunksAreTruncated() {
+		DirectBufferPool pool = new DirectBufferPool();
+		pool.resize(8, DirectBufferPool.MIN_BUFFER_SIZE);
+		ByteBuffer outstanding = pool.poll();
+
+		// Chunks that fit do not change the pool
+		pool.recordTruncated(DirectBufferPool.MIN_BUFFER_SIZE);
+		Assertions.assertEquals(DirectBufferPool.MIN_BUFFER_SIZE, pool.getBufferSize());
+
+		pool.recordTruncated(3 * DirectBufferPool.MIN_BUFFER_SIZE);
+		Assertions.assertEquals(4 * DirectBufferPool.MIN_BUFFER_SIZE, pool.getBufferSize());
+
+		// The memory held by the pool stays the same, so there are a quarter as many buffers
+		for (int i = 0; i < 2; i++) {
+			ByteBuffer buffer = pool.poll();
+			Assertions.assertNotNull(buffer);
+			Assertions.assertEquals(4 * DirectBufferPool.MIN_BUFFER_SIZE, buffer.capacity());
+		}
+		Assertions.assertNull(pool.poll());
+
+		// Buffers of the old size are dropped when returned
+		pool.add(outstanding);
+		Assertions.assertNull(pool.poll());
+
+		pool.recordTruncated(Integer.MAX_VALUE);
+		Assertions.assertEquals(DirectBufferPool.MAX_ADAPTIVE_BUFFER_SIZE, pool.getBufferSize());
+		Assertions.assertNotNull(pool.poll());
+	}
+}
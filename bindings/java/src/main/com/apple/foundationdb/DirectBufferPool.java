@@ -40,7 +40,11 @@ class DirectBufferPool {
 	static private final int DEFAULT_NUM_BUFFERS = 128;
 	static private final int DEFAULT_BUFFER_SIZE = 1024 * 512;
 
+	// Buffers only grow up to this size when chunks are truncated to fit them.
+	static public final int MAX_ADAPTIVE_BUFFER_SIZE = 1024 * 1024 * 8;
+
 	private ArrayBlockingQueue<ByteBuffer> buffers;
+	private int currentPoolSize;
 	private int currentBufferCapacity;
 
 	public DirectBufferPool() {
@@ -60,6 +64,7 @@ class DirectBufferPool {
 			throw new IllegalArgumentException("'bufferSize' must be at-least: " + MIN_BUFFER_SIZE + " bytes");
 		}
 		buffers = new ArrayBlockingQueue<>(newPoolSize);
+		currentPoolSize = newPoolSize;
 		currentBufferCapacity = bufferSize;
 		while (buffers.size() < newPoolSize) {
 			ByteBuffer buffer = ByteBuffer.allocateDirect(bufferSize);
@@ -67,6 +72,28 @@ class DirectBufferPool {
 		}
 	}
 
+	/**
+	 * Called when a chunk needing {@code neededCapacity} bytes had to be truncated to fit a
+	 * buffer from this pool. Truncated rows are fetched again by the next request, so the
+	 * buffers are grown to fit such chunks, up to {@link #MAX_ADAPTIVE_BUFFER_SIZE}. The
+	 * number of buffers shrinks accordingly, keeping the memory held by the pool the same.
+	 */
+	public synchronized void recordTruncated(int neededCapacity) {
+		if (neededCapacity <= currentBufferCapacity || currentBufferCapacity >= MAX_ADAPTIVE_BUFFER_SIZE) {
+			return;
+		}
+		int bufferSize = currentBufferCapacity;
+		while (bufferSize < neededCapacity && bufferSize < MAX_ADAPTIVE_BUFFER_SIZE) {
+			bufferSize = Math.min(bufferSize * 2, MAX_ADAPTIVE_BUFFER_SIZE);
+		}
+		long poolBytes = (long)currentPoolSize * currentBufferCapacity;
+		resize((int)Math.max(1, poolBytes / bufferSize), bufferSize);
+	}
+
+	public synchronized int getBufferSize() {
+		return currentBufferCapacity;
+	}
+
 	/**
 	 * Requests a {@link DirectByteBuffer} from our pool. Returns null if pool is empty.
 	 */
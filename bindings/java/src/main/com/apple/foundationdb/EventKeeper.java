@@ -147,6 +147,11 @@ public interface EventKeeper {
 		 * transfer data across the JNI boundary
 		 */
 		RANGE_QUERY_DIRECT_BUFFER_MISS,
+		/**
+		 * The number of times a range query chunk did not fit in a DirectBuffer and
+		 * had to be truncated, leaving the remaining rows to be fetched again
+		 */
+		RANGE_QUERY_DIRECT_BUFFER_TRUNCATED,
 		/**
 		 * The number of direct fetches made during a range query
 		 */
@@ -254,6 +254,7 @@ public class FDB {
 
 	/**
 	 * Resizes the DirectBufferPool with given parameters, which is used by getRange() requests.
+	 * Buffers are later grown if range chunks do not fit them, keeping the total size of the pool.
 	 *
 	 * @param poolSize Number of buffers in pool
 	 * @param bufferSize Size of each buffer in bytes
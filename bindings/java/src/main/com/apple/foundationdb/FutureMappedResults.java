@@ -68,8 +68,11 @@ class FutureMappedResults extends NativeFuture<MappedRangeResultInfo> {
 			if (buffer != null) {
 				try (MappedRangeResultDirectBufferIterator directIterator =
 				         new MappedRangeResultDirectBufferIterator(buffer)) {
-					FutureMappedResults_getDirect(getPtr(), directIterator.getBuffer(),
-					                              directIterator.getBuffer().capacity());
+					int neededCapacity = FutureMappedResults_getDirect(getPtr(), directIterator.getBuffer(),
+					                                                   directIterator.getBuffer().capacity());
+					if (neededCapacity > 0) {
+						recordTruncated(neededCapacity);
+					}
 					return new MappedRangeResult(directIterator);
 				}
 			} else {
@@ -80,8 +83,15 @@ class FutureMappedResults extends NativeFuture<MappedRangeResultInfo> {
 		}
 	}
 
+	private void recordTruncated(int neededCapacity) {
+		if (eventKeeper != null) {
+			eventKeeper.increment(Events.RANGE_QUERY_DIRECT_BUFFER_TRUNCATED);
+		}
+		DirectBufferPool.getInstance().recordTruncated(neededCapacity);
+	}
+
 	private boolean enableDirectBufferQueries = false;
 
 	private native MappedRangeResult FutureMappedResults_get(long cPtr) throws FDBException;
-	private native void FutureMappedResults_getDirect(long cPtr, ByteBuffer buffer, int capacity) throws FDBException;
+	private native int FutureMappedResults_getDirect(long cPtr, ByteBuffer buffer, int capacity) throws FDBException;
 }
@@ -67,7 +67,11 @@ class FutureResults extends NativeFuture<RangeResultInfo> {
 			pointerReadLock.lock();
 			if (buffer != null) {
 				try (RangeResultDirectBufferIterator directIterator = new RangeResultDirectBufferIterator(buffer)) {
-					FutureResults_getDirect(getPtr(), directIterator.getBuffer(), directIterator.getBuffer().capacity());
+					int neededCapacity = FutureResults_getDirect(getPtr(), directIterator.getBuffer(),
+					                                             directIterator.getBuffer().capacity());
+					if (neededCapacity > 0) {
+						recordTruncated(neededCapacity);
+					}
 					return new RangeResult(directIterator);
 				}
 			} else {
@@ -78,9 +82,16 @@ class FutureResults extends NativeFuture<RangeResultInfo> {
 		}
 	}
 
+	private void recordTruncated(int neededCapacity) {
+		if (eventKeeper != null) {
+			eventKeeper.increment(Events.RANGE_QUERY_DIRECT_BUFFER_TRUNCATED);
+		}
+		DirectBufferPool.getInstance().recordTruncated(neededCapacity);
+	}
+
 	private boolean enableDirectBufferQueries = false;
 
 	private native RangeResult FutureResults_get(long cPtr) throws FDBException;
-	private native void FutureResults_getDirect(long cPtr, ByteBuffer buffer, int capacity)
+	private native int FutureResults_getDirect(long cPtr, ByteBuffer buffer, int capacity)
 		throws FDBException;
 }
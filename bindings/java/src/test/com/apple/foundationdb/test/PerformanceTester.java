@@ -34,6 +34,7 @@ import java.util.stream.IntStream;
 import java.util.stream.Stream;
 
 import com.apple.foundationdb.Database;
+import com.apple.foundationdb.FDB;
 import com.apple.foundationdb.KeySelector;
 import com.apple.foundationdb.Transaction;
 import com.apple.foundationdb.TransactionContext;
@@ -60,6 +61,7 @@ public class PerformanceTester extends AbstractTester {
 		PARALLEL_GET("Java Completable API parallel get throughput"),
 		SERIAL_GET("Java Completable API serial get throughput"),
 		GET_RANGE("Java Completable API get_range throughput"),
+		GET_RANGE_DIRECT_BUFFER("Java Completable API get_range throughput with direct buffers"),
 		GET_KEY("Java Completable API get_key throughput"),
 		GET_SINGLE_KEY_RANGE("Java Completable API get_single_key_range throughput"),
 		ALTERNATING_GET_SET("Java Completable API alternating get and set throughput"),
@@ -108,6 +110,7 @@ public class PerformanceTester extends AbstractTester {
 		Tests.PARALLEL_GET.setFunction(db -> parallelGet(db, 10_000));
 		Tests.SERIAL_GET.setFunction(db -> serialGet(db, 2_000));
 		Tests.GET_RANGE.setFunction(db -> getRange(db, 1_000));
+		Tests.GET_RANGE_DIRECT_BUFFER.setFunction(db -> getRangeDirectBuffer(db, 1_000));
 		Tests.GET_KEY.setFunction(db -> getKey(db, 2_000));
 		Tests.GET_SINGLE_KEY_RANGE.setFunction(db -> getSingleKeyRange(db, 2_000));
 		Tests.ALTERNATING_GET_SET.setFunction(db -> alternatingGetSet(db, 2_000));
@@ -334,6 +337,17 @@ public class PerformanceTester extends AbstractTester {
 		});
 	}
 
+	public Double getRangeDirectBuffer(TransactionContext tcx, int count) {
+		FDB fdb = FDB.instance();
+		boolean wasEnabled = fdb.isDirectBufferQueriesEnabled();
+		fdb.enableDirectBufferQuery(true);
+		try {
+			return getRange(tcx, count);
+		} finally {
+			fdb.enableDirectBufferQuery(wasEnabled);
+		}
+	}
+
 	public Double getKey(TransactionContext tcx, int count) {
 		return tcx.run(tr -> {
 			tr.options().setRetryLimit(5);
@@ -142,7 +142,7 @@ class FDBServerProcess(lib.process.Process):
     async def run(self):
         self._args = ["--cluster-file", self._cluster_file, "-p", self._public_address]
         if self._class_:
-            self._args.extend("-c", self._class_)
+            self._args.extend(["-c", self._class_])
         if self._data_path:
             self._args.extend(["--datadir", self._data_path])
         if self._log_path:
@@ -12,14 +12,17 @@ from typing import List, Union
 logger = logging.getLogger(__name__)
 
 FDB_DEFAULT_PORT = 4000
+FDB_DEFAULT_CONFIGURATION = "single memory tenant_mode=optional_experimental"
 
 
-async def configure_fdbserver(cluster_file: str):
+async def configure_fdbserver(
+    cluster_file: str, configuration: str = FDB_DEFAULT_CONFIGURATION
+):
     await lib.fdb_process.wait_fdbserver_up(cluster_file=cluster_file)
     await (
         await lib.fdb_process.FDBCLIProcess(
             cluster_file=cluster_file,
-            commands="configure new single memory tenant_mode=optional_experimental",
+            commands=f"configure new {configuration}",
         ).run()
     ).wait()
     await lib.fdb_process.wait_fdbserver_available(cluster_file=cluster_file)
@@ -30,6 +33,7 @@ async def spawn_fdbservers(
     directory: lib.work_directory.WorkDirectory,
     cluster_file: str,
     port: Union[int, None] = None,
+    fdbserver_path: Union[str, None] = None,
 ):
     fdb_processes = {"handlers": [], "processes": []}
     initial_port = port or FDB_DEFAULT_PORT
@@ -46,6 +50,7 @@ async def spawn_fdbservers(
             port=initial_port,
             data_path=data_path,
             log_path=log_path,
+            fdbserver_overridden_path=fdbserver_path,
         )
         fdb_processes["handlers"].append(fdb_server_process)
         fdb_processes["processes"].append(await fdb_server_process.run())
@@ -61,6 +66,8 @@ class FDBServerLocalCluster:
         work_directory: Union[str, None] = None,
         cluster_file: Union[str, None] = None,
         port: Union[int, None] = None,
+        fdbserver_path: Union[str, None] = None,
+        configuration: str = FDB_DEFAULT_CONFIGURATION,
     ):
         """Constructor
 
@@ -68,11 +75,15 @@ class FDBServerLocalCluster:
         :param Union[str, None] work_directory: _description_, defaults to None
         :param Union[str, None] cluster_file: _description_, defaults to None
         :param Union[int, None] port: _description_, defaults to None
+        :param Union[str, None] fdbserver_path: fdbserver to run, defaults to the one set in lib.fdb_process
+        :param str configuration: Arguments to "configure new"
         """
         self._num_processes: int = num_processes
         self._work_directory: Union[str, None] = work_directory
         self._cluster_file: Union[str, None] = cluster_file
         self._port: int = port
+        self._fdbserver_path: Union[str, None] = fdbserver_path
+        self._configuration: str = configuration
 
         self._processes = None
 
@@ -125,14 +136,18 @@ class FDBServerLocalCluster:
         logger.info(f"Work directory: {directory.base_directory}")
         if not self._cluster_file:
             self._cluster_file = lib.cluster_file.generate_fdb_cluster_file(
-                directory.base_directory
+                directory.base_directory, port=self._port
             )
 
         self._processes = await spawn_fdbservers(
-            self._num_processes, directory, self.cluster_file, self._port
+            self._num_processes,
+            directory,
+            self.cluster_file,
+            self._port,
+            self._fdbserver_path,
         )
 
-        await configure_fdbserver(self._cluster_file)
+        await configure_fdbserver(self._cluster_file, self._configuration)
         logger.info("FoundationDB ready to use")
 
     async def __aenter__(self):
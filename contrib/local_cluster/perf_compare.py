@@ -0,0 +1,455 @@
+#! /usr/bin/env python3
+""" Compares the performance of two fdbserver builds
+
+Starts identical local clusters with each fdbserver, runs a fixed suite of mako and ReadWrite/Throughput workloads
+against them, and reports the difference in throughput and p50/p99/p99.9 latency with confidence intervals. Exits with
+a non-zero status if the candidate build is worse than the baseline by more than the thresholds.
+"""
+
+import argparse
+import asyncio
+import dataclasses
+import glob
+import json
+import logging
+import math
+import os
+import os.path
+import statistics
+import sys
+import tempfile
+
+import lib.fdb_process
+import lib.local_cluster
+import lib.process
+
+from typing import Dict, List, Tuple
+
+logger = logging.getLogger("perf_compare")
+
+SCRIPT_DIR = os.path.split(os.path.abspath(__file__))[0]
+BINARY_DIR = SCRIPT_DIR
+DEFAULT_FDBCLI_PATH = os.path.join(BINARY_DIR, "fdbcli")
+DEFAULT_MAKO_PATH = os.path.join(BINARY_DIR, "mako")
+# This is the LD_LIBRARY_PATH, so the file name is not included
+DEFAULT_LIBFDB_PATH = os.path.abspath(os.path.join(BINARY_DIR))
+
+DEFAULT_NUM_PROCESSES = 4
+DEFAULT_REPETITIONS = 5
+DEFAULT_CONFIGURATION = "single ssd-redwood-1"
+DEFAULT_THROUGHPUT_THRESHOLD = 5.0
+DEFAULT_LATENCY_THRESHOLD = 10.0
+DEFAULT_TIMEOUT_PER_TEST = 600.0
+
+# The measurements taken from every test, and whether a higher value is better
+MEASUREMENTS = {
+    "throughput": True,
+    "p50": False,
+    "p99": False,
+    "p99.9": False,
+}
+
+# Two-sided 95% critical values of Student's t distribution by degrees of freedom
+T_CRITICAL_95 = [
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+]
+
+
+def _t_critical(degrees_of_freedom: float) -> float:
+    if degrees_of_freedom < 1:
+        return T_CRITICAL_95[0]
+    if degrees_of_freedom > len(T_CRITICAL_95):
+        return 1.960
+    return T_CRITICAL_95[int(degrees_of_freedom) - 1]
+
+
+def _setup_logs(log_level: int = logging.INFO):
+    log_format = logging.Formatter(
+        "%(asctime)s | %(name)20s :: %(levelname)-8s :: %(message)s"
+    )
+
+    logger.handlers.clear()
+
+    stdout_handler = logging.StreamHandler(stream=sys.stderr)
+    stdout_handler.setLevel(log_level)
+    stdout_handler.setFormatter(log_format)
+
+    logger.addHandler(stdout_handler)
+    logger.setLevel(log_level)
+
+    lib_logger = logging.getLogger("lib")
+    lib_logger.addHandler(stdout_handler)
+    lib_logger.setLevel(log_level)
+
+
+def _setup_args() -> argparse.Namespace:
+    """Parse the command line arguments"""
+    parser = argparse.ArgumentParser(os.path.basename(__file__))
+    parser.add_argument(
+        "--baseline", type=str, required=True, help="Path to the baseline fdbserver"
+    )
+    parser.add_argument(
+        "--candidate", type=str, required=True, help="Path to the candidate fdbserver"
+    )
+    parser.add_argument(
+        "--fdbcli-path", type=str, default=DEFAULT_FDBCLI_PATH, help="Path to fdbcli"
+    )
+    parser.add_argument(
+        "--mako-path", type=str, default=DEFAULT_MAKO_PATH, help="Path to mako"
+    )
+    parser.add_argument(
+        "--libfdb-path",
+        type=str,
+        default=DEFAULT_LIBFDB_PATH,
+        help="Path to libfdb_c.so. NOTE: The file name should not be included.",
+    )
+    parser.add_argument(
+        "-n",
+        "--num-processes",
+        type=int,
+        default=DEFAULT_NUM_PROCESSES,
+        help="Number of fdbserver processes in each cluster",
+    )
+    parser.add_argument(
+        "--configuration",
+        type=str,
+        default=DEFAULT_CONFIGURATION,
+        help="Arguments to 'configure new' for each cluster",
+    )
+    parser.add_argument(
+        "--repetitions",
+        type=int,
+        default=DEFAULT_REPETITIONS,
+        help="Number of times each test is run against each build",
+    )
+    parser.add_argument(
+        "--throughput-threshold",
+        type=float,
+        default=DEFAULT_THROUGHPUT_THRESHOLD,
+        help="Largest tolerated throughput loss, in percent",
+    )
+    parser.add_argument(
+        "--latency-threshold",
+        type=float,
+        default=DEFAULT_LATENCY_THRESHOLD,
+        help="Largest tolerated latency increase, in percent",
+    )
+    parser.add_argument(
+        "--test-timeout",
+        type=float,
+        default=DEFAULT_TIMEOUT_PER_TEST,
+        help="Timeout for each single test",
+    )
+    parser.add_argument(
+        "--tests", type=str, nargs="*", default=None, help="Run only these tests"
+    )
+    parser.add_argument("-W", "--work-dir", type=str, default=None, help="Work directory")
+    parser.add_argument(
+        "--report", type=str, default=None, help="Write the comparison as JSON here"
+    )
+    parser.add_argument(
+        "--debug", action="store_true", default=False, help="Debug logging"
+    )
+    return parser.parse_args()
+
+
+@dataclasses.dataclass
+class PerfTest:
+    """A test in the suite, which measures throughput in transactions/sec and latency in milliseconds"""
+
+    name: str
+
+    async def run(self, args, cluster_file: str, work_dir: str) -> Dict[str, float]:
+        raise NotImplementedError()
+
+
+async def _run_to_completion(process: lib.process.Process, timeout: float):
+    handle = await process.run()
+    try:
+        stdout, stderr = await asyncio.wait_for(handle.communicate(), timeout)
+    except asyncio.TimeoutError:
+        handle.kill()
+        raise RuntimeError(f"{process._executable} timed out after {timeout} seconds")
+    if handle.returncode != 0:
+        raise RuntimeError(
+            f"{process._executable} exited with {handle.returncode}: {stderr.decode()}"
+        )
+    return stdout.decode()
+
+
+@dataclasses.dataclass
+class MakoTest(PerfTest):
+    """Populates the database with mako, then runs a mako workload"""
+
+    rows: int
+    arguments: List[str]
+
+    async def run(self, args, cluster_file: str, work_dir: str) -> Dict[str, float]:
+        env = dict(os.environ, LD_LIBRARY_PATH=args.libfdb_path)
+        common = ["--cluster", cluster_file, "--rows", str(self.rows)]
+        await _run_to_completion(
+            lib.process.Process(
+                args.mako_path, common + ["--mode", "build"], env=env
+            ),
+            args.test_timeout,
+        )
+
+        report_path = os.path.join(work_dir, f"{self.name}.json")
+        await _run_to_completion(
+            lib.process.Process(
+                args.mako_path,
+                common
+                + ["--mode", "run", f"--json_report={report_path}"]
+                + self.arguments,
+                env=env,
+            ),
+            args.test_timeout,
+        )
+        with open(report_path) as stream:
+            results = json.load(stream)["results"]
+
+        # mako reports latencies in microseconds
+        return {
+            "throughput": float(results["overallTPS"]),
+            "p50": results["medianLatency"]["TRANSACTION"] / 1000.0,
+            "p99": results["p99Latency"]["TRANSACTION"] / 1000.0,
+            "p99.9": results["p99.9Latency"]["TRANSACTION"] / 1000.0,
+        }
+
+
+@dataclasses.dataclass
+class WorkloadTest(PerfTest):
+    """Runs an fdbserver workload with the multitest role of the build under test"""
+
+    spec: str
+
+    async def run(self, args, cluster_file: str, work_dir: str) -> Dict[str, float]:
+        spec_path = os.path.join(work_dir, f"{self.name}.txt")
+        with open(spec_path, "w") as stream:
+            stream.write(self.spec)
+        log_dir = os.path.join(work_dir, f"{self.name}-logs")
+        os.makedirs(log_dir, exist_ok=True)
+
+        tester = lib.fdb_process.FDBServerProcess(
+            cluster_file=cluster_file,
+            port=args.tester_port,
+            class_="test",
+            log_path=log_dir,
+            fdbserver_overridden_path=args.fdbserver,
+        )
+        await tester.run()
+        try:
+            await _run_to_completion(
+                lib.process.Process(
+                    args.fdbserver,
+                    [
+                        "-r", "multitest",
+                        "-f", spec_path,
+                        "-C", cluster_file,
+                        "--num-testers", "1",
+                        "--logdir", log_dir,
+                        "--trace-format", "json",
+                    ],
+                ),
+                args.test_timeout,
+            )
+        finally:
+            tester.kill()
+
+        metrics = {}
+        for path in glob.glob(os.path.join(log_dir, "*.json")):
+            with open(path) as stream:
+                for line in stream:
+                    event = json.loads(line)
+                    if event.get("Type") == "Metric":
+                        metrics[event["Name"]] = float(event["Value"])
+
+        return {
+            "throughput": metrics["Transactions/sec"],
+            "p50": metrics["Median Latency (ms, averaged)"],
+            "p99": metrics["99% Latency (ms, averaged)"],
+            "p99.9": metrics["99.9% Latency (ms, averaged)"],
+        }
+
+
+_WORKLOAD_SPEC_SUFFIX = """    nodeCount=1000000
+    keyBytes=16
+    valueBytes=96
+    timeout=100000.0
+    databasePingDelay=100000.0
+"""
+
+SUITE: List[PerfTest] = [
+    MakoTest(
+        "mako_read_heavy",
+        rows=1000000,
+        arguments=["--transaction", "g9u1", "--seconds", "60", "--threads", "8"],
+    ),
+    MakoTest(
+        "mako_write_heavy",
+        rows=1000000,
+        arguments=["--transaction", "u10", "--seconds", "60", "--threads", "8"],
+    ),
+    MakoTest(
+        "mako_range_read",
+        rows=1000000,
+        arguments=["--transaction", "gr10:100", "--seconds", "60", "--threads", "8"],
+    ),
+    WorkloadTest(
+        "readwrite_90_10",
+        spec="""testTitle=ReadWrite90_10
+    testName=ReadWrite
+    testDuration=60.0
+    transactionsPerSecond=5000
+    readsPerTransactionA=10
+    writesPerTransactionA=0
+    readsPerTransactionB=9
+    writesPerTransactionB=1
+    alpha=0.1
+"""
+        + _WORKLOAD_SPEC_SUFFIX,
+    ),
+    WorkloadTest(
+        "throughput_mixed",
+        spec="""testTitle=ThroughputMixed
+    testName=Throughput
+    testDuration=60.0
+    targetLatency=0.05
+"""
+        + _WORKLOAD_SPEC_SUFFIX,
+    ),
+]
+
+
+async def _run_suite(
+    args, tests: List[PerfTest], fdbserver: str, work_dir: str
+) -> Dict[str, Dict[str, float]]:
+    """Runs each test against a fresh cluster running fdbserver"""
+    results = {}
+    for test in tests:
+        test_dir = tempfile.mkdtemp(prefix=f"{test.name}-", dir=work_dir)
+        async with lib.local_cluster.FDBServerLocalCluster(
+            args.num_processes,
+            test_dir,
+            port=args.port,
+            fdbserver_path=fdbserver,
+            configuration=args.configuration,
+        ) as cluster:
+            args.fdbserver = fdbserver
+            results[test.name] = await test.run(args, cluster.cluster_file, test_dir)
+        # Let the ports be freed before the next cluster starts
+        for process in cluster.processes:
+            await process.wait()
+        logger.info(f"{os.path.basename(fdbserver)} {test.name}: {results[test.name]}")
+    return results
+
+
+def _mean_confidence_interval(samples: List[float]) -> Tuple[float, float]:
+    mean = statistics.mean(samples)
+    if len(samples) < 2:
+        return mean, math.inf
+    return mean, _t_critical(len(samples) - 1) * statistics.stdev(samples) / math.sqrt(len(samples))
+
+
+def _compare(baseline: List[float], candidate: List[float]) -> Tuple[float, float, float]:
+    """Returns the relative change of the candidate's mean from the baseline's with the bounds of its 95% confidence
+    interval (Welch's t interval on the difference of the means), all in percent"""
+    base_mean = statistics.mean(baseline)
+    diff = statistics.mean(candidate) - base_mean
+    if len(baseline) < 2 or len(candidate) < 2 or base_mean == 0:
+        return 100 * diff / base_mean if base_mean else 0.0, -math.inf, math.inf
+
+    base_var = statistics.variance(baseline) / len(baseline)
+    cand_var = statistics.variance(candidate) / len(candidate)
+    std_error = math.sqrt(base_var + cand_var)
+    if std_error == 0:
+        change = 100 * diff / base_mean
+        return change, change, change
+    degrees_of_freedom = (base_var + cand_var) ** 2 / (
+        base_var**2 / (len(baseline) - 1) + cand_var**2 / (len(candidate) - 1)
+    )
+    margin = _t_critical(degrees_of_freedom) * std_error
+    return 100 * diff / base_mean, 100 * (diff - margin) / base_mean, 100 * (diff + margin) / base_mean
+
+
+def _report(args, baseline_runs, candidate_runs, tests: List[PerfTest]) -> Tuple[dict, bool]:
+    """Builds the comparison report; a measurement regresses when it is worse than the threshold and the whole
+    confidence interval is on the worse side of no change"""
+    report = {}
+    regressed = False
+    print(
+        f"{'test':<20} {'measurement':<12} {'baseline':>20} {'candidate':>20} {'change % (95% CI)':>30}"
+    )
+    for test in tests:
+        report[test.name] = {}
+        for measurement, higher_is_better in MEASUREMENTS.items():
+            baseline = [run[test.name][measurement] for run in baseline_runs]
+            candidate = [run[test.name][measurement] for run in candidate_runs]
+            base_mean, base_margin = _mean_confidence_interval(baseline)
+            cand_mean, cand_margin = _mean_confidence_interval(candidate)
+            change, low, high = _compare(baseline, candidate)
+
+            if higher_is_better:
+                worse = change < -args.throughput_threshold and high < 0
+            else:
+                worse = change > args.latency_threshold and low > 0
+            regressed = regressed or worse
+
+            report[test.name][measurement] = {
+                "baseline": baseline,
+                "candidate": candidate,
+                "change_percent": change,
+                "change_ci_percent": [low, high],
+                "regression": worse,
+            }
+            print(
+                f"{test.name:<20} {measurement:<12} "
+                f"{f'{base_mean:.2f} +/- {base_margin:.2f}':>20} "
+                f"{f'{cand_mean:.2f} +/- {cand_margin:.2f}':>20} "
+                f"{f'{change:+.1f} ({low:+.1f}, {high:+.1f})':>30}"
+                f"{' REGRESSION' if worse else ''}"
+            )
+    return report, regressed
+
+
+async def _run(args, tests: List[PerfTest]) -> Tuple[list, list]:
+    work_dir = args.work_dir or tempfile.mkdtemp()
+    logger.info(f"Work directory: {work_dir}")
+    baseline_runs = []
+    candidate_runs = []
+    # Alternate between the builds so that drift in the machine affects both alike
+    for repetition in range(args.repetitions):
+        logger.info(f"Repetition {repetition + 1} of {args.repetitions}")
+        baseline_runs.append(await _run_suite(args, tests, args.baseline, work_dir))
+        candidate_runs.append(await _run_suite(args, tests, args.candidate, work_dir))
+    return baseline_runs, candidate_runs
+
+
+def main():
+    args = _setup_args()
+    _setup_logs(logging.DEBUG if args.debug else logging.INFO)
+
+    if args.repetitions < 2:
+        raise RuntimeError("At least 2 repetitions are needed for confidence intervals")
+
+    lib.fdb_process.set_fdbcli_path(args.fdbcli_path)
+    args.port = lib.local_cluster.FDB_DEFAULT_PORT
+    args.tester_port = args.port + args.num_processes
+
+    tests = [test for test in SUITE if args.tests is None or test.name in args.tests]
+    baseline_runs, candidate_runs = asyncio.get_event_loop().run_until_complete(
+        _run(args, tests)
+    )
+
+    report, regressed = _report(args, baseline_runs, candidate_runs, tests)
+    if args.report:
+        with open(args.report, "w") as stream:
+            json.dump(report, stream, indent=2)
+
+    return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
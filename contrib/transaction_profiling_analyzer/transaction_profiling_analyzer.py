@@ -811,6 +811,46 @@ class WriteCounter(object):
         return results
 
 
+class ReplayWriter(object):
+    """
+    Writes the sampled transactions as JSON lines that mako replays with --replay_file. Keys are hex encoded and
+    only the sizes of written values are kept.
+    """
+
+    def __init__(self, path):
+        self.out = open(path, "w")
+        self.count = 0
+
+    def process(self, transaction_info):
+        events = [transaction_info.get_version, transaction_info.commit] + transaction_info.gets + \
+            transaction_info.get_ranges
+        starts = [e.start_timestamp for e in events if e is not None]
+        if not starts:
+            return
+        sets = []
+        clears = []
+        if transaction_info.commit:
+            for mutation in transaction_info.commit.mutations:
+                if mutation.code == MutationType.SET_VALUE:
+                    sets.append([mutation.param_one.hex(), len(mutation.param_two)])
+                elif mutation.code == MutationType.CLEAR_RANGE:
+                    clears.append([mutation.param_one.hex(), mutation.param_two.hex()])
+        record = {
+            "start": min(starts),
+            "gets": [g.key.hex() for g in transaction_info.gets],
+            "get_ranges": [[r.key_range.start_key.hex(), r.key_range.end_key.hex()]
+                           for r in transaction_info.get_ranges],
+            "sets": sets,
+            "clears": clears,
+        }
+        self.out.write(json.dumps(record) + "\n")
+        self.count += 1
+
+    def close(self):
+        self.out.close()
+        logger.info("Wrote %d transactions for replay" % self.count)
+
+
 def connect(cluster_file=None):
     db = fdb.open(cluster_file=cluster_file)
     return db
@@ -820,6 +860,8 @@ def main():
     parser = argparse.ArgumentParser(description="TransactionProfilingAnalyzer")
     parser.add_argument("-C", "--cluster-file", type=str, help="Cluster file")
     parser.add_argument("--full-output", action="store_true", help="Print full output from mutations")
+    parser.add_argument("--replay-output", type=str,
+                        help="Write the transactions to this file in the format replayed by mako --replay_file")
     parser.add_argument("--filter-get-version", action="store_true",
                         help="Include get_version type. If no filter args are given all will be returned.")
     parser.add_argument("--filter-get", action="store_true",
@@ -882,7 +924,9 @@ def main():
     else:
         read_counter = None
 
-    full_output = args.full_output or (args.num_buckets is not None)
+    replay_writer = ReplayWriter(args.replay_output) if args.replay_output else None
+
+    full_output = args.full_output or (args.num_buckets is not None) or (replay_writer is not None)
 
     if args.min_timestamp:
         min_timestamp = args.min_timestamp
@@ -918,13 +962,18 @@ def main():
 
     for info in loader.fetch_transaction_info():
         if info.has_types():
-            if not write_counter and not read_counter:
+            if not write_counter and not read_counter and not replay_writer:
                 print(info.to_json())
             else:
                 if write_counter:
                     write_counter.process(info)
                 if read_counter:
                     read_counter.process(info)
+                if replay_writer:
+                    replay_writer.process(info)
+
+    if replay_writer:
+        replay_writer.close()
 
     def print_top(top, total, context):
         if top:
@@ -172,28 +172,14 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 		// Returns true if new mutations has been saved.
 		bool decodeBlock(const Standalone<StringRef>& buf, int len, Version minVersion, Version maxVersion) {
 			StringRef block(buf.begin(), len);
-			StringRefReader reader(block, restore_corrupted_data());
 			int count = 0, inserted = 0;
 			Version msgVersion = invalidVersion;
 
 			try {
-				// Read block header
-				if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-					throw restore_unsupported_file_version();
-
-				while (1) {
-					// If eof reached or first key len bytes is 0xFF then end of block was reached.
-					if (reader.eof() || *reader.rptr == 0xFF)
-						break;
-
-					// Deserialize messages written in saveMutationsToFile().
-					msgVersion = bigEndian64(reader.consume<Version>());
-					uint32_t sub = bigEndian32(reader.consume<uint32_t>());
-					int msgSize = bigEndian32(reader.consume<int>());
-					const uint8_t* message = reader.consume(msgSize);
-
-					ArenaReader rd(
-					    buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+				Arena arena = buf.arena();
+				for (auto const& msg : fileBackup::decodePartitionedLogBlock(block, arena, minVersion)) {
+					msgVersion = msg.version.version;
+					ArenaReader rd(buf.arena(), msg.message, AssumeVersion(g_network->protocolVersion()));
 					MutationRef m;
 					rd >> m;
 					count++;
@@ -206,8 +192,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 						break; // skip
 					}
 					if (msgVersion >= minVersion) {
-						mutations.emplace_back(
-						    LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), buf.arena());
+						mutations.emplace_back(msg.version, msg.message, buf.arena());
 						inserted++;
 					}
 				}
@@ -217,7 +202,6 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 				    .detail("Name", fd->getFilename())
 				    .detail("Count", count)
 				    .detail("Insert", inserted)
-				    .detail("BlockOffset", reader.rptr - buf.begin())
 				    .detail("Total", mutations.size())
 				    .detail("EOF", eof)
 				    .detail("Version", msgVersion)
@@ -228,9 +212,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 				    .error(e)
 				    .detail("Filename", fd->getFilename())
 				    .detail("BlockOffset", offset)
-				    .detail("BlockLen", len)
-				    .detail("ErrorRelativeOffset", reader.rptr - buf.begin())
-				    .detail("ErrorAbsoluteOffset", reader.rptr - buf.begin() + offset);
+				    .detail("BlockLen", len);
 				throw;
 			}
 		}
@@ -30,7 +30,48 @@ Future<int64_t> AsyncFileS3BlobStoreRead::size() const {
 	return m_size;
 }
 
+ACTOR static Future<int> readPart(Reference<AsyncFileS3BlobStoreRead> f,
+                                  FlowLock* lock,
+                                  uint8_t* data,
+                                  int length,
+                                  int64_t offset) {
+	wait(lock->take());
+	state FlowLock::Releaser releaser(*lock);
+	int rlen = wait(f->m_bstore->readObject(f->m_bucket, f->m_object, data, length, offset));
+	return rlen;
+}
+
+// Reads a range larger than read_block_size as parallel ranged requests of read_block_size
+ACTOR static Future<int> readParallel(Reference<AsyncFileS3BlobStoreRead> f,
+                                      uint8_t* data,
+                                      int length,
+                                      int64_t offset) {
+	// Requests past the end of the object would fail, so stop at its size
+	int64_t size = wait(f->size());
+	state FlowLock lock(f->m_bstore->knobs.concurrent_reads_per_file);
+	state std::vector<Future<int>> parts;
+	int partSize = f->m_bstore->knobs.read_block_size;
+	int toRead = std::max<int64_t>(0, std::min<int64_t>(length, size - offset));
+	for (int pos = 0; pos < toRead; pos += partSize) {
+		parts.push_back(readPart(f, &lock, data + pos, std::min(partSize, toRead - pos), offset + pos));
+	}
+	if (S3BlobStoreEndpoint::blobStats) {
+		S3BlobStoreEndpoint::blobStats->parallelReadParts += parts.size();
+	}
+	wait(waitForAll(parts));
+
+	int total = 0;
+	for (auto const& p : parts) {
+		total += p.get();
+	}
+	return total;
+}
+
 Future<int> AsyncFileS3BlobStoreRead::read(void* data, int length, int64_t offset) {
+	if (length > m_bstore->knobs.read_block_size && m_bstore->knobs.read_block_size > 0 &&
+	    m_bstore->knobs.concurrent_reads_per_file > 1) {
+		return readParallel(Reference<AsyncFileS3BlobStoreRead>::addRef(this), (uint8_t*)data, length, offset);
+	}
 	return m_bstore->readObject(m_bucket, m_object, data, length, offset);
 }
 
@@ -492,7 +492,8 @@ Reference<BlobCipherKey> BlobCipherKeyIdCache::insertBaseCipherKey(const Encrypt
 			    .detail("DomainId", domainId);
 #endif
 
-			// Key is already present; nothing more to do.
+			// Key is already present. Without moving its refresh time, every read of it would fetch it again.
+			latestCipherKey->extendValidity(refreshAt, expireAt);
 			return latestCipherKey;
 		} else {
 			TraceEvent(SevInfo, "BlobCipherUpdatetBaseCipherKey")
@@ -862,6 +863,15 @@ void EncryptBlobCipherAes265Ctr::init() {
 	}
 }
 
+void EncryptBlobCipherAes265Ctr::resetIV(const uint8_t* cipherIV, const int ivLen) {
+	ASSERT_EQ(ivLen, AES_256_IV_LENGTH);
+	memcpy(&iv[0], cipherIV, ivLen);
+	// Passing a null cipher and key reuses the ones the context was initialized with
+	if (EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) != 1) {
+		throw encrypt_ops_error();
+	}
+}
+
 template <class Params>
 void EncryptBlobCipherAes265Ctr::setCipherAlgoHeaderWithAuthV1(const uint8_t* ciphertext,
                                                                const int ciphertextLen,
@@ -2382,6 +2392,52 @@ void testKeyCacheCleanup(const int minDomainId, const int maxDomainId) {
 	TraceEvent("BlobCipherTestKeyCacheCleanupDone");
 }
 
+// Validate that a cipher restarted with a new IV produces the same ciphertext as a cipher created with that IV
+void testResetIV(const int minDomainId) {
+	Reference<BlobCipherKeyCache> cipherKeyCache = BlobCipherKeyCache::getInstance();
+	Reference<BlobCipherKey> cipherKey = cipherKeyCache->getLatestCipherKey(minDomainId);
+	Reference<BlobCipherKey> headerCipherKey = cipherKeyCache->getLatestCipherKey(ENCRYPT_HEADER_DOMAIN_ID);
+	const int bufLen = deterministicRandom()->randomInt(786, 2127) + 512;
+	uint8_t orgData[bufLen];
+	deterministicRandom()->randomBytes(&orgData[0], bufLen);
+
+	Arena arena;
+	uint8_t iv[AES_256_IV_LENGTH];
+	deterministicRandom()->randomBytes(&iv[0], AES_256_IV_LENGTH);
+	EncryptBlobCipherAes265Ctr reused(cipherKey,
+	                                  headerCipherKey,
+	                                  iv,
+	                                  AES_256_IV_LENGTH,
+	                                  EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_SINGLE,
+	                                  BlobCipherMetrics::TEST);
+	BlobCipherEncryptHeader header;
+	reused.encrypt(&orgData[0], bufLen, &header, arena);
+
+	deterministicRandom()->randomBytes(&iv[0], AES_256_IV_LENGTH);
+	reused.resetIV(iv, AES_256_IV_LENGTH);
+	BlobCipherEncryptHeader reusedHeader;
+	Reference<EncryptBuf> reusedEncrypted = reused.encrypt(&orgData[0], bufLen, &reusedHeader, arena);
+
+	EncryptBlobCipherAes265Ctr fresh(cipherKey,
+	                                 headerCipherKey,
+	                                 iv,
+	                                 AES_256_IV_LENGTH,
+	                                 EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_SINGLE,
+	                                 BlobCipherMetrics::TEST);
+	BlobCipherEncryptHeader freshHeader;
+	Reference<EncryptBuf> freshEncrypted = fresh.encrypt(&orgData[0], bufLen, &freshHeader, arena);
+
+	ASSERT_EQ(memcmp(&reusedHeader.iv[0], &iv[0], AES_256_IV_LENGTH), 0);
+	ASSERT_EQ(memcmp(reusedEncrypted->begin(), freshEncrypted->begin(), bufLen), 0);
+	ASSERT_EQ(memcmp(&reusedHeader, &freshHeader, sizeof(BlobCipherEncryptHeader)), 0);
+
+	DecryptBlobCipherAes256Ctr decryptor(cipherKey, headerCipherKey, &reusedHeader.iv[0], BlobCipherMetrics::TEST);
+	Reference<EncryptBuf> decrypted = decryptor.decrypt(reusedEncrypted->begin(), bufLen, reusedHeader, arena);
+	ASSERT_EQ(memcmp(decrypted->begin(), &orgData[0], bufLen), 0);
+
+	TraceEvent("BlobCipherTestResetIVDone");
+}
+
 TEST_CASE("/blobCipher") {
 	DomainKeyMap domainKeyMap;
 	auto& g_knobs = IKnobCollection::getMutableGlobalKnobCollection();
@@ -2420,6 +2476,7 @@ TEST_CASE("/blobCipher") {
 	testConfigurableEncryptionNoAuthMode(minDomainId);
 	testConfigurableEncryptionSingleAuthMode<AesCtrWithHmacParams>(minDomainId);
 	testConfigurableEncryptionSingleAuthMode<AesCtrWithCmacParams>(minDomainId);
+	testResetIV(minDomainId);
 	testKeyCacheCleanup(minDomainId, maxDomainId);
 
 	return Void();
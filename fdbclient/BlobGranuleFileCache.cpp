@@ -0,0 +1,223 @@
+/*
+ * BlobGranuleFileCache.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/BlobGranuleFileCache.h"
+
+#include <cstdio>
+#include <memory>
+
+#include "fdbclient/Knobs.h"
+#include "flow/Platform.h"
+#include "flow/Trace.h"
+#include "flow/UnitTest.h"
+#include "flow/xxhash.h"
+#include "fmt/format.h"
+
+static const std::string cachedFileExtension = ".bgf";
+static const std::string tempFileExtension = ".part";
+
+BlobGranuleFileCache* BlobGranuleFileCache::get() {
+	static std::unique_ptr<BlobGranuleFileCache> cache = []() -> std::unique_ptr<BlobGranuleFileCache> {
+		if (CLIENT_KNOBS->BG_FILE_CACHE_DIR.empty()) {
+			return nullptr;
+		}
+		try {
+			return std::make_unique<BlobGranuleFileCache>(CLIENT_KNOBS->BG_FILE_CACHE_DIR,
+			                                              CLIENT_KNOBS->BG_FILE_CACHE_BYTES);
+		} catch (Error& e) {
+			TraceEvent(SevWarnAlways, "BlobGranuleFileCacheDisabled")
+			    .error(e)
+			    .detail("Directory", CLIENT_KNOBS->BG_FILE_CACHE_DIR);
+			return nullptr;
+		}
+	}();
+	return cache.get();
+}
+
+BlobGranuleFileCache::BlobGranuleFileCache(std::string const& directory, int64_t capacity)
+  : directory(directory), capacity(capacity), hits(0), misses(0), evictions(0), bytes(0), tempFiles(0) {
+	platform::createDirectory(directory);
+	for (auto const& name : platform::listFiles(directory, tempFileExtension)) {
+		deleteFile(pathFor(name));
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto const& name : platform::listFiles(directory, cachedFileExtension)) {
+		addLocked(name, fileSize(pathFor(name)));
+	}
+	TraceEvent("BlobGranuleFileCacheOpened")
+	    .detail("Directory", directory)
+	    .detail("Capacity", capacity)
+	    .detail("Files", entries.size())
+	    .detail("Bytes", bytes.load());
+}
+
+std::string BlobGranuleFileCache::nameFor(StringRef filename, int64_t offset, int64_t length) const {
+	// Granule file names are paths in the blob store, so name the cached range by a hash of the name instead
+	XXH128_hash_t h = XXH3_128bits(filename.begin(), filename.size());
+	return fmt::format("{:016x}{:016x}-{}-{}{}", h.high64, h.low64, offset, length, cachedFileExtension);
+}
+
+std::string BlobGranuleFileCache::pathFor(std::string const& name) const {
+	return joinPath(directory, name);
+}
+
+void BlobGranuleFileCache::addLocked(std::string const& name, int64_t size) {
+	auto it = entries.find(name);
+	if (it != entries.end()) {
+		bytes -= it->second->size;
+		lru.erase(it->second);
+	}
+	entries[name] = lru.insert(lru.end(), Entry{ name, size });
+	bytes += size;
+
+	while (bytes > capacity && !lru.empty()) {
+		Entry& victim = lru.front();
+		::remove(pathFor(victim.name).c_str());
+		bytes -= victim.size;
+		++evictions;
+		entries.erase(victim.name);
+		lru.pop_front();
+	}
+}
+
+void BlobGranuleFileCache::eraseLocked(std::string const& name) {
+	auto it = entries.find(name);
+	if (it != entries.end()) {
+		bytes -= it->second->size;
+		lru.erase(it->second);
+		entries.erase(it);
+	}
+	::remove(pathFor(name).c_str());
+}
+
+Optional<std::string> BlobGranuleFileCache::lookup(StringRef filename, int64_t offset, int64_t length) {
+	std::string name = nameFor(filename, offset, length);
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(name);
+	if (it == entries.end()) {
+		++misses;
+		return Optional<std::string>();
+	}
+	++hits;
+	lru.splice(lru.end(), lru, it->second);
+	return pathFor(name);
+}
+
+std::string BlobGranuleFileCache::tempPathFor(StringRef filename, int64_t offset, int64_t length) {
+	return pathFor(fmt::format("{}.{}{}", nameFor(filename, offset, length), ++tempFiles, tempFileExtension));
+}
+
+void BlobGranuleFileCache::insert(StringRef filename,
+                                  int64_t offset,
+                                  int64_t length,
+                                  std::string const& tempPath) {
+	std::string name = nameFor(filename, offset, length);
+	std::lock_guard<std::mutex> lock(mutex);
+	if (::rename(tempPath.c_str(), pathFor(name).c_str()) != 0) {
+		::remove(tempPath.c_str());
+		return;
+	}
+	addLocked(name, length);
+}
+
+void BlobGranuleFileCache::erase(StringRef filename, int64_t offset, int64_t length) {
+	std::string name = nameFor(filename, offset, length);
+	std::lock_guard<std::mutex> lock(mutex);
+	eraseLocked(name);
+}
+
+Optional<Standalone<StringRef>> BlobGranuleFileCache::read(StringRef filename, int64_t offset, int64_t length) {
+	Optional<std::string> path = lookup(filename, offset, length);
+	if (!path.present()) {
+		return Optional<Standalone<StringRef>>();
+	}
+	// The file may be evicted by another thread at any point, which is no different from a miss
+	Standalone<StringRef> data = makeString(length);
+	FILE* f = fopen(path.get().c_str(), "rb");
+	size_t readSize = f ? fread(mutateString(data), 1, length, f) : 0;
+	if (f) {
+		fclose(f);
+	}
+	if (readSize != length) {
+		erase(filename, offset, length);
+		--hits;
+		++misses;
+		return Optional<Standalone<StringRef>>();
+	}
+	return data;
+}
+
+void BlobGranuleFileCache::write(StringRef filename, int64_t offset, int64_t length, StringRef data) {
+	ASSERT(data.size() == length);
+	if (length > capacity) {
+		return;
+	}
+	std::string tempPath = tempPathFor(filename, offset, length);
+	FILE* f = fopen(tempPath.c_str(), "wb");
+	if (!f) {
+		return;
+	}
+	bool written = fwrite(data.begin(), 1, length, f) == length;
+	written = fclose(f) == 0 && written;
+	if (!written) {
+		::remove(tempPath.c_str());
+		return;
+	}
+	insert(filename, offset, length, tempPath);
+}
+
+TEST_CASE("/blobgranule/files/cache") {
+	std::string directory = joinPath(params.getDataDir(), format("bg_file_cache_%llx", timer_int()));
+	Standalone<StringRef> a = makeString(1000), b = makeString(1000), c = makeString(1000);
+	memset(mutateString(a), 'a', a.size());
+	memset(mutateString(b), 'b', b.size());
+	memset(mutateString(c), 'c', c.size());
+
+	{
+		BlobGranuleFileCache cache(directory, 2500);
+		ASSERT(!cache.read("bg/file/a"_sr, 0, 1000).present());
+		cache.write("bg/file/a"_sr, 0, 1000, a);
+		cache.write("bg/file/b"_sr, 0, 1000, b);
+		ASSERT(cache.read("bg/file/a"_sr, 0, 1000).get() == a);
+		// A different range of the same file is a different entry
+		ASSERT(!cache.read("bg/file/a"_sr, 0, 999).present());
+
+		// b is now the least recently used, so it is evicted to make room for c
+		cache.write("bg/file/c"_sr, 0, 1000, c);
+		ASSERT(cache.getEvictions() == 1);
+		ASSERT(cache.getBytes() == 2000);
+		ASSERT(!cache.read("bg/file/b"_sr, 0, 1000).present());
+		ASSERT(cache.read("bg/file/c"_sr, 0, 1000).get() == c);
+		ASSERT(cache.getHits() == 2);
+		ASSERT(cache.getMisses() == 3);
+	}
+
+	{
+		// A new cache over the same directory finds what the last one left
+		BlobGranuleFileCache cache(directory, 2500);
+		ASSERT(cache.getBytes() == 2000);
+		ASSERT(cache.read("bg/file/a"_sr, 0, 1000).get() == a);
+		ASSERT(cache.read("bg/file/c"_sr, 0, 1000).get() == c);
+		ASSERT(!cache.read("bg/file/b"_sr, 0, 1000).present());
+	}
+
+	platform::eraseDirectoryRecursive(directory);
+	return Void();
+}
@@ -22,10 +22,12 @@
 
 #include "fdbclient/BlobCipher.h"
 #include "fdbclient/BlobGranuleCommon.h"
+#include "fdbclient/BlobGranuleFileCache.h"
 #include "fdbclient/ClientKnobs.h"
 #include "fdbclient/CommitTransaction.h"
 #include "fdbclient/Knobs.h"
 #include "fdbclient/SystemData.h" // for allKeys unit test - could remove
+#include "fdbclient/Tuple.h"
 
 #include "flow/Arena.h"
 #include "flow/CompressionUtils.h"
@@ -1166,19 +1168,29 @@ Standalone<VectorRef<ParsedDeltaBoundaryRef>> loadChunkedDeltaFile(const Standal
 		return deltas;
 	}
 
-	// FIXME: shared prefix for key comparison
-	// FIXME: could cpu optimize first block a bit more by seeking right to start
+	// Decode all of the blocks the range needs first, so the output can be sized once instead of growing per boundary
+	std::vector<Standalone<GranuleSortedDeltas>> deltaBlocks;
+	int totalBoundaries = 0;
 	bool lastBlock = false;
-	bool prevClearAfter = false;
 	while (!lastBlock) {
 		auto nextBlock = currentBlock;
 		nextBlock++;
 		lastBlock = (nextBlock == file.indexBlockRef.block.children.end() - 1) || keyRange.end <= nextBlock->key;
 
-		Standalone<GranuleSortedDeltas> deltaBlock =
-		    file.getChild<GranuleSortedDeltas>(currentBlock, cipherKeysCtx, file.chunkStartOffset);
-		ASSERT(!deltaBlock.boundaries.empty());
-		ASSERT(currentBlock->key == deltaBlock.boundaries.front().key);
+		deltaBlocks.push_back(file.getChild<GranuleSortedDeltas>(currentBlock, cipherKeysCtx, file.chunkStartOffset));
+		ASSERT(!deltaBlocks.back().boundaries.empty());
+		ASSERT(currentBlock->key == deltaBlocks.back().boundaries.front().key);
+		totalBoundaries += deltaBlocks.back().boundaries.size();
+		currentBlock++;
+	}
+	deltas.reserve(deltas.arena(), totalBoundaries);
+
+	// FIXME: shared prefix for key comparison
+	// FIXME: could cpu optimize first block a bit more by seeking right to start
+	bool prevClearAfter = false;
+	for (int blockIdx = 0; blockIdx < deltaBlocks.size(); blockIdx++) {
+		auto& deltaBlock = deltaBlocks[blockIdx];
+		lastBlock = blockIdx == deltaBlocks.size() - 1;
 
 		// TODO refactor this into function to share with memory deltas
 		bool blockMemoryUsed = false;
@@ -1203,7 +1215,6 @@ Standalone<VectorRef<ParsedDeltaBoundaryRef>> loadChunkedDeltaFile(const Standal
 		if (blockMemoryUsed) {
 			deltas.arena().dependsOn(deltaBlock.arena());
 		}
-		currentBlock++;
 	}
 
 	// TODO REMOVE eventually? order sanity check for parsed deltas
@@ -1362,22 +1373,69 @@ struct MergeStreamNext {
 	int dataIdx;
 };
 
-// the sort order is logically lower by key, and then higher by streamIdx
-// because a priority queue is backwards, we invert that
-struct OrderForPriorityQueue {
-	int commonPrefixLen;
-	OrderForPriorityQueue(int commonPrefixLen) : commonPrefixLen(commonPrefixLen) {}
+// A loser tree over the heads of the streams. Taking the next boundary and advancing its stream replays a single
+// leaf-to-root path with one comparison per level, where a binary heap pops and pushes with about twice as many.
+// Boundaries are ordered by key, and for the same key the higher stream (the later write) comes first.
+class MergeLoserTree {
+public:
+	MergeLoserTree(const std::vector<Standalone<VectorRef<ParsedDeltaBoundaryRef>>>& streams, int commonPrefixLen)
+	  : streams(streams), commonPrefixLen(commonPrefixLen), dataIdx(streams.size(), 0), tree(streams.size()) {
+		int n = streams.size();
+		std::vector<int16_t> winners(2 * n);
+		for (int i = 0; i < n; i++) {
+			winners[n + i] = i;
+		}
+		for (int node = n - 1; node >= 1; node--) {
+			int16_t a = winners[2 * node];
+			int16_t b = winners[2 * node + 1];
+			if (!beats(a, b)) {
+				std::swap(a, b);
+			}
+			winners[node] = a;
+			tree[node] = b;
+		}
+		tree[0] = winners[1];
+	}
+
+	bool empty() const { return exhausted(tree[0]); }
+
+	MergeStreamNext top() const {
+		int16_t s = tree[0];
+		return MergeStreamNext{ streams[s][dataIdx[s]].key, s, dataIdx[s] };
+	}
+
+	// Advances the stream of the top boundary
+	void pop() {
+		int16_t winner = tree[0];
+		dataIdx[winner]++;
+		for (int node = (winner + (int)streams.size()) / 2; node >= 1; node /= 2) {
+			if (beats(tree[node], winner)) {
+				std::swap(tree[node], winner);
+			}
+		}
+		tree[0] = winner;
+	}
 
-	bool operator()(MergeStreamNext const& a, MergeStreamNext const& b) const {
-		int keyCmp = a.key.compareSuffix(b.key, commonPrefixLen);
+private:
+	bool exhausted(int16_t s) const { return dataIdx[s] >= streams[s].size(); }
+
+	bool beats(int16_t a, int16_t b) const {
+		if (exhausted(a) || exhausted(b)) {
+			return !exhausted(a);
+		}
+		int keyCmp = streams[a][dataIdx[a]].key.compareSuffix(streams[b][dataIdx[b]].key, commonPrefixLen);
 		if (keyCmp != 0) {
-			return keyCmp > 0; // reverse
+			return keyCmp < 0;
 		}
-		return a.streamIdx < b.streamIdx;
+		return a > b;
 	}
-};
 
-typedef std::priority_queue<MergeStreamNext, std::vector<MergeStreamNext>, OrderForPriorityQueue> MergePQ;
+	const std::vector<Standalone<VectorRef<ParsedDeltaBoundaryRef>>>& streams;
+	int commonPrefixLen;
+	std::vector<int> dataIdx;
+	// tree[0] is the stream with the next boundary, and every other node holds the stream that lost there
+	std::vector<int16_t> tree;
+};
 
 static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
                                      const std::vector<Standalone<VectorRef<ParsedDeltaBoundaryRef>>>& streams,
@@ -1392,9 +1450,6 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 
 	int prefixLen = commonPrefixLength(chunk.keyRange.begin, chunk.keyRange.end);
 
-	// next element for each stream
-	MergePQ next = MergePQ(OrderForPriorityQueue(prefixLen));
-
 	// efficiently find the highest stream's active clear
 	std::set<int16_t, std::greater<int16_t>> activeClears;
 	int16_t maxActiveClear = -1;
@@ -1415,25 +1470,23 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 			// single clear that entirely encases partial read bounds
 			ASSERT(clearActive[i]);
 		} else {
-			MergeStreamNext item;
-			item.key = streams[i][0].key;
-			item.streamIdx = i;
-			item.dataIdx = 0;
-			next.push(item);
 			maxExpectedSize += streams[i].size();
 			result.arena().dependsOn(streams[i].arena());
 		}
 	}
 	result.reserve(result.arena(), maxExpectedSize);
 
+	// next element for each stream
+	MergeLoserTree next(streams, prefixLen);
+
 	std::vector<MergeStreamNext> cur;
 	cur.reserve(streams.size());
 	while (!next.empty()) {
+		// Each stream's keys are unique and sorted, so its next key cannot match this one, and it can be advanced
+		// right away. The boundaries for this key come out from the highest stream to the lowest.
 		cur.clear();
 		cur.push_back(next.top());
 		next.pop();
-
-		// next.top().key == cur.front().key but with suffix comparison
 		while (!next.empty() && cur.front().key.compareSuffix(next.top().key, prefixLen) == 0) {
 			cur.push_back(next.top());
 			next.pop();
@@ -1472,7 +1525,7 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 			}
 		}
 
-		// advance streams and start clearAfter
+		// start clearAfter
 		for (auto& it : cur) {
 			if (streams[it.streamIdx][it.dataIdx].clearAfter) {
 				clearActive[it.streamIdx] = true;
@@ -1481,11 +1534,6 @@ static RangeResult mergeDeltaStreams(const BlobGranuleChunkRef& chunk,
 			}
 			// TODO: implement skipping if large clear!!
 			// if (maxClearIdx > it.streamIdx) - skip
-			it.dataIdx++;
-			if (it.dataIdx < streams[it.streamIdx].size()) {
-				it.key = streams[it.streamIdx][it.dataIdx].key;
-				next.push(it);
-			}
 		}
 	}
 
@@ -1634,14 +1682,36 @@ struct GranuleLoadIds {
 	Optional<int64_t> snapshotId;
 	std::vector<int64_t> deltaIds;
 	std::vector<Reference<GranuleLoadFreeHandle>> freeHandles;
+
+	// Files found in the BlobGranuleFileCache, which are not loaded through the granule context
+	Optional<Standalone<StringRef>> snapshotCached;
+	std::vector<Optional<Standalone<StringRef>>> deltaCached;
 };
 
+static Optional<Standalone<StringRef>> readCachedFile(BlobGranuleFileCache* cache, const BlobFilePointerRef& file) {
+	if (!cache) {
+		return Optional<Standalone<StringRef>>();
+	}
+	return cache->read(file.filename, file.offset, file.length);
+}
+
+static void writeCachedFile(BlobGranuleFileCache* cache, const BlobFilePointerRef& file, StringRef data) {
+	if (cache) {
+		cache->write(file.filename, file.offset, file.length, data);
+	}
+}
+
 static void startLoad(const ReadBlobGranuleContext* granuleContext,
                       const BlobGranuleChunkRef& chunk,
                       GranuleLoadIds& loadIds) {
 
+	BlobGranuleFileCache* cache = BlobGranuleFileCache::get();
+
 	// Start load process for all files in chunk
 	if (chunk.snapshotFile.present()) {
+		loadIds.snapshotCached = readCachedFile(cache, chunk.snapshotFile.get());
+	}
+	if (chunk.snapshotFile.present() && !loadIds.snapshotCached.present()) {
 		std::string snapshotFname = chunk.snapshotFile.get().filename.toString();
 		// FIXME: remove when we implement file multiplexing
 		ASSERT(chunk.snapshotFile.get().offset == 0);
@@ -1655,7 +1725,13 @@ static void startLoad(const ReadBlobGranuleContext* granuleContext,
 		loadIds.freeHandles.push_back(makeReference<GranuleLoadFreeHandle>(granuleContext, loadIds.snapshotId.get()));
 	}
 	loadIds.deltaIds.reserve(chunk.deltaFiles.size());
+	loadIds.deltaCached.reserve(chunk.deltaFiles.size());
 	for (int deltaFileIdx = 0; deltaFileIdx < chunk.deltaFiles.size(); deltaFileIdx++) {
+		loadIds.deltaCached.push_back(readCachedFile(cache, chunk.deltaFiles[deltaFileIdx]));
+		if (loadIds.deltaCached.back().present()) {
+			loadIds.deltaIds.push_back(-1);
+			continue;
+		}
 		std::string deltaFName = chunk.deltaFiles[deltaFileIdx].filename.toString();
 		// FIXME: remove when we implement file multiplexing
 		ASSERT(chunk.deltaFiles[deltaFileIdx].offset == 0);
@@ -1686,6 +1762,7 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 	}
 
 	GranuleLoadIds loadIds[files.size()];
+	BlobGranuleFileCache* cache = BlobGranuleFileCache::get();
 
 	try {
 		// Kick off first file reads if parallelism > 1
@@ -1703,18 +1780,25 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 
 			// once all loads kicked off, load data for chunk
 			Optional<StringRef> snapshotData;
-			if (files[chunkIdx].snapshotFile.present()) {
+			if (loadIds[chunkIdx].snapshotCached.present()) {
+				snapshotData = loadIds[chunkIdx].snapshotCached.get();
+			} else if (files[chunkIdx].snapshotFile.present()) {
 				snapshotData =
 				    StringRef(granuleContext.get_load_f(loadIds[chunkIdx].snapshotId.get(), granuleContext.userContext),
 				              files[chunkIdx].snapshotFile.get().length);
 				if (!snapshotData.get().begin()) {
 					return ErrorOr<RangeResult>(blob_granule_file_load_error());
 				}
+				writeCachedFile(cache, files[chunkIdx].snapshotFile.get(), snapshotData.get());
 			}
 
 			std::vector<StringRef> deltaData;
 			deltaData.resize(files[chunkIdx].deltaFiles.size());
 			for (int i = 0; i < files[chunkIdx].deltaFiles.size(); i++) {
+				if (loadIds[chunkIdx].deltaCached[i].present()) {
+					deltaData[i] = loadIds[chunkIdx].deltaCached[i].get();
+					continue;
+				}
 				deltaData[i] =
 				    StringRef(granuleContext.get_load_f(loadIds[chunkIdx].deltaIds[i], granuleContext.userContext),
 				              files[chunkIdx].deltaFiles[i].length);
@@ -1722,6 +1806,7 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 				if (!deltaData[i].begin()) {
 					return ErrorOr<RangeResult>(blob_granule_file_load_error());
 				}
+				writeCachedFile(cache, files[chunkIdx].deltaFiles[i], deltaData[i]);
 			}
 
 			// materialize rows from chunk
@@ -1733,6 +1818,8 @@ ErrorOr<RangeResult> loadAndMaterializeBlobGranules(const Standalone<VectorRef<B
 
 			// free once done by forcing FreeHandles to trigger
 			loadIds[chunkIdx].freeHandles.clear();
+			loadIds[chunkIdx].snapshotCached.reset();
+			loadIds[chunkIdx].deltaCached.clear();
 		}
 		return ErrorOr<RangeResult>(results);
 	} catch (Error& e) {
@@ -1762,6 +1849,34 @@ RangeResult bgReadSnapshotFile(const StringRef& data,
 	return snapshot;
 }
 
+RangeResult bgReadSnapshotFileProjected(const StringRef& data,
+                                        Optional<KeyRef> tenantPrefix,
+                                        Optional<BlobGranuleCipherKeysCtx> encryptionCtx,
+                                        const KeyRangeRef& keys,
+                                        const std::vector<int>& fields) {
+	Standalone<StringRef> fname = "f"_sr;
+	Arena arena;
+	KeyRangeRef fileKeys = tenantPrefix.present() ? keys.withPrefix(tenantPrefix.get(), arena) : keys;
+	// Only the chunks that overlap the range are decrypted and decompressed
+	Standalone<VectorRef<ParsedDeltaBoundaryRef>> rows = loadSnapshotFile(fname, data, fileKeys, encryptionCtx);
+	RangeResult projected;
+	projected.reserve(projected.arena(), rows.size());
+	for (auto& it : rows) {
+		Tuple value = Tuple::unpack(it.value);
+		Tuple fieldValues;
+		for (int field : fields) {
+			if (field >= 0 && field < value.size()) {
+				fieldValues.appendRaw(value.subTupleRawString(field));
+			} else {
+				fieldValues.appendNull();
+			}
+		}
+		KeyRef key = tenantPrefix.present() ? it.key.removePrefix(tenantPrefix.get()) : it.key;
+		projected.push_back_deep(projected.arena(), KeyValueRef(key, fieldValues.pack()));
+	}
+	return projected;
+}
+
 // FIXME: refactor if possible, just copy-pasted from loadChunkedDeltaFile for prototyping
 Standalone<VectorRef<GranuleMutationRef>> bgReadDeltaFile(const StringRef& deltaData,
                                                           Optional<KeyRef> tenantPrefix,
@@ -2967,6 +3082,38 @@ TEST_CASE("/blobgranule/files/bgReadDeltaFile") {
 	return Void();
 }
 
+TEST_CASE("/blobgranule/files/bgReadSnapshotFileProjected") {
+	Standalone<GranuleSnapshot> snapshot;
+	for (int i = 0; i < 100; i++) {
+		Key key = Tuple::makeTuple("row"_sr, (int64_t)i).pack();
+		Value value = Tuple::makeTuple((int64_t)i, "name"_sr, (double)i / 2).pack();
+		snapshot.push_back_deep(snapshot.arena(), KeyValueRef(key, value));
+	}
+	KeyRef tenantPrefix = "12345678"_sr;
+	bool addTenantPrefix = deterministicRandom()->coinflip();
+	if (addTenantPrefix) {
+		for (auto& it : snapshot) {
+			it.key = it.key.withPrefix(tenantPrefix, snapshot.arena());
+		}
+	}
+	Value serialized = serializeChunkedSnapshot("f"_sr, snapshot, deterministicRandom()->randomInt(64, 1024), {});
+
+	Key begin = Tuple::makeTuple("row"_sr, (int64_t)10).pack();
+	Key end = Tuple::makeTuple("row"_sr, (int64_t)20).pack();
+	RangeResult rows = bgReadSnapshotFileProjected(
+	    serialized, addTenantPrefix ? tenantPrefix : Optional<KeyRef>(), {}, KeyRangeRef(begin, end), { 2, 0, 5 });
+	ASSERT_EQ(rows.size(), 10);
+	for (int i = 0; i < rows.size(); i++) {
+		ASSERT(rows[i].key == Tuple::makeTuple("row"_sr, (int64_t)(i + 10)).pack());
+		Tuple fields = Tuple::unpack(rows[i].value);
+		ASSERT_EQ(fields.size(), 3);
+		ASSERT(fields.getDouble(0) == (double)(i + 10) / 2);
+		ASSERT_EQ(fields.getInt(1), i + 10);
+		ASSERT(fields.getType(2) == Tuple::NULL_TYPE);
+	}
+	return Void();
+}
+
 // performance micro-benchmarks
 
 struct FileSet {
@@ -18,21 +18,78 @@
  * limitations under the License.
  */
 
+#include <deque>
 #include <map>
 #include <vector>
 
 #include "fmt/format.h"
 #include "fdbclient/AsyncFileS3BlobStore.actor.h"
 #include "fdbclient/BlobGranuleCommon.h"
+#include "fdbclient/BlobGranuleFileCache.h"
 #include "fdbclient/BlobGranuleFiles.h"
 #include "fdbclient/BlobGranuleReader.actor.h"
 #include "fdbclient/BlobWorkerCommon.h"
 #include "fdbclient/BlobWorkerInterface.h"
 #include "fdbclient/FDBTypes.h"
+#include "fdbclient/Knobs.h"
+#include "flow/IAsyncFile.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
+// Returns the range of a granule file from the local file cache, or nothing if it is not there or cannot be read
+ACTOR static Future<Optional<Standalone<StringRef>>> readCachedFile(BlobGranuleFileCache* cache, BlobFilePointerRef f) {
+	state Optional<std::string> path = cache->lookup(f.filename, f.offset, f.length);
+	if (!path.present()) {
+		return Optional<Standalone<StringRef>>();
+	}
+	try {
+		state Arena arena;
+		state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+		    path.get(), IAsyncFile::OPEN_READONLY | IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_NO_AIO, 0));
+		state uint8_t* data = new (arena) uint8_t[f.length];
+		int readSize = wait(file->read(data, f.length, 0));
+		if (readSize == f.length) {
+			return Standalone<StringRef>(StringRef(data, f.length), arena);
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+	}
+	// Evicted by another reader since the lookup, or damaged
+	cache->erase(f.filename, f.offset, f.length);
+	return Optional<Standalone<StringRef>>();
+}
+
+ACTOR static Future<Void> writeCachedFile(BlobGranuleFileCache* cache,
+                                          Standalone<StringRef> filename,
+                                          int64_t offset,
+                                          Standalone<StringRef> data) {
+	state std::string tempPath = cache->tempPathFor(filename, offset, data.size());
+	try {
+		state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+		    tempPath,
+		    IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_NO_AIO,
+		    0600));
+		wait(file->write(data.begin(), data.size(), 0));
+		file = Reference<IAsyncFile>();
+		cache->insert(filename, offset, data.size(), tempPath);
+	} catch (Error& e) {
+		TraceEvent(SevWarn, "BlobGranuleFileCacheWriteError").errorUnsuppressed(e).detail("Path", tempPath);
+		deleteFile(tempPath);
+	}
+	return Void();
+}
+
 ACTOR Future<Standalone<StringRef>> readFile(Reference<BlobConnectionProvider> bstoreProvider, BlobFilePointerRef f) {
 	try {
+		state BlobGranuleFileCache* cache = BlobGranuleFileCache::get();
+		if (cache) {
+			Optional<Standalone<StringRef>> cached = wait(readCachedFile(cache, f));
+			if (cached.present()) {
+				return cached.get();
+			}
+		}
+
 		state Arena arena;
 		std::string fname = f.filename.toString();
 		state Reference<BackupContainerFileSystem> bstore = bstoreProvider->getForRead(fname);
@@ -44,7 +101,12 @@ ACTOR Future<Standalone<StringRef>> readFile(Reference<BlobConnectionProvider> b
 		ASSERT(f.length == readSize);
 
 		StringRef dataRef(data, f.length);
-		return Standalone<StringRef>(dataRef, arena);
+		Standalone<StringRef> result(dataRef, arena);
+		if (cache && f.length <= cache->getCapacity()) {
+			// Cache the file in the background rather than delay the read on it
+			uncancellable(writeCachedFile(cache, f.filename, f.offset, result));
+		}
+		return result;
 	} catch (Error& e) {
 		throw e;
 	}
@@ -120,10 +182,20 @@ ACTOR Future<Void> readBlobGranules(BlobGranuleFileRequest request,
 	// TODO for large amount of chunks, this should probably have some sort of buffer limit like ReplyPromiseStream.
 	// Maybe just use ReplyPromiseStream instead of PromiseStream?
 	try {
-		state int i;
-		for (i = 0; i < reply.chunks.size(); i++) {
-			RangeResult chunkResult = wait(
-			    readBlobGranule(reply.chunks[i], request.keyRange, request.beginVersion, request.readVersion, bstore));
+		// Fetch the files of the next few chunks while earlier ones are merged and sent, keeping results in order
+		state std::deque<Future<RangeResult>> chunkResults;
+		state int nextChunk = 0;
+		loop {
+			while (nextChunk < reply.chunks.size() && chunkResults.size() < CLIENT_KNOBS->BG_MAX_GRANULE_PARALLELISM) {
+				chunkResults.push_back(readBlobGranule(
+				    reply.chunks[nextChunk], request.keyRange, request.beginVersion, request.readVersion, bstore));
+				nextChunk++;
+			}
+			if (chunkResults.empty()) {
+				break;
+			}
+			RangeResult chunkResult = wait(chunkResults.front());
+			chunkResults.pop_front();
 			results.send(std::move(chunkResult));
 		}
 		results.sendError(end_of_stream());
@@ -22,6 +22,7 @@
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/SystemData.h"
 #include "fdbclient/Tenant.h"
+#include "flow/CompressionUtils.h"
 #include "flow/IRandom.h"
 #include "flow/UnitTest.h"
 #include "flow/flow.h"
@@ -50,6 +51,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( MAX_GENERATIONS_SIM,                      50 ); //Disable network connections after this many generations in simulation, should be less than RECOVERY_DELAY_START_GENERATION
 
 	init( COORDINATOR_RECONNECTION_DELAY,          1.0 );
+	init( COORDINATOR_RECONNECTION_MAX_DELAY,     10.0 ); if( randomize && BUGGIFY ) COORDINATOR_RECONNECTION_MAX_DELAY = 1.0;
 	init( CLIENT_EXAMPLE_AMOUNT,                    20 );
 	init( MAX_CLIENT_STATUS_AGE,                   1.0 );
 	init( MAX_COMMIT_PROXY_CONNECTIONS,              5 ); if( randomize && BUGGIFY ) MAX_COMMIT_PROXY_CONNECTIONS = 1;
@@ -69,6 +71,8 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( BACKOFF_GROWTH_RATE,                     2.0 );
 	init( RESOURCE_CONSTRAINED_MAX_BACKOFF,       30.0 );
 	init( PROXY_COMMIT_OVERHEAD_BYTES,              23 ); //The size of serializing 7 tags (3 primary, 3 remote, 1 log router) + 2 for the tag length
+	init( COMMIT_COALESCE_READ_CONFLICT_RANGES,   true ); if( randomize && BUGGIFY ) COMMIT_COALESCE_READ_CONFLICT_RANGES = false;
+	init( COMMIT_READ_CONFLICT_RANGE_LIMIT,          0 ); if( randomize && BUGGIFY ) COMMIT_READ_CONFLICT_RANGE_LIMIT = deterministicRandom()->randomInt(1, 100); // 0 means unlimited; above it, adjacent read conflict ranges are widened into covering ones
 	init( SHARD_STAT_SMOOTH_AMOUNT,                5.0 );
 	init( INIT_MID_SHARD_BYTES,               10000000 ); if( randomize && BUGGIFY ) INIT_MID_SHARD_BYTES = 40000; else if(randomize && BUGGIFY_WITH_PROB(0.75)) INIT_MID_SHARD_BYTES = 200000; // The same value as SERVER_KNOBS->MIN_SHARD_BYTES
 
@@ -78,6 +82,10 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( VALUE_SIZE_LIMIT,                        1e5 );
 	init( SPLIT_KEY_SIZE_LIMIT,                    KEY_SIZE_LIMIT/2 );  if( randomize && BUGGIFY ) SPLIT_KEY_SIZE_LIMIT = KEY_SIZE_LIMIT - 31;//serverKeysPrefixFor(UID()).size() - 1;
 	init( METADATA_VERSION_CACHE_SIZE,            1000 );
+	init( WRITE_MAP_FLAT_ENTRIES,                   64 ); if( randomize && BUGGIFY ) WRITE_MAP_FLAT_ENTRIES = deterministicRandom()->randomInt(0, 8);
+	init( READ_CACHE_SIZE,                           0 ); if( randomize && BUGGIFY ) READ_CACHE_SIZE = deterministicRandom()->randomInt(1, 1e6);
+	init( WRITE_BATCH_WINDOW,                    0.001 ); if( randomize && BUGGIFY ) WRITE_BATCH_WINDOW = deterministicRandom()->random01() * 0.1;
+	init( WRITE_BATCH_MAX_BYTES,                   1e6 ); if( randomize && BUGGIFY ) WRITE_BATCH_MAX_BYTES = deterministicRandom()->randomInt(1, 1e4);
 	init( CHANGE_FEED_LOCATION_LIMIT,            10000 );
 	init( CHANGE_FEED_CACHE_SIZE,               100000 ); if( randomize && BUGGIFY ) CHANGE_FEED_CACHE_SIZE = 1;
 	init( CHANGE_FEED_POP_TIMEOUT,                10.0 );
@@ -87,13 +95,17 @@ void ClientKnobs::initialize(Randomize randomize) {
 
 	init( MAX_BATCH_SIZE,                         1000 ); if( randomize && BUGGIFY ) MAX_BATCH_SIZE = 1;
 	init( GRV_BATCH_TIMEOUT,                     0.005 ); if( randomize && BUGGIFY ) GRV_BATCH_TIMEOUT = 0.1;
+	init( GRV_SHARE_WINDOW,                        0.0 ); if( randomize && BUGGIFY ) GRV_SHARE_WINDOW = deterministicRandom()->random01() * 0.1;
 	init( BROADCAST_BATCH_SIZE,                     20 ); if( randomize && BUGGIFY ) BROADCAST_BATCH_SIZE = 1;
 	init( TRANSACTION_TIMEOUT_DELAY_INTERVAL,     10.0 ); if( randomize && BUGGIFY ) TRANSACTION_TIMEOUT_DELAY_INTERVAL = 1.0;
+	init( EARLY_CONFLICT_CHECK_INTERVAL,           1.0 ); if( randomize && BUGGIFY ) EARLY_CONFLICT_CHECK_INTERVAL = 0.05;
 
 	init( LOCATION_CACHE_EVICTION_SIZE,         600000 );
 	init( LOCATION_CACHE_EVICTION_SIZE_SIM,         10 ); if( randomize && BUGGIFY ) LOCATION_CACHE_EVICTION_SIZE_SIM = 3;
 	init( LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD,     60 );
 	init( LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL,    60 );
+	init( LOCATION_CACHE_PREWARM_SHARD_LIMIT,     1000 ); if( randomize && BUGGIFY ) LOCATION_CACHE_PREWARM_SHARD_LIMIT = 3;
+	init( LOCATION_CACHE_FILE_SAVE_INTERVAL,      60.0 ); if( randomize && BUGGIFY ) LOCATION_CACHE_FILE_SAVE_INTERVAL = 1.0;
 
 	init( GET_RANGE_SHARD_LIMIT,                     2 );
 	init( WARM_RANGE_SHARD_LIMIT,                  100 );
@@ -107,8 +119,14 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( TAG_ENCODE_KEY_SERVERS,                false ); if( randomize && BUGGIFY ) TAG_ENCODE_KEY_SERVERS = true;
 	init( RANGESTREAM_FRAGMENT_SIZE,               1e6 );
 	init( RANGESTREAM_BUFFERED_FRAGMENTS_LIMIT,     20 );
+	init( RANGE_PREFETCH_DEPTH,                      2 ); if( randomize && BUGGIFY ) RANGE_PREFETCH_DEPTH = deterministicRandom()->randomInt(0, 5);
+	init( RANGE_PREFETCH_MAX_BYTES,                1e6 ); if( randomize && BUGGIFY ) RANGE_PREFETCH_MAX_BYTES = 1;
 	init( QUARANTINE_TSS_ON_MISMATCH,             true ); if( randomize && BUGGIFY ) QUARANTINE_TSS_ON_MISMATCH = false; // if true, a tss mismatch will put the offending tss in quarantine. If false, it will just be killed
+	init( TSS_GET_VALUE_SAMPLE_RATE,               1.0 ); // fraction of each kind of read that is also sent to the TSS pair and compared
+	init( TSS_GET_KEY_SAMPLE_RATE,                 1.0 );
+	init( TSS_GET_RANGE_SAMPLE_RATE,               1.0 );
 	init( CHANGE_FEED_EMPTY_BATCH_TIME,          0.005 );
+	init( RYW_READ_THROUGH_WITHOUT_WRITES,        true ); if( randomize && BUGGIFY ) RYW_READ_THROUGH_WITHOUT_WRITES = false;
 
 	//KeyRangeMap
 	init( KRM_GET_RANGE_LIMIT,                     1e5 ); if( randomize && BUGGIFY ) KRM_GET_RANGE_LIMIT = 10;
@@ -149,6 +167,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( BACKUP_SIMULATED_LIMIT_BYTES,		       1e6 ); if( randomize && BUGGIFY ) BACKUP_SIMULATED_LIMIT_BYTES = 1000;
 	init( BACKUP_GET_RANGE_LIMIT_BYTES,		       1e6 );
 	init( BACKUP_LOCK_BYTES,                       1e8 );
+	init( MUTATION_LOG_READER_BUFFERED_BYTES,      1e8 ); if( randomize && BUGGIFY ) MUTATION_LOG_READER_BUFFERED_BYTES = 1e4;
 	init( BACKUP_RANGE_TIMEOUT,   TASKBUCKET_TIMEOUT_VERSIONS/CORE_VERSIONSPERSECOND/2.0 );
 	init( BACKUP_RANGE_MINWAIT,   std::max(1.0, BACKUP_RANGE_TIMEOUT/2.0));
 	init( BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC,  10 * 60 );  // 10 minutes
@@ -175,6 +194,8 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( VERSIONS_PER_SECOND,                     1e6 ); // Must be the same as SERVER_KNOBS->VERSIONS_PER_SECOND
 	init( SIM_BACKUP_TASKS_PER_AGENT,               10 );
 	init( BACKUP_RANGEFILE_BLOCK_SIZE,      1024 * 1024);
+	init( BACKUP_RANGEFILE_COMPRESSION_FILTER,  "NONE" ); if( randomize && BUGGIFY ) BACKUP_RANGEFILE_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( BACKUP_RANGEFILE_COMPRESSION_CHUNK_BYTES, 64 * 1024 ); if( randomize && BUGGIFY ) BACKUP_RANGEFILE_COMPRESSION_CHUNK_BYTES = deterministicRandom()->randomInt(100, 10000);
 	init( BACKUP_LOGFILE_BLOCK_SIZE,        1024 * 1024);
 	init( BACKUP_DISPATCH_ADDTASK_SIZE,             50 );
 	init( RESTORE_DISPATCH_ADDTASK_SIZE,           150 );
@@ -225,11 +246,14 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( BLOBSTORE_READ_CACHE_BLOCKS_PER_FILE,      2 );
 	init( BLOBSTORE_MULTIPART_MAX_PART_SIZE,  20000000 );
 	init( BLOBSTORE_MULTIPART_MIN_PART_SIZE,   5242880 );
+	init( BLOBSTORE_MULTIPART_PART_UPLOAD_SECONDS,   2 );
 	init( BLOBSTORE_GLOBAL_CONNECTION_POOL,       true );
 	init( BLOBSTORE_ENABLE_LOGGING,               true );
 	init( BLOBSTORE_STATS_LOGGING_INTERVAL,       10.0 );
 	init( BLOBSTORE_LATENCY_LOGGING_INTERVAL,    120.0 );
 	init( BLOBSTORE_LATENCY_LOGGING_ACCURACY,     0.01 );
+	init( REST_LATENCY_LOGGING_INTERVAL,         120.0 );
+	init( REST_LATENCY_LOGGING_ACCURACY,          0.01 );
 
 	// These are basically unlimited by default but can be used to reduce blob IO if needed
 	init( BLOBSTORE_REQUESTS_PER_SECOND,            200 );
@@ -285,6 +309,8 @@ void ClientKnobs::initialize(Randomize randomize) {
 	// Blob granules
 	init( BG_MAX_GRANULE_PARALLELISM,                10 );
 	init( BG_TOO_MANY_GRANULES,                   20000 );
+	init( BG_FILE_CACHE_DIR,                         "" );
+	init( BG_FILE_CACHE_BYTES,                      1e9 );
 	init( BLOB_METADATA_REFRESH_INTERVAL,          3600 ); if ( randomize && BUGGIFY ) { BLOB_METADATA_REFRESH_INTERVAL = deterministicRandom()->randomInt(5, 120); }
 
 	init( CHANGE_QUORUM_BAD_STATE_RETRY_TIMES,        3 );
@@ -301,6 +327,7 @@ void ClientKnobs::initialize(Randomize randomize) {
 	init( METACLUSTER_RESTORE_BATCH_SIZE,          1000 ); if ( randomize && BUGGIFY ) METACLUSTER_RESTORE_BATCH_SIZE = 1 + deterministicRandom()->randomInt(0, 3);
 	init( TENANT_ENTRY_CACHE_LIST_REFRESH_INTERVAL,   2 ); if( randomize && BUGGIFY ) TENANT_ENTRY_CACHE_LIST_REFRESH_INTERVAL = deterministicRandom()->randomInt(1, 10);
 	init( CLIENT_ENABLE_USING_CLUSTER_ID_KEY,     false );
+	init( MULTI_VERSION_DIRECT_DISPATCH,           true ); if( randomize && BUGGIFY ) MULTI_VERSION_DIRECT_DISPATCH = false;
 
 	init( ENABLE_ENCRYPTION_CPU_TIME_LOGGING,       false );
 	init( SIMULATION_ENABLE_SNAPSHOT_ENCRYPTION_CHECKS,        true );
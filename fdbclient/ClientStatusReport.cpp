@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 
+#include "fdbclient/BlobGranuleFileCache.h"
 #include "fdbclient/CommitProxyInterface.h"
 #include "fdbclient/CoordinationInterface.h"
 #include "fdbclient/DatabaseContext.h"
@@ -41,6 +42,8 @@ public:
 			reportClientInfo();
 			reportStorageServers();
 			reportConnections();
+			reportReadVersionPool();
+			reportBlobGranuleFileCache();
 			statusObj["Healthy"] = healthy;
 		}
 		return StringRef(json_spirit::write_string(json_spirit::mValue(statusObj)));
@@ -120,6 +123,44 @@ private:
 		}
 	}
 
+	void reportReadVersionPool() {
+		json_spirit::mObject poolStatus;
+		int64_t hits = cx.transactionGrvPoolHits.getValue();
+		int64_t misses = cx.transactionGrvPoolMisses.getValue();
+		poolStatus["Hits"] = hits;
+		poolStatus["Misses"] = misses;
+		poolStatus["HitRate"] = hits + misses > 0 ? double(hits) / (hits + misses) : 0.0;
+		json_spirit::mObject waitTimes;
+		DDSketch<double>& sketch = cx.grvPoolWaitTimes;
+		waitTimes["Count"] = (int64_t)sketch.getPopulationSize();
+		if (sketch.getPopulationSize() > 0) {
+			waitTimes["Mean"] = sketch.mean();
+			waitTimes["P50"] = sketch.percentile(0.50);
+			waitTimes["P90"] = sketch.percentile(0.90);
+			waitTimes["P99"] = sketch.percentile(0.99);
+			waitTimes["Max"] = sketch.max();
+		}
+		poolStatus["WaitTimes"] = waitTimes;
+		statusObj["ReadVersionPool"] = poolStatus;
+	}
+
+	void reportBlobGranuleFileCache() {
+		BlobGranuleFileCache* cache = BlobGranuleFileCache::get();
+		if (!cache) {
+			return;
+		}
+		json_spirit::mObject cacheStatus;
+		int64_t hits = cache->getHits();
+		int64_t misses = cache->getMisses();
+		cacheStatus["Hits"] = hits;
+		cacheStatus["Misses"] = misses;
+		cacheStatus["HitRate"] = hits + misses > 0 ? double(hits) / (hits + misses) : 0.0;
+		cacheStatus["Evictions"] = cache->getEvictions();
+		cacheStatus["Bytes"] = cache->getBytes();
+		cacheStatus["Capacity"] = cache->getCapacity();
+		statusObj["BlobGranuleFileCache"] = cacheStatus;
+	}
+
 	json_spirit::mObject connectionStatusReport(const NetworkAddress& address) {
 		json_spirit::mObject connStatus;
 		connStatus["Address"] = address.toString();
@@ -170,4 +211,45 @@ private:
 Standalone<StringRef> DatabaseContext::getClientStatus() {
 	ClientReportGenerator generator(*this);
 	return generator.generateReport();
+}
+
+namespace {
+
+json_spirit::mObject latencySketchReport(DDSketch<double> const& total, DDSketch<double> const& current) {
+	DDSketch<double> sketch = total;
+	sketch.mergeWith(current);
+	json_spirit::mObject report;
+	report["ErrorGuarantee"] = sketch.getErrorGuarantee();
+	report["Count"] = (int64_t)sketch.getPopulationSize();
+	if (sketch.getPopulationSize() > 0) {
+		report["Min"] = sketch.min();
+		report["Max"] = sketch.max();
+		report["Sum"] = sketch.getSum();
+	}
+	json_spirit::mArray buckets;
+	std::vector<uint32_t> counts = sketch.getSamples();
+	for (size_t i = 0; i < counts.size(); i++) {
+		if (counts[i] > 0) {
+			json_spirit::mArray bucket;
+			bucket.push_back(sketch.getValue(i));
+			bucket.push_back((int64_t)counts[i]);
+			buckets.push_back(bucket);
+		}
+	}
+	report["Buckets"] = buckets;
+	return report;
+}
+
+} // namespace
+
+Standalone<StringRef> DatabaseContext::getClientMetrics() {
+	json_spirit::mObject latencies;
+	latencies["GRV"] = latencySketchReport(totalGRVLatencies, GRVLatencies);
+	latencies["Read"] = latencySketchReport(totalReadLatencies, readLatencies);
+	latencies["RangeRead"] = latencySketchReport(totalRangeReadLatencies, rangeReadLatencies);
+	latencies["Commit"] = latencySketchReport(totalCommitLatencies, commitLatencies);
+	latencies["Transaction"] = latencySketchReport(totalLatencies, this->latencies);
+	json_spirit::mObject metrics;
+	metrics["Latencies"] = latencies;
+	return StringRef(json_spirit::write_string(json_spirit::mValue(metrics)));
 }
\ No newline at end of file
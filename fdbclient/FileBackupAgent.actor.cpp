@@ -23,6 +23,7 @@
 #include "fdbclient/TenantManagement.actor.h"
 #include "fdbrpc/TenantInfo.h"
 #include "fdbrpc/simulator.h"
+#include "flow/CompressionUtils.h"
 #include "flow/EncryptUtils.h"
 #include "flow/FastRef.h"
 #include "fmt/format.h"
@@ -52,6 +53,7 @@
 #include "flow/IAsyncFile.h"
 #include "flow/genericactors.actor.h"
 #include "flow/Hash3.h"
+#include "flow/UnitTest.h"
 #include "flow/xxhash.h"
 
 #include <memory>
@@ -491,6 +493,155 @@ Value makePadding(int size) {
 	return pad.substr(0, size);
 }
 
+std::vector<PartitionedLogMessage> decodePartitionedLogBlock(StringRef block,
+                                                             Arena& arena,
+                                                             Version minVersion,
+                                                             Version maxVersion) {
+	std::vector<PartitionedLogMessage> messages;
+	StringRefReader reader(block, restore_corrupted_data());
+
+	int32_t blockVersion = reader.consume<int32_t>();
+	if (blockVersion == PARTITIONED_MLOG_VERSION) {
+		// If eof reached or first key len bytes is 0xFF then end of block was reached.
+		while (!reader.eof() && *reader.rptr != 0xFF) {
+			// Deserialize messages written in saveMutationsToFile().
+			PartitionedLogMessage& m = messages.emplace_back();
+			m.version.version = reader.consumeNetworkUInt64();
+			m.version.sub = reader.consumeNetworkUInt32();
+			int msgSize = reader.consumeNetworkInt32();
+			m.message = StringRef(reader.consume(msgSize), msgSize);
+		}
+	} else if (blockVersion == PARTITIONED_MLOG_GROUPED_VERSION) {
+		uint8_t filter = reader.consume<uint8_t>();
+		if (filter >= (uint8_t)CompressionFilter::LAST) {
+			throw restore_corrupted_data();
+		}
+		Version firstVersion = reader.consumeNetworkUInt64();
+		Version lastVersion = reader.consumeNetworkUInt64();
+		if (lastVersion < minVersion || firstVersion >= maxVersion) {
+			return messages;
+		}
+		// The first byte of a chunk length is never 0xFF
+		while (!reader.eof() && *reader.rptr != 0xFF) {
+			uint32_t len = reader.consumeNetworkUInt32();
+			StringRef compressed(reader.consume(len), len);
+			StringRefReader chunk(CompressionUtils::decompress((CompressionFilter)filter, compressed, arena),
+			                      restore_corrupted_data());
+			while (!chunk.eof()) {
+				Version version = chunk.consumeNetworkUInt64();
+				uint32_t count = chunk.consumeNetworkUInt32();
+				for (uint32_t i = 0; i < count; i++) {
+					PartitionedLogMessage& m = messages.emplace_back();
+					m.version.version = version;
+					m.version.sub = chunk.consumeNetworkUInt32();
+					int msgSize = chunk.consumeNetworkInt32();
+					m.message = StringRef(chunk.consume(msgSize), msgSize);
+				}
+			}
+		}
+	} else {
+		throw restore_unsupported_file_version();
+	}
+
+	// Make sure any remaining bytes in the block are 0xFF
+	for (auto b : reader.remainder()) {
+		if (b != 0xFF) {
+			throw restore_corrupted_data_padding();
+		}
+	}
+	return messages;
+}
+
+static void appendNetworkUInt32(std::string& s, uint32_t v) {
+	v = bigEndian32(v);
+	s.append((const char*)&v, sizeof(v));
+}
+
+static void appendNetworkUInt64(std::string& s, uint64_t v) {
+	v = bigEndian64(v);
+	s.append((const char*)&v, sizeof(v));
+}
+
+void PartitionedLogBlockEncoder::add(LogMessageVersion version, StringRef message) {
+	if (chunk.empty()) {
+		chunkFirstVersion = version.version;
+	}
+	if (chunk.empty() || version.version != groupVersion) {
+		groupVersion = version.version;
+		appendNetworkUInt64(chunk, groupVersion);
+		groupCountOffset = chunk.size();
+		groupCount = 0;
+		appendNetworkUInt32(chunk, groupCount);
+	}
+	appendNetworkUInt32(chunk, version.sub);
+	appendNetworkUInt32(chunk, message.size());
+	chunk.append((const char*)message.begin(), message.size());
+	uint32_t count = bigEndian32(++groupCount);
+	memcpy(chunk.data() + groupCountOffset, &count, sizeof(count));
+
+	if (chunk.size() >= chunkBytes) {
+		endChunk();
+	}
+}
+
+void PartitionedLogBlockEncoder::endChunk() {
+	if (chunk.empty()) {
+		return;
+	}
+	Standalone<StringRef> compressed;
+	compressed.contents() = CompressionUtils::compress(filter, StringRef(chunk), compressed.arena());
+	chunk.clear();
+
+	int bytes = sizeof(uint32_t) + compressed.size();
+	if (!blockChunks.empty() && headerBytes + blockChunkBytes + bytes > blockSize) {
+		endBlock(true);
+	}
+	if (headerBytes + bytes > blockSize) {
+		throw backup_bad_block_size();
+	}
+	if (blockChunks.empty()) {
+		blockFirstVersion = chunkFirstVersion;
+	}
+	blockLastVersion = groupVersion;
+	blockChunks.push_back(compressed);
+	blockChunkBytes += bytes;
+}
+
+void PartitionedLogBlockEncoder::endBlock(bool pad) {
+	if (blockChunks.empty()) {
+		return;
+	}
+	int size = pad ? blockSize : headerBytes + blockChunkBytes;
+	Standalone<StringRef> block = makeString(size);
+	uint8_t* wPtr = mutateString(block);
+	auto write = [&wPtr](const void* data, int len) {
+		memcpy(wPtr, data, len);
+		wPtr += len;
+	};
+	uint8_t filterByte = (uint8_t)filter;
+	uint64_t first = bigEndian64(blockFirstVersion);
+	uint64_t last = bigEndian64(blockLastVersion);
+	write(&PARTITIONED_MLOG_GROUPED_VERSION, sizeof(PARTITIONED_MLOG_GROUPED_VERSION));
+	write(&filterByte, sizeof(filterByte));
+	write(&first, sizeof(first));
+	write(&last, sizeof(last));
+	for (auto const& c : blockChunks) {
+		uint32_t len = bigEndian32((uint32_t)c.size());
+		write(&len, sizeof(len));
+		write(c.begin(), c.size());
+	}
+	memset(wPtr, 0xFF, mutateString(block) + size - wPtr);
+
+	blocks.push_back(block);
+	blockChunks.clear();
+	blockChunkBytes = 0;
+}
+
+void PartitionedLogBlockEncoder::finish() {
+	endChunk();
+	endBlock(false);
+}
+
 struct IRangeFileWriter {
 public:
 	virtual Future<Void> padEnd(bool final) = 0;
@@ -1069,6 +1220,179 @@ private:
 	Key lastValue;
 };
 
+// CompressedRangeFileWriter writes the same key and value stream as RangeFileWriter, with the same begin and end keys
+// around block boundaries, but compresses it in chunks of about BACKUP_RANGEFILE_COMPRESSION_CHUNK_BYTES so that each
+// fixed size block holds as many kv pairs as fit once compressed. Blocks stay at BACKUP_RANGEFILE_BLOCK_SIZE offsets,
+// so restore reads and splits them exactly as it does uncompressed files.
+//
+//   Block:  H F [len chunk] [len chunk] ... P
+//
+//   H = header   F = compression filter byte   len = network order chunk length   P = padding
+//
+// A chunk that no longer fits in the current block is moved, after the duplicated begin key and kv pair, to the next.
+struct CompressedRangeFileWriter : public IRangeFileWriter {
+	CompressedRangeFileWriter(Reference<IBackupFile> file, int blockSize, CompressionFilter filter)
+	  : file(file), blockSize(blockSize), blockEnd(0), fileVersion(BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION),
+	    filter((uint8_t)filter), blockChunks(0), pendingBytes(0) {}
+
+	// Pads the current block and writes the next header. The final flag is used in simulation to pad the file's
+	// final block to a whole block size.
+	ACTOR static Future<Void> newBlock(CompressedRangeFileWriter* self, bool final = false) {
+		int bytesLeft = self->blockEnd - self->file->size();
+		if (bytesLeft > 0) {
+			state Value paddingFFs = makePadding(bytesLeft);
+			wait(self->file->append(paddingFFs.begin(), bytesLeft));
+		}
+
+		if (final) {
+			ASSERT(g_network->isSimulated());
+			return Void();
+		}
+
+		self->blockEnd += self->blockSize;
+		self->blockChunks = 0;
+		wait(self->file->append((uint8_t*)&self->fileVersion, sizeof(self->fileVersion)));
+		wait(self->file->append(&self->filter, sizeof(self->filter)));
+
+		// If this is NOT the first block then the pending chunk starts with the duplicate stuff from the last block
+		if (self->blockEnd > self->blockSize) {
+			self->pending.insert(self->pending.begin(),
+			                     { { self->lastKey, Optional<Value>() }, { self->lastKey, self->lastValue } });
+		}
+		return Void();
+	}
+
+	Standalone<StringRef> compressPending() const {
+		int size = 0;
+		for (auto const& [k, v] : pending) {
+			size += sizeof(uint32_t) + k.size() + (v.present() ? sizeof(uint32_t) + v.get().size() : 0);
+		}
+		Standalone<StringRef> buf = makeString(size);
+		uint8_t* wPtr = mutateString(buf);
+		auto append = [&wPtr](StringRef s) {
+			uint32_t lenBuf = bigEndian32((uint32_t)s.size());
+			memcpy(wPtr, &lenBuf, sizeof(lenBuf));
+			memcpy(wPtr + sizeof(lenBuf), s.begin(), s.size());
+			wPtr += sizeof(lenBuf) + s.size();
+		};
+		for (auto const& [k, v] : pending) {
+			append(k);
+			if (v.present()) {
+				append(v.get());
+			}
+		}
+		Standalone<StringRef> compressed;
+		compressed.contents() = CompressionUtils::compress((CompressionFilter)filter, buf, compressed.arena());
+		return compressed;
+	}
+
+	// Writes the pending chunk to the current block, or to a new one if it does not fit
+	ACTOR static Future<Void> flushChunk(CompressedRangeFileWriter* self) {
+		loop {
+			if (self->pending.empty()) {
+				return Void();
+			}
+			state Standalone<StringRef> compressed = self->compressPending();
+			if (self->file->size() + sizeof(uint32_t) + compressed.size() <= self->blockEnd) {
+				wait(self->file->appendStringRefWithLen(compressed));
+				for (auto it = self->pending.rbegin(); it != self->pending.rend(); ++it) {
+					if (it->second.present()) {
+						self->lastKey = it->first;
+						self->lastValue = it->second.get();
+						break;
+					}
+				}
+				self->pending.clear();
+				self->pendingBytes = 0;
+				self->blockChunks++;
+				return Void();
+			}
+			// A chunk that does not fit in an empty block will not fit in the next one either
+			if (self->blockEnd > 0 && self->blockChunks == 0) {
+				throw backup_bad_block_size();
+			}
+			wait(newBlock(self));
+		}
+	}
+
+	Future<Void> add(Key k, Optional<Value> v) {
+		pendingBytes += sizeof(uint32_t) + k.size() + (v.present() ? sizeof(uint32_t) + v.get().size() : 0);
+		pending.emplace_back(k, v);
+		if (pendingBytes >= CLIENT_KNOBS->BACKUP_RANGEFILE_COMPRESSION_CHUNK_BYTES) {
+			return flushChunk(this);
+		}
+		return Void();
+	}
+
+	Future<Void> writeKV(Key k, Value v) { return add(k, v); }
+
+	// Write begin key or end key.
+	Future<Void> writeKey(Key k) { return add(k, Optional<Value>()); }
+
+	// Used in simulation only to create backup file sizes which are an integer multiple of the block size
+	ACTOR static Future<Void> padEnd_impl(CompressedRangeFileWriter* self, bool final) {
+		wait(flushChunk(self));
+		if (self->file->size() > 0) {
+			wait(newBlock(self, final));
+		}
+		return Void();
+	}
+
+	Future<Void> padEnd(bool final) {
+		ASSERT(g_network->isSimulated());
+		return padEnd_impl(this, final);
+	}
+
+	Future<Void> finish() { return flushChunk(this); }
+
+	Reference<IBackupFile> file;
+	int blockSize;
+
+private:
+	int64_t blockEnd;
+	uint32_t fileVersion;
+	uint8_t filter;
+	int blockChunks;
+	// Keys and kv pairs not yet compressed; a key without a value is a begin or end key
+	std::vector<std::pair<Key, Optional<Value>>> pending;
+	int pendingBytes;
+	Key lastKey;
+	Key lastValue;
+};
+
+// Decompresses the chunks of a BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION block, read after its header, into the
+// key and value stream that decodeKVPairs expects.
+static StringRef decompressRangeFileBlock(StringRefReader* reader, Arena& arena) {
+	uint8_t filter = reader->consume<uint8_t>();
+	if (filter >= (uint8_t)CompressionFilter::LAST) {
+		throw restore_corrupted_data();
+	}
+	std::vector<StringRef> chunks;
+	int size = 0;
+	// The first byte of a chunk length is never 0xFF
+	while (!reader->eof() && *reader->rptr != 0xFF) {
+		uint32_t len = reader->consumeNetworkUInt32();
+		StringRef chunk(reader->consume(len), len);
+		chunks.push_back(CompressionUtils::decompress((CompressionFilter)filter, chunk, arena));
+		size += chunks.back().size();
+	}
+	for (auto b : reader->remainder()) {
+		if (b != 0xFF) {
+			throw restore_corrupted_data_padding();
+		}
+	}
+	if (chunks.size() == 1) {
+		return chunks[0];
+	}
+	uint8_t* buf = new (arena) uint8_t[size];
+	uint8_t* wPtr = buf;
+	for (auto const& c : chunks) {
+		memcpy(wPtr, c.begin(), c.size());
+		wPtr += c.size();
+	}
+	return StringRef(buf, size);
+}
+
 ACTOR static Future<Void> decodeKVPairs(StringRefReader* reader,
                                         Standalone<VectorRef<KeyValueRef>>* results,
                                         bool encryptedBlock,
@@ -1178,11 +1502,15 @@ ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<
 	state int64_t blockDomainId = TenantInfo::INVALID_TENANT;
 
 	try {
-		// Read header, currently only decoding BACKUP_AGENT_SNAPSHOT_FILE_VERSION or
-		// BACKUP_AGENT_ENCRYPTED_SNAPSHOT_FILE_VERSION
+		// Read header, currently only decoding BACKUP_AGENT_SNAPSHOT_FILE_VERSION,
+		// BACKUP_AGENT_ENCRYPTED_SNAPSHOT_FILE_VERSION or BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION
 		int32_t file_version = reader.consume<int32_t>();
 		if (file_version == BACKUP_AGENT_SNAPSHOT_FILE_VERSION) {
 			wait(decodeKVPairs(&reader, &results, false, encryptMode, Optional<int64_t>(), tenantCache));
+		} else if (file_version == BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION) {
+			CODE_PROBE(true, "decoding compressed block");
+			reader = StringRefReader(decompressRangeFileBlock(&reader, results.arena()), restore_corrupted_data());
+			wait(decodeKVPairs(&reader, &results, false, encryptMode, Optional<int64_t>(), tenantCache));
 		} else if (file_version == BACKUP_AGENT_ENCRYPTED_SNAPSHOT_FILE_VERSION) {
 			CODE_PROBE(true, "decoding encrypted block");
 			// decode options struct
@@ -1920,6 +2248,12 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 					CODE_PROBE(true, "using encrypted snapshot file writer");
 					rangeFile = std::make_unique<EncryptedRangeFileWriter>(
 					    cx, &arena, encryptMode, tenantCache, outFile, blockSize);
+				} else if (CLIENT_KNOBS->BACKUP_RANGEFILE_COMPRESSION_FILTER != "NONE") {
+					CODE_PROBE(true, "using compressed snapshot file writer");
+					rangeFile = std::make_unique<CompressedRangeFileWriter>(
+					    outFile,
+					    blockSize,
+					    CompressionUtils::fromFilterString(CLIENT_KNOBS->BACKUP_RANGEFILE_COMPRESSION_FILTER));
 				} else {
 					rangeFile = std::make_unique<RangeFileWriter>(outFile, blockSize);
 				}
@@ -6901,3 +7235,37 @@ void simulateBlobFailure() {
 		}
 	}
 }
+
+TEST_CASE("/backup/partitionedLogBlock") {
+	state int blockSize = deterministicRandom()->randomInt(1000, 10000);
+	state CompressionFilter filter = CompressionUtils::getRandomFilter();
+	state fileBackup::PartitionedLogBlockEncoder encoder(blockSize, filter, deterministicRandom()->randomInt(1, 500));
+	state std::vector<std::pair<LogMessageVersion, Standalone<StringRef>>> expected;
+	state Version version = 100;
+	for (int i = 0; i < 1000; i++) {
+		if (deterministicRandom()->coinflip()) {
+			version += deterministicRandom()->randomInt(1, 10);
+		}
+		Standalone<StringRef> message(
+		    deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 200)));
+		expected.emplace_back(LogMessageVersion(version, i), message);
+		encoder.add(expected.back().first, message);
+	}
+	encoder.finish();
+	std::vector<Standalone<StringRef>> blocks = encoder.takeBlocks();
+
+	Arena arena;
+	int n = 0;
+	for (int b = 0; b < blocks.size(); b++) {
+		ASSERT(b == blocks.size() - 1 || blocks[b].size() == blockSize);
+		for (auto const& m : fileBackup::decodePartitionedLogBlock(blocks[b], arena)) {
+			ASSERT(m.version == expected[n].first);
+			ASSERT(m.message == expected[n].second);
+			n++;
+		}
+		// Blocks entirely before the version range are skipped
+		ASSERT(fileBackup::decodePartitionedLogBlock(blocks[b], arena, version + 1).empty());
+	}
+	ASSERT_EQ(n, expected.size());
+	return Void();
+}
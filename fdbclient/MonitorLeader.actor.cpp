@@ -858,6 +858,7 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 	state std::vector<GrvProxyInterface> lastGrvProxies;
 	state std::vector<ClientLeaderRegInterface> clientLeaderServers;
 	state bool allConnectionsFailed = false;
+	state double reconnectionDelay = CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY;
 
 	clientLeaderServers.reserve(coordinatorsSize);
 	for (const auto& h : cs.hostnames) {
@@ -968,6 +969,7 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 			clientInfo->setUnconditional(ni);
 			successIndex = index;
 			allConnectionsFailed = false;
+			reconnectionDelay = CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY;
 		} else {
 			CODE_PROBE(rep.getError().code() == error_code_failed_to_progress,
 			           "Coordinator cannot talk to cluster controller");
@@ -977,7 +979,9 @@ ACTOR Future<MonitorLeaderInfo> monitorProxiesOneGeneration(
 			index = (index + 1) % coordinatorsSize;
 			if (index == successIndex) {
 				allConnectionsFailed = true;
-				wait(delay(CLIENT_KNOBS->COORDINATOR_RECONNECTION_DELAY));
+				// Back off with jitter, so that a large fleet of clients does not retry the coordinators in lockstep
+				wait(delay(reconnectionDelay * (0.5 + 0.5 * deterministicRandom()->random01())));
+				reconnectionDelay = std::min(reconnectionDelay * 2, CLIENT_KNOBS->COORDINATOR_RECONNECTION_MAX_DELAY);
 			}
 		}
 	}
@@ -866,6 +866,22 @@ ThreadFuture<Standalone<StringRef>> DLDatabase::getClientStatus() {
 	});
 }
 
+ThreadFuture<Standalone<StringRef>> DLDatabase::getClientMetrics() {
+	if (!api->databaseGetClientMetrics) {
+		return unsupported_operation();
+	}
+	FdbCApi::FDBFuture* f = api->databaseGetClientMetrics(db);
+	return toThreadFuture<Standalone<StringRef>>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const uint8_t* str;
+		int strLength;
+		FdbCApi::fdb_error_t error = api->futureGetKey(f, &str, &strLength);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return Standalone<StringRef>(StringRef(str, strLength), Arena());
+	});
+}
+
 // DLApi
 
 // Loads the specified function from a dynamic library
@@ -986,6 +1002,11 @@ void DLApi::init() {
 	                   fdbCPath,
 	                   "fdb_database_get_client_status",
 	                   headerVersion >= ApiVersion::withGetClientStatus().version());
+	loadClientFunction(&api->databaseGetClientMetrics,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_get_client_metrics",
+	                   headerVersion >= ApiVersion::withGetClientMetrics().version());
 	loadClientFunction(
 	    &api->tenantCreateTransaction, lib, fdbCPath, "fdb_tenant_create_transaction", headerVersion >= 710);
 	loadClientFunction(&api->tenantPurgeBlobGranules,
@@ -1298,6 +1319,7 @@ void MultiVersionTransaction::updateTransaction(bool setPersistentOptions) {
 		}
 		newTr.onChange = currentDb.onChange;
 	}
+	newTr.directDispatch = newTr.transaction && db->dbState->directDispatch;
 
 	// When called from the constructor or from reset(), all persistent options are database options and therefore
 	// alredy set on newTr.transaction if it got created sucessfully. If newTr.transaction could not be created (i.e.,
@@ -1363,6 +1385,9 @@ ThreadFuture<T> MultiVersionTransaction::executeOperation(ThreadFuture<T> (ITran
 	auto tr = getTransaction();
 	if (tr.transaction) {
 		auto f = (tr.transaction.getPtr()->*func)(std::forward<Args>(args)...);
+		if (tr.directDispatch) {
+			return f;
+		}
 		return abortableFuture(f, tr.onChange);
 	}
 
@@ -2160,16 +2185,39 @@ ThreadFuture<Standalone<StringRef>> MultiVersionDatabase::getClientStatus() {
 	}
 }
 
+// The metrics of the client currently in use; there are none before it has connected
+ThreadFuture<Standalone<StringRef>> MultiVersionDatabase::getClientMetrics() {
+	auto db = dbState->db;
+	if (!db.isValid()) {
+		db = dbState->versionMonitorDb;
+	}
+	if (!db.isValid()) {
+		return Standalone<StringRef>("{}"_sr);
+	}
+	return db->getClientMetrics();
+}
+
 MultiVersionDatabase::DatabaseState::DatabaseState(ClusterConnectionRecord const& connectionRecord,
                                                    Reference<IDatabase> versionMonitorDb)
   : dbVar(new ThreadSafeAsyncVar<Reference<IDatabase>>(Reference<IDatabase>(nullptr))),
     connectionRecord(connectionRecord), versionMonitorDb(versionMonitorDb),
-    initializationState(InitializationState::INITIALIZING), isConfigDB(false) {}
+    initializationState(InitializationState::INITIALIZING), directDispatch(false), isConfigDB(false) {}
 
 void MultiVersionDatabase::DatabaseState::setDatabase(Reference<IDatabase> db) {
 	if (db.isValid()) {
 		initializationState = InitializationState::CREATED;
 	}
+
+	int usableClients = 0;
+	for (auto const& [version, client] : clients) {
+		usableClients += !client->failed;
+	}
+	bool direct = db.isValid() && usableClients == 1 && CLIENT_KNOBS->MULTI_VERSION_DIRECT_DISPATCH;
+	if (direct != directDispatch) {
+		TraceEvent("MultiVersionDirectDispatch").detail("Enabled", direct).detail("ProtocolVersion", dbProtocolVersion);
+	}
+	directDispatch = direct;
+
 	this->db = db;
 	dbVar->set(db, true);
 }
@@ -2917,6 +2965,34 @@ void MultiVersionApi::setNetworkOptionInternal(FDBNetworkOptions::Option option,
 		// multiple client threads are not supported on windows.
 		threadCount = extractIntOption(value, 1, 1);
 #endif
+	} else if (option == FDBNetworkOptions::CLIENT_THREADS_CPU_AFFINITY) {
+		MutexHolder holder(lock);
+		validateOption(value, true, false, false);
+		if (networkStartSetup) {
+			throw invalid_option();
+		}
+		std::vector<int> cpus;
+		StringRef cpuList = value.get();
+		while (cpuList.size()) {
+			std::string cpu = cpuList.eat(","_sr).toString();
+			char* end;
+			long n = strtol(cpu.c_str(), &end, 10);
+			if (cpu.empty() || *end || n < 0 || n >= 1024) {
+				throw invalid_option_value();
+			}
+			cpus.push_back(n);
+		}
+		threadCpus = cpus;
+	} else if (option == FDBNetworkOptions::CLIENT_THREADS_ASSIGNMENT) {
+		MutexHolder holder(lock);
+		validateOption(value, true, false, false);
+		if (value.get() == "round_robin"_sr) {
+			assignThreadsByCluster = false;
+		} else if (value.get() == "cluster"_sr) {
+			assignThreadsByCluster = true;
+		} else {
+			throw invalid_option_value();
+		}
 	} else if (option == FDBNetworkOptions::CLIENT_TMP_DIR) {
 		validateOption(value, true, false, false);
 		tmpDir = abspath(value.get().toString());
@@ -3090,8 +3166,15 @@ void MultiVersionApi::setupNetwork() {
 }
 
 THREAD_FUNC_RETURN runNetworkThread(void* param) {
+	ClientInfo* client = (ClientInfo*)param;
+	Optional<int> cpu = MultiVersionApi::api->getThreadCpu(client->threadIndex);
+	if (cpu.present()) {
+		setAffinity(cpu.get());
+		TraceEvent("ExternalNetworkThreadAffinity").detail("ThreadIndex", client->threadIndex).detail("CPU", cpu.get());
+	}
+
 	try {
-		((ClientInfo*)param)->api->runNetwork();
+		client->api->runNetwork();
 	} catch (Error& e) {
 		TraceEvent(SevError, "ExternalRunNetworkError").error(e);
 	} catch (std::exception& e) {
@@ -3186,8 +3269,14 @@ Reference<IDatabase> MultiVersionApi::createDatabase(ClusterConnectionRecord con
 	if (localClientDisabled) {
 		ASSERT(!bypassMultiClientApi);
 
-		int threadIdx = nextThread;
-		nextThread = (nextThread + 1) % threadCount;
+		int threadIdx;
+		if (assignThreadsByCluster) {
+			// Databases of one cluster share a thread and its connections
+			threadIdx = std::hash<std::string>()(connectionRecord.toString()) % threadCount;
+		} else {
+			threadIdx = nextThread;
+			nextThread = (nextThread + 1) % threadCount;
+		}
 		lock.leave();
 
 		Reference<IDatabase> localDb = connectionRecord.createDatabase(localClient->api);
@@ -3423,7 +3512,7 @@ void MultiVersionApi::loadEnvironmentVariableNetworkOptions() {
 MultiVersionApi::MultiVersionApi()
   : callbackOnMainThread(true), localClientDisabled(false), networkStartSetup(false), networkSetup(false),
     disableBypass(false), bypassMultiClientApi(false), externalClient(false), ignoreExternalClientFailures(false),
-    failIncompatibleClient(false), retainClientLibCopies(false), apiVersion(0), threadCount(0), tmpDir("/tmp"),
+    failIncompatibleClient(false), retainClientLibCopies(false), apiVersion(0), threadCount(0), assignThreadsByCluster(false), tmpDir("/tmp"),
     traceShareBaseNameAmongThreads(false), envOptionsLoaded(false) {}
 
 MultiVersionApi* MultiVersionApi::api = new MultiVersionApi();
@@ -78,6 +78,18 @@ ACTOR Future<Void> PipelinedReader::getNext_impl(PipelinedReader* self, Database
 		// Get the lock
 		wait(self->readerLimit.take());
 
+		// Reading ahead of the block the consumer waits on also needs room in the bytes buffered by all the readers.
+		// A reader with nothing buffered never waits for it, so a full buffer cannot starve the consumer.
+		state int64_t reserved = 0;
+		while (reserved == 0 && !self->reservations.empty()) {
+			choose {
+				when(wait(self->bufferedBytes->take(TaskPriority::DefaultYield, limits.bytes))) {
+					reserved = limits.bytes;
+				}
+				when(wait(self->consumed.onTrigger())) {}
+			}
+		}
+
 		// Read begin to end forever until successful
 		loop {
 			try {
@@ -86,9 +98,17 @@ ACTOR Future<Void> PipelinedReader::getNext_impl(PipelinedReader* self, Database
 
 				RangeResult kvs = wait(tr.getRange(KeyRangeRef(begin, end), limits));
 
+				// Only hold on to the bytes actually read, so that sparse hashes leave room for busy ones
+				int64_t used = kvs.empty() ? 0 : std::min<int64_t>(reserved, kvs.expectedSize());
+				if (reserved > used) {
+					self->bufferedBytes->release(reserved - used);
+				}
+				reserved = used;
+
 				// No more results, send end of stream
 				if (!kvs.empty()) {
 					// Send results to the reads stream
+					self->reservations.push_back(reserved);
 					self->reads.send(
 					    RangeResultBlock{ .result = kvs,
 					                      .firstVersion = keyRefToVersion(kvs.front().key, self->prefix.size()),
@@ -96,6 +116,9 @@ ACTOR Future<Void> PipelinedReader::getNext_impl(PipelinedReader* self, Database
 					                      .hash = self->hash,
 					                      .prefixLen = self->prefix.size(),
 					                      .indexToRead = 0 });
+				} else {
+					// The consumer will not release a block that was never sent
+					self->readerLimit.release();
 				}
 
 				if (!kvs.more) {
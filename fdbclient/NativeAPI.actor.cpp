@@ -47,6 +47,7 @@
 #include "fdbclient/AnnotateActor.h"
 #include "fdbclient/Atomic.h"
 #include "fdbclient/BlobGranuleCommon.h"
+#include "fdbclient/BlobGranuleFileCache.h"
 #include "fdbclient/ClusterInterface.h"
 #include "fdbclient/ClusterConnectionFile.h"
 #include "fdbclient/ClusterConnectionMemoryRecord.h"
@@ -78,10 +79,12 @@
 #include "fdbrpc/simulator.h"
 #include "fdbrpc/sim_validation.h"
 #include "flow/Arena.h"
+#include "flow/CompressionUtils.h"
 #include "flow/ActorCollection.h"
 #include "flow/DeterministicRandom.h"
 #include "flow/Error.h"
 #include "flow/FastRef.h"
+#include "flow/IAsyncFile.h"
 #include "flow/IRandom.h"
 #include "flow/Trace.h"
 #include "flow/ProtocolVersion.h"
@@ -679,6 +682,9 @@ ACTOR Future<Void> databaseLogger(DatabaseContext* cx) {
 			    .detail("MeanRowReadLatency", cx->readLatencies.mean())
 			    .detail("MedianRowReadLatency", cx->readLatencies.median())
 			    .detail("MaxRowReadLatency", cx->readLatencies.max())
+			    .detail("MeanRangeReadLatency", cx->rangeReadLatencies.mean())
+			    .detail("MedianRangeReadLatency", cx->rangeReadLatencies.median())
+			    .detail("MaxRangeReadLatency", cx->rangeReadLatencies.max())
 			    .detail("MeanGRVLatency", cx->GRVLatencies.mean())
 			    .detail("MedianGRVLatency", cx->GRVLatencies.median())
 			    .detail("MaxGRVLatency", cx->GRVLatencies.max())
@@ -727,10 +733,24 @@ ACTOR Future<Void> databaseLogger(DatabaseContext* cx) {
 			    .detail("MeanBGGranulesPerRequest", cx->bgGranulesPerRequest.mean())
 			    .detail("MedianBGGranulesPerRequest", cx->bgGranulesPerRequest.median())
 			    .detail("MaxBGGranulesPerRequest", cx->bgGranulesPerRequest.max());
+
+			if (BlobGranuleFileCache* cache = BlobGranuleFileCache::get()) {
+				bgReadEv.detail("FileCacheHits", cache->getHits())
+				    .detail("FileCacheMisses", cache->getMisses())
+				    .detail("FileCacheEvictions", cache->getEvictions())
+				    .detail("FileCacheBytes", cache->getBytes());
+			}
 		}
 
+		cx->totalLatencies.mergeWith(cx->latencies);
+		cx->totalReadLatencies.mergeWith(cx->readLatencies);
+		cx->totalRangeReadLatencies.mergeWith(cx->rangeReadLatencies);
+		cx->totalGRVLatencies.mergeWith(cx->GRVLatencies);
+		cx->totalCommitLatencies.mergeWith(cx->commitLatencies);
+
 		cx->latencies.clear();
 		cx->readLatencies.clear();
+		cx->rangeReadLatencies.clear();
 		cx->GRVLatencies.clear();
 		cx->commitLatencies.clear();
 		cx->mutationsPerCommit.clear();
@@ -1521,7 +1541,9 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
     transactionGetKeyRequests("GetKeyRequests", cc), transactionGetValueRequests("GetValueRequests", cc),
     transactionGetRangeRequests("GetRangeRequests", cc),
     transactionGetMappedRangeRequests("GetMappedRangeRequests", cc),
-    transactionGetRangeStreamRequests("GetRangeStreamRequests", cc), transactionWatchRequests("WatchRequests", cc),
+    transactionGetRangeStreamRequests("GetRangeStreamRequests", cc),
+    transactionRangePrefetches("RangePrefetches", cc), transactionRangePrefetchHits("RangePrefetchHits", cc),
+    transactionWatchRequests("WatchRequests", cc),
     transactionGetAddressesForKeyRequests("GetAddressesForKeyRequests", cc), transactionBytesRead("BytesRead", cc),
     transactionKeysRead("KeysRead", cc), transactionMetadataVersionReads("MetadataVersionReads", cc),
     transactionCommittedMutations("CommittedMutations", cc),
@@ -1537,7 +1559,13 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
     transactionsProcessBehind("ProcessBehind", cc), transactionsThrottled("Throttled", cc),
     transactionsExpensiveClearCostEstCount("ExpensiveClearCostEstCount", cc),
     transactionGrvFullBatches("NumGrvFullBatches", cc), transactionGrvTimedOutBatches("NumGrvTimedOutBatches", cc),
-    transactionCommitVersionNotFoundForSS("CommitVersionNotFoundForSS", cc), anyBGReads(false),
+    transactionGrvPoolHits("NumGrvPoolHits", cc), transactionGrvPoolMisses("NumGrvPoolMisses", cc),
+    transactionReadCacheHits("ReadCacheHits", cc),
+    transactionCommitVersionNotFoundForSS("CommitVersionNotFoundForSS", cc),
+    transactionReadConflictRangesMerged("ReadConflictRangesMerged", cc),
+    transactionReadConflictRangesWidened("ReadConflictRangesWidened", cc),
+    transactionCompressedRangeReplies("CompressedRangeReplies", cc),
+    transactionRangeReplyBytesSavedByCompression("RangeReplyBytesSavedByCompression", cc), anyBGReads(false),
     ccBG("BlobGranuleReadMetrics", dbId.toString()), bgReadInputBytes("BGReadInputBytes", ccBG),
     bgReadOutputBytes("BGReadOutputBytes", ccBG), bgReadSnapshotRows("BGReadSnapshotRows", ccBG),
     bgReadRowsCleared("BGReadRowsCleared", ccBG), bgReadRowsInserted("BGReadRowsInserted", ccBG),
@@ -1568,6 +1596,9 @@ DatabaseContext::DatabaseContext(Reference<AsyncVar<Reference<IClusterConnection
 	logger = databaseLogger(this) && tssLogger(this);
 	locationCacheSize = g_network->isSimulated() ? CLIENT_KNOBS->LOCATION_CACHE_EVICTION_SIZE_SIM
 	                                             : CLIENT_KNOBS->LOCATION_CACHE_EVICTION_SIZE;
+	readCache.setCapacity(CLIENT_KNOBS->READ_CACHE_SIZE);
+	// Opened here so that the granule file cache is set up on the network thread, not by a client thread's first read
+	BlobGranuleFileCache::get();
 
 	getValueSubmitted.init("NativeAPI.GetValueSubmitted"_sr);
 	getValueCompleted.init("NativeAPI.GetValueCompleted"_sr);
@@ -1821,7 +1852,9 @@ DatabaseContext::DatabaseContext(const Error& err)
     transactionGetKeyRequests("GetKeyRequests", cc), transactionGetValueRequests("GetValueRequests", cc),
     transactionGetRangeRequests("GetRangeRequests", cc),
     transactionGetMappedRangeRequests("GetMappedRangeRequests", cc),
-    transactionGetRangeStreamRequests("GetRangeStreamRequests", cc), transactionWatchRequests("WatchRequests", cc),
+    transactionGetRangeStreamRequests("GetRangeStreamRequests", cc),
+    transactionRangePrefetches("RangePrefetches", cc), transactionRangePrefetchHits("RangePrefetchHits", cc),
+    transactionWatchRequests("WatchRequests", cc),
     transactionGetAddressesForKeyRequests("GetAddressesForKeyRequests", cc), transactionBytesRead("BytesRead", cc),
     transactionKeysRead("KeysRead", cc), transactionMetadataVersionReads("MetadataVersionReads", cc),
     transactionCommittedMutations("CommittedMutations", cc),
@@ -1837,7 +1870,13 @@ DatabaseContext::DatabaseContext(const Error& err)
     transactionsProcessBehind("ProcessBehind", cc), transactionsThrottled("Throttled", cc),
     transactionsExpensiveClearCostEstCount("ExpensiveClearCostEstCount", cc),
     transactionGrvFullBatches("NumGrvFullBatches", cc), transactionGrvTimedOutBatches("NumGrvTimedOutBatches", cc),
-    transactionCommitVersionNotFoundForSS("CommitVersionNotFoundForSS", cc), anyBGReads(false),
+    transactionGrvPoolHits("NumGrvPoolHits", cc), transactionGrvPoolMisses("NumGrvPoolMisses", cc),
+    transactionReadCacheHits("ReadCacheHits", cc),
+    transactionCommitVersionNotFoundForSS("CommitVersionNotFoundForSS", cc),
+    transactionReadConflictRangesMerged("ReadConflictRangesMerged", cc),
+    transactionReadConflictRangesWidened("ReadConflictRangesWidened", cc),
+    transactionCompressedRangeReplies("CompressedRangeReplies", cc),
+    transactionRangeReplyBytesSavedByCompression("RangeReplyBytesSavedByCompression", cc), anyBGReads(false),
     ccBG("BlobGranuleReadMetrics"), bgReadInputBytes("BGReadInputBytes", ccBG),
     bgReadOutputBytes("BGReadOutputBytes", ccBG), bgReadSnapshotRows("BGReadSnapshotRows", ccBG),
     bgReadRowsCleared("BGReadRowsCleared", ccBG), bgReadRowsInserted("BGReadRowsInserted", ccBG),
@@ -1878,6 +1917,8 @@ DatabaseContext::~DatabaseContext() {
 	clientDBInfoMonitor.cancel();
 	monitorTssInfoChange.cancel();
 	tssMismatchHandler.cancel();
+	locationCachePrewarm = Future<Void>();
+	locationCacheFile = Future<Void>();
 	if (grvUpdateHandler.isValid()) {
 		grvUpdateHandler.cancel();
 	}
@@ -2067,6 +2108,9 @@ uint64_t extractHexOption(StringRef value) {
 	return id;
 }
 
+ACTOR Future<Void> prewarmLocationCache(DatabaseContext* self, KeyRange keys);
+ACTOR Future<Void> locationCacheFileUpdater(DatabaseContext* self, std::string path);
+
 void DatabaseContext::setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value) {
 	int defaultFor = FDBDatabaseOptions::optionInfo.getMustExist(option).defaultFor;
 	if (defaultFor >= 0) {
@@ -2078,6 +2122,19 @@ void DatabaseContext::setOption(FDBDatabaseOptions::Option option, Optional<Stri
 		case FDBDatabaseOptions::LOCATION_CACHE_SIZE:
 			locationCacheSize = (int)extractIntOption(value, 0, std::numeric_limits<int>::max());
 			break;
+		case FDBDatabaseOptions::LOCATION_CACHE_PREWARM:
+			validateOptionValueNotPresent(value);
+			if (!locationCachePrewarm.isValid() || locationCachePrewarm.isReady()) {
+				locationCachePrewarm = prewarmLocationCache(this, normalKeys);
+			}
+			break;
+		case FDBDatabaseOptions::LOCATION_CACHE_FILE:
+			validateOptionValuePresent(value);
+			locationCacheFile = locationCacheFileUpdater(this, value.get().toString());
+			break;
+		case FDBDatabaseOptions::READ_CACHE_SIZE:
+			readCache.setCapacity(extractIntOption(value, 0, std::numeric_limits<int64_t>::max()));
+			break;
 		case FDBDatabaseOptions::MACHINE_ID:
 			clientLocality =
 			    LocalityData(clientLocality.processId(),
@@ -3249,6 +3306,153 @@ ACTOR Future<Void> warmRange_impl(Reference<TransactionState> trState, KeyRange
 	return Void();
 }
 
+// Fills the location cache with the shard map of keys, in pages of LOCATION_CACHE_PREWARM_SHARD_LIMIT shards, until it
+// holds locationCacheSize ranges.
+ACTOR Future<Void> prewarmLocationCache(DatabaseContext* self, KeyRange keys) {
+	state int totalRanges = 0;
+	state double startTime = now();
+	loop {
+		// The Database only lives for the request, so that self can be destroyed while this waits for nothing else
+		std::vector<KeyRangeLocationInfo> locations =
+		    wait(getKeyRangeLocations_internal(Database(Reference<DatabaseContext>::addRef(self)),
+		                                       TenantInfo(),
+		                                       keys,
+		                                       CLIENT_KNOBS->LOCATION_CACHE_PREWARM_SHARD_LIMIT,
+		                                       Reverse::False,
+		                                       SpanContext(),
+		                                       Optional<UID>(),
+		                                       UseProvisionalProxies::False,
+		                                       latestVersion));
+		wait(delay(0)); // Give ourselves the chance to get cancelled if self was destroyed
+		totalRanges += locations.size();
+		if (totalRanges >= self->locationCacheSize || locations.back().range.end >= keys.end) {
+			break;
+		}
+		keys = KeyRangeRef(locations.back().range.end, keys.end);
+	}
+	TraceEvent("LocationCachePrewarmed", self->dbId)
+	    .detail("Ranges", totalRanges)
+	    .detail("Duration", now() - startTime);
+	return Void();
+}
+
+// What the location_cache_file option saves: the cached shard map of one cluster
+struct LocationCacheFileContents {
+	constexpr static FileIdentifier file_identifier = 3915728;
+	Key clusterKey;
+	std::vector<std::pair<KeyRangeRef, std::vector<StorageServerInterface>>> locations;
+	Arena arena;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, clusterKey, locations, arena);
+	}
+};
+
+ACTOR Future<Void> loadLocationCache(DatabaseContext* self, std::string path) {
+	if (!fileExists(path)) {
+		return Void();
+	}
+	state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+	    path, IAsyncFile::OPEN_READONLY | IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_NO_AIO, 0));
+	state int64_t size = wait(file->size());
+	if (size < (int64_t)sizeof(uint64_t)) {
+		throw io_error();
+	}
+	state Standalone<StringRef> buffer = makeString(size);
+	int bytesRead = wait(file->read(mutateString(buffer), size, 0));
+	if (bytesRead != size) {
+		throw io_error();
+	}
+
+	// Interfaces are only read back by the version of the client that wrote them
+	LocationCacheFileContents contents;
+	ObjectReader reader(buffer.begin(), IncludeVersion());
+	if (reader.protocolVersion() != g_network->protocolVersion()) {
+		TraceEvent("LocationCacheFileSkipped", self->dbId)
+		    .detail("Path", path)
+		    .detailf("ProtocolVersion", "%llx", reader.protocolVersion().versionWithFlags());
+		return Void();
+	}
+	reader.deserialize(contents);
+	if (contents.clusterKey != self->getConnectionRecord()->getConnectionString().clusterKey()) {
+		TraceEvent("LocationCacheFileSkipped", self->dbId).detail("Path", path).detail("Cluster", contents.clusterKey);
+		return Void();
+	}
+
+	// Ranges that were looked up since the database was opened are newer than the file
+	int loaded = 0;
+	for (auto const& [range, servers] : contents.locations) {
+		bool cached = false;
+		for (auto r : self->locationCache.intersectingRanges(range)) {
+			cached = cached || r.value().isValid();
+		}
+		if (!cached && loaded < self->locationCacheSize) {
+			self->setCachedLocation(range, servers);
+			loaded++;
+		}
+	}
+	TraceEvent("LocationCacheFileLoaded", self->dbId)
+	    .detail("Path", path)
+	    .detail("Ranges", loaded)
+	    .detail("SavedRanges", contents.locations.size());
+	return Void();
+}
+
+ACTOR Future<Void> saveLocationCache(DatabaseContext* self, std::string path) {
+	state Value data;
+	{
+		LocationCacheFileContents contents;
+		contents.clusterKey = self->getConnectionRecord()->getConnectionString().clusterKey();
+		for (auto r : self->locationCache.ranges()) {
+			if (!r.value()) {
+				continue;
+			}
+			std::vector<StorageServerInterface> servers;
+			servers.reserve(r.value()->size());
+			for (int i = 0; i < r.value()->size(); i++) {
+				servers.push_back(r.value()->getInterface(i));
+			}
+			contents.locations.emplace_back(KeyRangeRef(contents.arena, r.range()), std::move(servers));
+		}
+		data = ObjectWriter::toValue(contents, IncludeVersion(g_network->protocolVersion()));
+	}
+
+	state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+	    path,
+	    IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE |
+	        IAsyncFile::OPEN_NO_AIO,
+	    0600));
+	wait(file->write(data.begin(), data.size(), 0));
+	// The file replaces the old one when it is synced
+	wait(file->sync());
+	return Void();
+}
+
+// Loads the location cache from path, then saves it there every LOCATION_CACHE_FILE_SAVE_INTERVAL seconds. A file that
+// can't be read is replaced by the next save.
+ACTOR Future<Void> locationCacheFileUpdater(DatabaseContext* self, std::string path) {
+	try {
+		wait(loadLocationCache(self, path));
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarn, "LocationCacheFileLoadFailed", self->dbId).error(e).detail("Path", path);
+	}
+	loop {
+		wait(delay(CLIENT_KNOBS->LOCATION_CACHE_FILE_SAVE_INTERVAL));
+		try {
+			wait(saveLocationCache(self, path));
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			TraceEvent(SevWarn, "LocationCacheFileSaveFailed", self->dbId).error(e).detail("Path", path);
+		}
+	}
+}
+
 SpanContext generateSpanID(bool transactionTracingSample, SpanContext parentContext = SpanContext()) {
 	if (parentContext.isValid()) {
 		return SpanContext(parentContext.traceID, deterministicRandom()->randomUInt64(), parentContext.m_Flags);
@@ -3411,6 +3615,16 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 
 	trState->cx->validateVersion(trState->readVersion());
 
+	// The read cache is not keyed by tenant, so reads in a tenant do not use it
+	state bool useReadCache = trState->cx->readCache.enabled() && !(useTenant && trState->tenant().present());
+	if (useReadCache) {
+		Optional<Optional<Value>> cached = trState->cx->readCache.get(trState->readVersion(), key);
+		if (cached.present()) {
+			++trState->cx->transactionReadCacheHits;
+			return cached.get();
+		}
+	}
+
 	loop {
 		state KeyRangeLocationInfo locationInfo =
 		    wait(getKeyLocation(trState, key, &StorageServerInterface::getValue, Reverse::False, useTenant));
@@ -3505,6 +3719,9 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 
 			trState->cx->transactionBytesRead += reply.value.present() ? reply.value.get().size() : 0;
 			++trState->cx->transactionKeysRead;
+			if (useReadCache) {
+				trState->cx->readCache.insert(trState->readVersion(), key, reply.value.castTo<ValueRef>());
+			}
 			return reply.value;
 		} catch (Error& e) {
 			trState->cx->getValueCompleted->latency = timer_int() - startTime;
@@ -4045,6 +4262,26 @@ void setMatchIndex(GetKeyValuesFamilyRequest& req, int matchIndex) {
 	}
 }
 
+// Mapped range reads are not compressed, since their secondary reads are already split into many small rows
+template <class GetKeyValuesFamilyRequest>
+void setCompressReply(GetKeyValuesFamilyRequest& req, Reference<TransactionState> const& trState) {
+	if constexpr (std::is_same<GetKeyValuesFamilyRequest, GetKeyValuesRequest>::value) {
+		req.compressReply = trState->options.compressRangeReads &&
+		                    CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD);
+	}
+}
+
+template <class GetKeyValuesFamilyReply>
+void decompressReply(GetKeyValuesFamilyReply& rep, DatabaseContext* cx) {
+	if constexpr (std::is_same<GetKeyValuesFamilyReply, GetKeyValuesReply>::value) {
+		int64_t compressedBytes = rep.compressedData.present() ? rep.compressedData.get().size() : 0;
+		if (decompressKeyValuesReply(rep)) {
+			++cx->transactionCompressedRangeReplies;
+			cx->transactionRangeReplyBytesSavedByCompression += rep.data.expectedSize() - compressedBytes;
+		}
+	}
+}
+
 ACTOR template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply, class RangeResultFamily>
 Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
                                         KeyRange keys,
@@ -4099,6 +4336,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 			req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
 
 			req.options = trState->readOptions;
+			setCompressReply(req, trState);
 
 			try {
 				if (trState->readOptions.present() && trState->readOptions.get().debugID.present()) {
@@ -4133,6 +4371,7 @@ Future<RangeResultFamily> getExactRange(Reference<TransactionState> trState,
 						}
 					}
 					++trState->cx->transactionPhysicalReadsCompleted;
+					decompressReply(rep, trState->cx.getPtr());
 				} catch (Error&) {
 					++trState->cx->transactionPhysicalReadsCompleted;
 					throw;
@@ -4341,6 +4580,7 @@ void getRangeFinished(Reference<TransactionState> trState,
 	trState->totalCost += getReadOperationCost(bytes);
 	trState->cx->transactionBytesRead += bytes;
 	trState->cx->transactionKeysRead += result.size();
+	trState->cx->rangeReadLatencies.addSample(now() - startTime);
 
 	if (trState->trLogInfo) {
 		trState->trLogInfo->addLog(FdbClientLogEvents::EventGetRange(startTime,
@@ -4482,6 +4722,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 
 			req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
 			req.spanContext = span.context;
+			setCompressReply(req, trState);
 			if (trState->readOptions.present() && trState->readOptions.get().debugID.present()) {
 				getRangeID = nondeterministicRandom()->randomUniqueID();
 				g_traceBatch.addAttach(
@@ -4524,6 +4765,7 @@ Future<RangeResultFamily> getRange(Reference<TransactionState> trState,
 					                     trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr));
 					rep = _rep;
 					++trState->cx->transactionPhysicalReadsCompleted;
+					decompressReply(rep, trState->cx.getPtr());
 				} catch (Error&) {
 					++trState->cx->transactionPhysicalReadsCompleted;
 					throw;
@@ -5294,6 +5536,8 @@ void Transaction::operator=(Transaction&& r) noexcept {
 	tr = std::move(r.tr);
 	trState = std::move(r.trState);
 	extraConflictRanges = std::move(r.extraConflictRanges);
+	rangePrefetch = std::move(r.rangePrefetch);
+	readVersionPins = std::move(r.readVersionPins);
 	commitResult = std::move(r.commitResult);
 	committing = std::move(r.committing);
 	backoff = r.backoff;
@@ -5597,6 +5841,32 @@ void increaseCounterForRequest(Database cx) {
 	}
 }
 
+// Asks the storage servers of keys to pin the transaction's read version, so that a long_read scan can go on reading
+// it after the MVCC window has passed. The scan does not wait for the pins, since a server only pins a version once it
+// has made it durable; until then, and on servers that cannot pin it, reads are served as usual.
+ACTOR static Future<Void> pinReadVersion(Reference<TransactionState> trState, KeyRange keys) {
+	wait(trState->startTransaction());
+	std::vector<KeyRangeLocationInfo> locations = wait(getKeyRangeLocations(trState,
+	                                                                        keys,
+	                                                                        CLIENT_KNOBS->TOO_MANY,
+	                                                                        Reverse::False,
+	                                                                        &StorageServerInterface::pinReadVersion,
+	                                                                        UseTenant::True));
+	state std::vector<Future<Void>> pins;
+	for (auto const& location : locations) {
+		for (int i = 0; i < location.locations->size(); ++i) {
+			StorageServerInterface const& ssi = location.locations->getInterface(i);
+			if (trState->pinnedServers.insert(ssi.id()).second) {
+				pins.push_back(ssi.pinReadVersion.getReply(
+				    PinReadVersionRequest(trState->getTenantInfo(), trState->readVersion())));
+			}
+		}
+	}
+	CODE_PROBE(!pins.empty(), "Long read pinned its read version");
+	wait(waitForAllReady(pins));
+	return Void();
+}
+
 template <class GetKeyValuesFamilyRequest, class GetKeyValuesFamilyReply, class RangeResultFamily>
 Future<RangeResultFamily> Transaction::getRangeInternal(const KeySelector& begin,
                                                         const KeySelector& end,
@@ -5644,15 +5914,128 @@ Future<RangeResultFamily> Transaction::getRangeInternal(const KeySelector& begin
 		extraConflictRanges.push_back(conflictRange.getFuture());
 	}
 
+	if constexpr (std::is_same_v<GetKeyValuesFamilyRequest, GetKeyValuesRequest>) {
+		if (trState->options.longRead && b.getKey() < e.getKey()) {
+			readVersionPins.push_back(pinReadVersion(trState, KeyRangeRef(b.getKey(), e.getKey())));
+		}
+	}
+
 	return ::getRange<GetKeyValuesFamilyRequest, GetKeyValuesFamilyReply, RangeResultFamily>(
 	    trState, b, e, mapper, limits, conflictRange, matchIndex, snapshot, reverse);
 }
 
+Optional<std::pair<KeySelector, KeySelector>> RangePrefetchBatch::continuation(Reverse reverse) const {
+	if (!result.more || result.empty()) {
+		return Optional<std::pair<KeySelector, KeySelector>>();
+	}
+	if (reverse) {
+		return std::make_pair(begin, KeySelector(firstGreaterOrEqual(result.back().key), result.arena()));
+	}
+	KeySelector b(firstGreaterThan(result.back().key), result.arena());
+	b.removeOrEqual(b.arena());
+	return std::make_pair(b, end);
+}
+
+ACTOR static Future<RangePrefetchBatch> getRangePrefetchBatch(Future<RangeResult> result,
+                                                              KeySelector begin,
+                                                              KeySelector end,
+                                                              int bytes) {
+	RangeResult r = wait(result);
+	RangePrefetchBatch batch;
+	batch.begin = begin;
+	batch.end = end;
+	batch.bytes = bytes;
+	batch.result = r;
+	return batch;
+}
+
+// Reads the batch that continues after previous, with twice its byte limit up to RANGE_PREFETCH_MAX_BYTES. The
+// result is empty if previous was the end of the range.
+ACTOR static Future<RangePrefetchBatch> prefetchRangeBatch(Reference<TransactionState> trState,
+                                                           Future<RangePrefetchBatch> previous,
+                                                           Reverse reverse) {
+	state RangePrefetchBatch batch = wait(previous);
+	Optional<std::pair<KeySelector, KeySelector>> next = batch.continuation(reverse);
+	if (!next.present()) {
+		return RangePrefetchBatch();
+	}
+	batch.begin = next.get().first;
+	batch.end = next.get().second;
+	if (batch.begin.offset >= batch.end.offset && batch.begin.getKey() >= batch.end.getKey()) {
+		return RangePrefetchBatch();
+	}
+	if (batch.bytes != GetRangeLimits::BYTE_LIMIT_UNLIMITED) {
+		batch.bytes = std::max<int64_t>(batch.bytes,
+		                                std::min<int64_t>(2 * (int64_t)batch.bytes, CLIENT_KNOBS->RANGE_PREFETCH_MAX_BYTES));
+	}
+
+	++trState->cx->transactionRangePrefetches;
+	RangeResult result = wait(::getRange<GetKeyValuesRequest, GetKeyValuesReply, RangeResult>(
+	    trState,
+	    batch.begin,
+	    batch.end,
+	    ""_sr,
+	    GetRangeLimits(GetRangeLimits::ROW_LIMIT_UNLIMITED, batch.bytes),
+	    Promise<std::pair<Key, Key>>(),
+	    MATCH_INDEX_ALL,
+	    Snapshot::True,
+	    reverse));
+	batch.result = result;
+	return batch;
+}
+
+Future<RangeResult> Transaction::getRangePrefetch(const KeySelector& begin,
+                                                  const KeySelector& end,
+                                                  GetRangeLimits limits,
+                                                  Reverse reverse) {
+	KeySelector b = begin;
+	b.removeOrEqual(b.arena());
+	KeySelector e = end;
+	e.removeOrEqual(e.arena());
+
+	// A scan continuing from the last batch returned is served by the first prefetched batch, which was read at this
+	// transaction's read version with the same selectors.
+	bool hit = false;
+	if (rangePrefetch.present() && rangePrefetch.get().reverse == reverse && !rangePrefetch.get().next.empty() &&
+	    rangePrefetch.get().last.isReady() && !rangePrefetch.get().last.isError()) {
+		Optional<std::pair<KeySelector, KeySelector>> next = rangePrefetch.get().last.get().continuation(reverse);
+		hit = next.present() && next.get().first == b && next.get().second == e;
+	}
+
+	if (hit) {
+		CODE_PROBE(true, "getRange served from a prefetched batch");
+		++trState->cx->transactionLogicalReads;
+		++trState->cx->transactionGetRangeRequests;
+		++trState->cx->transactionRangePrefetchHits;
+		rangePrefetch.get().last = rangePrefetch.get().next.front();
+		rangePrefetch.get().next.pop_front();
+	} else {
+		Future<RangeResult> result = getRangeInternal<GetKeyValuesRequest, GetKeyValuesReply, RangeResult>(
+		    b, e, ""_sr, limits, MATCH_INDEX_ALL, Snapshot::True, reverse);
+		rangePrefetch = RangePrefetch();
+		rangePrefetch.get().reverse = reverse;
+		rangePrefetch.get().last = getRangePrefetchBatch(result, b, e, limits.bytes);
+	}
+
+	RangePrefetch& prefetch = rangePrefetch.get();
+	while (prefetch.next.size() < (size_t)CLIENT_KNOBS->RANGE_PREFETCH_DEPTH) {
+		prefetch.next.push_back(
+		    prefetchRangeBatch(trState, prefetch.next.empty() ? prefetch.last : prefetch.next.back(), reverse));
+	}
+	return map(prefetch.last, [](const RangePrefetchBatch& batch) { return batch.result; });
+}
+
 Future<RangeResult> Transaction::getRange(const KeySelector& begin,
                                           const KeySelector& end,
                                           GetRangeLimits limits,
                                           Snapshot snapshot,
                                           Reverse reverse) {
+	// Prefetched batches are read without conflict ranges, so only snapshot reads can use them. Reads through a
+	// ReadYourWritesTransaction are snapshot reads at this level.
+	if (limits.prefetch && snapshot && !limits.hasRowLimit() && limits.minRows <= 1 &&
+	    CLIENT_KNOBS->RANGE_PREFETCH_DEPTH > 0) {
+		return getRangePrefetch(begin, end, limits, reverse);
+	}
 	return getRangeInternal<GetKeyValuesRequest, GetKeyValuesReply, RangeResult>(
 	    begin, end, ""_sr, limits, MATCH_INDEX_ALL, snapshot, reverse);
 }
@@ -5784,6 +6167,13 @@ void Transaction::atomicOp(const KeyRef& key,
                            MutationRef::Type operationType,
                            AddConflictRange addConflictRange) {
 	++trState->cx->transactionAtomicMutations;
+	if (operationType == MutationRef::AppendVersionstamped) {
+		// The commit proxy extends the key, so it is checked at its final size
+		if (key.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE > getMaxWriteKeySize(key, trState->options.rawAccess))
+			throw key_too_large();
+		if (++trState->appends > MAX_APPENDS_PER_TRANSACTION)
+			throw client_invalid_operation();
+	}
 	if (key.size() > getMaxWriteKeySize(key, trState->options.rawAccess))
 		throw key_too_large();
 	if (operand.size() > CLIENT_KNOBS->VALUE_SIZE_LIMIT)
@@ -5798,13 +6188,30 @@ void Transaction::atomicOp(const KeyRef& key,
 
 	auto& req = tr;
 	auto& t = req.transaction;
+
+	// An operation following one of the same kind on the same key is folded into it, so that the many operations of
+	// counter heavy transactions commit as one
+	if (!t.mutations.empty() && t.mutations.back().type == operationType && t.mutations.back().param1 == key &&
+	    canFoldAtomicOp(operationType, t.mutations.back().param2, operand)) {
+		CODE_PROBE(true, "NativeAPI folded atomic operation");
+		MutationRef const& last = t.mutations.back();
+		foldAtomicOp(operationType, last.param2, operand);
+		if (addConflictRange && (t.write_conflict_ranges.empty() || t.write_conflict_ranges.back().begin != key ||
+		                         !t.write_conflict_ranges.back().singleKeyRange())) {
+			t.write_conflict_ranges.push_back(req.arena, singleKeyRange(last.param1, req.arena));
+		}
+		return;
+	}
+
 	auto r = singleKeyRange(key, req.arena);
 	auto v = ValueRef(req.arena, operand);
 
 	t.mutations.emplace_back(req.arena, operationType, r.begin, v);
 	trState->totalCost += getWriteOperationCost(key.expectedSize());
 
-	if (addConflictRange && operationType != MutationRef::SetVersionstampedKey)
+	// The commit proxy adds the conflict ranges of keys it makes
+	if (addConflictRange && operationType != MutationRef::SetVersionstampedKey &&
+	    operationType != MutationRef::AppendVersionstamped)
 		t.write_conflict_ranges.push_back(req.arena, r);
 
 	CODE_PROBE(true, "NativeAPI atomic operation");
@@ -5950,6 +6357,8 @@ void TransactionOptions::clear() {
 	useGrvCache = false;
 	skipGrvCache = false;
 	rawAccess = false;
+	compressRangeReads = false;
+	longRead = false;
 	bypassStorageQuota = false;
 }
 
@@ -5970,6 +6379,8 @@ void Transaction::resetImpl(bool generateNewSpan) {
 	trState = trState->cloneAndReset(createTrLogInfoProbabilistically(trState->cx), generateNewSpan);
 	tr = CommitTransactionRequest(trState->spanContext);
 	extraConflictRanges.clear();
+	rangePrefetch.reset();
+	readVersionPins.clear();
 	commitResult = Promise<Void>();
 	committing = Future<Void>();
 	cancelWatches();
@@ -6029,6 +6440,66 @@ Optional<KeyRangeRef> intersects(VectorRef<KeyRangeRef> lhs, VectorRef<KeyRangeR
 	return Optional<KeyRangeRef>();
 }
 
+// Sorts ranges and merges the ones that overlap or touch. If more than limit ranges remain and limit is positive, runs
+// of consecutive ranges are then replaced by the ranges covering them. Widening can only add conflicts, never miss one.
+// Returns the number of ranges removed by merging and by widening.
+std::pair<int, int> coalesceConflictRanges(VectorRef<KeyRangeRef>& ranges, int limit) {
+	int originalSize = ranges.size();
+	if (originalSize < 2) {
+		return { 0, 0 };
+	}
+	std::sort(ranges.begin(), ranges.end(), compareBegin);
+
+	int last = 0;
+	for (int i = 1; i < ranges.size(); i++) {
+		if (ranges[i].begin <= ranges[last].end) {
+			if (ranges[last].end < ranges[i].end) {
+				ranges[last] = KeyRangeRef(ranges[last].begin, ranges[i].end);
+			}
+		} else {
+			ranges[++last] = ranges[i];
+		}
+	}
+	int mergedSize = last + 1;
+
+	int finalSize = mergedSize;
+	if (limit > 0 && mergedSize > limit) {
+		int group = (mergedSize + limit - 1) / limit;
+		finalSize = 0;
+		for (int i = 0; i < mergedSize; i += group) {
+			ranges[finalSize++] = KeyRangeRef(ranges[i].begin, ranges[std::min(i + group, mergedSize) - 1].end);
+		}
+	}
+
+	while (ranges.size() > finalSize) {
+		ranges.pop_back();
+	}
+	return { originalSize - mergedSize, mergedSize - finalSize };
+}
+
+TEST_CASE("/fdbclient/NativeAPI/coalesceConflictRanges") {
+	Arena arena;
+	VectorRef<KeyRangeRef> ranges;
+	ranges.push_back(arena, KeyRangeRef("c"_sr, "d"_sr));
+	ranges.push_back(arena, KeyRangeRef("a"_sr, "b"_sr));
+	ranges.push_back(arena, KeyRangeRef("b"_sr, "c"_sr));
+	ranges.push_back(arena, KeyRangeRef("e"_sr, "g"_sr));
+	ranges.push_back(arena, KeyRangeRef("f"_sr, "f\x00"_sr));
+	ranges.push_back(arena, KeyRangeRef("x"_sr, "y"_sr));
+
+	ASSERT(coalesceConflictRanges(ranges, 0) == std::make_pair(3, 0));
+	ASSERT_EQ(ranges.size(), 3);
+	ASSERT(ranges[0] == KeyRangeRef("a"_sr, "d"_sr));
+	ASSERT(ranges[1] == KeyRangeRef("e"_sr, "g"_sr));
+	ASSERT(ranges[2] == KeyRangeRef("x"_sr, "y"_sr));
+
+	ASSERT(coalesceConflictRanges(ranges, 2) == std::make_pair(0, 1));
+	ASSERT_EQ(ranges.size(), 2);
+	ASSERT(ranges[0] == KeyRangeRef("a"_sr, "g"_sr));
+	ASSERT(ranges[1] == KeyRangeRef("x"_sr, "y"_sr));
+	return Void();
+}
+
 ACTOR void checkWrites(Reference<TransactionState> trState,
                        Future<Void> committed,
                        Promise<Void> outCommitted,
@@ -6595,6 +7066,45 @@ ACTOR static Future<Void> tryCommit(Reference<TransactionState> trState, CommitT
 	}
 }
 
+ACTOR static Future<bool> checkReadConflicts(Reference<TransactionState> trState, CommitTransactionRequest req) {
+	try {
+		wait(trState->startTransaction());
+		req.transaction.read_snapshot = trState->readVersion();
+		if (trState->hasTenant()) {
+			applyTenantPrefix(req, trState->tenant().get()->prefix());
+		}
+		req.tenantInfo = trState->getTenantInfo();
+
+		// Nothing is written, so the resolvers only check the reads and a reply of any kind changes nothing
+		choose {
+			when(wait(trState->cx->onProxiesChanged())) {}
+			when(wait(success(basicLoadBalance(trState->cx->getCommitProxies(trState->useProvisionalProxies),
+			                                   &CommitProxyInterface::commit,
+			                                   req,
+			                                   TaskPriority::DefaultPromiseEndpoint,
+			                                   AtMostOnce::True)))) {}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		if (e.code() == error_code_not_committed || e.code() == error_code_transaction_too_old) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Future<bool> Transaction::checkReadConflicts(Standalone<VectorRef<KeyRangeRef>> readRanges) {
+	CommitTransactionRequest req;
+	req.arena.dependsOn(readRanges.arena());
+	req.transaction.read_conflict_ranges = readRanges;
+	if (trState->options.lockAware) {
+		req.flags = req.flags | CommitTransactionRequest::FLAG_IS_LOCK_AWARE;
+	}
+	return ::checkReadConflicts(trState, req);
+}
+
 Future<Void> Transaction::commitMutations() {
 	try {
 		// if this is a read-only transaction return immediately
@@ -6644,6 +7154,15 @@ Future<Void> Transaction::commitMutations() {
 				tr.transaction.read_conflict_ranges.emplace_back(
 				    tr.arena, extraConflictRanges[i].get().first, extraConflictRanges[i].get().second);
 
+		// Resolvers sort and check every read conflict range, so send as few as possible. Reported conflicting keys
+		// refer to the ranges as the client added them, so those transactions keep theirs.
+		if (CLIENT_KNOBS->COMMIT_COALESCE_READ_CONFLICT_RANGES && !trState->options.reportConflictingKeys) {
+			auto [merged, widened] = coalesceConflictRanges(tr.transaction.read_conflict_ranges,
+			                                                CLIENT_KNOBS->COMMIT_READ_CONFLICT_RANGE_LIMIT);
+			trState->cx->transactionReadConflictRangesMerged += merged;
+			trState->cx->transactionReadConflictRangesWidened += widened;
+		}
+
 		if (tr.idempotencyId.valid()) {
 			// We need to be able confirm that this transaction is no longer in
 			// flight, and if the idempotency id is in the read and write
@@ -6761,6 +7280,11 @@ void Transaction::setOption(FDBTransactionOptions::Option option, Optional<Strin
 		trState->options.getReadVersionFlags |= GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY;
 		break;
 
+	case FDBTransactionOptions::BOUNDED_STALE_READ_VERSION:
+		validateOptionValueNotPresent(value);
+		trState->options.getReadVersionFlags |= GetReadVersionRequest::FLAG_BOUNDED_STALENESS;
+		break;
+
 	case FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE:
 		validateOptionValueNotPresent(value);
 		trState->options.priority = TransactionPriority::IMMEDIATE;
@@ -6949,6 +7473,17 @@ void Transaction::setOption(FDBTransactionOptions::Option option, Optional<Strin
 		validateOptionValueNotPresent(value);
 		trState->options.skipGrvCache = true;
 		break;
+
+	case FDBTransactionOptions::COMPRESS_RANGE_READS:
+		validateOptionValueNotPresent(value);
+		trState->options.compressRangeReads = true;
+		break;
+
+	case FDBTransactionOptions::LONG_READ:
+		validateOptionValueNotPresent(value);
+		trState->options.longRead = true;
+		break;
+
 	case FDBTransactionOptions::READ_SYSTEM_KEYS:
 	case FDBTransactionOptions::ACCESS_SYSTEM_KEYS:
 	case FDBTransactionOptions::RAW_ACCESS:
@@ -7177,17 +7712,23 @@ ACTOR Future<Void> readVersionBatcher(DatabaseContext* cx,
 	}
 }
 
+// requestTime is when the GRV request that f is the reply of was made, which is before trState->startTime if the read
+// version comes from the read version pool
 ACTOR Future<Version> extractReadVersion(Reference<TransactionState> trState,
                                          Location location,
                                          SpanContext spanContext,
                                          Future<GetReadVersionReply> f,
+                                         double requestTime,
                                          Promise<Optional<Value>> metadataVersion) {
 	state Span span(spanContext, location, trState->spanContext);
 	GetReadVersionReply rep = wait(f);
 	double replyTime = now();
 	double latency = replyTime - trState->startTime;
-	trState->cx->lastProxyRequestTime = trState->startTime;
-	trState->cx->updateCachedReadVersion(trState->startTime, rep.version);
+	if (requestTime < trState->startTime) {
+		trState->cx->grvPoolWaitTimes.addSample(latency);
+	}
+	trState->cx->lastProxyRequestTime = requestTime;
+	trState->cx->updateCachedReadVersion(requestTime, rep.version);
 	if (rep.rkBatchThrottled) {
 		trState->cx->lastRkBatchThrottleTime = replyTime;
 	}
@@ -7348,19 +7889,48 @@ Future<Version> TransactionState::getReadVersion(uint32_t flags) {
 		}
 	}
 
+	Location location = "NAPI:getReadVersion"_loc;
+	// Tagged transactions are excluded from the pool because tag throttling is accounted per GRV request
+	const bool usePool = (flags & GetReadVersionRequest::FLAG_BOUNDED_STALENESS) &&
+	                     CLIENT_KNOBS->GRV_SHARE_WINDOW > 0 && options.tags.size() == 0;
+	if (usePool) {
+		auto& shared = cx->sharedReadVersions[flags];
+		if (shared.reply.isValid() && !shared.reply.isError() &&
+		    now() - shared.requestTime <= CLIENT_KNOBS->GRV_SHARE_WINDOW) {
+			CODE_PROBE(true, "Bounded stale transaction sharing a read version request");
+			++cx->transactionGrvPoolHits;
+			startTime = now();
+			return extractReadVersion(Reference<TransactionState>::addRef(this),
+			                          location,
+			                          spanContext,
+			                          shared.reply,
+			                          shared.requestTime,
+			                          metadataVersion);
+		}
+		++cx->transactionGrvPoolMisses;
+	}
+
 	auto& batcher = cx->versionBatcher[flags];
 	if (!batcher.actor.isValid()) {
 		batcher.actor = readVersionBatcher(cx.getPtr(), batcher.stream.getFuture(), options.priority, flags);
 	}
 
-	Location location = "NAPI:getReadVersion"_loc;
 	SpanContext derivedSpanContext = generateSpanID(cx->transactionTracingSample, spanContext);
 	Optional<UID> versionDebugID = readOptions.present() ? readOptions.get().debugID : Optional<UID>();
 	auto const req = DatabaseContext::VersionRequest(derivedSpanContext, options.tags, versionDebugID);
 	batcher.stream.send(req);
 	startTime = now();
-	return extractReadVersion(
-	    Reference<TransactionState>::addRef(this), location, spanContext, req.reply.getFuture(), metadataVersion);
+	if (usePool) {
+		auto& shared = cx->sharedReadVersions[flags];
+		shared.reply = req.reply.getFuture();
+		shared.requestTime = startTime;
+	}
+	return extractReadVersion(Reference<TransactionState>::addRef(this),
+	                          location,
+	                          spanContext,
+	                          req.reply.getFuture(),
+	                          startTime,
+	                          metadataVersion);
 }
 
 Optional<Version> Transaction::getCachedReadVersion() const {
@@ -7978,6 +8548,94 @@ Future<Standalone<VectorRef<KeyRef>>> Transaction::getRangeSplitPoints(KeyRange
 	return ::getRangeSplitPoints(trState, keys, chunkSize);
 }
 
+// Aggregates the part of the range in one shard, sending another request from where each reply stopped
+ACTOR Future<RangeAggregate> getShardRangeAggregate(Reference<TransactionState> trState,
+                                                    KeyRangeLocationInfo locationInfo,
+                                                    KeyRange keys,
+                                                    SpanContext spanContext) {
+	state RangeAggregate aggregate;
+	state Key begin = keys.begin;
+	loop {
+		state VersionVector ssLatestCommitVersions;
+		trState->cx->getLatestCommitVersions(locationInfo.locations, trState, ssLatestCommitVersions);
+		++trState->cx->transactionPhysicalReads;
+		try {
+			GetRangeAggregateReply reply = wait(loadBalance(
+			    locationInfo.locations->locations(),
+			    &StorageServerInterface::getRangeAggregate,
+			    GetRangeAggregateRequest(spanContext,
+			                             trState->getTenantInfo(),
+			                             KeyRangeRef(begin, keys.end),
+			                             trState->readVersion(),
+			                             trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>(),
+			                             trState->readOptions,
+			                             ssLatestCommitVersions),
+			    TaskPriority::DefaultPromiseEndpoint,
+			    AtMostOnce::False,
+			    trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr));
+			++trState->cx->transactionPhysicalReadsCompleted;
+			aggregate.add(reply.aggregate);
+			if (!reply.readThrough.present()) {
+				return aggregate;
+			}
+			begin = reply.readThrough.get();
+		} catch (Error&) {
+			++trState->cx->transactionPhysicalReadsCompleted;
+			throw;
+		}
+	}
+}
+
+ACTOR Future<RangeAggregate> getRangeAggregate(Reference<TransactionState> trState, KeyRange keys) {
+	state Span span("NAPI:getRangeAggregate"_loc, trState->spanContext);
+
+	wait(trState->startTransaction());
+	trState->cx->validateVersion(trState->readVersion());
+
+	if (keys.empty()) {
+		return RangeAggregate();
+	}
+
+	loop {
+		state std::vector<KeyRangeLocationInfo> locations =
+		    wait(getKeyRangeLocations(trState,
+		                              keys,
+		                              CLIENT_KNOBS->TOO_MANY,
+		                              Reverse::False,
+		                              &StorageServerInterface::getRangeAggregate,
+		                              UseTenant::True));
+		try {
+			state std::vector<Future<RangeAggregate>> fAggregates;
+			for (const auto& location : locations) {
+				fAggregates.push_back(
+				    getShardRangeAggregate(trState, location, intersect(location.range, keys), span.context));
+			}
+			std::vector<RangeAggregate> aggregates = wait(getAll(fAggregates));
+
+			RangeAggregate total;
+			for (const auto& aggregate : aggregates) {
+				total.add(aggregate);
+			}
+			return total;
+		} catch (Error& e) {
+			if (e.code() == error_code_wrong_shard_server || e.code() == error_code_all_alternatives_failed) {
+				trState->cx->invalidateCache(trState->tenant().mapRef(&Tenant::prefix), keys);
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, trState->taskID));
+			} else {
+				throw;
+			}
+		}
+	}
+}
+
+Future<RangeAggregate> Transaction::getRangeAggregate(KeyRange const& keys, Snapshot snapshot) {
+	++trState->cx->transactionLogicalReads;
+	if (!snapshot && !keys.empty()) {
+		tr.transaction.read_conflict_ranges.push_back_deep(tr.arena, keys);
+	}
+	return ::getRangeAggregate(trState, keys);
+}
+
 #define BG_REQUEST_DEBUG false
 
 // the blob granule requests are a bit funky because they piggyback off the existing transaction to read from the system
@@ -23,6 +23,7 @@
 #include "fdbrpc/HTTP.h"
 #include "flow/IRateControl.h"
 #include "fdbclient/RESTUtils.h"
+#include "fdbclient/Knobs.h"
 #include "flow/Arena.h"
 #include "flow/Error.h"
 #include "flow/FastRef.h"
@@ -47,6 +48,8 @@ json_spirit::mObject RESTClient::Stats::getJSON() {
 	o["requests_failed"] = requests_failed;
 	o["requests_successful"] = requests_successful;
 	o["bytes_sent"] = bytes_sent;
+	o["connections_established"] = connections_established;
+	o["connections_reused"] = connections_reused;
 
 	return o;
 }
@@ -57,14 +60,17 @@ RESTClient::Stats RESTClient::Stats::operator-(const Stats& rhs) {
 	r.requests_failed = requests_failed - rhs.requests_failed;
 	r.requests_successful = requests_successful - rhs.requests_successful;
 	r.bytes_sent = bytes_sent - rhs.bytes_sent;
+	r.connections_established = connections_established - rhs.connections_established;
+	r.connections_reused = connections_reused - rhs.connections_reused;
 
 	return r;
 }
 
-RESTClient::RESTClient() {}
+RESTClient::RESTClient() : conectionPool(makeReference<RESTConnectionPool>(knobs.connection_pool_size)) {}
 
 RESTClient::RESTClient(std::unordered_map<std::string, int>& knobSettings) {
 	knobs.set(knobSettings);
+	conectionPool = makeReference<RESTConnectionPool>(knobs.connection_pool_size);
 }
 
 void RESTClient::setKnobs(const std::unordered_map<std::string, int>& knobSettings) {
@@ -88,7 +94,7 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 		pw.serializeBytes(url->body);
 	}
 
-	std::string statsKey = RESTClient::getStatsKey(url->service, url->service);
+	std::string statsKey = RESTClient::getStatsKey(url->host, url->service);
 	auto sItr = client->statsMap.find(statsKey);
 	if (sItr == client->statsMap.end()) {
 		client->statsMap.emplace(statsKey, std::make_unique<RESTClient::Stats>(statsKey));
@@ -104,34 +110,53 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 	state double reqTimeout = (client->knobs.request_timeout_secs * 1.0) / 60;
 	state RESTConnectionPoolKey connectPoolKey = RESTConnectionPool::getConnectionPoolKey(url->host, url->service);
 	state RESTClient::Stats* statsPtr = client->statsMap[statsKey].get();
+	if (!client->requestLatency) {
+		client->requestLatency = std::make_unique<LatencySample>("RESTClientRequestLatency",
+		                                                         deterministicRandom()->randomUniqueID(),
+		                                                         CLIENT_KNOBS->REST_LATENCY_LOGGING_INTERVAL,
+		                                                         CLIENT_KNOBS->REST_LATENCY_LOGGING_ACCURACY);
+	}
+	state double requestStart = now();
 
 	loop {
 		state Optional<Error> err;
 		state Optional<NetworkAddress> remoteAddress;
 		state bool connectionEstablished = false;
+		state bool reusingConn = false;
+		state bool fastRetry = false;
 		state Reference<HTTP::Response> r;
 
 		try {
 			// Start connecting
 			Future<RESTConnectionPool::ReusableConnection> frconn = client->conectionPool->connect(
-			    connectPoolKey, client->knobs.secure_connection, client->knobs.max_connection_life);
+			    connectPoolKey, client->knobs.secure_connection, client->knobs.max_connection_life, &reusingConn);
 
 			// Finish connecting, do request
 			state RESTConnectionPool::ReusableConnection rconn =
 			    wait(timeoutError(frconn, client->knobs.connect_timeout));
 			connectionEstablished = true;
+			if (reusingConn) {
+				statsPtr->connections_reused++;
+			} else {
+				statsPtr->connections_established++;
+			}
 
 			remoteAddress = rconn.conn->getPeerAddress();
-			Reference<HTTP::Response> _r = wait(timeoutError(HTTP::doRequest(rconn.conn,
-			                                                                 verb,
-			                                                                 url->resource,
-			                                                                 headers,
-			                                                                 contentLen > 0 ? &content : nullptr,
-			                                                                 contentLen,
-			                                                                 sendReceiveRate,
-			                                                                 &statsPtr->bytes_sent,
-			                                                                 sendReceiveRate),
-			                                                 reqTimeout));
+			Future<Reference<HTTP::Response>> reqF = HTTP::doRequest(rconn.conn,
+			                                                         verb,
+			                                                         url->resource,
+			                                                         headers,
+			                                                         contentLen > 0 ? &content : nullptr,
+			                                                         contentLen,
+			                                                         sendReceiveRate,
+			                                                         &statsPtr->bytes_sent,
+			                                                         sendReceiveRate);
+
+			// A pooled connection that fails at once was most likely closed by the server while idle, so retry at
+			// once on a new connection instead of counting a try and backing off
+			fastRetry = reqF.isReady() && reusingConn;
+
+			Reference<HTTP::Response> _r = wait(timeoutError(reqF, reqTimeout));
 			r = _r;
 
 			// Since the response was parsed successfully (which is why we are here) reuse the connection unless we
@@ -151,6 +176,7 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 		// If r->code is in successCodes then record the successful request and return r.
 		if (!err.present() && successCodes.count(r->code) != 0) {
 			statsPtr->requests_successful++;
+			client->requestLatency->addMeasurement(now() - requestStart);
 			return r;
 		}
 
@@ -164,7 +190,8 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 		                 r->code == HTTP::HTTP_STATUS_CODE_TOO_MANY_REQUESTS;
 
 		// But only if our previous attempt was not the last allowable try.
-		retryable = retryable && (thisTry < maxTries);
+		fastRetry = fastRetry && err.present();
+		retryable = fastRetry || (retryable && (thisTry < maxTries));
 
 		TraceEvent event(SevWarn, retryable ? "RESTClient_FailedRetryable" : "RESTClient_RequestFailed");
 
@@ -177,7 +204,7 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 			event.detail("ResponseCode", r->code);
 		}
 
-		event.detail("ConnectionEstablished", connectionEstablished);
+		event.detail("ConnectionEstablished", connectionEstablished).detail("ReusingConn", reusingConn);
 
 		if (remoteAddress.present())
 			event.detail("RemoteEndpoint", remoteAddress.get());
@@ -185,6 +212,12 @@ ACTOR Future<Reference<HTTP::Response>> doRequest_impl(Reference<RESTClient> cli
 			event.detail("RemoteHost", url->host);
 
 		event.detail("Verb", verb).detail("Resource", url->resource).detail("ThisTry", thisTry);
+		event.detail("FastRetry", fastRetry);
+
+		if (fastRetry) {
+			wait(::delay(0));
+			continue;
+		}
 
 		// If r is not valid or not code TOO_MANY_REQUESTS then increment the try count.
 		// TOO_MANY_REQUEST's will not count against the attempt limit.
@@ -96,17 +96,16 @@ std::unordered_map<std::string, int> RESTClientKnobs::get() const {
 ACTOR Future<RESTConnectionPool::ReusableConnection> connect_impl(Reference<RESTConnectionPool> connectionPool,
                                                                   RESTConnectionPoolKey connectKey,
                                                                   bool isSecure,
-                                                                  int maxConnLife) {
-	auto poolItr = connectionPool->connectionPoolMap.find(connectKey);
-	if (poolItr == connectionPool->connectionPoolMap.end()) {
-		throw rest_connectpool_key_not_found();
-	}
-
-	while (!poolItr->second.empty()) {
-		RESTConnectionPool::ReusableConnection rconn = poolItr->second.front();
-		poolItr->second.pop();
+                                                                  int maxConnLife,
+                                                                  bool* reusingConn) {
+	*reusingConn = false;
+	auto& pool = connectionPool->connectionPoolMap[connectKey];
+	while (!pool.empty()) {
+		RESTConnectionPool::ReusableConnection rconn = pool.front();
+		pool.pop();
 
 		if (rconn.expirationTime > now()) {
+			*reusingConn = true;
 			TraceEvent("RESTClient_ReusableConnection")
 			    .suppressFor(60)
 			    .detail("RemoteEndpoint", rconn.conn->getPeerAddress())
@@ -124,21 +123,18 @@ ACTOR Future<RESTConnectionPool::ReusableConnection> connect_impl(Reference<REST
 
 Future<RESTConnectionPool::ReusableConnection> RESTConnectionPool::connect(RESTConnectionPoolKey connectKey,
                                                                            const bool isSecure,
-                                                                           const int maxConnLife) {
-	return connect_impl(Reference<RESTConnectionPool>::addRef(this), connectKey, isSecure, maxConnLife);
+                                                                           const int maxConnLife,
+                                                                           bool* reusingConn) {
+	return connect_impl(Reference<RESTConnectionPool>::addRef(this), connectKey, isSecure, maxConnLife, reusingConn);
 }
 
 void RESTConnectionPool::returnConnection(RESTConnectionPoolKey connectKey,
                                           ReusableConnection& rconn,
                                           const int maxConnections) {
-	auto poolItr = connectionPoolMap.find(connectKey);
-	if (poolItr == connectionPoolMap.end()) {
-		throw rest_connectpool_key_not_found();
-	}
-
 	// If it expires in the future then add it to the pool in the front iff connection pool size is not maxed
-	if (rconn.expirationTime > now() && poolItr->second.size() < maxConnections) {
-		poolItr->second.push(rconn);
+	auto& pool = connectionPoolMap[connectKey];
+	if (rconn.expirationTime > now() && pool.size() < maxConnections) {
+		pool.push(rconn);
 	}
 	rconn.conn = Reference<IConnection>();
 }
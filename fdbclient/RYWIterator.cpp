@@ -629,6 +629,49 @@ TEST_CASE("/fdbclient/WriteMap/addValue") {
 	return Void();
 }
 
+TEST_CASE("/fdbclient/WriteMap/foldAtomicOps") {
+	const MutationRef::Type types[] = { MutationRef::AddValue, MutationRef::And,     MutationRef::AndV2,
+		                                MutationRef::Or,       MutationRef::Xor,     MutationRef::Max,
+		                                MutationRef::Min,      MutationRef::MinV2,   MutationRef::ByteMax,
+		                                MutationRef::ByteMin };
+	Arena arena;
+	auto randomValue = [&arena](int size) {
+		StringRef value = makeString(size, arena);
+		deterministicRandom()->randomBytes(mutateString(value), size);
+		return value;
+	};
+
+	for (int n = 0; n < 1000; n++) {
+		MutationRef::Type type = types[deterministicRandom()->randomInt(0, std::size(types))];
+		int size = deterministicRandom()->randomInt(0, 5);
+		ValueRef existing = randomValue(size);
+		ValueRef operand = randomValue(size);
+
+		// Folding an operation in place gives the value that applying it does
+		RYWMutation applied =
+		    WriteMap::coalesce(RYWMutation(existing, MutationRef::SetValue), RYWMutation(operand, type), arena);
+		ValueRef folded(arena, existing);
+		foldAtomicOp(type, folded, operand);
+		ASSERT(applied.value.get() == folded);
+
+		// Reading a key through a stack of operations gives the value that applying them one at a time does
+		OperationStack stack(RYWMutation(randomValue(size), type));
+		for (int i = 0; i < 3; i++) {
+			stack.push(RYWMutation(randomValue(size), types[deterministicRandom()->randomInt(0, std::size(types))]));
+		}
+		RYWMutation expected(existing, MutationRef::SetValue);
+		for (int i = 0; i < stack.size(); i++) {
+			expected = WriteMap::coalesce(expected, stack.at(i), arena);
+		}
+		ASSERT(WriteMap::coalesceUnder(stack, existing, arena) == expected);
+	}
+
+	// Operations of different lengths are not folded
+	ASSERT(!canFoldAtomicOp(MutationRef::AddValue, "\x01"_sr, "\x01\x00"_sr));
+	ASSERT(!canFoldAtomicOp(MutationRef::AppendIfFits, "a"_sr, "b"_sr));
+	return Void();
+}
+
 TEST_CASE("/fdbclient/WriteMap/random") {
 	Arena arena = Arena();
 	WriteMap writes = WriteMap(&arena);
@@ -821,3 +864,86 @@ TEST_CASE("/fdbclient/WriteMap/random") {
 
 	return Void();
 }
+
+static std::vector<std::string> getWriteMapSegments(WriteMap::iterator it) {
+	auto segment = [&it]() {
+		std::string s = format("%s %s %d %d %d",
+		                       printable(it.beginKey().toStandaloneStringRef()).c_str(),
+		                       printable(it.endKey().toStandaloneStringRef()).c_str(),
+		                       it.type(),
+		                       it.is_conflict_range(),
+		                       it.is_unreadable());
+		for (int i = 0; it.is_operation() && i < it.op().size(); i++) {
+			auto const& op = it.op().at(i);
+			s += format(" %d:%s", op.type, op.value.present() ? printable(op.value.get()).c_str() : "-");
+		}
+		return s;
+	};
+
+	std::vector<std::string> segments;
+	for (it.skip(allKeys.begin); it.beginKey() < allKeys.end; ++it) {
+		segments.push_back(segment());
+	}
+
+	// Walking back has to find the same segments
+	std::vector<std::string> backward;
+	it.skip(allKeys.end);
+	do {
+		--it;
+		backward.push_back(segment());
+	} while (it.beginKey() != allKeys.begin);
+	std::reverse(backward.begin(), backward.end());
+	ASSERT(backward == segments);
+	return segments;
+}
+
+static void randomWriteMapOperation(std::vector<WriteMap*> const& maps, Arena& arena) {
+	int r = deterministicRandom()->randomInt(0, 7);
+	bool addConflict = deterministicRandom()->random01() < 0.5;
+	KeyRangeRef range = RandomTestImpl::getRandomRange(arena);
+	KeyRef key = RandomTestImpl::getRandomKey(arena);
+	ValueRef value = RandomTestImpl::getRandomValue(arena);
+	for (auto writes : maps) {
+		if (r == 0) {
+			writes->addConflictRange(range);
+		} else if (r == 1) {
+			writes->addUnmodifiedAndUnreadableRange(range);
+		} else if (r == 2) {
+			writes->clear(range, addConflict);
+		} else if (r == 3) {
+			writes->mutate(key, MutationRef::SetVersionstampedValue, value, addConflict);
+		} else if (r == 4) {
+			writes->mutate(key, MutationRef::SetVersionstampedKey, value, addConflict);
+		} else if (r == 5) {
+			writes->mutate(key, MutationRef::And, value, addConflict);
+		} else {
+			writes->mutate(key, MutationRef::SetValue, value, addConflict);
+		}
+	}
+}
+
+// A WriteMap that keeps its entries in a sorted array has to have the same segments as one that keeps them in the tree,
+// including after it moves them there, and iterators have to keep seeing the array as it was when they were created.
+TEST_CASE("/fdbclient/WriteMap/flatMatchesTree") {
+	Arena arena;
+	WriteMap flat(&arena, 1000);
+	WriteMap tree(&arena, 0);
+	WriteMap growing(&arena, deterministicRandom()->randomInt(1, 20));
+	std::vector<WriteMap*> maps = { &flat, &tree, &growing };
+
+	Optional<WriteMap::iterator> snapshot;
+	std::vector<std::string> snapshotSegments;
+	for (int i = 0; i < 100; i++) {
+		randomWriteMapOperation(maps, arena);
+		std::vector<std::string> expected = getWriteMapSegments(WriteMap::iterator(&tree));
+		ASSERT(getWriteMapSegments(WriteMap::iterator(&flat)) == expected);
+		ASSERT(getWriteMapSegments(WriteMap::iterator(&growing)) == expected);
+		if (i == 50) {
+			snapshot = WriteMap::iterator(&flat);
+			snapshotSegments = expected;
+		}
+	}
+	ASSERT(getWriteMapSegments(snapshot.get()) == snapshotSegments);
+
+	return Void();
+}
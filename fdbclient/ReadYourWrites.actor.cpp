@@ -364,6 +364,26 @@ public:
 			}
 		}
 	}
+	// With nothing in the write map there is nothing to merge into a range read, so the storage servers' reply is
+	// returned as is instead of going through the snapshot cache and being copied into the transaction's arena.
+	ACTOR template <bool backwards>
+	static Future<RangeResult> readRangeWithoutWrites(ReadYourWritesTransaction* ryw,
+	                                                  GetRangeReq<backwards> req,
+	                                                  Snapshot snapshot) {
+		choose {
+			when(RangeResult result = wait(readThrough(ryw, req, Snapshot::True))) {
+				if (!snapshot) {
+					WriteMap::iterator it(&ryw->writes);
+					addConflictRange(ryw, req, it, result);
+				}
+				return result;
+			}
+			when(wait(ryw->resetPromise.getFuture())) {
+				throw internal_error();
+			}
+		}
+	}
+
 	ACTOR template <class Req>
 	static Future<typename Req::Result> readWithConflictRangeSnapshot(ReadYourWritesTransaction* ryw, Req req) {
 		state SnapshotCache::iterator it(&ryw->cache, &ryw->writes);
@@ -1429,6 +1449,40 @@ public:
 		}
 	}
 
+	// Checks the reads made so far every EARLY_CONFLICT_CHECK_INTERVAL, and fails the transaction with not_committed
+	// once a later commit has written to one of them
+	ACTOR static Future<Void> detectEarlyConflicts(ReadYourWritesTransaction* ryw) {
+		loop {
+			wait(delay(CLIENT_KNOBS->EARLY_CONFLICT_CHECK_INTERVAL));
+			if (ryw->commitStarted) {
+				return Void();
+			}
+
+			Standalone<VectorRef<KeyRangeRef>> readRanges;
+			if (ryw->options.readYourWritesDisabled) {
+				readRanges = ryw->tr.readConflictRanges();
+			} else {
+				for (auto r : ryw->readConflicts.ranges()) {
+					if (r.value()) {
+						readRanges.push_back_deep(readRanges.arena(), r.range());
+					}
+				}
+			}
+			if (readRanges.empty()) {
+				continue;
+			}
+
+			bool canCommit = wait(ryw->tr.checkReadConflicts(readRanges));
+			if (!canCommit) {
+				CODE_PROBE(true, "Transaction failed early because of a conflicting read");
+				if (ryw->deferredError.code() == invalid_error_code) {
+					ryw->deferredError = not_committed();
+				}
+				return Void();
+			}
+		}
+	}
+
 	ACTOR static Future<Void> onError(ReadYourWritesTransaction* ryw, Error e) {
 		try {
 			if (ryw->resetPromise.isSet()) {
@@ -1506,6 +1560,14 @@ void ReadYourWritesTransaction::resetTimeout() {
 	    options.timeoutInSeconds == 0.0 ? Void() : timebomb(options.timeoutInSeconds + creationTime, resetPromise);
 }
 
+// Started by the first read rather than by setting the option, so that it runs for the transaction that reads even
+// if the option was set on one moved from
+void ReadYourWritesTransaction::startEarlyConflictDetection() {
+	if (options.earlyConflictDetection && !earlyConflictActor.isValid()) {
+		earlyConflictActor = RYWImpl::detectEarlyConflicts(this);
+	}
+}
+
 Future<Version> ReadYourWritesTransaction::getReadVersion() {
 	if (tr.apiVersionAtLeast(101)) {
 		if (resetPromise.isSet())
@@ -1615,6 +1677,7 @@ Future<Optional<Value>> ReadYourWritesTransaction::get(const Key& key, Snapshot
 		return Optional<Value>();
 	}
 
+	startEarlyConflictDetection();
 	Future<Optional<Value>> result = RYWImpl::readWithConflictRange(this, RYWImpl::GetValueReq(key), snapshot);
 	reading.add(success(result));
 	return result;
@@ -1631,6 +1694,7 @@ Future<Key> ReadYourWritesTransaction::getKey(const KeySelector& key, Snapshot s
 	if (key.getKey() > getMaxReadKey())
 		return key_outside_legal_range();
 
+	startEarlyConflictDetection();
 	Future<Key> result = RYWImpl::readWithConflictRange(this, RYWImpl::GetKeyReq(key), snapshot);
 	reading.add(success(result));
 	return result;
@@ -1688,9 +1752,18 @@ Future<RangeResult> ReadYourWritesTransaction::getRange(KeySelector begin,
 		return RangeResult();
 	}
 
-	Future<RangeResult> result =
-	    reverse ? RYWImpl::readWithConflictRange(this, RYWImpl::GetRangeReq<true>(begin, end, limits), snapshot)
-	            : RYWImpl::readWithConflictRange(this, RYWImpl::GetRangeReq<false>(begin, end, limits), snapshot);
+	startEarlyConflictDetection();
+	Future<RangeResult> result;
+	if (!options.readYourWritesDisabled && writes.empty() && CLIENT_KNOBS->RYW_READ_THROUGH_WITHOUT_WRITES) {
+		CODE_PROBE(true, "RYW range read without writes");
+		result = reverse
+		             ? RYWImpl::readRangeWithoutWrites(this, RYWImpl::GetRangeReq<true>(begin, end, limits), snapshot)
+		             : RYWImpl::readRangeWithoutWrites(this, RYWImpl::GetRangeReq<false>(begin, end, limits), snapshot);
+	} else {
+		result = reverse
+		             ? RYWImpl::readWithConflictRange(this, RYWImpl::GetRangeReq<true>(begin, end, limits), snapshot)
+		             : RYWImpl::readWithConflictRange(this, RYWImpl::GetRangeReq<false>(begin, end, limits), snapshot);
+	}
 
 	reading.add(success(result));
 	return result;
@@ -1754,6 +1827,7 @@ Future<MappedRangeResult> ReadYourWritesTransaction::getMappedRange(KeySelector
 		return MappedRangeResult();
 	}
 
+	startEarlyConflictDetection();
 	Future<MappedRangeResult> result =
 	    reverse ? RYWImpl::readWithConflictRangeForGetMappedRange(
 	                  this, RYWImpl::GetMappedRangeReq<true>(begin, end, mapper, matchIndex, limits), snapshot)
@@ -2176,6 +2250,20 @@ void ReadYourWritesTransaction::atomicOp(const KeyRef& key, const ValueRef& oper
 			operationType = MutationRef::AndV2;
 	}
 
+	if (operationType == MutationRef::AppendVersionstamped) {
+		// The key is only made at commit, so the append goes to the native transaction as is. Earlier writes to the
+		// keys it could set are sent ahead of it, and reading those keys is not allowed.
+		if (!options.readYourWritesDisabled) {
+			KeyRangeRef range =
+			    getAppendKeyRange(arena, key, tr.getCachedReadVersion().orDefault(0), getMaxReadKey());
+			writeRangeToNativeTransaction(range);
+			writes.addUnmodifiedAndUnreadableRange(range);
+		}
+		approximateSize += key.expectedSize() + APPEND_VERSIONSTAMP_SUFFIX_SIZE + operand.expectedSize() +
+		                   sizeof(MutationRef) + sizeof(KeyRangeRef);
+		return tr.atomicOp(key, operand, MutationRef::AppendVersionstamped, AddConflictRange::False);
+	}
+
 	KeyRef k;
 	if (!tr.apiVersionAtLeast(520) && operationType == MutationRef::SetVersionstampedKey) {
 		k = key.withSuffix("\x00\x00"_sr, arena);
@@ -2436,6 +2524,9 @@ Future<Void> ReadYourWritesTransaction::commit() {
 	if (resetPromise.isSet())
 		return resetPromise.getFuture().getError();
 
+	if (deferredError.code() != invalid_error_code)
+		return deferredError;
+
 	return RYWImpl::commit(this);
 }
 
@@ -2503,6 +2594,11 @@ void ReadYourWritesTransaction::setOptionImpl(FDBTransactionOptions::Option opti
 		options.maxRetries = (int)extractIntOption(value, -1, std::numeric_limits<int>::max());
 		break;
 
+	case FDBTransactionOptions::EARLY_CONFLICT_DETECTION:
+		validateOptionValueNotPresent(value);
+		options.earlyConflictDetection = true;
+		break;
+
 	case FDBTransactionOptions::DEBUG_RETRY_LOGGING:
 		options.debugRetryLogging = true;
 		if (!transactionDebugInfo) {
@@ -2560,6 +2656,9 @@ void ReadYourWritesTransaction::operator=(ReadYourWritesTransaction&& r) noexcep
 	retries = r.retries;
 	approximateSize = r.approximateSize;
 	timeoutActor = r.timeoutActor;
+	// The detector refers to the transaction it was started for, and the next read starts one for this one
+	earlyConflictActor = Future<Void>();
+	r.earlyConflictActor = Future<Void>();
 	creationTime = r.creationTime;
 	commitStarted = r.commitStarted;
 	options = r.options;
@@ -2582,6 +2681,7 @@ ReadYourWritesTransaction::ReadYourWritesTransaction(ReadYourWritesTransaction&&
     options(r.options) {
 	cache.arena = &arena;
 	writes.arena = &arena;
+	r.earlyConflictActor = Future<Void>();
 	tr = std::move(r.tr);
 	readConflicts = std::move(r.readConflicts);
 	watchMap = std::move(r.watchMap);
@@ -2624,6 +2724,7 @@ void ReadYourWritesTransaction::resetRyow() {
 	resetPromise = Promise<Void>();
 
 	timeoutActor.cancel();
+	earlyConflictActor = Future<Void>();
 	arena = Arena();
 	cache = SnapshotCache(&arena);
 	writes = WriteMap(&arena);
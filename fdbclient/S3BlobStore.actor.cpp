@@ -102,6 +102,7 @@ S3BlobStoreEndpoint::BlobKnobs::BlobKnobs() {
 	max_recv_bytes_per_second = CLIENT_KNOBS->BLOBSTORE_MAX_RECV_BYTES_PER_SECOND;
 	sdk_auth = false;
 	global_connection_pool = CLIENT_KNOBS->BLOBSTORE_GLOBAL_CONNECTION_POOL;
+	part_upload_seconds = CLIENT_KNOBS->BLOBSTORE_MULTIPART_PART_UPLOAD_SECONDS;
 }
 
 bool S3BlobStoreEndpoint::BlobKnobs::set(StringRef name, int value) {
@@ -141,6 +142,7 @@ bool S3BlobStoreEndpoint::BlobKnobs::set(StringRef name, int value) {
 	TRY_PARAM(max_recv_bytes_per_second, rbps);
 	TRY_PARAM(sdk_auth, sa);
 	TRY_PARAM(global_connection_pool, gcp);
+	TRY_PARAM(part_upload_seconds, pus);
 #undef TRY_PARAM
 	return false;
 }
@@ -180,6 +182,7 @@ std::string S3BlobStoreEndpoint::BlobKnobs::getURLParameters() const {
 	_CHECK_PARAM(max_recv_bytes_per_second, rbps);
 	_CHECK_PARAM(sdk_auth, sa);
 	_CHECK_PARAM(global_connection_pool, gcp);
+	_CHECK_PARAM(part_upload_seconds, pus);
 #undef _CHECK_PARAM
 	return r;
 }
@@ -279,6 +279,20 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p99":0.0,
                      "p99.9":0.0
                   },
+                  "commit_stage_latency_statistics":{
+                     "$map":{
+                        "count":0,
+                        "min":0.0,
+                        "max":0.0,
+                        "median":0.0,
+                        "mean":0.0,
+                        "p25":0.0,
+                        "p90":0.0,
+                        "p95":0.0,
+                        "p99":0.0,
+                        "p99.9":0.0
+                     }
+                  },
                   "grv_latency_bands":{
                      "$map": 1
                   },
@@ -301,6 +315,13 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "estimated_cost":{
                         "hz": 0.0
                      }
+                  },
+                  "busiest_read_key_prefix":{
+                     "prefix": "",
+                     "fractional_cost": 0.0,
+                     "estimated_cost":{
+                        "hz": 0.0
+                     }
                   }
                }
             ],
@@ -379,6 +400,15 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                  "hz":0.0
                }
             },
+            "busiest_actors":[
+               {
+                  "name":"storageServerCore",
+                  "busy":0.1,
+                  "wakeups_hz":0.0,
+                  "instances":1,
+                  "frame_bytes":1024
+               }
+            ],
             "run_loop_busy":0.2
          }
       },
@@ -629,6 +659,15 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
          "required_logs":3,
          "missing_logs":"7f8d623d0cb9966e",
          "active_generations":1,
+         "last_recovery_phase_seconds":{
+            "reading_coordinated_state":0.5,
+            "locking_coordinated_state":0.5,
+            "reading_transaction_system_state":0.5,
+            "recruiting_transaction_servers":0.5,
+            "initializing_transaction_servers":0.5,
+            "recovery_transaction":0.5,
+            "writing_coordinated_state":0.5
+         },
          "description":"Recovery complete."
       },
       "workload":{
@@ -908,6 +947,11 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                 "primary":true,
                 "in_flight_bytes":0,
                 "unhealthy_servers":0,
+                "team_building":{
+                    "builds":0,
+                    "last_seconds":0.0,
+                    "max_seconds":0.0
+                },
                 "state":{
                     "healthy":true,
                     "min_replicas_remaining":0,
@@ -72,20 +72,32 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR,      double(TLOG_MESSAGE_BLOCK_BYTES) / (TLOG_MESSAGE_BLOCK_BYTES - MAX_MESSAGE_SIZE) ); //1.0121466709838096006362758832473
 	init( PEEK_TRACKER_EXPIRATION_TIME,                          600 ); if( randomize && BUGGIFY ) PEEK_TRACKER_EXPIRATION_TIME = 120; // Cannot be buggified lower without changing the following assert in LogSystemPeekCursor.actor.cpp: ASSERT_WE_THINK(e.code() == error_code_operation_obsolete || SERVER_KNOBS->PEEK_TRACKER_EXPIRATION_TIME < 10);
 	init( PEEK_USING_STREAMING,                                false ); if( randomize && isSimulated && BUGGIFY ) PEEK_USING_STREAMING = true;
+	init( LOG_ROUTER_PEEK_USING_STREAMING,                     false ); if( randomize && isSimulated && BUGGIFY ) LOG_ROUTER_PEEK_USING_STREAMING = true;
 	init( PARALLEL_GET_MORE_REQUESTS,                             32 ); if( randomize && BUGGIFY ) PARALLEL_GET_MORE_REQUESTS = 2;
 	init( MULTI_CURSOR_PRE_FETCH_LIMIT,                           10 );
+	init( TLOG_PUSH_COMPRESSION_FILTER,                       "NONE" ); if( randomize && BUGGIFY ) TLOG_PUSH_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( TLOG_PUSH_COMPRESSION_MIN_BYTES,                      4096 ); if( randomize && BUGGIFY ) TLOG_PUSH_COMPRESSION_MIN_BYTES = 0;
 	init( MAX_QUEUE_COMMIT_BYTES,                               15e6 ); if( randomize && BUGGIFY ) MAX_QUEUE_COMMIT_BYTES = 5000;
+	init( TLOG_GROUP_COMMIT_MAX_LINGER,                          0.0 ); if( randomize && BUGGIFY ) TLOG_GROUP_COMMIT_MAX_LINGER = deterministicRandom()->random01() * 0.002;
 	init( DESIRED_OUTSTANDING_MESSAGES,                         5000 ); if( randomize && BUGGIFY ) DESIRED_OUTSTANDING_MESSAGES = deterministicRandom()->randomInt(0,100);
 	init( DESIRED_GET_MORE_DELAY,                              0.005 );
 	init( CONCURRENT_LOG_ROUTER_READS,                             5 ); if( randomize && BUGGIFY ) CONCURRENT_LOG_ROUTER_READS = 1;
 	init( LOG_ROUTER_PEEK_FROM_SATELLITES_PREFERRED,               1 ); if( randomize && BUGGIFY ) LOG_ROUTER_PEEK_FROM_SATELLITES_PREFERRED = 0;
+	init( LOG_ROUTER_PEEK_USE_MEASURED_LATENCY,                false ); if( randomize && BUGGIFY ) LOG_ROUTER_PEEK_USE_MEASURED_LATENCY = true;
+	init( LOG_ROUTER_PEEK_SWITCH_LATENCY_RATIO,                  0.5 ); if( randomize && BUGGIFY ) LOG_ROUTER_PEEK_SWITCH_LATENCY_RATIO = deterministicRandom()->random01();
+	init( LOG_ROUTER_PEEK_OUTSTANDING_REPLY_COST,              0.001 );
+	init( LOG_ROUTER_PEEK_FAILED_CONNECT_COST,                   1.0 );
+	init( LOG_ROUTER_PEEK_FAILOVER_TIME,                         1.0 ); if( randomize && BUGGIFY ) LOG_ROUTER_PEEK_FAILOVER_TIME = 0.1;
 	init( DISK_QUEUE_ADAPTER_MIN_SWITCH_TIME,                    1.0 );
 	init( DISK_QUEUE_ADAPTER_MAX_SWITCH_TIME,                    5.0 );
 	init( TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES,            2e9 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES = 2e6;
 	init( TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK,           100 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK = 1;
 	init( TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH,           16<<10 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH = 500;
+	init( TLOG_SPILLED_READ_CACHE_BYTES,                     16<<20 ); if ( randomize && BUGGIFY ) TLOG_SPILLED_READ_CACHE_BYTES = deterministicRandom()->coinflip() ? 0 : 20000;
+	init( TLOG_SPILLED_READ_MAX_BATCH_BYTES,                  1<<20 ); if ( randomize && BUGGIFY ) TLOG_SPILLED_READ_MAX_BATCH_BYTES = 0;
 	init( DISK_QUEUE_FILE_EXTENSION_BYTES,                    10<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_FILE_SHRINK_BYTES,                      100<<20 ); // BUGGIFYd per file within the DiskQueue
+	init( DISK_QUEUE_FILE_PREALLOCATE_BYTES,                       0 ); if ( randomize && BUGGIFY ) DISK_QUEUE_FILE_PREALLOCATE_BYTES = deterministicRandom()->randomInt(1, 10) << 20;
 	init( DISK_QUEUE_MAX_TRUNCATE_BYTES,                     2LL<<30 ); if ( randomize && BUGGIFY ) DISK_QUEUE_MAX_TRUNCATE_BYTES = 0;
 	init( TLOG_DEGRADED_DURATION,                                5.0 );
 	init( MAX_CACHE_VERSIONS,                                   10e6 );
@@ -140,6 +152,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( DD_QUEUE_COUNTER_SUMMARIZE,                           true );
 	init( RELOCATION_PARALLELISM_PER_SOURCE_SERVER,                2 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_SOURCE_SERVER = 1;
 	init( RELOCATION_PARALLELISM_PER_DEST_SERVER,                 10 ); if( randomize && BUGGIFY ) RELOCATION_PARALLELISM_PER_DEST_SERVER = 1; // Note: if this is smaller than FETCH_KEYS_PARALLELISM, this will artificially reduce performance. The current default of 10 is probably too high but is set conservatively for now.
+	init( RELOCATION_INFLIGHT_BYTES_PER_DEST_SERVER,                0 ); if( randomize && BUGGIFY ) RELOCATION_INFLIGHT_BYTES_PER_DEST_SERVER = deterministicRandom()->randomInt(1, 100) * 1e6; // 0 disables the budget
+	init( DD_REBALANCE_MAX_BYTES_PER_SECOND,                       0 ); if( randomize && BUGGIFY ) DD_REBALANCE_MAX_BYTES_PER_SECOND = deterministicRandom()->randomInt(1, 100) * 1e6; // 0 is unlimited
 	init( DD_QUEUE_MAX_KEY_SERVERS,                              100 ); // Do not buggify
 	init( DD_REBALANCE_PARALLELISM,                               50 );
 	init( DD_REBALANCE_RESET_AMOUNT,                              30 );
@@ -193,6 +207,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 		The bytesRead/byteSize radio. Will be declared as read hot when larger than this. 8.0 was chosen to avoid reporting table scan as read hot.
 	*/
 	init ( SHARD_READ_HOT_BANDWIDTH_MIN_PER_KSECONDS,      1666667 * 1000);
+	init( DD_CACHE_READ_HOT_RANGES,                            false );
+	init( DD_CACHE_READ_HOT_MAX_BYTES,                     100000000 ); if( randomize && BUGGIFY ) DD_CACHE_READ_HOT_MAX_BYTES = 1000000;
+	init( DD_CACHE_READ_HOT_RANGE_TTL,                         300.0 ); if( randomize && BUGGIFY ) DD_CACHE_READ_HOT_RANGE_TTL = 10.0;
 	/*
 		The read bandwidth of a given shard needs to be larger than this value in order to be evaluated if it's read hot. The roughly 1.67MB per second is calculated as following:
 			- Heuristic data suggests that each storage process can do max 500K read operations per second
@@ -240,6 +257,13 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 		If this value is too small relative to SHARD_MIN_BYTES_PER_KSEC immediate merging work will be generated.
 		*/
+	init( DD_WRITE_HOT_SHARD_DETECTION,                        false ); if( randomize && BUGGIFY ) DD_WRITE_HOT_SHARD_DETECTION = true;
+	init( DD_WRITE_HOT_SHARD_REACTION_TIME,                      1.0 ); if( randomize && BUGGIFY ) DD_WRITE_HOT_SHARD_REACTION_TIME = deterministicRandom()->coinflip() ? 0.25 : 5.0;
+	/*
+		With DD_WRITE_HOT_SHARD_DETECTION, storage servers also report the write bandwidth of the last DD_WRITE_HOT_SHARD_REACTION_TIME seconds
+		to data distribution, so a burst of writes that would take most of STORAGE_METRICS_AVERAGE_INTERVAL to push the average over
+		SHARD_MAX_BYTES_PER_KSEC splits the shard within about this long. A shorter time reacts faster to a noisier estimate.
+		*/
 
 	init( STORAGE_METRIC_TIMEOUT,         isSimulated ? 60.0 : 600.0 ); if( randomize && BUGGIFY ) STORAGE_METRIC_TIMEOUT = deterministicRandom()->coinflip() ? 10.0 : 30.0;
 	init( METRIC_DELAY,                                          0.1 ); if( randomize && BUGGIFY ) METRIC_DELAY = 1.0;
@@ -256,6 +280,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BEST_TEAM_MAX_TEAM_TRIES,                               10 );
 	init( BEST_TEAM_OPTION_COUNT,                                  4 );
 	init( BEST_OF_AMT,                                             4 );
+	init( DD_LOAD_AWARE_TEAM_SELECTION,                        false ); if( randomize && BUGGIFY ) DD_LOAD_AWARE_TEAM_SELECTION = true;
+	init( DD_LOAD_PRESSURE_WEIGHT,                               1.0 ); if( randomize && BUGGIFY ) DD_LOAD_PRESSURE_WEIGHT = deterministicRandom()->random01() * 4;
+	init( DD_STORAGE_READ_BANDWIDTH_CAPACITY_PER_KSEC,   10e6 * 1000 ); // About the most a storage server can read, see SHARD_READ_HOT_BANDWIDTH_MIN_PER_KSECONDS
 	init( SERVER_LIST_DELAY,                                     1.0 );
 	init( RECRUITMENT_IDLE_DELAY,                                1.0 );
 	init( STORAGE_RECRUITMENT_DELAY,                            10.0 );
@@ -277,6 +304,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( DD_MOVE_KEYS_PARALLELISM,                               15 ); if( randomize && BUGGIFY ) DD_MOVE_KEYS_PARALLELISM = 1;
 	init( DD_FETCH_SOURCE_PARALLELISM,                          1000 ); if( randomize && BUGGIFY ) DD_FETCH_SOURCE_PARALLELISM = 1;
 	init( DD_MERGE_LIMIT,                                       2000 ); if( randomize && BUGGIFY ) DD_MERGE_LIMIT = 2;
+	init( DD_AGGRESSIVE_MERGE_SHARD_COUNT,                    100000 ); if( randomize && BUGGIFY ) DD_AGGRESSIVE_MERGE_SHARD_COUNT = deterministicRandom()->randomInt(1, 100);
+	init( DD_AGGRESSIVE_MERGE_MAX_SHARD_RATIO,                   0.5 ); if( randomize && BUGGIFY ) DD_AGGRESSIVE_MERGE_MAX_SHARD_RATIO = deterministicRandom()->random01();
+	init( DD_AGGRESSIVE_MERGES_PER_SECOND,                       1.0 ); if( randomize && BUGGIFY ) DD_AGGRESSIVE_MERGES_PER_SECOND = 0.1;
 	init( DD_SHARD_METRICS_TIMEOUT,                             60.0 ); if( randomize && BUGGIFY ) DD_SHARD_METRICS_TIMEOUT = 0.1;
 	init( DD_LOCATION_CACHE_SIZE,                            2000000 ); if( randomize && BUGGIFY ) DD_LOCATION_CACHE_SIZE = 3;
 	init( MOVEKEYS_LOCK_POLLING_DELAY,                           5.0 );
@@ -302,6 +332,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( DD_STORAGE_WIGGLE_STUCK_THRESHOLD,                      20 );
 	init( DD_STORAGE_WIGGLE_MIN_SS_AGE_SEC,   isSimulated ? 2 : 21 * 60 * 60 * 24 ); if(randomize && BUGGIFY) DD_STORAGE_WIGGLE_MIN_SS_AGE_SEC = isSimulated ? 0: 120;
 	init( DD_TENANT_AWARENESS_ENABLED,                         false );
+	init( DD_TENANT_COLOCATION_MAX_BYTES,                          0 ); if( randomize && BUGGIFY ) DD_TENANT_COLOCATION_MAX_BYTES = deterministicRandom()->randomInt64(1, 10e6);
 	init( STORAGE_QUOTA_ENABLED,                               false ); if(isSimulated) STORAGE_QUOTA_ENABLED = deterministicRandom()->coinflip();
 	init( TENANT_CACHE_LIST_REFRESH_INTERVAL,                      2 ); if( randomize && BUGGIFY ) TENANT_CACHE_LIST_REFRESH_INTERVAL = deterministicRandom()->randomInt(1, 10);
 	init( TENANT_CACHE_STORAGE_USAGE_REFRESH_INTERVAL,             2 ); if( randomize && BUGGIFY ) TENANT_CACHE_STORAGE_USAGE_REFRESH_INTERVAL = deterministicRandom()->randomInt(1, 10);
@@ -309,6 +340,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TENANT_CACHE_STORAGE_USAGE_TRACE_INTERVAL,             300 );
 	init( CP_FETCH_TENANTS_OVER_STORAGE_QUOTA_INTERVAL,            5 ); if( randomize && BUGGIFY ) CP_FETCH_TENANTS_OVER_STORAGE_QUOTA_INTERVAL = deterministicRandom()->randomInt(1, 10);
 	init( DD_BUILD_EXTRA_TEAMS_OVERRIDE,                          10 ); if( randomize && BUGGIFY ) DD_BUILD_EXTRA_TEAMS_OVERRIDE = 2;
+	init( DD_INCREMENTAL_TEAM_BUILDING,                        false ); if( randomize && BUGGIFY ) DD_INCREMENTAL_TEAM_BUILDING = true;
 
 	// TeamRemover
 	init( TR_FLAG_DISABLE_MACHINE_TEAM_REMOVER,                false ); if( randomize && BUGGIFY ) TR_FLAG_DISABLE_MACHINE_TEAM_REMOVER = deterministicRandom()->random01() < 0.1 ? true : false; // false by default. disable the consistency check when it's true
@@ -335,6 +367,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SQLITE_CHUNK_SIZE_PAGES,                             25600 );  // 100MB
 	init( SQLITE_CHUNK_SIZE_PAGES_SIM,                          1024 );  // 4MB
 	init( SQLITE_READER_THREADS,                                  64 );  // number of read threads
+	init( SQLITE_READER_CACHE_PAGES,                               0 ); if( randomize && BUGGIFY ) SQLITE_READER_CACHE_PAGES = deterministicRandom()->randomInt(10, 100);
 	init( SQLITE_WRITE_WINDOW_SECONDS,                            -1 );
 	init( SQLITE_CURSOR_MAX_LIFETIME_BYTES,                      1e6 ); if (buggifySmallShards || simulationMediumShards) SQLITE_CURSOR_MAX_LIFETIME_BYTES = MIN_SHARD_BYTES; if( randomize && BUGGIFY ) SQLITE_CURSOR_MAX_LIFETIME_BYTES = 0;
 	init( SQLITE_WRITE_WINDOW_LIMIT,                              -1 );
@@ -426,6 +459,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_READ_RANGE_REUSE_ITERATORS,                   true ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_ITERATORS = deterministicRandom()->coinflip();
 	init( ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS,          false ); if( randomize && BUGGIFY ) ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS = deterministicRandom()->coinflip();
 	init( ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT,        200 );
+	// Values below 2 send each point read to the reader threads on its own.
+	init( ROCKSDB_MULTIGET_MAX_KEYS,                               0 ); if( randomize && BUGGIFY ) ROCKSDB_MULTIGET_MAX_KEYS = deterministicRandom()->randomInt(2, 64);
+	init( ROCKSDB_MULTIGET_ASYNC_IO,                           false );
 	// Set to 0 to disable rocksdb write rate limiting. Rate limiter unit: bytes per second.
 	init( ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC,                0 );
 	// If true, enables dynamic adjustment of ROCKSDB_WRITE_RATE_LIMITER_BYTES according to the recent demand of background IO.
@@ -471,6 +507,15 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( ROCKSDB_MAX_BACKGROUND_JOBS,                             2 ); // RocksDB default.
 	init( ROCKSDB_DELETE_OBSOLETE_FILE_PERIOD,                 21600 ); // 6h, RocksDB default.
 	init( ROCKSDB_PHYSICAL_SHARD_CLEAN_UP_DELAY, isSimulated ? 10.0 : 300.0 ); // Delays shard clean up, must be larger than ROCKSDB_READ_VALUE_TIMEOUT to prevent reading deleted shard.
+	init( ROCKSDB_WRITE_BUFFER_MANAGER_CHARGE_CACHE,           false ); if( randomize && BUGGIFY ) ROCKSDB_WRITE_BUFFER_MANAGER_CHARGE_CACHE = true;
+	init( ROCKSDB_MEMTABLE_GOVERNOR_INTERVAL,                    5.0 ); if( randomize && BUGGIFY ) ROCKSDB_MEMTABLE_GOVERNOR_INTERVAL = deterministicRandom()->random01() < 0.5 ? 0.0 : 0.5;
+	init( ROCKSDB_MEMTABLE_GOVERNOR_TARGET_RATIO,               0.75 ); if( randomize && BUGGIFY ) ROCKSDB_MEMTABLE_GOVERNOR_TARGET_RATIO = 0.01;
+	init( ROCKSDB_SHARD_MEMTABLE_SOFT_QUOTA,                       0 ); if( randomize && BUGGIFY ) ROCKSDB_SHARD_MEMTABLE_SOFT_QUOTA = 1 << 20;
+	init( ROCKSDB_DELETE_FILES_ON_SHARD_CLEAR,                 false ); if( randomize && BUGGIFY ) ROCKSDB_DELETE_FILES_ON_SHARD_CLEAR = true;
+	init( ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER,                0 ); if( randomize && BUGGIFY ) ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER = deterministicRandom()->randomInt(1, 100);
+	init( ROCKSDB_RANGE_DELETES_COMPACTION_INTERVAL,            10.0 ); if( randomize && BUGGIFY ) ROCKSDB_RANGE_DELETES_COMPACTION_INTERVAL = 1.0;
+	// Entries "prefix,compression,blockBytes,bloomBitsPerKey[,dictBytes]" separated by ';', see parseShardCFPolicies()
+	init( ROCKSDB_SHARD_CF_POLICIES,                              "" ); if( randomize && BUGGIFY ) ROCKSDB_SHARD_CF_POLICIES = ",lz4,4096,10;\\xff,none,1024,0";
 
 	// Leader election
 	bool longLeaderElection = randomize && BUGGIFY;
@@ -491,6 +536,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( START_TRANSACTION_BATCH_QUEUE_CHECK_INTERVAL,        0.001 );
 	init( START_TRANSACTION_MAX_TRANSACTIONS_TO_START,        100000 );
 	init( START_TRANSACTION_MAX_REQUESTS_TO_START,             10000 );
+	init( START_TRANSACTION_MAX_READ_VERSION_STALENESS,         0.05 ); if( randomize && BUGGIFY ) START_TRANSACTION_MAX_READ_VERSION_STALENESS = deterministicRandom()->coinflip() ? 0.0 : 1.0;
 	init( START_TRANSACTION_RATE_WINDOW,                         2.0 );
 	init( START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET,             10.0 );
 	init( START_TRANSACTION_MAX_QUEUE_SIZE,                      1e6 );
@@ -503,6 +549,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,                0.020 );
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION,     0.1 );
 	init( COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA,       0.1 );
+	init( COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY,               0.0 ); if( randomize && BUGGIFY ) COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY = deterministicRandom()->random01() * 0.1;
+	init( COMMIT_BATCH_INTERVAL_CONTROL_WINDOW,                   1.0 );
+	init( COMMIT_BATCH_INTERVAL_CONTROL_MIN_SAMPLES,               20 );
 	init( COMMIT_TRANSACTION_BATCH_COUNT_MAX,                   32768 ); if( randomize && BUGGIFY ) COMMIT_TRANSACTION_BATCH_COUNT_MAX = 1000; // Do NOT increase this number beyond 32768, as CommitIds only budget 2 bytes for storing transaction id within each batch
 	init( COMMIT_BATCHES_MEM_BYTES_HARD_LIMIT,              8LL << 30 ); if (randomize && BUGGIFY) COMMIT_BATCHES_MEM_BYTES_HARD_LIMIT = deterministicRandom()->randomInt64(100LL << 20,  8LL << 30);
 	init( COMMIT_BATCHES_MEM_FRACTION_OF_TOTAL,                   0.5 );
@@ -538,6 +587,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 	bool buggfyUseResolverPrivateMutations = randomize && BUGGIFY && !ENABLE_VERSION_VECTOR_TLOG_UNICAST;
 	init( PROXY_USE_RESOLVER_PRIVATE_MUTATIONS,                 false ); if( buggfyUseResolverPrivateMutations ) PROXY_USE_RESOLVER_PRIVATE_MUTATIONS = deterministicRandom()->coinflip();
+	init( PROXY_REUSE_MUTATION_ENCRYPT_CIPHERS,                  true ); if( randomize && BUGGIFY ) PROXY_REUSE_MUTATION_ENCRYPT_CIPHERS = false;
+	init( PROXY_KEY_INFO_INDEX_REBUILD_INTERVAL,                 1.0 ); if( randomize && BUGGIFY ) PROXY_KEY_INFO_INDEX_REBUILD_INTERVAL = deterministicRandom()->coinflip() ? 0.0 : 0.01;
+	init( PROXY_KEY_INFO_INDEX_REBUILD_BATCH,                  10000 ); if( randomize && BUGGIFY ) PROXY_KEY_INFO_INDEX_REBUILD_BATCH = 10;
+	init( PROXY_KEY_INFO_INDEX_MAX_CHANGED_RANGES,                64 ); if( randomize && BUGGIFY ) PROXY_KEY_INFO_INDEX_MAX_CHANGED_RANGES = 1;
 
 	init( RESET_MASTER_BATCHES,                                   200 );
 	init( RESET_RESOLVER_BATCHES,                                 200 );
@@ -556,6 +609,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( KEY_BYTES_PER_SAMPLE,                                  2e4 ); if( fastBalancing ) KEY_BYTES_PER_SAMPLE = 1e3;
 	init( MIN_BALANCE_TIME,                                      0.2 );
 	init( MIN_BALANCE_DIFFERENCE,                                1e6 ); if( fastBalancing ) MIN_BALANCE_DIFFERENCE = 1e4;
+	init( RESOLUTION_BALANCE_MOVE_FRACTION,                      0.5 ); if( randomize && BUGGIFY ) RESOLUTION_BALANCE_MOVE_FRACTION = deterministicRandom()->random01() * 0.9 + 0.1;
 	init( SECONDS_BEFORE_NO_FAILURE_DELAY,                  8 * 3600 );
 	init( MAX_TXS_SEND_MEMORY,                                   1e7 ); if( randomize && BUGGIFY ) MAX_TXS_SEND_MEMORY = 1e5;
 	init( MAX_RECOVERY_VERSIONS,           200 * VERSIONS_PER_SECOND );
@@ -571,12 +625,18 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SAMPLE_EXPIRATION_TIME,                                1.0 );
 	init( SAMPLE_POLL_TIME,                                      0.1 );
 	init( RESOLVER_STATE_MEMORY_LIMIT,                           1e6 );
+	init( CONFLICT_SET_WORKER_THREADS,                             0 ); if( randomize && BUGGIFY ) CONFLICT_SET_WORKER_THREADS = deterministicRandom()->randomInt(1, 4);
+	init( CONFLICT_SET_PARALLEL_MIN_RANGES,                     1000 ); if( randomize && BUGGIFY ) CONFLICT_SET_PARALLEL_MIN_RANGES = deterministicRandom()->randomInt(2, 100);
+	init( RESOLVER_PIPELINE_CONFLICT_BATCHES,                  false ); if( randomize && BUGGIFY ) RESOLVER_PIPELINE_CONFLICT_BATCHES = true;
 	init( LAST_LIMITED_RATIO,                                    2.0 );
 
 	// Backup Worker
 	init( BACKUP_TIMEOUT,                                        0.4 );
 	init( BACKUP_NOOP_POP_DELAY,                                 5.0 );
 	init( BACKUP_FILE_BLOCK_BYTES,                       1024 * 1024 );
+	init( BACKUP_WORKER_GROUPED_LOG_FILES,                     false ); if( randomize && BUGGIFY ) BACKUP_WORKER_GROUPED_LOG_FILES = true;
+	init( BACKUP_WORKER_LOG_COMPRESSION_FILTER,               "NONE" ); if( randomize && BUGGIFY ) BACKUP_WORKER_LOG_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( BACKUP_WORKER_LOG_CHUNK_BYTES,                   64 * 1024 ); if( randomize && BUGGIFY ) BACKUP_WORKER_LOG_CHUNK_BYTES = deterministicRandom()->randomInt(100, 10000);
 	init( BACKUP_LOCK_BYTES,                                     3e9 ); if(randomize && BUGGIFY) BACKUP_LOCK_BYTES = deterministicRandom()->randomInt(1024, 4096) * 256 * 1024;
 	init( BACKUP_UPLOAD_DELAY,                                  10.0 ); if(randomize && BUGGIFY) BACKUP_UPLOAD_DELAY = deterministicRandom()->random01() * 60;
 
@@ -608,6 +668,10 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FORCE_RECOVERY_CHECK_DELAY,                            5.0 );
 	init( RATEKEEPER_FAILURE_TIME,                               1.0 );
 	init( CONSISTENCYSCAN_FAILURE_TIME,                          1.0 );
+	init( CONSISTENCY_SCAN_COMPARE_CHECKSUMS,                   true ); if( randomize && BUGGIFY ) CONSISTENCY_SCAN_COMPARE_CHECKSUMS = false;
+	init( CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER,                 4.0 ); if( randomize && BUGGIFY ) CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER = 1.0;
+	init( CONSISTENCY_SCAN_BUSY_CPU_PERCENT,                    50.0 );
+	init( CONSISTENCY_SCAN_BUSY_STORAGE_QUEUE,                  50e6 );
 	init( BLOB_MANAGER_FAILURE_TIME,                             1.0 );
 	init( BLOB_MIGRATOR_FAILURE_TIME,                            1.0 );
 	init( REPLACE_INTERFACE_DELAY,                              60.0 );
@@ -654,6 +718,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REMOVE_RETRY_DELAY,                                    1.0 );
 	init( MOVE_KEYS_KRM_LIMIT,                                  2000 ); if( randomize && BUGGIFY ) MOVE_KEYS_KRM_LIMIT = 2;
 	init( MOVE_KEYS_KRM_LIMIT_BYTES,                             1e5 ); if( randomize && BUGGIFY ) MOVE_KEYS_KRM_LIMIT_BYTES = 5e4; //This must be sufficiently larger than CLIENT_KNOBS->KEY_SIZE_LIMIT (fdbclient/Knobs.h) to ensure that at least two entries will be returned from an attempt to read a key range map
+	init( START_MOVE_KEYS_BATCH_SIZE,                             10 ); if( randomize && BUGGIFY ) START_MOVE_KEYS_BATCH_SIZE = deterministicRandom()->randomInt(1, 4);
 	init( MOVE_SHARD_KRM_ROW_LIMIT,                            20000 );
  	init( MOVE_SHARD_KRM_BYTE_LIMIT,                             1e6 );
 	init( MAX_SKIP_TAGS,                                           1 ); //The TLogs require tags to be densely packed to be memory efficient, so be careful increasing this knob
@@ -681,6 +746,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( RATEKEEPER_MAX_RATE,                                   1e9 );
 	init( RATEKEEPER_BATCH_MIN_RATE,                             0.0 );
 	init( RATEKEEPER_BATCH_MAX_RATE,                             1e9 );
+	init( RATEKEEPER_BATCH_RESERVED_FRACTION,                    0.0 ); if( randomize && BUGGIFY ) RATEKEEPER_BATCH_RESERVED_FRACTION = 0.2;
+	init( RATEKEEPER_QUEUE_PREDICTION_SECONDS,                   0.0 ); if( randomize && BUGGIFY ) RATEKEEPER_QUEUE_PREDICTION_SECONDS = deterministicRandom()->random01() * 5.0;
+	init( RATEKEEPER_QUEUE_PREDICTION_SECONDS_ROCKSDB,           0.0 ); if( randomize && BUGGIFY ) RATEKEEPER_QUEUE_PREDICTION_SECONDS_ROCKSDB = deterministicRandom()->random01() * 10.0;
 
 	bool smallStorageTarget = randomize && BUGGIFY;
 	init( TARGET_BYTES_PER_STORAGE_SERVER,                    1000e6 ); if( smallStorageTarget ) TARGET_BYTES_PER_STORAGE_SERVER = 3000e3;
@@ -707,6 +775,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TARGET_BYTES_PER_TLOG_BATCH,                        1400e6 ); if( smallTlogTarget ) TARGET_BYTES_PER_TLOG_BATCH = 1400e3;
 	init( SPRING_BYTES_TLOG_BATCH,                             300e6 ); if( smallTlogTarget ) SPRING_BYTES_TLOG_BATCH = 150e3;
 	init( TLOG_SPILL_THRESHOLD,                               1500e6 ); if( smallTlogTarget ) TLOG_SPILL_THRESHOLD = 1500e3; if( randomize && BUGGIFY ) TLOG_SPILL_THRESHOLD = 0;
+	init( TLOG_INCREMENTAL_SPILL_FRACTION,                       0.0 ); if( randomize && BUGGIFY ) TLOG_INCREMENTAL_SPILL_FRACTION = deterministicRandom()->random01();
+	init( TLOG_MAX_RECOVERY_REPLAY_BYTES,                          0 ); if( randomize && BUGGIFY ) TLOG_MAX_RECOVERY_REPLAY_BYTES = deterministicRandom()->randomInt(1, 100) * 1e4;
 	init( REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT,            20e6 ); if( (randomize && BUGGIFY) || smallTlogTarget ) REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT = 1e6;
 	init( TLOG_HARD_LIMIT_BYTES,                              3000e6 ); if( smallTlogTarget ) TLOG_HARD_LIMIT_BYTES = 30e6;
 	init( TLOG_RECOVER_MEMORY_LIMIT, TARGET_BYTES_PER_TLOG + SPRING_BYTES_TLOG );
@@ -760,6 +830,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TAG_THROTTLE_EXPIRED_CLEANUP_INTERVAL,                30.0 ); if(randomize && BUGGIFY) TAG_THROTTLE_EXPIRED_CLEANUP_INTERVAL = 1.0;
 	init( AUTO_TAG_THROTTLING_ENABLED,                          true ); if(randomize && BUGGIFY) AUTO_TAG_THROTTLING_ENABLED = false;
 	init( SS_THROTTLE_TAGS_TRACKED,                                1 ); if(randomize && BUGGIFY) SS_THROTTLE_TAGS_TRACKED = deterministicRandom()->randomInt(1, 10);
+	init( SS_BUSY_KEY_PREFIX_LENGTH,                               8 ); if(randomize && BUGGIFY) SS_BUSY_KEY_PREFIX_LENGTH = deterministicRandom()->randomInt(0, 17);
+	init( SS_BUSY_KEY_PREFIX_SAMPLE_COST,                        1.6e6 ); if(randomize && BUGGIFY) SS_BUSY_KEY_PREFIX_SAMPLE_COST = 1.0;
+	init( SS_BUSY_KEY_PREFIXES_SKETCHED,                          32 ); if(randomize && BUGGIFY) SS_BUSY_KEY_PREFIXES_SKETCHED = deterministicRandom()->randomInt(1, 10);
 	init( GLOBAL_TAG_THROTTLING,                                true ); if(isSimulated) GLOBAL_TAG_THROTTLING = deterministicRandom()->coinflip();
 	init( ENFORCE_TAG_THROTTLING_ON_PROXIES,   GLOBAL_TAG_THROTTLING );
 	init( GLOBAL_TAG_THROTTLING_MIN_RATE,                        1.0 );
@@ -773,6 +846,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( GLOBAL_TAG_THROTTLING_MAX_TAGS_TRACKED,                 10 );
 	init( GLOBAL_TAG_THROTTLING_TAG_EXPIRE_AFTER,              240.0 );
 	init( PROXY_MAX_TAG_THROTTLE_DURATION,          5.0 ); if( randomize && BUGGIFY ) PROXY_MAX_TAG_THROTTLE_DURATION = 0.5;
+	init( PROXY_TAG_TOKEN_BUCKET,                             false ); if( randomize && BUGGIFY ) PROXY_TAG_TOKEN_BUCKET = true;
+	init( PROXY_TAG_TOKEN_BUCKET_BURST_SECONDS,                 0.1 ); if( randomize && BUGGIFY ) PROXY_TAG_TOKEN_BUCKET_BURST_SECONDS = 1.0;
 	init( GLOBAL_TAG_THROTTLING_PROXY_LOGGING_INTERVAL,         60.0 );
 	init( GLOBAL_TAG_THROTTLING_MIN_TPS,                         1.0 );
 
@@ -797,12 +872,16 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_USING_STREAMING,                               false ); if( randomize && isSimulated && BUGGIFY ) FETCH_USING_STREAMING = true; //Determines if fetch keys uses streaming reads
 	init( FETCH_USING_BLOB,                                    false );
 	init( FETCH_BLOCK_BYTES,                                     2e6 );
+	init( FETCH_KEYS_PARALLEL_RANGES,                              1 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLEL_RANGES = deterministicRandom()->randomInt(2, 5);
+	init( FETCH_KEYS_PARALLEL_RANGE_BYTES,                      20e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLEL_RANGE_BYTES = deterministicRandom()->randomInt(1, 10) * 1e4;
 	init( FETCH_KEYS_PARALLELISM_BYTES,                          4e6 ); if( randomize && BUGGIFY ) FETCH_KEYS_PARALLELISM_BYTES = 3e6;
 	init( FETCH_KEYS_PARALLELISM,                                  2 );
 	init( FETCH_KEYS_PARALLELISM_FULL,                             6 );
 	init( FETCH_KEYS_LOWER_PRIORITY,                               0 );
 	init( SERVE_FETCH_CHECKPOINT_PARALLELISM,                      4 );
 	init( SERVE_AUDIT_STORAGE_PARALLELISM,                         1 );
+	init( AUDIT_STORAGE_COMPARE_CHECKSUMS,                      true ); if( randomize && BUGGIFY ) AUDIT_STORAGE_COMPARE_CHECKSUMS = false;
+	init( AUDIT_STORAGE_CHECKSUM_FANOUT,                          16 ); if( randomize && BUGGIFY ) AUDIT_STORAGE_CHECKSUM_FANOUT = deterministicRandom()->randomInt(2, 5);
 	init( BUGGIFY_BLOCK_BYTES,                                 10000 );
 	init( STORAGE_RECOVERY_VERSION_LAG_LIMIT,				2 * MAX_READ_TRANSACTION_LIFE_VERSIONS );
 	init( STORAGE_COMMIT_BYTES,                             10000000 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_BYTES = 2000000;
@@ -816,6 +895,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE,                        1e9 ); if( randomize && BUGGIFY ) MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE = 1e3;
 	init( LONG_BYTE_SAMPLE_RECOVERY_DELAY,                      60.0 );
 	init( BYTE_SAMPLE_LOAD_PARALLELISM,                            8 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_LOAD_PARALLELISM = 1;
+	init( BYTE_SAMPLE_LOAD_CHUNKS,                                64 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_LOAD_CHUNKS = deterministicRandom()->randomInt(1, 16);
 	init( BYTE_SAMPLE_LOAD_DELAY,                                0.0 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_LOAD_DELAY = 0.1;
 	init( BYTE_SAMPLE_START_DELAY,                               1.0 ); if( randomize && BUGGIFY ) BYTE_SAMPLE_START_DELAY = 0.0;
 	init( BEHIND_CHECK_DELAY,                                    2.0 );
@@ -826,12 +906,16 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MIN_TAG_WRITE_PAGES_RATE,                             3200 ); if( randomize && BUGGIFY ) MIN_TAG_WRITE_PAGES_RATE = 0;
 	init( TAG_MEASUREMENT_INTERVAL,                        30.0 ); if( randomize && BUGGIFY ) TAG_MEASUREMENT_INTERVAL = 1.0;
 	init( PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS,                    true ); if( randomize && BUGGIFY ) PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS = false;
+	init( KVS_MEM_SNAPSHOT_SLICE_BYTES,                          1e6 ); if( randomize && BUGGIFY ) KVS_MEM_SNAPSHOT_SLICE_BYTES = deterministicRandom()->randomInt(100, 10000);
 	init( REPORT_DD_METRICS,                                    true );
 	init( DD_METRICS_REPORT_INTERVAL,                           30.0 );
 	init( FETCH_KEYS_TOO_LONG_TIME_CRITERIA,                   300.0 );
 	init( MAX_STORAGE_COMMIT_TIME,                             120.0 ); //The max fsync stall time on the storage server and tlog before marking a disk as failed
 	init( RANGESTREAM_LIMIT_BYTES,                               2e6 ); if( randomize && BUGGIFY ) RANGESTREAM_LIMIT_BYTES = 1;
 	init( CHANGEFEEDSTREAM_LIMIT_BYTES,                          1e6 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_LIMIT_BYTES = 1;
+	init( CHANGEFEEDSTREAM_COALESCE_MIN_BYTES,                     0 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_COALESCE_MIN_BYTES = deterministicRandom()->randomInt(1, 100000);
+	init( CHANGEFEEDSTREAM_COALESCE_MAX_DELAY,                 0.005 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_COALESCE_MAX_DELAY = deterministicRandom()->random01() * 0.1;
+	init( CHANGE_FEED_DISK_READS_CACHE,                        false ); if( randomize && BUGGIFY ) CHANGE_FEED_DISK_READS_CACHE = true;
 	init( BLOBWORKERSTATUSSTREAM_LIMIT_BYTES,                    1e4 ); if( randomize && BUGGIFY ) BLOBWORKERSTATUSSTREAM_LIMIT_BYTES = 1;
 	init( ENABLE_CLEAR_RANGE_EAGER_READS,                       true ); if( randomize && BUGGIFY ) ENABLE_CLEAR_RANGE_EAGER_READS = deterministicRandom()->coinflip();
 	init( CHECKPOINT_TRANSFER_BLOCK_BYTES,                      40e6 );
@@ -840,8 +924,12 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STRICTLY_ENFORCE_BYTE_LIMIT,                          false); if( randomize && BUGGIFY ) STRICTLY_ENFORCE_BYTE_LIMIT = deterministicRandom()->coinflip();
 	init( FRACTION_INDEX_BYTELIMIT_PREFETCH,                      0.2); if( randomize && BUGGIFY ) FRACTION_INDEX_BYTELIMIT_PREFETCH = 0.01 + deterministicRandom()->random01();
 	init( MAX_PARALLEL_QUICK_GET_VALUE,                           10 ); if ( randomize && BUGGIFY ) MAX_PARALLEL_QUICK_GET_VALUE = deterministicRandom()->randomInt(1, 100);
+	init( MAX_PARALLEL_QUICK_GET_VALUE_LIMIT,                   1000 ); if ( randomize && BUGGIFY ) MAX_PARALLEL_QUICK_GET_VALUE_LIMIT = deterministicRandom()->randomInt(1, 100);
 	init( QUICK_GET_KEY_VALUES_LIMIT,                           2000 );
 	init( QUICK_GET_KEY_VALUES_LIMIT_BYTES,                      1e7 );
+	init( RANGE_AGGREGATE_BYTES_LIMIT,                          1e7 ); if( randomize && BUGGIFY ) RANGE_AGGREGATE_BYTES_LIMIT = deterministicRandom()->randomInt(1, 100) * 1e3;
+	init( RANGE_AGGREGATE_READ_BYTES,                           1e5 ); if( randomize && BUGGIFY ) RANGE_AGGREGATE_READ_BYTES = deterministicRandom()->randomInt(1, 10) * 1e2;
+	init( RANGE_CHECKSUM_BYTES_LIMIT,                           1e7 ); if( randomize && BUGGIFY ) RANGE_CHECKSUM_BYTES_LIMIT = deterministicRandom()->randomInt(1, 100) * 1e3;
 	init( STORAGE_FEED_QUERY_HARD_LIMIT,                      100000 );
 	// Read priority definitions in the form of a list of their relative concurrency share weights
 	init( STORAGESERVER_READ_PRIORITIES,           "120,10,20,40,60" );
@@ -852,6 +940,14 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// The enumeration is currently: eager, fetch, low, normal, high
 	init( STORAGESERVER_READTYPE_PRIORITY_MAP,           "0,1,2,3,4" );
 	init( SPLIT_METRICS_MAX_ROWS,                              10000 );
+	init( STORAGE_RANGE_CACHE_BYTES,                            16e6 ); if( randomize && BUGGIFY ) STORAGE_RANGE_CACHE_BYTES = deterministicRandom()->coinflip() ? 0 : 1e5;
+	init( STORAGE_RANGE_CACHE_MAX_ENTRY_BYTES,                   1e6 ); if( randomize && BUGGIFY ) STORAGE_RANGE_CACHE_MAX_ENTRY_BYTES = 1e4;
+	init( STORAGE_COMPRESS_RANGE_REPLY_MIN_BYTES,              16384 ); if( randomize && BUGGIFY ) STORAGE_COMPRESS_RANGE_REPLY_MIN_BYTES = deterministicRandom()->randomInt(0, 1000);
+	init( STORAGE_DEDUPLICATE_VALUE_MIN_BYTES,                    64 ); if( randomize && BUGGIFY ) STORAGE_DEDUPLICATE_VALUE_MIN_BYTES = deterministicRandom()->randomInt(0, 64);
+	init( STORAGE_DEDUPLICATE_VALUES_MAX,                       1000 ); if( randomize && BUGGIFY ) STORAGE_DEDUPLICATE_VALUES_MAX = deterministicRandom()->randomInt(0, 10);
+	init( STORAGE_PINNED_SNAPSHOT_LEASE,                        60.0 ); if( randomize && BUGGIFY ) STORAGE_PINNED_SNAPSHOT_LEASE = deterministicRandom()->random01() * 10;
+	init( STORAGE_MAX_PINNED_SNAPSHOTS,                           10 ); if( randomize && BUGGIFY ) STORAGE_MAX_PINNED_SNAPSHOTS = deterministicRandom()->randomInt(0, 3);
+	init( STORAGE_CLEARED_RANGES,                              10000 ); if( randomize && BUGGIFY ) STORAGE_CLEARED_RANGES = deterministicRandom()->randomInt(0, 10);
 
 	//Wait Failure
 	init( MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS,                 250 ); if( randomize && BUGGIFY ) MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS = 2;
@@ -904,6 +1000,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// Status
 	init( STATUS_MIN_TIME_BETWEEN_REQUESTS,                      0.0 );
 	init( MAX_STATUS_REQUESTS_PER_SECOND,                      256.0 );
+	init( STATUS_CACHE_MAX_AGE,                                  0.0 ); if( randomize && BUGGIFY ) STATUS_CACHE_MAX_AGE = deterministicRandom()->random01();
 	init( CONFIGURATION_ROWS_TO_FETCH,                         20000 );
 	init( DISABLE_DUPLICATE_LOG_WARNING,                       false );
 	init( HISTOGRAM_REPORT_INTERVAL,                           300.0 );
@@ -918,6 +1015,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FASTRESTORE_SAMPLING_PERCENT,                          100 ); if( randomize && BUGGIFY ) { FASTRESTORE_SAMPLING_PERCENT = deterministicRandom()->random01() * 100; }
 	init( FASTRESTORE_NUM_LOADERS,                                 3 ); if( randomize && BUGGIFY ) { FASTRESTORE_NUM_LOADERS = deterministicRandom()->random01() * 10 + 1; }
 	init( FASTRESTORE_NUM_APPLIERS,                                3 ); if( randomize && BUGGIFY ) { FASTRESTORE_NUM_APPLIERS = deterministicRandom()->random01() * 10 + 1; }
+	init( FASTRESTORE_MIN_BYTES_PER_APPLIER,         1024.0 * 1024.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_MIN_BYTES_PER_APPLIER = deterministicRandom()->random01() < 0.5 ? 0 : deterministicRandom()->random01() * 10.0 * 1024.0 * 1024.0; }
 	init( FASTRESTORE_TXN_BATCH_MAX_BYTES,           1024.0 * 1024.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_BATCH_MAX_BYTES = deterministicRandom()->random01() * 1024.0 * 1024.0 + 1.0; }
 	init( FASTRESTORE_VERSIONBATCH_MAX_BYTES, 10.0 * 1024.0 * 1024.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_VERSIONBATCH_MAX_BYTES = deterministicRandom()->random01() < 0.2 ? 50 * 1024 : deterministicRandom()->random01() < 0.4 ? 100 * 1024 * 1024 : deterministicRandom()->random01() * 1000.0 * 1024.0 * 1024.0; } // too small value may increase chance of TooManyFile error
 	init( FASTRESTORE_VB_PARALLELISM,                              5 ); if( randomize && BUGGIFY ) { FASTRESTORE_VB_PARALLELISM = deterministicRandom()->random01() < 0.2 ? 2 : deterministicRandom()->random01() * 10 + 1; }
@@ -964,6 +1062,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_DEFAULT_EXTENT_READ_SIZE,              1024 * 1024 );
 	init( REDWOOD_EXTENT_CONCURRENT_READS,                         4 );
 	init( REDWOOD_KVSTORE_RANGE_PREFETCH,                       true );
+	init( REDWOOD_PREFETCH_MAX_COALESCED_PAGES,                   32 ); if( randomize && BUGGIFY ) { REDWOOD_PREFETCH_MAX_COALESCED_PAGES = deterministicRandom()->randomInt(1, 8); }
 	init( REDWOOD_PAGE_REBUILD_MAX_SLACK,                       0.33 );
 	init( REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION,              0.50 );
 	init( REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES,                    10 );
@@ -971,11 +1070,24 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_LAZY_CLEAR_MAX_PAGES,                          1e6 );
 	init( REDWOOD_REMAP_CLEANUP_WINDOW_BYTES, 4LL * 1024 * 1024 * 1024 );
 	init( REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO,                0.05 );
+	init( REDWOOD_REMAP_CLEANUP_MAX_CONCURRENCY,                   0 ); if( randomize && BUGGIFY ) { REDWOOD_REMAP_CLEANUP_MAX_CONCURRENCY = deterministicRandom()->randomInt(1, 64); }
+	init( REDWOOD_REMAP_CLEANUP_TARGET_READ_LATENCY,           0.005 ); if( randomize && BUGGIFY ) { REDWOOD_REMAP_CLEANUP_TARGET_READ_LATENCY = deterministicRandom()->random01() * 0.01; }
+	init( REDWOOD_REMAP_CLEANUP_MAX_IO_WAITERS,                   32 ); if( randomize && BUGGIFY ) { REDWOOD_REMAP_CLEANUP_MAX_IO_WAITERS = deterministicRandom()->randomInt(0, 64); }
+	init( REDWOOD_REMAP_CLEANUP_THROTTLE_INTERVAL,               0.1 );
 	init( REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES,                  20000 ); if( randomize && BUGGIFY ) { REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES = deterministicRandom()->randomInt(200, 1000); }
 	init( REDWOOD_METRICS_INTERVAL,                              5.0 );
 	init( REDWOOD_HISTOGRAM_INTERVAL,                           30.0 );
+	init( REDWOOD_PAGE_COMPRESSION_FILTER,                    "NONE" ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter()); }
+	init( REDWOOD_COMPRESSED_LEAF_BLOCKS,                          4 ); if( randomize && BUGGIFY ) { REDWOOD_COMPRESSED_LEAF_BLOCKS = deterministicRandom()->randomInt(1, 9); }
 	init( REDWOOD_EVICT_UPDATED_PAGES,                          true ); if( randomize && BUGGIFY ) { REDWOOD_EVICT_UPDATED_PAGES = false; }
+	init( REDWOOD_PAGECACHE_PROTECTED_FRACTION,                  0.8 ); if( randomize && BUGGIFY ) { REDWOOD_PAGECACHE_PROTECTED_FRACTION = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->random01(); }
 	init( REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT,                    2 ); if( randomize && BUGGIFY ) { REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT = deterministicRandom()->randomInt(1, 7); }
+	init( REDWOOD_PAGE_BUILD_THREADS,                             0 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_BUILD_THREADS = deterministicRandom()->randomInt(1, 4); }
+	init( REDWOOD_LEAF_FILTER_CACHE_BYTES,                        0 ); if( randomize && BUGGIFY ) { REDWOOD_LEAF_FILTER_CACHE_BYTES = deterministicRandom()->randomInt(0, 1 << 20); }
+	init( REDWOOD_LEAF_FILTER_BITS_PER_KEY,                      10 ); if( randomize && BUGGIFY ) { REDWOOD_LEAF_FILTER_BITS_PER_KEY = deterministicRandom()->randomInt(1, 20); }
+	init( REDWOOD_SECONDARY_CACHE_BYTES,                          0 ); if( randomize && BUGGIFY ) { REDWOOD_SECONDARY_CACHE_BYTES = deterministicRandom()->randomInt(1, 100) * 64 * 1024; }
+	init( REDWOOD_SECONDARY_CACHE_DIR,                           "" );
+	init( REDWOOD_SECONDARY_CACHE_MAX_WRITES,                    64 ); if( randomize && BUGGIFY ) { REDWOOD_SECONDARY_CACHE_MAX_WRITES = deterministicRandom()->randomInt(1, 10); }
 	init( REDWOOD_IO_PRIORITIES,                       "32,32,32,32" );
 
 	// Server request latency measurement
@@ -1022,6 +1134,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BG_ENABLE_READ_DRIVEN_COMPACTION,                     true ); if (randomize && BUGGIFY) BG_ENABLE_READ_DRIVEN_COMPACTION = false;
 	init( BG_RDC_BYTES_FACTOR,                                     2 ); if (randomize && BUGGIFY) BG_RDC_BYTES_FACTOR = deterministicRandom()->randomInt(1, 10);
 	init( BG_RDC_READ_FACTOR,                                      3 ); if (randomize && BUGGIFY) BG_RDC_READ_FACTOR = deterministicRandom()->randomInt(1, 10);
+	init( BG_COLD_GRANULE_SECONDS,                              60.0 ); if (randomize && BUGGIFY) BG_COLD_GRANULE_SECONDS = deterministicRandom()->randomInt(1, 30);
+	init( BG_COLD_DELTA_FILE_FACTOR,                               2 ); if (randomize && BUGGIFY) BG_COLD_DELTA_FILE_FACTOR = deterministicRandom()->randomInt(1, 10);
 	init( BG_WRITE_MULTIPART,                                  false ); if (randomize && BUGGIFY) BG_WRITE_MULTIPART = true;
 	init( BG_ENABLE_DYNAMIC_WRITE_AMP,                          true ); if (randomize && BUGGIFY) BG_ENABLE_DYNAMIC_WRITE_AMP = false;
 	init( BG_DYNAMIC_WRITE_AMP_MIN_FACTOR,                       0.5 );
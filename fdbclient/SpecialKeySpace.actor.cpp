@@ -393,7 +393,9 @@ ACTOR Future<RangeResult> SpecialKeySpace::getRangeAggregationActor(SpecialKeySp
 				RangeResult pairs_ = wait(ptr->getRange(ryw, KeyRangeRef(keyStart, keyEnd), limits, &cache));
 				pairs = pairs_;
 			} else {
-				RangeResult pairs_ = wait(iter->value()->getRange(ryw, KeyRangeRef(keyStart, keyEnd), limits));
+				// Modules apply limit hints from the beginning of the range, so a reverse read cannot pass them on
+				RangeResult pairs_ =
+				    wait(iter->value()->getRange(ryw, KeyRangeRef(keyStart, keyEnd), GetRangeLimits()));
 				pairs = pairs_;
 			}
 			result.arena().dependsOn(pairs.arena());
@@ -728,12 +730,12 @@ Future<RangeResult> ConflictingKeysImpl::getRange(ReadYourWritesTransaction* ryw
 	return result;
 }
 
-ACTOR Future<RangeResult> ddMetricsGetRangeActor(ReadYourWritesTransaction* ryw, KeyRangeRef kr) {
+ACTOR Future<RangeResult> ddMetricsGetRangeActor(ReadYourWritesTransaction* ryw, KeyRangeRef kr, int shardLimit) {
 	loop {
 		try {
 			auto keys = kr.removePrefix(ddStatsRange.begin);
 			Standalone<VectorRef<DDMetricsRef>> resultWithoutPrefix =
-			    wait(waitDataDistributionMetricsList(ryw->getDatabase(), keys, CLIENT_KNOBS->TOO_MANY));
+			    wait(waitDataDistributionMetricsList(ryw->getDatabase(), keys, shardLimit));
 			RangeResult result;
 			for (const auto& ddMetricsRef : resultWithoutPrefix) {
 				// each begin key is the previous end key, thus we only encode the begin key in the result
@@ -765,7 +767,10 @@ DDStatsRangeImpl::DDStatsRangeImpl(KeyRangeRef kr) : SpecialKeyRangeAsyncImpl(kr
 Future<RangeResult> DDStatsRangeImpl::getRange(ReadYourWritesTransaction* ryw,
                                                KeyRangeRef kr,
                                                GetRangeLimits limitsHint) const {
-	return ddMetricsGetRangeActor(ryw, kr);
+	// Each shard is one row, so a paged listing only asks data distribution for the shards of its page
+	int shardLimit =
+	    limitsHint.hasRowLimit() ? std::min(limitsHint.rows, CLIENT_KNOBS->TOO_MANY) : CLIENT_KNOBS->TOO_MANY;
+	return ddMetricsGetRangeActor(ryw, kr, shardLimit);
 }
 
 Key SpecialKeySpace::getManagementApiCommandOptionSpecialKey(const std::string& command, const std::string& option) {
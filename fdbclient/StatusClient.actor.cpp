@@ -418,8 +418,10 @@ ACTOR Future<StatusObject> clientStatusFetcher(Reference<IClusterConnectionRecor
 }
 
 // Cluster section of json output
-ACTOR Future<Optional<StatusObject>> clusterStatusFetcher(ClusterInterface cI, StatusArray* messages) {
-	state StatusRequest req;
+ACTOR Future<Optional<StatusObject>> clusterStatusFetcher(ClusterInterface cI,
+                                                         StatusArray* messages,
+                                                         std::vector<std::string> sections) {
+	state StatusRequest req(sections);
 	state Future<Void> clusterTimeout = delay(30.0);
 	state Optional<StatusObject> oStatusObj;
 
@@ -506,7 +508,8 @@ StatusObject getClientDatabaseStatus(StatusObjectReader client, StatusObjectRead
 }
 
 ACTOR Future<StatusObject> statusFetcherImpl(Reference<IClusterConnectionRecord> connRecord,
-                                             Reference<AsyncVar<Optional<ClusterInterface>>> clusterInterface) {
+                                             Reference<AsyncVar<Optional<ClusterInterface>>> clusterInterface,
+                                             std::vector<std::string> sections) {
 	if (!g_network)
 		throw network_not_setup();
 
@@ -548,7 +551,7 @@ ACTOR Future<StatusObject> statusFetcherImpl(Reference<IClusterConnectionRecord>
 			loop {
 				if (clusterInterface->get().present()) {
 					Optional<StatusObject> _statusObjCluster =
-					    wait(clusterStatusFetcher(clusterInterface->get().get(), &clientMessages));
+					    wait(clusterStatusFetcher(clusterInterface->get().get(), &clientMessages, sections));
 					if (_statusObjCluster.present()) {
 						statusObjCluster = _statusObjCluster.get();
 						// TODO: this is a temporary fix, getting the number of available coordinators should move to
@@ -596,8 +599,10 @@ ACTOR Future<StatusObject> statusFetcherImpl(Reference<IClusterConnectionRecord>
 	// Put clientMessages into Client section.
 	statusObjClient["messages"] = clientMessages;
 
-	// Create database_status section, place into statusObjClient
-	statusObjClient["database_status"] = getClientDatabaseStatus(statusObjClient, statusObjCluster);
+	// Create database_status section, place into statusObjClient. It can only be judged from the whole cluster status.
+	if (sections.empty()) {
+		statusObjClient["database_status"] = getClientDatabaseStatus(statusObjClient, statusObjCluster);
+	}
 
 	// Put finalized client section into final document.  Cluster section was created above if it was possible.
 	statusObj["client"] = statusObjClient;
@@ -622,12 +627,12 @@ ACTOR Future<Void> timeoutMonitorLeader(Database db) {
 	}
 }
 
-Future<StatusObject> StatusClient::statusFetcher(Database db) {
+Future<StatusObject> StatusClient::statusFetcher(Database db, std::vector<std::string> sections) {
 	db->lastStatusFetch = now();
 	if (!db->statusClusterInterface) {
 		db->statusClusterInterface = makeReference<AsyncVar<Optional<ClusterInterface>>>();
 		db->statusLeaderMon = timeoutMonitorLeader(db);
 	}
 
-	return statusFetcherImpl(db->getConnectionRecord(), db->statusClusterInterface);
+	return statusFetcherImpl(db->getConnectionRecord(), db->statusClusterInterface, sections);
 }
@@ -22,6 +22,8 @@
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbclient/BlobWorkerInterface.h"
 #include "crc32/crc32c.h" // for crc32c_append, to checksum values in tss trace events
+#include "flow/CompressionUtils.h"
+#include "flow/xxhash.h"
 
 // Includes template specializations for all tss operations on storage server types.
 // New StorageServerInterface reply types must be added here or it won't compile.
@@ -43,6 +45,11 @@ const char* TSS_mismatchTraceName(const GetValueRequest& req) {
 	return "TSSMismatchGetValue";
 }
 
+template <>
+double TSS_sampleRate(const GetValueRequest& req) {
+	return CLIENT_KNOBS->TSS_GET_VALUE_SAMPLE_RATE;
+}
+
 template <>
 void TSS_traceMismatch(TraceEvent& event,
                        const GetValueRequest& req,
@@ -102,6 +109,11 @@ const char* TSS_mismatchTraceName(const GetKeyRequest& req) {
 	return "TSSMismatchGetKey";
 }
 
+template <>
+double TSS_sampleRate(const GetKeyRequest& req) {
+	return CLIENT_KNOBS->TSS_GET_KEY_SAMPLE_RATE;
+}
+
 template <>
 void TSS_traceMismatch(TraceEvent& event, const GetKeyRequest& req, const GetKeyReply& src, const GetKeyReply& tss) {
 	event
@@ -118,7 +130,68 @@ void TSS_traceMismatch(TraceEvent& event, const GetKeyRequest& req, const GetKey
 // range reads
 template <>
 bool TSS_doCompare(const GetKeyValuesReply& src, const GetKeyValuesReply& tss) {
-	return src.more == tss.more && src.data == tss.data;
+	if (src.compressedData.present() || tss.compressedData.present()) {
+		GetKeyValuesReply srcRows = src, tssRows = tss;
+		decompressKeyValuesReply(srcRows);
+		decompressKeyValuesReply(tssRows);
+		return TSS_doCompare(srcRows, tssRows);
+	}
+	return src.more == tss.more && src.data == tss.data && src.checksum == tss.checksum;
+}
+
+int64_t compressKeyValuesReply(GetKeyValuesReply& reply, int64_t minBytes) {
+	if (reply.data.empty() || reply.data.expectedSize() < minBytes ||
+	    !CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		return 0;
+	}
+	BinaryWriter wr(Unversioned());
+	wr << (int32_t)reply.data.size();
+	for (auto const& kv : reply.data) {
+		wr << (int32_t)kv.key.size();
+		wr.serializeBytes(kv.key);
+		wr << (int32_t)kv.value.size();
+		wr.serializeBytes(kv.value);
+	}
+	StringRef compressed = CompressionUtils::compress(CompressionFilter::ZSTD, wr.toValue(), reply.arena);
+	if (compressed.size() >= wr.getLength()) {
+		return 0;
+	}
+	reply.compressedData = compressed;
+	reply.data = VectorRef<KeyValueRef, VecSerStrategy::String>();
+	return wr.getLength() - compressed.size();
+}
+
+bool decompressKeyValuesReply(GetKeyValuesReply& reply) {
+	if (!reply.compressedData.present()) {
+		return false;
+	}
+	// The rows point into the decompressed buffer, which lives as long as reply.arena
+	StringRef rows = CompressionUtils::decompress(CompressionFilter::ZSTD, reply.compressedData.get(), reply.arena);
+	ArenaReader rd(reply.arena, rows, Unversioned());
+	int32_t count;
+	rd >> count;
+	reply.data = VectorRef<KeyValueRef, VecSerStrategy::String>();
+	reply.data.reserve(reply.arena, count);
+	for (int i = 0; i < count; i++) {
+		int32_t keySize, valueSize;
+		rd >> keySize;
+		KeyRef key(rd.arenaRead(keySize), keySize);
+		rd >> valueSize;
+		ValueRef value(rd.arenaRead(valueSize), valueSize);
+		reply.data.push_back(reply.arena, KeyValueRef(key, value));
+	}
+	reply.compressedData.reset();
+	return true;
+}
+
+uint64_t keyValuesChecksum(VectorRef<KeyValueRef, VecSerStrategy::String> const& data, uint64_t seed) {
+	// Hashing keys and values separately keeps the boundaries between them in the checksum
+	uint64_t checksum = seed;
+	for (auto const& kv : data) {
+		checksum = XXH3_64bits_withSeed(kv.key.begin(), kv.key.size(), checksum);
+		checksum = XXH3_64bits_withSeed(kv.value.begin(), kv.value.size(), checksum);
+	}
+	return checksum;
 }
 
 template <>
@@ -126,6 +199,11 @@ const char* TSS_mismatchTraceName(const GetKeyValuesRequest& req) {
 	return "TSSMismatchGetKeyValues";
 }
 
+template <>
+double TSS_sampleRate(const GetKeyValuesRequest& req) {
+	return CLIENT_KNOBS->TSS_GET_RANGE_SAMPLE_RATE;
+}
+
 static void traceKeyValuesSummary(TraceEvent& event,
                                   const KeySelectorRef& begin,
                                   const KeySelectorRef& end,
@@ -210,6 +288,11 @@ const char* TSS_mismatchTraceName(const GetMappedKeyValuesRequest& req) {
 	return "TSSMismatchGetMappedKeyValues";
 }
 
+template <>
+double TSS_sampleRate(const GetMappedKeyValuesRequest& req) {
+	return CLIENT_KNOBS->TSS_GET_RANGE_SAMPLE_RATE;
+}
+
 template <>
 void TSS_traceMismatch(TraceEvent& event,
                        const GetMappedKeyValuesRequest& req,
@@ -259,6 +342,34 @@ void TSS_traceMismatch(TraceEvent& event,
 	                   tss.more);
 }
 
+// range aggregates
+template <>
+bool TSS_doCompare(const GetRangeAggregateReply& src, const GetRangeAggregateReply& tss) {
+	return src.aggregate == tss.aggregate && src.readThrough == tss.readThrough;
+}
+
+template <>
+const char* TSS_mismatchTraceName(const GetRangeAggregateRequest& req) {
+	return "TSSMismatchGetRangeAggregate";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetRangeAggregateRequest& req,
+                       const GetRangeAggregateReply& src,
+                       const GetRangeAggregateReply& tss) {
+	event.detail("Begin", req.keys.begin.printable())
+	    .detail("End", req.keys.end.printable())
+	    .detail("Tenant", req.tenantInfo.tenantId)
+	    .detail("Version", req.version)
+	    .detail("SSRows", src.aggregate.rows)
+	    .detail("SSSum", src.aggregate.sum)
+	    .detail("SSReadThrough", src.readThrough.present() ? src.readThrough.get().printable() : "none")
+	    .detail("TSSRows", tss.aggregate.rows)
+	    .detail("TSSSum", tss.aggregate.sum)
+	    .detail("TSSReadThrough", tss.readThrough.present() ? tss.readThrough.get().printable() : "none");
+}
+
 template <>
 bool TSS_doCompare(const WatchValueReply& src, const WatchValueReply& tss) {
 	// We duplicate watches just for load, no need to validate replies.
@@ -450,10 +561,43 @@ void TSSMetrics::recordLatency(const GetKeyValuesStreamRequest& req, double ssLa
 template <>
 void TSSMetrics::recordLatency(const OverlappingChangeFeedsRequest& req, double ssLatency, double tssLatency) {}
 
+template <>
+void TSSMetrics::recordLatency(const GetRangeAggregateRequest& req, double ssLatency, double tssLatency) {}
+
 // this isn't even to storage servers
 template <>
 void TSSMetrics::recordLatency(const BlobGranuleFileRequest& req, double ssLatency, double tssLatency) {}
 
+Optional<int64_t> RangeAggregate::decodeInteger(ValueRef value) {
+	if (value.size() > sizeof(int64_t)) {
+		return Optional<int64_t>();
+	}
+	uint64_t n = 0;
+	for (int i = value.size() - 1; i >= 0; i--) {
+		n = (n << 8) | value[i];
+	}
+	return static_cast<int64_t>(n);
+}
+
+void RangeAggregate::add(ValueRef value) {
+	++rows;
+	Optional<int64_t> n = decodeInteger(value);
+	if (n.present()) {
+		++integers;
+		sum = static_cast<int64_t>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(n.get()));
+		min = std::min(min, n.get());
+		max = std::max(max, n.get());
+	}
+}
+
+void RangeAggregate::add(const RangeAggregate& other) {
+	rows += other.rows;
+	integers += other.integers;
+	sum = static_cast<int64_t>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(other.sum));
+	min = std::min(min, other.min);
+	max = std::max(max, other.max);
+}
+
 // -------------------
 
 TEST_CASE("/StorageServerInterface/TSSCompare/TestComparison") {
@@ -565,3 +709,138 @@ TEST_CASE("/StorageServerInterface/TSSCompare/TestComparison") {
 	ASSERT(checksumStart13 == traceChecksumValue(StringRef(s13)).substr(0, 4));
 	return Void();
 }
+
+TEST_CASE("/StorageServerInterface/KeyValueFilter/matches") {
+	KeyValueFilterRef filter;
+	ASSERT(filter.matches(KeyValueRef("a"_sr, ""_sr)));
+
+	filter.keySuffix = "/name"_sr;
+	ASSERT(filter.matches(KeyValueRef("user/1/name"_sr, "x"_sr)));
+	ASSERT(!filter.matches(KeyValueRef("user/1/email"_sr, "x"_sr)));
+
+	filter.valuePrefix = "ab"_sr;
+	ASSERT(filter.matches(KeyValueRef("user/1/name"_sr, "abc"_sr)));
+	ASSERT(!filter.matches(KeyValueRef("user/1/name"_sr, "a"_sr)));
+
+	filter.minValueSize = 3;
+	filter.maxValueSize = 4;
+	ASSERT(!filter.matches(KeyValueRef("user/1/name"_sr, "ab"_sr)));
+	ASSERT(filter.matches(KeyValueRef("user/1/name"_sr, "abcd"_sr)));
+	ASSERT(!filter.matches(KeyValueRef("user/1/name"_sr, "abcde"_sr)));
+
+	Arena arena;
+	KeyValueFilterRef copy(arena, filter);
+	ASSERT(copy.keySuffix == filter.keySuffix && copy.valuePrefix == filter.valuePrefix);
+	ASSERT(copy.minValueSize == 3 && copy.maxValueSize == 4);
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/keyValuesChecksum") {
+	Arena arena;
+	VectorRef<KeyValueRef, VecSerStrategy::String> a, b;
+	a.push_back(arena, KeyValueRef("ab"_sr, "c"_sr));
+	b.push_back(arena, KeyValueRef("a"_sr, "bc"_sr));
+	ASSERT(keyValuesChecksum(a) != keyValuesChecksum(b));
+
+	b[0] = a[0];
+	ASSERT(keyValuesChecksum(a) == keyValuesChecksum(b));
+	b.push_back(arena, KeyValueRef("d"_sr, ""_sr));
+	ASSERT(keyValuesChecksum(a) != keyValuesChecksum(b));
+
+	// Checksumming in parts
+	VectorRef<KeyValueRef, VecSerStrategy::String> last(b.begin() + 1, 1);
+	ASSERT(keyValuesChecksum(last, keyValuesChecksum(a)) == keyValuesChecksum(b));
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/RangeAggregate/add") {
+	ASSERT(RangeAggregate::decodeInteger(""_sr).get() == 0);
+	ASSERT(RangeAggregate::decodeInteger("\x01\x02"_sr).get() == 0x0201);
+	ASSERT(RangeAggregate::decodeInteger("\xff\xff\xff\xff\xff\xff\xff\xff"_sr).get() == -1);
+	ASSERT(!RangeAggregate::decodeInteger("123456789"_sr).present());
+
+	RangeAggregate a;
+	a.add("\x05"_sr);
+	a.add("\xfe\xff\xff\xff\xff\xff\xff\xff"_sr);
+	a.add("not an integer"_sr);
+	ASSERT(a.rows == 3 && a.integers == 2);
+	ASSERT(a.sum == 3 && a.min == -2 && a.max == 5);
+
+	RangeAggregate b;
+	b.add("\xff\xff\xff\xff\xff\xff\xff\x7f"_sr);
+	b.add("\x02"_sr);
+	ASSERT(b.sum == std::numeric_limits<int64_t>::min() + 1);
+
+	a.add(b);
+	ASSERT(a.rows == 5 && a.integers == 4);
+	ASSERT(a.sum == std::numeric_limits<int64_t>::min() + 4);
+	ASSERT(a.min == -2 && a.max == std::numeric_limits<int64_t>::max());
+
+	RangeAggregate empty;
+	a.add(empty);
+	ASSERT(a.rows == 5 && a.min == -2);
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/GetKeyValuesReplyView/roundTrip") {
+	GetKeyValuesReply reply;
+	int rows = deterministicRandom()->randomInt(0, 100);
+	for (int i = 0; i < rows; i++) {
+		reply.data.push_back_deep(reply.arena,
+		                          KeyValueRef(StringRef(format("key%05d", i)),
+		                                      StringRef(std::string(deterministicRandom()->randomInt(0, 20), 'v'))));
+	}
+	reply.version = 7;
+	reply.more = true;
+	Standalone<StringRef> message = ObjectWriter::toValue(reply, Unversioned());
+
+	// Read from memory the arena owns, as FlowTransport does, and from memory it does not
+	ArenaObjectReader arenaReader(message.arena(), message, Unversioned());
+	GetKeyValuesReplyView view;
+	arenaReader.deserialize(view);
+	ASSERT(view.data.size() == rows && view.version == 7 && view.more);
+	ASSERT(view.data.toVectorRef(view.arena) == reply.data);
+	GetKeyValuesReplyView copied = ObjectReader::fromStringRef<GetKeyValuesReplyView>(message, Unversioned());
+	int i = 0;
+	for (const auto& kv : copied.data) {
+		ASSERT(kv == reply.data[i++]);
+	}
+	ASSERT(i == rows);
+
+	// Forwarding the view sends the same rows
+	GetKeyValuesReply forwarded =
+	    ObjectReader::fromStringRef<GetKeyValuesReply>(ObjectWriter::toValue(view, Unversioned()), Unversioned());
+	ASSERT(forwarded.data == reply.data && forwarded.version == 7 && forwarded.more);
+	return Void();
+}
+
+TEST_CASE("/StorageServerInterface/GetKeyValuesReply/compression") {
+	GetKeyValuesReply reply;
+	int rows = deterministicRandom()->randomInt(1, 200);
+	for (int i = 0; i < rows; i++) {
+		reply.data.push_back_deep(reply.arena,
+		                          KeyValueRef(StringRef(format("key%05d", i)),
+		                                      StringRef(std::string(deterministicRandom()->randomInt(0, 100), 'v'))));
+	}
+	Standalone<VectorRef<KeyValueRef>> original(VectorRef<KeyValueRef>(reply.data.begin(), reply.data.size()),
+	                                            reply.arena);
+
+	ASSERT(compressKeyValuesReply(reply, std::numeric_limits<int64_t>::max()) == 0);
+	ASSERT(!reply.compressedData.present() && reply.data.size() == rows);
+
+	int64_t saved = compressKeyValuesReply(reply, 0);
+	if (!CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		ASSERT(saved == 0 && !decompressKeyValuesReply(reply));
+		return Void();
+	}
+	ASSERT(saved > 0 && reply.compressedData.present() && reply.data.empty());
+
+	GetKeyValuesReply received =
+	    ObjectReader::fromStringRef<GetKeyValuesReply>(ObjectWriter::toValue(reply, Unversioned()), Unversioned());
+	ASSERT(decompressKeyValuesReply(received));
+	ASSERT(!received.compressedData.present() && received.data.size() == rows);
+	for (int i = 0; i < rows; i++) {
+		ASSERT(received.data[i] == original[i]);
+	}
+	return Void();
+}
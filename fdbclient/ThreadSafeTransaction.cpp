@@ -233,6 +233,11 @@ ThreadFuture<Standalone<StringRef>> ThreadSafeDatabase::getClientStatus() {
 	return onMainThread([db] { return Future<Standalone<StringRef>>(db->getClientStatus()); });
 }
 
+ThreadFuture<Standalone<StringRef>> ThreadSafeDatabase::getClientMetrics() {
+	DatabaseContext* db = this->db;
+	return onMainThread([db] { return Future<Standalone<StringRef>>(db->getClientMetrics()); });
+}
+
 ThreadSafeDatabase::~ThreadSafeDatabase() {
 	DatabaseContext* db = this->db;
 	onMainThreadVoid([db]() { db->delref(); });
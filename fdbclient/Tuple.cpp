@@ -38,10 +38,24 @@ static double bigEndianDouble(double orig) {
 	return *(double*)&big;
 }
 
+// Returns the first null byte in [p, end), or nullptr. Nulls are what strings are escaped and terminated with, and
+// memchr() is vectorized by the C library, so the bytes between them are skipped many at a time.
+static const uint8_t* findNull(const uint8_t* p, const uint8_t* end) {
+	return p < end ? (const uint8_t*)memchr(p, 0, end - p) : nullptr;
+}
+
 static size_t findStringTerminator(const StringRef data, size_t offset) {
 	size_t i = offset;
-	while (i < data.size() - 1 && !(data[i] == '\x00' && data[i + 1] != (uint8_t)'\xff')) {
-		i += (data[i] == '\x00' ? 2 : 1);
+	while (i < data.size() - 1) {
+		const uint8_t* null = findNull(data.begin() + i, data.end() - 1);
+		if (!null) {
+			return data.size() - 1;
+		}
+		i = null - data.begin();
+		if (data[i + 1] != (uint8_t)'\xff') {
+			break;
+		}
+		i += 2;
 	}
 
 	return i;
@@ -171,20 +185,25 @@ Tuple& Tuple::append(TupleVersionstamp const& vs) {
 Tuple& Tuple::append(StringRef const& str, bool utf8) {
 	offsets.push_back(data.size());
 
+	// Count the nulls to escape first, so that the encoded string is written without reallocating
+	int nulls = 0;
+	for (const uint8_t* null = findNull(str.begin(), str.end()); null; null = findNull(null + 1, str.end())) {
+		++nulls;
+	}
+	data.reserve(data.arena(), data.size() + str.size() + nulls + 2);
+
 	const uint8_t utfChar = uint8_t(utf8 ? '\x02' : '\x01');
 	data.append(data.arena(), &utfChar, 1);
 
-	size_t lastPos = 0;
-	for (size_t pos = 0; pos < str.size(); ++pos) {
-		if (str[pos] == '\x00') {
-			data.append(data.arena(), str.begin() + lastPos, pos - lastPos);
-			data.push_back(data.arena(), (uint8_t)'\x00');
-			data.push_back(data.arena(), (uint8_t)'\xff');
-			lastPos = pos + 1;
-		}
+	const uint8_t* last = str.begin();
+	for (const uint8_t* null = findNull(last, str.end()); null; null = findNull(last, str.end())) {
+		data.append(data.arena(), last, null - last);
+		data.push_back(data.arena(), (uint8_t)'\x00');
+		data.push_back(data.arena(), (uint8_t)'\xff');
+		last = null + 1;
 	}
 
-	data.append(data.arena(), str.begin() + lastPos, str.size() - lastPos);
+	data.append(data.arena(), last, str.end() - last);
 	data.push_back(data.arena(), (uint8_t)'\x00');
 
 	return *this;
@@ -313,6 +332,13 @@ Tuple::ElementType Tuple::getType(size_t index) const {
 }
 
 Standalone<StringRef> Tuple::getString(size_t index) const {
+	Standalone<StringRef> result;
+	StringRef str = getString(index, result.arena());
+	result.StringRef::operator=(str);
+	return result;
+}
+
+StringRef Tuple::getString(size_t index, Arena& arena) const {
 	if (index >= offsets.size()) {
 		throw invalid_tuple_index();
 	}
@@ -330,27 +356,32 @@ Standalone<StringRef> Tuple::getString(size_t index) const {
 		e = data.size();
 	}
 
-	Standalone<StringRef> result;
-	VectorRef<uint8_t> staging;
-
-	for (size_t i = b; i < e; ++i) {
-		if (data[i] == '\x00') {
-			staging.append(result.arena(), data.begin() + b, i - b);
-			++i;
-			b = i + 1;
-
-			if (i < e) {
-				staging.push_back(result.arena(), '\x00');
-			}
-		}
+	if (b >= e) {
+		return StringRef();
 	}
 
-	if (b < e) {
-		staging.append(result.arena(), data.begin() + b, e - b);
+	// Unescaping only removes bytes, so the encoded size is enough
+	uint8_t* out = new (arena) uint8_t[e - b];
+	uint8_t* o = out;
+	const uint8_t* p = data.begin() + b;
+	const uint8_t* end = data.begin() + e;
+	while (p < end) {
+		const uint8_t* null = findNull(p, end);
+		if (!null) {
+			memcpy(o, p, end - p);
+			o += end - p;
+			break;
+		}
+		memcpy(o, p, null - p);
+		o += null - p;
+		// A null followed by another byte is an escaped null, while the last one ends the string
+		if (null + 1 < end) {
+			*o++ = '\x00';
+		}
+		p = null + 2;
 	}
 
-	result.StringRef::operator=(StringRef(staging.begin(), staging.size()));
-	return result;
+	return StringRef(out, o - out);
 }
 
 int64_t Tuple::getInt(size_t index, bool allow_incomplete) const {
@@ -565,6 +596,32 @@ TEST_CASE("/fdbclient/Tuple/makeTuple") {
 	return Void();
 }
 
+TEST_CASE("/fdbclient/Tuple/escapedNulls") {
+	std::vector<std::string> strs = { "",
+		                              "\x00"_sr.toString(),
+		                              "\x00\x00"_sr.toString(),
+		                              "a\x00"
+		                              "b\x00\x00"
+		                              "c"_sr.toString(),
+		                              "\xff\x00\xff"_sr.toString(),
+		                              std::string(100, 'x') + std::string(1, '\0') + std::string(100, 'y') };
+	Tuple t;
+	for (auto const& s : strs) {
+		t.append(StringRef(s)).append(1);
+	}
+	Tuple u = Tuple::unpack(t.pack());
+	ASSERT_EQ(u.size(), strs.size() * 2);
+
+	Arena arena;
+	for (int i = 0; i < strs.size(); ++i) {
+		ASSERT(u.getString(2 * i) == StringRef(strs[i]));
+		ASSERT(u.getString(2 * i, arena) == StringRef(strs[i]));
+		ASSERT_EQ(u.getInt(2 * i + 1), 1);
+	}
+
+	return Void();
+}
+
 TEST_CASE("/fdbclient/Tuple/unpack") {
 	Tuple t1 = Tuple::makeTuple(1,
 	                            1.0f,
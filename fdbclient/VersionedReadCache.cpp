@@ -0,0 +1,123 @@
+/*
+ * VersionedReadCache.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/VersionedReadCache.h"
+#include "flow/UnitTest.h"
+
+void VersionedReadCache::setCapacity(int64_t bytes) {
+	capacity = bytes;
+	while (usedBytes > capacity && !versions.empty()) {
+		evictOldestVersion();
+	}
+}
+
+Optional<Optional<Value>> VersionedReadCache::get(Version version, KeyRef key) const {
+	auto v = versions.find(version);
+	if (v == versions.end()) {
+		return Optional<Optional<Value>>();
+	}
+	auto it = v->second.values.find(key);
+	if (it == v->second.values.end()) {
+		return Optional<Optional<Value>>();
+	}
+	if (!it->second.present()) {
+		return Optional<Value>();
+	}
+	return Optional<Value>(Value(it->second.get(), v->second.arena));
+}
+
+void VersionedReadCache::insert(Version version, KeyRef key, Optional<ValueRef> value) {
+	int64_t size = entryBytes(key, value);
+	if (size > capacity) {
+		return;
+	}
+	while (usedBytes + size > capacity && versions.begin()->first < version) {
+		evictOldestVersion();
+	}
+	if (usedBytes + size > capacity) {
+		// Only reads at this and newer versions are left, and they are more likely to be used again
+		return;
+	}
+
+	VersionReads& reads = versions[version];
+	if (reads.values.count(key)) {
+		return;
+	}
+	KeyRef keyCopy(reads.arena, key);
+	reads.values[keyCopy] = value.present() ? ValueRef(reads.arena, value.get()) : Optional<ValueRef>();
+	usedBytes += size;
+}
+
+void VersionedReadCache::evictOldestVersion() {
+	auto oldest = versions.begin();
+	for (auto const& [key, value] : oldest->second.values) {
+		usedBytes -= entryBytes(key, value);
+	}
+	versions.erase(oldest);
+}
+
+TEST_CASE("/fdbclient/VersionedReadCache/exactVersions") {
+	VersionedReadCache cache;
+	cache.insert(10, "a"_sr, "1"_sr);
+	ASSERT(!cache.get(10, "a"_sr).present());
+
+	cache.setCapacity(100);
+	cache.insert(10, "a"_sr, "1"_sr);
+	cache.insert(10, "b"_sr, Optional<ValueRef>());
+	ASSERT(cache.get(10, "a"_sr).get() == Optional<Value>("1"_sr));
+	ASSERT(cache.get(10, "b"_sr).present() && !cache.get(10, "b"_sr).get().present());
+	// Nothing is known about other versions
+	ASSERT(!cache.get(9, "a"_sr).present());
+	ASSERT(!cache.get(11, "a"_sr).present());
+	ASSERT(!cache.get(10, "c"_sr).present());
+	ASSERT_EQ(cache.bytes(), 3);
+
+	cache.setCapacity(0);
+	ASSERT_EQ(cache.bytes(), 0);
+	ASSERT(!cache.get(10, "a"_sr).present());
+	return Void();
+}
+
+TEST_CASE("/fdbclient/VersionedReadCache/evictOldest") {
+	VersionedReadCache cache;
+	cache.setCapacity(12);
+	cache.insert(1, "k1"_sr, "v1"_sr);
+	cache.insert(2, "k2"_sr, "v2"_sr);
+	cache.insert(3, "k3"_sr, "v3"_sr);
+	ASSERT_EQ(cache.bytes(), 12);
+	ASSERT(cache.get(1, "k1"_sr).present());
+
+	cache.insert(3, "k4"_sr, "v4"_sr);
+	ASSERT(!cache.get(1, "k1"_sr).present());
+	ASSERT(cache.get(2, "k2"_sr).present());
+	ASSERT(cache.get(3, "k4"_sr).present());
+	ASSERT_EQ(cache.bytes(), 12);
+
+	// A read at an older version does not push out newer ones
+	cache.insert(1, "k5"_sr, "v5"_sr);
+	ASSERT(!cache.get(1, "k5"_sr).present());
+	ASSERT_EQ(cache.bytes(), 12);
+
+	// A value may outlive its eviction
+	Optional<Value> v = cache.get(3, "k3"_sr).get();
+	cache.setCapacity(0);
+	ASSERT(v.get() == "v3"_sr);
+	return Void();
+}
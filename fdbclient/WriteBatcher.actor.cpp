@@ -0,0 +1,140 @@
+/*
+ * WriteBatcher.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/WriteBatcher.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+namespace {
+
+void applyMutation(Transaction& tr, MutationRef const& m) {
+	if (m.type == MutationRef::SetValue) {
+		tr.set(m.param1, m.param2);
+	} else if (m.type == MutationRef::ClearRange) {
+		tr.clear(KeyRangeRef(m.param1, m.param2));
+	} else if (isAtomicOp((MutationRef::Type)m.type)) {
+		tr.atomicOp(m.param1, m.param2, (MutationRef::Type)m.type);
+	} else {
+		throw client_invalid_operation();
+	}
+}
+
+// Adds the mutations of writes to tr, failing and removing any write that tr rejects
+void applyWrites(Transaction& tr, std::vector<WriteBatcher::PendingWrite>& writes) {
+	for (size_t i = 0; i < writes.size();) {
+		try {
+			for (auto const& m : writes[i].mutations) {
+				applyMutation(tr, m);
+			}
+			++i;
+		} catch (Error& e) {
+			writes[i].committed.sendError(e);
+			writes.erase(writes.begin() + i);
+			// Start over without the part of the write that was applied
+			tr.reset();
+			i = 0;
+		}
+	}
+}
+
+void failWrites(std::vector<WriteBatcher::PendingWrite>& writes, Error const& e) {
+	for (auto& w : writes) {
+		w.committed.sendError(e);
+	}
+}
+
+ACTOR Future<Void> commitBatch(Database db, std::vector<WriteBatcher::PendingWrite> writes) {
+	state Transaction tr(db);
+	state Error err;
+	loop {
+		try {
+			applyWrites(tr, writes);
+			if (writes.empty()) {
+				return Void();
+			}
+			wait(tr.commit());
+			for (auto& w : writes) {
+				w.committed.send(tr.getCommittedVersion());
+			}
+			return Void();
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			if (e.code() == error_code_commit_unknown_result) {
+				failWrites(writes, e);
+				return Void();
+			}
+			err = e;
+		}
+		try {
+			wait(tr.onError(err));
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			failWrites(writes, e);
+			return Void();
+		}
+	}
+}
+
+ACTOR Future<Void> flushAfter(WriteBatcher* self, uint64_t* flushedBatches, uint64_t batch, double window) {
+	wait(delay(window));
+	if (*flushedBatches == batch) {
+		self->flush();
+	}
+	return Void();
+}
+
+} // namespace
+
+WriteBatcher::WriteBatcher(Database db) : db(db), commits(false) {}
+
+Future<Version> WriteBatcher::write(Standalone<VectorRef<MutationRef>> mutations) {
+	int64_t bytes = mutations.expectedSize();
+	if (pendingBytes + bytes > CLIENT_KNOBS->WRITE_BATCH_MAX_BYTES && !pending.empty()) {
+		// Writes too large to share a batch get one of their own
+		flush();
+	}
+
+	PendingWrite& w = pending.emplace_back();
+	w.mutations = mutations;
+	Future<Version> committed = w.committed.getFuture();
+	pendingBytes += bytes;
+
+	if (pendingBytes >= CLIENT_KNOBS->WRITE_BATCH_MAX_BYTES) {
+		flush();
+	} else if (!windowStarted) {
+		windowStarted = true;
+		commits.add(flushAfter(this, &flushedBatches, flushedBatches, CLIENT_KNOBS->WRITE_BATCH_WINDOW));
+	}
+	return committed;
+}
+
+void WriteBatcher::flush() {
+	if (pending.empty()) {
+		return;
+	}
+	++flushedBatches;
+	windowStarted = false;
+	commits.add(commitBatch(db, std::move(pending)));
+	pending.clear();
+	pendingBytes = 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include "fdbclient/WriteMap.h"
+#include "fdbclient/Knobs.h"
 
 void OperationStack::reset(RYWMutation initialEntry) {
 	defaultConstructed = false;
@@ -75,19 +76,87 @@ bool OperationStack::operator==(const OperationStack& r) const {
 	return true;
 }
 
+WriteMap::WriteMap(Arena* arena) : WriteMap(arena, CLIENT_KNOBS->WRITE_MAP_FLAT_ENTRIES) {}
+
+WriteMap::WriteMap(Arena* arena, int flatLimit)
+  : arena(arena), writeMapEmpty(true), flatLimit(flatLimit), ver(-1), scratch_iterator(this) {
+	if (flatLimit > 0) {
+		flat = makeReference<FlatEntries>();
+		flat->entries.reserve(flatLimit + 1);
+	}
+	insert(WriteMapEntry(allKeys.begin, OperationStack(), false, false, false, false, false));
+	insert(WriteMapEntry(allKeys.end, OperationStack(), false, false, false, false, false));
+	insert(WriteMapEntry(afterAllKeys, OperationStack(), false, false, false, false, false));
+}
+
 WriteMap& WriteMap::operator=(WriteMap&& r) noexcept {
 	writeMapEmpty = r.writeMapEmpty;
 	writes = std::move(r.writes);
+	flat = std::move(r.flat);
+	flatLimit = r.flatLimit;
 	ver = r.ver;
 	scratch_iterator = std::move(r.scratch_iterator);
 	arena = r.arena;
 	return *this;
 }
 
+// The entries of flat, copied first if an iterator is reading them
+std::vector<WriteMapEntry>& WriteMap::mutableFlatEntries() {
+	if (!flat->isSoleOwner()) {
+		auto copy = makeReference<FlatEntries>();
+		copy->entries.reserve(flatLimit + 1);
+		copy->entries = flat->entries;
+		flat = copy;
+	}
+	return flat->entries;
+}
+
+void WriteMap::insert(WriteMapEntry const& entry) {
+	if (!flat) {
+		PTreeImpl::insert(writes, ver, entry);
+		return;
+	}
+	auto& entries = mutableFlatEntries();
+	auto i = std::lower_bound(entries.begin(), entries.end(), entry.key);
+	if (i != entries.end() && i->key == entry.key) {
+		*i = entry;
+	} else {
+		entries.insert(i, entry);
+	}
+	if ((int)entries.size() > flatLimit) {
+		for (auto const& e : entries) {
+			PTreeImpl::insert(writes, ver, e);
+		}
+		flat.clear();
+	}
+}
+
+void WriteMap::remove(ExtStringRef key) {
+	if (!flat) {
+		PTreeImpl::remove(writes, ver, key);
+		return;
+	}
+	auto& entries = mutableFlatEntries();
+	auto i = std::lower_bound(entries.begin(), entries.end(), key);
+	ASSERT(i != entries.end() && key.compare(i->key) == 0);
+	entries.erase(i);
+}
+
+// Removes the entries from begin up to but not including end
+void WriteMap::remove(ExtStringRef begin, ExtStringRef end) {
+	if (!flat) {
+		PTreeImpl::remove(writes, ver, begin, end);
+		return;
+	}
+	auto& entries = mutableFlatEntries();
+	auto first = std::lower_bound(entries.begin(), entries.end(), begin);
+	entries.erase(first, std::lower_bound(first, entries.end(), end));
+}
+
 void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, bool addConflict) {
 	writeMapEmpty = false;
 	auto& it = scratch_iterator;
-	it.reset(writes, ver);
+	it.reset(writes, flat, ver);
 	it.skip(key);
 
 	bool is_cleared = it.entry().following_keys_cleared;
@@ -101,40 +170,33 @@ void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, b
 
 	if (it.entry().key != key) {
 		if (it.is_cleared_range() && is_dependent) {
-			it.tree.clear();
+			it.clear();
 			OperationStack op(RYWMutation(Optional<StringRef>(), MutationRef::SetValue));
 			coalesceOver(op, RYWMutation(param, operation), *arena);
-			PTreeImpl::insert(
-			    writes,
-			    ver,
-			    WriteMapEntry(
-			        key, std::move(op), true, following_conflict, is_conflict, following_unreadable, is_unreadable));
+			insert(WriteMapEntry(
+			    key, std::move(op), true, following_conflict, is_conflict, following_unreadable, is_unreadable));
 		} else {
-			it.tree.clear();
-			PTreeImpl::insert(writes,
-			                  ver,
-			                  WriteMapEntry(key,
-			                                OperationStack(RYWMutation(param, operation)),
-			                                is_cleared,
-			                                following_conflict,
-			                                is_conflict,
-			                                following_unreadable,
-			                                is_unreadable));
+			it.clear();
+			insert(WriteMapEntry(key,
+			                     OperationStack(RYWMutation(param, operation)),
+			                     is_cleared,
+			                     following_conflict,
+			                     is_conflict,
+			                     following_unreadable,
+			                     is_unreadable));
 		}
 	} else {
 		if (!it.is_unreadable() &&
 		    (operation == MutationRef::SetValue || operation == MutationRef::SetVersionstampedValue)) {
-			it.tree.clear();
-			PTreeImpl::remove(writes, ver, key);
-			PTreeImpl::insert(writes,
-			                  ver,
-			                  WriteMapEntry(key,
-			                                OperationStack(RYWMutation(param, operation)),
-			                                is_cleared,
-			                                following_conflict,
-			                                is_conflict,
-			                                following_unreadable,
-			                                is_unreadable));
+			it.clear();
+			remove(key);
+			insert(WriteMapEntry(key,
+			                     OperationStack(RYWMutation(param, operation)),
+			                     is_cleared,
+			                     following_conflict,
+			                     is_conflict,
+			                     following_unreadable,
+			                     is_unreadable));
 		} else {
 			WriteMapEntry e(it.entry());
 			e.is_conflict = is_conflict;
@@ -147,12 +209,9 @@ void WriteMap::mutate(KeyRef key, MutationRef::Type operation, ValueRef param, b
 			else
 				e.stack.push(RYWMutation(param, operation));
 
-			it.tree.clear();
-			PTreeImpl::remove(
-			    writes,
-			    ver,
-			    e.key); // FIXME: Make PTreeImpl::insert do this automatically (see also VersionedMap.h FIXME)
-			PTreeImpl::insert(writes, ver, std::move(e));
+			it.clear();
+			remove(e.key); // FIXME: Make PTreeImpl::insert do this automatically (see also VersionedMap.h FIXME)
+			insert(std::move(e));
 		}
 	}
 }
@@ -165,7 +224,7 @@ void WriteMap::clear(KeyRangeRef keys, bool addConflict) {
 	}
 
 	auto& it = scratch_iterator;
-	it.reset(writes, ver);
+	it.reset(writes, flat, ver);
 	it.skip(keys.begin);
 
 	bool insert_begin = !it.is_cleared_range() || !it.is_conflict_range() || it.is_unreadable();
@@ -184,27 +243,21 @@ void WriteMap::clear(KeyRangeRef keys, bool addConflict) {
 	bool end_cleared = it.is_cleared_range();
 	bool end_unreadable = it.is_unreadable();
 
-	it.tree.clear();
+	it.clear();
 
-	PTreeImpl::remove(writes,
-	                  ver,
-	                  ExtStringRef(keys.begin, !insert_begin ? 1 : 0),
-	                  ExtStringRef(keys.end, end_coalesce_clear ? 1 : 0));
+	remove(ExtStringRef(keys.begin, !insert_begin ? 1 : 0), ExtStringRef(keys.end, end_coalesce_clear ? 1 : 0));
 
 	if (insert_begin)
-		PTreeImpl::insert(writes, ver, WriteMapEntry(keys.begin, OperationStack(), true, true, true, false, false));
+		insert(WriteMapEntry(keys.begin, OperationStack(), true, true, true, false, false));
 
 	if (insert_end)
-		PTreeImpl::insert(
-		    writes,
-		    ver,
-		    WriteMapEntry(
-		        keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
+		insert(WriteMapEntry(
+		    keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
 }
 
 void WriteMap::addUnmodifiedAndUnreadableRange(KeyRangeRef keys) {
 	auto& it = scratch_iterator;
-	it.reset(writes, ver);
+	it.reset(writes, flat, ver);
 	it.skip(keys.begin);
 
 	bool insert_begin = !it.is_unmodified_range() || it.is_conflict_range() || !it.is_unreadable();
@@ -223,28 +276,22 @@ void WriteMap::addUnmodifiedAndUnreadableRange(KeyRangeRef keys) {
 	bool end_cleared = it.is_cleared_range();
 	bool end_unreadable = it.is_unreadable();
 
-	it.tree.clear();
+	it.clear();
 
-	PTreeImpl::remove(writes,
-	                  ver,
-	                  ExtStringRef(keys.begin, !insert_begin ? 1 : 0),
-	                  ExtStringRef(keys.end, end_coalesce_unmodified ? 1 : 0));
+	remove(ExtStringRef(keys.begin, !insert_begin ? 1 : 0), ExtStringRef(keys.end, end_coalesce_unmodified ? 1 : 0));
 
 	if (insert_begin)
-		PTreeImpl::insert(writes, ver, WriteMapEntry(keys.begin, OperationStack(), false, false, false, true, true));
+		insert(WriteMapEntry(keys.begin, OperationStack(), false, false, false, true, true));
 
 	if (insert_end)
-		PTreeImpl::insert(
-		    writes,
-		    ver,
-		    WriteMapEntry(
-		        keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
+		insert(WriteMapEntry(
+		    keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
 }
 
 void WriteMap::addConflictRange(KeyRangeRef keys) {
 	writeMapEmpty = false;
 	auto& it = scratch_iterator;
-	it.reset(writes, ver);
+	it.reset(writes, flat, ver);
 	it.skip(keys.begin);
 
 	std::vector<ExtStringRef> removals;
@@ -287,18 +334,15 @@ void WriteMap::addConflictRange(KeyRangeRef keys) {
 		}
 	}
 
-	it.tree.clear();
+	it.clear();
 
 	// SOMEDAY: optimize this code by having a PTree removal/insertion that takes and returns an iterator
 	for (int i = 0; i < removals.size(); i++) {
-		PTreeImpl::remove(
-		    writes,
-		    ver,
-		    removals[i]); // FIXME: Make PTreeImpl::insert do this automatically (see also VersionedMap.h FIXME)
+		remove(removals[i]); // FIXME: Make PTreeImpl::insert do this automatically (see also VersionedMap.h FIXME)
 	}
 
 	for (int i = 0; i < insertions.size(); i++) {
-		PTreeImpl::insert(writes, ver, std::move(insertions[i]));
+		insert(std::move(insertions[i]));
 	}
 }
 
@@ -312,6 +356,9 @@ WriteMap::iterator::SEGMENT_TYPE WriteMap::iterator::type() const {
 WriteMap::iterator& WriteMap::iterator::operator++() {
 	if (!offset && !equalsKeyAfter(entry().key, nextEntry().key)) {
 		offset = true;
+	} else if (flat) {
+		++index;
+		offset = !entry().stack.size();
 	} else {
 		beginLen = endLen;
 		finger.resize(beginLen);
@@ -323,6 +370,9 @@ WriteMap::iterator& WriteMap::iterator::operator++() {
 WriteMap::iterator& WriteMap::iterator::operator--() {
 	if (offset && entry().stack.size()) {
 		offset = false;
+	} else if (flat) {
+		--index;
+		offset = !entry().stack.size() || !equalsKeyAfter(entry().key, nextEntry().key);
 	} else {
 		endLen = beginLen;
 		finger.resize(endLen);
@@ -334,6 +384,12 @@ WriteMap::iterator& WriteMap::iterator::operator--() {
 
 void WriteMap::iterator::skip(
     KeyRef key) { // Changes *this to the segment containing key (so that beginKey()<=key && key < endKey())
+	if (flat) {
+		auto const& entries = flat->entries;
+		index = std::upper_bound(entries.begin(), entries.end(), key) - entries.begin() - 1;
+		offset = !entry().stack.size() || (entry().key != key);
+		return;
+	}
 	finger.clear();
 
 	if (key == allKeys.end)
@@ -346,8 +402,9 @@ void WriteMap::iterator::skip(
 	offset = !entry().stack.size() || (entry().key != key);
 }
 
-void WriteMap::iterator::reset(Tree const& tree, Version ver) {
+void WriteMap::iterator::reset(Tree const& tree, Flat const& flat, Version ver) {
 	this->tree = tree;
+	this->flat = flat;
 	this->at = ver;
 	this->finger.clear();
 	beginLen = endLen = 0;
@@ -500,8 +557,22 @@ RYWMutation WriteMap::coalesceUnder(OperationStack const& stack, Optional<ValueR
 		return stack.at(0);
 
 	RYWMutation currentEntry = RYWMutation(value, MutationRef::SetValue);
+	// The value is copied once an operation can be applied to it in place, and the following operations of its size
+	// update that copy instead of allocating a value of their own
+	bool copied = false;
 	for (int i = 0; i < stack.size(); ++i) {
-		currentEntry = coalesce(currentEntry, stack.at(i), arena);
+		RYWMutation const& op = stack.at(i);
+		if (currentEntry.type == MutationRef::SetValue && currentEntry.value.present() && op.value.present() &&
+		    canFoldAtomicOp(op.type, currentEntry.value.get(), op.value.get())) {
+			if (!copied) {
+				currentEntry.value = ValueRef(arena, currentEntry.value.get());
+				copied = true;
+			}
+			foldAtomicOp(op.type, currentEntry.value.get(), op.value.get());
+		} else {
+			currentEntry = coalesce(currentEntry, op, arena);
+			copied = false;
+		}
 	}
 
 	return currentEntry;
@@ -526,7 +597,7 @@ void WriteMap::dump() {
 
 void WriteMap::clearNoConflict(KeyRangeRef keys) {
 	auto& it = scratch_iterator;
-	it.reset(writes, ver);
+	it.reset(writes, flat, ver);
 
 	// Find all write conflict ranges within the cleared range
 	it.skip(keys.begin);
@@ -569,28 +640,19 @@ void WriteMap::clearNoConflict(KeyRangeRef keys) {
 
 	CODE_PROBE(it.is_conflict_range() != lastConflicted, "not last conflicted");
 
-	it.tree.clear();
+	it.clear();
 
-	PTreeImpl::remove(writes,
-	                  ver,
-	                  ExtStringRef(keys.begin, !insert_begin ? 1 : 0),
-	                  ExtStringRef(keys.end, end_coalesce_clear ? 1 : 0));
+	remove(ExtStringRef(keys.begin, !insert_begin ? 1 : 0), ExtStringRef(keys.end, end_coalesce_clear ? 1 : 0));
 
 	for (int i = 0; i < conflict_ranges.size(); i++) {
-		PTreeImpl::insert(
-		    writes,
-		    ver,
-		    WriteMapEntry(
-		        conflict_ranges[i].toArenaOrRef(*arena), OperationStack(), true, conflicted, conflicted, false, false));
+		insert(WriteMapEntry(
+		    conflict_ranges[i].toArenaOrRef(*arena), OperationStack(), true, conflicted, conflicted, false, false));
 		conflicted = !conflicted;
 	}
 
 	ASSERT(conflicted != lastConflicted);
 
 	if (insert_end)
-		PTreeImpl::insert(
-		    writes,
-		    ver,
-		    WriteMapEntry(
-		        keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
+		insert(WriteMapEntry(
+		    keys.end, OperationStack(), end_cleared, end_conflict, end_conflict, end_unreadable, end_unreadable));
 }
@@ -55,6 +55,8 @@ static Future<T> joinErrorGroup(Future<T> f, Promise<Void> p) {
 // using multi-part upload and beginning to transfer each part as soon as it is large enough.
 // All write operations file operations must be sequential and contiguous.
 // Limits on part sizes, upload speed, and concurrent uploads are taken from the S3BlobStoreEndpoint being used.
+// Parts start at the minimum part size and then grow or shrink, within the part size limits, to what the measured
+// upload throughput sends in part_upload_seconds.
 class AsyncFileS3BlobStoreWrite final : public IAsyncFile, public ReferenceCounted<AsyncFileS3BlobStoreWrite> {
 public:
 	void addref() override { ReferenceCounted<AsyncFileS3BlobStoreWrite>::addref(); }
@@ -99,9 +101,9 @@ public:
 		state Part* p = f->m_parts.back().getPtr();
 		// If this write will cause the part to cross the min part size boundary then write to the boundary and start a
 		// new part.
-		while (p->length + length >= f->m_bstore->knobs.multipart_min_part_size) {
+		while (p->length + length >= f->m_partSize) {
 			// Finish off this part
-			int finishlen = f->m_bstore->knobs.multipart_min_part_size - p->length;
+			int finishlen = f->m_partSize - p->length;
 			p->write((const uint8_t*)data, finishlen);
 
 			// Adjust source buffer args
@@ -135,8 +137,10 @@ public:
 	ACTOR static Future<std::string> doPartUpload(AsyncFileS3BlobStoreWrite* f, Part* p) {
 		p->finalizeMD5();
 		std::string upload_id = wait(f->getUploadID());
+		state double start = now();
 		std::string etag = wait(f->m_bstore->uploadPart(
 		    f->m_bucket, f->m_object, upload_id, p->number, &p->content, p->length, p->md5string));
+		f->adjustPartSize(p->length, now() - start);
 		return etag;
 	}
 
@@ -221,6 +225,18 @@ private:
 	std::vector<Reference<Part>> m_parts;
 	Promise<Void> m_error;
 	FlowLock m_concurrentUploads;
+	int m_partSize;
+
+	// Size the next parts so that each takes about part_upload_seconds at the throughput of the last upload
+	void adjustPartSize(int bytes, double seconds) {
+		const auto& knobs = m_bstore->knobs;
+		if (knobs.part_upload_seconds <= 0 || seconds <= 0) {
+			return;
+		}
+		int64_t target = bytes / seconds * knobs.part_upload_seconds;
+		m_partSize = std::max<int64_t>(knobs.multipart_min_part_size,
+		                               std::min<int64_t>(knobs.multipart_max_part_size, target));
+	}
 
 	// End the current part and start uploading it, but also wait for a part to finish if too many are in transit.
 	ACTOR static Future<Void> endCurrentPart(AsyncFileS3BlobStoreWrite* f, bool startNew = false) {
@@ -235,11 +251,14 @@ private:
 		auto releaser = std::make_shared<FlowLock::Releaser>(f->m_concurrentUploads, 1);
 		f->m_parts.back()->etag =
 		    holdWhile(std::move(releaser), joinErrorGroup(doPartUpload(f, f->m_parts.back().getPtr()), f->m_error));
+		if (S3BlobStoreEndpoint::blobStats) {
+			++S3BlobStoreEndpoint::blobStats->partsUploaded;
+			S3BlobStoreEndpoint::blobStats->partBytesUploaded += f->m_parts.back()->length;
+		}
 
 		// Make a new part to write to
 		if (startNew)
-			f->m_parts.push_back(
-			    Reference<Part>(new Part(f->m_parts.size() + 1, f->m_bstore->knobs.multipart_min_part_size)));
+			f->m_parts.push_back(Reference<Part>(new Part(f->m_parts.size() + 1, f->m_partSize)));
 
 		return Void();
 	}
@@ -253,7 +272,8 @@ private:
 public:
 	AsyncFileS3BlobStoreWrite(Reference<S3BlobStoreEndpoint> bstore, std::string bucket, std::string object)
 	  : m_bstore(bstore), m_bucket(bucket), m_object(object), m_cursor(0),
-	    m_concurrentUploads(bstore->knobs.concurrent_writes_per_file) {
+	    m_concurrentUploads(bstore->knobs.concurrent_writes_per_file),
+	    m_partSize(bstore->knobs.multipart_min_part_size) {
 
 		// Add first part
 		m_parts.push_back(makeReference<Part>(1, m_bstore->knobs.multipart_min_part_size));
@@ -246,6 +246,86 @@ inline Optional<ValueRef> doCompareAndClear(const Optional<ValueRef>& existingVa
 	return existingValueOptional; // No change required.
 }
 
+// Returns true if an operation of the given type with operand can be folded into a present value, or into an earlier
+// operation of the same type on the same key, by foldAtomicOp(). Operations of equal lengths are associative, so the
+// folded operation has the same effect as the two it replaces.
+inline bool canFoldAtomicOp(MutationRef::Type type, const ValueRef& existing, const ValueRef& operand) {
+	switch (type) {
+	case MutationRef::AddValue:
+	case MutationRef::And:
+	case MutationRef::AndV2:
+	case MutationRef::Or:
+	case MutationRef::Xor:
+	case MutationRef::Max:
+	case MutationRef::Min:
+	case MutationRef::MinV2:
+	case MutationRef::ByteMax:
+	case MutationRef::ByteMin:
+		return existing.size() == operand.size();
+	default:
+		return false;
+	}
+}
+
+// Returns true if a is greater than b as a little endian integer of the same length
+inline bool littleEndianGreater(const ValueRef& a, const ValueRef& b) {
+	for (int i = a.size() - 1; i >= 0; i--) {
+		if (a[i] != b[i]) {
+			return a[i] > b[i];
+		}
+	}
+	return false;
+}
+
+// Applies operand to existing in place, without allocating. Requires canFoldAtomicOp(), and existing must not be
+// shared with anything that expects it to stay the same.
+inline void foldAtomicOp(MutationRef::Type type, StringRef existing, const ValueRef& operand) {
+	ASSERT(canFoldAtomicOp(type, existing, operand));
+	uint8_t* buf = mutateString(existing);
+	int carry = 0;
+	switch (type) {
+	case MutationRef::AddValue:
+		for (int i = 0; i < operand.size(); i++) {
+			int sum = buf[i] + operand[i] + carry;
+			buf[i] = sum;
+			carry = sum >> 8;
+		}
+		break;
+	case MutationRef::And:
+	case MutationRef::AndV2:
+		for (int i = 0; i < operand.size(); i++)
+			buf[i] &= operand[i];
+		break;
+	case MutationRef::Or:
+		for (int i = 0; i < operand.size(); i++)
+			buf[i] |= operand[i];
+		break;
+	case MutationRef::Xor:
+		for (int i = 0; i < operand.size(); i++)
+			buf[i] ^= operand[i];
+		break;
+	case MutationRef::Max:
+		if (littleEndianGreater(operand, existing))
+			memcpy(buf, operand.begin(), operand.size());
+		break;
+	case MutationRef::Min:
+	case MutationRef::MinV2:
+		if (littleEndianGreater(existing, operand))
+			memcpy(buf, operand.begin(), operand.size());
+		break;
+	case MutationRef::ByteMax:
+		if (operand > existing)
+			memcpy(buf, operand.begin(), operand.size());
+		break;
+	case MutationRef::ByteMin:
+		if (operand < existing)
+			memcpy(buf, operand.begin(), operand.size());
+		break;
+	default:
+		UNREACHABLE();
+	}
+}
+
 static void placeVersionstamp(uint8_t* destination, Version version, uint16_t transactionNumber) {
 	version = bigEndian64(version);
 	transactionNumber = bigEndian16(transactionNumber);
@@ -313,4 +393,42 @@ inline void transformVersionstampMutation(MutationRef& mutation,
 	mutation.type = MutationRef::SetValue;
 }
 
+// An AppendVersionstamped mutation sets the key made of its param1, the versionstamp of its transaction and the
+// big-endian sequence number of the append within the transaction. So the appends under a prefix sort in commit order,
+// and neither clients nor conflicts on a counter are needed to order them.
+constexpr int APPEND_VERSIONSTAMP_SUFFIX_SIZE = 12;
+constexpr int MAX_APPENDS_PER_TRANSACTION = 1 << 16;
+
+inline void transformAppendMutation(MutationRef& mutation,
+                                    Arena& arena,
+                                    Version version,
+                                    uint16_t transactionNumber,
+                                    uint16_t sequence) {
+	int prefixSize = mutation.param1.size();
+	uint8_t* key = new (arena) uint8_t[prefixSize + APPEND_VERSIONSTAMP_SUFFIX_SIZE];
+	memcpy(key, mutation.param1.begin(), prefixSize);
+	placeVersionstamp(key + prefixSize, version, transactionNumber);
+	sequence = bigEndian16(sequence);
+	memcpy(key + prefixSize + 10, &sequence, sizeof(sequence));
+
+	mutation.param1 = StringRef(key, prefixSize + APPEND_VERSIONSTAMP_SUFFIX_SIZE);
+	mutation.type = MutationRef::SetValue;
+}
+
+// Returns the range of the keys that appends under prefix might set, for a transaction reading at minVersion
+inline KeyRangeRef getAppendKeyRange(Arena& arena, const KeyRef& prefix, Version minVersion, const KeyRef& maxKey) {
+	uint8_t* begin = new (arena) uint8_t[prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE];
+	memcpy(begin, prefix.begin(), prefix.size());
+	placeVersionstamp(begin + prefix.size(), minVersion, 0);
+	memset(begin + prefix.size() + 10, 0, 2);
+
+	uint8_t* end = new (arena) uint8_t[prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE + 1];
+	memcpy(end, prefix.begin(), prefix.size());
+	memset(end + prefix.size(), '\xff', APPEND_VERSIONSTAMP_SUFFIX_SIZE);
+	end[prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE] = 0;
+
+	return KeyRangeRef(KeyRef(begin, prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE),
+	                   std::min(KeyRef(end, prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE + 1), maxKey));
+}
+
 #endif
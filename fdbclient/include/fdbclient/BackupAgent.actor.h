@@ -30,6 +30,7 @@
 #include "fdbclient/TaskBucket.h"
 #include "fdbclient/Notified.h"
 #include "flow/IAsyncFile.h"
+#include "flow/CompressionUtils.h"
 #include "fdbclient/KeyBackedTypes.h"
 #include <ctime>
 #include <climits>
@@ -1013,6 +1014,60 @@ ACTOR Future<Standalone<VectorRef<KeyValueRef>>> decodeMutationLogFileBlock(Refe
 
 // Return a block of contiguous padding bytes "\0xff" for backup files, growing if needed.
 Value makePadding(int size);
+
+// A mutation of a partitioned mutation log block
+struct PartitionedLogMessage {
+	LogMessageVersion version;
+	StringRef message; // Serialized mutation
+};
+
+// Decodes a PARTITIONED_MLOG_VERSION or PARTITIONED_MLOG_GROUPED_VERSION block. Messages point into block or, for
+// compressed blocks, into arena. A grouped block holding no version in [minVersion, maxVersion) is not decompressed
+// and yields nothing; otherwise every message is returned and callers filter versions themselves.
+std::vector<PartitionedLogMessage> decodePartitionedLogBlock(StringRef block,
+                                                             Arena& arena,
+                                                             Version minVersion = 0,
+                                                             Version maxVersion = MAX_VERSION);
+
+// Builds PARTITIONED_MLOG_GROUPED_VERSION blocks from messages added in version order. Each block starts with the
+// first and last versions it holds, followed by chunks of about chunkBytes, each compressed with filter, in which
+// every version is written once for all of its messages. Blocks are padded to blockSize, except the final one.
+class PartitionedLogBlockEncoder {
+public:
+	PartitionedLogBlockEncoder(int blockSize, CompressionFilter filter, int chunkBytes)
+	  : blockSize(blockSize), filter(filter), chunkBytes(chunkBytes) {}
+
+	void add(LogMessageVersion version, StringRef message);
+
+	// Ends the final block
+	void finish();
+
+	// Returns the blocks completed since the last call, in order
+	std::vector<Standalone<StringRef>> takeBlocks() { return std::move(blocks); }
+
+private:
+	static constexpr int headerBytes = sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(Version);
+
+	void endChunk();
+	void endBlock(bool pad);
+
+	int blockSize;
+	CompressionFilter filter;
+	int chunkBytes;
+
+	std::string chunk;
+	Version chunkFirstVersion = invalidVersion;
+	Version groupVersion = invalidVersion;
+	size_t groupCountOffset = 0;
+	uint32_t groupCount = 0;
+
+	std::vector<Standalone<StringRef>> blockChunks;
+	int blockChunkBytes = 0;
+	Version blockFirstVersion = invalidVersion;
+	Version blockLastVersion = invalidVersion;
+
+	std::vector<Standalone<StringRef>> blocks;
+};
 } // namespace fileBackup
 
 // For fast restore simulation test
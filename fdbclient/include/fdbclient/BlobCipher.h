@@ -640,6 +640,26 @@ public:
 		return now() + INetwork::TIME_EPS >= expireAtTS ? true : false;
 	}
 
+	// Whether the caller should start fetching the key again because it needs a refresh within refreshAhead seconds.
+	// Returns true at most once until the key is fetched again with a later refresh time.
+	bool startRefreshAhead(int64_t refreshAhead) {
+		if (refreshAheadStarted || refreshAtTS == std::numeric_limits<int64_t>::max() ||
+		    now() + refreshAhead < refreshAtTS) {
+			return false;
+		}
+		refreshAheadStarted = true;
+		return true;
+	}
+
+	// The same base cipher was fetched again, and is valid until the new refresh and expire times
+	void extendValidity(int64_t refreshAt, int64_t expireAt) {
+		if (refreshAt > refreshAtTS) {
+			refreshAtTS = refreshAt;
+			refreshAheadStarted = false;
+		}
+		expireAtTS = std::max(expireAtTS, expireAt);
+	}
+
 	BlobCipherDetails details() const { return BlobCipherDetails{ encryptDomainId, baseCipherId, randomSalt }; }
 
 	void reset();
@@ -659,6 +679,7 @@ private:
 	int64_t refreshAtTS;
 	// CipherKey is valid until
 	int64_t expireAtTS;
+	bool refreshAheadStarted = false;
 
 	void initKey(const EncryptCipherDomainId& domainId,
 	             const uint8_t* baseCiph,
@@ -900,6 +921,11 @@ public:
 	                              Arena&);
 	StringRef encrypt(const uint8_t*, const int, BlobCipherEncryptHeaderRef*, Arena&);
 
+	// Restarts the cipher stream with a new IV while keeping the expanded key, so that a single instance can encrypt
+	// a sequence of independent buffers with the same cipher keys, such as all mutations of a commit batch that
+	// belong to one encryption domain, without setting up a new cipher context for every buffer.
+	void resetIV(const uint8_t* iv, const int ivLen);
+
 private:
 	void init();
 
@@ -0,0 +1,98 @@
+/*
+ * BlobGranuleFileCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_BLOBGRANULEFILECACHE_H
+#define FDBCLIENT_BLOBGRANULEFILECACHE_H
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flow/Arena.h"
+#include "flow/Optional.h"
+
+// A size bounded cache of blob granule file contents on local disk, shared by all databases in the process.
+// Granule files are immutable once written, so a file's name and the byte range read from it identify its contents,
+// and cached ranges never need to be invalidated. The least recently used ranges are evicted once the cache holds more
+// than BG_FILE_CACHE_BYTES, and ranges cached by an earlier process using the same directory are reused.
+//
+// The cache may be used from any thread. read() and write() do blocking file I/O, for the synchronous readers of the
+// client API; actors should instead do their own I/O on lookup() and tempPathFor(), and report it with insert() and
+// erase().
+class BlobGranuleFileCache {
+public:
+	// Returns the process' cache, or nullptr if BG_FILE_CACHE_DIR is not set
+	static BlobGranuleFileCache* get();
+
+	explicit BlobGranuleFileCache(std::string const& directory, int64_t capacity);
+
+	// Returns the cached contents of the given range of a granule file, if present
+	Optional<Standalone<StringRef>> read(StringRef filename, int64_t offset, int64_t length);
+
+	// Caches the contents of the given range of a granule file, evicting older ranges as needed. Failures to write
+	// the cache are ignored.
+	void write(StringRef filename, int64_t offset, int64_t length, StringRef data);
+
+	// Returns the path of the cached range, if present, and counts the lookup as a hit or a miss
+	Optional<std::string> lookup(StringRef filename, int64_t offset, int64_t length);
+
+	// Returns a new path the range can be written to before being added with insert()
+	std::string tempPathFor(StringRef filename, int64_t offset, int64_t length);
+
+	// Moves the range written to tempPath into the cache
+	void insert(StringRef filename, int64_t offset, int64_t length, std::string const& tempPath);
+
+	// Drops a range that could not be read back from the cache
+	void erase(StringRef filename, int64_t offset, int64_t length);
+
+	int64_t getHits() const { return hits; }
+	int64_t getMisses() const { return misses; }
+	int64_t getEvictions() const { return evictions; }
+	int64_t getBytes() const { return bytes; }
+	int64_t getCapacity() const { return capacity; }
+
+private:
+	struct Entry {
+		std::string name;
+		int64_t size;
+	};
+
+	std::string nameFor(StringRef filename, int64_t offset, int64_t length) const;
+	std::string pathFor(std::string const& name) const;
+
+	// Adds the named file to the most recently used end and evicts from the other end. Requires mutex to be held.
+	void addLocked(std::string const& name, int64_t size);
+	void eraseLocked(std::string const& name);
+
+	const std::string directory;
+	const int64_t capacity;
+
+	std::mutex mutex;
+	std::list<Entry> lru; // least recently used first
+	std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+
+	std::atomic<int64_t> hits, misses, evictions, bytes;
+	std::atomic<uint64_t> tempFiles;
+};
+
+#endif
@@ -66,6 +66,13 @@ RangeResult bgReadSnapshotFile(const StringRef& data,
                                Optional<KeyRef> tenantPrefix,
                                Optional<BlobGranuleCipherKeysCtx> encryptionCtx,
                                const KeyRangeRef& keys = normalKeys);
+// Reads the rows of a snapshot file in keys, decoding only the chunks that overlap it. Each value must be a packed
+// tuple, and is replaced by a tuple of just the elements at fields, in that order, with null for fields past its end.
+RangeResult bgReadSnapshotFileProjected(const StringRef& data,
+                                        Optional<KeyRef> tenantPrefix,
+                                        Optional<BlobGranuleCipherKeysCtx> encryptionCtx,
+                                        const KeyRangeRef& keys,
+                                        const std::vector<int>& fields);
 Standalone<VectorRef<GranuleMutationRef>> bgReadDeltaFile(const StringRef& data,
                                                           Optional<KeyRef> tenantPrefix,
                                                           Optional<BlobGranuleCipherKeysCtx> encryptionCtx);
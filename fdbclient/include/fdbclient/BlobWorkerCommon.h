@@ -47,6 +47,7 @@ struct BlobWorkerStats {
 	Counter forceFlushCleanups;
 	Counter readDrivenCompactions;
 	Counter oldFeedSnapshots;
+	Counter coldDeltaFiles;
 
 	int numRangesAssigned;
 	int mutationBytesBuffered;
@@ -95,12 +96,11 @@ struct BlobWorkerStats {
 	    flushGranuleReqs("FlushGranuleReqs", cc), compressionBytesRaw("CompressionBytesRaw", cc),
 	    compressionBytesFinal("CompressionBytesFinal", cc), fullRejections("FullRejections", cc),
 	    forceFlushCleanups("ForceFlushCleanups", cc), readDrivenCompactions("ReadDrivenCompactions", cc),
-	    oldFeedSnapshots("OldFeedSnapshots", cc), numRangesAssigned(0), mutationBytesBuffered(0), activeReadRequests(0),
-	    granulesPendingSplitCheck(0), minimumCFVersion(0), cfVersionLag(0), notAtLatestChangeFeeds(0),
-	    lastResidentMemory(0), snapshotBlobWriteLatencySample("SnapshotBlobWriteMetrics",
-	                                                          id,
-	                                                          sampleLoggingInterval,
-	                                                          fileOpLatencySketchAccuracy),
+	    oldFeedSnapshots("OldFeedSnapshots", cc), coldDeltaFiles("ColdDeltaFiles", cc), numRangesAssigned(0),
+	    mutationBytesBuffered(0), activeReadRequests(0), granulesPendingSplitCheck(0), minimumCFVersion(0),
+	    cfVersionLag(0), notAtLatestChangeFeeds(0), lastResidentMemory(0),
+	    snapshotBlobWriteLatencySample(
+	        "SnapshotBlobWriteMetrics", id, sampleLoggingInterval, fileOpLatencySketchAccuracy),
 	    deltaBlobWriteLatencySample("DeltaBlobWriteMetrics", id, sampleLoggingInterval, fileOpLatencySketchAccuracy),
 	    reSnapshotLatencySample("GranuleResnapshotMetrics", id, sampleLoggingInterval, fileOpLatencySketchAccuracy),
 	    readLatencySample("GranuleReadLatencyMetrics", id, sampleLoggingInterval, requestLatencySketchAccuracy),
@@ -46,6 +46,7 @@ public:
 	double MAX_GENERATIONS_SIM;
 
 	double COORDINATOR_RECONNECTION_DELAY;
+	double COORDINATOR_RECONNECTION_MAX_DELAY; // backoff limit after every coordinator failed
 	int CLIENT_EXAMPLE_AMOUNT;
 	double MAX_CLIENT_STATUS_AGE;
 	int MAX_COMMIT_PROXY_CONNECTIONS;
@@ -65,6 +66,8 @@ public:
 	double BACKOFF_GROWTH_RATE;
 	double RESOURCE_CONSTRAINED_MAX_BACKOFF;
 	int PROXY_COMMIT_OVERHEAD_BYTES;
+	bool COMMIT_COALESCE_READ_CONFLICT_RANGES;
+	int COMMIT_READ_CONFLICT_RANGE_LIMIT;
 	double SHARD_STAT_SMOOTH_AMOUNT;
 	int INIT_MID_SHARD_BYTES;
 
@@ -74,6 +77,10 @@ public:
 	int64_t VALUE_SIZE_LIMIT;
 	int64_t SPLIT_KEY_SIZE_LIMIT;
 	int METADATA_VERSION_CACHE_SIZE;
+	int WRITE_MAP_FLAT_ENTRIES; // A WriteMap keeps up to this many entries in a sorted array before using a tree
+	int64_t READ_CACHE_SIZE; // Bytes of values kept by read version for later transactions; see read_cache_size
+	double WRITE_BATCH_WINDOW; // How long a WriteBatcher waits for more writes before committing a batch
+	int64_t WRITE_BATCH_MAX_BYTES; // A WriteBatcher commits a batch as soon as its mutations reach this size
 	int64_t CHANGE_FEED_LOCATION_LIMIT;
 	int64_t CHANGE_FEED_CACHE_SIZE;
 	double CHANGE_FEED_POP_TIMEOUT;
@@ -83,14 +90,18 @@ public:
 
 	int MAX_BATCH_SIZE;
 	double GRV_BATCH_TIMEOUT;
+	double GRV_SHARE_WINDOW; // Bounded stale transactions share a GRV request sent up to this many seconds earlier
 	int BROADCAST_BATCH_SIZE;
 	double TRANSACTION_TIMEOUT_DELAY_INTERVAL;
+	double EARLY_CONFLICT_CHECK_INTERVAL; // How often a transaction with early_conflict_detection checks its reads
 
 	// When locationCache in DatabaseContext gets to be this size, items will be evicted
 	int LOCATION_CACHE_EVICTION_SIZE;
 	int LOCATION_CACHE_EVICTION_SIZE_SIM;
 	double LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD;
 	double LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL;
+	int LOCATION_CACHE_PREWARM_SHARD_LIMIT; // Shards asked for in each request made by location_cache_prewarm
+	double LOCATION_CACHE_FILE_SAVE_INTERVAL;
 
 	int GET_RANGE_SHARD_LIMIT;
 	int WARM_RANGE_SHARD_LIMIT;
@@ -104,8 +115,14 @@ public:
 	bool TAG_ENCODE_KEY_SERVERS;
 	int64_t RANGESTREAM_FRAGMENT_SIZE;
 	int RANGESTREAM_BUFFERED_FRAGMENTS_LIMIT;
+	int RANGE_PREFETCH_DEPTH; // Batches requested ahead of a getRange scan in the prefetch streaming mode
+	int RANGE_PREFETCH_MAX_BYTES;
 	bool QUARANTINE_TSS_ON_MISMATCH;
+	double TSS_GET_VALUE_SAMPLE_RATE;
+	double TSS_GET_KEY_SAMPLE_RATE;
+	double TSS_GET_RANGE_SAMPLE_RATE;
 	double CHANGE_FEED_EMPTY_BATCH_TIME;
+	bool RYW_READ_THROUGH_WITHOUT_WRITES; // Range reads of transactions without writes skip the RYW snapshot cache
 
 	// KeyRangeMap
 	int KRM_GET_RANGE_LIMIT;
@@ -150,6 +167,7 @@ public:
 	int BACKUP_SIMULATED_LIMIT_BYTES;
 	int BACKUP_GET_RANGE_LIMIT_BYTES;
 	int BACKUP_LOCK_BYTES;
+	int64_t MUTATION_LOG_READER_BUFFERED_BYTES; // read ahead across all hashes of a MutationLogReader
 	double BACKUP_RANGE_TIMEOUT;
 	double BACKUP_RANGE_MINWAIT;
 	int BACKUP_SNAPSHOT_DISPATCH_INTERVAL_SEC;
@@ -175,6 +193,8 @@ public:
 	int64_t VERSIONS_PER_SECOND; // Copy of SERVER_KNOBS, as we can't link with it
 	int SIM_BACKUP_TASKS_PER_AGENT;
 	int BACKUP_RANGEFILE_BLOCK_SIZE;
+	std::string BACKUP_RANGEFILE_COMPRESSION_FILTER; // NONE writes uncompressed range files
+	int BACKUP_RANGEFILE_COMPRESSION_CHUNK_BYTES;
 	int BACKUP_LOGFILE_BLOCK_SIZE;
 	int BACKUP_DISPATCH_ADDTASK_SIZE;
 	int RESTORE_DISPATCH_ADDTASK_SIZE;
@@ -229,6 +249,7 @@ public:
 	int BLOBSTORE_CONCURRENT_REQUESTS;
 	int BLOBSTORE_MULTIPART_MAX_PART_SIZE;
 	int BLOBSTORE_MULTIPART_MIN_PART_SIZE;
+	int BLOBSTORE_MULTIPART_PART_UPLOAD_SECONDS;
 	int BLOBSTORE_CONCURRENT_UPLOADS;
 	int BLOBSTORE_CONCURRENT_LISTS;
 	int BLOBSTORE_CONCURRENT_WRITES_PER_FILE;
@@ -244,6 +265,8 @@ public:
 	double BLOBSTORE_STATS_LOGGING_INTERVAL;
 	double BLOBSTORE_LATENCY_LOGGING_INTERVAL;
 	double BLOBSTORE_LATENCY_LOGGING_ACCURACY;
+	double REST_LATENCY_LOGGING_INTERVAL;
+	double REST_LATENCY_LOGGING_ACCURACY;
 
 	int CONSISTENCY_CHECK_RATE_LIMIT_MAX;
 	int CONSISTENCY_CHECK_ONE_ROUND_TARGET_COMPLETION_TIME;
@@ -275,6 +298,8 @@ public:
 	// Blob Granules
 	int BG_MAX_GRANULE_PARALLELISM;
 	int BG_TOO_MANY_GRANULES;
+	std::string BG_FILE_CACHE_DIR; // if set, granule files read by this process are cached in this directory
+	int64_t BG_FILE_CACHE_BYTES; // the total size of the files kept in BG_FILE_CACHE_DIR
 	int64_t BLOB_METADATA_REFRESH_INTERVAL;
 
 	// The coordinator key/value in storage server might be inconsistent to the value stored in the cluster file.
@@ -295,6 +320,7 @@ public:
 	int METACLUSTER_RESTORE_BATCH_SIZE;
 	int TENANT_ENTRY_CACHE_LIST_REFRESH_INTERVAL; // How often the TenantEntryCache is refreshed
 	bool CLIENT_ENABLE_USING_CLUSTER_ID_KEY;
+	bool MULTI_VERSION_DIRECT_DISPATCH; // Skip the version change wrappers when only one client version is loaded
 
 	// Encryption-at-rest
 	bool ENABLE_ENCRYPTION_CPU_TIME_LOGGING;
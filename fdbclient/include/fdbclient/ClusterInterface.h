@@ -245,10 +245,15 @@ struct StatusReply {
 struct StatusRequest {
 	constexpr static FileIdentifier file_identifier = 14419140;
 	ReplyPromise<struct StatusReply> reply;
+	// The top level fields of the cluster status to return, or all of them if empty
+	std::vector<std::string> sections;
+
+	StatusRequest() {}
+	explicit StatusRequest(std::vector<std::string> sections) : sections(std::move(sections)) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, reply);
+		serializer(ar, reply, sections);
 	}
 };
 
@@ -57,6 +57,9 @@ static const char* typeString[] = { "SetValue",
 	                                "AndV2",
 	                                "CompareAndClear",
 	                                "Reserved_For_SpanContextMessage",
+	                                "Reserved_For_OTELSpanContextMessage",
+	                                "Encrypted",
+	                                "AppendVersionstamped",
 	                                "MAX_ATOMIC_OP" };
 
 struct MutationRef {
@@ -86,6 +89,7 @@ struct MutationRef {
 		Reserved_For_SpanContextMessage /* See fdbserver/SpanContextMessage.h */,
 		Reserved_For_OTELSpanContextMessage,
 		Encrypted, /* Represents an encrypted mutation and cannot be used directly before decrypting */
+		AppendVersionstamped, /* Turned into a SetValue of a key made by the commit proxy, see Atomic.h */
 		MAX_ATOMIC_OP
 	};
 	// This is stored this way for serialization purposes.
@@ -255,6 +259,32 @@ struct MutationRef {
 		}
 	}
 
+	// Encrypts the mutation with a cipher that is reused across mutations encrypted with the same keys. The cipher
+	// stream is restarted with a fresh IV, so the result is equivalent to encrypt() with a newly constructed cipher.
+	MutationRef encrypt(EncryptBlobCipherAes265Ctr& cipher, Arena& arena) const {
+		uint8_t iv[AES_256_IV_LENGTH] = { 0 };
+		deterministicRandom()->randomBytes(iv, AES_256_IV_LENGTH);
+		cipher.resetIV(iv, AES_256_IV_LENGTH);
+		BinaryWriter bw(AssumeVersion(ProtocolVersion::withEncryptionAtRest()));
+		bw << *this;
+
+		if (CLIENT_KNOBS->ENABLE_CONFIGURABLE_ENCRYPTION) {
+			BlobCipherEncryptHeaderRef header;
+			StringRef payload =
+			    cipher.encrypt(static_cast<const uint8_t*>(bw.getData()), bw.getLength(), &header, arena);
+			Standalone<StringRef> serializedHeader = BlobCipherEncryptHeaderRef::toStringRef(header);
+			arena.dependsOn(serializedHeader.arena());
+			return MutationRef(Encrypted, serializedHeader, payload);
+		} else {
+			BlobCipherEncryptHeader* header = new (arena) BlobCipherEncryptHeader;
+			StringRef serializedHeader =
+			    StringRef(reinterpret_cast<const uint8_t*>(header), sizeof(BlobCipherEncryptHeader));
+			StringRef payload =
+			    cipher.encrypt(static_cast<const uint8_t*>(bw.getData()), bw.getLength(), header, arena)->toStringRef();
+			return MutationRef(Encrypted, serializedHeader, payload);
+		}
+	}
+
 	MutationRef encryptMetadata(const std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>& cipherKeys,
 	                            Arena& arena,
 	                            BlobCipherMetrics::UsageType usageType) const {
@@ -329,11 +359,12 @@ struct MutationRef {
 	enum {
 		ATOMIC_MASK = (1 << AddValue) | (1 << And) | (1 << Or) | (1 << Xor) | (1 << AppendIfFits) | (1 << Max) |
 		              (1 << Min) | (1 << SetVersionstampedKey) | (1 << SetVersionstampedValue) | (1 << ByteMin) |
-		              (1 << ByteMax) | (1 << MinV2) | (1 << AndV2) | (1 << CompareAndClear),
+		              (1 << ByteMax) | (1 << MinV2) | (1 << AndV2) | (1 << CompareAndClear) |
+		              (1 << AppendVersionstamped),
 		SINGLE_KEY_MASK = ATOMIC_MASK | (1 << SetValue),
 		NON_ASSOCIATIVE_MASK = (1 << AddValue) | (1 << Or) | (1 << Xor) | (1 << Max) | (1 << Min) |
 		                       (1 << SetVersionstampedKey) | (1 << SetVersionstampedValue) | (1 << MinV2) |
-		                       (1 << CompareAndClear)
+		                       (1 << CompareAndClear) | (1 << AppendVersionstamped)
 	};
 };
 
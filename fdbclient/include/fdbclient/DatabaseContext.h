@@ -38,6 +38,7 @@
 #include "fdbclient/CommitProxyInterface.h"
 #include "fdbclient/SpecialKeySpace.actor.h"
 #include "fdbclient/VersionVector.h"
+#include "fdbclient/VersionedReadCache.h"
 #include "fdbrpc/QueueModel.h"
 #include "fdbrpc/MultiInterface.h"
 #include "flow/TDMetric.actor.h"
@@ -473,6 +474,19 @@ public:
 	};
 	std::map<uint32_t, VersionBatcher> versionBatcher;
 
+	// Read version pool for bounded stale transactions. Transactions with FLAG_BOUNDED_STALENESS started within
+	// GRV_SHARE_WINDOW of the latest GRV request with the same flags share that request's reply, outstanding or not,
+	// instead of sending their own.
+	struct SharedReadVersion {
+		Future<GetReadVersionReply> reply;
+		double requestTime = 0;
+	};
+	std::map<uint32_t, SharedReadVersion> sharedReadVersions;
+
+	// Values read by this database's transactions, for later ones reading at the same version. Sized by the
+	// read_cache_size option.
+	VersionedReadCache readCache;
+
 	AsyncTrigger connectionFileChangedTrigger;
 
 	// Disallow any reads at a read version lower than minAcceptableReadVersion.  This way the client does not have to
@@ -492,6 +506,9 @@ public:
 	// Cache of location information
 	int locationCacheSize;
 	CoalescedKeyRangeMap<Reference<LocationInfo>> locationCache;
+	// Set by the location_cache_prewarm and location_cache_file options
+	Future<Void> locationCachePrewarm;
+	Future<Void> locationCacheFile;
 	std::unordered_map<Endpoint, EndpointFailureInfo> failedEndpointsOnHealthyServersInfo;
 
 	std::map<UID, StorageServerInfo*> server_interf;
@@ -540,6 +557,8 @@ public:
 	Counter transactionGetRangeRequests;
 	Counter transactionGetMappedRangeRequests;
 	Counter transactionGetRangeStreamRequests;
+	Counter transactionRangePrefetches;
+	Counter transactionRangePrefetchHits;
 	Counter transactionWatchRequests;
 	Counter transactionGetAddressesForKeyRequests;
 	Counter transactionBytesRead;
@@ -567,7 +586,14 @@ public:
 	Counter transactionsExpensiveClearCostEstCount;
 	Counter transactionGrvFullBatches;
 	Counter transactionGrvTimedOutBatches;
+	Counter transactionGrvPoolHits;
+	Counter transactionGrvPoolMisses;
+	Counter transactionReadCacheHits;
 	Counter transactionCommitVersionNotFoundForSS;
+	Counter transactionReadConflictRangesMerged; // read conflict ranges not sent because they merged into another
+	Counter transactionReadConflictRangesWidened; // read conflict ranges folded into wider ones over the limit
+	Counter transactionCompressedRangeReplies;
+	Counter transactionRangeReplyBytesSavedByCompression;
 
 	// Blob Granule Read metrics. Omit from logging if not used.
 	bool anyBGReads;
@@ -591,6 +617,14 @@ public:
 	Counter feedPopsFallback;
 
 	DDSketch<double> latencies, readLatencies, commitLatencies, GRVLatencies, mutationsPerCommit, bytesPerCommit;
+	DDSketch<double> rangeReadLatencies;
+	// The latency sketches above are reset by the periodic metrics logger, which first adds them to these, so that
+	// client metrics can report the distributions since the database was opened
+	DDSketch<double> totalLatencies, totalReadLatencies, totalRangeReadLatencies, totalCommitLatencies,
+	    totalGRVLatencies;
+	// Wait times of transactions that got their read version from the read version pool. Not reset by the periodic
+	// metrics logger, so that client status reports the distribution since the database was opened.
+	DDSketch<double> grvPoolWaitTimes;
 
 	int outstandingWatches;
 	int maxOutstandingWatches;
@@ -750,6 +784,14 @@ public:
 	// { "InitializationError" : <error code> }
 	Standalone<StringRef> getClientStatus();
 
+	// Gets the latency distributions of this client's requests since the database was opened, as JSON:
+	// { "Latencies" : { "GRV" : <sketch>, "Read" : <sketch>, "RangeRead" : <sketch>, "Commit" : <sketch>,
+	//                   "Transaction" : <sketch> } }
+	// Each sketch is a DDSketch, { "ErrorGuarantee", "Count", "Min", "Max", "Sum", "Buckets" }, where Buckets lists
+	// the [ value, count ] of each nonempty bucket and samples of 0 are counted only in Count. Sketches with the same
+	// ErrorGuarantee, e.g. those of several clients, are merged by adding the counts of buckets with the same value.
+	Standalone<StringRef> getClientMetrics();
+
 private:
 	using WatchMapKey = std::pair<int64_t, Key>;
 	using WatchMapKeyHasher = boost::hash<WatchMapKey>;
@@ -714,6 +714,9 @@ struct GetRangeLimits {
 	int rows;
 	int minRows;
 	int bytes;
+	// The caller is scanning the range in batches, so the transaction may request the batches that follow this one
+	// before they are asked for. Has no effect on the results returned.
+	bool prefetch = false;
 
 	GetRangeLimits() : rows(ROW_LIMIT_UNLIMITED), minRows(1), bytes(BYTE_LIMIT_UNLIMITED) {}
 	explicit GetRangeLimits(int rowLimit) : rows(rowLimit), minRows(1), bytes(BYTE_LIMIT_UNLIMITED) {}
@@ -90,9 +90,45 @@ Future<EKPGetLatestBaseCipherKeysReply> getUncachedLatestEncryptCipherKeys(Refer
 	}
 }
 
+// Fetches the latest cipher keys of domains whose cached keys need a refresh soon into the local cache, while callers
+// keep using the cached keys, so that they do not wait for EncryptKeyProxy once the keys need a refresh.
+ACTOR template <class T>
+Future<Void> refreshLatestEncryptCipherKeysAhead(Reference<AsyncVar<T> const> db,
+                                                 EKPGetLatestBaseCipherKeysRequest request,
+                                                 BlobCipherMetrics::UsageType usageType) {
+	state Reference<BlobCipherKeyCache> cipherKeyCache = BlobCipherKeyCache::getInstance();
+	try {
+		loop choose {
+			when(EKPGetLatestBaseCipherKeysReply reply =
+			         wait(getUncachedLatestEncryptCipherKeys(db, request, usageType))) {
+				for (const EKPBaseCipherDetails& details : reply.baseCipherDetails) {
+					cipherKeyCache->insertCipherKey(details.encryptDomainId,
+					                                details.baseCipherId,
+					                                details.baseCipherKey.begin(),
+					                                details.baseCipherKey.size(),
+					                                details.refreshAt,
+					                                details.expireAt);
+				}
+				break;
+			}
+			when(wait(onEncryptKeyProxyChange(db))) {}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		// The keys are fetched by getLatestEncryptCipherKeys() once they need a refresh
+		TraceEvent(SevWarn, "RefreshLatestEncryptCipherKeysAheadFailed")
+		    .error(e)
+		    .detail("UsageType", toString(usageType))
+		    .detail("Domains", request.encryptDomainIds.size());
+	}
+	return Void();
+}
+
 // Get latest cipher keys for given encryption domains. It tries to get the cipher keys from local cache.
 // In case of cache miss, it fetches the cipher keys from EncryptKeyProxy and put the result in the local cache
-// before return.
+// before return. Cached keys that need a refresh within ENCRYPT_KEY_REFRESH_AHEAD are fetched in the background.
 ACTOR template <class T>
 Future<std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>> getLatestEncryptCipherKeys(
     Reference<AsyncVar<T> const> db,
@@ -108,14 +144,22 @@ Future<std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>>> getL
 	}
 
 	// Collect cached cipher keys.
+	EKPGetLatestBaseCipherKeysRequest refreshAheadRequest;
 	for (auto& domainId : domainIds) {
 		Reference<BlobCipherKey> cachedCipherKey = cipherKeyCache->getLatestCipherKey(domainId);
 		if (cachedCipherKey.isValid()) {
 			cipherKeys[domainId] = cachedCipherKey;
+			if (cachedCipherKey->startRefreshAhead(FLOW_KNOBS->ENCRYPT_KEY_REFRESH_AHEAD)) {
+				refreshAheadRequest.encryptDomainIds.emplace_back(domainId);
+			}
 		} else {
 			request.encryptDomainIds.emplace_back(domainId);
 		}
 	}
+	if (!refreshAheadRequest.encryptDomainIds.empty()) {
+		CODE_PROBE(true, "Latest cipher keys fetched ahead of their refresh time");
+		uncancellable(refreshLatestEncryptCipherKeysAhead(db, refreshAheadRequest, usageType));
+	}
 	if (request.encryptDomainIds.empty()) {
 		return cipherKeys;
 	}
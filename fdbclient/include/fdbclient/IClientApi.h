@@ -215,6 +215,9 @@ public:
 	// Return a JSON string containing database client-side status information
 	virtual ThreadFuture<Standalone<StringRef>> getClientStatus() = 0;
 
+	// Return a JSON string containing the latency distributions of the client's requests
+	virtual ThreadFuture<Standalone<StringRef>> getClientMetrics() = 0;
+
 	// used in template functions as the Transaction type that can be created through createTransaction()
 	using TransactionT = ITransaction;
 };
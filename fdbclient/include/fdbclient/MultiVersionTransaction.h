@@ -214,6 +214,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	                                      int64_t version);
 
 	FDBFuture* (*databaseGetClientStatus)(FDBDatabase* db);
+	FDBFuture* (*databaseGetClientMetrics)(FDBDatabase* db);
 
 	// Tenant
 	fdb_error_t (*tenantCreateTransaction)(FDBTenant* tenant, FDBTransaction** outTransaction);
@@ -622,6 +623,7 @@ public:
 
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
+	ThreadFuture<Standalone<StringRef>> getClientMetrics() override;
 
 private:
 	const Reference<FdbCApi> api;
@@ -781,6 +783,8 @@ private:
 		Reference<ITransaction> transaction;
 		ThreadFuture<Void> onChange;
 		ErrorOr<Void> dbError = ErrorOr<Void>(Void());
+		// Futures from transaction are returned as they are, see DatabaseState::directDispatch
+		bool directDispatch = false;
 	};
 
 	// Timeout related variables for MultiVersionTransaction objects that do not have an underlying ITransaction
@@ -1020,6 +1024,7 @@ public:
 
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
+	ThreadFuture<Standalone<StringRef>> getClientMetrics() override;
 
 	// private:
 
@@ -1076,6 +1081,12 @@ public:
 		// The current database initialization state
 		std::atomic<InitializationState> initializationState;
 
+		// Set while db was created by the only usable client. No other client could take over from it, so
+		// transactions skip wrapping their futures to abort them with cluster_version_changed when db changes. If
+		// the cluster is upgraded, their requests wait on the old connection until it is compatible again or they
+		// time out, as they would after retrying with no matching client.
+		std::atomic<bool> directDispatch;
+
 		// Last error received during database initialization
 		// Set on transition to INITIALIZATION_FAILED state, never changed afterwards
 		Error initializationError;
@@ -1159,6 +1170,11 @@ public:
 	static MultiVersionApi* api;
 
 	Reference<ClientInfo> getLocalClient();
+
+	// The CPU that the client thread with threadIndex is pinned to, if any
+	Optional<int> getThreadCpu(int threadIndex) const {
+		return threadCpus.empty() ? Optional<int>() : threadCpus[threadIndex % threadCpus.size()];
+	}
 	void runOnExternalClients(int threadId,
 	                          std::function<void(Reference<ClientInfo>)>,
 	                          bool runOnFailedClients = false,
@@ -1220,6 +1236,10 @@ private:
 
 	int nextThread = 0;
 	int threadCount;
+	// The CPUs that client threads are pinned to, by thread index modulo its size. Empty if they are not pinned.
+	std::vector<int> threadCpus;
+	// If set, databases are assigned to client threads by their cluster instead of in turn
+	bool assignThreadsByCluster;
 	std::string tmpDir;
 	bool traceShareBaseNameAmongThreads;
 	std::string traceFileIdentifier;
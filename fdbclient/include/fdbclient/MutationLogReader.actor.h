@@ -62,15 +62,23 @@ struct RangeResultBlock {
 // in charge of one hash value from 0-255.
 class PipelinedReader {
 public:
-	PipelinedReader(uint8_t h, Version bv, Version ev, unsigned pd, Key p)
+	PipelinedReader(uint8_t h, Version bv, Version ev, unsigned pd, Key p, Reference<FlowLock> bufferedBytes)
 	  : readerLimit(pd), hash(h), prefix(StringRef(&hash, sizeof(uint8_t)).withPrefix(p)), beginVersion(bv),
-	    endVersion(ev), currentBeginVersion(bv), pipelineDepth(pd) {}
+	    endVersion(ev), currentBeginVersion(bv), pipelineDepth(pd), bufferedBytes(bufferedBytes) {}
 
 	void startReading(Database cx);
 	Future<Void> getNext(Database cx);
 	ACTOR static Future<Void> getNext_impl(PipelinedReader* self, Database cx);
 
-	void release() { readerLimit.release(); }
+	// Called once the consumer is done with the oldest block sent to reads
+	void release() {
+		readerLimit.release();
+		if (reservations.front() > 0) {
+			bufferedBytes->release(reservations.front());
+		}
+		reservations.pop_front();
+		consumed.trigger();
+	}
 
 	PromiseStream<RangeResultBlock> reads;
 	FlowLock readerLimit;
@@ -83,6 +91,10 @@ private:
 	[[maybe_unused]] Version beginVersion;
 	Version endVersion, currentBeginVersion;
 	[[maybe_unused]] unsigned pipelineDepth;
+	// Bytes buffered by all the readers of a MutationLogReader, so that busy hashes can prefetch deeper than idle ones
+	Reference<FlowLock> bufferedBytes;
+	std::deque<int64_t> reservations; // bytes of bufferedBytes held by each block sent to reads and not yet released
+	AsyncTrigger consumed;
 	Future<Void> reader;
 };
 
@@ -98,12 +110,13 @@ class MutationLogReader : public ReferenceCounted<MutationLogReader> {
 public:
 	MutationLogReader() : finished(256) {}
 	MutationLogReader(Database cx, Version bv, Version ev, Key uid, Key beginKey, unsigned pd)
-	  : beginVersion(bv), endVersion(ev), prefix(uid.withPrefix(beginKey)), pipelineDepth(pd), finished(0) {
+	  : beginVersion(bv), endVersion(ev), prefix(uid.withPrefix(beginKey)), pipelineDepth(pd), finished(0),
+	    bufferedBytes(makeReference<FlowLock>(CLIENT_KNOBS->MUTATION_LOG_READER_BUFFERED_BYTES)) {
 		pipelinedReaders.reserve(256);
 		if (pipelineDepth > 0) {
 			for (int h = 0; h < 256; ++h) {
 				pipelinedReaders.emplace_back(new mutation_log_reader::PipelinedReader(
-				    (uint8_t)h, beginVersion, endVersion, pipelineDepth, prefix));
+				    (uint8_t)h, beginVersion, endVersion, pipelineDepth, prefix, bufferedBytes));
 				pipelinedReaders[h]->startReading(cx);
 			}
 		}
@@ -132,6 +145,7 @@ private:
 	Key prefix; // "\xff\x02/alog/UID/" for restore, or "\xff\x02/blog/UID/" for backup
 	unsigned pipelineDepth;
 	unsigned finished;
+	Reference<FlowLock> bufferedBytes;
 };
 
 #include "flow/unactorcompiler.h"
@@ -163,7 +163,9 @@ struct TransactionOptions {
 	bool useGrvCache : 1;
 	bool skipGrvCache : 1;
 	bool rawAccess : 1;
+	bool compressRangeReads : 1;
 	bool bypassStorageQuota : 1;
+	bool longRead : 1;
 
 	TransactionPriority priority;
 
@@ -284,6 +286,8 @@ struct TransactionState : ReferenceCounted<TransactionState> {
 	// Measured by summing the bytes accessed by each read and write operation
 	// after rounding up to the nearest page size and applying a write penalty
 	int64_t totalCost = 0;
+	// The number of AppendVersionstamped mutations, which the commit proxy numbers within the transaction
+	int appends = 0;
 
 	// Special flag to skip prepending tenant prefix to mutations and conflict ranges
 	// when a dummy, internal transaction gets commited. The sole purpose of commitDummyTransaction() is to
@@ -307,6 +311,9 @@ struct TransactionState : ReferenceCounted<TransactionState> {
 
 	Future<Void> startFuture;
 
+	// Storage servers asked to pin the read version for FDBTransactionOptions::LONG_READ
+	std::unordered_set<UID> pinnedServers;
+
 	// Only available so that Transaction can have a default constructor, for use in state variables
 	TransactionState(TaskPriority taskID, SpanContext spanContext)
 	  : taskID(taskID), spanContext(spanContext), tenantSet(false) {}
@@ -339,6 +346,18 @@ private:
 	bool tenantSet;
 };
 
+// One batch of a getRange scan in the prefetch streaming mode, along with the normalized selectors and byte limit it
+// was read with
+struct RangePrefetchBatch {
+	KeySelector begin;
+	KeySelector end;
+	int bytes = GetRangeLimits::BYTE_LIMIT_UNLIMITED;
+	RangeResult result;
+
+	// The selectors of the batch that continues after this one, if the range has more data
+	Optional<std::pair<KeySelector, KeySelector>> continuation(Reverse reverse) const;
+};
+
 class Transaction : NonCopyable {
 public:
 	explicit Transaction(Database const& cx, Optional<Reference<Tenant>> const& tenant = Optional<Reference<Tenant>>());
@@ -460,6 +479,10 @@ public:
 	// The returned list would still be in form of [keys.begin, splitPoint1, splitPoint2, ... , keys.end]
 	Future<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(KeyRange const& keys, int64_t chunkSize);
 
+	// Counts the keys in the range and sums their values as AddValue operands, on the storage servers as of the read
+	// version. The transaction's own uncommitted writes are not included. See RangeAggregate.
+	Future<RangeAggregate> getRangeAggregate(KeyRange const& keys, Snapshot snapshot = Snapshot::False);
+
 	Future<Standalone<VectorRef<KeyRangeRef>>> getBlobGranuleRanges(const KeyRange& range, int rangeLimit);
 	Future<Standalone<VectorRef<BlobGranuleChunkRef>>> readBlobGranules(const KeyRange& range,
 	                                                                    Version begin,
@@ -484,6 +507,10 @@ public:
 	// Throws not_committed or commit_unknown_result errors in normal operation
 	[[nodiscard]] Future<Void> commit();
 
+	// Returns false if a transaction committed after this transaction's read version wrote to one of readRanges, found
+	// by resolving them as a commit without writes. Returns true if none did or the check could not be made.
+	[[nodiscard]] Future<bool> checkReadConflicts(Standalone<VectorRef<KeyRangeRef>> readRanges);
+
 	void setOption(FDBTransactionOptions::Option option, Optional<StringRef> value = Optional<StringRef>());
 
 	// May be called only after commit() returns success
@@ -562,9 +589,24 @@ private:
 
 	void resetImpl(bool generateNewSpan);
 
+	Future<RangeResult> getRangePrefetch(const KeySelector& begin,
+	                                     const KeySelector& end,
+	                                     GetRangeLimits limits,
+	                                     Reverse reverse);
+
+	// The scan being read in the prefetch streaming mode. The batches after the one last returned are requested as
+	// soon as the batch before them is known, so up to RANGE_PREFETCH_DEPTH requests are outstanding.
+	struct RangePrefetch {
+		Reverse reverse = Reverse::False;
+		Future<RangePrefetchBatch> last;
+		std::deque<Future<RangePrefetchBatch>> next;
+	};
+
 	double backoff;
 	CommitTransactionRequest tr;
 	std::vector<Future<std::pair<Key, Key>>> extraConflictRanges;
+	Optional<RangePrefetch> rangePrefetch;
+	std::vector<Future<Void>> readVersionPins;
 	Promise<Void> commitResult;
 	Future<Void> committing;
 };
@@ -26,6 +26,7 @@
 
 #include "fdbclient/JSONDoc.h"
 #include "fdbrpc/HTTP.h"
+#include "fdbrpc/Stats.h"
 #include "fdbclient/RESTUtils.h"
 #include "flow/Arena.h"
 #include "flow/FastRef.h"
@@ -39,21 +40,30 @@ class RESTClient : public ReferenceCounted<RESTClient> {
 public:
 	struct Stats {
 		explicit Stats(const std::string& hService)
-		  : host_service(hService), requests_successful(0), requests_failed(0), bytes_sent(0) {}
+		  : host_service(hService), requests_successful(0), requests_failed(0), bytes_sent(0),
+		    connections_established(0), connections_reused(0) {}
 		Stats operator-(const Stats& rhs);
-		void clear() { requests_failed = requests_successful = bytes_sent = 0; }
+		void clear() {
+			requests_failed = requests_successful = bytes_sent = connections_established = connections_reused = 0;
+		}
 		json_spirit::mObject getJSON();
 
 		std::string host_service;
 		int64_t requests_successful;
 		int64_t requests_failed;
 		int64_t bytes_sent;
+		int64_t connections_established;
+		int64_t connections_reused;
 	};
 
 	RESTClientKnobs knobs;
+	// Keep-alive connections shared by all the requests of this client, per "host:service"
 	Reference<RESTConnectionPool> conectionPool;
 	// Connection stats maintained per "host:service"
 	std::unordered_map<std::string, std::unique_ptr<Stats>> statsMap;
+	// Latency of requests, including connecting and retries. Created on the first request, so that clients which
+	// never send one log nothing.
+	std::unique_ptr<LatencySample> requestLatency;
 
 	RESTClient();
 	explicit RESTClient(std::unordered_map<std::string, int>& params);
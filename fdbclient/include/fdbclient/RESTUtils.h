@@ -54,8 +54,12 @@ public:
 	RESTConnectionPool(const int maxConnsPerKey) : maxConnPerConnectKey(maxConnsPerKey) {}
 
 	// Routine is responsible to provide an usable TCP connection object; it reuses an active connection from
-	// connection-pool if availalbe, otherwise, establish a new TCP connection
-	Future<ReusableConnection> connect(RESTConnectionPoolKey connectKey, const bool isSecure, const int maxConnLife);
+	// connection-pool if availalbe, otherwise, establish a new TCP connection. Sets reusingConn to whether the
+	// connection came from the pool.
+	Future<ReusableConnection> connect(RESTConnectionPoolKey connectKey,
+	                                   const bool isSecure,
+	                                   const int maxConnLife,
+	                                   bool* reusingConn);
 	void returnConnection(RESTConnectionPoolKey connectKey, ReusableConnection& conn, const int maxConnections);
 
 	static RESTConnectionPoolKey getConnectionPoolKey(const std::string& host, const std::string& service) {
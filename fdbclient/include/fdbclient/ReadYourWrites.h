@@ -46,6 +46,7 @@ struct ReadYourWritesTransactionOptions {
 	int maxRetries;
 	int snapshotRywEnabled;
 	bool bypassUnreadable : 1;
+	bool earlyConflictDetection : 1;
 
 	ReadYourWritesTransactionOptions() {}
 	explicit ReadYourWritesTransactionOptions(Transaction const& tr);
@@ -235,6 +236,7 @@ private:
 	int retries;
 	int64_t approximateSize;
 	Future<Void> timeoutActor;
+	Future<Void> earlyConflictActor;
 	double creationTime;
 	bool commitStarted;
 
@@ -252,6 +254,7 @@ private:
 	Optional<std::string> specialKeySpaceErrorMsg;
 
 	void resetTimeout();
+	void startEarlyConflictDetection();
 	void updateConflictMap(KeyRef const& key, WriteMap::iterator& it); // pre: it.segmentContains(key)
 	void updateConflictMap(
 	    KeyRangeRef const& keys,
@@ -94,6 +94,9 @@ public:
 		Counter expiredConnections;
 		Counter reusedConnections;
 		Counter fastRetries;
+		Counter partsUploaded;
+		Counter partBytesUploaded;
+		Counter parallelReadParts;
 
 		LatencySample requestLatency;
 
@@ -104,6 +107,8 @@ public:
 		    requestsSuccessful("RequestsSuccessful", cc), requestsFailed("RequestsFailed", cc),
 		    newConnections("NewConnections", cc), expiredConnections("ExpiredConnections", cc),
 		    reusedConnections("ReusedConnections", cc), fastRetries("FastRetries", cc),
+		    partsUploaded("PartsUploaded", cc), partBytesUploaded("PartBytesUploaded", cc),
+		    parallelReadParts("ParallelReadParts", cc),
 		    requestLatency("BlobStoreRequestLatency",
 		                   id,
 		                   CLIENT_KNOBS->BLOBSTORE_LATENCY_LOGGING_INTERVAL,
@@ -146,7 +151,8 @@ public:
 		    delete_requests_per_second, multipart_max_part_size, multipart_min_part_size, concurrent_requests,
 		    concurrent_uploads, concurrent_lists, concurrent_reads_per_file, concurrent_writes_per_file,
 		    enable_read_cache, read_block_size, read_ahead_blocks, read_cache_blocks_per_file,
-		    max_send_bytes_per_second, max_recv_bytes_per_second, sdk_auth, global_connection_pool;
+		    max_send_bytes_per_second, max_recv_bytes_per_second, sdk_auth, global_connection_pool,
+		    part_upload_seconds;
 		bool set(StringRef name, int value);
 		std::string getURLParameters() const;
 		static std::vector<std::string> getKnobDescriptions() {
@@ -182,7 +188,9 @@ public:
 				"USED).",
 				"sdk_auth (or sa)                      Use AWS SDK to resolve credentials. Only valid if "
 				"BUILD_AWS_BACKUP is enabled.",
-				"global_connection_pool (or gcp)       Enable shared connection pool between all blobstore instances."
+				"global_connection_pool (or gcp)       Enable shared connection pool between all blobstore instances.",
+				"part_upload_seconds (or pus)          Target seconds to upload each multipart upload part, used to "
+				"size parts from measured throughput. 0 keeps parts at the min part size."
 			};
 		}
 
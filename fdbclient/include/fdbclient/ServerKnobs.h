@@ -48,6 +48,8 @@ public:
 
 	// TLogs
 	bool PEEK_USING_STREAMING;
+	// Peeks across regions, from and of log routers, stream even without the above
+	bool LOG_ROUTER_PEEK_USING_STREAMING;
 	double TLOG_TIMEOUT; // tlog OR commit proxy failure - master's reaction time
 	double TLOG_SLOW_REJOIN_WARN_TIMEOUT_SECS; // Warns if a tlog takes too long to rejoin
 	double TLOG_STORAGE_MIN_UPDATE_INTERVAL;
@@ -76,18 +78,30 @@ public:
 	double PEEK_TRACKER_EXPIRATION_TIME;
 	int PARALLEL_GET_MORE_REQUESTS;
 	int MULTI_CURSOR_PRE_FETCH_LIMIT;
+	std::string TLOG_PUSH_COMPRESSION_FILTER; // Compression filter for the messages commit proxies push to TLogs
+	int64_t TLOG_PUSH_COMPRESSION_MIN_BYTES; // Pushes with fewer message bytes than this are sent uncompressed
 	int64_t MAX_QUEUE_COMMIT_BYTES;
+	double TLOG_GROUP_COMMIT_MAX_LINGER; // How long a disk queue commit may wait for more pushes to join it; 0 disables
 	int DESIRED_OUTSTANDING_MESSAGES;
 	double DESIRED_GET_MORE_DELAY;
 	int CONCURRENT_LOG_ROUTER_READS;
 	int LOG_ROUTER_PEEK_FROM_SATELLITES_PREFERRED; // 0==peek from primary, non-zero==peek from satellites
+	// Log routers choose among the primary and satellite TLogs holding their tag by measured ping latency and load
+	bool LOG_ROUTER_PEEK_USE_MEASURED_LATENCY;
+	double LOG_ROUTER_PEEK_SWITCH_LATENCY_RATIO; // switch away from the default TLog only if this much cheaper
+	double LOG_ROUTER_PEEK_OUTSTANDING_REPLY_COST; // seconds of latency charged per outstanding reply to a TLog
+	double LOG_ROUTER_PEEK_FAILED_CONNECT_COST; // seconds of latency charged to a TLog we are failing to connect to
+	double LOG_ROUTER_PEEK_FAILOVER_TIME; // a peek blocked this long makes the log router choose its TLog again
 	double DISK_QUEUE_ADAPTER_MIN_SWITCH_TIME;
 	double DISK_QUEUE_ADAPTER_MAX_SWITCH_TIME;
 	int64_t TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH;
+	int64_t TLOG_SPILLED_READ_CACHE_BYTES; // Capacity of the cache of disk queue entries read by peeks of spilled data
+	int64_t TLOG_SPILLED_READ_MAX_BATCH_BYTES; // Adjacent spilled entries are read together, up to this many bytes
 	int64_t DISK_QUEUE_FILE_EXTENSION_BYTES; // When we grow the disk queue, by how many bytes should it grow?
 	int64_t DISK_QUEUE_FILE_SHRINK_BYTES; // When we shrink the disk queue, by how many bytes should it shrink?
+	int64_t DISK_QUEUE_FILE_PREALLOCATE_BYTES; // Disk queue files are grown to at least this size when first extended
 	int64_t DISK_QUEUE_MAX_TRUNCATE_BYTES; // A truncate larger than this will cause the file to be replaced instead.
 	double TLOG_DEGRADED_DURATION;
 	int64_t MAX_CACHE_VERSIONS;
@@ -127,6 +141,9 @@ public:
 	                                 // relocations in the last minute exceeds DD_QUEUE_COUNTER_MAX_LOG
 	double RELOCATION_PARALLELISM_PER_SOURCE_SERVER;
 	double RELOCATION_PARALLELISM_PER_DEST_SERVER;
+	int64_t RELOCATION_INFLIGHT_BYTES_PER_DEST_SERVER; // Moves are not started to a server while this many bytes
+	                                                   // of moves of the same or higher priority are in flight to it
+	int64_t DD_REBALANCE_MAX_BYTES_PER_SECOND; // The rate at which disk and read rebalancing may move data
 	int DD_QUEUE_MAX_KEY_SERVERS;
 	int DD_REBALANCE_PARALLELISM;
 	int DD_REBALANCE_RESET_AMOUNT;
@@ -180,8 +197,13 @@ public:
 	int64_t SHARD_MAX_BYTES_PER_KSEC, // Shards with more than this bandwidth will be split immediately
 	    SHARD_MIN_BYTES_PER_KSEC, // Shards with more than this bandwidth will not be merged
 	    SHARD_SPLIT_BYTES_PER_KSEC; // When splitting a shard, it is split into pieces with less than this bandwidth
+	bool DD_WRITE_HOT_SHARD_DETECTION; // Split shards on their recent write bandwidth as well as its average
+	double DD_WRITE_HOT_SHARD_REACTION_TIME; // The window of the recent write bandwidth
 	double SHARD_MAX_READ_DENSITY_RATIO;
 	int64_t SHARD_READ_HOT_BANDWIDTH_MIN_PER_KSECONDS;
+	bool DD_CACHE_READ_HOT_RANGES; // Add read hot ranges to the storage cache, which needs storage cache processes
+	int64_t DD_CACHE_READ_HOT_MAX_BYTES; // Estimated bytes of read hot ranges cached at once
+	double DD_CACHE_READ_HOT_RANGE_TTL; // A cached range is removed when it has not been read hot for this long
 	double SHARD_MAX_BYTES_READ_PER_KSEC_JITTER;
 	double STORAGE_METRIC_TIMEOUT;
 	double METRIC_DELAY;
@@ -199,6 +221,10 @@ public:
 	int BEST_TEAM_MAX_TEAM_TRIES;
 	int BEST_TEAM_OPTION_COUNT;
 	int BEST_OF_AMT;
+	bool DD_LOAD_AWARE_TEAM_SELECTION; // Weigh the CPU, storage queue, durability lag and read bandwidth of servers
+	                                   // as well as their data when picking a team
+	double DD_LOAD_PRESSURE_WEIGHT; // A team with a saturated server counts as 1 + this times its load bytes
+	int64_t DD_STORAGE_READ_BANDWIDTH_CAPACITY_PER_KSEC; // The read bandwidth that saturates a storage server
 	double SERVER_LIST_DELAY;
 	double RECRUITMENT_IDLE_DELAY;
 	double STORAGE_RECRUITMENT_DELAY;
@@ -220,6 +246,12 @@ public:
 	int DD_MOVE_KEYS_PARALLELISM;
 	int DD_FETCH_SOURCE_PARALLELISM;
 	int DD_MERGE_LIMIT;
+	// While there are more shards than this, cold shards keep merging until they reach
+	// DD_AGGRESSIVE_MERGE_MAX_SHARD_RATIO of the maximum shard size, instead of the minimum. Merges that go past the
+	// minimum are limited to DD_AGGRESSIVE_MERGES_PER_SECOND.
+	int DD_AGGRESSIVE_MERGE_SHARD_COUNT;
+	double DD_AGGRESSIVE_MERGE_MAX_SHARD_RATIO;
+	double DD_AGGRESSIVE_MERGES_PER_SECOND;
 	double DD_SHARD_METRICS_TIMEOUT;
 	int64_t DD_LOCATION_CACHE_SIZE;
 	double MOVEKEYS_LOCK_POLLING_DELAY;
@@ -243,6 +275,8 @@ public:
 	int64_t
 	    DD_STORAGE_WIGGLE_MIN_SS_AGE_SEC; // Minimal age of a correct-configured server before it's chosen to be wiggled
 	bool DD_TENANT_AWARENESS_ENABLED;
+	int64_t DD_TENANT_COLOCATION_MAX_BYTES; // Shards of up to this many bytes may hold several tenants, and new tenants
+	                                        // are not split into shards of their own. 0 keeps every tenant apart.
 	bool STORAGE_QUOTA_ENABLED; // Whether storage quota enforcement for tenant groups and all the relevant storage
 	                            // usage / quota monitors are enabled.
 	int TENANT_CACHE_LIST_REFRESH_INTERVAL; // How often the TenantCache is refreshed
@@ -271,6 +305,8 @@ public:
 	double DD_FAILURE_TIME;
 	double DD_ZERO_HEALTHY_TEAM_DELAY;
 	int DD_BUILD_EXTRA_TEAMS_OVERRIDE; // build extra teams to allow data movement to progress. must be larger than 0
+	bool DD_INCREMENTAL_TEAM_BUILDING; // Index the candidate servers and machines by their team counts once per team
+	                                   // building pass, instead of scanning all of them for every team added
 
 	// Run storage enginee on a child process on the same machine with storage process
 	bool REMOTE_KV_STORE;
@@ -299,6 +335,7 @@ public:
 	int SQLITE_CHUNK_SIZE_PAGES;
 	int SQLITE_CHUNK_SIZE_PAGES_SIM;
 	int SQLITE_READER_THREADS;
+	int SQLITE_READER_CACHE_PAGES; // SQLite's private page cache size for each reader connection; 0 keeps the default
 	int SQLITE_WRITE_WINDOW_LIMIT;
 	double SQLITE_WRITE_WINDOW_SECONDS;
 	int64_t SQLITE_CURSOR_MAX_LIFETIME_BYTES;
@@ -354,6 +391,8 @@ public:
 	bool ROCKSDB_READ_RANGE_REUSE_ITERATORS;
 	bool ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS;
 	int ROCKSDB_READ_RANGE_BOUNDED_ITERATORS_MAX_LIMIT;
+	int ROCKSDB_MULTIGET_MAX_KEYS; // Point reads issued together are batched into MultiGets of up to this many keys
+	bool ROCKSDB_MULTIGET_ASYNC_IO; // Only takes effect when RocksDB is built with coroutine support
 	int64_t ROCKSDB_WRITE_RATE_LIMITER_BYTES_PER_SEC;
 	bool ROCKSDB_WRITE_RATE_LIMITER_AUTO_TUNE;
 	std::string DEFAULT_FDB_ROCKSDB_COLUMN_FAMILY;
@@ -385,6 +424,14 @@ public:
 	int64_t ROCKSDB_MAX_BACKGROUND_JOBS;
 	int64_t ROCKSDB_DELETE_OBSOLETE_FILE_PERIOD;
 	double ROCKSDB_PHYSICAL_SHARD_CLEAN_UP_DELAY;
+	bool ROCKSDB_WRITE_BUFFER_MANAGER_CHARGE_CACHE; // Count memtables of all physical shards against the block cache
+	double ROCKSDB_MEMTABLE_GOVERNOR_INTERVAL; // How often sharded RocksDB checks memtable usage; 0 disables
+	double ROCKSDB_MEMTABLE_GOVERNOR_TARGET_RATIO; // Of ROCKSDB_WRITE_BUFFER_SIZE, above which cold shards are flushed
+	int64_t ROCKSDB_SHARD_MEMTABLE_SOFT_QUOTA; // Active memtable bytes a physical shard may hold; 0 for no quota
+	bool ROCKSDB_DELETE_FILES_ON_SHARD_CLEAR; // Unlink the SST files of a physical shard a clearRange empties
+	int ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER; // Range deletions that get a physical shard compacted; 0 disables
+	double ROCKSDB_RANGE_DELETES_COMPACTION_INTERVAL;
+	std::string ROCKSDB_SHARD_CF_POLICIES; // Column family options of new physical shards by key prefix
 
 	// Leader election
 	int MAX_NOTIFICATIONS;
@@ -404,6 +451,7 @@ public:
 	double START_TRANSACTION_BATCH_QUEUE_CHECK_INTERVAL;
 	double START_TRANSACTION_MAX_TRANSACTIONS_TO_START;
 	int START_TRANSACTION_MAX_REQUESTS_TO_START;
+	double START_TRANSACTION_MAX_READ_VERSION_STALENESS; // Max age of a cached read version given to bounded stale GRVs
 	double START_TRANSACTION_RATE_WINDOW;
 	double START_TRANSACTION_MAX_EMPTY_QUEUE_BUDGET;
 	int START_TRANSACTION_MAX_QUEUE_SIZE;
@@ -416,6 +464,9 @@ public:
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_MAX;
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
 	double COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA;
+	double COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY; // If positive, caps the batch interval to stay within this latency
+	double COMMIT_BATCH_INTERVAL_CONTROL_WINDOW; // Seconds of resolution and TLog latencies used for each adjustment
+	int COMMIT_BATCH_INTERVAL_CONTROL_MIN_SAMPLES; // Windows with fewer batches keep the previous interval cap
 	int COMMIT_TRANSACTION_BATCH_COUNT_MAX;
 	int COMMIT_TRANSACTION_BATCH_BYTES_MIN;
 	int COMMIT_TRANSACTION_BATCH_BYTES_MAX;
@@ -445,6 +496,10 @@ public:
 	double REPORT_TRANSACTION_COST_ESTIMATION_DELAY;
 	bool PROXY_REJECT_BATCH_QUEUED_TOO_LONG;
 	bool PROXY_USE_RESOLVER_PRIVATE_MUTATIONS;
+	bool PROXY_REUSE_MUTATION_ENCRYPT_CIPHERS; // Share one cipher context per encryption domain across a commit batch
+	double PROXY_KEY_INFO_INDEX_REBUILD_INTERVAL; // How often the key info index is rebuilt if stale, 0 disables it
+	int PROXY_KEY_INFO_INDEX_REBUILD_BATCH; // Ranges copied into the key info index between yields
+	int PROXY_KEY_INFO_INDEX_MAX_CHANGED_RANGES; // Changed ranges kept before the key info index is invalidated
 
 	int RESET_MASTER_BATCHES;
 	int RESET_RESOLVER_BATCHES;
@@ -459,6 +514,7 @@ public:
 	double COMMIT_SLEEP_TIME;
 	double MIN_BALANCE_TIME;
 	int64_t MIN_BALANCE_DIFFERENCE;
+	double RESOLUTION_BALANCE_MOVE_FRACTION; // Fraction of the load difference between two resolvers moved per round
 	double SECONDS_BEFORE_NO_FAILURE_DELAY;
 	int64_t MAX_TXS_SEND_MEMORY;
 	int64_t MAX_RECOVERY_VERSIONS;
@@ -475,11 +531,17 @@ public:
 	double SAMPLE_EXPIRATION_TIME;
 	double SAMPLE_POLL_TIME;
 	int64_t RESOLVER_STATE_MEMORY_LIMIT;
+	int CONFLICT_SET_WORKER_THREADS; // Extra threads used to resolve large batches, 0 to resolve on the network thread
+	int CONFLICT_SET_PARALLEL_MIN_RANGES; // Batches with fewer conflict ranges are not split across worker threads
+	bool RESOLVER_PIPELINE_CONFLICT_BATCHES; // Prepare a batch's conflict ranges before the previous version resolves
 
 	// Backup Worker
 	double BACKUP_TIMEOUT; // master's reaction time for backup failure
 	double BACKUP_NOOP_POP_DELAY;
 	int BACKUP_FILE_BLOCK_BYTES;
+	bool BACKUP_WORKER_GROUPED_LOG_FILES; // Write PARTITIONED_MLOG_GROUPED_VERSION log files
+	std::string BACKUP_WORKER_LOG_COMPRESSION_FILTER;
+	int BACKUP_WORKER_LOG_CHUNK_BYTES;
 	int64_t BACKUP_LOCK_BYTES;
 	double BACKUP_UPLOAD_DELAY;
 
@@ -514,6 +576,14 @@ public:
 	double FORCE_RECOVERY_CHECK_DELAY;
 	double RATEKEEPER_FAILURE_TIME;
 	double CONSISTENCYSCAN_FAILURE_TIME;
+	// Compare replicas by their checksums of each batch, reading the rows from one replica only
+	bool CONSISTENCY_SCAN_COMPARE_CHECKSUMS;
+	// How much faster than the configured rate the scan may read a team whose storage servers are idle. A team counts
+	// as busy, and gets the configured rate, once a server reaches CONSISTENCY_SCAN_BUSY_CPU_PERCENT or
+	// CONSISTENCY_SCAN_BUSY_STORAGE_QUEUE bytes of storage queue.
+	double CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER;
+	double CONSISTENCY_SCAN_BUSY_CPU_PERCENT;
+	int64_t CONSISTENCY_SCAN_BUSY_STORAGE_QUEUE;
 	double BLOB_MANAGER_FAILURE_TIME;
 	double BLOB_MIGRATOR_FAILURE_TIME;
 	double REPLACE_INTERFACE_DELAY;
@@ -577,6 +647,7 @@ public:
 	double REMOVE_RETRY_DELAY;
 	int MOVE_KEYS_KRM_LIMIT;
 	int MOVE_KEYS_KRM_LIMIT_BYTES; // This must be sufficiently larger than CLIENT_KNOBS->KEY_SIZE_LIMIT
+	int START_MOVE_KEYS_BATCH_SIZE; // Number of relocations whose startMoveKeys may share a transaction
 	                               // (fdbclient/Knobs.h) to ensure that at least two entries will be returned from an
 	                               // attempt to read a key range map
 	int MOVE_SHARD_KRM_ROW_LIMIT;
@@ -605,6 +676,13 @@ public:
 	double RATEKEEPER_MAX_RATE;
 	double RATEKEEPER_BATCH_MIN_RATE;
 	double RATEKEEPER_BATCH_MAX_RATE;
+	// Fraction of the default priority rate that grv proxies start batch priority transactions from first, when
+	// there are any, so that batch work is not starved by default priority work. It never exceeds the batch rate.
+	double RATEKEEPER_BATCH_RESERVED_FRACTION;
+	// How far ahead ratekeeper projects each storage queue from its smoothed input and drain rates, so that it
+	// throttles a growing queue before it reaches the target and releases a draining one early. 0 disables this.
+	double RATEKEEPER_QUEUE_PREDICTION_SECONDS;
+	double RATEKEEPER_QUEUE_PREDICTION_SECONDS_ROCKSDB; // Used instead for RocksDB storage engines
 
 	int64_t TARGET_BYTES_PER_STORAGE_SERVER;
 	int64_t SPRING_BYTES_STORAGE_SERVER;
@@ -628,6 +706,9 @@ public:
 	int64_t TARGET_BYTES_PER_TLOG_BATCH;
 	int64_t SPRING_BYTES_TLOG_BATCH;
 	int64_t TLOG_SPILL_THRESHOLD;
+	// Fraction of TLOG_SPILL_THRESHOLD above which spilling keeps pace with input
+	double TLOG_INCREMENTAL_SPILL_FRACTION;
+	int64_t TLOG_MAX_RECOVERY_REPLAY_BYTES; // Spill early so a TLog restart replays at most this much; 0 disables
 	int64_t TLOG_HARD_LIMIT_BYTES;
 	int64_t TLOG_RECOVER_MEMORY_LIMIT;
 	double TLOG_IGNORE_POP_AUTO_ENABLE_DELAY;
@@ -648,6 +729,13 @@ public:
 	// Limit to the number of throttling tags each storage server
 	// will track and send to the ratekeeper
 	int64_t SS_THROTTLE_TAGS_TRACKED;
+	// Storage servers also find the key prefixes of this length that untagged reads spend the most cost on, for
+	// status. The default matches the length of a tenant prefix. 0 disables this.
+	int SS_BUSY_KEY_PREFIX_LENGTH;
+	// Untagged reads are sampled with probability cost / SS_BUSY_KEY_PREFIX_SAMPLE_COST
+	double SS_BUSY_KEY_PREFIX_SAMPLE_COST;
+	// Number of key prefixes counted at once by the heavy hitters sketch
+	int SS_BUSY_KEY_PREFIXES_SKETCHED;
 	// Use global tag throttling strategy. i.e. throttle based on the cluster-wide
 	// throughput for tags and their associated quotas.
 	bool GLOBAL_TAG_THROTTLING;
@@ -665,6 +753,11 @@ public:
 	int64_t GLOBAL_TAG_THROTTLING_TAG_EXPIRE_AFTER;
 	// Maximum duration that a transaction can be tag throttled by proxy before being rejected
 	double PROXY_MAX_TAG_THROTTLE_DURATION;
+	// Also release throttled tags on grv proxies through a token bucket refilled at the rate from ratekeeper, which
+	// holds back bursts within a release window instead of letting them spend the smoothed rate's window
+	bool PROXY_TAG_TOKEN_BUCKET;
+	// Tokens a tag's bucket can hold, in seconds of its rate
+	double PROXY_TAG_TOKEN_BUCKET_BURST_SECONDS;
 	// Interval at which latency bands are logged for each tag on grv proxy
 	double GLOBAL_TAG_THROTTLING_PROXY_LOGGING_INTERVAL;
 	// When the measured tps for a tag gets too low, the denominator in the
@@ -747,12 +840,19 @@ public:
 	bool FETCH_USING_STREAMING;
 	bool FETCH_USING_BLOB;
 	int FETCH_BLOCK_BYTES;
+	// When above 1 and not streaming, fetchKeys reads this many sub-ranges of about FETCH_KEYS_PARALLEL_RANGE_BYTES
+	// each at a time
+	int FETCH_KEYS_PARALLEL_RANGES;
+	int64_t FETCH_KEYS_PARALLEL_RANGE_BYTES;
 	int FETCH_KEYS_PARALLELISM_BYTES;
 	int FETCH_KEYS_PARALLELISM;
 	int FETCH_KEYS_PARALLELISM_FULL;
 	int FETCH_KEYS_LOWER_PRIORITY;
 	int SERVE_FETCH_CHECKPOINT_PARALLELISM;
 	int SERVE_AUDIT_STORAGE_PARALLELISM;
+	// Whether audits compare checksums of ranges with the remote replica before comparing the rows themselves
+	bool AUDIT_STORAGE_COMPARE_CHECKSUMS;
+	int AUDIT_STORAGE_CHECKSUM_FANOUT; // The sub-ranges a differing range is split into for the next round of checksums
 	int BUGGIFY_BLOCK_BYTES;
 	int64_t STORAGE_RECOVERY_VERSION_LAG_LIMIT;
 	double STORAGE_DURABILITY_LAG_REJECT_THRESHOLD;
@@ -766,6 +866,7 @@ public:
 	int MAX_BYTE_SAMPLE_CLEAR_MAP_SIZE;
 	double LONG_BYTE_SAMPLE_RECOVERY_DELAY;
 	int BYTE_SAMPLE_LOAD_PARALLELISM;
+	int BYTE_SAMPLE_LOAD_CHUNKS; // Ranges the byte sample is read in, BYTE_SAMPLE_LOAD_PARALLELISM at a time
 	double BYTE_SAMPLE_LOAD_DELAY;
 	double BYTE_SAMPLE_START_DELAY;
 	double BEHIND_CHECK_DELAY;
@@ -776,12 +877,18 @@ public:
 	int64_t MIN_TAG_WRITE_PAGES_RATE;
 	double TAG_MEASUREMENT_INTERVAL;
 	bool PREFIX_COMPRESS_KVS_MEM_SNAPSHOTS;
+	int64_t KVS_MEM_SNAPSHOT_SLICE_BYTES; // The memory engine snapshot may yield after logging this many bytes
 	bool REPORT_DD_METRICS;
 	double DD_METRICS_REPORT_INTERVAL;
 	double FETCH_KEYS_TOO_LONG_TIME_CRITERIA;
 	double MAX_STORAGE_COMMIT_TIME;
 	int64_t RANGESTREAM_LIMIT_BYTES;
 	int64_t CHANGEFEEDSTREAM_LIMIT_BYTES;
+	// A change feed stream that has caught up waits, up to the max delay, for this many bytes of new mutations before
+	// replying, so that it sends fewer, larger replies. 0 replies as soon as there are any.
+	int64_t CHANGEFEEDSTREAM_COALESCE_MIN_BYTES;
+	double CHANGEFEEDSTREAM_COALESCE_MAX_DELAY;
+	bool CHANGE_FEED_DISK_READS_CACHE; // Whether feed reads from disk keep their pages in the storage engine's cache
 	int64_t BLOBWORKERSTATUSSTREAM_LIMIT_BYTES;
 	bool ENABLE_CLEAR_RANGE_EAGER_READS;
 	bool QUICK_GET_VALUE_FALLBACK;
@@ -789,14 +896,27 @@ public:
 	bool STRICTLY_ENFORCE_BYTE_LIMIT;
 	double FRACTION_INDEX_BYTELIMIT_PREFETCH;
 	int MAX_PARALLEL_QUICK_GET_VALUE;
+	int MAX_PARALLEL_QUICK_GET_VALUE_LIMIT; // The most a mapped range read can raise MAX_PARALLEL_QUICK_GET_VALUE to
 	int CHECKPOINT_TRANSFER_BLOCK_BYTES;
 	int QUICK_GET_KEY_VALUES_LIMIT;
 	int QUICK_GET_KEY_VALUES_LIMIT_BYTES;
+	// The most bytes a storage server reads for one GetRangeAggregateRequest before replying with a continuation
+	int RANGE_AGGREGATE_BYTES_LIMIT;
+	int RANGE_AGGREGATE_READ_BYTES; // The bytes read from the versioned data and the engine at a time for an aggregate
+	int RANGE_CHECKSUM_BYTES_LIMIT; // The most bytes a storage server reads for one GetRangeChecksumRequest
 	int STORAGE_FEED_QUERY_HARD_LIMIT;
 	std::string STORAGESERVER_READ_PRIORITIES;
 	int STORAGE_SERVER_READ_CONCURRENCY;
 	std::string STORAGESERVER_READTYPE_PRIORITY_MAP;
 	int SPLIT_METRICS_MAX_ROWS;
+	int64_t STORAGE_RANGE_CACHE_BYTES; // Capacity of the storage server's cache of engine range reads; 0 disables it
+	int64_t STORAGE_RANGE_CACHE_MAX_ENTRY_BYTES;
+	int64_t STORAGE_COMPRESS_RANGE_REPLY_MIN_BYTES; // Smallest range read reply compressed for clients that ask
+	int STORAGE_DEDUPLICATE_VALUE_MIN_BYTES; // Smallest set value the mutation log shares with an identical one
+	int STORAGE_DEDUPLICATE_VALUES_MAX; // Recent values remembered for sharing; 0 disables deduplication
+	double STORAGE_PINNED_SNAPSHOT_LEASE; // Seconds a pinned read version is kept after its last pin request or read
+	int STORAGE_MAX_PINNED_SNAPSHOTS; // Pinned and pending read versions a storage server keeps at once
+	int STORAGE_CLEARED_RANGES; // Cleared engine ranges remembered so reads can skip them; 0 disables it
 
 	// Wait Failure
 	int MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS;
@@ -861,6 +981,7 @@ public:
 	// Status
 	double STATUS_MIN_TIME_BETWEEN_REQUESTS;
 	double MAX_STATUS_REQUESTS_PER_SECOND;
+	double STATUS_CACHE_MAX_AGE; // Status requests within this many seconds of the last status are served from it
 	int CONFIGURATION_ROWS_TO_FETCH;
 	bool DISABLE_DUPLICATE_LOG_WARNING;
 	double HISTOGRAM_REPORT_INTERVAL;
@@ -876,6 +997,8 @@ public:
 	double FASTRESTORE_SAMPLING_PERCENT;
 	int64_t FASTRESTORE_NUM_LOADERS;
 	int64_t FASTRESTORE_NUM_APPLIERS;
+	// A version batch uses only as many appliers as give each at least this many sampled bytes; 0 uses all appliers
+	double FASTRESTORE_MIN_BYTES_PER_APPLIER;
 	// FASTRESTORE_TXN_BATCH_MAX_BYTES is target txn size used by appliers to apply mutations
 	double FASTRESTORE_TXN_BATCH_MAX_BYTES;
 	// FASTRESTORE_VERSIONBATCH_MAX_BYTES is the maximum data size in each version batch
@@ -927,6 +1050,7 @@ public:
 	int REDWOOD_DEFAULT_EXTENT_READ_SIZE; // Extent read size for Redwood files
 	int REDWOOD_EXTENT_CONCURRENT_READS; // Max number of simultaneous extent disk reads in progress.
 	bool REDWOOD_KVSTORE_RANGE_PREFETCH; // Whether to use range read prefetching
+	int REDWOOD_PREFETCH_MAX_COALESCED_PAGES; // Max physically adjacent pages a range read prefetch reads at once
 	double REDWOOD_PAGE_REBUILD_MAX_SLACK; // When rebuilding pages, max slack to allow in page before extending it
 	double REDWOOD_PAGE_REBUILD_SLACK_DISTRIBUTION; // When rebuilding pages, use this ratio of slack distribution
 	                                                // between the rightmost (new) page and the previous page. Defaults
@@ -945,11 +1069,29 @@ public:
 	                                            // remap cleanup
 	double REDWOOD_REMAP_CLEANUP_TOLERANCE_RATIO; // Maximum ratio of the remap cleanup window that remap cleanup is
 	                                              // allowed to be ahead or behind
+	int REDWOOD_REMAP_CLEANUP_MAX_CONCURRENCY; // Maximum remap cleanup copies in progress at once, which is lowered
+	                                           // while foreground reads are slow, 0 to not throttle remap cleanup
+	double REDWOOD_REMAP_CLEANUP_TARGET_READ_LATENCY; // Page read latency above which remap cleanup backs off
+	int REDWOOD_REMAP_CLEANUP_MAX_IO_WAITERS; // IO lock waiters above which remap cleanup backs off
+	double REDWOOD_REMAP_CLEANUP_THROTTLE_INTERVAL; // Seconds between adjustments of the remap cleanup limit
 	int REDWOOD_PAGEFILE_GROWTH_SIZE_PAGES; // Number of pages to grow page file by
 	double REDWOOD_METRICS_INTERVAL;
 	double REDWOOD_HISTOGRAM_INTERVAL;
+	std::string REDWOOD_PAGE_COMPRESSION_FILTER; // Compression applied to leaf pages as they are written
+	int REDWOOD_COMPRESSED_LEAF_BLOCKS; // Number of blocks leaf pages are built to fill before they are compressed
 	bool REDWOOD_EVICT_UPDATED_PAGES; // Whether to prioritize eviction of updated pages from cache.
+	double REDWOOD_PAGECACHE_PROTECTED_FRACTION; // Fraction of the page cache reserved for pages hit more than once, 0
+	                                             // for plain LRU eviction
 	int REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT; // Minimum height for which to keep and reuse page decode caches
+	int REDWOOD_PAGE_BUILD_THREADS; // Threads which build the pages written by commits, 0 to build them on the network
+	                                // thread
+	int64_t REDWOOD_LEAF_FILTER_CACHE_BYTES; // Memory for filters of recently written leaves, which let point reads of
+	                                         // absent keys skip the leaf, 0 to disable
+	int REDWOOD_LEAF_FILTER_BITS_PER_KEY; // Size of leaf filters, trading memory for fewer false positives
+	int64_t REDWOOD_SECONDARY_CACHE_BYTES; // Size of the secondary page cache file, 0 to disable
+	std::string REDWOOD_SECONDARY_CACHE_DIR; // Directory of the secondary page cache file, on a device faster than the
+	                                         // page file, or empty to use the page file's directory
+	int REDWOOD_SECONDARY_CACHE_MAX_WRITES; // Maximum concurrent writes of pages into the secondary page cache
 
 	std::string REDWOOD_IO_PRIORITIES;
 
@@ -1001,6 +1143,8 @@ public:
 	bool BG_ENABLE_READ_DRIVEN_COMPACTION;
 	int BG_RDC_BYTES_FACTOR;
 	int BG_RDC_READ_FACTOR;
+	double BG_COLD_GRANULE_SECONDS; // A granule that has not been read for this long writes larger delta files
+	int BG_COLD_DELTA_FILE_FACTOR; // How many times larger, up to the bytes before a re-snapshot
 	bool BG_WRITE_MULTIPART;
 	bool BG_ENABLE_DYNAMIC_WRITE_AMP;
 	double BG_DYNAMIC_WRITE_AMP_MIN_FACTOR;
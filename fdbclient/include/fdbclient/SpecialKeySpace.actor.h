@@ -144,8 +144,9 @@ public:
 		if (!(*cache)[kr.begin].present()) {
 			// For simplicity, every time we need to cache, we read the whole range
 			// Although sometimes the range can be narrowed,
-			// there is not a general way to do it in complicated scenarios
-			RangeResult result_ = wait(skrAyncImpl->getRange(ryw, skrAyncImpl->getKeyRange(), limits));
+			// there is not a general way to do it in complicated scenarios. The whole range is cached, so the limits
+			// of this read cannot be passed on.
+			RangeResult result_ = wait(skrAyncImpl->getRange(ryw, skrAyncImpl->getKeyRange(), GetRangeLimits()));
 			cache->insert(skrAyncImpl->getKeyRange(), result_);
 		}
 		const auto& allResults = (*cache)[kr.begin].get();
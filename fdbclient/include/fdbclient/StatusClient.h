@@ -28,7 +28,9 @@
 class StatusClient {
 public:
 	enum StatusLevel { MINIMAL = 0, NORMAL = 1, DETAILED = 2, JSON = 3 };
-	static Future<StatusObject> statusFetcher(Database db);
+	// If sections is not empty, only those top level fields of the cluster status are fetched, and the client status
+	// has no database_status
+	static Future<StatusObject> statusFetcher(Database db, std::vector<std::string> sections = {});
 };
 
 #endif
\ No newline at end of file
@@ -96,6 +96,10 @@ struct StorageServerInterface {
 
 	PublicRequestStream<struct GetValueRequest> getValue;
 	PublicRequestStream<struct GetKeyRequest> getKey;
+	// Reads a batch of keys at one version. Throws wrong_shard_server if any of the keys is not readable here.
+	PublicRequestStream<struct GetValuesRequest> getValues;
+	// Aggregates the values of a range within one shard. Throws wrong_shard_server if the range is not readable here.
+	PublicRequestStream<struct GetRangeAggregateRequest> getRangeAggregate;
 
 	// Throws a wrong_shard_server if the keys in the request or result depend on data outside this server OR if a large
 	// selector offset prevents all data from being read in one range read
@@ -123,6 +127,8 @@ struct StorageServerInterface {
 	RequestStream<struct FetchCheckpointKeyValuesRequest> fetchCheckpointKeyValues;
 	RequestStream<struct UpdateCommitCostRequest> updateCommitCostRequest;
 	RequestStream<struct AuditStorageRequest> auditStorage;
+	RequestStream<struct GetRangeChecksumRequest> getRangeChecksum;
+	PublicRequestStream<struct PinReadVersionRequest> pinReadVersion;
 
 private:
 	bool acceptingRequests;
@@ -198,6 +204,14 @@ public:
 				    RequestStream<struct UpdateCommitCostRequest>(getValue.getEndpoint().getAdjustedEndpoint(22));
 				auditStorage =
 				    RequestStream<struct AuditStorageRequest>(getValue.getEndpoint().getAdjustedEndpoint(23));
+				getValues =
+				    PublicRequestStream<struct GetValuesRequest>(getValue.getEndpoint().getAdjustedEndpoint(24));
+				getRangeAggregate = PublicRequestStream<struct GetRangeAggregateRequest>(
+				    getValue.getEndpoint().getAdjustedEndpoint(25));
+				getRangeChecksum =
+				    RequestStream<struct GetRangeChecksumRequest>(getValue.getEndpoint().getAdjustedEndpoint(26));
+				pinReadVersion =
+				    PublicRequestStream<struct PinReadVersionRequest>(getValue.getEndpoint().getAdjustedEndpoint(27));
 			}
 		} else {
 			ASSERT(Ar::isDeserializing);
@@ -250,6 +264,10 @@ public:
 		streams.push_back(fetchCheckpointKeyValues.getReceiver());
 		streams.push_back(updateCommitCostRequest.getReceiver());
 		streams.push_back(auditStorage.getReceiver());
+		streams.push_back(getValues.getReceiver(TaskPriority::LoadBalancedEndpoint));
+		streams.push_back(getRangeAggregate.getReceiver(TaskPriority::LoadBalancedEndpoint));
+		streams.push_back(getRangeChecksum.getReceiver());
+		streams.push_back(pinReadVersion.getReceiver());
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -325,6 +343,117 @@ struct GetValueRequest : TimedRequest {
 	}
 };
 
+struct GetValuesReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 2519384;
+	std::vector<Optional<Value>> values; // In the order of the keys in the request
+	bool cached;
+
+	GetValuesReply() : cached(false) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, values, cached);
+	}
+};
+
+// Reads several keys at one version, so that a client reading keys served by the same storage servers pays for the
+// queueing, the version wait and the engine read once instead of once per key
+struct GetValuesRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 6341502;
+	SpanContext spanContext;
+	TenantInfo tenantInfo;
+	Arena arena;
+	VectorRef<KeyRef> keys;
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetValuesReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetValuesRequest() {}
+
+	bool verify() const { return tenantInfo.isAuthorized(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, tenantInfo, options, ssLatestCommitVersions, arena);
+	}
+};
+
+// Count, sum, min and max of the values in a key range. Values of at most 8 bytes are read as little-endian integers,
+// the encoding of the AddValue atomic op: values shorter than 8 bytes are zero extended and 8 byte values are signed.
+// Longer values are counted in rows but not in the other aggregates. The sum wraps around as AddValue does.
+struct RangeAggregate {
+	int64_t rows = 0;
+	int64_t integers = 0; // The rows whose value was read as an integer
+	int64_t sum = 0;
+	int64_t min = std::numeric_limits<int64_t>::max();
+	int64_t max = std::numeric_limits<int64_t>::min();
+
+	static Optional<int64_t> decodeInteger(ValueRef value);
+
+	void add(ValueRef value);
+	void add(const RangeAggregate& other);
+
+	bool operator==(const RangeAggregate& r) const {
+		return rows == r.rows && integers == r.integers && sum == r.sum && min == r.min && max == r.max;
+	}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, rows, integers, sum, min, max);
+	}
+};
+
+struct GetRangeAggregateReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 9204577;
+	RangeAggregate aggregate;
+	// Set when the storage server stopped before the end of the range. The aggregate covers the keys before
+	// readThrough, and the rest of the range has to be read with another request.
+	Optional<Key> readThrough;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, aggregate, readThrough);
+	}
+};
+
+// Aggregates the values of a range within one shard at one version on the storage server, so that counting or summing a
+// range does not send every row to the client. A storage server reads at most RANGE_AGGREGATE_BYTES_LIMIT bytes for one
+// request.
+struct GetRangeAggregateRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 3868261;
+	SpanContext spanContext;
+	TenantInfo tenantInfo;
+	Arena arena;
+	KeyRangeRef keys;
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetRangeAggregateReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetRangeAggregateRequest() {}
+	GetRangeAggregateRequest(SpanContext spanContext,
+	                         TenantInfo tenantInfo,
+	                         KeyRangeRef const& keys,
+	                         Version version,
+	                         Optional<TagSet> tags,
+	                         Optional<ReadOptions> options,
+	                         VersionVector latestCommitVersions)
+	  : spanContext(spanContext), tenantInfo(tenantInfo), keys(arena, keys), version(version), tags(tags),
+	    options(options), ssLatestCommitVersions(latestCommitVersions) {}
+
+	bool verify() const { return tenantInfo.isAuthorized(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, tenantInfo, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct WatchValueReply {
 	constexpr static FileIdentifier file_identifier = 3;
 
@@ -370,6 +499,39 @@ struct WatchValueRequest {
 	}
 };
 
+// Rows a storage server leaves out of a range read reply. A row is returned only if it meets every condition that is
+// set. Keys are compared without the tenant prefix.
+struct KeyValueFilterRef {
+	Optional<KeyRef> keySuffix;
+	Optional<ValueRef> valuePrefix;
+	int minValueSize = 0;
+	int maxValueSize = std::numeric_limits<int>::max();
+
+	KeyValueFilterRef() {}
+	KeyValueFilterRef(Arena& a, const KeyValueFilterRef& copyFrom)
+	  : minValueSize(copyFrom.minValueSize), maxValueSize(copyFrom.maxValueSize) {
+		if (copyFrom.keySuffix.present()) {
+			keySuffix = KeyRef(a, copyFrom.keySuffix.get());
+		}
+		if (copyFrom.valuePrefix.present()) {
+			valuePrefix = ValueRef(a, copyFrom.valuePrefix.get());
+		}
+	}
+
+	bool matches(KeyValueRef const& kv) const {
+		return kv.value.size() >= minValueSize && kv.value.size() <= maxValueSize &&
+		       (!keySuffix.present() || kv.key.endsWith(keySuffix.get())) &&
+		       (!valuePrefix.present() || kv.value.startsWith(valuePrefix.get()));
+	}
+
+	int expectedSize() const { return keySuffix.expectedSize() + valuePrefix.expectedSize(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keySuffix, valuePrefix, minValueSize, maxValueSize);
+	}
+};
+
 struct GetKeyValuesReply : public LoadBalancedReply {
 	constexpr static FileIdentifier file_identifier = 1783066;
 	Arena arena;
@@ -377,12 +539,130 @@ struct GetKeyValuesReply : public LoadBalancedReply {
 	Version version; // useful when latestVersion was requested
 	bool more;
 	bool cached = false;
+	// Set when the request had a filter, to the last key read whether or not it was returned. A read that continues
+	// the range starts past it, not past the last row in data.
+	Optional<KeyRef> lastScannedKey;
+	// Set instead of data when the request asked for checksumOnly, to keyValuesChecksum() of the rows read
+	Optional<uint64_t> checksum;
+	// Set instead of data when the request asked for compressReply and the rows were large enough to be worth it. See
+	// compressKeyValuesReply().
+	Optional<StringRef> compressedData;
 
 	GetKeyValuesReply() : version(invalidVersion), more(false), cached(false) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, version, more, cached, arena);
+		serializer(ar,
+		           LoadBalancedReply::penalty,
+		           LoadBalancedReply::error,
+		           data,
+		           version,
+		           more,
+		           cached,
+		           lastScannedKey,
+		           checksum,
+		           compressedData,
+		           arena);
+	}
+};
+
+// Replaces the rows of reply with their ZSTD compressed encoding if they are at least minBytes and compress smaller,
+// and returns the bytes saved. Does nothing and returns 0 otherwise, or when ZSTD is not supported.
+int64_t compressKeyValuesReply(GetKeyValuesReply& reply, int64_t minBytes);
+// Restores the rows of a reply compressed by compressKeyValuesReply(), and returns whether it was compressed
+bool decompressKeyValuesReply(GetKeyValuesReply& reply);
+
+template <>
+struct payload_arena_traits<GetKeyValuesReply> {
+	static Arena const* arena(GetKeyValuesReply const& reply) { return &reply.arena; }
+};
+
+// A GetKeyValuesReply deserialized without decoding its rows, for a receiver that forwards them or reads only some of
+// them. It has the same wire format as GetKeyValuesReply, and data points into arena.
+struct GetKeyValuesReplyView : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = GetKeyValuesReply::file_identifier;
+	Arena arena;
+	SerializedVectorRef<KeyValueRef> data;
+	Version version;
+	bool more;
+	bool cached = false;
+	Optional<KeyRef> lastScannedKey;
+	Optional<uint64_t> checksum;
+	Optional<StringRef> compressedData;
+
+	GetKeyValuesReplyView() : version(invalidVersion), more(false), cached(false) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar,
+		           LoadBalancedReply::penalty,
+		           LoadBalancedReply::error,
+		           data,
+		           version,
+		           more,
+		           cached,
+		           lastScannedKey,
+		           checksum,
+		           compressedData,
+		           arena);
+	}
+};
+
+// An order dependent checksum of the keys and values of a range read, for comparing replicas without transferring them.
+// Rows read in several parts get the same checksum as when read at once by passing each part's checksum as the seed of
+// the next.
+uint64_t keyValuesChecksum(VectorRef<KeyValueRef, VecSerStrategy::String> const& data, uint64_t seed = 0);
+
+struct GetRangeChecksumReply {
+	constexpr static FileIdentifier file_identifier = 6114872;
+	// keyValuesChecksum() of the rows of each sub-range, in order. It is shorter than the number of sub-ranges when the
+	// storage server stopped at RANGE_CHECKSUM_BYTES_LIMIT, and the remaining sub-ranges have to be asked for again.
+	std::vector<uint64_t> checksums;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, checksums);
+	}
+};
+
+// Checksums a range within one shard at one version, split at boundaries into sub-ranges that each get a checksum. A
+// replica compares them with the checksums of its own rows, and narrows a difference down by asking again for the
+// sub-range that differs split more finely, so that audits only transfer the rows that differ.
+struct GetRangeChecksumRequest {
+	constexpr static FileIdentifier file_identifier = 2980337;
+	Arena arena;
+	KeyRangeRef range;
+	VectorRef<KeyRef> boundaries; // Sorted, and strictly within range
+	Version version;
+	ReplyPromise<GetRangeChecksumReply> reply;
+
+	GetRangeChecksumRequest() {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, range, boundaries, version, reply, arena);
+	}
+};
+
+// Asks a storage server to keep serving reads at a read version after it falls out of the MVCC window, by pinning a
+// snapshot of its storage engine taken when exactly that version is durable. The reply is sent once the snapshot is
+// pinned. Each pin request and each read served from the snapshot extends its lease by STORAGE_PINNED_SNAPSHOT_LEASE
+// seconds. Throws transaction_too_old if a later version is already durable, unsupported_operation if the storage
+// engine cannot pin snapshots, and operation_failed if the server already keeps STORAGE_MAX_PINNED_SNAPSHOTS.
+struct PinReadVersionRequest {
+	constexpr static FileIdentifier file_identifier = 5209384;
+	TenantInfo tenantInfo;
+	Version version;
+	ReplyPromise<Void> reply;
+
+	PinReadVersionRequest() {}
+	PinReadVersionRequest(TenantInfo tenantInfo, Version version) : tenantInfo(tenantInfo), version(version) {}
+
+	bool verify() const { return tenantInfo.isAuthorized(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, tenantInfo, version, reply);
 	}
 };
 
@@ -403,6 +683,12 @@ struct GetKeyValuesRequest : TimedRequest {
 	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key
+	// Rows that do not match are read, and count toward limit, limitBytes and the read cost, but are not returned
+	Optional<KeyValueFilterRef> filter;
+	// Reply with the checksum of the rows read, and the last key read in lastScannedKey, instead of the rows
+	bool checksumOnly = false;
+	// Allow the storage server to compress large replies, see GetKeyValuesReply::compressedData
+	bool compressReply = false;
 
 	GetKeyValuesRequest() {}
 
@@ -422,6 +708,9 @@ struct GetKeyValuesRequest : TimedRequest {
 		           tenantInfo,
 		           options,
 		           ssLatestCommitVersions,
+		           filter,
+		           checksumOnly,
+		           compressReply,
 		           arena);
 	}
 };
@@ -460,6 +749,9 @@ struct GetMappedKeyValuesRequest : TimedRequest {
 	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key range
+	// The most secondary lookups the storage server runs at once, up to MAX_PARALLEL_QUICK_GET_VALUE_LIMIT. When not
+	// set, MAX_PARALLEL_QUICK_GET_VALUE is used.
+	Optional<int> maxParallelLookups;
 
 	GetMappedKeyValuesRequest() {}
 
@@ -481,6 +773,7 @@ struct GetMappedKeyValuesRequest : TimedRequest {
 		           options,
 		           ssLatestCommitVersions,
 		           matchIndex,
+		           maxParallelLookups,
 		           arena);
 	}
 };
@@ -1199,6 +1492,16 @@ struct StorageQueuingMetricsRequest {
 	}
 };
 
+// Sampling of the most common reads when duplicating them to a TSS, see TSS_sampleRate()
+template <>
+double TSS_sampleRate(const GetValueRequest& req);
+template <>
+double TSS_sampleRate(const GetKeyRequest& req);
+template <>
+double TSS_sampleRate(const GetKeyValuesRequest& req);
+template <>
+double TSS_sampleRate(const GetMappedKeyValuesRequest& req);
+
 // Memory size for storing mutation in the mutation log and the versioned map.
 inline int mvccStorageBytes(int mutationBytes) {
 	// Why * 2:
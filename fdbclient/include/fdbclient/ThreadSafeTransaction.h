@@ -76,6 +76,7 @@ public:
 
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
+	ThreadFuture<Standalone<StringRef>> getClientMetrics() override;
 
 private:
 	friend class ThreadSafeTenant;
@@ -93,6 +93,8 @@ struct Tuple {
 	StringRef subTupleRawString(size_t index) const;
 	ElementType getType(size_t index) const;
 	Standalone<StringRef> getString(size_t index) const;
+	// Decodes the string into arena, so that many can share one without a Standalone each
+	StringRef getString(size_t index, Arena& arena) const;
 	TupleVersionstamp getVersionstamp(size_t index) const;
 	int64_t getInt(size_t index, bool allow_incomplete = false) const;
 	bool getBool(size_t index) const;
@@ -60,6 +60,23 @@ struct PTree : public ReferenceCounted<PTree<T>>, FastAllocated<PTree<T>>, NonCo
 	Reference<PTree> left(Version at) const { return child(false, at); }
 	Reference<PTree> right(Version at) const { return child(true, at); }
 
+	// Like child(), but without taking a reference, for read-only traversals that hold the root
+	PTree const* childPtr(bool which, Version at) const {
+		if (updated && lastUpdateVersion <= at && which == replacedPointer)
+			return pointer[2].getPtr();
+		else
+			return pointer[which].getPtr();
+	}
+
+	// Starts loading every child this node may have at some version, so that the next step of a search does not
+	// stall on a cache miss once the comparison against this node is done
+	void prefetchChildren() const {
+		for (int i = 0; i < 3; i++) {
+			if (pointer[i])
+				_mm_prefetch((const char*)pointer[i].getPtr(), _MM_HINT_T0);
+		}
+	}
+
 	PTree(const T& data, Version ver) : lastUpdateVersion(ver), updated(false), data(data) {
 		priority = deterministicRandom()->randomUInt32();
 	}
@@ -172,42 +189,45 @@ static Reference<PTree<T>> update(Reference<PTree<T>> const& node,
 	}
 }
 
+// Searches walk raw pointers: the caller's root keeps the whole tree at version at alive, and taking a reference on
+// every node visited would write to each node's cache line.
 template <class T, class X>
-bool contains(const Reference<PTree<T>>& p, Version at, const X& x) {
-	if (!p)
-		return false;
-	int cmp = compare(x, p->data);
-	bool less = cmp < 0;
-	if (cmp == 0)
-		return true;
-	return contains(p->child(!less, at), at, x);
+bool contains(const Reference<PTree<T>>& root, Version at, const X& x) {
+	for (PTree<T> const* p = root.getPtr(); p;) {
+		p->prefetchChildren();
+		int cmp = compare(x, p->data);
+		if (cmp == 0)
+			return true;
+		p = p->childPtr(!(cmp < 0), at);
+	}
+	return false;
 }
 
 // TODO: Remove the number of invocations of operator<, and replace with something closer to memcmp.
 // and same for upper_bound.
 template <class T, class X>
-void lower_bound(const Reference<PTree<T>>& p, Version at, const X& x, PTreeFinger<T>& f) {
-	if (!p) {
-		f.trim_to_bound();
-		return;
+void lower_bound(const Reference<PTree<T>>& root, Version at, const X& x, PTreeFinger<T>& f) {
+	for (PTree<T> const* p = root.getPtr(); p;) {
+		p->prefetchChildren();
+		int cmp = compare(x, p->data);
+		bool less = cmp < 0;
+		f.push_for_bound(p, less);
+		if (cmp == 0)
+			return;
+		p = p->childPtr(!less, at);
 	}
-	int cmp = compare(x, p->data);
-	bool less = cmp < 0;
-	f.push_for_bound(p.getPtr(), less);
-	if (cmp == 0)
-		return;
-	lower_bound(p->child(!less, at), at, x, f);
+	f.trim_to_bound();
 }
 
 template <class T, class X>
-void upper_bound(const Reference<PTree<T>>& p, Version at, const X& x, PTreeFinger<T>& f) {
-	if (!p) {
-		f.trim_to_bound();
-		return;
-	}
-	bool less = x < p->data;
-	f.push_for_bound(p.getPtr(), less);
-	upper_bound(p->child(!less, at), at, x, f);
+void upper_bound(const Reference<PTree<T>>& root, Version at, const X& x, PTreeFinger<T>& f) {
+	for (PTree<T> const* p = root.getPtr(); p;) {
+		p->prefetchChildren();
+		bool less = x < p->data;
+		f.push_for_bound(p, less);
+		p = p->childPtr(!less, at);
+	}
+	f.trim_to_bound();
 }
 
 template <class T, bool forward>
@@ -215,17 +235,17 @@ void move(Version at, PTreeFinger<T>& f) {
 	ASSERT(f.size());
 	const PTree<T>* n;
 	n = f.back();
-	if (n->child(forward, at)) {
-		n = n->child(forward, at).getPtr();
+	if (n->childPtr(forward, at)) {
+		n = n->childPtr(forward, at);
 		do {
 			f.push_back(n);
-			n = n->child(!forward, at).getPtr();
+			n = n->childPtr(!forward, at);
 		} while (n);
 	} else {
 		do {
 			n = f.back();
 			f.pop_back();
-		} while (f.size() && f.back()->child(forward, at).getPtr() == n);
+		} while (f.size() && f.back()->childPtr(forward, at) == n);
 	}
 }
 
@@ -236,11 +256,11 @@ int halfMove(Version at, PTreeFinger<T>& f) {
 	ASSERT(f.size());
 	const PTree<T>* n;
 	n = f.back();
-	if (n->child(forward, at)) {
-		n = n->child(forward, at).getPtr();
+	if (n->childPtr(forward, at)) {
+		n = n->childPtr(forward, at);
 		do {
 			f.push_back(n);
-			n = n->child(!forward, at).getPtr();
+			n = n->childPtr(!forward, at);
 		} while (n);
 		return f.size();
 	} else {
@@ -248,7 +268,7 @@ int halfMove(Version at, PTreeFinger<T>& f) {
 		do {
 			n = f[s - 1];
 			--s;
-		} while (s && f[s - 1]->child(forward, at).getPtr() == n);
+		} while (s && f[s - 1]->childPtr(forward, at) == n);
 		return s;
 	}
 }
@@ -318,11 +338,10 @@ Reference<PTree<T>> lastNode(const Reference<PTree<T>>& p, Version at) {
 }
 
 template <class T, bool last>
-void firstOrLastFinger(const Reference<PTree<T>>& p, Version at, PTreeFinger<T>& f) {
-	if (!p)
-		return;
-	f.push_back(p.getPtr());
-	firstOrLastFinger<T, last>(p->child(last, at), at, f);
+void firstOrLastFinger(const Reference<PTree<T>>& root, Version at, PTreeFinger<T>& f) {
+	for (PTree<T> const* p = root.getPtr(); p; p = p->childPtr(last, at)) {
+		f.push_back(p);
+	}
 }
 
 template <class T>
@@ -663,6 +682,10 @@ private:
 // VersionedMap provides an interface to a partially persistent tree, allowing you to read the values at a particular
 // version, create new versions, modify the current version of the tree, and forget versions prior to a specific
 // version.
+//
+// Old versions are not immutable in memory, so a VersionedMap must only be used from one thread, readers included.
+// Nodes are reference counted without atomics. Writes at the latest version update nodes shared with older versions in
+// place (see update() and compact()), and nodes come from the thread local FastAllocator.
 template <class K, class T>
 class VersionedMap : NonCopyable {
 	// private:
@@ -0,0 +1,68 @@
+/*
+ * VersionedReadCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_VERSIONED_READ_CACHE_H
+#define FDBCLIENT_VERSIONED_READ_CACHE_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+#include <map>
+#include <unordered_map>
+
+// Values read by the transactions of a database, kept by the version they were read at. The value of a key at a
+// version never changes, so a later transaction reading at the same version (one that shares a pooled or cached read
+// version, or that set its version) can use it without asking a storage server, and without any effect on its
+// conflict checking.
+//
+// A value is never served at any other version: nothing tells a client that a key has not changed between two
+// versions. Watches fire some time after a change has been made, so an outstanding one does not prove it.
+//
+// The cache holds up to capacity bytes of keys and values, dropping the oldest versions first.
+class VersionedReadCache {
+public:
+	// A capacity of 0 disables the cache and clears it
+	void setCapacity(int64_t bytes);
+	bool enabled() const { return capacity > 0; }
+
+	// Returns the value key had at version if a read of it at that version was cached; otherwise an empty Optional
+	Optional<Optional<Value>> get(Version version, KeyRef key) const;
+	void insert(Version version, KeyRef key, Optional<ValueRef> value);
+
+	int64_t bytes() const { return usedBytes; }
+
+private:
+	static int64_t entryBytes(KeyRef key, Optional<ValueRef> value) {
+		return key.size() + (value.present() ? value.get().size() : 0);
+	}
+
+	void evictOldestVersion();
+
+	int64_t capacity = 0;
+	int64_t usedBytes = 0;
+	// The reads at one version, with their keys and values copied into arena
+	struct VersionReads {
+		Arena arena;
+		std::unordered_map<KeyRef, Optional<ValueRef>> values;
+	};
+	std::map<Version, VersionReads> versions;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * WriteBatcher.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_WRITE_BATCHER_H
+#define FDBCLIENT_WRITE_BATCHER_H
+#pragma once
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "flow/ActorCollection.h"
+
+// Commits independent blind writes that are submitted within WRITE_BATCH_WINDOW of each other as one transaction, so
+// that a high rate of small writes costs a read version and a commit per batch instead of per write.
+//
+// The writes of a batch read nothing, so they cannot conflict with each other or with other transactions and are
+// committed together or not at all. Each write gets the outcome of its batch, except that a write that is invalid on
+// its own, such as one with a key that is too large, fails alone without affecting the rest of its batch. A batch is
+// retried on retryable errors, but commit_unknown_result is returned to the writers to decide on, since atomic
+// operations may not be safe to apply twice.
+class WriteBatcher : public ReferenceCounted<WriteBatcher>, NonCopyable {
+public:
+	explicit WriteBatcher(Database db);
+
+	// Commits mutations (sets, clears and atomic operations) with the other writes of its batch and returns the
+	// version they were committed at. Writes still pending when the WriteBatcher is destroyed fail with
+	// broken_promise.
+	Future<Version> write(Standalone<VectorRef<MutationRef>> mutations);
+
+	// Commits the pending writes now instead of at the end of their window
+	void flush();
+
+	struct PendingWrite {
+		Standalone<VectorRef<MutationRef>> mutations;
+		Promise<Version> committed;
+	};
+
+private:
+	Database db;
+	std::vector<PendingWrite> pending;
+	int64_t pendingBytes = 0;
+	// Counts the batches that have been flushed, so that a window's timer does not flush a later batch
+	uint64_t flushedBatches = 0;
+	bool windowStarted = false;
+	ActorCollection commits;
+};
+
+#endif
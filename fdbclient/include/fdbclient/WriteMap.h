@@ -119,24 +119,27 @@ inline bool operator<(const ExtStringRef& lhs, const WriteMapEntry& rhs) {
 	return lhs.compare(rhs.key) < 0;
 }
 
+// A WriteMap starts out with its entries in a sorted array, which is cheaper to search and update than the tree while
+// there are few of them, and moves them to the tree once there are more than flatLimit. Both are snapshots for the
+// iterators that read them: the tree is versioned, and the array is copied on write while an iterator shares it.
 class WriteMap {
 private:
 	typedef PTreeImpl::PTree<WriteMapEntry> PTreeT;
 	typedef PTreeImpl::PTreeFinger<WriteMapEntry> PTreeFingerT;
 	typedef Reference<PTreeT> Tree;
 
+	struct FlatEntries : ReferenceCounted<FlatEntries>, FastAllocated<FlatEntries> {
+		std::vector<WriteMapEntry> entries;
+	};
+	typedef Reference<FlatEntries> Flat;
+
 public:
-	explicit WriteMap(Arena* arena) : arena(arena), writeMapEmpty(true), ver(-1), scratch_iterator(this) {
-		PTreeImpl::insert(
-		    writes, ver, WriteMapEntry(allKeys.begin, OperationStack(), false, false, false, false, false));
-		PTreeImpl::insert(writes, ver, WriteMapEntry(allKeys.end, OperationStack(), false, false, false, false, false));
-		PTreeImpl::insert(
-		    writes, ver, WriteMapEntry(afterAllKeys, OperationStack(), false, false, false, false, false));
-	}
+	explicit WriteMap(Arena* arena);
+	WriteMap(Arena* arena, int flatLimit);
 
 	WriteMap(WriteMap&& r) noexcept
-	  : arena(r.arena), writeMapEmpty(r.writeMapEmpty), writes(std::move(r.writes)), ver(r.ver),
-	    scratch_iterator(std::move(r.scratch_iterator)) {}
+	  : arena(r.arena), writeMapEmpty(r.writeMapEmpty), writes(std::move(r.writes)), flat(std::move(r.flat)),
+	    flatLimit(r.flatLimit), ver(r.ver), scratch_iterator(std::move(r.scratch_iterator)) {}
 
 	WriteMap& operator=(WriteMap&& r) noexcept;
 
@@ -155,7 +158,9 @@ public:
 		// regardless of the snapshot value) Every key will belong to exactly one segment.  The first segment begins at
 		// "" and the last segment ends at \xff\xff.
 
-		explicit iterator(WriteMap* map) : tree(map->writes), at(map->ver), offset(false) { ++map->ver; }
+		explicit iterator(WriteMap* map) : tree(map->writes), flat(map->flat), at(map->ver), offset(false) {
+			++map->ver;
+		}
 		// Creates an iterator which is conceptually before the beginning of map (you may essentially only call skip()
 		// or ++ on it) This iterator also represents a snapshot (will be unaffected by future writes)
 
@@ -184,23 +189,34 @@ public:
 		iterator& operator++();
 		iterator& operator--();
 		bool operator==(const iterator& r) const {
+			if (flat) {
+				return offset == r.offset && flat == r.flat && index == r.index;
+			}
 			return offset == r.offset && beginLen == r.beginLen && finger[beginLen - 1] == r.finger[beginLen - 1];
 		}
 		void skip(KeyRef key);
 
 	private:
 		friend class WriteMap;
-		void reset(Tree const& tree, Version ver);
+		void reset(Tree const& tree, Flat const& flat, Version ver);
+		void clear() {
+			tree.clear();
+			flat.clear();
+		}
 
-		WriteMapEntry const& entry() const { return finger[beginLen - 1]->data; }
-		WriteMapEntry const& nextEntry() const { return finger[endLen - 1]->data; }
+		WriteMapEntry const& entry() const { return flat ? flat->entries[index] : finger[beginLen - 1]->data; }
+		WriteMapEntry const& nextEntry() const {
+			return flat ? flat->entries[index + 1] : finger[endLen - 1]->data;
+		}
 
 		bool keyAtBegin() { return !offset || !entry().stack.size(); }
 
 		Tree tree;
+		Flat flat;
 		Version at;
 		int beginLen, endLen;
 		PTreeFingerT finger;
+		int index; // of entry() in flat
 		bool offset; // false-> the operation stack at entry(); true-> the following cleared or unmodified range
 	};
 
@@ -215,6 +231,8 @@ private:
 	Arena* arena;
 	bool writeMapEmpty;
 	Tree writes;
+	Flat flat; // holds the entries instead of writes until there are more than flatLimit
+	int flatLimit;
 	// an internal version number for the tree - no connection to database versions!  Currently this is
 	// incremented after reads, so that consecutive writes have the same version and those separated by
 	// reads have different versions.
@@ -223,6 +241,11 @@ private:
 
 	void dump();
 
+	void insert(WriteMapEntry const& entry);
+	void remove(ExtStringRef key);
+	void remove(ExtStringRef begin, ExtStringRef end);
+	std::vector<WriteMapEntry>& mutableFlatEntries();
+
 	// SOMEDAY: clearNoConflict replaces cleared sets with two map entries for everyone one item cleared
 	void clearNoConflict(KeyRangeRef keys);
 };
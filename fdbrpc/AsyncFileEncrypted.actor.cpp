@@ -44,37 +44,60 @@ public:
 		return iv;
 	}
 
-	// Read a single block of size ENCRYPTION_BLOCK_SIZE bytes, and decrypt.
-	ACTOR static Future<Standalone<StringRef>> readBlock(AsyncFileEncrypted* self, uint32_t block) {
+	// Read the blocks [firstBlock, firstBlock + count) with a single read of the underlying file, and decrypt them with
+	// one cipher context. Blocks at or after the end of the file come back short or empty.
+	ACTOR static Future<std::vector<Standalone<StringRef>>> readBlocks(AsyncFileEncrypted* self,
+	                                                                   uint32_t firstBlock,
+	                                                                   int count) {
 		state Arena arena;
-		state unsigned char* encrypted = new (arena) unsigned char[FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE];
-		int bytes = wait(uncancellable(holdWhile(arena,
-		                                         self->file->read(encrypted,
-		                                                          FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE,
-		                                                          FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE * block))));
-		StreamCipherKey const* cipherKey = StreamCipherKey::getGlobalCipherKey();
-		DecryptionStreamCipher decryptor(cipherKey, self->getIV(block));
-		auto decrypted = decryptor.decrypt(encrypted, bytes, arena);
-		return Standalone<StringRef>(decrypted, arena);
+		state const int blockSize = FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE;
+		state unsigned char* encrypted = new (arena) unsigned char[blockSize * count];
+		int bytes = wait(uncancellable(
+		    holdWhile(arena, self->file->read(encrypted, blockSize * count, int64_t(blockSize) * firstBlock))));
+		std::vector<Standalone<StringRef>> blocks;
+		blocks.reserve(count);
+		DecryptionStreamCipher decryptor(StreamCipherKey::getGlobalCipherKey(), self->getIV(firstBlock));
+		for (int i = 0; i < count; ++i) {
+			if (i > 0) {
+				decryptor.reset(self->getIV(firstBlock + i));
+			}
+			// Each block gets its own arena so that the cache holds no more than the blocks it keeps
+			Standalone<StringRef> plaintext;
+			int blockBytes = std::clamp(bytes - i * blockSize, 0, blockSize);
+			plaintext.contents() = decryptor.decrypt(encrypted + i * blockSize, blockBytes, plaintext.arena());
+			blocks.push_back(plaintext);
+		}
+		return blocks;
 	}
 
 	ACTOR static Future<int> read(Reference<AsyncFileEncrypted> self, void* data, int length, int64_t offset) {
 		state const uint32_t firstBlock = offset / FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE;
 		state const uint32_t lastBlock = (offset + length - 1) / FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE;
-		state uint32_t block;
-		state unsigned char* output = reinterpret_cast<unsigned char*>(data);
-		state int bytesRead = 0;
+		state std::vector<Standalone<StringRef>> plaintexts(lastBlock - firstBlock + 1);
+		state int i = 0;
 		ASSERT(self->mode == AsyncFileEncrypted::Mode::READ_ONLY);
-		for (block = firstBlock; block <= lastBlock; ++block) {
-			state Standalone<StringRef> plaintext;
-
-			auto cachedBlock = self->readBuffers.get(block);
+		// Take the blocks that are cached, and read each run of blocks that are not with one I/O
+		while (i < plaintexts.size()) {
+			auto cachedBlock = self->readBuffers.get(firstBlock + i);
 			if (cachedBlock.present()) {
-				plaintext = cachedBlock.get();
-			} else {
-				wait(store(plaintext, readBlock(self.getPtr(), block)));
-				self->readBuffers.insert(block, plaintext);
+				plaintexts[i++] = cachedBlock.get();
+				continue;
+			}
+			int runEnd = i + 1;
+			while (runEnd < plaintexts.size() && !self->readBuffers.get(firstBlock + runEnd).present()) {
+				++runEnd;
 			}
+			std::vector<Standalone<StringRef>> blocks = wait(readBlocks(self.getPtr(), firstBlock + i, runEnd - i));
+			for (auto const& block : blocks) {
+				self->readBuffers.insert(firstBlock + i, block);
+				plaintexts[i++] = block;
+			}
+		}
+
+		unsigned char* output = reinterpret_cast<unsigned char*>(data);
+		int bytesRead = 0;
+		for (uint32_t block = firstBlock; block <= lastBlock; ++block) {
+			Standalone<StringRef> const& plaintext = plaintexts[block - firstBlock];
 			auto start = (block == firstBlock) ? plaintext.begin() + (offset % FLOW_KNOBS->ENCRYPTION_BLOCK_SIZE)
 			                                   : plaintext.begin();
 			auto end = (block == lastBlock)
@@ -117,8 +140,7 @@ public:
 				self->offsetInBlock = 0;
 				ASSERT_LT(self->currentBlock, std::numeric_limits<uint32_t>::max());
 				++self->currentBlock;
-				self->encryptor = std::make_unique<EncryptionStreamCipher>(StreamCipherKey::getGlobalCipherKey(),
-				                                                           self->getIV(self->currentBlock));
+				self->encryptor->reset(self->getIV(self->currentBlock));
 			}
 		}
 		return Void();
@@ -289,5 +311,10 @@ TEST_CASE("fdbrpc/AsyncFileEncrypted") {
 		bytesRead += bytesReadInChunk;
 	}
 	ASSERT(writeBuffer == readBuffer);
+	// Most of the blocks have been evicted from the decrypted block cache by now, so this reads runs of them at once
+	std::fill(readBuffer.begin(), readBuffer.end(), 0);
+	int wholeFileBytes = wait(file->read(readBuffer.data(), bytes, 0));
+	ASSERT_EQ(wholeFileBytes, bytes);
+	ASSERT(writeBuffer == readBuffer);
 	return Void();
 }
@@ -37,10 +37,20 @@
 #include "fdbrpc/AsyncFileEncrypted.h"
 #include "fdbrpc/AsyncFileWinASIO.actor.h"
 #include "fdbrpc/AsyncFileKAIO.actor.h"
+#include "fdbrpc/AsyncFileIOUring.actor.h"
 #include "flow/AsioReactor.h"
 #include "flow/Platform.h"
 #include "fdbrpc/AsyncFileWriteChecker.h"
 
+#if defined(__linux__) && defined(IO_URING_SUPPORTED)
+// Submits the requests queued by both Kernel AIO and io_uring files once per run loop iteration
+static void launchAsyncFileIO() {
+	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
+		AsyncFileKAIO::launch();
+	AsyncFileIOUring::launch();
+}
+#endif
+
 // Opens a file for asynchronous I/O
 Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& filename, int64_t flags, int64_t mode) {
 #ifdef __linux__
@@ -62,6 +72,13 @@ Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& file
 
 	Future<Reference<IAsyncFile>> f;
 #ifdef __linux__
+#ifdef IO_URING_SUPPORTED
+	// Files that ask for io_uring use it when the ring could be set up, and otherwise fall back to Kernel AIO
+	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && (flags & IAsyncFile::OPEN_IO_URING) &&
+	    !(flags & IAsyncFile::OPEN_NO_AIO) && AsyncFileIOUring::isEnabled())
+		f = AsyncFileIOUring::open(filename, flags, mode, nullptr);
+	else
+#endif
 	// In the vast majority of cases, we wish to use Kernel AIO. However, some systems
 	// don’t properly support kernel async I/O without O_DIRECT or AIO at all. In such
 	// cases, DISABLE_POSIX_KERNEL_AIO knob can be enabled to fallback to EIO instead
@@ -115,6 +132,13 @@ Net2FileSystem::Net2FileSystem(double ioTimeout, const std::string& fileSystemPa
 #ifdef __linux__
 	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
 		AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+#ifdef IO_URING_SUPPORTED
+	if (FLOW_KNOBS->ENABLE_IO_URING) {
+		AsyncFileIOUring::init(Reference<IEventFD>(N2::ASIOReactor::getIOUringEventFD()), ioTimeout);
+		if (AsyncFileIOUring::isEnabled())
+			g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&launchAsyncFileIO);
+	}
+#endif
 
 	if (fileSystemPath.empty()) {
 		checkFileSystem = false;
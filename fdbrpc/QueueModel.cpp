@@ -20,6 +20,7 @@
 
 #include "fdbrpc/QueueModel.h"
 #include "fdbrpc/LoadBalance.h"
+#include "flow/UnitTest.h"
 
 void QueueModel::endRequest(uint64_t id, double latency, double penalty, double delta, bool clean, bool futureVersion) {
 	auto& d = data[id];
@@ -29,6 +30,9 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 
 	if (clean) {
 		d.latency = latency;
+		if (FLOW_KNOBS->LOAD_BALANCE_HEDGING) {
+			addHedgeSample(d, latency);
+		}
 	} else {
 		d.latency = std::max(d.latency, latency);
 	}
@@ -50,6 +54,18 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 	}
 }
 
+void QueueModel::addHedgeSample(QueueData& d, double latency) {
+	if (!d.recentLatencies) {
+		// Hedge delays only need to be roughly right, and a coarse sketch keeps each server's small
+		d.recentLatencies = std::make_unique<DDSketch<double>>(0.05);
+	}
+	d.recentLatencies->addSample(latency);
+	if (d.recentLatencies->getPopulationSize() >= (uint64_t)FLOW_KNOBS->LOAD_BALANCE_HEDGE_WINDOW) {
+		d.hedgeDelay = d.recentLatencies->percentile(FLOW_KNOBS->LOAD_BALANCE_HEDGE_QUANTILE);
+		d.recentLatencies->clear();
+	}
+}
+
 QueueData const& QueueModel::getMeasurement(uint64_t id) {
 	return data[id]; // return smoothed penalty
 }
@@ -90,6 +106,26 @@ Optional<BasicLoadBalancedReply> getBasicLoadBalancedReply(const void*) {
 	return Optional<BasicLoadBalancedReply>();
 }
 
+TEST_CASE("/fdbrpc/QueueModel/hedgeDelay") {
+	QueueData d;
+	int window = FLOW_KNOBS->LOAD_BALANCE_HEDGE_WINDOW;
+	for (int i = 0; i < window - 1; i++) {
+		QueueModel::addHedgeSample(d, 0.001);
+	}
+	ASSERT_EQ(d.hedgeDelay, 0);
+
+	QueueModel::addHedgeSample(d, 0.001);
+	ASSERT(d.hedgeDelay > 0.0009 && d.hedgeDelay < 0.0011);
+	ASSERT_EQ(d.recentLatencies->getPopulationSize(), 0);
+
+	// Only the latest window counts
+	for (int i = 0; i < window; i++) {
+		QueueModel::addHedgeSample(d, 0.1);
+	}
+	ASSERT(d.hedgeDelay > 0.09 && d.hedgeDelay < 0.11);
+	return Void();
+}
+
 /*
 void QueueModel::addMeasurement( uint64_t id, QueueDetails qd ){
     if (data[new_index].count(id))
@@ -42,36 +42,42 @@ namespace bi = boost::intrusive;
 struct EvictablePage {
 	void* data;
 	int index;
+	bool referenced; // set by hits and cleared as the clock hand passes
 	class Reference<struct EvictablePageCache> pageCache;
 	bi::list_member_hook<> member_hook;
 
 	virtual bool evict() = 0; // true if page was evicted, false if it isn't immediately evictable (but will be evicted
 	                          // regardless if possible)
 
-	EvictablePage(Reference<EvictablePageCache> pageCache) : data(0), index(-1), pageCache(pageCache) {}
+	EvictablePage(Reference<EvictablePageCache> pageCache)
+	  : data(0), index(-1), referenced(false), pageCache(pageCache) {}
 	virtual ~EvictablePage();
 };
 
 struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	using List =
 	    bi::list<EvictablePage, bi::member_hook<EvictablePage, bi::list_member_hook<>, &EvictablePage::member_hook>>;
-	enum CacheEvictionType { RANDOM = 0, LRU = 1 };
+	// CLOCK keeps pages in the same vector as RANDOM and gives every page that was hit since the hand last passed it a
+	// second chance, which approximates LRU without relinking a list node on every hit
+	enum CacheEvictionType { RANDOM = 0, LRU = 1, CLOCK = 2 };
 
 	static CacheEvictionType evictionPolicyStringToEnum(const std::string& policy) {
 		std::string cep = policy;
 		std::transform(cep.begin(), cep.end(), cep.begin(), ::tolower);
-		if (cep != "random" && cep != "lru")
+		if (cep != "random" && cep != "lru" && cep != "clock")
 			throw invalid_cache_eviction_policy();
 
 		if (cep == "random")
 			return RANDOM;
+		if (cep == "clock")
+			return CLOCK;
 		return LRU;
 	}
 
-	EvictablePageCache() : pageSize(0), maxPages(0), cacheEvictionType(RANDOM) {}
+	EvictablePageCache() : pageSize(0), maxPages(0), clockHand(0), cacheEvictionType(RANDOM) {}
 
 	explicit EvictablePageCache(int pageSize, int64_t maxSize)
-	  : pageSize(pageSize), maxPages(maxSize / pageSize),
+	  : pageSize(pageSize), maxPages(maxSize / pageSize), clockHand(0),
 	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {
 		cacheEvictions.init("EvictablePageCache.CacheEvictions"_sr);
 	}
@@ -82,7 +88,7 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 
 		page->data = allocateFast4kAligned(pageSize);
 
-		if (RANDOM == cacheEvictionType) {
+		if (LRU != cacheEvictionType) {
 			page->index = pages.size();
 			pages.push_back(page);
 		} else {
@@ -91,7 +97,9 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	}
 
 	void updateHit(EvictablePage* page) {
-		if (RANDOM != cacheEvictionType) {
+		if (CLOCK == cacheEvictionType) {
+			page->referenced = true;
+		} else if (LRU == cacheEvictionType) {
 			// on a hit, update page's location in the LRU so that it's most recent (tail)
 			lruPages.erase(List::s_iterator_to(*page));
 			lruPages.push_back(*page);
@@ -110,8 +118,31 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 					}
 				}
 			}
+		} else if (CLOCK == cacheEvictionType) {
+			if (pages.size() >= (uint64_t)maxPages && !pages.empty()) {
+				// Referenced pages only cost clearing their bit, but bound the sweep to two revolutions
+				int attempts = 0;
+				for (size_t steps = 0; attempts < FLOW_KNOBS->MAX_EVICT_ATTEMPTS && steps < 2 * pages.size();
+				     ++steps) {
+					if (clockHand >= pages.size()) {
+						clockHand = 0;
+					}
+					EvictablePage* page = pages[clockHand];
+					if (page->referenced) {
+						page->referenced = false;
+						++clockHand;
+						continue;
+					}
+					++attempts;
+					// An evicted page is replaced in the vector by the last page, which the hand looks at next
+					if (page->evict()) {
+						++cacheEvictions;
+						break;
+					}
+					++clockHand;
+				}
+			}
 		} else {
-			// For now, LRU is the only other CACHE_EVICTION option
 			if (lruPages.size() >= (uint64_t)maxPages) {
 				int i = 0;
 				// try the least recently used pages first (starting at head of the LRU list)
@@ -130,6 +161,7 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	List lruPages;
 	int pageSize;
 	int64_t maxPages;
+	size_t clockHand;
 	Int64MetricHandle cacheEvictions;
 	const CacheEvictionType cacheEvictionType;
 };
@@ -285,6 +317,7 @@ private:
 	Int64MetricHandle countFileCachePageReadsMissed;
 	Int64MetricHandle countFileCachePageReadsMerged;
 	Int64MetricHandle countFileCacheReadBytes;
+	Int64MetricHandle countFileCacheEvictions;
 
 	Int64MetricHandle countCacheFinds;
 	Int64MetricHandle countCacheReads;
@@ -312,6 +345,7 @@ private:
 			countFileCachePageReadsMerged.init("AsyncFile.CountFileCachePageReadsMerged"_sr, filename);
 			countFileCacheFinds.init("AsyncFile.CountFileCacheFinds"_sr, filename);
 			countFileCacheReadBytes.init("AsyncFile.CountFileCacheReadBytes"_sr, filename);
+			countFileCacheEvictions.init("AsyncFile.CountFileCacheEvictions"_sr, filename);
 
 			countCacheWrites.init("AsyncFile.CountCacheWrites"_sr);
 			countCacheReads.init("AsyncFile.CountCacheReads"_sr);
@@ -373,6 +407,7 @@ private:
 struct AFCPage : public EvictablePage, public FastAllocated<AFCPage> {
 	bool evict() override {
 		if (notReading.isReady() && notFlushing.isReady() && !dirty && !zeroCopyRefCount && !truncated) {
+			++owner->countFileCacheEvictions;
 			owner->remove_page(this);
 			delete this;
 			return true;
@@ -0,0 +1,756 @@
+/*
+ * AsyncFileIOUring.actor.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#if defined(__linux__) && defined(IO_URING_SUPPORTED)
+
+// When actually compiled (NO_INTELLISENSE), include the generated version of this file.  In intellisense use the source
+// version.
+#if defined(NO_INTELLISENSE) && !defined(FLOW_ASYNCFILEIOURING_ACTOR_G_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_G_H
+#include "fdbrpc/AsyncFileIOUring.actor.g.h"
+#elif !defined(FLOW_ASYNCFILEIOURING_ACTOR_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_H
+
+#include "flow/IAsyncFile.h"
+
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/stat.h>
+#include "fdbrpc/AsyncFileEIO.actor.h"
+#include "flow/Knobs.h"
+#include "fdbrpc/Stats.h"
+#include "flow/UnitTest.h"
+#include "flow/genericactors.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// An IAsyncFile for unbuffered files on top of io_uring.  Reads, writes and data syncs of all files share one ring, and
+// the requests queued during a run loop iteration are submitted together.  With IO_URING_SQPOLL a kernel thread polls
+// the submission queue, so a busy process submits requests without making system calls.  Each file takes a slot in the
+// ring's registered file table while one is free, which saves the kernel a file lookup and reference count per request.
+class AsyncFileIOUring final : public IAsyncFile, public ReferenceCounted<AsyncFileIOUring> {
+public:
+	struct AsyncFileIOUringMetrics {
+		LatencySample readLatencySample = { "AsyncFileIOUringReadLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample writeLatencySample = { "AsyncFileIOUringWriteLatency",
+			                                 UID(),
+			                                 FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                 FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample syncLatencySample = { "AsyncFileIOUringSyncLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+	};
+
+	static AsyncFileIOUringMetrics& getMetrics() {
+		static AsyncFileIOUringMetrics metrics;
+		return metrics;
+	}
+
+	static Future<Reference<IAsyncFile>> open(std::string filename, int flags, int mode, void* ignore) {
+		ASSERT(isEnabled());
+		ASSERT(flags & OPEN_UNBUFFERED);
+
+		if (flags & OPEN_LOCK)
+			mode |= 02000; // Enable mandatory locking for this file if it is supported by the filesystem
+
+		std::string open_filename = filename;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			ASSERT((flags & OPEN_CREATE) && (flags & OPEN_READWRITE) && !(flags & OPEN_EXCLUSIVE));
+			open_filename = filename + ".part";
+		}
+
+		int fd = ::open(open_filename.c_str(), openFlags(flags), mode);
+		if (fd < 0) {
+			Error e = errno == ENOENT ? file_not_found() : io_error();
+			TraceEvent("AsyncFileIOUringOpenFailed")
+			    .error(e)
+			    .detail("Filename", filename)
+			    .detailf("Flags", "%x", flags)
+			    .detailf("OSFlags", "%x", openFlags(flags))
+			    .detailf("Mode", "0%o", mode)
+			    .GetLastError();
+			return e;
+		}
+
+		Reference<AsyncFileIOUring> r(new AsyncFileIOUring(fd, flags, filename));
+		TraceEvent("AsyncFileIOUringOpen")
+		    .detail("Filename", filename)
+		    .detail("Flags", flags)
+		    .detail("Mode", mode)
+		    .detail("Fd", fd)
+		    .detail("FixedFile", r->fixedFile);
+
+		if (flags & OPEN_LOCK) {
+			// Acquire a "write" lock for the entire file
+			flock lockDesc;
+			lockDesc.l_type = F_WRLCK;
+			lockDesc.l_whence = SEEK_SET;
+			lockDesc.l_start = 0;
+			lockDesc.l_len = 0; // Lock through to the end of the file, no matter how large it grows
+			lockDesc.l_pid = 0;
+			if (fcntl(fd, F_SETLK, &lockDesc) == -1) {
+				TraceEvent(SevWarn, "UnableToLockFile").detail("Filename", filename).GetLastError();
+				return lock_file_failure();
+			}
+		}
+
+		struct stat buf;
+		if (fstat(fd, &buf)) {
+			TraceEvent("AsyncFileIOUringFStatError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		r->lastFileSize = r->nextFileSize = buf.st_size;
+		return Reference<IAsyncFile>(std::move(r));
+	}
+
+	// Sets up the ring, which delivers completion notifications to ev.  If the kernel cannot set up a ring with the
+	// configured options, io_uring stays disabled and files that ask for it are opened with the other implementations.
+	static void init(Reference<IEventFD> ev, double ioTimeout) {
+		ASSERT(FLOW_KNOBS->ENABLE_IO_URING && !isEnabled());
+		if (!g_network->isSimulated()) {
+			ctx.countIOUringSubmit.init("AsyncFile.CountIOUringSubmit"_sr);
+			ctx.countIOUringCollect.init("AsyncFile.CountIOUringCollect"_sr);
+			ctx.countPreSubmitTruncate.init("AsyncFile.CountPreIOUringSubmitTruncate"_sr);
+		}
+
+		io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		if (FLOW_KNOBS->IO_URING_SQPOLL) {
+			params.flags |= IORING_SETUP_SQPOLL;
+			params.sq_thread_idle = FLOW_KNOBS->IO_URING_SQPOLL_IDLE_MS;
+		}
+
+		int rc = io_uring_queue_init_params(FLOW_KNOBS->IO_URING_ENTRIES, &ctx.ring, &params);
+		if (rc < 0) {
+			TraceEvent(SevWarnAlways, "IOUringSetupError")
+			    .detail("Entries", FLOW_KNOBS->IO_URING_ENTRIES)
+			    .detail("SQPoll", FLOW_KNOBS->IO_URING_SQPOLL)
+			    .detail("ErrorCode", -rc)
+			    .detail("ErrorDesc", strerror(-rc));
+			return;
+		}
+
+		rc = io_uring_register_eventfd(&ctx.ring, ev->getFD());
+		if (rc < 0) {
+			TraceEvent(SevWarnAlways, "IOUringRegisterEventFDError")
+			    .detail("ErrorCode", -rc)
+			    .detail("ErrorDesc", strerror(-rc));
+			io_uring_queue_exit(&ctx.ring);
+			return;
+		}
+
+		// Start with an empty registered file table, which files are added to as they are opened
+		if (FLOW_KNOBS->IO_URING_REGISTERED_FILES > 0) {
+			std::vector<int> fds(FLOW_KNOBS->IO_URING_REGISTERED_FILES, -1);
+			rc = io_uring_register_files(&ctx.ring, fds.data(), fds.size());
+			if (rc < 0) {
+				TraceEvent(SevWarn, "IOUringRegisterFilesError")
+				    .detail("Files", fds.size())
+				    .detail("ErrorCode", -rc)
+				    .detail("ErrorDesc", strerror(-rc));
+			} else {
+				for (int i = fds.size() - 1; i >= 0; --i) {
+					ctx.freeFileSlots.push_back(i);
+				}
+			}
+		}
+
+		ctx.entries = params.sq_entries;
+		ctx.enabled = true;
+		setTimeout(ioTimeout);
+		TraceEvent("IOUringInit")
+		    .detail("Entries", ctx.entries)
+		    .detail("SQPoll", FLOW_KNOBS->IO_URING_SQPOLL)
+		    .detail("RegisteredFiles", ctx.freeFileSlots.size());
+		poll(ev);
+	}
+
+	static bool isEnabled() { return ctx.enabled; }
+	static void setTimeout(double ioTimeout) { ctx.setIOTimeout(ioTimeout); }
+
+	void addref() override { ReferenceCounted<AsyncFileIOUring>::addref(); }
+	void delref() override { ReferenceCounted<AsyncFileIOUring>::delref(); }
+	Future<int> read(void* data, int length, int64_t offset) override {
+		++countFileLogicalReads;
+		++countLogicalReads;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_READ);
+		io->buf = data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		enqueue(io);
+		return io->result.getFuture();
+	}
+	Future<Void> write(void const* data, int length, int64_t offset) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_WRITE);
+		io->buf = (void*)data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		nextFileSize = std::max(nextFileSize, offset + length);
+
+		enqueue(io);
+		return success(io->result.getFuture());
+	}
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE 0x10
+#endif
+	Future<Void> zeroRange(int64_t offset, int64_t length) override {
+		bool success = false;
+		if (ctx.fallocateZeroSupported) {
+			int rc = fallocate(fd, FALLOC_FL_ZERO_RANGE, offset, length);
+			if (rc == EOPNOTSUPP) {
+				ctx.fallocateZeroSupported = false;
+			}
+			if (rc == 0) {
+				success = true;
+			}
+		}
+		return success ? Void() : IAsyncFile::zeroRange(offset, length);
+	}
+	Future<Void> truncate(int64_t size) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		int result = -1;
+		bool completed = false;
+		double begin = timer_monotonic();
+
+		if (ctx.fallocateSupported && size >= lastFileSize) {
+			result = fallocate(fd, 0, 0, size);
+			if (result != 0) {
+				int fallocateErrCode = errno;
+				TraceEvent("AsyncFileIOUringAllocateError")
+				    .detail("Fd", fd)
+				    .detail("Filename", filename)
+				    .detail("Size", size)
+				    .GetLastError();
+				if (fallocateErrCode == EOPNOTSUPP) {
+					// Mark fallocate as unsupported. Try again with truncate.
+					ctx.fallocateSupported = false;
+				} else {
+					return io_error();
+				}
+			} else {
+				completed = true;
+			}
+		}
+		if (!completed)
+			result = ftruncate(fd, size);
+
+		double end = timer_monotonic();
+		if (nondeterministicRandom()->random01() < end - begin) {
+			TraceEvent("SlowIOUringTruncate")
+			    .detail("TruncateTime", end - begin)
+			    .detail("TruncateBytes", size - lastFileSize);
+		}
+
+		if (result != 0) {
+			TraceEvent("AsyncFileIOUringTruncateError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		lastFileSize = nextFileSize = size;
+
+		return Void();
+	}
+
+	ACTOR static Future<Void> throwErrorIfFailed(Reference<AsyncFileIOUring> self, Future<Void> sync) {
+		wait(sync);
+		if (self->failed) {
+			throw io_timeout();
+		}
+		return Void();
+	}
+
+	// Unlike AsyncFileKAIO, which has to hand fdatasync() to a thread, the data sync is submitted to the ring along
+	// with the reads and writes.  As with the other implementations, it only covers writes which have completed.
+	Future<Void> sync() override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_FSYNC);
+		enqueue(io);
+
+		double start_time = timer();
+		Future<Void> fsync =
+		    throwErrorIfFailed(Reference<AsyncFileIOUring>::addRef(this), success(io->result.getFuture()));
+		fsync = map(fsync, [=](Void r) mutable {
+			getMetrics().syncLatencySample.addMeasurement(timer() - start_time);
+			return r;
+		});
+
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			flags &= ~OPEN_ATOMIC_WRITE_AND_CREATE;
+
+			return AsyncFileEIO::waitAndAtomicRename(fsync, filename + ".part", filename);
+		}
+
+		return fsync;
+	}
+	Future<int64_t> size() const override { return nextFileSize; }
+	int64_t debugFD() const override { return fd; }
+	std::string getFilename() const override { return filename; }
+	~AsyncFileIOUring() override {
+		// Requests hold a reference to their file, so none of them can still be using the registered file slot
+		if (fixedFile >= 0) {
+			ctx.unregisterFile(fixedFile);
+		}
+		close(fd);
+	}
+
+	// Moves as many queued requests as the ring has room for into the submission queue and submits them.  Called once
+	// per run loop iteration.
+	static void launch() {
+		if (!ctx.enabled || ((ctx.queue.empty() || ctx.outstanding >= ctx.entries) && !ctx.submitPending)) {
+			return;
+		}
+
+		double begin = timer_monotonic();
+		if (!ctx.outstanding)
+			ctx.ioStallBegin = begin;
+
+		int n = std::min<size_t>(ctx.entries - ctx.outstanding, ctx.queue.size());
+		double start = timer();
+		int prepared = 0;
+		for (; prepared < n; ++prepared) {
+			io_uring_sqe* sqe = io_uring_get_sqe(&ctx.ring);
+			if (sqe == nullptr) {
+				break;
+			}
+
+			IOBlock* io = ctx.queue.top();
+			ctx.queue.pop();
+			io->startTime = start;
+
+			if (ctx.ioTimeout > 0) {
+				ctx.appendToRequestList(io);
+			}
+
+			if (io->owner->lastFileSize != io->owner->nextFileSize) {
+				++ctx.countPreSubmitTruncate;
+				io->owner->truncate(io->owner->nextFileSize);
+			}
+
+			io->prepare(sqe);
+		}
+		ctx.outstanding += prepared;
+
+		// Entries the kernel did not consume stay in the submission queue, and are submitted again on the next call
+		int rc = io_uring_submit(&ctx.ring);
+		if (rc < 0 && rc != -EAGAIN && rc != -EBUSY && rc != -EINTR) {
+			TraceEvent(SevError, "IOUringSubmitError").detail("ErrorCode", -rc).detail("ErrorDesc", strerror(-rc));
+			throw io_error();
+		}
+		ctx.submitPending = io_uring_sq_ready(&ctx.ring) > 0;
+		++ctx.countIOUringSubmit;
+
+		double elapsed = timer_monotonic() - begin;
+		g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
+		if (elapsed > FLOW_KNOBS->SLOW_LOOP_CUTOFF && nondeterministicRandom()->random01() < elapsed) {
+			TraceEvent("SlowIOUringLaunch").detail("Elapsed", elapsed).detail("Submitted", prepared);
+		}
+	}
+
+	bool failed;
+
+private:
+	int fd, flags;
+	// Index of the file in the ring's registered file table, or -1 if it is not registered
+	int fixedFile;
+	int64_t lastFileSize, nextFileSize;
+	std::string filename;
+	Int64MetricHandle countFileLogicalWrites;
+	Int64MetricHandle countFileLogicalReads;
+
+	Int64MetricHandle countLogicalWrites;
+	Int64MetricHandle countLogicalReads;
+
+	struct IOBlock : FastAllocated<IOBlock> {
+		Promise<int> result;
+		Reference<AsyncFileIOUring> owner;
+		int op;
+		void* buf;
+		int nbytes;
+		int64_t offset;
+		int64_t prio;
+		IOBlock* prev;
+		IOBlock* next;
+		double startTime;
+
+		struct indirect_order_by_priority {
+			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
+		};
+
+		explicit IOBlock(int op)
+		  : op(op), buf(nullptr), nbytes(0), offset(0), prio(0), prev(nullptr), next(nullptr), startTime(0) {}
+
+		TaskPriority getTask() const { return static_cast<TaskPriority>((prio >> 32) + 1); }
+
+		void prepare(io_uring_sqe* sqe) {
+			int target = owner->fixedFile >= 0 ? owner->fixedFile : owner->fd;
+			switch (op) {
+			case IORING_OP_READ:
+				io_uring_prep_read(sqe, target, buf, nbytes, offset);
+				break;
+			case IORING_OP_WRITE:
+				io_uring_prep_write(sqe, target, buf, nbytes, offset);
+				break;
+			case IORING_OP_FSYNC:
+				io_uring_prep_fsync(sqe, target, IORING_FSYNC_DATASYNC);
+				break;
+			default:
+				UNREACHABLE();
+			}
+			if (owner->fixedFile >= 0) {
+				sqe->flags |= IOSQE_FIXED_FILE;
+			}
+			io_uring_sqe_set_data(sqe, this);
+		}
+
+		ACTOR static void deliver(Promise<int> result, bool failed, int r, TaskPriority task) {
+			wait(delay(0, task));
+			if (failed)
+				result.sendError(io_timeout());
+			else if (r < 0)
+				result.sendError(io_error());
+			else
+				result.send(r);
+		}
+
+		void setResult(int r) {
+			if (r < 0) {
+				struct stat fst;
+				fstat(owner->fd, &fst);
+
+				errno = -r;
+				TraceEvent("AsyncFileIOUringIOError")
+				    .GetLastError()
+				    .detail("Fd", owner->fd)
+				    .detail("Op", op)
+				    .detail("Nbytes", nbytes)
+				    .detail("Offset", offset)
+				    .detail("Ptr", int64_t(buf))
+				    .detail("Size", fst.st_size)
+				    .detail("Filename", owner->filename);
+			}
+			deliver(result, owner->failed, r, getTask());
+			delete this;
+		}
+
+		void timeout(bool warnOnly) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringTimeout")
+			    .detail("Fd", owner->fd)
+			    .detail("Op", op)
+			    .detail("Nbytes", nbytes)
+			    .detail("Offset", offset)
+			    .detail("Ptr", int64_t(buf))
+			    .detail("Filename", owner->filename);
+			g_network->setGlobal(INetwork::enASIOTimedOut, (flowGlobalType) true);
+
+			if (!warnOnly)
+				owner->failed = true;
+		}
+	};
+
+	struct Context {
+		io_uring ring;
+		bool enabled;
+		// Size of the submission queue.  No more requests than this are outstanding at once, so the completion queue,
+		// which is twice as large, cannot overflow.
+		int entries;
+		int outstanding;
+		// Whether the submission queue holds entries that the last io_uring_submit() did not get to the kernel
+		bool submitPending;
+		double ioStallBegin;
+		bool fallocateSupported;
+		bool fallocateZeroSupported;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::vector<int> freeFileSlots;
+		Int64MetricHandle countIOUringSubmit;
+		Int64MetricHandle countIOUringCollect;
+		Int64MetricHandle countPreSubmitTruncate;
+
+		double ioTimeout;
+		bool timeoutWarnOnly;
+		IOBlock* submittedRequestList;
+
+		uint32_t opsIssued;
+		Context()
+		  : enabled(false), entries(0), outstanding(0), submitPending(false), ioStallBegin(0), fallocateSupported(true),
+		    fallocateZeroSupported(true), submittedRequestList(nullptr), opsIssued(0) {
+			memset(&ring, 0, sizeof(ring));
+			setIOTimeout(0);
+		}
+
+		void setIOTimeout(double timeout) {
+			ioTimeout = fabs(timeout);
+			timeoutWarnOnly = timeout < 0;
+		}
+
+		// Returns the registered file table slot holding fd, or -1 if fd could not be registered
+		int registerFile(int fd) {
+			if (freeFileSlots.empty()) {
+				return -1;
+			}
+			int slot = freeFileSlots.back();
+			int rc = io_uring_register_files_update(&ring, slot, &fd, 1);
+			if (rc < 0) {
+				TraceEvent(SevWarn, "IOUringRegisterFileError")
+				    .detail("Fd", fd)
+				    .detail("Slot", slot)
+				    .detail("ErrorCode", -rc)
+				    .detail("ErrorDesc", strerror(-rc));
+				return -1;
+			}
+			freeFileSlots.pop_back();
+			return slot;
+		}
+
+		void unregisterFile(int slot) {
+			int fd = -1;
+			int rc = io_uring_register_files_update(&ring, slot, &fd, 1);
+			if (rc < 0) {
+				// Leave the slot out of the free list rather than risk handing out a slot that still refers to a file
+				TraceEvent(SevWarn, "IOUringUnregisterFileError")
+				    .detail("Slot", slot)
+				    .detail("ErrorCode", -rc)
+				    .detail("ErrorDesc", strerror(-rc));
+				return;
+			}
+			freeFileSlots.push_back(slot);
+		}
+
+		void appendToRequestList(IOBlock* io) {
+			ASSERT(!io->next && !io->prev);
+
+			if (submittedRequestList) {
+				io->prev = submittedRequestList->prev;
+				io->prev->next = io;
+
+				submittedRequestList->prev = io;
+				io->next = submittedRequestList;
+			} else {
+				submittedRequestList = io;
+				io->next = io->prev = io;
+			}
+		}
+
+		void removeFromRequestList(IOBlock* io) {
+			if (io->next == nullptr) {
+				ASSERT(io->prev == nullptr);
+				return;
+			}
+
+			ASSERT(io->prev != nullptr);
+
+			if (io == io->next) {
+				ASSERT(io == submittedRequestList && io == io->prev);
+				submittedRequestList = nullptr;
+			} else {
+				io->next->prev = io->prev;
+				io->prev->next = io->next;
+
+				if (submittedRequestList == io) {
+					submittedRequestList = io->next;
+				}
+			}
+
+			io->next = io->prev = nullptr;
+		}
+	};
+	static Context ctx;
+
+	explicit AsyncFileIOUring(int fd, int flags, std::string const& filename)
+	  : failed(false), fd(fd), flags(flags), fixedFile(ctx.registerFile(fd)), filename(filename) {
+		if (!g_network->isSimulated()) {
+			countFileLogicalWrites.init("AsyncFile.CountFileLogicalWrites"_sr, filename);
+			countFileLogicalReads.init("AsyncFile.CountFileLogicalReads"_sr, filename);
+			countLogicalWrites.init("AsyncFile.CountLogicalWrites"_sr);
+			countLogicalReads.init("AsyncFile.CountLogicalReads"_sr);
+		}
+	}
+
+	void enqueue(IOBlock* io) {
+		ASSERT(int64_t(io->buf) % 4096 == 0 && io->offset % 4096 == 0 && io->nbytes % 4096 == 0);
+
+		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - (++ctx.opsIssued);
+		io->owner = Reference<AsyncFileIOUring>::addRef(this);
+
+		ctx.queue.push(io);
+	}
+
+	static int openFlags(int flags) {
+		int oflags = O_DIRECT | O_CLOEXEC;
+		ASSERT(bool(flags & OPEN_READONLY) != bool(flags & OPEN_READWRITE)); // readonly xor readwrite
+		if (flags & OPEN_EXCLUSIVE)
+			oflags |= O_EXCL;
+		if (flags & OPEN_CREATE)
+			oflags |= O_CREAT;
+		if (flags & OPEN_READONLY)
+			oflags |= O_RDONLY;
+		if (flags & OPEN_READWRITE)
+			oflags |= O_RDWR;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE)
+			oflags |= O_TRUNC;
+		return oflags;
+	}
+
+	// Completes the requests in the completion queue and returns how many there were
+	static int reapCompletions(double currentTime) {
+		int n = 0;
+		unsigned head;
+		io_uring_cqe* cqe;
+		io_uring_for_each_cqe(&ctx.ring, head, cqe) {
+			IOBlock* iob = static_cast<IOBlock*>(io_uring_cqe_get_data(cqe));
+
+			if (ctx.ioTimeout > 0) {
+				ctx.removeFromRequestList(iob);
+			}
+
+			switch (iob->op) {
+			case IORING_OP_READ:
+				getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			case IORING_OP_WRITE:
+				getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			}
+
+			iob->setResult(cqe->res);
+			++n;
+		}
+		io_uring_cq_advance(&ctx.ring, n);
+		return n;
+	}
+
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
+
+			wait(delay(0, TaskPriority::DiskIOComplete));
+
+			double currentTime = timer();
+			++ctx.countIOUringCollect;
+
+			if (ctx.ioTimeout > 0) {
+				while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+					ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+					ctx.removeFromRequestList(ctx.submittedRequestList);
+				}
+			}
+
+			int n = reapCompletions(currentTime);
+			if (n) {
+				double t = timer_monotonic();
+				double elapsed = t - ctx.ioStallBegin;
+				ctx.ioStallBegin = t;
+				g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+			}
+			ctx.outstanding -= n;
+		}
+	}
+};
+
+TEST_CASE("/fdbrpc/AsyncFileIOUring/ReadWrite") {
+	// This test does nothing in simulation, or unless io_uring was enabled with ENABLE_IO_URING
+	if (!g_network->isSimulated() && AsyncFileIOUring::isEnabled()) {
+		state Reference<IAsyncFile> f;
+		state int pages = 64;
+		state uint8_t* buf = (uint8_t*)aligned_alloc(4096, pages * 4096);
+		try {
+			Reference<IAsyncFile> f_ = wait(AsyncFileIOUring::open(
+			    "/tmp/__IO_URING_TEST_FILE__",
+			    IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE,
+			    0666,
+			    nullptr));
+			f = f_;
+
+			state std::vector<Future<Void>> writes;
+			state int i = 0;
+			for (i = 0; i < pages; ++i) {
+				memset(buf + i * 4096, i, 4096);
+				writes.push_back(f->write(buf + i * 4096, 4096, int64_t(i) * 4096));
+			}
+			wait(waitForAll(writes));
+			wait(f->sync());
+			int64_t size = wait(f->size());
+			ASSERT_EQ(size, int64_t(pages) * 4096);
+
+			// Read the pages back in the reverse order, all at once, so that they are submitted together
+			memset(buf, 0xff, pages * 4096);
+			state std::vector<Future<int>> reads;
+			for (i = pages - 1; i >= 0; --i) {
+				reads.push_back(f->read(buf + i * 4096, 4096, int64_t(i) * 4096));
+			}
+			wait(waitForAll(reads));
+			for (i = 0; i < pages; ++i) {
+				ASSERT_EQ(reads[pages - 1 - i].get(), 4096);
+				for (int j = 0; j < 4096; ++j) {
+					ASSERT_EQ(buf[i * 4096 + j], uint8_t(i));
+				}
+			}
+			ASSERT(!((AsyncFileIOUring*)f.getPtr())->failed);
+		} catch (Error& e) {
+			state Error err = e;
+			aligned_free(buf);
+			if (f) {
+				wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+			}
+			throw err;
+		}
+
+		aligned_free(buf);
+		wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+	}
+
+	return Void();
+}
+
+AsyncFileIOUring::Context AsyncFileIOUring::ctx;
+
+#include "flow/unactorcompiler.h"
+#endif
+#endif
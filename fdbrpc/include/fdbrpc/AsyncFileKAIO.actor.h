@@ -58,6 +58,29 @@ DESCR struct SlowAioSubmit {
 
 class AsyncFileKAIO final : public IAsyncFile, public ReferenceCounted<AsyncFileKAIO> {
 public:
+	// I/Os are queued and launched per class, so that background writes can't take all the outstanding slots and
+	// hold up foreground reads, and are ordered by the issuing task's priority within a class
+	enum IOClass { IO_FOREGROUND = 0, IO_COMMIT = 1, IO_BACKGROUND = 2, IO_CLASS_COUNT = 3 };
+
+	static IOClass ioClassOf(int op, TaskPriority task) {
+		if (task < TaskPriority::DiskRead) {
+			return IO_BACKGROUND;
+		}
+		return op == IO_CMD_PREAD ? IO_FOREGROUND : IO_COMMIT;
+	}
+
+	// Most I/Os of a class that may be outstanding at once
+	static int ioClassBudget(IOClass ioClass) {
+		switch (ioClass) {
+		case IO_COMMIT:
+			return std::min(FLOW_KNOBS->KAIO_COMMIT_MAX_OUTSTANDING, FLOW_KNOBS->MAX_OUTSTANDING);
+		case IO_BACKGROUND:
+			return std::min(FLOW_KNOBS->KAIO_BACKGROUND_MAX_OUTSTANDING, FLOW_KNOBS->MAX_OUTSTANDING);
+		default:
+			return FLOW_KNOBS->MAX_OUTSTANDING;
+		}
+	}
+
 	struct AsyncFileKAIOMetrics {
 		LatencySample readLatencySample = { "AsyncFileKAIOReadLatency",
 			                                UID(),
@@ -71,6 +94,30 @@ public:
 			                                UID(),
 			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
 			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		// Per class latencies, measured from when the I/O is queued so that they include the time spent waiting
+		LatencySample foregroundLatencySample = { "AsyncFileKAIOForegroundLatency",
+			                                      UID(),
+			                                      FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                      FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample commitLatencySample = { "AsyncFileKAIOCommitLatency",
+			                                  UID(),
+			                                  FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                  FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample backgroundLatencySample = { "AsyncFileKAIOBackgroundLatency",
+			                                      UID(),
+			                                      FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                      FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+
+		LatencySample& ioClassLatencySample(IOClass ioClass) {
+			switch (ioClass) {
+			case IO_FOREGROUND:
+				return foregroundLatencySample;
+			case IO_COMMIT:
+				return commitLatencySample;
+			default:
+				return backgroundLatencySample;
+			}
+		}
 	};
 
 	static AsyncFileKAIOMetrics& getMetrics() {
@@ -196,6 +243,7 @@ public:
 			ctx.submitMetric.init("AsyncFile.Submit"_sr);
 			ctx.countPreSubmitTruncate.init("AsyncFile.CountPreAIOSubmitTruncate"_sr);
 			ctx.preSubmitTruncateBytes.init("AsyncFile.PreAIOSubmitTruncateBytes"_sr);
+			ctx.countStarvedLaunches.init("AsyncFile.CountAIOStarvedLaunches"_sr);
 			ctx.slowAioSubmitMetric.init("AsyncFile.SlowAIOSubmit"_sr);
 		}
 
@@ -401,7 +449,7 @@ public:
 	}
 
 	static void launch() {
-		if (ctx.queue.size() && ctx.outstanding < FLOW_KNOBS->MAX_OUTSTANDING - FLOW_KNOBS->MIN_SUBMIT) {
+		if (ctx.launchable() && ctx.outstanding < FLOW_KNOBS->MAX_OUTSTANDING - FLOW_KNOBS->MIN_SUBMIT) {
 			ctx.submitMetric = true;
 
 			double begin = timer_monotonic();
@@ -409,20 +457,24 @@ public:
 				ctx.ioStallBegin = begin;
 
 			IOBlock* toStart[FLOW_KNOBS->MAX_OUTSTANDING];
-			int n = std::min<size_t>(FLOW_KNOBS->MAX_OUTSTANDING - ctx.outstanding, ctx.queue.size());
+			int n = 0;
 
 			int64_t previousTruncateCount = ctx.countPreSubmitTruncate;
 			int64_t previousTruncateBytes = ctx.preSubmitTruncateBytes;
 			int64_t largestTruncate = 0;
 
 			double start = timer();
-			for (int i = 0; i < n; i++) {
-				auto io = ctx.queue.top();
+			int launching[IO_CLASS_COUNT];
+			std::copy(ctx.classOutstanding, ctx.classOutstanding + IO_CLASS_COUNT, launching);
+			while (n < FLOW_KNOBS->MAX_OUTSTANDING - ctx.outstanding) {
+				IOBlock* io = ctx.popNext(launching, start);
+				if (!io) {
+					break;
+				}
 
 				KAIOLogBlockEvent(io, OpLogEntry::LAUNCH);
 
-				ctx.queue.pop();
-				toStart[i] = io;
+				toStart[n++] = io;
 				io->startTime = start;
 
 				if (ctx.ioTimeout > 0) {
@@ -466,7 +518,7 @@ public:
 			double elapsed = timer_monotonic() - begin;
 			g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
 
-			//TraceEvent("Launched").detail("N", rc).detail("Queued", ctx.queue.size()).detail("Elapsed", elapsed).detail("Outstanding", ctx.outstanding+rc);
+			//TraceEvent("Launched").detail("N", rc).detail("Elapsed", elapsed).detail("Outstanding", ctx.outstanding+rc);
 			// printf("launched: %d/%d in %f us (%d outstanding; lowest prio %d)\n", rc, ctx.queue.size(), elapsed*1e6,
 			// ctx.outstanding + rc, toStart[n-1]->getTask());
 			if (rc < 0) {
@@ -478,12 +530,19 @@ public:
 					toStart[0]->setResult(errno ? -errno : -1000000);
 					rc = 1;
 				}
-			} else
+			} else {
 				ctx.outstanding += rc;
+				for (int i = 0; i < rc; i++) {
+					ctx.classOutstanding[toStart[i]->ioClass]++;
+				}
+			}
 			// Any unsubmitted I/Os need to be requeued
 			for (int i = rc; i < n; i++) {
 				KAIOLogBlockEvent(toStart[i], OpLogEntry::REQUEUE);
-				ctx.queue.push(toStart[i]);
+				if (ctx.ioTimeout > 0) {
+					ctx.removeFromRequestList(toStart[i]);
+				}
+				ctx.queues[toStart[i]->ioClass].push(toStart[i]);
 			}
 		}
 	}
@@ -504,8 +563,10 @@ private:
 		Promise<int> result;
 		Reference<AsyncFileKAIO> owner;
 		int64_t prio;
+		IOClass ioClass;
 		IOBlock* prev;
 		IOBlock* next;
+		double enqueueTime;
 		double startTime;
 #if KAIO_LOGGING
 		int32_t iolog_id;
@@ -515,7 +576,8 @@ private:
 			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
 		};
 
-		IOBlock(int op, int fd) : prev(nullptr), next(nullptr), startTime(0) {
+		IOBlock(int op, int fd)
+		  : ioClass(IO_FOREGROUND), prev(nullptr), next(nullptr), enqueueTime(0), startTime(0) {
 			memset((linux_iocb*)this, 0, sizeof(linux_iocb));
 			aio_lio_opcode = op;
 			aio_fildes = fd;
@@ -578,7 +640,11 @@ private:
 		double ioStallBegin;
 		bool fallocateSupported;
 		bool fallocateZeroSupported;
-		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority>
+		    queues[IO_CLASS_COUNT];
+		int classOutstanding[IO_CLASS_COUNT];
+		// When each class last launched an I/O, or started waiting to if its queue was empty
+		double classLastLaunch[IO_CLASS_COUNT];
 		Int64MetricHandle countAIOSubmit;
 		Int64MetricHandle countAIOCollect;
 		Int64MetricHandle submitMetric;
@@ -589,6 +655,7 @@ private:
 
 		Int64MetricHandle countPreSubmitTruncate;
 		Int64MetricHandle preSubmitTruncateBytes;
+		Int64MetricHandle countStarvedLaunches;
 
 		EventMetricHandle<SlowAioSubmit> slowAioSubmitMetric;
 
@@ -596,9 +663,49 @@ private:
 		Context()
 		  : iocx(0), evfd(-1), outstanding(0), ioStallBegin(0), fallocateSupported(true), fallocateZeroSupported(true),
 		    submittedRequestList(nullptr), opsIssued(0) {
+			std::fill(classOutstanding, classOutstanding + IO_CLASS_COUNT, 0);
+			std::fill(classLastLaunch, classLastLaunch + IO_CLASS_COUNT, 0.0);
 			setIOTimeout(0);
 		}
 
+		bool launchable() const {
+			for (int c = 0; c < IO_CLASS_COUNT; c++) {
+				if (!queues[c].empty() && classOutstanding[c] < ioClassBudget((IOClass)c)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Takes the next I/O to launch given how many of each class are outstanding or launching. Classes go in order,
+		// except that one which hasn't launched anything for KAIO_STARVATION_TIME goes first.
+		IOBlock* popNext(int* launching, double now) {
+			int next = -1;
+			for (int c = 0; c < IO_CLASS_COUNT; c++) {
+				if (queues[c].empty() || launching[c] >= ioClassBudget((IOClass)c)) {
+					continue;
+				}
+				if (now - classLastLaunch[c] > FLOW_KNOBS->KAIO_STARVATION_TIME) {
+					next = c;
+					if (c > 0) {
+						++countStarvedLaunches;
+					}
+					break;
+				}
+				if (next < 0) {
+					next = c;
+				}
+			}
+			if (next < 0) {
+				return nullptr;
+			}
+			IOBlock* io = queues[next].top();
+			queues[next].pop();
+			launching[next]++;
+			classLastLaunch[next] = now;
+			return io;
+		}
+
 		void setIOTimeout(double timeout) {
 			ioTimeout = fabs(timeout);
 			timeoutWarnOnly = timeout < 0;
@@ -697,9 +804,14 @@ private:
 		io->eventfd = ctx.evfd;
 		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - (++ctx.opsIssued);
 		// io->prio = - (++ctx.opsIssued);
+		io->ioClass = ioClassOf(io->aio_lio_opcode, g_network->getCurrentTask());
+		io->enqueueTime = timer();
 		io->owner = Reference<AsyncFileKAIO>::addRef(owner);
 
-		ctx.queue.push(io);
+		if (ctx.queues[io->ioClass].empty()) {
+			ctx.classLastLaunch[io->ioClass] = io->enqueueTime;
+		}
+		ctx.queues[io->ioClass].push(io);
 	}
 
 	static int openFlags(int flags) {
@@ -772,6 +884,9 @@ private:
 					ctx.removeFromRequestList(iob);
 				}
 
+				ctx.classOutstanding[iob->ioClass]--;
+				getMetrics().ioClassLatencySample(iob->ioClass).addMeasurement(currentTime - iob->enqueueTime);
+
 				switch (iob->aio_lio_opcode) {
 				case IO_CMD_PREAD:
 					getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
@@ -33,7 +33,8 @@
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 // Read-only file type that wraps another file instance, reads in large blocks, and reads ahead of the actual range
-// requested
+// requested. The read ahead window starts at the configured number of blocks, doubles while the file is read
+// sequentially, up to FLOW_KNOBS->READ_AHEAD_MAX_BYTES, and halves back toward the configured size on other reads.
 class AsyncFileReadAheadCache final : public IAsyncFile, public ReferenceCounted<AsyncFileReadAheadCache> {
 public:
 	void addref() override { ReferenceCounted<AsyncFileReadAheadCache>::addref(); }
@@ -54,6 +55,7 @@ public:
 		try {
 			int len = wait(uncancellable(holdWhile(block, f->m_f->read(block->data, length, offset))));
 			block->len = len;
+			f->m_bytes_read += len;
 		} catch (Error& e) {
 			f->m_max_concurrent_reads.release(1);
 			throw e;
@@ -77,6 +79,8 @@ public:
 		if (offset + length > fileSize)
 			length = fileSize - offset; // Length is at least 1 since offset < fileSize
 
+		f->adaptReadAhead(offset, length);
+
 		// Calculate block range for the blocks that contain this data
 		state int firstBlockNum = offset / f->m_block_size;
 		ASSERT(f->m_block_size > 0);
@@ -130,7 +134,7 @@ public:
 
 			// unpin this block
 			localCache.erase(blockNum);
-			if (f->m_blocks.size() > f->m_cache_block_limit) {
+			if (f->m_blocks.size() > f->cacheBlockLimit()) {
 				// make an attempt to free no-longer needed blocks as we go
 				// FIXME: could also expire previous blocks if above limit and they're also free
 				auto i = f->m_blocks.find(blockNum);
@@ -144,6 +148,7 @@ public:
 
 		ASSERT(wpos == length);
 		ASSERT(localCache.empty());
+		f->m_bytes_returned += wpos;
 
 		// If the cache is too large then go through the cache in block number order and remove any entries whose future
 		// has a reference count of 1, stopping once the cache is no longer too big.  There is no point in removing
@@ -153,13 +158,13 @@ public:
 		// printf("cache block limit: %d   Cache contents:\n", f->m_cache_block_limit);
 		// for(auto &m : f->m_blocks) printf("\tblock %d refcount %d\n", m.first, m.second.getFutureReferenceCount());
 
-		if (f->m_blocks.size() > f->m_cache_block_limit) {
+		if (f->m_blocks.size() > f->cacheBlockLimit()) {
 			auto i = f->m_blocks.begin();
 			while (i != f->m_blocks.end()) {
 				if (i->second.getFutureReferenceCount() == 1) {
 					// printf("evicting block %d\n", i->first);
 					i = f->m_blocks.erase(i);
-					if (f->m_blocks.size() <= f->m_cache_block_limit)
+					if (f->m_blocks.size() <= f->cacheBlockLimit())
 						break;
 				} else
 					++i;
@@ -195,23 +200,69 @@ public:
 		for (auto& it : m_blocks) {
 			it.second.cancel();
 		}
+		if (m_bytes_returned > 0) {
+			double elapsed = now() - m_first_read_time;
+			TraceEvent(SevDebug, "AsyncFileReadAheadStats")
+			    .detail("Filename", getFilename())
+			    .detail("BytesReturned", m_bytes_returned)
+			    .detail("BytesRead", m_bytes_read)
+			    .detail("Seconds", elapsed)
+			    .detail("BytesPerSecond", elapsed > 0 ? m_bytes_returned / elapsed : 0)
+			    .detail("SequentialReads", m_sequential_reads)
+			    .detail("OtherReads", m_other_reads)
+			    .detail("MaxReadAheadBlocks", m_max_read_ahead_blocks_used);
+		}
+	}
+
+	// Grows the read ahead window on a read that continues the previous one, or starts less than a block past it, and
+	// shrinks it on any other read
+	void adaptReadAhead(int64_t offset, int length) {
+		if (m_bytes_returned == 0 && m_next_offset == 0) {
+			m_first_read_time = now();
+		}
+		if (offset >= m_last_offset && offset <= m_next_offset + m_block_size) {
+			++m_sequential_reads;
+			m_read_ahead_blocks = std::min(m_max_read_ahead_blocks, std::max(1, m_read_ahead_blocks * 2));
+		} else {
+			++m_other_reads;
+			m_read_ahead_blocks = std::max(m_min_read_ahead_blocks, m_read_ahead_blocks / 2);
+		}
+		m_max_read_ahead_blocks_used = std::max(m_max_read_ahead_blocks_used, m_read_ahead_blocks);
+		m_last_offset = offset;
+		m_next_offset = offset + length;
 	}
 
+	// The configured cache size, but always enough to hold the read ahead window beyond the block being read
+	int cacheBlockLimit() const { return std::max(m_cache_block_limit, m_read_ahead_blocks + 1); }
+
 	Reference<IAsyncFile> m_f;
 	int m_block_size;
 	int m_read_ahead_blocks;
+	int m_min_read_ahead_blocks;
+	int m_max_read_ahead_blocks;
 	int m_cache_block_limit;
 	FlowLock m_max_concurrent_reads;
 
 	// Map block numbers to future
 	std::map<int, Future<Reference<CacheBlock>>> m_blocks;
 
+	// Access pattern of the reads so far, and the bytes read from the underlying file and returned to callers
+	int64_t m_last_offset = 0;
+	int64_t m_next_offset = 0;
+	int64_t m_sequential_reads = 0;
+	int64_t m_other_reads = 0;
+	int m_max_read_ahead_blocks_used = 0;
+	int64_t m_bytes_read = 0;
+	int64_t m_bytes_returned = 0;
+	double m_first_read_time = 0;
+
 	AsyncFileReadAheadCache(Reference<IAsyncFile> f,
 	                        int blockSize,
 	                        int readAheadBlocks,
 	                        int maxConcurrentReads,
 	                        int cacheSizeBlocks)
-	  : m_f(f), m_block_size(blockSize), m_read_ahead_blocks(readAheadBlocks),
+	  : m_f(f), m_block_size(blockSize), m_read_ahead_blocks(readAheadBlocks), m_min_read_ahead_blocks(readAheadBlocks),
+	    m_max_read_ahead_blocks(std::max<int64_t>(readAheadBlocks, FLOW_KNOBS->READ_AHEAD_MAX_BYTES / blockSize)),
 	    m_cache_block_limit(std::max<int>(1, cacheSizeBlocks)), m_max_concurrent_reads(maxConcurrentReads) {}
 };
 
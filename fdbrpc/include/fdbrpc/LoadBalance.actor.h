@@ -269,7 +269,7 @@ struct RequestData : NonCopyable {
 			// Send parallel request to TSS pair, if it exists
 			Optional<TSSEndpointData> tssData = model->getTssData(stream->getEndpoint().token.first());
 
-			if (tssData.present()) {
+			if (tssData.present() && deterministicRandom()->random01() < TSS_sampleRate(request)) {
 				CODE_PROBE(true, "duplicating request to TSS");
 				resetReply(request);
 				// FIXME: optimize to avoid creating new netNotifiedQueue for each message
@@ -476,6 +476,7 @@ Future<REPLY_TYPE(Request)> loadBalance(
 		double nextMetric = 1e9;
 		double bestTime = 1e9; // The latency to the server with the least outstanding requests.
 		double nextTime = 1e9;
+		double bestHedgeDelay = 0; // How long requests to the best server usually take, if known
 		int badServers = 0;
 
 		for (int i = 0; i < alternatives->size(); i++) {
@@ -517,6 +518,7 @@ Future<REPLY_TYPE(Request)> loadBalance(
 						bestAlt = i;
 						bestMetric = thisMetric;
 						bestTime = thisTime;
+						bestHedgeDelay = qd.hedgeDelay;
 					} else if (thisMetric < nextMetric) {
 						nextAlt = i;
 						nextMetric = thisMetric;
@@ -551,7 +553,16 @@ Future<REPLY_TYPE(Request)> loadBalance(
 			}
 		}
 
-		if (nextTime < 1e9) {
+		if (nextTime < 1e9 && FLOW_KNOBS->LOAD_BALANCE_HEDGING && bestHedgeDelay > 0) {
+			// Only send the request to the second best choice once the first has taken longer than most requests to
+			// its server do. Crossing DCs costs more, so wait longer before doing so.
+			double hedgeDelay = bestHedgeDelay;
+			if (alternatives->getDistance(nextAlt) == LBDistance::DISTANT &&
+			    alternatives->getDistance(bestAlt) != LBDistance::DISTANT) {
+				hedgeDelay *= FLOW_KNOBS->LOAD_BALANCE_HEDGE_DISTANT_MULTIPLIER;
+			}
+			secondDelay = delay(hedgeDelay + FLOW_KNOBS->BASE_SECOND_REQUEST_TIME);
+		} else if (nextTime < 1e9) {
 			// Decide when to send the request to the second best choice.
 			if (bestTime > FLOW_KNOBS->INSTANT_SECOND_REQUEST_MULTIPLIER *
 			                   (model->secondMultiplier * (nextTime) + FLOW_KNOBS->BASE_SECOND_REQUEST_TIME)) {
@@ -24,6 +24,7 @@
 
 #include "flow/flow.h"
 #include "fdbrpc/Smoother.h"
+#include "fdbrpc/DDSketch.h"
 #include "flow/Knobs.h"
 #include "flow/ActorCollection.h"
 #include "fdbrpc/TSSComparison.h" // For TSS Metrics
@@ -71,12 +72,20 @@ struct QueueData {
 	// to increase the future backoff amount.
 	double increaseBackoffTime;
 
+	// With LOAD_BALANCE_HEDGING, the LOAD_BALANCE_HEDGE_QUANTILE of the latencies of the last
+	// LOAD_BALANCE_HEDGE_WINDOW clean requests to this storage server, or 0 until a window has been seen. A second
+	// request is only sent once a request to this server has taken longer than this.
+	double hedgeDelay;
+
+	// The latencies of the current window, only allocated once hedging is used with this server.
+	std::unique_ptr<DDSketch<double>> recentLatencies;
+
 	// a bit of a hack to store this here, but it's the only centralized place for per-endpoint tracking
 	Optional<TSSEndpointData> tssData;
 
 	QueueData()
 	  : smoothOutstanding(FLOW_KNOBS->QUEUE_MODEL_SMOOTHING_AMOUNT), latency(0.001), penalty(1.0), failedUntil(0),
-	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0) {}
+	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0), hedgeDelay(0) {}
 };
 
 typedef double TimeEstimate;
@@ -118,6 +127,9 @@ public:
 	// Retrieves the data for this endpoint's pair TSS endpoint, if present
 	Optional<TSSEndpointData> getTssData(uint64_t endpointId);
 
+	// Adds the latency of a clean request to d's window, updating its hedgeDelay when the window is full
+	static void addHedgeSample(QueueData& d, double latency);
+
 	QueueModel() : secondMultiplier(1.0), secondBudget(0), laggingRequestCount(0) {
 		laggingRequests = actorCollection(addActor.getFuture(), &laggingRequestCount);
 		tssComparisons = actorCollection(addTSSActor.getFuture(), &laggingTSSCompareCount);
@@ -119,4 +119,11 @@ const char* TSS_mismatchTraceName(const Req& req);
 template <class Req, class Rep>
 void TSS_traceMismatch(TraceEvent& event, const Req& req, const Rep& src, const Rep& tss);
 
+// The fraction of requests of this type that are duplicated to the TSS pair and compared. Request types that override
+// this must declare their specialization next to the type, before any load balancing can instantiate it.
+template <class Req>
+double TSS_sampleRate(const Req& req) {
+	return 1.0;
+}
+
 #endif
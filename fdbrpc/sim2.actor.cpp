@@ -329,8 +329,7 @@ struct Sim2Conn final : IConnection, ReferenceCounted<Sim2Conn> {
 		int64_t avail = receivedBytes.get() - readBytes.get(); // SOMEDAY: random?
 		int toRead = std::min<int64_t>(end - begin, avail);
 		ASSERT(toRead >= 0 && toRead <= recvBuf.size() && toRead <= end - begin);
-		for (int i = 0; i < toRead; i++)
-			begin[i] = recvBuf[i];
+		std::copy(recvBuf.begin(), recvBuf.begin() + toRead, begin);
 		recvBuf.erase(recvBuf.begin(), recvBuf.begin() + toRead);
 		readBytes.set(readBytes.get() + toRead);
 		return toRead;
@@ -1283,9 +1282,46 @@ public:
 		}
 	}
 
+	// Real wall clock time and number of tasks run at one priority, with SIM_PROFILE_RUN_LOOP
+	struct TaskProfile {
+		int64_t tasks = 0;
+		double seconds = 0;
+	};
+
+	static void traceRunLoopProfile(Sim2* self,
+	                                double startTime,
+	                                int64_t tasks,
+	                                std::map<TaskPriority, TaskProfile> const& profile) {
+		double elapsed = ::timer_monotonic() - startTime;
+		TraceEvent("SimulationRunLoopStats")
+		    .detail("Tasks", tasks)
+		    .detail("WallSeconds", elapsed)
+		    .detail("SimulatedSeconds", self->time)
+		    .detail("TasksPerSecond", elapsed > 0 ? tasks / elapsed : 0);
+		if (profile.empty()) {
+			return;
+		}
+		// Most expensive priorities first
+		std::vector<std::pair<TaskPriority, TaskProfile>> byTime(profile.begin(), profile.end());
+		std::sort(byTime.begin(), byTime.end(), [](auto const& a, auto const& b) {
+			return a.second.seconds > b.second.seconds;
+		});
+		for (auto const& [priority, p] : byTime) {
+			TraceEvent("SimulationRunLoopProfile")
+			    .detail("Priority", static_cast<int>(priority))
+			    .detail("Tasks", p.tasks)
+			    .detail("Seconds", p.seconds)
+			    .detail("Fraction", elapsed > 0 ? p.seconds / elapsed : 0);
+		}
+	}
+
 	static void runLoop(Sim2* self) {
 		ISimulator::ProcessInfo* callingMachine = self->currentProcess;
 		int lastPrintTime = 0;
+		double startTime = ::timer_monotonic();
+		int64_t tasks = 0;
+		bool profileTasks = FLOW_KNOBS->SIM_PROFILE_RUN_LOOP;
+		std::map<TaskPriority, TaskProfile> profile;
 		while (!self->isStopped) {
 			if (self->taskQueue.canSleep()) {
 				double sleepTime = self->taskQueue.getSleepTime(self->time);
@@ -1307,11 +1343,22 @@ public:
 				self->currentTaskID = self->taskQueue.getReadyTaskID();
 				PromiseTask* task = self->taskQueue.getReadyTask();
 				self->taskQueue.popReadyTask();
-				self->execTask(*task);
+				++tasks;
+				if (profileTasks) {
+					TaskPriority priority = self->currentTaskID;
+					double taskStart = ::timer_monotonic();
+					self->execTask(*task);
+					TaskProfile& p = profile[priority];
+					++p.tasks;
+					p.seconds += ::timer_monotonic() - taskStart;
+				} else {
+					self->execTask(*task);
+				}
 				delete task;
 				self->yielded = false;
 			}
 		}
+		traceRunLoopProfile(self, startTime, tasks, profile);
 		self->currentProcess = callingMachine;
 		for (auto& fn : self->stopCallbacks) {
 			fn();
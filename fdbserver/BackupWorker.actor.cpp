@@ -699,6 +699,27 @@ ACTOR Future<Void> addMutation(Reference<IBackupFile> logFile,
 	return Void();
 }
 
+ACTOR static Future<Void> appendLogBlocks(Reference<IBackupFile> logFile, std::vector<Standalone<StringRef>> blocks) {
+	state int i = 0;
+	for (; i < blocks.size(); i++) {
+		wait(logFile->append(blocks[i].begin(), blocks[i].size()));
+	}
+	return Void();
+}
+
+// Queues a mutation for a PARTITIONED_MLOG_GROUPED_VERSION log file and writes the blocks it completes
+Future<Void> addGroupedMutation(Reference<IBackupFile> logFile,
+                                fileBackup::PartitionedLogBlockEncoder* encoder,
+                                VersionedMessage message,
+                                StringRef mutation) {
+	encoder->add(message.version, mutation);
+	std::vector<Standalone<StringRef>> blocks = encoder->takeBlocks();
+	if (blocks.empty()) {
+		return Void();
+	}
+	return appendLogBlocks(logFile, std::move(blocks));
+}
+
 ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
                                                 std::vector<UID> backupUids,
                                                 std::vector<Reference<IBackupFile>> logFiles) {
@@ -724,7 +745,8 @@ ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
 }
 
 // Saves messages in the range of [0, numMsg) to a file and then remove these
-// messages. The file content format is a sequence of (Version, sub#, msgSize, message).
+// messages. The file content format is a sequence of (Version, sub#, msgSize, message), or with
+// BACKUP_WORKER_GROUPED_LOG_FILES the blocks of fileBackup::PartitionedLogBlockEncoder.
 // Note only ready backups are saved.
 ACTOR Future<Void> saveMutationsToFile(BackupData* self,
                                        Version popVersion,
@@ -734,6 +756,7 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 	state std::vector<Future<Reference<IBackupFile>>> logFileFutures;
 	state std::vector<Reference<IBackupFile>> logFiles;
 	state std::vector<int64_t> blockEnds;
+	state std::vector<fileBackup::PartitionedLogBlockEncoder> encoders; // for grouped log files
 	state std::vector<UID> activeUids; // active Backups' UIDs
 	state std::vector<Version> beginVersions; // logFiles' begin versions
 	state KeyRangeMap<std::set<int>> keyRangeMap; // range to index in logFileFutures, logFiles, & blockEnds
@@ -798,6 +821,13 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 	}
 
 	blockEnds = std::vector<int64_t>(logFiles.size(), 0);
+	if (SERVER_KNOBS->BACKUP_WORKER_GROUPED_LOG_FILES) {
+		CompressionFilter filter =
+		    CompressionUtils::fromFilterString(SERVER_KNOBS->BACKUP_WORKER_LOG_COMPRESSION_FILTER);
+		for (int i = 0; i < logFiles.size(); i++) {
+			encoders.emplace_back(blockSize, filter, SERVER_KNOBS->BACKUP_WORKER_LOG_CHUNK_BYTES);
+		}
+	}
 	for (idx = 0; idx < numMsg; idx++) {
 		auto& message = self->messages[idx];
 		MutationRef m;
@@ -811,7 +841,12 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		std::vector<Future<Void>> adds;
 		if (m.type != MutationRef::Type::ClearRange) {
 			for (int index : keyRangeMap[m.param1]) {
-				if (message.getVersion() >= beginVersions[index]) {
+				if (message.getVersion() < beginVersions[index]) {
+					continue;
+				}
+				if (!encoders.empty()) {
+					adds.push_back(addGroupedMutation(logFiles[index], &encoders[index], message, message.message));
+				} else {
 					adds.push_back(
 					    addMutation(logFiles[index], message, message.message, &blockEnds[index], blockSize));
 				}
@@ -829,7 +864,13 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 				wr << subm;
 				mutations.push_back(wr.toValue());
 				for (int index : range.value()) {
-					if (message.getVersion() >= beginVersions[index]) {
+					if (message.getVersion() < beginVersions[index]) {
+						continue;
+					}
+					if (!encoders.empty()) {
+						adds.push_back(
+						    addGroupedMutation(logFiles[index], &encoders[index], message, mutations.back()));
+					} else {
 						adds.push_back(
 						    addMutation(logFiles[index], message, mutations.back(), &blockEnds[index], blockSize));
 					}
@@ -840,6 +881,15 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		mutations.clear();
 	}
 
+	if (!encoders.empty()) {
+		std::vector<Future<Void>> lastBlocks;
+		for (int i = 0; i < logFiles.size(); i++) {
+			encoders[i].finish();
+			lastBlocks.push_back(appendLogBlocks(logFiles[i], encoders[i].takeBlocks()));
+		}
+		wait(waitForAll(lastBlocks));
+	}
+
 	std::vector<Future<Void>> finished;
 	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
 		return f->finish();
@@ -134,6 +134,13 @@ struct GranuleMetadata : NonCopyable, ReferenceCounted<GranuleMetadata> {
 	bool rdcCandidate;
 	Promise<Void> runRDC;
 
+	// What this granule has cost since its last re-snapshot, reported when it next re-snapshots
+	double lastReadTime = now();
+	int64_t reads = 0;
+	int64_t deltaFiles = 0;
+	int64_t deltaFileBytes = 0;
+	int64_t mergedDeltaBytes = 0;
+
 	void resume() {
 		if (resumeSnapshot.canBeSet()) {
 			resumeSnapshot.send(Void());
@@ -164,7 +171,24 @@ struct GranuleMetadata : NonCopyable, ReferenceCounted<GranuleMetadata> {
 		return bytesWritten * SERVER_KNOBS->BG_RDC_READ_FACTOR < readStats.deltaBytesRead;
 	}
 
+	// A granule nobody is reading buffers more per delta file, so it writes fewer, larger ones
+	bool isReadCold() const { return now() - lastReadTime >= SERVER_KNOBS->BG_COLD_GRANULE_SECONDS; }
+
+	void resetCostStats() {
+		reads = 0;
+		deltaFiles = 0;
+		deltaFileBytes = 0;
+		mergedDeltaBytes = 0;
+	}
+
 	bool updateReadStats(Version readVersion, const BlobGranuleChunkRef& chunk) {
+		lastReadTime = now();
+		reads++;
+		mergedDeltaBytes += chunk.newDeltas.expectedSize();
+		for (auto& it : chunk.deltaFiles) {
+			mergedDeltaBytes += it.length;
+		}
+
 		// Only update stats for re-compacting for at-latest reads that have to do snapshot + delta merge
 		if (!SERVER_KNOBS->BG_ENABLE_READ_DRIVEN_COMPACTION || !chunk.snapshotFile.present() ||
 		    pendingSnapshotVersion != durableSnapshotVersion.get() || readVersion <= pendingSnapshotVersion) {
@@ -2795,11 +2819,23 @@ ACTOR Future<Void> blobGranuleUpdateFiles(Reference<BlobWorkerData> bwData,
 			bool forceFlush = !forceFlushVersions.empty() && forceFlushVersions.back() > metadata->pendingDeltaVersion;
 			bool doEarlyFlush = !metadata->currentDeltas.empty() && metadata->doEarlyReSnapshot();
 			CODE_PROBE(forceFlush, "Force flushing granule");
-			if ((processedAnyMutations && metadata->bufferedDeltaBytes >= writeAmpTarget.getDeltaFileBytes()) ||
-			    forceFlush || doEarlyFlush) {
+			int64_t deltaFileBytes = writeAmpTarget.getDeltaFileBytes();
+			bool readCold = metadata->isReadCold();
+			if (readCold) {
+				deltaFileBytes = std::min<int64_t>(deltaFileBytes * SERVER_KNOBS->BG_COLD_DELTA_FILE_FACTOR,
+				                                   writeAmpTarget.getBytesBeforeCompact());
+			}
+			if ((processedAnyMutations && metadata->bufferedDeltaBytes >= deltaFileBytes) || forceFlush ||
+			    doEarlyFlush) {
 				TraceEvent(SevDebug, "BlobGranuleDeltaFile", bwData->id)
 				    .detail("Granule", metadata->keyRange)
-				    .detail("Version", lastDeltaVersion);
+				    .detail("Version", lastDeltaVersion)
+				    .detail("ReadCold", readCold);
+				if (readCold) {
+					++bwData->stats.coldDeltaFiles;
+				}
+				metadata->deltaFiles++;
+				metadata->deltaFileBytes += metadata->bufferedDeltaBytes;
 
 				// sanity check for version order
 				if (forceFlush || doEarlyFlush) {
@@ -2972,9 +3008,19 @@ ACTOR Future<Void> blobGranuleUpdateFiles(Reference<BlobWorkerData> bwData,
 
 				metadata->pendingSnapshotVersion = metadata->pendingDeltaVersion;
 
+				TraceEvent(SevDebug, "BlobGranuleCost", bwData->id)
+				    .detail("Granule", metadata->keyRange)
+				    .detail("Reads", metadata->reads)
+				    .detail("MergedDeltaBytes", metadata->mergedDeltaBytes)
+				    .detail("DeltaFiles", metadata->deltaFiles)
+				    .detail("DeltaFileBytes", metadata->deltaFileBytes)
+				    .detail("ReadCold", metadata->isReadCold())
+				    .detail("ReadDriven", metadata->rdcCandidate);
+
 				// reset metadata
 				metadata->bytesInNewDeltaFiles = 0;
 				metadata->resetReadStats();
+				metadata->resetCostStats();
 
 				// If we have more than one snapshot file and that file is unblocked (committedVersion >=
 				// snapshotVersion), wait for it to finish. Otherwise, we might write way too many delta files that then
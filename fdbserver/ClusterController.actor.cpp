@@ -1333,6 +1333,34 @@ ACTOR Future<Void> timeKeeper(ClusterControllerData* self) {
 	}
 }
 
+// Replies to req with the sections of status it asked for. A sectioned reply also keeps the cluster messages and the
+// time the status was generated, so that a reply from the cache can be told apart from a fresh one.
+static void sendStatusReply(StatusRequest const& req, StatusReply const& status, Optional<StatusObject>& parsedStatus) {
+	if (req.sections.empty()) {
+		req.reply.send(status);
+		return;
+	}
+	if (!parsedStatus.present()) {
+		json_spirit::mValue mv;
+		json_spirit::read_string(status.statusStr, mv);
+		parsedStatus = mv.type() == json_spirit::obj_type ? StatusObject(mv.get_obj()) : StatusObject();
+	}
+	StatusObject sections;
+	for (auto const& section : req.sections) {
+		auto it = parsedStatus.get().find(section);
+		if (it != parsedStatus.get().end()) {
+			sections[section] = it->second;
+		}
+	}
+	for (auto const& field : { "messages", "cluster_controller_timestamp" }) {
+		auto it = parsedStatus.get().find(field);
+		if (it != parsedStatus.get().end()) {
+			sections[field] = it->second;
+		}
+	}
+	req.reply.send(StatusReply(sections));
+}
+
 ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
                                 ClusterControllerData* self,
                                 ServerCoordinators coordinators,
@@ -1343,11 +1371,21 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 	// Place to accumulate a batch of requests to respond to
 	state std::vector<StatusRequest> requests_batch;
 
+	// The last status generated, which requests are answered from for up to STATUS_CACHE_MAX_AGE seconds. It is only
+	// parsed if a request asks for some of its sections.
+	state Optional<StatusReply> cachedStatus;
+	state Optional<StatusObject> cachedStatusParsed;
+
 	loop {
 		try {
 			// Wait til first request is ready
 			StatusRequest req = waitNext(requests);
 			++self->statusRequests;
+			if (cachedStatus.present() && now() - last_request_time < SERVER_KNOBS->STATUS_CACHE_MAX_AGE) {
+				++self->cachedStatusReplies;
+				sendStatusReply(req, cachedStatus.get(), cachedStatusParsed);
+				continue;
+			}
 			requests_batch.push_back(req);
 
 			// Earliest time at which we may begin a new request
@@ -1414,12 +1452,18 @@ ACTOR Future<Void> statusServer(FutureStream<StatusRequest> requests,
 			// Update last_request_time now because GetStatus is finished and the delay is to be measured between
 			// requests
 			last_request_time = now();
+			cachedStatusParsed.reset();
+			if (result.isError()) {
+				cachedStatus.reset();
+			} else {
+				cachedStatus = result.get();
+			}
 
 			while (!requests_batch.empty()) {
 				if (result.isError())
 					requests_batch.back().reply.sendError(result.getError());
 				else
-					requests_batch.back().reply.send(result.get());
+					sendStatusReply(requests_batch.back(), result.get(), cachedStatusParsed);
 				requests_batch.pop_back();
 				wait(yield());
 			}
@@ -958,6 +958,7 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 		    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 		return Never();
 	} else {
+		self->enterRecoveryPhase(RecoveryStatus::recruiting_transaction_servers);
 		TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(),
 		           self->dbgid)
 		    .detail("StatusCode", RecoveryStatus::recruiting_transaction_servers)
@@ -1008,6 +1009,7 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 	}
 	self->backupWorkers.swap(recruits.backupWorkers);
 
+	self->enterRecoveryPhase(RecoveryStatus::initializing_transaction_servers);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::initializing_transaction_servers)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::initializing_transaction_servers])
@@ -1028,17 +1030,20 @@ ACTOR Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 	// up so that the recruitment part happens above (in parallel with recruiting the transaction servers?).
 	wait(newSeedServers(self, recruits, seedServers));
 	state std::vector<Standalone<CommitTransactionRef>> confChanges;
-	wait(newCommitProxies(self, recruits) && newGrvProxies(self, recruits) && newResolvers(self, recruits) &&
-	     newTLogServers(self, recruits, oldLogSystem, &confChanges));
+	// Locking in the new TLogs is usually the slowest part. It sets primaryLocality before its first wait, and the
+	// sequencer needs nothing else from it, so the sequencer is updated as soon as the proxies and resolvers are up.
+	state Future<Void> newTLogs = newTLogServers(self, recruits, oldLogSystem, &confChanges);
+	wait(newCommitProxies(self, recruits) && newGrvProxies(self, recruits) && newResolvers(self, recruits));
 
 	// Update recovery related information to the newly elected sequencer (master) process.
-	wait(brokenPromiseToNever(
-	    self->masterInterface.updateRecoveryData.getReply(UpdateRecoveryDataRequest(self->recoveryTransactionVersion,
-	                                                                                self->lastEpochEnd,
-	                                                                                self->commitProxies,
-	                                                                                self->resolvers,
-	                                                                                self->versionEpoch,
-	                                                                                self->primaryLocality))));
+	wait(brokenPromiseToNever(self->masterInterface.updateRecoveryData.getReply(
+	         UpdateRecoveryDataRequest(self->recoveryTransactionVersion,
+	                                   self->lastEpochEnd,
+	                                   self->commitProxies,
+	                                   self->resolvers,
+	                                   self->versionEpoch,
+	                                   self->primaryLocality))) &&
+	     newTLogs);
 
 	return confChanges;
 }
@@ -1383,6 +1388,7 @@ ACTOR Future<Void> recoverFrom(Reference<ClusterRecoveryData> self,
                                std::vector<StorageServerInterface>* seedServers,
                                std::vector<Standalone<CommitTransactionRef>>* initialConfChanges,
                                Future<Version> poppedTxsVersion) {
+	self->enterRecoveryPhase(RecoveryStatus::reading_transaction_system_state);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::reading_transaction_system_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::reading_transaction_system_state])
@@ -1473,6 +1479,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	TraceEvent(recoveryInterval.begin(), self->dbgid).log();
 
 	self->recoveryState = RecoveryState::READING_CSTATE;
+	self->enterRecoveryPhase(RecoveryStatus::reading_coordinated_state);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::reading_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::reading_coordinated_state])
@@ -1492,6 +1499,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	}
 
 	self->recoveryState = RecoveryState::LOCKING_CSTATE;
+	self->enterRecoveryPhase(RecoveryStatus::locking_coordinated_state);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::locking_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::locking_coordinated_state])
@@ -1612,6 +1620,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	ASSERT_GE(self->resolvers.size(), 1);
 
 	self->recoveryState = RecoveryState::RECOVERY_TRANSACTION;
+	self->enterRecoveryPhase(RecoveryStatus::recovery_transaction);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::recovery_transaction)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::recovery_transaction])
@@ -1739,6 +1748,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	ASSERT(self->recoveryTransactionVersion != 0);
 
 	self->recoveryState = RecoveryState::WRITING_CSTATE;
+	self->enterRecoveryPhase(RecoveryStatus::writing_coordinated_state);
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::writing_coordinated_state)
 	    .detail("Status", RecoveryStatus::names[RecoveryStatus::writing_coordinated_state])
@@ -1774,13 +1784,24 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	    .detail("RecoveryTransactionVersion", self->recoveryTransactionVersion);
 
 	self->recoveryState = RecoveryState::ACCEPTING_COMMITS;
+	self->enterRecoveryPhase(RecoveryStatus::accepting_commits);
 	double recoveryDuration = now() - recoverStartTime;
 
-	TraceEvent((recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
-	           getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
-	           self->dbgid)
-	    .detail("RecoveryDuration", recoveryDuration)
-	    .trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	{
+		TraceEvent durationEvent(
+		    (recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
+		    getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
+		    self->dbgid);
+		durationEvent.detail("RecoveryDuration", recoveryDuration);
+		// Details named by the recovery status, e.g. recruiting_transaction_servers, for the phases this recovery
+		// went through; status reports them as recovery_state.last_recovery_phase_seconds
+		for (int phase = 0; phase < RecoveryStatus::accepting_commits; phase++) {
+			if (self->recoveryPhaseSeconds[phase] > 0) {
+				durationEvent.detail(RecoveryStatus::names[phase], self->recoveryPhaseSeconds[phase]);
+			}
+		}
+		durationEvent.trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	}
 
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::accepting_commits)
@@ -206,6 +206,7 @@ struct ResolutionRequestBuilder {
 		DisabledTraceEvent("AddTransaction", self->dbgid).detail("TenantMode", (int)self->getTenantMode());
 		bool needParseTenantId = !trRequest.tenantInfo.hasTenant() && self->getTenantMode() == TenantMode::REQUIRED;
 		VectorRef<int64_t> tenantIds;
+		int appends = 0;
 		for (auto& m : trIn.mutations) {
 			DEBUG_MUTATION("AddTr", ver, m, self->dbgid).detail("Idx", transactionNumberInBatch);
 			if (m.type == MutationRef::SetVersionstampedKey) {
@@ -213,6 +214,11 @@ struct ResolutionRequestBuilder {
 				trIn.write_conflict_ranges.push_back(requests[0].arena, singleKeyRange(m.param1, requests[0].arena));
 			} else if (m.type == MutationRef::SetVersionstampedValue) {
 				transformVersionstampMutation(m, &MutationRef::param2, requests[0].version, transactionNumberInBatch);
+			} else if (m.type == MutationRef::AppendVersionstamped) {
+				// Clients limit a transaction to MAX_APPENDS_PER_TRANSACTION appends, so the sequence does not wrap
+				transformAppendMutation(
+				    m, trRequest.arena, requests[0].version, transactionNumberInBatch, (uint16_t)appends++);
+				trIn.write_conflict_ranges.push_back(requests[0].arena, singleKeyRange(m.param1, requests[0].arena));
 			}
 			if (isMetadataMutation(m)) {
 				isTXNStateTransaction = true;
@@ -608,6 +614,7 @@ struct CommitBatchContext {
 	int currentBatchMemBytesCount;
 
 	double startTime;
+	double resolutionLatency = 0;
 
 	Optional<UID> debugID;
 
@@ -685,8 +692,12 @@ struct CommitBatchContext {
 
 	// Cipher keys to be used to encrypt mutations
 	std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys;
+	// Ciphers set up from cipherKeys, reused for all mutations of the batch in the same encryption domain
+	std::unordered_map<EncryptCipherDomainId, Reference<EncryptBlobCipherAes265Ctr>> mutationCiphers;
 
 	IdempotencyIdKVBuilder idempotencyKVBuilder;
+	// For each idempotency key written by the batch, the key directly before it, if known
+	std::unordered_map<uint8_t, Optional<std::pair<Version, uint8_t>>> idempotencyKeyPredecessors;
 
 	CommitBatchContext(ProxyCommitData*, const std::vector<CommitTransactionRequest>*, const int);
 
@@ -694,6 +705,9 @@ struct CommitBatchContext {
 
 	std::set<Tag> getWrittenTagsPreResolution();
 
+	// Records the time the batch spent in one stage of the commit pipeline, and tags the batch span with it
+	void recordStageLatency(const Reference<Histogram>& dist, LatencySample& sample, StringRef stage, double seconds);
+
 private:
 	void evaluateBatchSize();
 };
@@ -742,6 +756,15 @@ std::set<Tag> CommitBatchContext::getWrittenTagsPreResolution() {
 	return transactionTags;
 }
 
+void CommitBatchContext::recordStageLatency(const Reference<Histogram>& dist,
+                                            LatencySample& sample,
+                                            StringRef stage,
+                                            double seconds) {
+	dist->sampleSeconds(seconds);
+	sample.addMeasurement(seconds);
+	span.addAttribute(stage, StringRef(format("%.6f", seconds)));
+}
+
 CommitBatchContext::CommitBatchContext(ProxyCommitData* const pProxyCommitData_,
                                        const std::vector<CommitTransactionRequest>* trs_,
                                        const int currentBatchMemBytesCount)
@@ -834,7 +857,10 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 	wait(pProxyCommitData->latestLocalCommitBatchResolving.whenAtLeast(localBatchNumber - 1));
 	pProxyCommitData->stats.computeLatency.addMeasurement(now() - timeStart);
 	double queuingDelay = g_network->now() - timeStart;
-	pProxyCommitData->stats.commitBatchQueuingDist->sampleSeconds(queuingDelay);
+	self->recordStageLatency(pProxyCommitData->stats.commitBatchQueuingDist,
+	                         pProxyCommitData->stats.commitBatchQueuingLatency,
+	                         "BatchQueuing"_sr,
+	                         queuingDelay);
 	if ((queuingDelay > (double)SERVER_KNOBS->MAX_READ_TRANSACTION_LIFE_VERSIONS / SERVER_KNOBS->VERSIONS_PER_SECOND ||
 	     (g_network->isSimulated() && BUGGIFY_WITH_PROB(0.01))) &&
 	    SERVER_KNOBS->PROXY_REJECT_BATCH_QUEUED_TOO_LONG && canReject(trs)) {
@@ -883,7 +909,10 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 
 	pProxyCommitData->stats.txnCommitVersionAssigned += trs.size();
 	pProxyCommitData->stats.lastCommitVersionAssigned = versionReply.version;
-	pProxyCommitData->stats.getCommitVersionDist->sampleSeconds(now() - beforeGettingCommitVersion);
+	self->recordStageLatency(pProxyCommitData->stats.getCommitVersionDist,
+	                         pProxyCommitData->stats.getCommitVersionLatency,
+	                         "GetCommitVersion"_sr,
+	                         now() - beforeGettingCommitVersion);
 
 	self->commitVersion = versionReply.version;
 	self->prevVersion = versionReply.prevVersion;
@@ -1036,7 +1065,11 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 	std::vector<ResolveTransactionBatchReply> resolutionResp = wait(getAll(replies));
 	self->resolution.swap(*const_cast<std::vector<ResolveTransactionBatchReply>*>(&resolutionResp));
 
-	self->pProxyCommitData->stats.resolutionDist->sampleSeconds(now() - resolutionStart);
+	self->resolutionLatency = now() - resolutionStart;
+	self->recordStageLatency(self->pProxyCommitData->stats.resolutionDist,
+	                         self->pProxyCommitData->stats.resolutionLatency,
+	                         "Resolution"_sr,
+	                         self->resolutionLatency);
 	if (self->debugID.present()) {
 		g_traceBatch.addEvent(
 		    "CommitDebug", self->debugID.get().first(), "CommitProxyServer.commitBatch.AfterResolution");
@@ -1355,6 +1388,48 @@ TEST_CASE("/CommitProxy/SplitRange/replaceRawClearRanges") {
 	return Void();
 }
 
+TEST_CASE("/CommitProxy/KeyInfoIndex/find") {
+	KeyRangeMap<ServerCacheInfo> keyInfo;
+	std::vector<KeyRangeRef> ranges = { KeyRangeRef("b"_sr, "d"_sr),
+		                                KeyRangeRef("abcdefgh1"_sr, "abcdefgh3"_sr),
+		                                KeyRangeRef("abcdefgh3"_sr, "abcdefgh3\x00"_sr),
+		                                KeyRangeRef("x"_sr, "\xff"_sr) };
+	for (int i = 0; i < ranges.size(); i++) {
+		ServerCacheInfo info;
+		info.tags.push_back(Tag(0, i + 1));
+		keyInfo.insert(ranges[i], info);
+	}
+
+	KeyInfoIndex index;
+	ASSERT(index.find("b"_sr) == nullptr);
+	Standalone<VectorRef<KeyRef>> begins;
+	std::vector<ServerCacheInfo*> values;
+	for (auto it = keyInfo.ranges().begin(); it != keyInfo.ranges().end(); ++it) {
+		begins.push_back_deep(begins.arena(), it.begin());
+		values.push_back(&it.value());
+	}
+	index.install(begins, std::move(values));
+
+	std::vector<KeyRef> keys = { ""_sr,          "a"_sr,          "abcdefgh"_sr,   "abcdefgh1"_sr, "abcdefgh2"_sr,
+		                         "abcdefgh3"_sr, "abcdefgh3\x00"_sr, "abcdefgh4"_sr, "c"_sr,         "d"_sr,
+		                         "w\xff"_sr,     "x"_sr,          "\xfe"_sr };
+	for (auto& k : keys) {
+		ASSERT(index.find(k) == &keyInfo.rangeContaining(k).value());
+	}
+
+	// Keys in ranges touching a change are left to keyInfo
+	index.keyInfoChanged(KeyRangeRef("c"_sr, "e"_sr));
+	ASSERT(index.find("a"_sr) == &keyInfo.rangeContaining("a"_sr).value());
+	ASSERT(index.find("b"_sr) == nullptr);
+	ASSERT(index.find("d"_sr) == nullptr);
+	ASSERT(index.find("x"_sr) == &keyInfo.rangeContaining("x"_sr).value());
+	ASSERT(index.needsRebuild());
+
+	index.invalidate();
+	ASSERT(index.find("a"_sr) == nullptr);
+	return Void();
+}
+
 // Return success and properly split clear range mutations if all tenant check pass. Otherwise, return corresponding
 // error
 Error validateAndProcessTenantAccess(Arena& arena,
@@ -1719,6 +1794,27 @@ ACTOR Future<WriteMutationRefVar> writeMutationEncryptedMutation(CommitBatchCont
 	return encryptedMutation;
 }
 
+// Returns the cipher used to encrypt the batch's TLog mutations for the given domain, creating it on first use. Setting
+// up the cipher context is a significant part of encrypting a small mutation, so it is done once per domain per batch
+// and each mutation only restarts the cipher stream with its own IV.
+Reference<EncryptBlobCipherAes265Ctr> getMutationCipher(CommitBatchContext* self, EncryptCipherDomainId domainId) {
+	auto& cipher = self->mutationCiphers[domainId];
+	if (!cipher.isValid()) {
+		Reference<BlobCipherKey> headerCipherKey;
+		if (FLOW_KNOBS->ENCRYPT_HEADER_AUTH_TOKEN_ENABLED) {
+			auto it = self->cipherKeys.find(ENCRYPT_HEADER_DOMAIN_ID);
+			ASSERT(it != self->cipherKeys.end() && it->second.isValid());
+			headerCipherKey = it->second;
+		}
+		cipher = makeReference<EncryptBlobCipherAes265Ctr>(
+		    self->cipherKeys[domainId],
+		    headerCipherKey,
+		    getEncryptAuthTokenMode(EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_SINGLE),
+		    BlobCipherMetrics::TLOG);
+	}
+	return cipher;
+}
+
 Future<WriteMutationRefVar> writeMutation(CommitBatchContext* self,
                                           int64_t domainId,
                                           const MutationRef* mutation,
@@ -1762,7 +1858,11 @@ Future<WriteMutationRefVar> writeMutation(CommitBatchContext* self,
 			}
 			ASSERT_NE(domainId, INVALID_ENCRYPT_DOMAIN_ID);
 			ASSERT(self->cipherKeys.count(domainId) > 0);
-			encryptedMutation = mutation->encrypt(self->cipherKeys, domainId, *arena, BlobCipherMetrics::TLOG);
+			if (SERVER_KNOBS->PROXY_REUSE_MUTATION_ENCRYPT_CIPHERS) {
+				encryptedMutation = mutation->encrypt(*getMutationCipher(self, domainId), *arena);
+			} else {
+				encryptedMutation = mutation->encrypt(self->cipherKeys, domainId, *arena, BlobCipherMetrics::TLOG);
+			}
 		}
 		ASSERT(encryptedMutation.isEncrypted());
 		CODE_PROBE(true, "encrypting non-metadata mutations");
@@ -2052,7 +2152,10 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	CODE_PROBE(queuedCommits, "Queuing post-resolution commit processing");
 	wait(pProxyCommitData->latestLocalCommitBatchLogging.whenAtLeast(localBatchNumber - 1));
 	state double postResolutionQueuing = now();
-	pProxyCommitData->stats.postResolutionDist->sampleSeconds(postResolutionQueuing - postResolutionStart);
+	self->recordStageLatency(pProxyCommitData->stats.postResolutionDist,
+	                         pProxyCommitData->stats.postResolutionQueuingLatency,
+	                         "PostResolutionQueuing"_sr,
+	                         postResolutionQueuing - postResolutionStart);
 	wait(yield(TaskPriority::ProxyCommitYield1));
 
 	self->computeStart = g_network->timer();
@@ -2112,6 +2215,12 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 		                        &self->computeStart));
 	}
 
+	// Batches reach this point in commit version order, so keys written here directly follow the last one this proxy
+	// wrote unless another proxy's batch was given a version in between
+	if (self->prevVersion != pProxyCommitData->lastIdempotencyBatchVersion) {
+		pProxyCommitData->lastIdempotencyKey.reset();
+	}
+	pProxyCommitData->lastIdempotencyBatchVersion = self->commitVersion;
 	buildIdempotencyIdMutations(self->trs,
 	                            self->idempotencyKVBuilder,
 	                            self->commitVersion,
@@ -2119,6 +2228,12 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	                            ConflictBatch::TransactionCommitted,
 	                            self->locked,
 	                            [&](const KeyValue& kv) {
+		                            Version version;
+		                            uint8_t highOrderBatchIndex;
+		                            decodeIdempotencyKey(kv.key, version, highOrderBatchIndex);
+		                            self->idempotencyKeyPredecessors[highOrderBatchIndex] =
+		                                pProxyCommitData->lastIdempotencyKey;
+		                            pProxyCommitData->lastIdempotencyKey = std::make_pair(version, highOrderBatchIndex);
 		                            MutationRef idempotencyIdSet;
 		                            idempotencyIdSet.type = MutationRef::Type::SetValue;
 		                            idempotencyIdSet.param1 = kv.key;
@@ -2136,17 +2251,19 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 			                            self->toCommit.writeTypedMessage(idempotencyIdSet);
 		                            }
 	                            });
+	// Take the queued clears so that the expire server cannot extend one of them while it is being written
+	state Standalone<VectorRef<MutationRef>> idempotencyClears = std::move(pProxyCommitData->idempotencyClears);
+	pProxyCommitData->idempotencyClears = Standalone<VectorRef<MutationRef>>();
 	state int i = 0;
-	for (i = 0; i < pProxyCommitData->idempotencyClears.size(); i++) {
-		auto& tags = pProxyCommitData->tagsForKey(pProxyCommitData->idempotencyClears[i].param1);
+	for (i = 0; i < idempotencyClears.size(); i++) {
+		auto& tags = pProxyCommitData->tagsForKey(idempotencyClears[i].param1);
 		self->toCommit.addTags(tags);
 		// We already have an arena with an appropriate lifetime handy
-		Arena& arena = pProxyCommitData->idempotencyClears.arena();
-		WriteMutationRefVar var = wait(writeMutation(
-		    self, SYSTEM_KEYSPACE_ENCRYPT_DOMAIN_ID, &pProxyCommitData->idempotencyClears[i], nullptr, &arena));
+		Arena& arena = idempotencyClears.arena();
+		WriteMutationRefVar var =
+		    wait(writeMutation(self, SYSTEM_KEYSPACE_ENCRYPT_DOMAIN_ID, &idempotencyClears[i], nullptr, &arena));
 		ASSERT(std::holds_alternative<MutationRef>(var));
 	}
-	pProxyCommitData->idempotencyClears = Standalone<VectorRef<MutationRef>>();
 
 	self->toCommit.saveTags(self->writtenTags);
 
@@ -2231,6 +2348,13 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
 		tpcvMap = self->tpcvMap;
 	}
+	if (SERVER_KNOBS->ENABLE_VERSION_VECTOR_TLOG_UNICAST) {
+		pProxyCommitData->stats.tLogPushes += tpcvMap.get().size();
+		pProxyCommitData->stats.tLogPushesAvoided +=
+		    std::max<int64_t>(0, pProxyCommitData->localTLogCount - tpcvMap.get().size());
+	} else {
+		pProxyCommitData->stats.tLogPushes += pProxyCommitData->localTLogCount;
+	}
 	self->loggingComplete = pProxyCommitData->logSystem->push(self->prevVersion,
 	                                                          self->commitVersion,
 	                                                          pProxyCommitData->committedVersion.get(),
@@ -2284,7 +2408,10 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 		}
 	}
 
-	pProxyCommitData->stats.processingMutationDist->sampleSeconds(now() - postResolutionQueuing);
+	self->recordStageLatency(pProxyCommitData->stats.processingMutationDist,
+	                         pProxyCommitData->stats.processingMutationLatency,
+	                         "ProcessingMutation"_sr,
+	                         now() - postResolutionQueuing);
 	return Void();
 }
 
@@ -2323,7 +2450,13 @@ ACTOR Future<Void> transactionLogging(CommitBatchContext* self) {
 		pProxyCommitData->txsPopVersions.emplace_back(self->commitVersion, self->msg.popTo);
 	}
 	pProxyCommitData->logSystem->popTxs(self->msg.popTo);
-	pProxyCommitData->stats.tlogLoggingDist->sampleSeconds(now() - tLoggingStart);
+	self->recordStageLatency(pProxyCommitData->stats.tlogLoggingDist,
+	                         pProxyCommitData->stats.tlogLoggingLatency,
+	                         "TLogLogging"_sr,
+	                         now() - tLoggingStart);
+	if (pProxyCommitData->commitBatchIntervalController.enabled()) {
+		pProxyCommitData->commitBatchIntervalController.addPipelineLatency(self->resolutionLatency + now() - tLoggingStart);
+	}
 	return Void();
 }
 
@@ -2451,8 +2584,13 @@ ACTOR Future<Void> reply(CommitBatchContext* self) {
 	}
 
 	for (auto [highOrderBatchIndex, count] : idCountsForKey) {
-		pProxyCommitData->expectedIdempotencyIdCountForKey.send(
-		    ExpectedIdempotencyIdCountForKey{ self->commitVersion, count, highOrderBatchIndex });
+		auto predecessor = self->idempotencyKeyPredecessors.find(highOrderBatchIndex);
+		pProxyCommitData->expectedIdempotencyIdCountForKey.send(ExpectedIdempotencyIdCountForKey{
+		    self->commitVersion,
+		    count,
+		    highOrderBatchIndex,
+		    predecessor != self->idempotencyKeyPredecessors.end() ? predecessor->second
+		                                                          : Optional<std::pair<Version, uint8_t>>() });
 	}
 
 	++pProxyCommitData->stats.commitBatchOut;
@@ -2492,18 +2630,21 @@ ACTOR Future<Void> reply(CommitBatchContext* self) {
 	// Dynamic batching for commits
 	double target_latency =
 	    (now() - self->startTime) * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_LATENCY_FRACTION;
-	pProxyCommitData->commitBatchInterval =
+	pProxyCommitData->commitBatchInterval = pProxyCommitData->commitBatchIntervalController.limit(
 	    std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
 	             std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX,
 	                      target_latency * SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA +
 	                          pProxyCommitData->commitBatchInterval *
-	                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA)));
+	                              (1 - SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_SMOOTHER_ALPHA))));
 
 	pProxyCommitData->stats.commitBatchingWindowSize.addMeasurement(pProxyCommitData->commitBatchInterval);
 	pProxyCommitData->commitBatchesMemBytesCount -= self->currentBatchMemBytesCount;
 	ASSERT_ABORT(pProxyCommitData->commitBatchesMemBytesCount >= 0);
 	wait(self->releaseFuture);
-	pProxyCommitData->stats.replyCommitDist->sampleSeconds(now() - replyStart);
+	self->recordStageLatency(pProxyCommitData->stats.replyCommitDist,
+	                         pProxyCommitData->stats.replyCommitLatency,
+	                         "ReplyCommit"_sr,
+	                         now() - replyStart);
 	return Void();
 }
 
@@ -3095,6 +3236,7 @@ struct ExpireServerEntry {
 	int expectedCount = 0;
 	int receivedCount = 0;
 	bool initialized = false;
+	Optional<std::pair<Version, uint8_t>> previous;
 };
 
 struct IdempotencyKey {
@@ -3130,6 +3272,7 @@ ACTOR static Future<Void> idempotencyIdsExpireServer(
 	state int64_t purgeBefore;
 	state IdempotencyKey key;
 	state ExpireServerEntry* status = nullptr;
+	state Optional<std::pair<Version, uint8_t>> lastQueuedClear;
 	state Future<Void> purgeOld = Void();
 	loop {
 		choose {
@@ -3147,6 +3290,7 @@ ACTOR static Future<Void> idempotencyIdsExpireServer(
 				status = &idStatus[key];
 				ASSERT_EQ(status->expectedCount, 0);
 				status->expectedCount = req.idempotencyIdCount;
+				status->previous = req.previousKey;
 			}
 			when(wait(purgeOld)) {
 				purgeOld = delay(SERVER_KNOBS->IDEMPOTENCY_ID_IN_MEMORY_LIFETIME);
@@ -3168,8 +3312,16 @@ ACTOR static Future<Void> idempotencyIdsExpireServer(
 			if (status->receivedCount == status->expectedCount) {
 				auto keyRange =
 				    makeIdempotencySingleKeyRange(idempotencyClears->arena(), key.version, key.highOrderBatchIndex);
-				idempotencyClears->push_back(idempotencyClears->arena(),
-				                             MutationRef(MutationRef::ClearRange, keyRange.begin, keyRange.end));
+				if (!idempotencyClears->empty() && lastQueuedClear.present() && status->previous.present() &&
+				    lastQueuedClear.get() == status->previous.get()) {
+					// Nothing lies between the end of the last queued clear and this key, so one clear covers both
+					CODE_PROBE(true, "Coalescing idempotency id clears");
+					idempotencyClears->back().param2 = keyRange.end;
+				} else {
+					idempotencyClears->push_back(idempotencyClears->arena(),
+					                             MutationRef(MutationRef::ClearRange, keyRange.begin, keyRange.end));
+				}
+				lastQueuedClear = std::make_pair(key.version, key.highOrderBatchIndex);
 				idStatus.erase(key);
 			}
 		} else {
@@ -3281,6 +3433,7 @@ ACTOR Future<Void> processCompleteTransactionStateRequest(TransactionStateResolv
 		// insert keyTag data separately from metadata mutations so that we can do one bulk insert which
 		// avoids a lot of map lookups.
 		pContext->pCommitData->keyInfo.rawInsert(keyInfoData);
+		pContext->pCommitData->keyInfoIndex.invalidate();
 
 		Arena arena;
 		bool confChanges;
@@ -3343,11 +3496,18 @@ ACTOR Future<Void> processTransactionStateRequestPart(TransactionStateResolveCon
 	pContext->pTxnStateStore->commit(true);
 
 	if (pContext->receivedSequences.size() == pContext->maxSequence) {
-		// Received all components of the txnStateRequest
+		// Received all components of the txnStateRequest. Pass the part on before processing the state, so that the
+		// proxies and resolvers further down the broadcast tree process it at the same time as this one, but only
+		// acknowledge it once this proxy is done too.
 		ASSERT(!pContext->processed);
+		state ReplyPromise<Void> reply = request.reply;
+		state Future<Void> forwarded = broadcastTxnRequest(request, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, false);
 		pContext->txnRecovery = processCompleteTransactionStateRequest(pContext);
 		wait(pContext->txnRecovery);
 		pContext->processed = true;
+		wait(forwarded);
+		reply.send(Void());
+		return Void();
 	}
 
 	pContext->pActors->send(broadcastTxnRequest(request, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, true));
@@ -3357,6 +3517,43 @@ ACTOR Future<Void> processTransactionStateRequestPart(TransactionStateResolveCon
 
 } // anonymous namespace
 
+// Periodically rebuilds commitData->keyInfoIndex from keyInfo once keyInfo has changed. Copying keyInfo yields every so
+// often, and starts over later if keyInfo changes in the meantime.
+ACTOR Future<Void> rebuildKeyInfoIndex(ProxyCommitData* commitData) {
+	loop {
+		wait(delay(SERVER_KNOBS->PROXY_KEY_INFO_INDEX_REBUILD_INTERVAL));
+		if (!commitData->keyInfoIndex.needsRebuild() || !commitData->validState.isSet()) {
+			continue;
+		}
+
+		state double startTime = now();
+		state uint64_t changes = commitData->keyInfoIndex.changes;
+		state Standalone<VectorRef<KeyRef>> begins;
+		state std::vector<ServerCacheInfo*> values;
+		state KeyRangeMap<ServerCacheInfo>::iterator it = commitData->keyInfo.ranges().begin();
+		state int copied = 0;
+		for (; it != commitData->keyInfo.ranges().end(); ++it) {
+			begins.push_back_deep(begins.arena(), it.begin());
+			values.push_back(&it.value());
+			if (++copied % SERVER_KNOBS->PROXY_KEY_INFO_INDEX_REBUILD_BATCH == 0) {
+				wait(yield(TaskPriority::DefaultDelay));
+				if (commitData->keyInfoIndex.changes != changes) {
+					break;
+				}
+			}
+		}
+
+		if (commitData->keyInfoIndex.changes != changes) {
+			CODE_PROBE(true, "Key info index rebuild raced with a change to keyInfo");
+			continue;
+		}
+		commitData->keyInfoIndex.install(begins, std::move(values));
+		TraceEvent(SevDebug, "KeyInfoIndexRebuilt", commitData->dbgid)
+		    .detail("Ranges", copied)
+		    .detail("Duration", now() - startTime);
+	}
+}
+
 ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
                                          MasterInterface master,
                                          LifetimeToken masterLifetime,
@@ -3447,6 +3644,9 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 	addActor.send(rejoinServer(proxy, &commitData));
 	addActor.send(ddMetricsRequestServer(proxy, db));
 	addActor.send(reportTxnTagCommitCost(proxy.id(), db, &commitData.ssTrTagCommitCost));
+	if (SERVER_KNOBS->PROXY_KEY_INFO_INDEX_REBUILD_INTERVAL > 0) {
+		addActor.send(rebuildKeyInfoIndex(&commitData));
+	}
 
 	auto openDb = openDBOnServer(db);
 
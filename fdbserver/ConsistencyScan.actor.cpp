@@ -353,6 +353,22 @@ ACTOR Future<int64_t> getDatabaseSize(Database cx) {
 // Checks that the data in each shard is the same on each storage server that it resides on.  Also performs some
 // sanity checks on the sizes of shards and storage servers. Returns false if there is a failure
 // TODO: Future optimization: Use streaming reads
+// How much less of the rate limit a read from the given storage servers is charged: 1 once any of them is busy, rising
+// to CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER as they all become idle. Servers missing from the metrics count as busy.
+static double idleRateMultiplier(HealthMetrics const& metrics, std::vector<UID> const& servers) {
+	double load = 0;
+	for (auto const& id : servers) {
+		auto stats = metrics.storageStats.find(id);
+		if (stats == metrics.storageStats.end()) {
+			return 1.0;
+		}
+		load = std::max({ load,
+		                  stats->second.cpuUsage / SERVER_KNOBS->CONSISTENCY_SCAN_BUSY_CPU_PERCENT,
+		                  double(stats->second.storageQueue) / SERVER_KNOBS->CONSISTENCY_SCAN_BUSY_STORAGE_QUEUE });
+	}
+	return 1.0 + (SERVER_KNOBS->CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER - 1.0) * std::max(0.0, 1.0 - load);
+}
+
 ACTOR Future<bool> checkDataConsistency(Database cx,
                                         VectorRef<KeyValueRef> keyLocations,
                                         DatabaseConfiguration configuration,
@@ -534,12 +550,19 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 
 			state KeySelector begin = firstGreaterOrEqual(range.begin);
 			state Transaction onErrorTr(cx); // This transaction exists only to access onError and its backoff behavior
+			// Set after the checksums of a batch did not match, to read it again in full from every replica
+			state bool fullReadRetry = false;
+			state Future<HealthMetrics> healthMetrics;
 
 			// Read a limited number of entries at a time, repeating until all keys in the shard have been read
 			loop {
 				try {
 					lastSampleKey = lastStartSampleKey;
 
+					if (SERVER_KNOBS->CONSISTENCY_SCAN_IDLE_RATE_MULTIPLIER > 1.0) {
+						healthMetrics = cx->getHealthMetrics(true);
+					}
+
 					// Get the min version of the storage servers
 					Version version = wait(getVersion(cx));
 
@@ -554,9 +577,12 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 					// Try getting the entries in the specified range
 					state std::vector<Future<ErrorOr<GetKeyValuesReply>>> keyValueFutures;
 					state int j = 0;
+					// All but the first replica reply with a checksum of the rows, compared to that of the first's rows
+					bool compareChecksums = SERVER_KNOBS->CONSISTENCY_SCAN_COMPARE_CHECKSUMS && !fullReadRetry;
 					TraceEvent("ConsistencyCheck_StoringGetFutures").detail("SSISize", storageServerInterfaces.size());
 					for (j = 0; j < storageServerInterfaces.size(); j++) {
 						resetReply(req);
+						req.checksumOnly = compareChecksums && j > 0;
 						if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
 							cx->getLatestCommitVersion(
 							    storageServerInterfaces[j], req.version, req.ssLatestCommitVersions);
@@ -569,12 +595,29 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 
 					// Read the resulting entries
 					state int firstValidServer = -1;
+					state bool checksumMismatch = false;
 					totalReadAmount = 0;
 					for (j = 0; j < storageServerInterfaces.size(); j++) {
 						ErrorOr<GetKeyValuesReply> rangeResult = keyValueFutures[j].get();
 
+						if (rangeResult.present() && !rangeResult.get().error.present() &&
+						    rangeResult.get().checksum.present()) {
+							// The replica read the same rows as the first one but sent only their checksum. Without
+							// the first replica's rows there is nothing to compare it to.
+							if (firstValidServer == -1) {
+								checksumMismatch = true;
+							} else {
+								GetKeyValuesReply const& reference = keyValueFutures[firstValidServer].get().get();
+								totalReadAmount += reference.data.expectedSize();
+								if (rangeResult.get().checksum.get() != keyValuesChecksum(reference.data) ||
+								    rangeResult.get().more != reference.more) {
+									checksumMismatch = true;
+								}
+							}
+						}
+
 						// Compare the results with other storage servers
-						if (rangeResult.present() && !rangeResult.get().error.present()) {
+						else if (rangeResult.present() && !rangeResult.get().error.present()) {
 							state GetKeyValuesReply current = rangeResult.get();
 							TraceEvent("ConsistencyCheck_GetKeyValuesStream")
 							    .detail("DataSize", current.data.size())
@@ -745,6 +788,17 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 						}
 					}
 
+					if (checksumMismatch) {
+						CODE_PROBE(true, "Consistency scan rereads a batch whose checksums did not match");
+						TraceEvent("ConsistencyCheck_ChecksumMismatch")
+						    .detail("ShardBegin", req.begin.getKey())
+						    .detail("ShardEnd", req.end.getKey())
+						    .detail("VersionNumber", req.version);
+						fullReadRetry = true;
+						continue;
+					}
+					fullReadRetry = false;
+
 					if (firstValidServer >= 0) {
 						state VectorRef<KeyValueRef> data = keyValueFutures[firstValidServer].get().get().data;
 
@@ -820,10 +874,16 @@ ACTOR Future<bool> checkDataConsistency(Database cx,
 					}
 					// after requesting each shard, enforce rate limit based on how much data will likely be read
 					if (rateLimitForThisRound > 0) {
+						// Reads from idle servers are charged less, so idle teams are scanned faster
+						double rateMultiplier = 1.0;
+						if (healthMetrics.isValid() && healthMetrics.isReady() && !healthMetrics.isError()) {
+							rateMultiplier = idleRateMultiplier(healthMetrics.get(), storageServers);
+						}
 						TraceEvent("ConsistencyCheck_RateLimit")
 						    .detail("RateLimitForThisRound", rateLimitForThisRound)
-						    .detail("TotalAmountRead", totalReadAmount);
-						wait(rateLimiter->getAllowance(totalReadAmount));
+						    .detail("TotalAmountRead", totalReadAmount)
+						    .detail("RateMultiplier", rateMultiplier);
+						wait(rateLimiter->getAllowance(static_cast<int64_t>(totalReadAmount / rateMultiplier)));
 						TraceEvent("ConsistencyCheck_AmountRead1").detail("TotalAmountRead", totalReadAmount);
 						// Set ratelimit to max allowed if current round has been going on for a while
 						if (now() - rateLimiterStartTime > 1.1 * targetInterval && rateLimitForThisRound != maxRate) {
@@ -24,6 +24,7 @@
 
 #include "flow/ActorCollection.h"
 #include "flow/FastRef.h"
+#include "flow/IRateControl.h"
 #include "flow/Trace.h"
 #include "flow/Util.h"
 #include "fdbrpc/sim_validation.h"
@@ -131,6 +132,7 @@ struct RelocateData {
 	UID randomId; // inherit from RelocateShard.traceId
 	UID dataMoveId;
 	int workFactor;
+	int64_t destBytes; // What the relocation counts against the in-flight bytes of each of completeDests
 	std::vector<UID> src;
 	std::vector<UID> completeSources;
 	std::vector<UID> completeDests;
@@ -141,16 +143,17 @@ struct RelocateData {
 
 	RelocateData()
 	  : priority(-1), boundaryPriority(-1), healthPriority(-1), reason(RelocateReason::OTHER), startTime(-1),
-	    dataMoveId(anonymousShardId), workFactor(0), wantsNewServers(false), cancellable(false),
+	    dataMoveId(anonymousShardId), workFactor(0), destBytes(0), wantsNewServers(false), cancellable(false),
 	    interval("QueuedRelocation") {}
 	explicit RelocateData(RelocateShard const& rs)
 	  : keys(rs.keys), priority(rs.priority), boundaryPriority(isBoundaryPriority(rs.priority) ? rs.priority : -1),
 	    healthPriority(isHealthPriority(rs.priority) ? rs.priority : -1), reason(rs.reason), startTime(now()),
 	    randomId(rs.traceId.isValid() ? rs.traceId : deterministicRandom()->randomUniqueID()),
-	    dataMoveId(rs.dataMoveId), workFactor(0), wantsNewServers(isDataMovementForMountainChopper(rs.moveReason) ||
-	                                                              isDataMovementForValleyFiller(rs.moveReason) ||
-	                                                              rs.moveReason == DataMovementReason::SPLIT_SHARD ||
-	                                                              rs.moveReason == DataMovementReason::TEAM_REDUNDANT),
+	    dataMoveId(rs.dataMoveId), workFactor(0), destBytes(0),
+	    wantsNewServers(isDataMovementForMountainChopper(rs.moveReason) ||
+	                    isDataMovementForValleyFiller(rs.moveReason) ||
+	                    rs.moveReason == DataMovementReason::SPLIT_SHARD ||
+	                    rs.moveReason == DataMovementReason::TEAM_REDUNDANT),
 	    cancellable(true), interval("QueuedRelocation", randomId), dataMove(rs.dataMove) {
 		if (dataMove != nullptr) {
 			this->src.insert(this->src.end(), dataMove->meta.src.begin(), dataMove->meta.src.end());
@@ -172,6 +175,10 @@ struct RelocateData {
 
 	bool isRestore() const { return this->dataMove != nullptr; }
 
+	bool isRebalance() const {
+		return reason == RelocateReason::REBALANCE_DISK || reason == RelocateReason::REBALANCE_READ;
+	}
+
 	bool operator>(const RelocateData& rhs) const {
 		return priority != rhs.priority
 		           ? priority > rhs.priority
@@ -372,8 +379,10 @@ public:
 
 struct Busyness {
 	std::vector<int> ledger;
+	// The bytes in flight, by priority the same way as ledger: work only waits for work of the same or higher priority
+	std::vector<int64_t> bytesLedger;
 
-	Busyness() : ledger(10, 0) {}
+	Busyness() : ledger(10, 0), bytesLedger(10, 0) {}
 
 	bool canLaunch(int prio, int work) const {
 		ASSERT(prio > 0 && prio < 1000);
@@ -385,6 +394,18 @@ struct Busyness {
 			ledger[i] += work;
 	}
 	void removeWork(int prio, int work) { addWork(prio, -work); }
+
+	// A move larger than the whole budget can still start once nothing else is in flight
+	bool canLaunchBytes(int prio, int64_t bytes, int64_t budget) const {
+		ASSERT(prio > 0 && prio < 1000);
+		return budget <= 0 || bytesLedger[prio / 100] == 0 || bytesLedger[prio / 100] + bytes <= budget;
+	}
+	void addBytes(int prio, int64_t bytes) {
+		ASSERT(prio > 0 && prio < 1000);
+		for (int i = 0; i <= (prio / 100); i++)
+			bytesLedger[i] += bytes;
+	}
+	void removeBytes(int prio, int64_t bytes) { addBytes(prio, -bytes); }
 	std::string toString() {
 		std::string result;
 		for (int i = 1; i < ledger.size();) {
@@ -460,6 +481,7 @@ bool canLaunchSrc(RelocateData& relocation,
 // candidateTeams is a vector containing one team per datacenter, the team(s) DD is planning on moving the shard to.
 bool canLaunchDest(const std::vector<std::pair<Reference<IDataDistributionTeam>, bool>>& candidateTeams,
                    int priority,
+                   int64_t bytes,
                    std::map<UID, Busyness>& busymapDest) {
 	// fail switch if this is causing issues
 	if (SERVER_KNOBS->RELOCATION_PARALLELISM_PER_DEST_SERVER <= 0) {
@@ -468,7 +490,9 @@ bool canLaunchDest(const std::vector<std::pair<Reference<IDataDistributionTeam>,
 	int workFactor = getDestWorkFactor();
 	for (auto& [team, _] : candidateTeams) {
 		for (UID id : team->getServerIDs()) {
-			if (!busymapDest[id].canLaunch(priority, workFactor)) {
+			if (!busymapDest[id].canLaunch(priority, workFactor) ||
+			    !busymapDest[id].canLaunchBytes(
+			        priority, bytes, SERVER_KNOBS->RELOCATION_INFLIGHT_BYTES_PER_DEST_SERVER)) {
 				return false;
 			}
 		}
@@ -486,13 +510,16 @@ void launch(RelocateData& relocation, std::map<UID, Busyness>& busymap, int sing
 
 void launchDest(RelocateData& relocation,
                 const std::vector<std::pair<Reference<IDataDistributionTeam>, bool>>& candidateTeams,
+                int64_t bytes,
                 std::map<UID, Busyness>& destBusymap) {
 	ASSERT(relocation.completeDests.empty());
 	int destWorkFactor = getDestWorkFactor();
+	relocation.destBytes = bytes;
 	for (auto& [team, _] : candidateTeams) {
 		for (UID id : team->getServerIDs()) {
 			relocation.completeDests.push_back(id);
 			destBusymap[id].addWork(relocation.priority, destWorkFactor);
+			destBusymap[id].addBytes(relocation.priority, bytes);
 		}
 	}
 }
@@ -500,6 +527,7 @@ void completeDest(RelocateData const& relocation, std::map<UID, Busyness>& destB
 	int destWorkFactor = getDestWorkFactor();
 	for (UID id : relocation.completeDests) {
 		destBusymap[id].removeWork(relocation.priority, destWorkFactor);
+		destBusymap[id].removeBytes(relocation.priority, relocation.destBytes);
 	}
 }
 
@@ -639,6 +667,8 @@ struct DDQueue : public IDDRelocationQueue {
 	FlowLock finishMoveKeysParallelismLock;
 	FlowLock cleanUpDataMoveParallelismLock;
 	Reference<FlowLock> fetchSourceLock;
+	// Declared after startMoveKeysParallelismLock, so that its workers are cancelled before the lock goes away
+	StartMoveKeysBatcher startMoveKeysBatcher{ &startMoveKeysParallelismLock };
 
 	int activeRelocations;
 	int queuedRelocations;
@@ -648,6 +678,7 @@ struct DDQueue : public IDDRelocationQueue {
 
 	std::map<UID, Busyness> busymap; // UID is serverID
 	std::map<UID, Busyness> destBusymap; // UID is serverID
+	Reference<IRateControl> rebalanceRateLimit; // Only set with DD_REBALANCE_MAX_BYTES_PER_SECOND
 
 	KeyRangeMap<RelocateData> queueMap;
 	std::set<RelocateData, std::greater<RelocateData>> fetchingSourcesQueue;
@@ -770,6 +801,10 @@ struct DDQueue : public IDDRelocationQueue {
 	    rawProcessingWiggle(new AsyncVar<bool>(false)), unhealthyRelocations(0),
 	    movedKeyServersEventHolder(makeReference<EventCacheHolder>("MovedKeyServers")), moveReusePhysicalShard(0),
 	    moveCreateNewPhysicalShard(0), retryFindDstReasonCount(static_cast<int>(RetryFindDstReason::NumberOfTypes), 0) {
+		if (SERVER_KNOBS->DD_REBALANCE_MAX_BYTES_PER_SECOND > 0) {
+			rebalanceRateLimit = makeReference<SpeedLimit>(
+			    std::min<int64_t>(SERVER_KNOBS->DD_REBALANCE_MAX_BYTES_PER_SECOND, std::numeric_limits<int>::max()), 1);
+		}
 	}
 	DDQueue() = default;
 
@@ -1478,6 +1513,12 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 		state StorageMetrics metrics =
 		    wait(brokenPromiseToNever(self->getShardMetrics.getReply(GetMetricsRequest(rd.keys))));
 
+		// Rebalancing can wait for bandwidth, anything moving data for the sake of fault tolerance or splits can not
+		if (self->rebalanceRateLimit && rd.isRebalance()) {
+			wait(self->rebalanceRateLimit->getAllowance(
+			    std::min<int64_t>(metrics.bytes, std::numeric_limits<int>::max())));
+		}
+
 		state std::unordered_set<uint64_t> excludedDstPhysicalShards;
 
 		ASSERT(rd.src.size());
@@ -1675,7 +1716,7 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 
 				// once we've found healthy candidate teams, make sure they're not overloaded with outstanding moves
 				// already
-				anyDestOverloaded = !canLaunchDest(bestTeams, rd.priority, self->destBusymap);
+				anyDestOverloaded = !canLaunchDest(bestTeams, rd.priority, metrics.bytes, self->destBusymap);
 
 				if (foundTeams && anyHealthy && !anyDestOverloaded) {
 					ASSERT(rd.completeDests.empty());
@@ -1828,7 +1869,7 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 			healthyDestinations.addDataInFlightToTeam(+metrics.bytes);
 			healthyDestinations.addReadInFlightToTeam(+metrics.bytesReadPerKSecond);
 
-			launchDest(rd, bestTeams, self->destBusymap);
+			launchDest(rd, bestTeams, metrics.bytes, self->destBusymap);
 
 			if (SERVER_KNOBS->DD_ENABLE_VERBOSE_TRACING) {
 				// StorageMetrics is the rd shard's metrics, e.g., bytes and write bandwidth
@@ -1886,6 +1927,7 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 				                                          relocateShardInterval.pairID,
 				                                          ddEnabledState,
 				                                          CancelConflictingDataMoves::False);
+				params->startMoveKeysBatcher = &self->startMoveKeysBatcher;
 			}
 			state Future<Void> doMoveKeys = self->txnProcessor->moveKeys(*params);
 			state Future<Void> pollHealth =
@@ -1927,6 +1969,7 @@ ACTOR Future<Void> dataDistributionRelocator(DDQueue* self,
 									                                          relocateShardInterval.pairID,
 									                                          ddEnabledState,
 									                                          CancelConflictingDataMoves::False);
+									params->startMoveKeysBatcher = &self->startMoveKeysBatcher;
 								}
 								doMoveKeys = self->txnProcessor->moveKeys(*params);
 							} else {
@@ -2649,3 +2692,27 @@ TEST_CASE("/DataDistribution/DDQueue/ServerCounterTrace") {
 	std::cout << "Finished.";
 	return Void();
 }
+
+TEST_CASE("/DataDistribution/DDQueue/BusynessBytes") {
+	int healing = SERVER_KNOBS->PRIORITY_TEAM_UNHEALTHY;
+	int rebalancing = SERVER_KNOBS->PRIORITY_REBALANCE_OVERUTILIZED_TEAM;
+	ASSERT(healing / 100 > rebalancing / 100);
+
+	Busyness busy;
+	// Anything can start on an idle server, even a move larger than the budget
+	ASSERT(busy.canLaunchBytes(rebalancing, 300, 100));
+	busy.addBytes(rebalancing, 80);
+	ASSERT(busy.canLaunchBytes(rebalancing, 20, 100));
+	ASSERT(!busy.canLaunchBytes(rebalancing, 30, 100));
+	// Rebalancing does not hold up moves that restore fault tolerance
+	ASSERT(busy.canLaunchBytes(healing, 100, 100));
+	busy.addBytes(healing, 100);
+	ASSERT(!busy.canLaunchBytes(rebalancing, 1, 100));
+	ASSERT(!busy.canLaunchBytes(healing, 1, 100));
+	ASSERT(busy.canLaunchBytes(healing, 1, 0));
+
+	busy.removeBytes(healing, 100);
+	busy.removeBytes(rebalancing, 80);
+	ASSERT(std::all_of(busy.bytesLedger.begin(), busy.bytesLedger.end(), [](int64_t b) { return b == 0; }));
+	return Void();
+}
@@ -28,6 +28,7 @@
 #include "fdbserver/Knobs.h"
 #include "fdbserver/workloads/workloads.actor.h"
 #include "fdbclient/DatabaseContext.h"
+#include "fdbclient/ManagementAPI.actor.h"
 #include "flow/ActorCollection.h"
 #include "flow/Arena.h"
 #include "flow/CodeProbe.h"
@@ -101,6 +102,15 @@ struct DataDistributionTracker : public IDDShardTracker {
 	// Read hot detection
 	PromiseStream<KeyRange> readHotShard;
 
+	// Read hot ranges this tracker added to the storage cache
+	struct CachedReadHotRange {
+		KeyRange keys;
+		int64_t bytes;
+		double lastReadHot;
+	};
+	std::vector<CachedReadHotRange> cachedReadHotRanges;
+	int64_t cachedReadHotBytes = 0;
+
 	// The reference to trackerCancelled must be extracted by actors,
 	// because by the time (trackerCancelled == true) this memory cannot
 	// be accessed
@@ -131,6 +141,11 @@ struct DataDistributionTracker : public IDDShardTracker {
 
 	Optional<Reference<TenantCache>> ddTenantCache;
 
+	// Shards merged into their neighbours, and the merges among them that went past the minimum shard size
+	int64_t shardsMergedAway = 0;
+	int64_t aggressiveMerges = 0;
+	double nextAggressiveMergeTime = 0;
+
 	DataDistributionTracker() = default;
 
 	DataDistributionTracker(Reference<IDDTxnProcessor> db,
@@ -201,6 +216,15 @@ ShardSizeBounds getShardSizeBounds(KeyRangeRef shard, int64_t maxShardSize) {
 	return bounds;
 }
 
+// Shards smaller than this are merged with their neighbours. Every shard costs a tracker here and a location cache
+// entry on each client, so once there are too many, cold shards are merged until they are well past the minimum size.
+int64_t getMergeBelowBytes(DataDistributionTracker* self, ShardSizeBounds const& bounds) {
+	if (bounds.min.bytes == 0 || self->shards->size() <= SERVER_KNOBS->DD_AGGRESSIVE_MERGE_SHARD_COUNT) {
+		return bounds.min.bytes;
+	}
+	return std::max<int64_t>(bounds.min.bytes, bounds.max.bytes * SERVER_KNOBS->DD_AGGRESSIVE_MERGE_MAX_SHARD_RATIO);
+}
+
 int64_t getMaxShardSize(double dbSizeEstimate) {
 	return std::min((SERVER_KNOBS->MIN_SHARD_BYTES + (int64_t)std::sqrt(std::max<double>(dbSizeEstimate, 0)) *
 	                                                     SERVER_KNOBS->SHARD_BYTES_PER_SQRT_BYTES) *
@@ -373,19 +397,119 @@ ACTOR Future<Void> trackShardMetrics(DataDistributionTracker::SafeAccessor self,
 	}
 }
 
+// Adds keys to the storage cache unless some of them are cached already, possibly by an operator, whose cached range
+// must not be split or removed along with ours later. Returns whether the keys were added.
+ACTOR Future<bool> cacheRangeIfUncached(Database cx, KeyRange keys) {
+	state Transaction tr(cx);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			state Key begin = keys.begin.withPrefix(storageCacheKeys.begin);
+			state Key end = keys.end.withPrefix(storageCacheKeys.begin);
+			// The last boundary at or before keys.begin, then every boundary inside keys
+			state RangeResult before = wait(
+			    tr.getRange(KeyRangeRef(storageCacheKeys.begin, keyAfter(begin)), 1, Snapshot::False, Reverse::True));
+			RangeResult inside = wait(tr.getRange(KeyRangeRef(keyAfter(begin), end), CLIENT_KNOBS->TOO_MANY));
+			bool cached = inside.more;
+			inside.append(inside.arena(), before.begin(), before.size());
+			for (const auto& kv : inside) {
+				std::vector<uint16_t> servers;
+				decodeStorageCacheValue(kv.value, servers);
+				cached = cached || !servers.empty();
+			}
+			if (cached) {
+				return false;
+			}
+			break;
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+	wait(ManagementAPI::addCachedRange(cx.getReference(), keys));
+	return true;
+}
+
+ACTOR Future<Void> uncacheReadHotRange(DataDistributionTracker* self, int index) {
+	state DataDistributionTracker::CachedReadHotRange range = self->cachedReadHotRanges[index];
+	self->cachedReadHotRanges.erase(self->cachedReadHotRanges.begin() + index);
+	self->cachedReadHotBytes -= range.bytes;
+	TraceEvent("ReadHotRangeUncached", self->distributorId)
+	    .detail("KeyRangeBegin", range.keys.begin)
+	    .detail("KeyRangeEnd", range.keys.end)
+	    .detail("Bytes", range.bytes)
+	    .detail("SinceReadHot", now() - range.lastReadHot);
+	wait(ManagementAPI::removeCachedRange(self->db->context().getReference(), range.keys));
+	return Void();
+}
+
+// Caches a read hot range, making room by uncaching the ranges that have not been read hot for the longest
+ACTOR Future<Void> cacheReadHotRange(DataDistributionTracker* self, ReadHotRangeWithMetrics hotRange) {
+	state bool alreadyCached = false;
+	for (auto& cached : self->cachedReadHotRanges) {
+		if (cached.keys.intersects(hotRange.keys)) {
+			cached.lastReadHot = now();
+			alreadyCached = true;
+		}
+	}
+	// density is the ratio of bytes read to bytes stored over the same interval
+	state int64_t bytes = hotRange.density > 0 ? hotRange.readBandwidth / hotRange.density : 0;
+	if (alreadyCached || bytes > SERVER_KNOBS->DD_CACHE_READ_HOT_MAX_BYTES) {
+		return Void();
+	}
+	while (self->cachedReadHotBytes + bytes > SERVER_KNOBS->DD_CACHE_READ_HOT_MAX_BYTES) {
+		auto coldest = std::min_element(self->cachedReadHotRanges.begin(),
+		                                self->cachedReadHotRanges.end(),
+		                                [](auto const& a, auto const& b) { return a.lastReadHot < b.lastReadHot; });
+		CODE_PROBE(true, "Uncaching a read hot range to make room for another");
+		wait(uncacheReadHotRange(self, coldest - self->cachedReadHotRanges.begin()));
+	}
+	bool added = wait(cacheRangeIfUncached(self->db->context(), hotRange.keys));
+	if (added) {
+		self->cachedReadHotRanges.push_back({ hotRange.keys, bytes, now() });
+		self->cachedReadHotBytes += bytes;
+		TraceEvent("ReadHotRangeCached", self->distributorId)
+		    .detail("KeyRangeBegin", hotRange.keys.begin)
+		    .detail("KeyRangeEnd", hotRange.keys.end)
+		    .detail("Bytes", bytes)
+		    .detail("CachedBytes", self->cachedReadHotBytes);
+	}
+	return Void();
+}
+
 ACTOR Future<Void> readHotDetector(DataDistributionTracker* self) {
+	state bool cacheReadHot = SERVER_KNOBS->DD_CACHE_READ_HOT_RANGES && !self->db->isMocked();
+	state Future<Void> expireCached = cacheReadHot ? delay(SERVER_KNOBS->DD_CACHE_READ_HOT_RANGE_TTL) : Never();
+	state KeyRange keys;
+	state int i = 0;
 	try {
-		loop {
-			state KeyRange keys = waitNext(self->readHotShard.getFuture());
-			Standalone<VectorRef<ReadHotRangeWithMetrics>> readHotRanges = wait(self->db->getReadHotRanges(keys));
-
-			for (const auto& keyRange : readHotRanges) {
-				TraceEvent("ReadHotRangeLog")
-				    .detail("ReadDensity", keyRange.density)
-				    .detail("ReadBandwidth", keyRange.readBandwidth)
-				    .detail("ReadDensityThreshold", SERVER_KNOBS->SHARD_MAX_READ_DENSITY_RATIO)
-				    .detail("KeyRangeBegin", keyRange.keys.begin)
-				    .detail("KeyRangeEnd", keyRange.keys.end);
+		loop choose {
+			when(KeyRange hotShard = waitNext(self->readHotShard.getFuture())) {
+				keys = hotShard;
+				state Standalone<VectorRef<ReadHotRangeWithMetrics>> readHotRanges =
+				    wait(self->db->getReadHotRanges(keys));
+
+				for (const auto& keyRange : readHotRanges) {
+					TraceEvent("ReadHotRangeLog")
+					    .detail("ReadDensity", keyRange.density)
+					    .detail("ReadBandwidth", keyRange.readBandwidth)
+					    .detail("ReadDensityThreshold", SERVER_KNOBS->SHARD_MAX_READ_DENSITY_RATIO)
+					    .detail("KeyRangeBegin", keyRange.keys.begin)
+					    .detail("KeyRangeEnd", keyRange.keys.end);
+				}
+				for (i = 0; cacheReadHot && i < readHotRanges.size(); i++) {
+					wait(cacheReadHotRange(self, readHotRanges[i]));
+				}
+			}
+			when(wait(expireCached)) {
+				for (i = 0; i < self->cachedReadHotRanges.size();) {
+					if (now() - self->cachedReadHotRanges[i].lastReadHot > SERVER_KNOBS->DD_CACHE_READ_HOT_RANGE_TTL) {
+						wait(uncacheReadHotRange(self, i));
+					} else {
+						i++;
+					}
+				}
+				expireCached = delay(SERVER_KNOBS->DD_CACHE_READ_HOT_RANGE_TTL / 2);
 			}
 		}
 	} catch (Error& e) {
@@ -517,12 +641,14 @@ void executeShardSplit(DataDistributionTracker* self,
                        Standalone<VectorRef<KeyRef>> splitKeys,
                        Reference<AsyncVar<Optional<ShardMetrics>>> shardSize,
                        bool relocate,
-                       RelocateReason reason) {
+                       RelocateReason reason,
+                       bool keepFirst = false) {
 
 	int numShards = splitKeys.size() - 1;
 	ASSERT(numShards > 1);
 
-	int skipRange = deterministicRandom()->randomInt(0, numShards);
+	// Any one of the new shards can stay where it is, unless the caller wants the rest of the range moved off it
+	int skipRange = keepFirst ? 0 : deterministicRandom()->randomInt(0, numShards);
 
 	auto s = describeSplit(keys, splitKeys);
 	TraceEvent(SevInfo, "ExecutingShardSplit").suppressFor(0.5).detail("Splitting", s).detail("NumShards", numShards);
@@ -858,6 +984,12 @@ TEST_CASE("/DataDistribution/Tenant/DoubleShardTenantAlignedAtEnd") {
 
 ACTOR Future<Void> tenantShardSplitter(DataDistributionTracker* self, KeyRange tenantKeys) {
 	wait(Future<Void>(Void()));
+	if (SERVER_KNOBS->DD_TENANT_COLOCATION_MAX_BYTES > 0) {
+		// A new tenant is empty, so leave it in the shard it shares with its neighbors. It gets shards of its own
+		// through splits aligned to its boundaries once it grows.
+		CODE_PROBE(true, "New tenant colocated with its neighbors");
+		return Void();
+	}
 	std::vector<RangeToSplit> rangesToSplit = findTenantShardBoundaries(self->shards, tenantKeys);
 
 	for (auto& range : rangesToSplit) {
@@ -877,6 +1009,24 @@ ACTOR Future<Void> tenantCreationHandling(DataDistributionTracker* self, TenantC
 	return Void();
 }
 
+// Moves split points that fall inside tenants to the tenants' boundaries, so that a shard holding several tenants is
+// split between them rather than through one of them
+static Standalone<VectorRef<KeyRef>> alignSplitKeysToTenants(TenantCache const& tenantCache,
+                                                             Standalone<VectorRef<KeyRef>> const& splitKeys) {
+	Standalone<VectorRef<KeyRef>> aligned;
+	aligned.push_back_deep(aligned.arena(), splitKeys.front());
+	for (int i = 1; i + 1 < splitKeys.size(); i++) {
+		Key splitKey = tenantCache.alignToTenantBoundary(splitKeys[i], KeyRangeRef(aligned.back(), splitKeys.back()));
+		CODE_PROBE(splitKey != splitKeys[i], "Shard split point moved to a tenant boundary");
+		// Split points in the same tenant align to the same boundary
+		if (splitKey > aligned.back()) {
+			aligned.push_back_deep(aligned.arena(), splitKey);
+		}
+	}
+	aligned.push_back_deep(aligned.arena(), splitKeys.back());
+	return aligned;
+}
+
 ACTOR Future<Void> shardSplitter(DataDistributionTracker* self,
                                  KeyRange keys,
                                  Reference<AsyncVar<Optional<ShardMetrics>>> shardSize,
@@ -897,6 +1047,9 @@ ACTOR Future<Void> shardSplitter(DataDistributionTracker* self,
 
 	state Standalone<VectorRef<KeyRef>> splitKeys =
 	    wait(self->db->splitStorageMetrics(keys, splitMetrics, metrics, SERVER_KNOBS->MIN_SHARD_BYTES));
+	if (self->ddTenantCache.present() && SERVER_KNOBS->DD_TENANT_COLOCATION_MAX_BYTES > 0) {
+		splitKeys = alignSplitKeysToTenants(*self->ddTenantCache.get(), splitKeys);
+	}
 	// fprintf(stderr, "split keys:\n");
 	// for( int i = 0; i < splitKeys.size(); i++ ) {
 	//	fprintf(stderr, "   %s\n", printable(splitKeys[i]).c_str());
@@ -917,7 +1070,18 @@ ACTOR Future<Void> shardSplitter(DataDistributionTracker* self,
 	    .detail("NumShards", numShards);
 
 	if (numShards > 1) {
-		executeShardSplit(self, keys, splitKeys, shardSize, true, reason);
+		// A shard that got write-hot quickly is usually being written at its end, as by sequential inserts: keep its
+		// head in place and move the hot tail to other teams
+		bool keepFirst = reason == RelocateReason::WRITE_SPLIT && SERVER_KNOBS->DD_WRITE_HOT_SHARD_DETECTION;
+		if (keepFirst) {
+			TraceEvent("WriteHotShardSplit", self->distributorId)
+			    .suppressFor(1.0)
+			    .detail("Begin", keys.begin)
+			    .detail("End", keys.end)
+			    .detail("FirstSplit", splitKeys[1])
+			    .detail("BytesWrittenPerKSec", metrics.bytesWrittenPerKSecond);
+		}
+		executeShardSplit(self, keys, splitKeys, shardSize, true, reason, keepFirst);
 	} else {
 		wait(delay(1.0, TaskPriority::DataDistribution)); // In case the reason the split point was off was due to a
 		                                                  // discrepancy between storage servers
@@ -936,7 +1100,11 @@ ACTOR Future<Void> brokenPromiseToReady(Future<Void> f) {
 	return Void();
 }
 
-static bool shardMergeFeasible(DataDistributionTracker* self, KeyRange const& keys, KeyRangeRef adjRange) {
+// mergedBytes is the size the merged shard would have, if known
+static bool shardMergeFeasible(DataDistributionTracker* self,
+                               KeyRange const& keys,
+                               KeyRangeRef adjRange,
+                               Optional<int64_t> mergedBytes) {
 	bool honorTenantKeyspaceBoundaries = self->ddTenantCache.present();
 
 	if (!honorTenantKeyspaceBoundaries) {
@@ -949,28 +1117,51 @@ static bool shardMergeFeasible(DataDistributionTracker* self, KeyRange const& ke
 	tenantOwningRange = self->ddTenantCache.get()->tenantOwning(keys.begin);
 	tenantOwningAdjRange = self->ddTenantCache.get()->tenantOwning(adjRange.begin);
 
-	if ((tenantOwningRange.present() != tenantOwningAdjRange.present()) ||
-	    (tenantOwningRange.present() && (tenantOwningRange != tenantOwningAdjRange))) {
+	if (tenantOwningRange.present() != tenantOwningAdjRange.present()) {
+		return false;
+	}
+
+	if (tenantOwningRange.present() && (tenantOwningRange != tenantOwningAdjRange)) {
+		// Small tenants are packed together, so that their transactions commit to and read from fewer teams. A
+		// shard holding several tenants never grows past DD_TENANT_COLOCATION_MAX_BYTES by merging, so every tenant
+		// in it is small.
+		if (mergedBytes.present() && mergedBytes.get() <= SERVER_KNOBS->DD_TENANT_COLOCATION_MAX_BYTES) {
+			CODE_PROBE(true, "Merging shards of small tenants");
+			return true;
+		}
 		return false;
 	}
 
 	return true;
 }
 
-static bool shardForwardMergeFeasible(DataDistributionTracker* self, KeyRange const& keys, KeyRangeRef nextRange) {
+static bool shardForwardMergeFeasible(DataDistributionTracker* self,
+                                      KeyRange const& keys,
+                                      KeyRangeRef nextRange,
+                                      Optional<int64_t> mergedBytes) {
 	if (keys.end == allKeys.end) {
 		return false;
 	}
 
-	return shardMergeFeasible(self, keys, nextRange);
+	return shardMergeFeasible(self, keys, nextRange, mergedBytes);
 }
 
-static bool shardBackwardMergeFeasible(DataDistributionTracker* self, KeyRange const& keys, KeyRangeRef prevRange) {
+static bool shardBackwardMergeFeasible(DataDistributionTracker* self,
+                                       KeyRange const& keys,
+                                       KeyRangeRef prevRange,
+                                       Optional<int64_t> mergedBytes) {
 	if (keys.begin == allKeys.begin) {
 		return false;
 	}
 
-	return shardMergeFeasible(self, keys, prevRange);
+	return shardMergeFeasible(self, keys, prevRange, mergedBytes);
+}
+
+static Optional<int64_t> mergedShardBytes(StorageMetrics const& endingStats, Optional<ShardMetrics> const& newMetrics) {
+	if (!newMetrics.present()) {
+		return Optional<int64_t>();
+	}
+	return endingStats.bytes + newMetrics.get().metrics.bytes;
 }
 
 Future<Void> shardMerger(DataDistributionTracker* self,
@@ -1002,6 +1193,18 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 
 	int64_t systemBytes = keys.begin >= systemKeys.begin ? shardSize->get().get().metrics.bytes : 0;
 
+	// Merges past the minimum shard size are rate limited; until one is allowed, merge only up to the minimum
+	ShardSizeBounds const bounds = getShardSizeBounds(keys, maxShardSize);
+	int64_t const minBytes = bounds.min.bytes;
+	bool aggressive = getMergeBelowBytes(self, bounds) > minBytes;
+	if (aggressive && now() < self->nextAggressiveMergeTime) {
+		if (endingStats.bytes >= minBytes) {
+			CODE_PROBE(true, "shardMerger waiting for an aggressive merge");
+			return delayJittered(SERVER_KNOBS->DD_MERGE_COALESCE_DELAY, TaskPriority::DataDistribution);
+		}
+		aggressive = false;
+	}
+
 	loop {
 		Optional<ShardMetrics> newMetrics;
 		if (!forwardComplete) {
@@ -1011,14 +1214,13 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 			}
 
 			++nextIter;
-			if (!shardForwardMergeFeasible(self, keys, nextIter->range())) {
+			newMetrics = nextIter->value().stats->get();
+			if (!shardForwardMergeFeasible(self, keys, nextIter->range(), mergedShardBytes(endingStats, newMetrics))) {
 				--nextIter;
 				forwardComplete = true;
 				continue;
 			}
 
-			newMetrics = nextIter->value().stats->get();
-
 			// If going forward, give up when the next shard's stats are not yet present, or if the
 			// the shard is already over the merge bounds.
 			if (!newMetrics.present() || shardCount + newMetrics.get().shardCount >= CLIENT_KNOBS->SHARD_COUNT_LIMIT ||
@@ -1031,7 +1233,8 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 			--prevIter;
 			newMetrics = prevIter->value().stats->get();
 
-			if (!shardBackwardMergeFeasible(self, keys, prevIter->range())) {
+			if (!shardBackwardMergeFeasible(
+			        self, keys, prevIter->range(), mergedShardBytes(endingStats, newMetrics))) {
 				++prevIter;
 				break;
 			}
@@ -1061,9 +1264,10 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 		shardsMerged++;
 
 		auto shardBounds = getShardSizeBounds(merged, maxShardSize);
+		int64_t mergeBelowBytes = aggressive ? getMergeBelowBytes(self, shardBounds) : shardBounds.min.bytes;
 		// If we just recently get the current shard's metrics (i.e., less than DD_LOW_BANDWIDTH_DELAY ago), it
 		// means the shard's metric may not be stable yet. So we cannot continue merging in this direction.
-		if (endingStats.bytes >= shardBounds.min.bytes || getBandwidthStatus(endingStats) != BandwidthStatusLow ||
+		if (endingStats.bytes >= mergeBelowBytes || getBandwidthStatus(endingStats) != BandwidthStatusLow ||
 		    now() - lastLowBandwidthStartTime < SERVER_KNOBS->DD_LOW_BANDWIDTH_DELAY ||
 		    shardsMerged >= SERVER_KNOBS->DD_MERGE_LIMIT) {
 			// The merged range is larger than the min bounds so we cannot continue merging in this direction.
@@ -1112,7 +1316,14 @@ Future<Void> shardMerger(DataDistributionTracker* self,
 	    .detail("EndingSize", endingStats.bytes)
 	    .detail("BatchedMerges", shardsMerged)
 	    .detail("LastLowBandwidthStartTime", lastLowBandwidthStartTime)
-	    .detail("ShardCount", shardCount);
+	    .detail("ShardCount", shardCount)
+	    .detail("Aggressive", aggressive);
+
+	self->shardsMergedAway += shardsMerged - 1;
+	if (aggressive && endingStats.bytes > minBytes) {
+		++self->aggressiveMerges;
+		self->nextAggressiveMergeTime = now() + 1.0 / SERVER_KNOBS->DD_AGGRESSIVE_MERGES_PER_SECOND;
+	}
 
 	if (mergeRange.begin < systemKeys.begin) {
 		self->systemSizeEstimate -= systemBytes;
@@ -1150,9 +1361,12 @@ ACTOR Future<Void> shardEvaluator(DataDistributionTracker* self,
 	if (keys.end < allKeys.end)
 		++nextIter;
 
-	bool shouldMerge = stats.bytes < shardBounds.min.bytes && bandwidthStatus == BandwidthStatusLow &&
-	                   (shardForwardMergeFeasible(self, keys, nextIter.range()) ||
-	                    shardBackwardMergeFeasible(self, keys, prevIter.range()));
+	bool shouldMerge = stats.bytes < getMergeBelowBytes(self, shardBounds) &&
+	                   bandwidthStatus == BandwidthStatusLow &&
+	                   (shardForwardMergeFeasible(
+	                        self, keys, nextIter.range(), mergedShardBytes(stats, nextIter.value().stats->get())) ||
+	                    shardBackwardMergeFeasible(
+	                        self, keys, prevIter.range(), mergedShardBytes(stats, prevIter.value().stats->get())));
 
 	// Every invocation must set this or clear it
 	if (shouldMerge && !self->anyZeroHealthyTeams->get()) {
@@ -1511,6 +1725,8 @@ ACTOR Future<Void> dataDistributionTracker(Reference<InitialDataDistribution> in
 				    .detail("Shards", self.shards->size())
 				    .detail("TotalSizeBytes", self.dbSizeEstimate->get())
 				    .detail("SystemSizeBytes", self.systemSizeEstimate)
+				    .detail("ShardsMergedAway", self.shardsMergedAway)
+				    .detail("AggressiveMerges", self.aggressiveMerges)
 				    .trackLatest(ddTrackerStatsEventHolder->trackingKey);
 
 				loggingTrigger = delay(SERVER_KNOBS->DATA_DISTRIBUTION_LOGGING_INTERVAL, TaskPriority::FlushTrace);
@@ -233,7 +233,8 @@ public:
 			// Only healthy teams may be selected. The team has to be healthy at the moment we update
 			//   shardsAffectedByTeamFailure or we could be dropping a shard on the floor (since team
 			//   tracking is "edge triggered")
-			// SOMEDAY: Account for capacity, load (when shardMetrics load is high)
+			// With DD_LOAD_AWARE_TEAM_SELECTION, used space counts for more on teams whose servers are short of CPU,
+			//   storage queue, durability lag or read bandwidth
 
 			// self->teams.size() can be 0 under the ConfigureTest.txt test when we change configurations
 			// The situation happens rarely. We may want to eliminate this situation someday
@@ -269,7 +270,8 @@ public:
 					if (self->teams[currentIndex]->isHealthy() &&
 					    (!req.preferLowerDiskUtil ||
 					     self->teams[currentIndex]->hasHealthyAvailableSpace(self->medianAvailableSpace))) {
-						int64_t loadBytes = self->teams[currentIndex]->getLoadBytes(true, req.inflightPenalty);
+						int64_t loadBytes =
+						    self->getPlacementLoadBytes(*self->teams[currentIndex], req.inflightPenalty);
 						if ((!req.teamMustHaveShards ||
 						     self->shardsAffectedByTeamFailure->hasShards(ShardsAffectedByTeamFailure::Team(
 						         self->teams[currentIndex]->getServerIDs(), self->primary))) &&
@@ -330,7 +332,7 @@ public:
 				}
 
 				for (int i = 0; i < randomTeams.size(); i++) {
-					int64_t loadBytes = randomTeams[i]->getLoadBytes(true, req.inflightPenalty);
+					int64_t loadBytes = self->getPlacementLoadBytes(*randomTeams[i], req.inflightPenalty);
 					if (!bestOption.present() ||
 					    req.lessCompare(bestOption.get(), randomTeams[i], bestLoadBytes, loadBytes)) {
 
@@ -514,6 +516,7 @@ public:
 			}
 		}
 
+		state double buildStart = timer_monotonic();
 		for (const auto& [serverID, server] : self->server_info) {
 			if (!self->server_status.get(serverID).isUnhealthy()) {
 				++serverCount;
@@ -637,6 +640,7 @@ public:
 		}
 
 		self->evaluateTeamQuality();
+		self->recordBuildTeamsTime(timer_monotonic() - buildStart);
 
 		// Building teams can cause servers to become undesired, which can make teams unhealthy.
 		// Let all of these changes get worked out before responding to the get team request
@@ -2761,6 +2765,16 @@ public:
 		}
 	}
 
+	ACTOR static Future<Void> trackStorageLoadPressure(DDTeamCollection* self) {
+		loop {
+			ErrorOr<HealthMetrics> metrics = wait(errorOr(self->db->getHealthMetrics(true)));
+			if (metrics.present()) {
+				self->storageStats = metrics.get().storageStats;
+			}
+			wait(delay(SERVER_KNOBS->STORAGE_METRICS_POLLING_DELAY, TaskPriority::DataDistribution));
+		}
+	}
+
 	ACTOR static Future<Void> waitServerListChange(DDTeamCollection* self,
 	                                               FutureStream<Void> serverRemoved,
 	                                               const DDEnabledState* ddEnabledState) {
@@ -2966,6 +2980,9 @@ public:
 				self->addActor.send(self->trackExcludedServers());
 				self->addActor.send(self->waitHealthyZoneChange());
 				self->addActor.send(self->monitorPerpetualStorageWiggle());
+				if (SERVER_KNOBS->DD_LOAD_AWARE_TEAM_SELECTION) {
+					self->addActor.send(self->trackStorageLoadPressure());
+				}
 			}
 			// SOMEDAY: Monitor FF/serverList for (new) servers that aren't in allServers and add or remove them
 
@@ -3586,6 +3603,10 @@ Future<Void> DDTeamCollection::monitorHealthyTeams() {
 	return DDTeamCollectionImpl::monitorHealthyTeams(this);
 }
 
+Future<Void> DDTeamCollection::trackStorageLoadPressure() {
+	return DDTeamCollectionImpl::trackStorageLoadPressure(this);
+}
+
 Future<UID> DDTeamCollection::getNextWigglingServerID() {
 	Optional<Value> localityKey;
 	Optional<Value> localityValue;
@@ -3658,6 +3679,7 @@ DDTeamCollection::DDTeamCollection(DDTeamCollectionInitParams const& params)
     getUnhealthyRelocationCount(params.getUnhealthyRelocationCount), removeFailedServer(params.removeFailedServer),
     ddTrackerStartingEventHolder(makeReference<EventCacheHolder>("DDTrackerStarting")),
     teamCollectionInfoEventHolder(makeReference<EventCacheHolder>("TeamCollectionInfo")),
+    teamBuildingEventHolder(makeReference<EventCacheHolder>(params.primary ? "TeamBuilding" : "TeamBuildingRemote")),
     storageServerRecruitmentEventHolder(
         makeReference<EventCacheHolder>("StorageServerRecruitment_" + params.distributorId.toString())),
     primary(params.primary), distributorId(params.distributorId), configuration(params.configuration),
@@ -3783,6 +3805,35 @@ int64_t DDTeamCollection::getDebugTotalDataInFlight() const {
 	return total;
 }
 
+double DDTeamCollection::getLoadPressure(TCTeamInfo const& team) const {
+	double pressure = 0;
+	for (const auto& server : team.getServers()) {
+		// A server ratekeeper has not heard from yet is usually a new one, the best place for data
+		auto stats = storageStats.find(server->getId());
+		if (stats != storageStats.end()) {
+			pressure = std::max({ pressure,
+			                      stats->second.cpuUsage / 100.0,
+			                      double(stats->second.storageQueue) / SERVER_KNOBS->TARGET_BYTES_PER_STORAGE_SERVER,
+			                      double(stats->second.storageDurabilityLag) /
+			                          SERVER_KNOBS->TARGET_DURABILITY_LAG_VERSIONS });
+		}
+		if (server->metricsPresent()) {
+			pressure = std::max(pressure,
+			                    double(server->getMetrics().load.bytesReadPerKSecond) /
+			                        SERVER_KNOBS->DD_STORAGE_READ_BANDWIDTH_CAPACITY_PER_KSEC);
+		}
+	}
+	return std::min(pressure, 1.0);
+}
+
+int64_t DDTeamCollection::getPlacementLoadBytes(TCTeamInfo const& team, double inflightPenalty) const {
+	int64_t loadBytes = team.getLoadBytes(true, inflightPenalty);
+	if (!SERVER_KNOBS->DD_LOAD_AWARE_TEAM_SELECTION) {
+		return loadBytes;
+	}
+	return loadBytes * (1.0 + SERVER_KNOBS->DD_LOAD_PRESSURE_WEIGHT * getLoadPressure(team));
+}
+
 bool DDTeamCollection::isValidLocality(Reference<IReplicationPolicy> storagePolicy,
                                        const LocalityData& locality) const {
 	// Future: Once we add simulation test that misconfigure a cluster, such as not setting some locality entries,
@@ -4151,36 +4202,48 @@ int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 	// Step 1: Create machineLocalityMap which will be used in building machine team
 	rebuildMachineLocalityMap();
 
+	const bool incremental = SERVER_KNOBS->DD_INCREMENTAL_TEAM_BUILDING;
+	int machinesBelowTarget = 0;
+	TeamCountIndex<TCMachineInfo> machineIndex;
+	if (incremental) {
+		machineIndex = indexMachinesByTeamCount(&machinesBelowTarget);
+	}
+
 	// Add a team in each iteration
-	while (addedMachineTeams < machineTeamsToBuild || notEnoughMachineTeamsForAMachine()) {
+	while (addedMachineTeams < machineTeamsToBuild ||
+	       (incremental ? machinesBelowTarget > 0 : notEnoughMachineTeamsForAMachine())) {
 		// Step 2: Get least used machines from which we choose machines as a machine team
-		std::vector<Reference<TCMachineInfo>> leastUsedMachines; // A less used machine has less number of teams
-		int minTeamCount = std::numeric_limits<int>::max();
-		for (auto& machine : machine_info) {
-			// Skip invalid machine whose representative server is not in server_info
-			ASSERT_WE_THINK(server_info.find(machine.second->serversOnMachine[0]->getId()) != server_info.end());
-			// Skip unhealthy machines
-			if (!isMachineHealthy(machine.second))
-				continue;
-			// Skip machine with incomplete locality
-			if (!isValidLocality(configuration.storagePolicy,
-			                     machine.second->serversOnMachine[0]->getLastKnownInterface().locality)) {
-				continue;
-			}
+		std::vector<Reference<TCMachineInfo>> scannedMachines; // A less used machine has less number of teams
+		if (!incremental) {
+			int minTeamCount = std::numeric_limits<int>::max();
+			for (auto& machine : machine_info) {
+				// Skip invalid machine whose representative server is not in server_info
+				ASSERT_WE_THINK(server_info.find(machine.second->serversOnMachine[0]->getId()) != server_info.end());
+				// Skip unhealthy machines
+				if (!isMachineHealthy(machine.second))
+					continue;
+				// Skip machine with incomplete locality
+				if (!isValidLocality(configuration.storagePolicy,
+				                     machine.second->serversOnMachine[0]->getLastKnownInterface().locality)) {
+					continue;
+				}
 
-			// Invariant: We only create correct size machine teams.
-			// When configuration (e.g., team size) is changed, the DDTeamCollection will be destroyed and rebuilt
-			// so that the invariant will not be violated.
-			int teamCount = machine.second->machineTeams.size();
+				// Invariant: We only create correct size machine teams.
+				// When configuration (e.g., team size) is changed, the DDTeamCollection will be destroyed and rebuilt
+				// so that the invariant will not be violated.
+				int teamCount = machine.second->machineTeams.size();
 
-			if (teamCount < minTeamCount) {
-				leastUsedMachines.clear();
-				minTeamCount = teamCount;
-			}
-			if (teamCount == minTeamCount) {
-				leastUsedMachines.push_back(machine.second);
+				if (teamCount < minTeamCount) {
+					scannedMachines.clear();
+					minTeamCount = teamCount;
+				}
+				if (teamCount == minTeamCount) {
+					scannedMachines.push_back(machine.second);
+				}
 			}
 		}
+		std::vector<Reference<TCMachineInfo>> const& leastUsedMachines =
+		    incremental ? machineIndex.leastUsed() : scannedMachines;
 
 		std::vector<UID*> team;
 		std::vector<LocalityEntry> forcedAttributes;
@@ -4268,8 +4331,24 @@ int DDTeamCollection::addBestMachineTeams(int machineTeamsToBuild) {
 				machines.push_back(machine);
 			}
 
+			std::vector<int> teamCounts;
+			if (incremental) {
+				for (auto const& machine : machines) {
+					teamCounts.push_back(machine->machineTeams.size());
+				}
+			}
 			addMachineTeam(machines);
 			addedMachineTeams++;
+			if (incremental) {
+				int target = targetMachineTeamNumPerMachine();
+				for (int i = 0; i < machines.size(); ++i) {
+					int teamCount = machines[i]->machineTeams.size();
+					if (teamCounts[i] < target && teamCount >= target && isMachineHealthy(machines[i])) {
+						--machinesBelowTarget;
+					}
+					machineIndex.update(machines[i], teamCount);
+				}
+			}
 		} else {
 			// When too many teams exist in simulation, traceAllInfo will buffer too many trace logs before
 			// trace has a chance to flush its buffer, which causes assertion failure.
@@ -4509,13 +4588,16 @@ int DDTeamCollection::getHealthyMachineTeamCount() const {
 	return healthyTeamCount;
 }
 
-bool DDTeamCollection::notEnoughMachineTeamsForAMachine() const {
+int DDTeamCollection::targetMachineTeamNumPerMachine() const {
 	// If we want to remove the machine team with most machine teams, we use the same logic as
 	// notEnoughTeamsForAServer
-	int targetMachineTeamNumPerMachine =
-	    SERVER_KNOBS->TR_FLAG_REMOVE_MT_WITH_MOST_TEAMS
-	        ? (SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * (configuration.storageTeamSize + 1)) / 2
-	        : SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER;
+	return SERVER_KNOBS->TR_FLAG_REMOVE_MT_WITH_MOST_TEAMS
+	           ? (SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * (configuration.storageTeamSize + 1)) / 2
+	           : SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER;
+}
+
+bool DDTeamCollection::notEnoughMachineTeamsForAMachine() const {
+	int targetMachineTeamNumPerMachine = this->targetMachineTeamNumPerMachine();
 	for (auto& [_, machine] : machine_info) {
 		// If SERVER_KNOBS->TR_FLAG_REMOVE_MT_WITH_MOST_TEAMS is false,
 		// The desired machine team number is not the same with the desired server team number
@@ -4529,7 +4611,7 @@ bool DDTeamCollection::notEnoughMachineTeamsForAMachine() const {
 	return false;
 }
 
-bool DDTeamCollection::notEnoughTeamsForAServer() const {
+int DDTeamCollection::targetTeamNumPerServer() const {
 	// We build more teams than we finally want so that we can use serverTeamRemover() actor to remove the teams
 	// whose member belong to too many teams. This allows us to get a more balanced number of teams per server.
 	// We want to ensure every server has targetTeamNumPerServer teams.
@@ -4539,6 +4621,11 @@ bool DDTeamCollection::notEnoughTeamsForAServer() const {
 	// (#servers * DESIRED_TEAMS_PER_SERVER * storageTeamSize) / #servers.
 	int targetTeamNumPerServer = (SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * (configuration.storageTeamSize + 1)) / 2;
 	ASSERT_GT(targetTeamNumPerServer, 0);
+	return targetTeamNumPerServer;
+}
+
+bool DDTeamCollection::notEnoughTeamsForAServer() const {
+	int targetTeamNumPerServer = this->targetTeamNumPerServer();
 	for (auto& [serverID, server] : server_info) {
 		if (server->getTeams().size() < targetTeamNumPerServer && !server_status.get(serverID).isUnhealthy()) {
 			return true;
@@ -4548,6 +4635,54 @@ bool DDTeamCollection::notEnoughTeamsForAServer() const {
 	return false;
 }
 
+TeamCountIndex<TCServerInfo> DDTeamCollection::indexServersByTeamCount(int* serversBelowTarget) const {
+	TeamCountIndex<TCServerInfo> index;
+	int target = targetTeamNumPerServer();
+	*serversBelowTarget = 0;
+	for (auto& [serverID, server] : server_info) {
+		if (server_status.get(serverID).isUnhealthy())
+			continue;
+		if (server->getTeams().size() < target) {
+			++*serversBelowTarget;
+		}
+		if (isValidLocality(configuration.storagePolicy, server->getLastKnownInterface().locality)) {
+			index.add(server, server->getTeams().size());
+		}
+	}
+	return index;
+}
+
+TeamCountIndex<TCMachineInfo> DDTeamCollection::indexMachinesByTeamCount(int* machinesBelowTarget) const {
+	TeamCountIndex<TCMachineInfo> index;
+	int target = targetMachineTeamNumPerMachine();
+	*machinesBelowTarget = 0;
+	for (auto& [_, machine] : machine_info) {
+		if (!isMachineHealthy(machine))
+			continue;
+		if (machine->machineTeams.size() < target) {
+			++*machinesBelowTarget;
+		}
+		if (isValidLocality(configuration.storagePolicy,
+		                    machine->serversOnMachine[0]->getLastKnownInterface().locality)) {
+			index.add(machine, machine->machineTeams.size());
+		}
+	}
+	return index;
+}
+
+void DDTeamCollection::recordBuildTeamsTime(double seconds) {
+	++buildTeamsCount;
+	lastBuildTeamsSeconds = seconds;
+	maxBuildTeamsSeconds = std::max(maxBuildTeamsSeconds, seconds);
+	TraceEvent(primary ? "TeamBuilding" : "TeamBuildingRemote", distributorId)
+	    .detail("Primary", primary)
+	    .detail("LastSeconds", lastBuildTeamsSeconds)
+	    .detail("MaxSeconds", maxBuildTeamsSeconds)
+	    .detail("Builds", buildTeamsCount)
+	    .detail("Incremental", SERVER_KNOBS->DD_INCREMENTAL_TEAM_BUILDING)
+	    .trackLatest(teamBuildingEventHolder->trackingKey);
+}
+
 int DDTeamCollection::addTeamsBestOf(int teamsToBuild, int desiredTeams, int maxTeams) {
 	ASSERT_GE(teamsToBuild, 0);
 	ASSERT_WE_THINK(machine_info.size() > 0 || server_info.size() == 0);
@@ -4602,14 +4737,26 @@ int DDTeamCollection::addTeamsBestOf(int teamsToBuild, int desiredTeams, int max
 		}
 	}
 
-	while (addedTeams < teamsToBuild || notEnoughTeamsForAServer()) {
+	const bool incremental = SERVER_KNOBS->DD_INCREMENTAL_TEAM_BUILDING;
+	int serversBelowTarget = 0;
+	TeamCountIndex<TCServerInfo> serverIndex;
+	if (incremental) {
+		serverIndex = indexServersByTeamCount(&serversBelowTarget);
+	}
+
+	while (addedTeams < teamsToBuild || (incremental ? serversBelowTarget > 0 : notEnoughTeamsForAServer())) {
 		std::vector<UID> bestServerTeam;
 		int bestScore = std::numeric_limits<int>::max();
 		int maxAttempts = SERVER_KNOBS->BEST_OF_AMT; // BEST_OF_AMT = 4
 		bool earlyQuitBuild = false;
 		for (int i = 0; i < maxAttempts && i < 100; ++i) {
 			// Step 1: Choose 1 least used server and then choose 1 least used machine team from the server
-			Reference<TCServerInfo> chosenServer = findOneLeastUsedServer();
+			Reference<TCServerInfo> chosenServer;
+			if (!incremental) {
+				chosenServer = findOneLeastUsedServer();
+			} else if (!serverIndex.leastUsed().empty()) {
+				chosenServer = deterministicRandom()->randomChoice(serverIndex.leastUsed());
+			}
 			if (!chosenServer.isValid()) {
 				TraceEvent(SevWarn, "NoValidServer").detail("Primary", primary);
 				earlyQuitBuild = true;
@@ -4690,8 +4837,26 @@ int DDTeamCollection::addTeamsBestOf(int teamsToBuild, int desiredTeams, int max
 		}
 
 		// Step 4: Add the server team
+		std::vector<int> teamCounts;
+		if (incremental) {
+			for (auto const& serverID : bestServerTeam) {
+				teamCounts.push_back(server_info[serverID]->getTeams().size());
+			}
+		}
 		addTeam(bestServerTeam.begin(), bestServerTeam.end(), IsInitialTeam::False);
 		addedTeams++;
+		if (incremental) {
+			int target = targetTeamNumPerServer();
+			for (int i = 0; i < bestServerTeam.size(); ++i) {
+				auto const& server = server_info[bestServerTeam[i]];
+				int teamCount = server->getTeams().size();
+				if (teamCounts[i] < target && teamCount >= target &&
+				    !server_status.get(bestServerTeam[i]).isUnhealthy()) {
+					--serversBelowTarget;
+				}
+				serverIndex.update(server, teamCount);
+			}
+		}
 	}
 
 	healthyMachineTeamCount = getHealthyMachineTeamCount();
@@ -5337,6 +5502,31 @@ public:
 		return Void();
 	}
 
+	ACTOR static Future<Void> AddTeamsBestOf_Incremental() {
+		wait(Future<Void>(Void()));
+
+		int teamSize = 3; // replication size
+		int processSize = 60;
+		int desiredTeams = SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * processSize;
+		int maxTeams = SERVER_KNOBS->MAX_TEAMS_PER_SERVER * processSize;
+		bool incremental = SERVER_KNOBS->DD_INCREMENTAL_TEAM_BUILDING;
+
+		Reference<IReplicationPolicy> policy =
+		    makeReference<PolicyAcross>(teamSize, "zoneid", makeReference<PolicyOne>());
+		state std::unique_ptr<DDTeamCollection> collection = testMachineTeamCollection(teamSize, policy, processSize);
+
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_incremental_team_building",
+		                                                          KnobValueRef::create(bool{ true }));
+		int addedTeams = collection->addTeamsBestOf(30, desiredTeams, maxTeams);
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_incremental_team_building",
+		                                                          KnobValueRef::create(bool{ incremental }));
+
+		ASSERT_GT(addedTeams, 0);
+		ASSERT(collection->sanityCheckTeams() == true);
+
+		return Void();
+	}
+
 	ACTOR static Future<Void> AddTeamsBestOf_NotUseMachineID() {
 		wait(Future<Void>(Void()));
 
@@ -5881,6 +6071,67 @@ public:
 
 		return Void();
 	}
+
+	ACTOR static Future<Void> GetTeam_TrueBestLeastLoadPressure() {
+		Reference<IReplicationPolicy> policy = makeReference<PolicyAcross>(3, "zoneid", makeReference<PolicyOne>());
+		state int processSize = 5;
+		state int teamSize = 3;
+		state std::unique_ptr<DDTeamCollection> collection = testTeamCollection(teamSize, policy, processSize);
+		state bool loadAware = SERVER_KNOBS->DD_LOAD_AWARE_TEAM_SELECTION;
+		state double pressureWeight = SERVER_KNOBS->DD_LOAD_PRESSURE_WEIGHT;
+		GetStorageMetricsReply mid_avail;
+		mid_avail.capacity.bytes = 1000 * 1024 * 1024;
+		mid_avail.available.bytes = 400 * 1024 * 1024;
+		mid_avail.load.bytes = 100 * 1024 * 1024;
+
+		GetStorageMetricsReply high_avail;
+		high_avail.capacity.bytes = 1000 * 1024 * 1024;
+		high_avail.available.bytes = 800 * 1024 * 1024;
+		high_avail.load.bytes = 90 * 1024 * 1024;
+
+		collection->addTeam(std::set<UID>({ UID(1, 0), UID(2, 0), UID(3, 0) }), IsInitialTeam::True);
+		collection->addTeam(std::set<UID>({ UID(2, 0), UID(3, 0), UID(4, 0) }), IsInitialTeam::True);
+		collection->disableBuildingTeams();
+		collection->setCheckTeamDelay();
+
+		collection->server_info[UID(1, 0)]->setMetrics(mid_avail);
+		collection->server_info[UID(2, 0)]->setMetrics(high_avail);
+		collection->server_info[UID(3, 0)]->setMetrics(high_avail);
+		collection->server_info[UID(4, 0)]->setMetrics(high_avail);
+
+		/*
+		 * Server 4 has the most free space but is out of CPU, so the other team holding a little more data is the
+		 * better place for more of it.
+		 */
+		collection->storageStats[UID(4, 0)].cpuUsage = 100.0;
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_load_aware_team_selection",
+		                                                          KnobValueRef::create(bool{ true }));
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_load_pressure_weight",
+		                                                          KnobValueRef::create(double{ 1.0 }));
+		ASSERT_EQ(collection->getLoadPressure(*collection->teams[1]), 1.0);
+
+		std::vector<UID> completeSources{ UID(1, 0), UID(2, 0), UID(3, 0) };
+
+		state GetTeamRequest req(
+		    WantNewServers::True, WantTrueBest::True, PreferLowerDiskUtil::True, TeamMustHaveShards::False);
+		req.completeSources = completeSources;
+
+		wait(collection->getTeam(req));
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_load_aware_team_selection",
+		                                                          KnobValueRef::create(bool{ loadAware }));
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_load_pressure_weight",
+		                                                          KnobValueRef::create(double{ pressureWeight }));
+
+		const auto [resTeam, srcFound] = req.reply.getFuture().get();
+
+		std::set<UID> expectedServers{ UID(1, 0), UID(2, 0), UID(3, 0) };
+		ASSERT(resTeam.present());
+		auto servers = resTeam.get()->getServerIDs();
+		const std::set<UID> selectedServers(servers.begin(), servers.end());
+		ASSERT(expectedServers == selectedServers);
+
+		return Void();
+	}
 };
 
 TEST_CASE("DataDistribution/AddTeamsBestOf/UseMachineID") {
@@ -5888,6 +6139,38 @@ TEST_CASE("DataDistribution/AddTeamsBestOf/UseMachineID") {
 	return Void();
 }
 
+TEST_CASE("/DataDistribution/AddTeamsBestOf/Incremental") {
+	wait(DDTeamCollectionUnitTest::AddTeamsBestOf_Incremental());
+	return Void();
+}
+
+namespace {
+struct TeamCountIndexTestItem : ReferenceCounted<TeamCountIndexTestItem> {};
+} // namespace
+
+TEST_CASE("/DataDistribution/TeamCountIndex") {
+	TeamCountIndex<TeamCountIndexTestItem> index;
+	std::vector<Reference<TeamCountIndexTestItem>> items;
+	for (int i = 0; i < 4; ++i) {
+		items.push_back(makeReference<TeamCountIndexTestItem>());
+		index.add(items[i], i < 2 ? 1 : 2);
+	}
+	ASSERT_EQ(index.leastUsed().size(), 2);
+
+	index.update(items[0], 2);
+	ASSERT(index.leastUsed() == std::vector<Reference<TeamCountIndexTestItem>>{ items[1] });
+	index.update(items[1], 3);
+	ASSERT_EQ(index.leastUsed().size(), 3);
+	index.update(items[3], 0);
+	ASSERT(index.leastUsed() == std::vector<Reference<TeamCountIndexTestItem>>{ items[3] });
+
+	// Items that were never added are not indexed
+	index.update(makeReference<TeamCountIndexTestItem>(), 0);
+	ASSERT_EQ(index.leastUsed().size(), 1);
+	ASSERT_EQ(index.size(), 4);
+	return Void();
+}
+
 TEST_CASE("DataDistribution/AddTeamsBestOf/NotUseMachineID") {
 	wait(DDTeamCollectionUnitTest::AddTeamsBestOf_NotUseMachineID());
 	return Void();
@@ -5952,6 +6235,11 @@ TEST_CASE("/DataDistribution/GetTeam/DeprioritizeWigglePausedTeam") {
 	return Void();
 }
 
+TEST_CASE("/DataDistribution/GetTeam/TrueBestLeastLoadPressure") {
+	wait(DDTeamCollectionUnitTest::GetTeam_TrueBestLeastLoadPressure());
+	return Void();
+}
+
 TEST_CASE("/DataDistribution/StorageWiggler/NextIdWithMinAge") {
 	state Reference<StorageWiggler> wiggler = makeReference<StorageWiggler>(nullptr);
 	state double startTime = now();
@@ -91,12 +91,20 @@ struct StringBuffer {
 				    .detail("Reserved", reserved)
 				    .backtrace();
 			}
-			uint8_t* b = new (str.arena()) uint8_t[reserved + alignment - 1];
-			uint8_t* e = b + (reserved + alignment - 1);
+			uint8_t* p;
+			if (alignment == 4096) {
+				// Page aligned buffers come from the aligned buffer pool, which reuses the few sizes commits grow to
+				reserved = (reserved + 4095) & ~4095;
+				p = (uint8_t*)str.arena().allocate4kAlignedBuffer(reserved);
+			} else {
+				uint8_t* b = new (str.arena()) uint8_t[reserved + alignment - 1];
+				uint8_t* e = b + (reserved + alignment - 1);
 
-			uint8_t* p = (uint8_t*)(int64_t(b + alignment - 1) &
-			                        ~(alignment - 1)); // first multiple of alignment greater than or equal to b
-			ASSERT(p >= b && p + reserved <= e && int64_t(p) % alignment == 0);
+				p = (uint8_t*)(int64_t(b + alignment - 1) &
+				               ~(alignment - 1)); // first multiple of alignment greater than or equal to b
+				ASSERT(p >= b && p + reserved <= e);
+			}
+			ASSERT(int64_t(p) % alignment == 0);
 
 			if (str.size() > 0) {
 				memcpy(p, str.begin(), str.size());
@@ -174,7 +182,8 @@ public:
 	    fileSizeWarningLimit(fileSizeWarningLimit), onError(delayed(error.getFuture())), onStopped(stopped.getFuture()),
 	    readyToPush(Void()), lastCommit(Void()), isFirstCommit(true), readingBuffer(dbgid), readingFile(-1),
 	    readingPage(-1), writingPos(-1), fileExtensionBytes(SERVER_KNOBS->DISK_QUEUE_FILE_EXTENSION_BYTES),
-	    fileShrinkBytes(SERVER_KNOBS->DISK_QUEUE_FILE_SHRINK_BYTES) {
+	    fileShrinkBytes(SERVER_KNOBS->DISK_QUEUE_FILE_SHRINK_BYTES),
+	    fileMinBytes(pageCeiling(SERVER_KNOBS->DISK_QUEUE_FILE_PREALLOCATE_BYTES)) {
 		if (BUGGIFY)
 			fileExtensionBytes = _PAGE_SIZE * deterministicRandom()->randomSkewedUInt32(1, 10 << 10);
 		if (BUGGIFY)
@@ -292,6 +301,9 @@ public:
 
 	int64_t fileExtensionBytes;
 	int64_t fileShrinkBytes;
+	// The first extension of a file grows it to at least this size, and it is never shrunk below it, so that a busy
+	// queue does not have to extend its files in small steps
+	int64_t fileMinBytes;
 
 	Int64MetricHandle stallCount;
 
@@ -323,7 +335,8 @@ public:
 		Reference<IAsyncFile> _replacement = wait(IAsyncFileSystem::filesystem()->open(
 		    toReplace->getFilename(),
 		    IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE |
-		        IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK,
+		        IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK |
+		        IAsyncFile::OPEN_IO_URING,
 		    0600));
 		state Reference<IAsyncFile> replacement = _replacement;
 		wait(replacement->sync());
@@ -371,8 +384,8 @@ public:
 
 				const int64_t activeDataVolume = pageCeiling(self->files[0].size - self->files[0].popped +
 				                                             self->fileExtensionBytes + self->fileShrinkBytes);
-				const int64_t desiredMaxFileSize =
-				    pageCeiling(std::max(activeDataVolume, SERVER_KNOBS->TLOG_HARD_LIMIT_BYTES * 2));
+				const int64_t desiredMaxFileSize = pageCeiling(
+				    std::max({ activeDataVolume, SERVER_KNOBS->TLOG_HARD_LIMIT_BYTES * 2, self->fileMinBytes }));
 				const bool frivolouslyTruncate = BUGGIFY_WITH_PROB(0.1);
 				if (self->files[1].size > desiredMaxFileSize || frivolouslyTruncate) {
 					// Either shrink self->files[1] to the size of self->files[0], or chop off fileShrinkBytes
@@ -387,13 +400,14 @@ public:
 						    .detail("ElidedTruncateSize", maxShrink);
 						Reference<IAsyncFile> newFile = wait(replaceFile(self->files[1].f));
 						self->files[1].setFile(newFile);
-						waitfor.push_back(self->files[1].f->truncate(self->fileExtensionBytes));
-						self->files[1].size = self->fileExtensionBytes;
+						self->files[1].size = std::max(self->fileExtensionBytes, self->fileMinBytes);
+						waitfor.push_back(self->files[1].f->truncate(self->files[1].size));
 					} else {
 						CODE_PROBE(true, "Truncating DiskQueue file");
 						const int64_t startingSize = self->files[1].size;
 						self->files[1].size -= std::min(maxShrink, self->files[1].size);
-						self->files[1].size = std::max(self->files[1].size, self->fileExtensionBytes);
+						self->files[1].size =
+						    std::max({ self->files[1].size, self->fileExtensionBytes, self->fileMinBytes });
 						TraceEvent("DiskQueueTruncate", self->dbgid)
 						    .detail("Filename", self->files[1].f->getFilename())
 						    .detail("OldFileSize", startingSize)
@@ -409,6 +423,7 @@ public:
 				int64_t minExtension = pageData.size() + self->writingPos - self->files[1].size;
 				self->files[1].size += std::min(std::max(self->fileExtensionBytes, minExtension),
 				                                self->files[0].size + self->files[1].size + minExtension);
+				self->files[1].size = std::max(self->files[1].size, self->fileMinBytes);
 				waitfor.push_back(self->files[1].f->truncate(self->files[1].size));
 
 				if (self->fileSizeWarningLimit > 0 && self->files[1].size > self->fileSizeWarningLimit) {
@@ -542,7 +557,8 @@ public:
 		for (int i = 0; i < 2; i++)
 			fs.push_back(IAsyncFileSystem::filesystem()->open(self->filename(i),
 			                                                  IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_UNCACHED |
-			                                                      IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK,
+			                                                      IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK |
+			                                                      IAsyncFile::OPEN_IO_URING,
 			                                                  0));
 		wait(waitForAllReady(fs));
 
@@ -561,7 +577,8 @@ public:
 				fs[i] = IAsyncFileSystem::filesystem()->open(
 				    self->filename(i),
 				    IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE |
-				        IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK,
+				        IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_LOCK |
+				        IAsyncFile::OPEN_IO_URING,
 				    0600);
 
 			// Any error here is fatal
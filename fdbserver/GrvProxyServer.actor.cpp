@@ -48,6 +48,7 @@ struct GrvProxyStats {
 	Counter txnBatchPriorityStartIn, txnBatchPriorityStartOut;
 	Counter txnDefaultPriorityStartIn, txnDefaultPriorityStartOut;
 	Counter txnThrottled;
+	Counter txnStartBoundedStale;
 	Counter updatesFromRatekeeper, leaseTimeouts;
 	int systemGRVQueueSize, defaultGRVQueueSize, batchGRVQueueSize;
 	double transactionRateAllowed, batchTransactionRateAllowed;
@@ -111,7 +112,7 @@ struct GrvProxyStats {
 	    txnBatchPriorityStartOut("TxnBatchPriorityStartOut", cc),
 	    txnDefaultPriorityStartIn("TxnDefaultPriorityStartIn", cc),
 	    txnDefaultPriorityStartOut("TxnDefaultPriorityStartOut", cc), txnThrottled("TxnThrottled", cc),
-	    updatesFromRatekeeper("UpdatesFromRatekeeper", cc), leaseTimeouts("LeaseTimeouts", cc), systemGRVQueueSize(0),
+	    txnStartBoundedStale("TxnStartBoundedStale", cc), updatesFromRatekeeper("UpdatesFromRatekeeper", cc), leaseTimeouts("LeaseTimeouts", cc), systemGRVQueueSize(0),
 	    defaultGRVQueueSize(0), batchGRVQueueSize(0), transactionRateAllowed(0), batchTransactionRateAllowed(0),
 	    transactionLimit(0), batchTransactionLimit(0), percentageOfDefaultGRVQueueProcessed(0),
 	    percentageOfBatchGRVQueueProcessed(0), lastBatchQueueThrottled(false), lastDefaultQueueThrottled(false),
@@ -185,6 +186,11 @@ struct GrvProxyData {
 	Version version;
 	Version minKnownCommittedVersion; // we should ask master for this version.
 
+	// The most recent live committed version reply, and the time the request for it was sent. Any version that was
+	// committed before that time is <= the cached version, which bounds the staleness of a cached read version.
+	Optional<GetReadVersionReply> cachedReadVersionReply;
+	double cachedReadVersionTime;
+
 	GrvProxyTagThrottler tagThrottler;
 
 	// Cache of the latest commit versions of storage servers.
@@ -219,7 +225,7 @@ struct GrvProxyData {
 	                                SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                                SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    updateCommitRequests(0), lastCommitTime(0), version(0), minKnownCommittedVersion(invalidVersion),
-	    tagThrottler(SERVER_KNOBS->PROXY_MAX_TAG_THROTTLE_DURATION) {}
+	    cachedReadVersionTime(0), tagThrottler(SERVER_KNOBS->PROXY_MAX_TAG_THROTTLE_DURATION) {}
 };
 
 ACTOR Future<Void> healthMetricsRequestServer(GrvProxyInterface grvProxy,
@@ -367,6 +373,7 @@ ACTOR Future<Void> getRate(UID myID,
                            int64_t* inBatchTransactionCount,
                            GrvTransactionRateInfo* transactionRateInfo,
                            GrvTransactionRateInfo* batchTransactionRateInfo,
+                           GrvTransactionRateInfo* batchReservedRateInfo,
                            GetHealthMetricsReply* healthMetricsReply,
                            GetHealthMetricsReply* detailedHealthMetricsReply,
                            TransactionTagMap<uint64_t>* transactionTagCounter,
@@ -412,6 +419,7 @@ ACTOR Future<Void> getRate(UID myID,
 
 			transactionRateInfo->setRate(rep.transactionRate);
 			batchTransactionRateInfo->setRate(rep.batchTransactionRate);
+			batchReservedRateInfo->setRate(rep.batchReservedRate);
 			stats->transactionRateAllowed = rep.transactionRate;
 			stats->batchTransactionRateAllowed = rep.batchTransactionRate;
 			++stats->updatesFromRatekeeper;
@@ -437,6 +445,7 @@ ACTOR Future<Void> getRate(UID myID,
 		when(wait(leaseTimeout)) {
 			transactionRateInfo->disable();
 			batchTransactionRateInfo->disable();
+			batchReservedRateInfo->disable();
 			++stats->leaseTimeouts;
 			TraceEvent(SevWarn, "GrvProxyRateLeaseExpired", myID).suppressFor(5.0);
 			//TraceEvent("GrvProxyRate", myID).detail("Rate", 0.0).detail("BatchRate", 0.0).detail("Lease", 0);
@@ -680,6 +689,11 @@ ACTOR Future<GetReadVersionReply> getLiveCommittedVersion(std::vector<SpanContex
 		    "TransactionDebug", debugID.get().first(), "GrvProxyServer.getLiveCommittedVersion.After");
 	}
 
+	if (!(flags & GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY) && grvStart > grvProxyData->cachedReadVersionTime) {
+		grvProxyData->cachedReadVersionReply = rep;
+		grvProxyData->cachedReadVersionTime = grvStart;
+	}
+
 	grvProxyData->stats.txnStartOut += transactionCount;
 	grvProxyData->stats.txnSystemPriorityStartOut += systemTransactionCount;
 	grvProxyData->stats.txnDefaultPriorityStartOut += defaultPriTransactionCount;
@@ -688,6 +702,28 @@ ACTOR Future<GetReadVersionReply> getLiveCommittedVersion(std::vector<SpanContex
 	return rep;
 }
 
+// Returns true if a request with FLAG_BOUNDED_STALENESS can be answered from the cached live committed version
+bool canUseCachedReadVersion(GrvProxyData* grvProxyData) {
+	return grvProxyData->cachedReadVersionReply.present() &&
+	       now() - grvProxyData->cachedReadVersionTime <= SERVER_KNOBS->START_TRANSACTION_MAX_READ_VERSION_STALENESS;
+}
+
+// Answers bounded stale GRV requests with the cached live committed version, without asking the master
+GetReadVersionReply getCachedReadVersion(GrvProxyData* grvProxyData,
+                                         int transactionCount,
+                                         int systemTransactionCount,
+                                         int defaultPriTransactionCount,
+                                         int batchPriTransactionCount) {
+	ASSERT(grvProxyData->cachedReadVersionReply.present());
+	CODE_PROBE(true, "GRV proxy answering bounded stale read version from cache");
+	grvProxyData->stats.txnStartBoundedStale += transactionCount;
+	grvProxyData->stats.txnStartOut += transactionCount;
+	grvProxyData->stats.txnSystemPriorityStartOut += systemTransactionCount;
+	grvProxyData->stats.txnDefaultPriorityStartOut += defaultPriTransactionCount;
+	grvProxyData->stats.txnBatchPriorityStartOut += batchPriTransactionCount;
+	return grvProxyData->cachedReadVersionReply.get();
+}
+
 // Returns the current read version (or minimum known committed version if requested),
 // to each request in the provided list. Also check if the request should be throttled.
 // Update GRV statistics according to the request's priority.
@@ -835,6 +871,7 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 	state int64_t batchTransactionCount = 0;
 	state GrvTransactionRateInfo normalRateInfo(10);
 	state GrvTransactionRateInfo batchRateInfo(0);
+	state GrvTransactionRateInfo batchReservedRateInfo(0);
 
 	state Deque<GetReadVersionRequest> systemQueue;
 	state Deque<GetReadVersionRequest> defaultQueue;
@@ -856,6 +893,7 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 	                      &batchTransactionCount,
 	                      &normalRateInfo,
 	                      &batchRateInfo,
+	                      &batchReservedRateInfo,
 	                      healthMetricsReply,
 	                      detailedHealthMetricsReply,
 	                      &transactionTagCounter,
@@ -900,18 +938,20 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 		grvProxyData->tagThrottler.releaseTransactions(elapsed, defaultQueue, batchQueue);
 		normalRateInfo.startReleaseWindow();
 		batchRateInfo.startReleaseWindow();
+		batchReservedRateInfo.startReleaseWindow();
 
 		grvProxyData->stats.transactionLimit = normalRateInfo.getLimit();
 		grvProxyData->stats.batchTransactionLimit = batchRateInfo.getLimit();
 
-		int transactionsStarted[2] = { 0, 0 };
-		int systemTransactionsStarted[2] = { 0, 0 };
-		int defaultPriTransactionsStarted[2] = { 0, 0 };
-		int batchPriTransactionsStarted[2] = { 0, 0 };
+		int transactionsStarted[3] = { 0, 0, 0 };
+		int systemTransactionsStarted[3] = { 0, 0, 0 };
+		int defaultPriTransactionsStarted[3] = { 0, 0, 0 };
+		int batchPriTransactionsStarted[3] = { 0, 0, 0 };
 
-		std::vector<std::vector<GetReadVersionRequest>> start(
-		    2); // start[0] is transactions starting with !(flags&CAUSAL_READ_RISKY), start[1] is transactions starting
-		        // with flags&CAUSAL_READ_RISKY
+		// start[0] is transactions starting with !(flags&CAUSAL_READ_RISKY), start[1] is transactions starting with
+		// flags&CAUSAL_READ_RISKY, and start[2] is bounded stale transactions answered from the cached read version
+		std::vector<std::vector<GetReadVersionRequest>> start(3);
+		const bool useCachedReadVersion = canUseCachedReadVersion(grvProxyData);
 		Optional<UID> debugID;
 
 		int requestsToStart = 0;
@@ -920,8 +960,16 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 		uint32_t batchQueueSize = batchQueue.size();
 		while (requestsToStart < SERVER_KNOBS->START_TRANSACTION_MAX_REQUESTS_TO_START) {
 			Deque<GetReadVersionRequest>* transactionQueue;
+			const int batchStarted =
+			    batchPriTransactionsStarted[0] + batchPriTransactionsStarted[1] + batchPriTransactionsStarted[2];
+			// Batch requests within the reserved rate go ahead of default priority ones
+			bool reservedBatch = false;
 			if (!systemQueue.empty()) {
 				transactionQueue = &systemQueue;
+			} else if (!batchQueue.empty() &&
+			           batchReservedRateInfo.canStart(batchStarted, batchQueue.front().transactionCount)) {
+				transactionQueue = &batchQueue;
+				reservedBatch = true;
 			} else if (!defaultQueue.empty()) {
 				transactionQueue = &defaultQueue;
 			} else if (!batchQueue.empty()) {
@@ -933,11 +981,11 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 			auto& req = transactionQueue->front();
 			int tc = req.transactionCount;
 
-			if (req.priority < TransactionPriority::DEFAULT &&
-			    !batchRateInfo.canStart(transactionsStarted[0] + transactionsStarted[1], tc)) {
+			const int totalStarted = transactionsStarted[0] + transactionsStarted[1] + transactionsStarted[2];
+			if (req.priority < TransactionPriority::DEFAULT && !reservedBatch &&
+			    !batchRateInfo.canStart(totalStarted, tc)) {
 				break;
-			} else if (req.priority < TransactionPriority::IMMEDIATE &&
-			           !normalRateInfo.canStart(transactionsStarted[0] + transactionsStarted[1], tc)) {
+			} else if (req.priority < TransactionPriority::IMMEDIATE && !normalRateInfo.canStart(totalStarted, tc)) {
 				break;
 			}
 
@@ -947,22 +995,27 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 				g_traceBatch.addAttach("TransactionAttachID", req.debugID.get().first(), debugID.get().first());
 			}
 
-			transactionsStarted[req.flags & 1] += tc;
+			int startIndex = req.flags & 1;
+			static_assert(GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY == 1, "Implementation dependent on flag value");
+			if (useCachedReadVersion && (req.flags & GetReadVersionRequest::FLAG_BOUNDED_STALENESS) &&
+			    !(req.flags & GetReadVersionRequest::FLAG_USE_MIN_KNOWN_COMMITTED_VERSION)) {
+				startIndex = 2;
+			}
+			transactionsStarted[startIndex] += tc;
 			double currentTime = g_network->timer();
 			if (req.priority >= TransactionPriority::IMMEDIATE) {
-				systemTransactionsStarted[req.flags & 1] += tc;
+				systemTransactionsStarted[startIndex] += tc;
 				--grvProxyData->stats.systemGRVQueueSize;
 			} else if (req.priority >= TransactionPriority::DEFAULT) {
-				defaultPriTransactionsStarted[req.flags & 1] += tc;
+				defaultPriTransactionsStarted[startIndex] += tc;
 				grvProxyData->stats.defaultTxnGRVTimeInQueue.addMeasurement(currentTime - req.requestTime());
 				--grvProxyData->stats.defaultGRVQueueSize;
 			} else {
-				batchPriTransactionsStarted[req.flags & 1] += tc;
+				batchPriTransactionsStarted[startIndex] += tc;
 				grvProxyData->stats.batchTxnGRVTimeInQueue.addMeasurement(currentTime - req.requestTime());
 				--grvProxyData->stats.batchGRVQueueSize;
 			}
-			start[req.flags & 1].push_back(std::move(req));
-			static_assert(GetReadVersionRequest::FLAG_CAUSAL_READ_RISKY == 1, "Implementation dependent on flag value");
+			start[startIndex].push_back(std::move(req));
 			transactionQueue->pop_front();
 			requestsToStart++;
 		}
@@ -1001,11 +1054,13 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 		.detail("TransactionBudget", transactionBudget)
 		.detail("BatchTransactionBudget", batchTransactionBudget);*/
 
-		int systemTotalStarted = systemTransactionsStarted[0] + systemTransactionsStarted[1];
-		int normalTotalStarted = defaultPriTransactionsStarted[0] + defaultPriTransactionsStarted[1];
-		int batchTotalStarted = batchPriTransactionsStarted[0] + batchPriTransactionsStarted[1];
+		int systemTotalStarted = systemTransactionsStarted[0] + systemTransactionsStarted[1] + systemTransactionsStarted[2];
+		int normalTotalStarted =
+		    defaultPriTransactionsStarted[0] + defaultPriTransactionsStarted[1] + defaultPriTransactionsStarted[2];
+		int batchTotalStarted =
+		    batchPriTransactionsStarted[0] + batchPriTransactionsStarted[1] + batchPriTransactionsStarted[2];
 
-		transactionCount += transactionsStarted[0] + transactionsStarted[1];
+		transactionCount += transactionsStarted[0] + transactionsStarted[1] + transactionsStarted[2];
 		batchTransactionCount += batchTotalStarted;
 
 		normalRateInfo.endReleaseWindow(
@@ -1013,6 +1068,7 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 		batchRateInfo.endReleaseWindow(systemTotalStarted + normalTotalStarted + batchTotalStarted,
 		                               systemQueue.empty() && defaultQueue.empty() && batchQueue.empty(),
 		                               elapsed);
+		batchReservedRateInfo.endReleaseWindow(batchTotalStarted, batchQueue.empty(), elapsed);
 
 		if (debugID.present()) {
 			g_traceBatch.addEvent("TransactionDebug",
@@ -1030,14 +1086,23 @@ ACTOR static Future<Void> transactionStarter(GrvProxyInterface proxy,
 					spanContexts.push_back(request.spanContext);
 				}
 
-				Future<GetReadVersionReply> readVersionReply = getLiveCommittedVersion(spanContexts,
-				                                                                       grvProxyData,
-				                                                                       i,
-				                                                                       debugID,
-				                                                                       transactionsStarted[i],
-				                                                                       systemTransactionsStarted[i],
-				                                                                       defaultPriTransactionsStarted[i],
-				                                                                       batchPriTransactionsStarted[i]);
+				Future<GetReadVersionReply> readVersionReply;
+				if (i == 2) {
+					readVersionReply = getCachedReadVersion(grvProxyData,
+					                                        transactionsStarted[i],
+					                                        systemTransactionsStarted[i],
+					                                        defaultPriTransactionsStarted[i],
+					                                        batchPriTransactionsStarted[i]);
+				} else {
+					readVersionReply = getLiveCommittedVersion(spanContexts,
+					                                           grvProxyData,
+					                                           i,
+					                                           debugID,
+					                                           transactionsStarted[i],
+					                                           systemTransactionsStarted[i],
+					                                           defaultPriTransactionsStarted[i],
+					                                           batchPriTransactionsStarted[i]);
+				}
 				addActor.send(sendGrvReplies(readVersionReply,
 				                             start[i],
 				                             grvProxyData,
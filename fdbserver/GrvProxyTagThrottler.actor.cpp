@@ -36,14 +36,38 @@ bool GrvProxyTagThrottler::DelayedRequest::isMaxThrottled(double maxThrottleDura
 	return now() - startTime > maxThrottleDuration;
 }
 
+GrvProxyTagThrottler::TokenBucket::TokenBucket(double rate) : rate(rate), tokens(capacity()) {}
+
+double GrvProxyTagThrottler::TokenBucket::capacity() const {
+	return rate * SERVER_KNOBS->PROXY_TAG_TOKEN_BUCKET_BURST_SECONDS;
+}
+
+void GrvProxyTagThrottler::TokenBucket::refill(double elapsed) {
+	tokens = std::min(tokens + rate * elapsed, capacity());
+}
+
+bool GrvProxyTagThrottler::TokenBucket::canTake(int64_t count) const {
+	return tokens >= std::min<double>(count, capacity());
+}
+
 void GrvProxyTagThrottler::TagQueue::setRate(double rate) {
 	if (rateInfo.present()) {
 		rateInfo.get().setRate(rate);
+		tokenBucket.setRate(rate);
 	} else {
 		rateInfo = GrvTransactionRateInfo(rate);
+		tokenBucket = TokenBucket(rate);
 	}
 }
 
+bool GrvProxyTagThrottler::TagQueue::canStart(uint32_t numReleased, int64_t count) const {
+	if (!rateInfo.present()) {
+		return true;
+	}
+	return rateInfo.get().canStart(numReleased, count) &&
+	       (!SERVER_KNOBS->PROXY_TAG_TOKEN_BUCKET || tokenBucket.canTake(count));
+}
+
 bool GrvProxyTagThrottler::TagQueue::isMaxThrottled(double maxThrottleDuration) const {
 	return !requests.empty() && requests.front().isMaxThrottled(maxThrottleDuration);
 }
@@ -147,6 +171,7 @@ void GrvProxyTagThrottler::releaseTransactions(double elapsed,
 	for (auto& [tag, queue] : queues) {
 		if (queue.rateInfo.present()) {
 			queue.rateInfo.get().startReleaseWindow();
+			queue.tokenBucket.refill(elapsed);
 		}
 		if (!queue.requests.empty()) {
 			// First place the count in the transactionsReleased object,
@@ -173,8 +198,7 @@ void GrvProxyTagThrottler::releaseTransactions(double elapsed,
 			auto& delayedReq = tagQueueHandle.queue->requests.front();
 			auto count = delayedReq.req.tags.begin()->second;
 			ASSERT_EQ(tagQueueHandle.nextSeqNo, delayedReq.sequenceNumber);
-			if (tagQueueHandle.queue->rateInfo.present() &&
-			    !tagQueueHandle.queue->rateInfo.get().canStart(*(tagQueueHandle.numReleased), count)) {
+			if (!tagQueueHandle.queue->canStart(*(tagQueueHandle.numReleased), count)) {
 				// Cannot release any more transaction from this tag (don't push the tag queue handle back into
 				// pqOfQueues)
 				CODE_PROBE(true, "GrvProxyTagThrottler throttling transaction");
@@ -188,6 +212,9 @@ void GrvProxyTagThrottler::releaseTransactions(double elapsed,
 				if (tagQueueHandle.nextSeqNo < nextQueueSeqNo) {
 					// Releasing transaction
 					*(tagQueueHandle.numReleased) += count;
+					if (tagQueueHandle.queue->rateInfo.present()) {
+						tagQueueHandle.queue->tokenBucket.take(count);
+					}
 					delayedReq.updateProxyTagThrottledDuration(latencyBandsMap);
 					if (delayedReq.req.priority == TransactionPriority::BATCH) {
 						outBatchPriority.push_back(delayedReq.req);
@@ -499,3 +526,38 @@ TEST_CASE("/GrvProxyTagThrottler/LimitedIdleBudget") {
 	ASSERT(isNear(counters["sampleTag"_sr], 60.0 * 10.0));
 	return Void();
 }
+
+// A burst of requests from a throttled tag is held to the tag's rate from the first release window,
+// rather than spending the budget the smoothed rate allows over its window
+TEST_CASE("/GrvProxyTagThrottler/TokenBucketBurst") {
+	state bool const tokenBucket = SERVER_KNOBS->PROXY_TAG_TOKEN_BUCKET;
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("proxy_tag_token_bucket",
+	                                                          KnobValueRef::create(bool{ true }));
+	state GrvProxyTagThrottler throttler(5.0);
+	state std::vector<GetReadVersionRequest> reqs;
+	state Future<Void> server;
+	state int released = 0;
+	{
+		TransactionTagMap<double> rates;
+		rates["sampleTag"_sr] = 10.0;
+		throttler.updateRates(rates);
+	}
+	for (int i = 0; i < 100; ++i) {
+		auto& req = reqs.emplace_back();
+		req.tags["sampleTag"_sr] = 1;
+		req.priority = TransactionPriority::DEFAULT;
+		throttler.addRequest(req);
+	}
+
+	server = mockServer(&throttler);
+	wait(delay(2.0));
+	for (auto const& req : reqs) {
+		released += req.reply.isSet() ? 1 : 0;
+	}
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("proxy_tag_token_bucket",
+	                                                          KnobValueRef::create(bool{ tokenBucket }));
+	TraceEvent("TagQuotaTest_TokenBucketBurst").detail("Released", released);
+	ASSERT_LE(released, 2.0 * 10.0 + 10.0 * SERVER_KNOBS->PROXY_TAG_TOKEN_BUCKET_BURST_SECONDS + 2);
+	ASSERT_GE(released, 15);
+	return Void();
+}
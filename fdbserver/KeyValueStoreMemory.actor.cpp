@@ -870,6 +870,7 @@ private:
 		state int lastDiff = 0;
 		state int snapItems = 0;
 		state uint64_t snapshotBytes = 0;
+		state int64_t sliceBytes = 0;
 
 		// Snapshot keys will be alternately written to two preallocated buffers.
 		// This allows consecutive snapshot keys to be compared for delta compression while only copying each key's
@@ -905,6 +906,7 @@ private:
 			// when this line is reached it is certain that there are no snapshot items in this commit yet.  Since this
 			// commit could be the first thing read during recovery, we can't write a delta yet.
 			bool useDelta = false;
+			sliceBytes = 0;
 
 			// Write snapshot items until the wait above would block because we've used up all of the byte budget
 			loop {
@@ -923,6 +925,15 @@ private:
 					    .detail("CommittedWrites", self->notifiedCommittedWriteBytes.get())
 					    .detail("SnapshotSize", snapshotBytes);
 
+					// Memory taken per item, against the bytes of its key and value, shows the container's overhead
+					if (snapItems > 0) {
+						TraceEvent("KVSMemSnapshotItemBytes", self->id)
+						    .suppressFor(60.0)
+						    .detail("Items", snapItems)
+						    .detail("MemoryBytesPerItem", self->committedDataSize / snapItems)
+						    .detail("DataBytesPerItem", snapshotBytes / snapItems - OP_DISK_OVERHEAD);
+					}
+
 					ASSERT(thisSnapshotEnd >= self->currentSnapshotEnd);
 					self->previousSnapshotEnd = self->currentSnapshotEnd;
 					self->currentSnapshotEnd = thisSnapshotEnd;
@@ -1000,10 +1011,12 @@ private:
 					uint64_t opBytes = opKeySize + next.getValue().size() + OP_DISK_OVERHEAD;
 					snapshotBytes += opBytes;
 					snapshotTotalWrittenBytes += opBytes;
+					sliceBytes += opBytes;
 					lastSnapshotKeyUsingA = !lastSnapshotKeyUsingA;
 
 					// If we're not stopping now, increment next
-					if (snapshotTotalWrittenBytes < self->notifiedCommittedWriteBytes.get()) {
+					if (snapshotTotalWrittenBytes < self->notifiedCommittedWriteBytes.get() &&
+					    sliceBytes < SERVER_KNOBS->KVS_MEM_SNAPSHOT_SLICE_BYTES) {
 						++next;
 					} else {
 						// Otherwise, save state for continuing after the next wait and stop
@@ -1013,6 +1026,12 @@ private:
 					}
 				}
 			}
+
+			// A large commit can owe many megabytes of snapshot. Pay it off in slices, letting commits and reads run
+			// in between; the saved position survives any changes they make to the data.
+			if (sliceBytes >= SERVER_KNOBS->KVS_MEM_SNAPSHOT_SLICE_BYTES) {
+				wait(yield());
+			}
 		}
 	}
 
@@ -341,6 +341,7 @@ const StringRef ROCKSDB_READPREFIX_QUEUEWAIT_HISTOGRAM = "RocksDBReadPrefixQueue
 const StringRef ROCKSDB_READRANGE_NEWITERATOR_HISTOGRAM = "RocksDBReadRangeNewIterator"_sr;
 const StringRef ROCKSDB_READVALUE_GET_HISTOGRAM = "RocksDBReadValueGet"_sr;
 const StringRef ROCKSDB_READPREFIX_GET_HISTOGRAM = "RocksDBReadPrefixGet"_sr;
+const StringRef ROCKSDB_READVALUE_MULTIGET_HISTOGRAM = "RocksDBReadValueMultiGet"_sr;
 const StringRef ROCKSDB_READ_RANGE_BYTES_RETURNED_HISTOGRAM = "RocksDBReadRangeBytesReturned"_sr;
 const StringRef ROCKSDB_READ_RANGE_KV_PAIRS_RETURNED_HISTOGRAM = "RocksDBReadRangeKVPairsReturned"_sr;
 
@@ -445,6 +446,9 @@ struct ReadIterator {
 	double creationTime;
 	KeyRange keyRange;
 	std::shared_ptr<rocksdb::Slice> beginSlice, endSlice;
+	// Set when a forward read stopped at its limit, leaving the cursor on lastKey, the last key it returned.
+	bool positioned = false;
+	Key lastKey;
 	ReadIterator(CF& cf, uint64_t index, DB& db, rocksdb::ReadOptions& options)
 	  : index(index), inUse(true), creationTime(now()), iter(db->NewIterator(options, cf)) {}
 	ReadIterator(CF& cf, uint64_t index, DB& db, rocksdb::ReadOptions options, KeyRange keyRange)
@@ -469,6 +473,9 @@ Write: Iterators in the pool are deleted, forcing new iterator creation on next
 which are currently used by the reads can continue using the iterator as it is a shared_ptr. Once
 the read is processed, shared_ptr goes out of scope and gets deleted. Eventually the iterator object
 gets deleted as the ref count becomes 0.
+
+Iterators go back to the pool positioned where their reads stopped, and a read picks the iterator left closest
+before its begin key. A storage server paging through a range then continues with Next() instead of a Seek().
 */
 class ReadIteratorPool {
 public:
@@ -506,15 +513,20 @@ public:
 	ReadIterator getIterator(KeyRange keyRange) {
 		if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS) {
 			mutex.lock();
+			auto best = iteratorsMap.end();
 			for (it = iteratorsMap.begin(); it != iteratorsMap.end(); it++) {
-				if (!it->second.inUse && it->second.index > deletedUptoIndex) {
-					it->second.inUse = true;
-					iteratorsReuseCount++;
-					ReadIterator iter = it->second;
-					mutex.unlock();
-					return iter;
+				if (!it->second.inUse && it->second.index > deletedUptoIndex &&
+				    (best == iteratorsMap.end() || closerTo(it->second, best->second, keyRange.begin))) {
+					best = it;
 				}
 			}
+			if (best != iteratorsMap.end()) {
+				best->second.inUse = true;
+				iteratorsReuseCount++;
+				ReadIterator iter = best->second;
+				mutex.unlock();
+				return iter;
+			}
 			index++;
 			uint64_t readIteratorIndex = index;
 			mutex.unlock();
@@ -527,16 +539,21 @@ public:
 		} else if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_BOUNDED_ITERATORS) {
 			// TODO: Based on the datasize in the keyrange, decide whether to store the iterator for reuse.
 			mutex.lock();
+			auto best = iteratorsMap.end();
 			for (it = iteratorsMap.begin(); it != iteratorsMap.end(); it++) {
 				if (!it->second.inUse && it->second.index > deletedUptoIndex &&
-				    it->second.keyRange.contains(keyRange)) {
-					it->second.inUse = true;
-					iteratorsReuseCount++;
-					ReadIterator iter = it->second;
-					mutex.unlock();
-					return iter;
+				    it->second.keyRange.contains(keyRange) &&
+				    (best == iteratorsMap.end() || closerTo(it->second, best->second, keyRange.begin))) {
+					best = it;
 				}
 			}
+			if (best != iteratorsMap.end()) {
+				best->second.inUse = true;
+				iteratorsReuseCount++;
+				ReadIterator iter = best->second;
+				mutex.unlock();
+				return iter;
+			}
 			index++;
 			uint64_t readIteratorIndex = index;
 			mutex.unlock();
@@ -568,8 +585,24 @@ public:
 			if (it != iteratorsMap.end()) {
 				ASSERT(it->second.inUse);
 				it->second.inUse = false;
+				it->second.positioned = iter.positioned;
+				it->second.lastKey = iter.lastKey;
+			}
+		}
+	}
+
+	// Positions the cursor on the first key at or after begin. A read starting after the key where the previous read
+	// on this iterator stopped steps forward from there when that reaches begin.
+	void seek(ReadIterator& readIter, KeyRef begin) {
+		auto& cursor = readIter.iter;
+		if (readIter.positioned && readIter.lastKey < begin && cursor->Valid()) {
+			cursor->Next();
+			if (!cursor->Valid() || begin <= toStringRef(cursor->key())) {
+				seeksSkipped++;
+				return;
 			}
 		}
+		cursor->Seek(toSlice(begin));
 	}
 
 	// Called for every ROCKSDB_READ_RANGE_ITERATOR_REFRESH_TIME seconds in a loop.
@@ -591,9 +624,19 @@ public:
 
 	uint64_t numTimesReadIteratorsReused() { return iteratorsReuseCount; }
 
+	uint64_t numReadIteratorSeeksSkipped() { return seeksSkipped; }
+
 	FutureStream<Void> getDeleteIteratorsFutureStream() { return deleteIteratorsPromise.getFuture(); }
 
 private:
+	// Whether a suits a read starting at begin better than b: it was left positioned before begin, closer to it.
+	static bool closerTo(const ReadIterator& a, const ReadIterator& b, KeyRef begin) {
+		if (!a.positioned || a.lastKey >= begin) {
+			return false;
+		}
+		return !b.positioned || b.lastKey >= begin || a.lastKey > b.lastKey;
+	}
+
 	std::unordered_map<int, ReadIterator> iteratorsMap;
 	std::unordered_map<int, ReadIterator>::iterator it;
 	DB& db;
@@ -604,6 +647,7 @@ private:
 	uint64_t index;
 	uint64_t deletedUptoIndex;
 	uint64_t iteratorsReuseCount;
+	std::atomic<uint64_t> seeksSkipped = 0;
 	ThreadReturnPromiseStream<Void> deleteIteratorsPromise;
 };
 
@@ -612,14 +656,22 @@ public:
 	PerfContextMetrics();
 	void reset();
 	void set(int index);
+	// Counted for every batch, not just the sampled ones, and cleared when logged
+	void addMultiGet(int index, int keys, double seconds);
 	void log(bool ignoreZeroMetric);
 
 private:
 	std::vector<std::tuple<const char*, int, std::vector<uint64_t>>> metrics;
+	struct MultiGetStats {
+		std::atomic<uint64_t> batches = 0;
+		std::atomic<uint64_t> keys = 0;
+		std::atomic<uint64_t> micros = 0;
+	};
+	std::vector<MultiGetStats> multiGets;
 	uint64_t getRocksdbPerfcontextMetric(int metric);
 };
 
-PerfContextMetrics::PerfContextMetrics() {
+PerfContextMetrics::PerfContextMetrics() : multiGets(SERVER_KNOBS->ROCKSDB_READ_PARALLELISM) {
 	metrics = {
 		{ "UserKeyComparisonCount", rocksdb_user_key_comparison_count, {} },
 		{ "BlockCacheHitCount", rocksdb_block_cache_hit_count, {} },
@@ -708,6 +760,12 @@ void PerfContextMetrics::set(int index) {
 	}
 }
 
+void PerfContextMetrics::addMultiGet(int index, int keys, double seconds) {
+	multiGets[index].batches += 1;
+	multiGets[index].keys += keys;
+	multiGets[index].micros += static_cast<uint64_t>(seconds * 1e6);
+}
+
 void PerfContextMetrics::log(bool ignoreZeroMetric) {
 	TraceEvent e("RocksDBPerfContextMetrics");
 	e.setMaxEventLength(20000);
@@ -726,6 +784,23 @@ void PerfContextMetrics::log(bool ignoreZeroMetric) {
 		if (vals[SERVER_KNOBS->ROCKSDB_READ_PARALLELISM] != 0)
 			e.detail("WR" + (std::string)name, vals[SERVER_KNOBS->ROCKSDB_READ_PARALLELISM]);
 	}
+	uint64_t batches = 0, keys = 0, micros = 0;
+	for (int i = 0; i < multiGets.size(); i++) {
+		uint64_t readerBatches = multiGets[i].batches.exchange(0);
+		uint64_t readerKeys = multiGets[i].keys.exchange(0);
+		batches += readerBatches;
+		keys += readerKeys;
+		micros += multiGets[i].micros.exchange(0);
+		if (readerBatches != 0) {
+			e.detail("RD" + std::to_string(i) + "MultiGetBatches", readerBatches);
+			e.detail("RD" + std::to_string(i) + "MultiGetKeys", readerKeys);
+		}
+	}
+	if (!ignoreZeroMetric || batches != 0) {
+		e.detail("SumMultiGetBatches", batches);
+		e.detail("SumMultiGetKeys", keys);
+		e.detail("SumMultiGetMicros", micros);
+	}
 }
 
 uint64_t PerfContextMetrics::getRocksdbPerfcontextMetric(int metric) {
@@ -1073,6 +1148,10 @@ ACTOR Future<Void> rocksDBMetricLogger(UID id,
 		e.detail("NumTimesReadIteratorsReused", stat - readIteratorPoolStats["NumTimesReadIteratorsReused"]);
 		readIteratorPoolStats["NumTimesReadIteratorsReused"] = stat;
 
+		stat = readIterPool->numReadIteratorSeeksSkipped();
+		e.detail("NumReadIteratorSeeksSkipped", stat - readIteratorPoolStats["NumReadIteratorSeeksSkipped"]);
+		readIteratorPoolStats["NumReadIteratorSeeksSkipped"] = stat;
+
 		counters->cc.logToTraceEvent(e);
 
 		if (SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE) {
@@ -1567,6 +1646,109 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			sharedState->readLatency[threadIndex]->addMeasurement(endTime - readBeginTime);
 		}
 
+		// Point reads issued together, looked up with a single MultiGet
+		struct MultiGetAction : TypedAction<Reader, MultiGetAction> {
+			std::vector<std::unique_ptr<ReadValueAction>> reads;
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * reads.size(); }
+		};
+		void action(MultiGetAction& a) {
+			ASSERT(cf != nullptr);
+			bool doPerfContextMetrics =
+			    SERVER_KNOBS->ROCKSDB_PERFCONTEXT_ENABLE &&
+			    (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE);
+			if (doPerfContextMetrics) {
+				perfContextMetrics->reset();
+			}
+			const double readBeginTime = timer_monotonic();
+			std::vector<ReadValueAction*> reads;
+			std::vector<rocksdb::Slice> keys;
+			double oldestStartTime = readBeginTime;
+			bool getHistograms = false;
+			Optional<TraceBatch> traceBatch;
+			for (auto& r : a.reads) {
+				sharedState->readQueueLatency[threadIndex]->addMeasurement(readBeginTime - r->startTime);
+				if (r->getHistograms) {
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_QUEUEWAIT_HISTOGRAM.toString(), readBeginTime - r->startTime));
+					getHistograms = true;
+				}
+				if (r->debugID.present()) {
+					if (!traceBatch.present()) {
+						traceBatch = { TraceBatch{} };
+					}
+					traceBatch.get().addEvent("GetValueDebug", r->debugID.get().first(), "Reader.Before");
+				}
+				if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT && readBeginTime - r->startTime > readValueTimeout) {
+					TraceEvent(SevWarn, "KVSTimeout", id)
+					    .detail("Error", "Read value request timedout")
+					    .detail("Method", "MultiGetAction")
+					    .detail("TimeoutValue", readValueTimeout);
+					r->result.sendError(transaction_too_old());
+					continue;
+				}
+				oldestStartTime = std::min(oldestStartTime, r->startTime);
+				reads.push_back(r.get());
+				keys.push_back(toSlice(r->key));
+			}
+			if (reads.empty()) {
+				if (traceBatch.present()) {
+					traceBatch.get().dump();
+				}
+				return;
+			}
+
+			rocksdb::ReadOptions options = sharedState->getReadOptions();
+			if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
+				uint64_t deadlineMircos =
+				    db->GetEnv()->NowMicros() + (readValueTimeout - (readBeginTime - oldestStartTime)) * 1000000;
+				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+				options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+			}
+			options.async_io = SERVER_KNOBS->ROCKSDB_MULTIGET_ASYNC_IO;
+
+			std::vector<rocksdb::PinnableSlice> values(reads.size());
+			std::vector<rocksdb::Status> statuses(reads.size());
+			const double dbGetBeginTime = timer_monotonic();
+			db->MultiGet(options, cf, keys.size(), keys.data(), values.data(), statuses.data());
+			const double dbGetEndTime = timer_monotonic();
+			perfContextMetrics->addMultiGet(threadIndex, reads.size(), dbGetEndTime - dbGetBeginTime);
+			if (getHistograms) {
+				metricPromiseStream->send(
+				    std::make_pair(ROCKSDB_READVALUE_MULTIGET_HISTOGRAM.toString(), dbGetEndTime - dbGetBeginTime));
+			}
+
+			for (int i = 0; i < reads.size(); i++) {
+				if (statuses[i].ok()) {
+					reads[i]->result.send(Value(toStringRef(values[i])));
+				} else if (statuses[i].IsNotFound()) {
+					reads[i]->result.send(Optional<Value>());
+				} else {
+					logRocksDBError(id, statuses[i], "ReadValue");
+					reads[i]->result.sendError(statusToError(statuses[i]));
+				}
+				if (reads[i]->debugID.present()) {
+					traceBatch.get().addEvent("GetValueDebug", reads[i]->debugID.get().first(), "Reader.After");
+				}
+			}
+			if (traceBatch.present()) {
+				traceBatch.get().dump();
+			}
+
+			const double endTime = timer_monotonic();
+			for (auto r : reads) {
+				if (r->getHistograms) {
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_ACTION_HISTOGRAM.toString(), endTime - readBeginTime));
+					metricPromiseStream->send(
+					    std::make_pair(ROCKSDB_READVALUE_LATENCY_HISTOGRAM.toString(), endTime - r->startTime));
+				}
+				sharedState->readLatency[threadIndex]->addMeasurement(endTime - readBeginTime);
+			}
+			if (doPerfContextMetrics) {
+				perfContextMetrics->set(threadIndex);
+			}
+		}
+
 		struct ReadValuePrefixAction : TypedAction<Reader, ReadValuePrefixAction> {
 			Key key;
 			int maxLength;
@@ -1701,13 +1883,16 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 					                                         timer_monotonic() - iterCreationBeginTime));
 				}
 				auto cursor = readIter.iter;
-				cursor->Seek(toSlice(a.keys.begin));
+				readIterPool->seek(readIter, a.keys.begin);
+				readIter.positioned = false;
 				while (cursor->Valid() && toStringRef(cursor->key()) < a.keys.end) {
 					KeyValueRef kv(toStringRef(cursor->key()), toStringRef(cursor->value()));
 					accumulatedBytes += sizeof(KeyValueRef) + kv.expectedSize();
 					result.push_back_deep(result.arena(), kv);
 					// Calling `cursor->Next()` is potentially expensive, so short-circut here just in case.
 					if (result.size() >= a.rowLimit || accumulatedBytes >= a.byteLimit) {
+						readIter.positioned = true;
+						readIter.lastKey = result.back().key;
 						break;
 					}
 					if (SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT && timer_monotonic() - a.startTime > readRangeTimeout) {
@@ -1730,6 +1915,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 					                                         timer_monotonic() - iterCreationBeginTime));
 				}
 				auto cursor = readIter.iter;
+				readIter.positioned = false;
 				cursor->SeekForPrev(toSlice(a.keys.end));
 				if (cursor->Valid() && toStringRef(cursor->key()) == a.keys.end) {
 					cursor->Prev();
@@ -1961,6 +2147,10 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		// The metrics future retains a reference to the DB, so stop it before we delete it.
 		self->metrics.reset();
 
+		self->multiGetFlush.cancel();
+		if (self->pendingMultiGet) {
+			self->readThreads->post(self->pendingMultiGet.release());
+		}
 		wait(self->readThreads->stop());
 		self->readIterPool.reset();
 		auto a = new Writer::CloseAction(self->path, deleteOnClose);
@@ -2106,8 +2296,27 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		return type != ReadType::EAGER && !(key.startsWith(systemKeys.begin));
 	}
 
+	// The read threads serve foreground reads ahead of fetches and other background reads queued before them
+	static TaskPriority readPriority(ReadType type) {
+		switch (type) {
+		case ReadType::EAGER:
+		case ReadType::HIGH:
+			return TaskPriority::DiskRead;
+		case ReadType::LOW:
+			return TaskPriority::LowPriorityRead;
+		case ReadType::FETCH:
+			return TaskPriority::FetchKeys;
+		default:
+			return TaskPriority::DefaultEndpoint;
+		}
+	}
+
 	ACTOR template <class Action>
-	static Future<Optional<Value>> read(Action* action, FlowLock* semaphore, IThreadPool* pool, Counter* counter) {
+	static Future<Optional<Value>> read(Action* action,
+	                                    FlowLock* semaphore,
+	                                    IThreadPool* pool,
+	                                    TaskPriority priority,
+	                                    Counter* counter) {
 		state std::unique_ptr<Action> a(action);
 		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
 		if (!slot.present()) {
@@ -2118,7 +2327,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		state FlowLock::Releaser release(*semaphore);
 
 		auto fut = a->result.getFuture();
-		pool->post(a.release());
+		pool->postWithPriority(a.release(), priority);
 		Optional<Value> result = wait(fut);
 
 		return result;
@@ -2136,7 +2345,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, key)) {
 			auto a = new Reader::ReadValueAction(key, debugID);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			readThreads->postWithPriority(a, readPriority(type));
 			return res;
 		}
 
@@ -2145,7 +2354,46 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadValueAction>(key, debugID);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		if (SERVER_KNOBS->ROCKSDB_MULTIGET_MAX_KEYS > 1) {
+			return readBatched(this, a.release(), &semaphore);
+		}
+		return read(a.release(), &semaphore, readThreads.getPtr(), readPriority(type), &counters.failedToAcquire);
+	}
+
+	// Like read(), but the action joins the MultiGet being gathered instead of being posted on its own
+	ACTOR static Future<Optional<Value>> readBatched(RocksDBKeyValueStore* self,
+	                                                 Reader::ReadValueAction* action,
+	                                                 FlowLock* semaphore) {
+		state std::unique_ptr<Reader::ReadValueAction> a(action);
+		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
+		if (!slot.present()) {
+			++self->counters.failedToAcquire;
+			throw server_overloaded();
+		}
+
+		state FlowLock::Releaser release(*semaphore);
+
+		state Future<Optional<Value>> fut = a->result.getFuture();
+		if (!self->pendingMultiGet) {
+			self->pendingMultiGet = std::make_unique<Reader::MultiGetAction>();
+			self->multiGetFlush = flushMultiGet(self);
+		}
+		self->pendingMultiGet->reads.push_back(std::move(a));
+		if (self->pendingMultiGet->reads.size() >= SERVER_KNOBS->ROCKSDB_MULTIGET_MAX_KEYS) {
+			self->readThreads->post(self->pendingMultiGet.release());
+		}
+		Optional<Value> result = wait(fut);
+
+		return result;
+	}
+
+	// Reads issued in the same run loop iteration share a MultiGet, so a batch waits for no more than that
+	ACTOR static Future<Void> flushMultiGet(RocksDBKeyValueStore* self) {
+		wait(delay(0));
+		if (self->pendingMultiGet) {
+			self->readThreads->post(self->pendingMultiGet.release());
+		}
+		return Void();
 	}
 
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
@@ -2160,7 +2408,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, key)) {
 			auto a = new Reader::ReadValuePrefixAction(key, maxLength, debugID);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			readThreads->postWithPriority(a, readPriority(type));
 			return res;
 		}
 
@@ -2169,12 +2417,13 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadValuePrefixAction>(key, maxLength, debugID);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		return read(a.release(), &semaphore, readThreads.getPtr(), readPriority(type), &counters.failedToAcquire);
 	}
 
 	ACTOR static Future<Standalone<RangeResultRef>> read(Reader::ReadRangeAction* action,
 	                                                     FlowLock* semaphore,
 	                                                     IThreadPool* pool,
+	                                                     TaskPriority priority,
 	                                                     Counter* counter) {
 		state std::unique_ptr<Reader::ReadRangeAction> a(action);
 		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
@@ -2186,7 +2435,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		state FlowLock::Releaser release(*semaphore);
 
 		auto fut = a->result.getFuture();
-		pool->post(a.release());
+		pool->postWithPriority(a.release(), priority);
 		Standalone<RangeResultRef> result = wait(fut);
 
 		return result;
@@ -2205,7 +2454,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, keys.begin)) {
 			auto a = new Reader::ReadRangeAction(keys, rowLimit, byteLimit, counters);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			readThreads->postWithPriority(a, readPriority(type));
 			return res;
 		}
 
@@ -2214,7 +2463,7 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadRangeAction>(keys, rowLimit, byteLimit, counters);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		return read(a.release(), &semaphore, readThreads.getPtr(), readPriority(type), &counters.failedToAcquire);
 	}
 
 	StorageBytes getStorageBytes() const override {
@@ -2291,6 +2540,9 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 	int numReadWaiters;
 	FlowLock fetchSemaphore;
 	int numFetchWaiters;
+	// Point reads waiting for the next MultiGet, see readBatched()
+	std::unique_ptr<Reader::MultiGetAction> pendingMultiGet;
+	Future<Void> multiGetFlush;
 	std::shared_ptr<ReadIteratorPool> readIterPool;
 	std::vector<std::unique_ptr<ThreadReturnPromiseStream<std::pair<std::string, double>>>> metricPromiseStreams;
 	// ThreadReturnPromiseStream pair.first stores the histogram name and
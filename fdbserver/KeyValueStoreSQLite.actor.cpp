@@ -1525,7 +1525,11 @@ void SQLiteDB::open(bool writable) {
 
 	//TraceEvent("KVThreadInitStage").detail("Stage",3).detail("Filename", filename).detail("Writable", writable);
 
-	// Statement(*this, "PRAGMA cache_size = 100").execute();
+	// Every reader connection keeps its own page cache on top of the page cache of the file, which all of them share,
+	// so with many readers a smaller private cache leaves more memory for the shared one.
+	if (!writable && SERVER_KNOBS->SQLITE_READER_CACHE_PAGES > 0) {
+		Statement(*this, format("PRAGMA cache_size = %d", SERVER_KNOBS->SQLITE_READER_CACHE_PAGES).c_str()).execute();
+	}
 
 	Statement jm(*this, "PRAGMA journal_mode");
 	ASSERT(jm.nextRow());
@@ -2034,6 +2038,7 @@ private:
 			    .detail("WriteOps", wc - lastWritesComplete)
 			    .detail("ReadQueue", self->readsRequested - rc)
 			    .detail("WriteQueue", self->writesRequested - wc)
+			    .detail("GlobalSQLiteMemoryUsed", (int64_t)sqlite3_memory_used())
 			    .detail("GlobalSQLiteMemoryHighWater", (int64_t)sqlite3_memory_highwater(1));
 
 			TraceEvent("SpringCleaningMetrics", self->logID)
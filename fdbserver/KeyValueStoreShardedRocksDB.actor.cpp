@@ -7,6 +7,7 @@
 #include "flow/serialize.h"
 #include <rocksdb/c.h>
 #include <rocksdb/cache.h>
+#include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/listener.h>
@@ -20,6 +21,7 @@
 #include <rocksdb/utilities/checkpoint.h>
 #include <rocksdb/utilities/table_properties_collectors.h>
 #include <rocksdb/version.h>
+#include <rocksdb/write_buffer_manager.h>
 #if defined __has_include
 #if __has_include(<liburing.h>)
 #include <liburing.h>
@@ -349,6 +351,92 @@ rocksdb::ColumnFamilyOptions getCFOptions() {
 	return options;
 }
 
+// Column family settings for the physical shards whose first range begins with prefix. A setting of 0, or a missing
+// compression, keeps the default.
+struct ShardCFPolicy {
+	Key prefix;
+	Optional<rocksdb::CompressionType> compression;
+	int blockBytes = 0;
+	int bloomBitsPerKey = 0;
+	int dictBytes = 0;
+};
+
+// Parses ROCKSDB_SHARD_CF_POLICIES: entries "prefix,compression,blockBytes,bloomBitsPerKey[,dictBytes]" separated by
+// ';', where prefix is escaped the way printable() escapes keys and compression is none, lz4, lz4hc or zstd.
+// Entries that cannot be parsed are skipped, as are codecs this RocksDB build does not support.
+std::vector<ShardCFPolicy> parseShardCFPolicies(const std::string& spec) {
+	// zstd is built out of RocksDB (see cmake/CompileRocksDB.cmake), and a column family asking for it fails to open
+	static const std::map<std::string, std::pair<rocksdb::CompressionType, bool>> codecs = {
+		{ "none", { rocksdb::kNoCompression, true } },
+		{ "lz4", { rocksdb::kLZ4Compression, true } },
+		{ "lz4hc", { rocksdb::kLZ4HCCompression, true } },
+		{ "zstd", { rocksdb::kZSTD, false } }
+	};
+	std::vector<ShardCFPolicy> policies;
+	std::stringstream entries(spec);
+	std::string entry;
+	while (std::getline(entries, entry, ';')) {
+		if (entry.empty()) {
+			continue;
+		}
+		std::vector<std::string> fields;
+		std::stringstream fieldStream(entry);
+		std::string field;
+		while (std::getline(fieldStream, field, ',')) {
+			fields.push_back(field);
+		}
+		auto codec = fields.size() >= 2 ? codecs.find(fields[1]) : codecs.end();
+		if (fields.size() < 4 || fields.size() > 5 || codec == codecs.end()) {
+			TraceEvent(SevWarnAlways, "InvalidShardCFPolicy").detail("Policy", entry);
+			continue;
+		}
+		ShardCFPolicy policy;
+		policy.prefix = unprintable(fields[0]);
+		if (codec->second.second) {
+			policy.compression = codec->second.first;
+		} else {
+			TraceEvent(SevWarnAlways, "UnsupportedShardCFCompression").detail("Policy", entry);
+		}
+		policy.blockBytes = atoi(fields[2].c_str());
+		policy.bloomBitsPerKey = atoi(fields[3].c_str());
+		policy.dictBytes = fields.size() == 5 ? atoi(fields[4].c_str()) : 0;
+		policies.push_back(policy);
+	}
+	return policies;
+}
+
+// Returns the policy with the longest prefix of key, or nullptr if none matches.
+const ShardCFPolicy* findShardCFPolicy(const std::vector<ShardCFPolicy>& policies, KeyRef key) {
+	const ShardCFPolicy* best = nullptr;
+	for (const auto& policy : policies) {
+		if (key.startsWith(policy.prefix) && (best == nullptr || policy.prefix.size() > best->prefix.size())) {
+			best = &policy;
+		}
+	}
+	return best;
+}
+
+// Options only apply to the files written after the column family is created, and a shard reopened after a restart
+// gets the default options again.
+void applyShardCFPolicy(rocksdb::ColumnFamilyOptions& options, const ShardCFPolicy& policy) {
+	if (policy.compression.present()) {
+		options.compression = policy.compression.get();
+		if (policy.dictBytes > 0) {
+			options.compression_opts.max_dict_bytes = policy.dictBytes;
+			// RocksDB trains zstd dictionaries on samples of about 100 times the dictionary size.
+			options.compression_opts.zstd_max_train_bytes = policy.dictBytes * 100;
+		}
+	}
+	rocksdb::BlockBasedTableOptions bbOpts = *options.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+	if (policy.blockBytes > 0) {
+		bbOpts.block_size = policy.blockBytes;
+	}
+	if (policy.bloomBitsPerKey > 0) {
+		bbOpts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(policy.bloomBitsPerKey));
+	}
+	options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(bbOpts));
+}
+
 rocksdb::Options getOptions() {
 	rocksdb::Options options({}, getCFOptions());
 	options.avoid_unnecessary_blocking_io = true;
@@ -364,6 +452,11 @@ rocksdb::Options getOptions() {
 
 	options.db_write_buffer_size = SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_SIZE;
 	options.write_buffer_size = SERVER_KNOBS->ROCKSDB_CF_WRITE_BUFFER_SIZE;
+	if (SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_MANAGER_CHARGE_CACHE && rocksdb_block_cache != nullptr) {
+		// Memtables of all physical shards share one budget, and the memory they use is taken from the block cache.
+		options.write_buffer_manager =
+		    std::make_shared<rocksdb::WriteBufferManager>(SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_SIZE, rocksdb_block_cache);
+	}
 	options.statistics = rocksdb::CreateDBStatistics();
 	options.statistics->set_stats_level(rocksdb::kExceptHistogramOrTimers);
 	options.db_log_dir = g_network->isSimulated() ? "" : SERVER_KNOBS->LOG_DIRECTORY;
@@ -384,6 +477,9 @@ struct ReadIterator {
 	double creationTime;
 	KeyRange keyRange;
 	std::shared_ptr<rocksdb::Slice> beginSlice, endSlice;
+	// Set when a forward read stopped at its limit, leaving the cursor on lastKey, the last key it returned.
+	bool positioned = false;
+	Key lastKey;
 
 	ReadIterator(rocksdb::ColumnFamilyHandle* cf, uint64_t index, rocksdb::DB* db, const rocksdb::ReadOptions& options)
 	  : index(index), inUse(true), creationTime(now()), iter(db->NewIterator(options, cf)) {}
@@ -409,6 +505,9 @@ Write: Iterators in the pool are deleted, forcing new iterator creation on next
 which are currently used by the reads can continue using the iterator as it is a shared_ptr. Once
 the read is processed, shared_ptr goes out of scope and gets deleted. Eventually the iterator object
 gets deleted as the ref count becomes 0.
+
+Iterators go back to the pool positioned where their reads stopped, and a read picks the iterator left closest
+before its begin key. A storage server paging through a range then continues with Next() instead of a Seek().
 */
 class ReadIteratorPool {
 public:
@@ -437,13 +536,18 @@ public:
 		// Shared iterators are not bounded.
 		if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS) {
 			std::lock_guard<std::mutex> lock(mutex);
+			auto best = iteratorsMap.end();
 			for (it = iteratorsMap.begin(); it != iteratorsMap.end(); it++) {
-				if (!it->second.inUse) {
-					it->second.inUse = true;
-					iteratorsReuseCount++;
-					return it->second;
+				if (!it->second.inUse &&
+				    (best == iteratorsMap.end() || closerTo(it->second, best->second, range.begin))) {
+					best = it;
 				}
 			}
+			if (best != iteratorsMap.end()) {
+				best->second.inUse = true;
+				iteratorsReuseCount++;
+				return best->second;
+			}
 			index++;
 			ReadIterator iter(cf, index, db, readRangeOptions);
 			iteratorsMap.insert({ index, iter });
@@ -465,8 +569,24 @@ public:
 			if (it != iteratorsMap.end()) {
 				ASSERT(it->second.inUse);
 				it->second.inUse = false;
+				it->second.positioned = iter.positioned;
+				it->second.lastKey = iter.lastKey;
+			}
+		}
+	}
+
+	// Positions the cursor on the first key at or after begin. A read starting after the key where the previous read
+	// on this iterator stopped steps forward from there when that reaches begin.
+	void seek(ReadIterator& readIter, KeyRef begin) {
+		auto& cursor = readIter.iter;
+		if (readIter.positioned && readIter.lastKey < begin && cursor->Valid()) {
+			cursor->Next();
+			if (!cursor->Valid() || begin <= toStringRef(cursor->key())) {
+				seeksSkipped++;
+				return;
 			}
 		}
+		cursor->Seek(toSlice(begin));
 	}
 
 	// Called for every ROCKSDB_READ_RANGE_ITERATOR_REFRESH_TIME seconds in a loop.
@@ -486,7 +606,17 @@ public:
 
 	uint64_t numTimesReadIteratorsReused() { return iteratorsReuseCount; }
 
+	uint64_t numReadIteratorSeeksSkipped() { return seeksSkipped; }
+
 private:
+	// Whether a suits a read starting at begin better than b: it was left positioned before begin, closer to it.
+	static bool closerTo(const ReadIterator& a, const ReadIterator& b, KeyRef begin) {
+		if (!a.positioned || a.lastKey >= begin) {
+			return false;
+		}
+		return !b.positioned || b.lastKey >= begin || a.lastKey > b.lastKey;
+	}
+
 	std::unordered_map<int, ReadIterator> iteratorsMap;
 	std::unordered_map<int, ReadIterator>::iterator it;
 	rocksdb::DB* db;
@@ -496,6 +626,7 @@ private:
 	// incrementing counter for every new iterator creation, to uniquely identify the iterator in returnIterator().
 	uint64_t index;
 	uint64_t iteratorsReuseCount;
+	std::atomic<uint64_t> seeksSkipped = 0;
 };
 
 ACTOR Future<Void> flowLockLogger(const FlowLock* readLock, const FlowLock* fetchLock) {
@@ -661,8 +792,49 @@ struct PhysicalShard {
 	bool deletePending = false;
 	std::atomic<bool> isInitialized;
 	double deleteTimeSec;
+	double lastWriteTime = 0; // Time of the last commit that wrote to the shard
+	// Range deletions since the shard was last compacted for them, and the keys they span
+	int rangeDeletes = 0;
+	Key rangeDeletesBegin;
+	Key rangeDeletesEnd;
 };
 
+struct ShardMemtableUsage {
+	std::string id;
+	int64_t activeBytes;
+	double lastWriteTime;
+};
+
+// Picks the physical shards whose active memtables to flush: every shard above the soft quota (if any), then the
+// coldest shards until the memtables of all shards, totalBytes, are expected to fit in targetBytes. Flushing a cold
+// shard frees memory that its writes will not take back soon, where a hot shard would fill a new memtable quickly.
+std::vector<std::string> selectShardsToFlush(std::vector<ShardMemtableUsage> shards,
+                                             int64_t totalBytes,
+                                             int64_t quota,
+                                             int64_t targetBytes) {
+	std::sort(shards.begin(), shards.end(), [](const ShardMemtableUsage& a, const ShardMemtableUsage& b) {
+		return a.lastWriteTime < b.lastWriteTime;
+	});
+	std::vector<std::string> selected;
+	for (auto& shard : shards) {
+		if (quota > 0 && shard.activeBytes > quota) {
+			selected.push_back(shard.id);
+			totalBytes -= shard.activeBytes;
+			shard.activeBytes = 0;
+		}
+	}
+	for (const auto& shard : shards) {
+		if (totalBytes <= targetBytes) {
+			break;
+		}
+		if (shard.activeBytes > 0) {
+			selected.push_back(shard.id);
+			totalBytes -= shard.activeBytes;
+		}
+	}
+	return selected;
+}
+
 int readRangeInDb(PhysicalShard* shard, const KeyRangeRef range, int rowLimit, int byteLimit, RangeResult* result) {
 	if (rowLimit == 0 || byteLimit == 0) {
 		return 0;
@@ -676,13 +848,16 @@ int readRangeInDb(PhysicalShard* shard, const KeyRangeRef range, int rowLimit, i
 	if (rowLimit >= 0) {
 		ReadIterator readIter = shard->readIterPool->getIterator(range);
 		auto cursor = readIter.iter;
-		cursor->Seek(toSlice(range.begin));
+		shard->readIterPool->seek(readIter, range.begin);
+		readIter.positioned = false;
 		while (cursor->Valid() && toStringRef(cursor->key()) < range.end) {
 			KeyValueRef kv(toStringRef(cursor->key()), toStringRef(cursor->value()));
 			accumulatedBytes += sizeof(KeyValueRef) + kv.expectedSize();
 			result->push_back_deep(result->arena(), kv);
 			// Calling `cursor->Next()` is potentially expensive, so short-circut here just in case.
 			if (result->size() >= rowLimit || accumulatedBytes >= byteLimit) {
+				readIter.positioned = true;
+				readIter.lastKey = result->back().key;
 				break;
 			}
 			cursor->Next();
@@ -692,6 +867,7 @@ int readRangeInDb(PhysicalShard* shard, const KeyRangeRef range, int rowLimit, i
 	} else {
 		ReadIterator readIter = shard->readIterPool->getIterator(range);
 		auto cursor = readIter.iter;
+		readIter.positioned = false;
 		cursor->SeekForPrev(toSlice(range.end));
 		if (cursor->Valid() && toStringRef(cursor->key()) == range.end) {
 			cursor->Prev();
@@ -723,7 +899,8 @@ int readRangeInDb(PhysicalShard* shard, const KeyRangeRef range, int rowLimit, i
 class ShardManager {
 public:
 	ShardManager(std::string path, UID logId, const rocksdb::Options& options)
-	  : path(path), logId(logId), dbOptions(options), dataShardMap(nullptr, specialKeys.end) {}
+	  : path(path), logId(logId), dbOptions(options), dataShardMap(nullptr, specialKeys.end),
+	    cfPolicies(parseShardCFPolicies(SERVER_KNOBS->ROCKSDB_SHARD_CF_POLICIES)) {}
 
 	ACTOR static Future<Void> shardMetricsLogger(std::shared_ptr<ShardedRocksDBState> rState,
 	                                             Future<Void> openFuture,
@@ -1011,8 +1188,20 @@ public:
 			}
 		}
 
-		auto [it, inserted] = physicalShards.emplace(
-		    id, std::make_shared<PhysicalShard>(db, id, rocksdb::ColumnFamilyOptions(dbOptions)));
+		auto it = physicalShards.find(id);
+		if (it == physicalShards.end()) {
+			rocksdb::ColumnFamilyOptions cfOptions(dbOptions);
+			const ShardCFPolicy* policy = findShardCFPolicy(cfPolicies, range.begin);
+			if (policy != nullptr) {
+				applyShardCFPolicy(cfOptions, *policy);
+				TraceEvent(SevInfo, "ShardedRocksShardCFPolicy", this->logId)
+				    .detail("PhysicalShardID", id)
+				    .detail("Prefix", policy->prefix)
+				    .detail("BlockBytes", policy->blockBytes)
+				    .detail("BloomBitsPerKey", policy->bloomBitsPerKey);
+			}
+			it = physicalShards.emplace(id, std::make_shared<PhysicalShard>(db, id, cfOptions)).first;
+		}
 		std::shared_ptr<PhysicalShard>& shard = it->second;
 
 		activePhysicalShardIds.emplace(id);
@@ -1169,11 +1358,38 @@ public:
 				TraceEvent(SevDebug, "ShardedRocksDB").detail("ClearNonExistentRange", it.range());
 				continue;
 			}
-			writeBatch->DeleteRange(it.value()->physicalShard->cf, toSlice(range.begin), toSlice(range.end));
-			dirtyShards->insert(it.value()->physicalShard);
+			PhysicalShard* ps = it.value()->physicalShard;
+			writeBatch->DeleteRange(ps->cf, toSlice(range.begin), toSlice(range.end));
+			dirtyShards->insert(ps);
+
+			KeyRangeRef cleared = range & it.range();
+			if (ps->rangeDeletes++ == 0) {
+				ps->rangeDeletesBegin = cleared.begin;
+				ps->rangeDeletesEnd = cleared.end;
+			} else {
+				ps->rangeDeletesBegin = std::min(ps->rangeDeletesBegin, Key(cleared.begin));
+				ps->rangeDeletesEnd = std::max(ps->rangeDeletesEnd, Key(cleared.end));
+			}
+
+			if (SERVER_KNOBS->ROCKSDB_DELETE_FILES_ON_SHARD_CLEAR && !fullShardClears.count(ps)) {
+				bool coversShard = true;
+				for (const auto& shardRange : ps->getAllRanges()) {
+					coversShard = coversShard && range.contains(shardRange);
+				}
+				if (coversShard) {
+					fullShardClears[ps] = range;
+				}
+			}
 		}
 	}
 
+	// Physical shards that a clearRange since the last commit emptied, with the range that cleared each of them
+	std::unordered_map<PhysicalShard*, KeyRange> getFullShardClears() {
+		std::unordered_map<PhysicalShard*, KeyRange> existingClears;
+		existingClears.swap(fullShardClears);
+		return existingClears;
+	}
+
 	void populateRangeMappingMutations(rocksdb::WriteBatch* writeBatch, KeyRangeRef range, bool isAdd) {
 		TraceEvent(SevDebug, "ShardedRocksDB", this->logId)
 		    .detail("Info", "RangeToPersist")
@@ -1248,6 +1464,9 @@ public:
 	std::unique_ptr<std::set<PhysicalShard*>> getDirtyShards() {
 		std::unique_ptr<std::set<PhysicalShard*>> existingShards = std::move(dirtyShards);
 		dirtyShards = std::make_unique<std::set<PhysicalShard*>>();
+		for (auto shard : *existingShards) {
+			shard->lastWriteTime = now();
+		}
 		return existingShards;
 	}
 
@@ -1336,14 +1555,20 @@ private:
 	std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*> columnFamilyMap;
 	std::unique_ptr<rocksdb::WriteBatch> writeBatch;
 	std::unique_ptr<std::set<PhysicalShard*>> dirtyShards;
+	std::unordered_map<PhysicalShard*, KeyRange> fullShardClears;
 	KeyRangeMap<DataShard*> dataShardMap;
 	std::deque<std::string> pendingDeletionShards;
+	std::vector<ShardCFPolicy> cfPolicies;
 };
 
 class RocksDBMetrics {
 public:
-	RocksDBMetrics(UID debugID, std::shared_ptr<rocksdb::Statistics> stats);
+	RocksDBMetrics(UID debugID,
+	               std::shared_ptr<rocksdb::Statistics> stats,
+	               std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager);
 	void logStats(rocksdb::DB* db);
+	// Totals over the iterator pools of the open physical shards
+	void logReadIteratorPoolStats(ShardManager* shardManager);
 	// PerfContext
 	void resetPerfContext();
 	void collectPerfContext(int index);
@@ -1369,11 +1594,16 @@ public:
 	Reference<Histogram> getDeleteCompactRangeHistogram();
 	// Stat for Memory Usage
 	void logMemUsage(rocksdb::DB* db);
+	void addGovernorFlush(int shards, int64_t bytes);
 
 private:
 	const UID debugID;
 	// Global Statistic Input to RocksDB DB instance
 	std::shared_ptr<rocksdb::Statistics> stats;
+	std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager;
+	// Memtable flushes requested by the memtable governor since the last logMemUsage()
+	int64_t governorFlushedShards = 0;
+	int64_t governorFlushedBytes = 0;
 	// Statistic Output from RocksDB
 	std::vector<std::tuple<const char*, uint32_t, uint64_t>> tickerStats;
 	std::vector<std::pair<const char*, std::string>> intPropertyStats;
@@ -1458,8 +1688,10 @@ Reference<Histogram> RocksDBMetrics::getDeleteCompactRangeHistogram() {
 	return deleteCompactRangeHistogram;
 }
 
-RocksDBMetrics::RocksDBMetrics(UID debugID, std::shared_ptr<rocksdb::Statistics> stats)
-  : debugID(debugID), stats(stats) {
+RocksDBMetrics::RocksDBMetrics(UID debugID,
+                               std::shared_ptr<rocksdb::Statistics> stats,
+                               std::shared_ptr<rocksdb::WriteBufferManager> writeBufferManager)
+  : debugID(debugID), stats(stats), writeBufferManager(writeBufferManager) {
 	tickerStats = {
 		{ "StallMicros", rocksdb::STALL_MICROS, 0 },
 		{ "BytesRead", rocksdb::BYTES_READ, 0 },
@@ -1655,6 +1887,21 @@ void RocksDBMetrics::logStats(rocksdb::DB* db) {
 	}
 }
 
+void RocksDBMetrics::logReadIteratorPoolStats(ShardManager* shardManager) {
+	uint64_t created = 0, reused = 0, seeksSkipped = 0;
+	for (auto& [_, shard] : *shardManager->getAllShards()) {
+		if (shard->initialized()) {
+			created += shard->readIterPool->numReadIteratorsCreated();
+			reused += shard->readIterPool->numTimesReadIteratorsReused();
+			seeksSkipped += shard->readIterPool->numReadIteratorSeeksSkipped();
+		}
+	}
+	TraceEvent(SevInfo, "ShardedRocksDBReadIterators", debugID)
+	    .detail("NumReadIteratorsCreated", created)
+	    .detail("NumTimesReadIteratorsReused", reused)
+	    .detail("NumReadIteratorSeeksSkipped", seeksSkipped);
+}
+
 void RocksDBMetrics::logMemUsage(rocksdb::DB* db) {
 	TraceEvent e(SevInfo, "ShardedRocksDBMemMetrics", debugID);
 	uint64_t stat;
@@ -1667,6 +1914,19 @@ void RocksDBMetrics::logMemUsage(rocksdb::DB* db) {
 	e.detail("AllMemtablesBytes", stat);
 	ASSERT(db->GetAggregatedIntProperty(rocksdb::DB::Properties::kBlockCachePinnedUsage, &stat));
 	e.detail("BlockCachePinnedUsage", stat);
+	if (writeBufferManager != nullptr) {
+		e.detail("WriteBufferManagerUsage", writeBufferManager->memory_usage());
+		e.detail("WriteBufferManagerLimit", writeBufferManager->buffer_size());
+	}
+	e.detail("GovernorFlushedShards", governorFlushedShards);
+	e.detail("GovernorFlushedBytes", governorFlushedBytes);
+	governorFlushedShards = 0;
+	governorFlushedBytes = 0;
+}
+
+void RocksDBMetrics::addGovernorFlush(int shards, int64_t bytes) {
+	governorFlushedShards += shards;
+	governorFlushedBytes += bytes;
 }
 
 void RocksDBMetrics::resetPerfContext() {
@@ -1852,6 +2112,9 @@ ACTOR Future<Void> rocksDBAggregatedMetricsLogger(std::shared_ptr<ShardedRocksDB
 			}
 			rocksDBMetrics->logStats(db);
 			rocksDBMetrics->logMemUsage(db);
+			if (SERVER_KNOBS->ROCKSDB_READ_RANGE_REUSE_ITERATORS) {
+				rocksDBMetrics->logReadIteratorPoolStats(shardManager);
+			}
 			if (SERVER_KNOBS->ROCKSDB_PERFCONTEXT_SAMPLE_RATE != 0) {
 				rocksDBMetrics->logPerfContext(true);
 			}
@@ -2004,10 +2267,39 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			a.done.send(Void());
 		}
 
+		struct FlushShardsAction : TypedAction<Writer, FlushShardsAction> {
+			std::vector<std::shared_ptr<PhysicalShard>> shards;
+			ThreadReturnPromise<Void> done;
+
+			FlushShardsAction(std::vector<std::shared_ptr<PhysicalShard>> shards) : shards(std::move(shards)) {}
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+
+		void action(FlushShardsAction& a) {
+			std::vector<rocksdb::ColumnFamilyHandle*> cfs;
+			for (auto& shard : a.shards) {
+				if (shard->initialized() && !shard->deletePending) {
+					cfs.push_back(shard->cf);
+				}
+			}
+			if (!cfs.empty()) {
+				rocksdb::FlushOptions options;
+				options.wait = false;
+				options.allow_write_stall = true;
+				auto s = a.shards.front()->db->Flush(options, cfs);
+				if (!s.ok()) {
+					logRocksDBError(s, "FlushShards");
+				}
+			}
+			a.shards.clear();
+			a.done.send(Void());
+		}
+
 		struct CommitAction : TypedAction<Writer, CommitAction> {
 			rocksdb::DB* db;
 			std::unique_ptr<rocksdb::WriteBatch> writeBatch;
 			std::unique_ptr<std::set<PhysicalShard*>> dirtyShards;
+			std::unordered_map<PhysicalShard*, KeyRange> fullShardClears;
 			const std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*>* columnFamilyMap;
 			ThreadReturnPromise<Void> done;
 			double startTime;
@@ -2017,9 +2309,10 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			CommitAction(rocksdb::DB* db,
 			             std::unique_ptr<rocksdb::WriteBatch> writeBatch,
 			             std::unique_ptr<std::set<PhysicalShard*>> dirtyShards,
+			             std::unordered_map<PhysicalShard*, KeyRange> fullShardClears,
 			             std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*>* columnFamilyMap)
 			  : db(db), writeBatch(std::move(writeBatch)), dirtyShards(std::move(dirtyShards)),
-			    columnFamilyMap(columnFamilyMap) {
+			    fullShardClears(std::move(fullShardClears)), columnFamilyMap(columnFamilyMap) {
 				if (deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_HISTOGRAMS_SAMPLE_RATE) {
 					getHistograms = true;
 					startTime = timer_monotonic();
@@ -2113,6 +2406,16 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			}
 
 			a.done.send(Void());
+			for (const auto& [shard, range] : a.fullShardClears) {
+				// The range tombstone just written covers every key of the shard, so its SST files can be unlinked
+				// instead of being compacted away. Files overlapping the range only in part, and level 0 files, stay.
+				auto begin = toSlice(range.begin);
+				auto end = toSlice(range.end);
+				auto s = rocksdb::DeleteFilesInRange(a.db, shard->cf, &begin, &end);
+				if (!s.ok()) {
+					logRocksDBError(s, "DeleteFilesInRange");
+				}
+			}
 			if (SERVER_KNOBS->ROCKSDB_SUGGEST_COMPACT_CLEAR_RANGE) {
 				for (const auto& [id, range] : deletes) {
 					auto cf = columnFamilyMap->find(id);
@@ -2740,6 +3043,35 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		}
 	};
 
+	// Runs manual compactions, which block for as long as they take, away from the writer and the readers.
+	struct Compactor : IThreadPoolReceiver {
+		void init() override {}
+
+		struct CompactRangeAction : TypedAction<Compactor, CompactRangeAction> {
+			std::shared_ptr<PhysicalShard> shard;
+			KeyRange range;
+			ThreadReturnPromise<Void> done;
+
+			CompactRangeAction(std::shared_ptr<PhysicalShard> shard, KeyRange range) : shard(shard), range(range) {}
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+
+		void action(CompactRangeAction& a) {
+			if (a.shard->initialized() && !a.shard->deletePending) {
+				rocksdb::CompactRangeOptions options;
+				options.exclusive_manual_compaction = false;
+				auto begin = toSlice(a.range.begin);
+				auto end = toSlice(a.range.end);
+				auto s = a.shard->db->CompactRange(options, a.shard->cf, &begin, &end);
+				if (!s.ok()) {
+					logRocksDBError(s, "CompactRangeDeletes");
+				}
+			}
+			a.shard.reset();
+			a.done.send(Void());
+		}
+	};
+
 	struct Counters {
 		CounterCollection cc;
 		Counter immediateThrottle;
@@ -2758,7 +3090,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	    numFetchWaiters(SERVER_KNOBS->ROCKSDB_FETCH_QUEUE_HARD_MAX - SERVER_KNOBS->ROCKSDB_FETCH_QUEUE_SOFT_MAX),
 	    errorListener(std::make_shared<RocksDBErrorListener>()), errorFuture(errorListener->getFuture()),
 	    dbOptions(getOptions()), shardManager(path, id, dbOptions),
-	    rocksDBMetrics(std::make_shared<RocksDBMetrics>(id, dbOptions.statistics)) {
+	    rocksDBMetrics(
+	        std::make_shared<RocksDBMetrics>(id, dbOptions.statistics, dbOptions.write_buffer_manager)) {
 		// In simluation, run the reader/writer threads as Coro threads (i.e. in the network thread. The storage
 		// engine is still multi-threaded as background compaction threads are still present. Reads/writes to disk
 		// will also block the network thread in a way that would be unacceptable in production but is a necessary
@@ -2774,11 +3107,14 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			TraceEvent(SevDebug, "ShardedRocksDB").detail("Info", "Use Coro threads in simulation.");
 			writeThread = CoroThreadPool::createThreadPool();
 			readThreads = CoroThreadPool::createThreadPool();
+			compactionThread = CoroThreadPool::createThreadPool();
 		} else {
 			writeThread = createGenericThreadPool(/*stackSize=*/0, SERVER_KNOBS->ROCKSDB_WRITER_THREAD_PRIORITY);
 			readThreads = createGenericThreadPool(/*stackSize=*/0, SERVER_KNOBS->ROCKSDB_READER_THREAD_PRIORITY);
+			compactionThread = createGenericThreadPool(/*stackSize=*/0, SERVER_KNOBS->ROCKSDB_WRITER_THREAD_PRIORITY);
 		}
 		writeThread->addThread(new Writer(id, 0, shardManager.getColumnFamilyMap(), rocksDBMetrics), "fdb-rocksdb-wr");
+		compactionThread->addThread(new Compactor(), "fdb-rocksdb-cp");
 		TraceEvent("ShardedRocksDBReadThreads", id)
 		    .detail("KnobRocksDBReadParallelism", SERVER_KNOBS->ROCKSDB_READ_PARALLELISM);
 		for (unsigned i = 0; i < SERVER_KNOBS->ROCKSDB_READ_PARALLELISM; ++i) {
@@ -2794,8 +3130,11 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		self->metrics.reset();
 		self->refreshHolder.cancel();
 		self->cleanUpJob.cancel();
+		self->memtableGovernorJob.cancel();
+		self->rangeDeleteCompactionJob.cancel();
 
 		wait(self->readThreads->stop());
+		wait(self->compactionThread->stop());
 		auto a = new Writer::CloseAction(&self->shardManager, deleteOnClose);
 		auto f = a->done.getFuture();
 		self->writeThread->post(a);
@@ -2830,6 +3169,10 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			                rocksDBAggregatedMetricsLogger(this->rState, openFuture, rocksDBMetrics, &shardManager);
 			this->refreshHolder = refreshReadIteratorPools(this->rState, openFuture, shardManager.getAllShards());
 			this->cleanUpJob = emptyShardCleaner(this->rState, openFuture, &shardManager, writeThread);
+			this->memtableGovernorJob =
+			    memtableGovernor(this->rState, openFuture, &shardManager, writeThread, rocksDBMetrics);
+			this->rangeDeleteCompactionJob =
+			    rangeDeleteCompactor(this->rState, openFuture, &shardManager, compactionThread);
 			writeThread->post(a.release());
 			return openFuture;
 		}
@@ -2877,6 +3220,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		auto a = new Writer::CommitAction(shardManager.getDb(),
 		                                  shardManager.getWriteBatch(),
 		                                  shardManager.getDirtyShards(),
+		                                  shardManager.getFullShardClears(),
 		                                  shardManager.getColumnFamilyMap());
 		auto res = a->done.getFuture();
 		writeThread->post(a);
@@ -3055,6 +3399,119 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		return Void();
 	}
 
+	// Keeps the memtables of all physical shards under a share of ROCKSDB_WRITE_BUFFER_SIZE by flushing shards over
+	// their soft quota and, when that is not enough, the shards written to least recently. RocksDB would otherwise
+	// only flush once the whole budget is used, and then the largest memtable, however hot.
+	ACTOR static Future<Void> memtableGovernor(std::shared_ptr<ShardedRocksDBState> rState,
+	                                           Future<Void> openFuture,
+	                                           ShardManager* shardManager,
+	                                           Reference<IThreadPool> writeThread,
+	                                           std::shared_ptr<RocksDBMetrics> rocksDBMetrics) {
+		if (SERVER_KNOBS->ROCKSDB_MEMTABLE_GOVERNOR_INTERVAL <= 0) {
+			return Void();
+		}
+		try {
+			wait(openFuture);
+			loop {
+				wait(delay(SERVER_KNOBS->ROCKSDB_MEMTABLE_GOVERNOR_INTERVAL));
+				if (rState->closing) {
+					break;
+				}
+				rocksdb::DB* db = shardManager->getDb();
+				uint64_t totalBytes = 0;
+				ASSERT(db->GetAggregatedIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &totalBytes));
+				const int64_t targetBytes =
+				    SERVER_KNOBS->ROCKSDB_WRITE_BUFFER_SIZE * SERVER_KNOBS->ROCKSDB_MEMTABLE_GOVERNOR_TARGET_RATIO;
+				if ((int64_t)totalBytes <= targetBytes && SERVER_KNOBS->ROCKSDB_SHARD_MEMTABLE_SOFT_QUOTA <= 0) {
+					continue;
+				}
+
+				std::vector<ShardMemtableUsage> usage;
+				for (auto& [id, shard] : *shardManager->getAllShards()) {
+					uint64_t activeBytes = 0;
+					if (shard->initialized() && !shard->deletePending &&
+					    db->GetIntProperty(shard->cf, rocksdb::DB::Properties::kCurSizeActiveMemTable, &activeBytes)) {
+						usage.push_back({ id, (int64_t)activeBytes, shard->lastWriteTime });
+					}
+				}
+				std::vector<std::string> ids = selectShardsToFlush(
+				    usage, totalBytes, SERVER_KNOBS->ROCKSDB_SHARD_MEMTABLE_SOFT_QUOTA, targetBytes);
+				if (ids.empty()) {
+					continue;
+				}
+
+				std::vector<std::shared_ptr<PhysicalShard>> shards;
+				int64_t flushedBytes = 0;
+				for (const auto& id : ids) {
+					shards.push_back(shardManager->getAllShards()->at(id));
+					for (const auto& u : usage) {
+						if (u.id == id) {
+							flushedBytes += u.activeBytes;
+						}
+					}
+				}
+				rocksDBMetrics->addGovernorFlush(shards.size(), flushedBytes);
+				TraceEvent(SevDebug, "ShardedRocksDBMemtableGovernorFlush")
+				    .detail("Shards", shards.size())
+				    .detail("FlushedBytes", flushedBytes)
+				    .detail("MemtableBytes", totalBytes)
+				    .detail("TargetBytes", targetBytes);
+				auto a = new Writer::FlushShardsAction(std::move(shards));
+				Future<Void> f = a->done.getFuture();
+				writeThread->post(a);
+				wait(f);
+			}
+		} catch (Error& e) {
+			if (e.code() != error_code_actor_cancelled) {
+				TraceEvent(SevError, "ShardedRocksDBMemtableGovernorError").errorUnsuppressed(e);
+			}
+		}
+		return Void();
+	}
+
+	// Range tombstones slow down every read that crosses them until compaction drops them, and RocksDB only picks
+	// files for compaction by size and age. Compacts the span of a physical shard's range deletions once it has seen
+	// ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER of them.
+	ACTOR static Future<Void> rangeDeleteCompactor(std::shared_ptr<ShardedRocksDBState> rState,
+	                                               Future<Void> openFuture,
+	                                               ShardManager* shardManager,
+	                                               Reference<IThreadPool> compactionThread) {
+		if (SERVER_KNOBS->ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER <= 0) {
+			return Void();
+		}
+		try {
+			wait(openFuture);
+			loop {
+				wait(delay(SERVER_KNOBS->ROCKSDB_RANGE_DELETES_COMPACTION_INTERVAL));
+				if (rState->closing) {
+					break;
+				}
+				std::vector<Future<Void>> compactions;
+				for (auto& [id, shard] : *shardManager->getAllShards()) {
+					if (shard->rangeDeletes < SERVER_KNOBS->ROCKSDB_RANGE_DELETES_COMPACTION_TRIGGER ||
+					    !shard->initialized() || shard->deletePending) {
+						continue;
+					}
+					KeyRange range(KeyRangeRef(shard->rangeDeletesBegin, shard->rangeDeletesEnd));
+					TraceEvent(SevInfo, "ShardedRocksDBCompactRangeDeletes")
+					    .detail("ShardId", id)
+					    .detail("RangeDeletes", shard->rangeDeletes)
+					    .detail("Range", range);
+					shard->rangeDeletes = 0;
+					auto a = new Compactor::CompactRangeAction(shard, range);
+					compactions.push_back(a->done.getFuture());
+					compactionThread->post(a);
+				}
+				wait(waitForAll(compactions));
+			}
+		} catch (Error& e) {
+			if (e.code() != error_code_actor_cancelled) {
+				TraceEvent(SevError, "ShardedRocksDBCompactRangeDeletesError").errorUnsuppressed(e);
+			}
+		}
+		return Void();
+	}
+
 	StorageBytes getStorageBytes() const override {
 		uint64_t live = 0;
 		ASSERT(shardManager.getDb()->GetAggregatedIntProperty(rocksdb::DB::Properties::kLiveSstFilesSize, &live));
@@ -3115,6 +3572,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	UID id;
 	Reference<IThreadPool> writeThread;
 	Reference<IThreadPool> readThreads;
+	Reference<IThreadPool> compactionThread;
 	std::shared_ptr<RocksDBErrorListener> errorListener;
 	Future<Void> errorFuture;
 	Promise<Void> closePromise;
@@ -3127,6 +3585,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	Counters counters;
 	Future<Void> refreshHolder;
 	Future<Void> cleanUpJob;
+	Future<Void> memtableGovernorJob;
+	Future<Void> rangeDeleteCompactionJob;
 };
 
 } // namespace
@@ -3703,6 +4163,86 @@ TEST_CASE("noSim/ShardedRocksDB/CheckpointBasic") {
 
 	return Void();
 }
+
+TEST_CASE("noSim/ShardedRocksDB/IngestBuiltCheckpoint") {
+	state std::string rocksDBTestDir = "sharded-rocks-ingest";
+	state std::string sstDir = "sharded-rocks-ingest-sst";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	platform::eraseDirectoryRecursive(sstDir);
+	state IKeyValueStore* kvStore =
+	    new ShardedRocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	wait(kvStore->init());
+
+	// Two adjacent ranges built offline, restored into one shard without any commit of their data.
+	state Standalone<VectorRef<KeyValueRef>> kvs1;
+	kvs1.push_back_deep(kvs1.arena(), KeyValueRef("a"_sr, "TestValueA"_sr));
+	kvs1.push_back_deep(kvs1.arena(), KeyValueRef("ab"_sr, "TestValueAB"_sr));
+	state Standalone<VectorRef<KeyValueRef>> kvs2;
+	kvs2.push_back_deep(kvs2.arena(), KeyValueRef("b"_sr, "TestValueB"_sr));
+	std::vector<CheckpointMetaData> checkpoints;
+	checkpoints.push_back(buildRocksDBKeyValuesCheckpoint(
+	    sstDir, KeyRangeRef("a"_sr, "b"_sr), kvs1, deterministicRandom()->randomUniqueID()));
+	checkpoints.push_back(buildRocksDBKeyValuesCheckpoint(
+	    sstDir, KeyRangeRef("b"_sr, "c"_sr), kvs2, deterministicRandom()->randomUniqueID()));
+	wait(kvStore->restore("bulk-1", { KeyRangeRef("a"_sr, "c"_sr) }, checkpoints));
+
+	Optional<Value> val = wait(kvStore->readValue("ab"_sr));
+	ASSERT(val == Optional<Value>("TestValueAB"_sr));
+	RangeResult result = wait(kvStore->readRange(KeyRangeRef("a"_sr, "c"_sr)));
+	ASSERT_EQ(result.size(), 3);
+	ASSERT(result[2].key == "b"_sr && result[2].value == "TestValueB"_sr);
+
+	Future<Void> closed = kvStore->onClosed();
+	kvStore->dispose();
+	wait(closed);
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+	platform::eraseDirectoryRecursive(sstDir);
+
+	return Void();
+}
+
+TEST_CASE("noSim/ShardedRocksDB/ShardCFPolicies") {
+	std::vector<ShardCFPolicy> policies =
+	    parseShardCFPolicies(",none,65536,0;\\x01,lz4,4096,10;\\x01idx,none,1024,16,0;bad;x,unknown,1,1");
+	ASSERT_EQ(policies.size(), 3);
+	ASSERT(policies[1].prefix == "\x01"_sr);
+	ASSERT(policies[1].compression.get() == rocksdb::kLZ4Compression);
+	ASSERT_EQ(policies[1].blockBytes, 4096);
+	ASSERT_EQ(policies[1].bloomBitsPerKey, 10);
+
+	// The longest matching prefix wins, and the empty prefix matches everything else
+	ASSERT_EQ(findShardCFPolicy(policies, "\x01idx/a"_sr)->blockBytes, 1024);
+	ASSERT_EQ(findShardCFPolicy(policies, "\x01rows"_sr)->blockBytes, 4096);
+	ASSERT_EQ(findShardCFPolicy(policies, "a"_sr)->blockBytes, 65536);
+	ASSERT(findShardCFPolicy(std::vector<ShardCFPolicy>(), "a"_sr) == nullptr);
+
+	rocksdb::ColumnFamilyOptions options = getCFOptions();
+	applyShardCFPolicy(options, policies[2]);
+	ASSERT(options.compression == rocksdb::kNoCompression);
+	ASSERT_EQ(options.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>()->block_size, 1024);
+	return Void();
+}
+
+TEST_CASE("noSim/ShardedRocksDB/SelectShardsToFlush") {
+	std::vector<ShardMemtableUsage> shards = {
+		{ "hot", 300, 30.0 }, { "warm", 200, 20.0 }, { "cold", 100, 10.0 }, { "empty", 0, 0.0 }
+	};
+
+	// Under the target, nothing is flushed
+	ASSERT(selectShardsToFlush(shards, 600, 0, 600).empty());
+
+	// The coldest shards are flushed first, and only as many as needed
+	std::vector<std::string> ids = selectShardsToFlush(shards, 600, 0, 450);
+	ASSERT(ids == std::vector<std::string>({ "cold", "warm" }));
+
+	// A shard over its quota is flushed however recently it was written, which may be enough on its own
+	ids = selectShardsToFlush(shards, 600, 250, 450);
+	ASSERT(ids == std::vector<std::string>({ "hot" }));
+	ids = selectShardsToFlush(shards, 600, 250, 250);
+	ASSERT(ids == std::vector<std::string>({ "hot", "cold" }));
+
+	return Void();
+}
 } // namespace
 
 #endif // SSD_ROCKSDB_EXPERIMENTAL
@@ -314,6 +314,11 @@ ACTOR Future<Void> pullAsyncData(LogRouterData* self) {
 					++self->getMoreBlockedCount;
 				}
 			}
+			// A peek that stays blocked may be stuck on a slow or unreachable TLog when another replica would do
+			Future<Void> peekFailover = Never();
+			if (r && SERVER_KNOBS->LOG_ROUTER_PEEK_USE_MEASURED_LATENCY && !getMoreF.isReady()) {
+				peekFailover = delay(SERVER_KNOBS->LOG_ROUTER_PEEK_FAILOVER_TIME);
+			}
 			state double startTime = now();
 			choose {
 				when(wait(getMoreF)) {
@@ -335,6 +340,20 @@ ACTOR Future<Void> pullAsyncData(LogRouterData* self) {
 					}
 					dbInfoChange = self->logSystem->onChange();
 				}
+				when(wait(peekFailover)) {
+					if (self->logSystem->get()) {
+						Reference<ILogSystem::IPeekCursor> candidate =
+						    self->logSystem->get()->peekLogRouter(self->dbgid, tagAt, self->routerTag);
+						if (candidate->getPrimaryPeekLocation() != r->getPrimaryPeekLocation()) {
+							CODE_PROBE(true, "Log router switched TLogs after a blocked peek");
+							r = candidate;
+							self->primaryPeekLocation = r->getPrimaryPeekLocation();
+							TraceEvent("LogRouterPeekFailover", self->dbgid)
+							    .detail("LogID", r->getPrimaryPeekLocation())
+							    .detail("BlockedTime", now() - startTime);
+						}
+					}
+				}
 			}
 		}
 
@@ -20,6 +20,8 @@
 
 #include "fdbserver/LogSystem.h"
 #include "fdbclient/FDBTypes.h"
+#include "fdbrpc/FlowTransport.h"
+#include "fdbserver/Knobs.h"
 #include "fdbserver/OTELSpanContextMessage.h"
 #include "fdbserver/SpanContextMessage.h"
 #include "flow/serialize.h"
@@ -189,6 +191,51 @@ int LogSet::bestLocationFor(Tag tag) {
 	return tag.id % logServers.size();
 }
 
+Optional<double> LogSet::measuredPeekLatency(int location) const {
+	const auto& server = logServers[location]->get();
+	if (!server.present()) {
+		return Optional<double>();
+	}
+	const auto& peers = FlowTransport::transport().getAllPeers();
+	auto it = peers.find(server.interf().peekMessages.getEndpoint().getPrimaryAddress());
+	if (it == peers.end()) {
+		return Optional<double>();
+	}
+	const Reference<Peer>& peer = it->second;
+	double latency = 0;
+	if (peer->pingLatencies.getPopulationSize() > 0) {
+		latency = peer->pingLatencies.median();
+	} else if (peer->connectFailedCount == 0) {
+		return Optional<double>();
+	}
+	latency += peer->outstandingReplies * SERVER_KNOBS->LOG_ROUTER_PEEK_OUTSTANDING_REPLY_COST;
+	if (!peer->connected && peer->connectFailedCount > 0) {
+		latency += SERVER_KNOBS->LOG_ROUTER_PEEK_FAILED_CONNECT_COST;
+	}
+	return latency;
+}
+
+int LogSet::bestPeekLocationFor(Tag tag) {
+	int best = bestLocationFor(tag);
+	if (locality != tagLocalitySatellite || !SERVER_KNOBS->LOG_ROUTER_PEEK_USE_MEASURED_LATENCY) {
+		return best;
+	}
+	Optional<double> bestLatency = measuredPeekLatency(best);
+	if (!bestLatency.present()) {
+		return best;
+	}
+	for (int location : satelliteTagLocations[tag == txsTag ? 0 : tag.id + 1]) {
+		Optional<double> latency = measuredPeekLatency(location);
+		if (latency.present() &&
+		    latency.get() < bestLatency.get() * SERVER_KNOBS->LOG_ROUTER_PEEK_SWITCH_LATENCY_RATIO) {
+			CODE_PROBE(true, "Peeking from the satellite TLog with the lowest measured latency");
+			best = location;
+			bestLatency = latency;
+		}
+	}
+	return best;
+}
+
 void LogSet::updateLocalitySet(std::vector<LocalityData> const& localities) {
 	LocalityMap<int>* logServerMap;
 
@@ -297,15 +344,7 @@ void LogPushData::addTransactionInfo(SpanContext const& context) {
 
 void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePreviousLocations) {
 	if (!usePreviousLocations) {
-		prev_tags.clear();
-		if (logSystem->hasRemoteLogs()) {
-			prev_tags.push_back(logSystem->getRandomRouterTag());
-		}
-		for (auto& tag : next_message_tags) {
-			prev_tags.push_back(tag);
-		}
-		msg_locations.clear();
-		logSystem->getPushLocations(prev_tags, msg_locations);
+		updateMessageLocations(false);
 		written_tags.insert(next_message_tags.begin(), next_message_tags.end());
 		next_message_tags.clear();
 	}
@@ -321,6 +360,24 @@ void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePrevio
 	}
 }
 
+void LogPushData::updateMessageLocations(bool allLocations) {
+	prev_tags.clear();
+	if (logSystem->hasRemoteLogs()) {
+		prev_tags.push_back(logSystem->getRandomRouterTag());
+	}
+	for (auto& tag : next_message_tags) {
+		prev_tags.push_back(tag);
+	}
+	if (!msg_locations.empty() && allLocations == location_all_locations && prev_tags == location_tags) {
+		CODE_PROBE(true, "Reusing push locations of the previous message");
+		return;
+	}
+	msg_locations.clear();
+	logSystem->getPushLocations(prev_tags, msg_locations, allLocations);
+	location_tags = prev_tags;
+	location_all_locations = allLocations;
+}
+
 std::vector<Standalone<StringRef>> LogPushData::getAllMessages() const {
 	std::vector<Standalone<StringRef>> results;
 	results.reserve(messagesWriter.size());
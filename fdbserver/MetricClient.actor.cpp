@@ -50,7 +50,10 @@ UDPMetricClient::UDPMetricClient()
 // ifndef guard here to avoid any compilation issues
 void UDPMetricClient::send_packet(int fd, const void* data, size_t len) {
 #ifndef WIN32
-	::send(fd, data, len, MSG_DONTWAIT);
+	if (::send(fd, data, len, MSG_DONTWAIT) < 0) {
+		int error = errno;
+		TraceEvent(SevWarn, "MetricsUdpSendError").suppressFor(60.0).detail("Errno", error).detail("Bytes", len);
+	}
 #endif
 }
 
@@ -84,50 +87,46 @@ void UDPMetricClient::send(MetricCollection* metrics) {
 			serialize_vector(vec, buf, f);
 		};
 
+		// Pack the sums into as few packets as fit, starting a new packet before one would grow too large
 		std::vector<OTEL::OTELSum> currentSums;
 		size_t current_msgpack = 0;
-		for (const auto& [_, s] : metrics->sumMap) {
-			if (current_msgpack < MAX_OTELSUM_PACKET_SIZE) {
-				currentSums.push_back(std::move(s));
-				current_msgpack += s.getMsgpackBytes();
-			} else {
+		for (auto& [_, s] : metrics->sumMap) {
+			uint32_t bytes = s.getMsgpackBytes();
+			if (!currentSums.empty() && current_msgpack + bytes > MAX_OTELSUM_PACKET_SIZE) {
 				sums.push_back(std::move(currentSums));
 				currentSums.clear();
 				current_msgpack = 0;
 			}
+			currentSums.push_back(std::move(s));
+			current_msgpack += bytes;
 		}
-		if (!sums.empty()) {
-			for (const auto& currSums : sums) {
-				serialize_ext(currSums, buf, OTEL::OTELMetricType::Sum, f_sums);
-				send_packet(socket_fd, buf.buffer.get(), buf.data_size);
-				int error = errno;
-				TraceEvent("MetricsSumUdpErrno", UID()).detail("Errno", error);
-				buf.reset();
-			}
-			metrics->sumMap.clear();
+		if (!currentSums.empty()) {
+			sums.push_back(std::move(currentSums));
+		}
+		for (const auto& currSums : sums) {
+			serialize_ext(currSums, buf, OTEL::OTELMetricType::Sum, f_sums);
+			send_packet(socket_fd, buf.buffer.get(), buf.data_size);
+			buf.reset();
 		}
+		metrics->sumMap.clear();
 
 		// Each histogram should be in a seperate because of their large sizes
 		// Expected DDSketch size is ~4200 entries * 9 bytes = 37800
-		for (const auto& [_, h] : metrics->histMap) {
+		for (auto& [_, h] : metrics->histMap) {
 			const std::vector<OTEL::OTELHistogram> singleHist{ std::move(h) };
 			serialize_ext(singleHist, buf, OTEL::OTELMetricType::Hist, f_hists);
 			send_packet(socket_fd, buf.buffer.get(), buf.data_size);
-			int error = errno;
-			TraceEvent("MetricsHistUdpErrno", UID()).detail("Errno", error);
 			buf.reset();
 		}
 
 		metrics->histMap.clear();
 
-		for (const auto& [_, g] : metrics->gaugeMap) {
+		for (auto& [_, g] : metrics->gaugeMap) {
 			gauges.push_back(std::move(g));
 		}
 		if (!gauges.empty()) {
 			serialize_ext(gauges, buf, OTEL::OTELMetricType::Gauge, f_gauge);
 			send_packet(socket_fd, buf.buffer.get(), buf.data_size);
-			int error = errno;
-			TraceEvent("MetricsGaugeUdpErrno", UID()).detail("Errno", error);
 			metrics->gaugeMap.clear();
 			buf.reset();
 		}
@@ -135,11 +134,12 @@ void UDPMetricClient::send(MetricCollection* metrics) {
 		std::string messages;
 		for (const auto& msg : metrics->statsd_message) {
 			// Account for max udp packet size (+1 since we add '\n')
-			if (messages.size() + msg.size() + 1 < IUDPSocket::MAX_PACKET_SIZE) {
-				messages += (std::move(msg) + '\n');
-			} else {
-				send_packet(socket_fd, buf.buffer.get(), buf.data_size);
+			if (!messages.empty() && messages.size() + msg.size() + 1 >= IUDPSocket::MAX_PACKET_SIZE) {
+				send_packet(socket_fd, messages.data(), messages.size());
+				messages.clear();
 			}
+			messages += msg;
+			messages += '\n';
 		}
 		if (!messages.empty()) {
 			send_packet(socket_fd, messages.data(), messages.size());
@@ -578,6 +578,198 @@ ACTOR Future<Void> logWarningAfter(const char* context, double duration, std::ve
 	}
 }
 
+// Returns whether every one of servers is still in the server list
+ACTOR static Future<bool> serversInServerList(Reference<ReadYourWritesTransaction> tr, std::vector<UID> servers) {
+	std::vector<Future<Optional<Value>>> serverListEntries;
+	serverListEntries.reserve(servers.size());
+	for (int s = 0; s < servers.size(); s++)
+		serverListEntries.push_back(tr->get(serverListKeyFor(servers[s])));
+	std::vector<Optional<Value>> serverListValues = wait(getAll(serverListEntries));
+
+	for (int s = 0; s < serverListValues.size(); s++) {
+		if (!serverListValues[s].present()) {
+			// Attempt to move onto a server that isn't in serverList (removed or never added to the
+			// database) This can happen (why?) and is handled by the data distribution algorithm
+			// FIXME: Answer why this can happen?
+			CODE_PROBE(true, "start move keys moving to a removed server", probe::decoration::rare);
+			return false;
+		}
+	}
+	return true;
+}
+
+// Starts moving the prefix of keys covered by one read of keyServers to servers in tr. Returns the end of that prefix
+// and the number of shards in it.
+ACTOR static Future<std::pair<Key, int>> startMoveKeysRange(Reference<ReadYourWritesTransaction> tr,
+                                                            RangeResult UIDtoTagMap,
+                                                            KeyRange keys,
+                                                            std::vector<UID> servers) {
+	// Keep track of old dests that may need to have ranges removed from serverKeys
+	state std::set<UID> oldDests;
+
+	// Keep track of shards for all src servers so that we can preserve their values in serverKeys
+	state Map<UID, VectorRef<KeyRangeRef>> shardMap;
+
+	// Get all existing shards overlapping keys
+	state RangeResult old = wait(krmGetRanges(
+	    tr, keyServersPrefix, keys, SERVER_KNOBS->MOVE_KEYS_KRM_LIMIT, SERVER_KNOBS->MOVE_KEYS_KRM_LIMIT_BYTES));
+
+	// Determine the last processed key (which will be the beginning for the next iteration)
+	state Key endKey = old.end()[-1].key;
+	state KeyRange currentKeys = KeyRangeRef(keys.begin, endKey);
+
+	// Check that enough servers for each shard are in the correct state
+	std::vector<std::vector<UID>> addAsSource = wait(
+	    additionalSources(old, tr, servers.size(), SERVER_KNOBS->MAX_ADDED_SOURCES_MULTIPLIER * servers.size()));
+
+	// For each intersecting range, update keyServers[range] dest to be servers and clear existing dest
+	// servers from serverKeys
+	for (int i = 0; i < old.size() - 1; ++i) {
+		KeyRangeRef rangeIntersectKeys(old[i].key, old[i + 1].key);
+		std::vector<UID> src;
+		std::vector<UID> dest;
+		decodeKeyServersValue(UIDtoTagMap, old[i].value, src, dest);
+
+		for (auto& uid : addAsSource[i]) {
+			src.push_back(uid);
+		}
+		uniquify(src);
+
+		// Update dest servers for this range to be equal to servers
+		krmSetPreviouslyEmptyRange(&(tr->getTransaction()),
+		                           keyServersPrefix,
+		                           rangeIntersectKeys,
+		                           keyServersValue(UIDtoTagMap, src, servers),
+		                           old[i + 1].value);
+
+		// Track old destination servers.  They may be removed from serverKeys soon, since they are
+		// about to be overwritten in keyServers
+		for (auto s = dest.begin(); s != dest.end(); ++s) {
+			oldDests.insert(*s);
+		}
+
+		// Keep track of src shards so that we can preserve their values when we overwrite serverKeys
+		for (auto& uid : src) {
+			shardMap[uid].push_back(old.arena(), rangeIntersectKeys);
+		}
+	}
+
+	// Remove old dests from serverKeys.  In order for krmSetRangeCoalescing to work correctly in the
+	// same prefix for a single transaction, we must do most of the coalescing ourselves.  Only the
+	// shards on the boundary of currentRange are actually coalesced with the ranges outside of
+	// currentRange. For all shards internal to currentRange, we overwrite all consecutive keys whose
+	// value is or should be serverKeysFalse in a single write
+	std::vector<Future<Void>> actors;
+	for (auto oldDest = oldDests.begin(); oldDest != oldDests.end(); ++oldDest)
+		if (std::find(servers.begin(), servers.end(), *oldDest) == servers.end())
+			actors.push_back(removeOldDestinations(tr, *oldDest, shardMap[*oldDest], currentKeys));
+
+	// Update serverKeys to include keys (or the currently processed subset of keys) for each SS in
+	// servers
+	for (int i = 0; i < servers.size(); i++) {
+		// Since we are setting this for the entire range, serverKeys and keyServers aren't guaranteed
+		// to have the same shard boundaries If that invariant was important, we would have to move this
+		// inside the loop above and also set it for the src servers
+		actors.push_back(
+		    krmSetRangeCoalescing(tr, serverKeysPrefixFor(servers[i]), currentKeys, allKeys, serverKeysTrue));
+	}
+
+	wait(waitForAll(actors));
+	return std::make_pair(endKey, old.size() - 1);
+}
+
+// Holds a permit of the batcher's parallelism lock and starts the moves pending once it is granted in one transaction.
+// Each move goes as far as one startMoveKeysRange() gets, and its requester enqueues the rest again.
+ACTOR static Future<Void> startMoveKeysBatch(StartMoveKeysBatcher* batcher) {
+	wait(batcher->parallelismLock->take(TaskPriority::DataDistributionLaunch));
+	state FlowLock::Releaser releaser(*batcher->parallelismLock);
+
+	state std::vector<StartMoveKeysBatcher::Request> requests;
+	while (!batcher->pending.empty() && requests.size() < SERVER_KNOBS->START_MOVE_KEYS_BATCH_SIZE) {
+		// Skip moves that were cancelled while queued
+		if (batcher->pending.front().reply.getFutureReferenceCount()) {
+			requests.push_back(std::move(batcher->pending.front()));
+		}
+		batcher->pending.pop_front();
+	}
+	batcher->collecting = false;
+	if (!batcher->pending.empty()) {
+		batcher->startWorker();
+	}
+
+	state int next = 0;
+	state int batchLimit = requests.size();
+	try {
+		while (next < requests.size()) {
+			state int count = std::min<int>(batchLimit, requests.size() - next);
+			CODE_PROBE(count > 1, "startMoveKeys of several relocations in one transaction");
+			state Reference<ReadYourWritesTransaction> tr = makeReference<ReadYourWritesTransaction>(requests[0].occ);
+			state std::map<UID, StorageServerInterface> tssMapping;
+			state std::vector<Optional<Key>> ends;
+			state int i = 0;
+			loop {
+				try {
+					tr->getTransaction().trState->taskID = TaskPriority::MoveKeys;
+					tr->setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+					tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+
+					wait(checkMoveKeysLock(&(tr->getTransaction()), requests[0].lock, requests[0].ddEnabledState));
+
+					tssMapping.clear();
+					wait(readTSSMappingRYW(tr, &tssMapping));
+
+					state RangeResult UIDtoTagMap = wait(tr->getRange(serverTagKeys, CLIENT_KNOBS->TOO_MANY));
+					ASSERT(!UIDtoTagMap.more && UIDtoTagMap.size() < CLIENT_KNOBS->TOO_MANY);
+
+					// Moves are applied in order, so RYW lets each one see the serverKeys written by the ones before it
+					ends.clear();
+					for (i = 0; i < count; i++) {
+						bool present = wait(serversInServerList(tr, requests[next + i].servers));
+						if (!present) {
+							ends.push_back(Optional<Key>());
+							continue;
+						}
+						std::pair<Key, int> started = wait(
+						    startMoveKeysRange(tr, UIDtoTagMap, requests[next + i].keys, requests[next + i].servers));
+						ends.push_back(started.first);
+					}
+
+					wait(tr->commit());
+					break;
+				} catch (Error& e) {
+					state Error err = e;
+					if (count > 1 && (err.code() == error_code_transaction_too_old ||
+					                  err.code() == error_code_transaction_too_large)) {
+						// Fall back to a transaction per move rather than retrying a batch that cannot commit
+						TraceEvent(SevInfo, "StartMoveKeysBatchTooBig").error(err).detail("Moves", count);
+						count = batchLimit = 1;
+						tr->reset();
+					} else {
+						wait(tr->onError(err));
+					}
+				}
+			}
+
+			for (i = 0; i < count; i++) {
+				if (ends[i].present()) {
+					requests[next + i].reply.send(std::make_pair(ends[i].get(), tssMapping));
+				} else {
+					requests[next + i].reply.sendError(move_to_removed_server());
+				}
+			}
+			next += count;
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		for (; next < requests.size(); next++) {
+			requests[next].reply.sendError(e);
+		}
+	}
+	return Void();
+}
+
 // keyServer: map from keys to destination servers
 // serverKeys: two-dimension map: [servers][keys], value is the servers' state of having the keys: active(not-have),
 // complete(already has), ""(). Set keyServers[keys].dest = servers. Set serverKeys[servers][keys] = active for each
@@ -589,15 +781,18 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
                                         std::vector<UID> servers,
                                         MoveKeysLock lock,
                                         FlowLock* startMoveKeysLock,
+                                        StartMoveKeysBatcher* batcher,
                                         UID relocationIntervalId,
                                         std::map<UID, StorageServerInterface>* tssMapping,
                                         const DDEnabledState* ddEnabledState) {
 	state TraceInterval interval("RelocateShard_StartMoveKeys");
 	state Future<Void> warningLogger = logWarningAfter("StartMoveKeysTooLong", 600, servers);
-	// state TraceInterval waitInterval("");
+	state bool batched = batcher != nullptr && SERVER_KNOBS->START_MOVE_KEYS_BATCH_SIZE > 1;
 
-	wait(startMoveKeysLock->take(TaskPriority::DataDistributionLaunch));
-	state FlowLock::Releaser releaser(*startMoveKeysLock);
+	if (!batched) {
+		wait(startMoveKeysLock->take(TaskPriority::DataDistributionLaunch));
+	}
+	state FlowLock::Releaser releaser(*startMoveKeysLock, batched ? 0 : 1);
 	state bool loadedTssMapping = false;
 
 	TraceEvent(SevDebug, interval.begin(), relocationIntervalId);
@@ -615,6 +810,20 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
 			CODE_PROBE(begin > keys.begin, "Multi-transactional startMoveKeys");
 			batches++;
 
+			if (batched) {
+				StartMoveKeysBatcher::Request request;
+				request.occ = occ;
+				request.keys = KeyRangeRef(begin, keys.end);
+				request.servers = servers;
+				request.lock = lock;
+				request.ddEnabledState = ddEnabledState;
+				std::pair<Key, std::map<UID, StorageServerInterface>> started =
+				    wait(batcher->enqueue(std::move(request)));
+				begin = started.first;
+				*tssMapping = std::move(started.second);
+				continue;
+			}
+
 			// RYW to optimize re-reading the same key ranges
 			state Reference<ReadYourWritesTransaction> tr = makeReference<ReadYourWritesTransaction>(occ);
 			state int retries = 0;
@@ -623,12 +832,6 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
 				try {
 					retries++;
 
-					// Keep track of old dests that may need to have ranges removed from serverKeys
-					state std::set<UID> oldDests;
-
-					// Keep track of shards for all src servers so that we can preserve their values in serverKeys
-					state Map<UID, VectorRef<KeyRangeRef>> shardMap;
-
 					tr->getTransaction().trState->taskID = TaskPriority::MoveKeys;
 					tr->setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
 					tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
@@ -641,122 +844,23 @@ ACTOR static Future<Void> startMoveKeys(Database occ,
 						loadedTssMapping = true;
 					}
 
-					std::vector<Future<Optional<Value>>> serverListEntries;
-					serverListEntries.reserve(servers.size());
-					for (int s = 0; s < servers.size(); s++)
-						serverListEntries.push_back(tr->get(serverListKeyFor(servers[s])));
-					state std::vector<Optional<Value>> serverListValues = wait(getAll(serverListEntries));
-
-					for (int s = 0; s < serverListValues.size(); s++) {
-						if (!serverListValues[s].present()) {
-							// Attempt to move onto a server that isn't in serverList (removed or never added to the
-							// database) This can happen (why?) and is handled by the data distribution algorithm
-							// FIXME: Answer why this can happen?
-							CODE_PROBE(true, "start move keys moving to a removed server", probe::decoration::rare);
-							throw move_to_removed_server();
-						}
+					bool present = wait(serversInServerList(tr, servers));
+					if (!present) {
+						throw move_to_removed_server();
 					}
 
-					// Get all existing shards overlapping keys (exclude any that have been processed in a previous
-					// iteration of the outer loop)
-					state KeyRange currentKeys = KeyRangeRef(begin, keys.end);
-
-					state RangeResult old = wait(krmGetRanges(tr,
-					                                          keyServersPrefix,
-					                                          currentKeys,
-					                                          SERVER_KNOBS->MOVE_KEYS_KRM_LIMIT,
-					                                          SERVER_KNOBS->MOVE_KEYS_KRM_LIMIT_BYTES));
-
-					// Determine the last processed key (which will be the beginning for the next iteration)
-					state Key endKey = old.end()[-1].key;
-					currentKeys = KeyRangeRef(currentKeys.begin, endKey);
-
-					// TraceEvent("StartMoveKeysBatch", relocationIntervalId)
-					//     .detail("KeyBegin", currentKeys.begin.toString())
-					//     .detail("KeyEnd", currentKeys.end.toString());
-
-					// printf("Moving '%s'-'%s' (%d) to %d servers\n", keys.begin.toString().c_str(),
-					// keys.end.toString().c_str(), old.size(), servers.size()); for(int i=0; i<old.size(); i++)
-					// 	printf("'%s': '%s'\n", old[i].key.toString().c_str(), old[i].value.toString().c_str());
-
-					// Check that enough servers for each shard are in the correct state
 					state RangeResult UIDtoTagMap = wait(tr->getRange(serverTagKeys, CLIENT_KNOBS->TOO_MANY));
 					ASSERT(!UIDtoTagMap.more && UIDtoTagMap.size() < CLIENT_KNOBS->TOO_MANY);
-					std::vector<std::vector<UID>> addAsSource = wait(additionalSources(
-					    old, tr, servers.size(), SERVER_KNOBS->MAX_ADDED_SOURCES_MULTIPLIER * servers.size()));
-
-					// For each intersecting range, update keyServers[range] dest to be servers and clear existing dest
-					// servers from serverKeys
-					for (int i = 0; i < old.size() - 1; ++i) {
-						KeyRangeRef rangeIntersectKeys(old[i].key, old[i + 1].key);
-						std::vector<UID> src;
-						std::vector<UID> dest;
-						decodeKeyServersValue(UIDtoTagMap, old[i].value, src, dest);
-
-						// TraceEvent("StartMoveKeysOldRange", relocationIntervalId)
-						//     .detail("KeyBegin", rangeIntersectKeys.begin.toString())
-						//     .detail("KeyEnd", rangeIntersectKeys.end.toString())
-						//     .detail("OldSrc", describe(src))
-						//     .detail("OldDest", describe(dest))
-						//     .detail("ReadVersion", tr->getReadVersion().get());
-
-						for (auto& uid : addAsSource[i]) {
-							src.push_back(uid);
-						}
-						uniquify(src);
 
-						// Update dest servers for this range to be equal to servers
-						krmSetPreviouslyEmptyRange(&(tr->getTransaction()),
-						                           keyServersPrefix,
-						                           rangeIntersectKeys,
-						                           keyServersValue(UIDtoTagMap, src, servers),
-						                           old[i + 1].value);
-
-						// Track old destination servers.  They may be removed from serverKeys soon, since they are
-						// about to be overwritten in keyServers
-						for (auto s = dest.begin(); s != dest.end(); ++s) {
-							oldDests.insert(*s);
-							// TraceEvent("StartMoveKeysOldDestAdd", relocationIntervalId).detail("Server", *s);
-						}
-
-						// Keep track of src shards so that we can preserve their values when we overwrite serverKeys
-						for (auto& uid : src) {
-							shardMap[uid].push_back(old.arena(), rangeIntersectKeys);
-							// TraceEvent("StartMoveKeysShardMapAdd", relocationIntervalId).detail("Server", uid);
-						}
-					}
-
-					state std::set<UID>::iterator oldDest;
-
-					// Remove old dests from serverKeys.  In order for krmSetRangeCoalescing to work correctly in the
-					// same prefix for a single transaction, we must do most of the coalescing ourselves.  Only the
-					// shards on the boundary of currentRange are actually coalesced with the ranges outside of
-					// currentRange. For all shards internal to currentRange, we overwrite all consecutive keys whose
-					// value is or should be serverKeysFalse in a single write
-					std::vector<Future<Void>> actors;
-					for (oldDest = oldDests.begin(); oldDest != oldDests.end(); ++oldDest)
-						if (std::find(servers.begin(), servers.end(), *oldDest) == servers.end())
-							actors.push_back(removeOldDestinations(tr, *oldDest, shardMap[*oldDest], currentKeys));
-
-					// Update serverKeys to include keys (or the currently processed subset of keys) for each SS in
-					// servers
-					for (int i = 0; i < servers.size(); i++) {
-						// Since we are setting this for the entire range, serverKeys and keyServers aren't guaranteed
-						// to have the same shard boundaries If that invariant was important, we would have to move this
-						// inside the loop above and also set it for the src servers
-						actors.push_back(krmSetRangeCoalescing(
-						    tr, serverKeysPrefixFor(servers[i]), currentKeys, allKeys, serverKeysTrue));
-					}
-
-					wait(waitForAll(actors));
+					// Get all existing shards overlapping keys (exclude any that have been processed in a previous
+					// iteration of the outer loop)
+					state std::pair<Key, int> started =
+					    wait(startMoveKeysRange(tr, UIDtoTagMap, KeyRangeRef(begin, keys.end), servers));
 
 					wait(tr->commit());
 
-					/*TraceEvent("StartMoveKeysCommitDone", relocationIntervalId)
-					    .detail("CommitVersion", tr.getCommittedVersion())
-					    .detail("ShardsInBatch", old.size() - 1);*/
-					begin = endKey;
-					shards += old.size() - 1;
+					begin = started.first;
+					shards += started.second;
 					break;
 				} catch (Error& e) {
 					state Error err = e;
@@ -1846,6 +1950,20 @@ ACTOR static Future<Void> finishMoveShards(Database occ,
 
 }; // anonymous namespace
 
+Future<std::pair<Key, std::map<UID, StorageServerInterface>>> StartMoveKeysBatcher::enqueue(Request request) {
+	auto reply = request.reply.getFuture();
+	pending.push_back(std::move(request));
+	if (!collecting) {
+		startWorker();
+	}
+	return reply;
+}
+
+void StartMoveKeysBatcher::startWorker() {
+	collecting = true;
+	workers.add(startMoveKeysBatch(this));
+}
+
 ACTOR Future<std::pair<Version, Tag>> addStorageServer(Database cx, StorageServerInterface server) {
 	state Reference<ReadYourWritesTransaction> tr = makeReference<ReadYourWritesTransaction>(cx);
 	state KeyBackedMap<UID, UID> tssMapDB = KeyBackedMap<UID, UID>(tssMappingKeys.begin);
@@ -2524,6 +2642,7 @@ Future<Void> rawStartMovement(Database occ,
 	                     params.destinationTeam,
 	                     params.lock,
 	                     params.startMoveKeysParallelismLock,
+	                     params.startMoveKeysBatcher,
 	                     params.relocationIntervalId,
 	                     &tssMapping,
 	                     params.ddEnabledState);
@@ -1592,6 +1592,7 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
                               TLogCommitRequest req,
                               Reference<LogData> logData,
                               PromiseStream<Void> warningCollectorInput) {
+	req.decompressMessages();
 	state Optional<UID> tlogDebugID;
 	if (req.debugID.present()) {
 		tlogDebugID = nondeterministicRandom()->randomUniqueID();
@@ -2033,6 +2033,7 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
                               TLogCommitRequest req,
                               Reference<LogData> logData,
                               PromiseStream<Void> warningCollectorInput) {
+	req.decompressMessages();
 	state Optional<UID> tlogDebugID;
 	if (req.debugID.present()) {
 		tlogDebugID = nondeterministicRandom()->randomUniqueID();
@@ -489,6 +489,11 @@ public:
 
 					reply.transactionRate = self.normalLimits.tpsLimit / self.grvProxyInfo.size();
 					reply.batchTransactionRate = self.batchLimits.tpsLimit / self.grvProxyInfo.size();
+					if (SERVER_KNOBS->RATEKEEPER_BATCH_RESERVED_FRACTION > 0) {
+						reply.batchReservedRate =
+						    std::min(reply.batchTransactionRate,
+						             SERVER_KNOBS->RATEKEEPER_BATCH_RESERVED_FRACTION * reply.transactionRate);
+					}
 					reply.leaseDuration = SERVER_KNOBS->METRIC_UPDATE_RATE;
 
 					if (p.lastThrottledTagChangeId != self.tagThrottler->getThrottledTagChangeId() ||
@@ -655,6 +660,16 @@ void Ratekeeper::updateCommitCostEstimation(
 	}
 }
 
+double Ratekeeper::queuePredictionSeconds() const {
+	switch (configuration.storageServerStoreType) {
+	case KeyValueStoreType::SSD_ROCKSDB_V1:
+	case KeyValueStoreType::SSD_SHARDED_ROCKSDB:
+		return SERVER_KNOBS->RATEKEEPER_QUEUE_PREDICTION_SECONDS_ROCKSDB;
+	default:
+		return SERVER_KNOBS->RATEKEEPER_QUEUE_PREDICTION_SECONDS;
+	}
+}
+
 void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 	// double controlFactor = ;  // dt / eFoldingTime
 
@@ -685,6 +700,8 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 	    SERVER_KNOBS->RATEKEEPER_PRINT_LIMIT_REASON &&
 	    (deterministicRandom()->random01() < SERVER_KNOBS->RATEKEEPER_LIMIT_REASON_SAMPLE_RATE);
 
+	double predictionSeconds = queuePredictionSeconds();
+
 	// Look at each storage server's write queue and local rate, compute and store the desired rate
 	// ratio
 	for (auto i = storageQueueInfo.begin(); i != storageQueueInfo.end(); ++i) {
@@ -737,7 +754,11 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 		ssMetrics.cpuUsage = ss.lastReply.cpuUsage;
 		ssMetrics.diskUsage = ss.lastReply.diskUsage;
 
-		double targetRateRatio = std::min((storageQueue - targetBytes + springBytes) / (double)springBytes, 2.0);
+		// Control on where the queue is heading rather than where it is, so that a queue still growing towards the
+		// target is slowed before it overshoots, and one already draining is not held back until it reaches it
+		int64_t controlledQueue =
+		    predictionSeconds > 0 ? ss.getProjectedStorageQueueBytes(predictionSeconds) : storageQueue;
+		double targetRateRatio = std::min((controlledQueue - targetBytes + springBytes) / (double)springBytes, 2.0);
 
 		if (limits->priority == TransactionPriority::DEFAULT) {
 			addActor.send(tagThrottler->tryUpdateAutoThrottling(ss));
@@ -797,6 +818,7 @@ void Ratekeeper::updateRate(RatekeeperLimits* limits) {
 						    .detail("SSLastReplyBytesInput", ss.lastReply.bytesInput)
 						    .detail("SSSmoothDurableBytes", ss.getSmoothDurableBytes())
 						    .detail("StorageQueue", storageQueue)
+						    .detail("ProjectedStorageQueue", controlledQueue)
 						    .detail("TargetBytes", targetBytes)
 						    .detail("SpringBytes", springBytes)
 						    .detail("SSVerySmoothDurableBytesRate", ss.getVerySmoothDurableBytesRate())
@@ -1363,6 +1385,11 @@ UpdateCommitCostRequest StorageQueueInfo::refreshCommitCost(double elapsed) {
 	return updateCommitCostRequest;
 }
 
+int64_t StorageQueueInfo::getProjectedStorageQueueBytes(double horizon) const {
+	double growthRate = getSmoothInputBytesRate() - getSmoothDurableBytesRate();
+	return std::max<int64_t>(0, getStorageQueueBytes() + growthRate * horizon);
+}
+
 Optional<double> StorageQueueInfo::getTagThrottlingRatio(int64_t storageTargetBytes, int64_t storageSpringBytes) const {
 	auto const storageQueue = getStorageQueueBytes();
 	if (storageQueue < storageTargetBytes - storageSpringBytes) {
@@ -24,6 +24,9 @@
 #include "fdbserver/MasterInterface.h"
 #include "fdbserver/Knobs.h"
 #include "flow/flow.h"
+#include "flow/UnitTest.h"
+
+#include <numeric>
 
 #include "flow/actorcompiler.h" // This must be the last #include.
 
@@ -111,6 +114,58 @@ static std::pair<KeyRangeRef, bool> findRange(CoalescedKeyRangeMap<int>& key_res
 	                          // move anything
 }
 
+std::vector<ResolutionBalancer::Move> planResolutionMoves(std::vector<int64_t> const& loads) {
+	std::vector<ResolutionBalancer::Move> plan;
+	if (loads.size() < 2) {
+		return plan;
+	}
+	int64_t mean = std::accumulate(loads.begin(), loads.end(), int64_t(0)) / (int64_t)loads.size();
+	std::vector<int> order(loads.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](int a, int b) { return loads[a] > loads[b]; });
+
+	// Match the resolvers above the mean with those below it, hottest with coolest, until every remaining pair is
+	// within MIN_BALANCE_DIFFERENCE of each other
+	std::vector<int64_t> surplus(loads.size());
+	for (int i = 0; i < loads.size(); i++) {
+		surplus[i] = loads[i] - mean;
+	}
+	int hot = 0, cool = order.size() - 1;
+	while (hot < cool) {
+		int src = order[hot], dest = order[cool];
+		if (surplus[src] <= 0 || surplus[dest] >= 0 ||
+		    surplus[src] - surplus[dest] <= SERVER_KNOBS->MIN_BALANCE_DIFFERENCE) {
+			break;
+		}
+		int64_t amount = std::min(surplus[src], -surplus[dest]);
+		// Loads are sampled, and lag behind the moves, so only move part of the difference each time
+		plan.push_back({ src, dest, (int64_t)(amount * SERVER_KNOBS->RESOLUTION_BALANCE_MOVE_FRACTION) });
+		surplus[src] -= amount;
+		surplus[dest] += amount;
+		if (surplus[src] <= 0) {
+			hot++;
+		}
+		if (surplus[dest] >= 0) {
+			cool--;
+		}
+	}
+	return plan;
+}
+
+static void traceResolutionBalance(std::vector<int64_t> const& loads, int64_t total, int moves) {
+	auto [minLoad, maxLoad] = std::minmax_element(loads.begin(), loads.end());
+	double mean = loads.empty() ? 0 : (double)total / loads.size();
+	// Imbalance is how much more than its share the hottest resolver checks, 1 when balanced
+	TraceEvent("ResolutionBalanceQuality")
+	    .detail("Resolvers", loads.size())
+	    .detail("TotalLoad", total)
+	    .detail("MaxLoad", loads.empty() ? 0 : *maxLoad)
+	    .detail("MinLoad", loads.empty() ? 0 : *minLoad)
+	    .detail("Imbalance", mean > 0 ? *maxLoad / mean : 1.0)
+	    .detail("Moves", moves)
+	    .trackLatest("ResolutionBalanceQuality");
+}
+
 // Balance key ranges among resolvers so that their load are evenly distributed.
 ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalancer* self) {
 	wait(self->triggerResolution.onTrigger());
@@ -127,37 +182,41 @@ ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalanc
 			futures.push_back(
 			    brokenPromiseToNever(p.metrics.getReply(ResolutionMetricsRequest(), TaskPriority::ResolutionMetrics)));
 		wait(waitForAll(futures));
-		state IndexedSet<std::pair<int64_t, int>, NoMetric> metrics;
 
+		state std::vector<int64_t> loads;
 		int64_t total = 0;
 		for (int i = 0; i < futures.size(); i++) {
-			total += futures[i].get().value;
-			metrics.insert(std::make_pair(futures[i].get().value, i), NoMetric());
-			//TraceEvent("ResolverMetric").detail("I", i).detail("Metric", futures[i].get());
+			loads.push_back(futures[i].get().value);
+			total += loads.back();
+		}
+		state std::vector<ResolutionBalancer::Move> plan = planResolutionMoves(loads);
+		traceResolutionBalance(loads, total, plan.size());
+		if (plan.empty()) {
+			continue;
 		}
-		if (metrics.lastItem()->first - metrics.begin()->first > SERVER_KNOBS->MIN_BALANCE_DIFFERENCE) {
-			try {
-				state int src = metrics.lastItem()->second;
-				state int dest = metrics.begin()->second;
-				state int64_t amount = std::min(metrics.lastItem()->first - total / self->resolvers.size(),
-				                                total / self->resolvers.size() - metrics.begin()->first) /
-				                       2;
-				state Standalone<VectorRef<ResolverMoveRef>> movedRanges;
 
+		// Moves for all the pairs are sent to the commit proxies at once, so they take effect at a single version
+		state Standalone<VectorRef<ResolverMoveRef>> movedRanges;
+		state int planIndex = 0;
+		for (; planIndex < plan.size(); planIndex++) {
+			state int src = plan[planIndex].src;
+			state int dest = plan[planIndex].dest;
+			state int64_t amount = plan[planIndex].amount;
+			state Standalone<VectorRef<ResolverMoveRef>> pairMoves;
+			try {
 				loop {
-					state std::pair<KeyRangeRef, bool> range = findRange(key_resolver, movedRanges, src, dest);
+					state std::pair<KeyRangeRef, bool> range = findRange(key_resolver, pairMoves, src, dest);
 
 					ResolutionSplitRequest req;
 					req.front = range.second;
 					req.offset = amount;
 					req.range = range.first;
 
-					ResolutionSplitReply split =
-					    wait(brokenPromiseToNever(self->resolvers[metrics.lastItem()->second].split.getReply(
-					        req, TaskPriority::ResolutionMetrics)));
+					ResolutionSplitReply split = wait(brokenPromiseToNever(
+					    self->resolvers[src].split.getReply(req, TaskPriority::ResolutionMetrics)));
 					KeyRangeRef moveRange = range.second ? KeyRangeRef(range.first.begin, split.key)
 					                                     : KeyRangeRef(split.key, range.first.end);
-					movedRanges.push_back_deep(movedRanges.arena(), ResolverMoveRef(moveRange, dest));
+					pairMoves.push_back_deep(pairMoves.arena(), ResolverMoveRef(moveRange, dest));
 					TraceEvent("MovingResolutionRange")
 					    .detail("Src", src)
 					    .detail("Dest", dest)
@@ -170,19 +229,46 @@ ACTOR Future<Void> ResolutionBalancer::resolutionBalancing_impl(ResolutionBalanc
 					if (moveRange != range.first || amount <= 0)
 						break;
 				}
-				for (auto& it : movedRanges)
-					key_resolver.insert(it.range, it.dest);
-				// for(auto& it : key_resolver.ranges())
-				//	TraceEvent("KeyResolver").detail("Range", it.range()).detail("Value", it.value());
-
-				self->resolverChangesVersion = *self->pVersion + 1;
-				for (auto& p : self->commitProxies)
-					self->resolverNeedingChanges.insert(p.id());
-				self->resolverChanges.set(movedRanges);
 			} catch (Error& e) {
 				if (e.code() != error_code_operation_failed)
 					throw;
 			}
+			// Later pairs with the same source must not pick the ranges this one moved
+			for (auto& it : pairMoves) {
+				key_resolver.insert(it.range, it.dest);
+				movedRanges.push_back_deep(movedRanges.arena(), it);
+			}
+		}
+		// for(auto& it : key_resolver.ranges())
+		//	TraceEvent("KeyResolver").detail("Range", it.range()).detail("Value", it.value());
+
+		if (!movedRanges.empty()) {
+			self->resolverChangesVersion = *self->pVersion + 1;
+			for (auto& p : self->commitProxies)
+				self->resolverNeedingChanges.insert(p.id());
+			self->resolverChanges.set(movedRanges);
 		}
 	}
 }
+
+TEST_CASE("/fdbserver/ResolutionBalancer/planResolutionMoves") {
+	int64_t diff = SERVER_KNOBS->MIN_BALANCE_DIFFERENCE;
+	double fraction = SERVER_KNOBS->RESOLUTION_BALANCE_MOVE_FRACTION;
+
+	ASSERT(planResolutionMoves({ 5 * diff }).empty());
+	ASSERT(planResolutionMoves({ 5 * diff, 5 * diff, 5 * diff + diff / 2 }).empty());
+
+	// Two hot resolvers each hand their surplus to a different cool one
+	std::vector<ResolutionBalancer::Move> plan = planResolutionMoves({ 8 * diff, 2 * diff, 6 * diff, 4 * diff });
+	ASSERT_EQ(plan.size(), 2);
+	ASSERT(plan[0].src == 0 && plan[0].dest == 1 && plan[0].amount == (int64_t)(3 * diff * fraction));
+	ASSERT(plan[1].src == 2 && plan[1].dest == 3 && plan[1].amount == (int64_t)(diff * fraction));
+
+	// One hot resolver spreads its surplus over every cool one
+	plan = planResolutionMoves({ 2 * diff, 2 * diff, 2 * diff, 14 * diff });
+	ASSERT_EQ(plan.size(), 3);
+	for (auto& move : plan) {
+		ASSERT(move.src == 3 && move.amount == (int64_t)(3 * diff * fraction));
+	}
+	return Void();
+}
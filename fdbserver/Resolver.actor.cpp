@@ -175,7 +175,8 @@ struct Resolver : ReferenceCounted<Resolver> {
 
 	Resolver(UID dbgid, int commitProxyCount, int resolverCount, EncryptionAtRestMode encryptMode)
 	  : dbgid(dbgid), commitProxyCount(commitProxyCount), resolverCount(resolverCount), encryptMode(encryptMode),
-	    version(-1), conflictSet(newConflictSet()), iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE),
+	    version(-1), conflictSet(newConflictSet(SERVER_KNOBS->CONFLICT_SET_WORKER_THREADS)),
+	    iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE),
 	    cc("Resolver", dbgid.toString()), resolveBatchIn("ResolveBatchIn", cc),
 	    resolveBatchStart("ResolveBatchStart", cc), resolvedTransactions("ResolvedTransactions", cc),
 	    resolvedBytes("ResolvedBytes", cc), resolvedReadConflictRanges("ResolvedReadConflictRanges", cc),
@@ -246,6 +247,21 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 		g_traceBatch.addEvent("CommitDebug", debugID.get().first(), "Resolver.resolveBatch.AfterQueueSizeCheck");
 	}
 
+	// Building and sorting the batch's conflict ranges only depends on the request, so when pipelining it is done
+	// while earlier versions are still being resolved, leaving only the conflict set operations serialized.
+	state std::map<int, VectorRef<int>> conflictingKeyRangeMap;
+	state Arena conflictingKeyRangeArena;
+	state std::unique_ptr<ConflictBatch> conflictBatch;
+	if (SERVER_KNOBS->RESOLVER_PIPELINE_CONFLICT_BATCHES && self->version.get() < req.prevVersion) {
+		conflictBatch = std::make_unique<ConflictBatch>(
+		    self->conflictSet, &conflictingKeyRangeMap, &conflictingKeyRangeArena);
+		const Version newOldestVersion = req.version - SERVER_KNOBS->MAX_WRITE_TRANSACTION_LIFE_VERSIONS;
+		for (int t = 0; t < req.transactions.size(); t++) {
+			conflictBatch->addTransaction(req.transactions[t], newOldestVersion);
+		}
+		conflictBatch->sortConflictRanges();
+	}
+
 	loop {
 		if (self->recentStateTransactionsInfo.size() &&
 		    proxyInfo.lastVersion <= self->recentStateTransactionsInfo.firstVersion()) {
@@ -290,10 +306,15 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 
 		// Detect conflicts
 		double expire = now() + SERVER_KNOBS->SAMPLE_EXPIRATION_TIME;
-		ConflictBatch conflictBatch(self->conflictSet, &reply.conflictingKeyRangeMap, &reply.arena);
+		const bool prepared = conflictBatch != nullptr;
+		if (!prepared) {
+			conflictBatch = std::make_unique<ConflictBatch>(self->conflictSet, &reply.conflictingKeyRangeMap, &reply.arena);
+		}
 		const Version newOldestVersion = req.version - SERVER_KNOBS->MAX_WRITE_TRANSACTION_LIFE_VERSIONS;
 		for (int t = 0; t < req.transactions.size(); t++) {
-			conflictBatch.addTransaction(req.transactions[t], newOldestVersion);
+			if (!prepared) {
+				conflictBatch->addTransaction(req.transactions[t], newOldestVersion);
+			}
 			self->resolvedReadConflictRanges += req.transactions[t].read_conflict_ranges.size();
 			self->resolvedWriteConflictRanges += req.transactions[t].write_conflict_ranges.size();
 
@@ -306,7 +327,12 @@ ACTOR Future<Void> resolveBatch(Reference<Resolver> self,
 					    it.begin, SERVER_KNOBS->SAMPLE_OFFSET_PER_KEY + it.begin.size(), expire);
 			}
 		}
-		conflictBatch.detectConflicts(req.version, newOldestVersion, commitList, &tooOldList);
+		conflictBatch->detectConflicts(req.version, newOldestVersion, commitList, &tooOldList);
+		conflictBatch.reset();
+		if (prepared) {
+			reply.conflictingKeyRangeMap = std::move(conflictingKeyRangeMap);
+			reply.arena.dependsOn(conflictingKeyRangeArena);
+		}
 
 		reply.debugID = req.debugID;
 		reply.committed.resize(reply.arena, req.transactions.size());
@@ -635,8 +661,11 @@ ACTOR Future<Void> processTransactionStateRequestPart(Reference<Resolver> self,
 	pContext->pTxnStateStore->commit(true);
 
 	if (pContext->receivedSequences.size() == pContext->maxSequence) {
-		// Received all components of the txnStateRequest
+		// Received all components of the txnStateRequest. As on the commit proxies, pass the part on before
+		// processing the state, and acknowledge it once both are done.
 		ASSERT(!pContext->processed);
+		state ReplyPromise<Void> reply = request.reply;
+		state Future<Void> forwarded = broadcastTxnRequest(request, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, false);
 		state std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys;
 		if (self->encryptMode.isEncryptionEnabled()) {
 			static const std::unordered_set<EncryptCipherDomainId> metadataDomainIds = {
@@ -649,6 +678,9 @@ ACTOR Future<Void> processTransactionStateRequestPart(Reference<Resolver> self,
 		wait(processCompleteTransactionStateRequest(
 		    self, pContext, db, self->encryptMode.isEncryptionEnabled() ? &cipherKeys : nullptr));
 		pContext->processed = true;
+		wait(forwarded);
+		reply.send(Void());
+		return Void();
 	}
 
 	pContext->pActors->send(broadcastTxnRequest(request, SERVER_KNOBS->TXN_STATE_SEND_AMOUNT, true));
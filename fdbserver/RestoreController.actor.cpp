@@ -610,6 +610,7 @@ ACTOR static Future<Void> distributeWorkloadPerVersionBatch(Reference<RestoreCon
 	    loadFilesOnLoaders(batchData, batchStatus, self->loadersInterf, batchIndex, cx, request, versionBatch, false) &&
 	    loadFilesOnLoaders(batchData, batchStatus, self->loadersInterf, batchIndex, cx, request, versionBatch, true));
 
+	state double loadedTime = now();
 	ASSERT(batchData->rangeToApplier.empty());
 	splitKeyRangeForAppliers(batchData, self->appliersInterf, batchIndex);
 
@@ -617,10 +618,12 @@ ACTOR static Future<Void> distributeWorkloadPerVersionBatch(Reference<RestoreCon
 	// log mutations should be applied before range mutations at the same version, which is ensured by LogMessageVersion
 	wait(sendMutationsFromLoaders(batchData, batchStatus, self->loadersInterf, batchIndex, false) &&
 	     sendMutationsFromLoaders(batchData, batchStatus, self->loadersInterf, batchIndex, true));
+	state double sentTime = now();
 
 	// Synchronization point for version batch pipelining.
 	// self->finishedBatch will continuously increase by 1 per version batch.
 	wait(notifyApplierToApplyMutations(batchData, batchStatus, self->appliersInterf, batchIndex, &self->finishedBatch));
+	state double appliedTime = now();
 
 	wait(notifyLoadersVersionBatchFinished(self->loadersInterf, batchIndex));
 
@@ -636,6 +639,19 @@ ACTOR static Future<Void> distributeWorkloadPerVersionBatch(Reference<RestoreCon
 	    .detail("RunningVersionBatches", self->runningVersionBatches.get())
 	    .detail("Latency", now() - startTime);
 
+	// Apply time includes waiting for earlier version batches to be applied
+	auto mbps = [&](double seconds) { return seconds > 0 ? versionBatch.size / seconds / 1e6 : 0.0; };
+	TraceEvent("FastRestoreControllerVersionBatchStages", self->id())
+	    .detail("BatchIndex", batchIndex)
+	    .detail("BatchSize", versionBatch.size)
+	    .detail("Appliers", batchData->rangeToApplier.size())
+	    .detail("LoadSeconds", loadedTime - startTime)
+	    .detail("SendSeconds", sentTime - loadedTime)
+	    .detail("ApplySeconds", appliedTime - sentTime)
+	    .detail("LoadMBps", mbps(loadedTime - startTime))
+	    .detail("SendMBps", mbps(sentTime - loadedTime))
+	    .detail("ApplyMBps", mbps(appliedTime - sentTime));
+
 	return Void();
 }
 
@@ -649,7 +665,12 @@ void splitKeyRangeForAppliers(Reference<ControllerBatchData> batchData,
 	// Sanity check: samples should not be used after freed
 	ASSERT((batchData->samplesSize > 0 && !batchData->samples.empty()) ||
 	       (batchData->samplesSize == 0 && batchData->samples.empty()));
+	// Small version batches use fewer appliers, rotating through them so that batches in parallel use different ones
 	int numAppliers = appliersInterf.size();
+	if (SERVER_KNOBS->FASTRESTORE_MIN_BYTES_PER_APPLIER > 0) {
+		numAppliers = std::max(
+		    1, std::min<int>(numAppliers, batchData->samplesSize / SERVER_KNOBS->FASTRESTORE_MIN_BYTES_PER_APPLIER));
+	}
 	double slotSize = std::max(batchData->samplesSize / numAppliers, 1.0);
 	double cumulativeSize = slotSize;
 	TraceEvent("FastRestoreControllerPhaseCalculateApplierKeyRangesStart")
@@ -691,13 +712,19 @@ void splitKeyRangeForAppliers(Reference<ControllerBatchData> batchData,
 		    .detail("PerformanceMayDegrade", "Last applier handles more data than others");
 	}
 
+	std::vector<UID> applierIDs;
+	for (auto& applier : appliersInterf) {
+		applierIDs.push_back(applier.first);
+	}
+	int firstApplier = (batchIndex * numAppliers) % applierIDs.size();
+	std::rotate(applierIDs.begin(), applierIDs.begin() + firstApplier, applierIDs.end());
 	std::set<Key>::iterator splitter = keyrangeSplitter.begin();
 	batchData->rangeToApplier.clear();
-	for (auto& applier : appliersInterf) {
+	for (auto& applierID : applierIDs) {
 		if (splitter == keyrangeSplitter.end()) {
 			break; // Not all appliers will be used
 		}
-		batchData->rangeToApplier[*splitter] = applier.first;
+		batchData->rangeToApplier[*splitter] = applierID;
 		splitter++;
 	}
 	ASSERT(batchData->rangeToApplier.size() > 0);
@@ -407,24 +407,16 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
 	    .detail("Length", asset.len);
 
 	state Arena tempArena;
-	state StringRefReader reader(buf, restore_corrupted_data());
 	try {
-		// Read block header
-		if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-			throw restore_unsupported_file_version();
+		// Blocks with no mutation in the asset's version range are skipped without being decompressed
+		state std::vector<fileBackup::PartitionedLogMessage> messages =
+		    fileBackup::decodePartitionedLogBlock(buf, buf.arena(), asset.beginVersion, asset.endVersion);
 
 		state VersionedMutationsMap* kvOps = &kvOpsIter->second;
-		while (1) {
-			// If eof reached or first key len bytes is 0xFF then end of block was reached.
-			if (reader.eof() || *reader.rptr == 0xFF)
-				break;
-
-			// Deserialize messages written in saveMutationsToFile().
-			state LogMessageVersion msgVersion;
-			msgVersion.version = reader.consumeNetworkUInt64();
-			msgVersion.sub = reader.consumeNetworkUInt32();
-			state int msgSize = reader.consumeNetworkInt32();
-			state const uint8_t* message = reader.consume(msgSize);
+		state int msgIndex = 0;
+		for (; msgIndex < messages.size(); msgIndex++) {
+			state LogMessageVersion msgVersion = messages[msgIndex].version;
+			state StringRef message = messages[msgIndex].message;
 
 			// Skip mutations out of the version range
 			if (!asset.isInVersionRange(msgVersion.version)) {
@@ -440,7 +432,7 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
 			// only one clear mutation is generated (i.e., always inserted).
 			ASSERT(inserted);
 
-			ArenaReader rd(buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+			ArenaReader rd(buf.arena(), message, AssumeVersion(g_network->protocolVersion()));
 			state MutationRef mutation;
 			rd >> mutation;
 			if (mutation.isEncrypted()) {
@@ -495,12 +487,6 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
 				                                   SampledMutation(mutation.param1, sampleInfo.sampledSize));
 			}
 		}
-
-		// Make sure any remaining bytes in the block are 0xFF
-		for (auto b : reader.remainder()) {
-			if (b != 0xFF)
-				throw restore_corrupted_data_padding();
-		}
 	} catch (Error& e) {
 		TraceEvent(SevWarn, "FileRestoreCorruptLogFileBlock")
 		    .error(e)
@@ -26,6 +26,7 @@
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/types.h>
 #include <rocksdb/version.h>
 #endif // SSD_ROCKSDB_EXPERIMENTAL
@@ -38,6 +39,7 @@
 #include "flow/IThreadPool.h"
 #include "flow/ThreadHelper.actor.h"
 #include "flow/Trace.h"
+#include "flow/UnitTest.h"
 #include "flow/flow.h"
 
 #include "flow/actorcompiler.h" // has to be last include
@@ -993,7 +995,62 @@ ACTOR Future<Void> deleteRocksCheckpoint(CheckpointMetaData checkpoint) {
 
 	return Void();
 }
+
+CheckpointMetaData buildRocksDBKeyValuesCheckpoint(const std::string& dir,
+                                                   KeyRange range,
+                                                   const Standalone<VectorRef<KeyValueRef>>& kvs,
+                                                   UID checkpointID) {
+	ASSERT(!kvs.empty());
+	const std::string localFile =
+	    dir + "/" + UID(checkpointID.first(), deterministicRandom()->randomUInt64()).toString() + ".sst";
+	platform::createDirectory(dir);
+
+	rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options());
+	rocksdb::Status status = writer.Open(localFile);
+	int64_t totalBytes = 0;
+	for (int i = 0; status.ok() && i < kvs.size(); ++i) {
+		if (!range.contains(kvs[i].key)) {
+			TraceEvent(SevWarnAlways, "BuildCheckpointKeyOutOfRange")
+			    .detail("CheckpointID", checkpointID)
+			    .detail("Range", range)
+			    .detail("Key", kvs[i].key);
+			throw failed_to_create_checkpoint();
+		}
+		// Keys must be unique and in ascending order, which the writer checks.
+		status = writer.Put(toSlice(kvs[i].key), toSlice(kvs[i].value));
+		totalBytes += kvs[i].expectedSize();
+	}
+	if (status.ok()) {
+		status = writer.Finish();
+	}
+	if (!status.ok()) {
+		TraceEvent(SevWarnAlways, "BuildCheckpointFileError")
+		    .detail("CheckpointID", checkpointID)
+		    .detail("LocalFile", localFile)
+		    .detail("Status", status.ToString());
+		throw statusToError(status);
+	}
+
+	CheckpointMetaData checkpoint({ range }, RocksDBKeyValues, {}, checkpointID, UID());
+	RocksDBCheckpointKeyValues rcp({ range });
+	rcp.fetchedFiles.emplace_back(localFile, range, totalBytes);
+	checkpoint.serializedCheckpoint = ObjectWriter::toValue(rcp, IncludeVersion());
+	checkpoint.setState(CheckpointMetaData::Complete);
+	TraceEvent(SevInfo, "BuildCheckpointFileEnd")
+	    .detail("CheckpointID", checkpointID)
+	    .detail("Range", range)
+	    .detail("LocalFile", localFile)
+	    .detail("TotalBytes", totalBytes);
+	return checkpoint;
+}
 #else
+CheckpointMetaData buildRocksDBKeyValuesCheckpoint(const std::string& dir,
+                                                   KeyRange range,
+                                                   const Standalone<VectorRef<KeyValueRef>>& kvs,
+                                                   UID checkpointID) {
+	throw not_implemented();
+}
+
 ACTOR Future<CheckpointMetaData> fetchRocksDBCheckpoint(Database cx,
                                                         CheckpointMetaData initialState,
                                                         std::string dir,
@@ -1045,6 +1102,31 @@ RocksDBColumnFamilyCheckpoint getRocksCF(const CheckpointMetaData& checkpoint) {
 	return rocksCF;
 }
 
+std::vector<LiveFileMetaData> getChangedCheckpointFiles(const RocksDBColumnFamilyCheckpoint& base,
+                                                        const RocksDBColumnFamilyCheckpoint& current) {
+	std::unordered_map<uint64_t, const LiveFileMetaData*> baseFiles;
+	for (const auto& file : base.sstFiles) {
+		baseFiles[file.file_number] = &file;
+	}
+	std::vector<LiveFileMetaData> changed;
+	int64_t changedBytes = 0;
+	for (const auto& file : current.sstFiles) {
+		auto it = baseFiles.find(file.file_number);
+		if (it != baseFiles.end() && it->second->size == file.size && it->second->name == file.name &&
+		    it->second->file_checksum == file.file_checksum) {
+			continue;
+		}
+		changed.push_back(file);
+		changedBytes += file.size;
+	}
+	TraceEvent(SevDebug, "RocksDBCheckpointChangedFiles")
+	    .detail("BaseFiles", base.sstFiles.size())
+	    .detail("CurrentFiles", current.sstFiles.size())
+	    .detail("ChangedFiles", changed.size())
+	    .detail("ChangedBytes", changedBytes);
+	return changed;
+}
+
 RocksDBCheckpoint getRocksCheckpoint(const CheckpointMetaData& checkpoint) {
 	RocksDBCheckpoint rocksCheckpoint;
 	ObjectReader reader(checkpoint.serializedCheckpoint.begin(), IncludeVersion());
@@ -1057,4 +1139,30 @@ RocksDBCheckpointKeyValues getRocksKeyValuesCheckpoint(const CheckpointMetaData&
 	ObjectReader reader(checkpoint.serializedCheckpoint.begin(), IncludeVersion());
 	reader.deserialize(rocksCheckpoint);
 	return rocksCheckpoint;
-}
\ No newline at end of file
+}
+
+TEST_CASE("/fdbserver/RocksDBCheckpoint/changedFiles") {
+	auto makeFile = [](uint64_t number, size_t size, std::string checksum) {
+		LiveFileMetaData file;
+		file.file_number = number;
+		file.name = "/" + std::to_string(number) + ".sst";
+		file.size = size;
+		file.file_checksum = checksum;
+		return file;
+	};
+	RocksDBColumnFamilyCheckpoint base;
+	base.sstFiles = { makeFile(1, 100, "a"), makeFile(2, 200, "b"), makeFile(3, 300, "c") };
+
+	// File 1 was compacted away into file 4, and file 3 was rewritten
+	RocksDBColumnFamilyCheckpoint current;
+	current.sstFiles = { makeFile(2, 200, "b"), makeFile(3, 300, "d"), makeFile(4, 400, "e") };
+
+	std::vector<LiveFileMetaData> changed = getChangedCheckpointFiles(base, current);
+	ASSERT_EQ(changed.size(), 2);
+	ASSERT_EQ(changed[0].file_number, 3);
+	ASSERT_EQ(changed[1].file_number, 4);
+
+	ASSERT(getChangedCheckpointFiles(current, current).empty());
+	ASSERT_EQ(getChangedCheckpointFiles(RocksDBColumnFamilyCheckpoint(), current).size(), 3);
+	return Void();
+}
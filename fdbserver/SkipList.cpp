@@ -22,17 +22,23 @@
 #include <memory.h>
 #include <stdio.h>
 #include <algorithm>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#include "flow/IThreadPool.h"
+#include "flow/KeyCompare.h"
 #include "flow/Platform.h"
+#include "flow/ThreadPrimitives.h"
+#include "flow/UnitTest.h"
 #include "fdbrpc/fdbrpc.h"
 #include "fdbrpc/PerfMetric.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/SystemData.h"
 #include "fdbserver/ConflictSet.h"
+#include "fdbserver/Knobs.h"
 
 static std::vector<PerfDoubleCounter*> skc;
 
@@ -48,16 +54,8 @@ PerfDoubleCounter g_buildTest("Build", skc), g_add("Add", skc), g_detectConflict
     g_merge("D.MergeWrite", skc), g_removeBefore("D.RemoveBefore", skc);
 
 static force_inline int compare(const StringRef& a, const StringRef& b) {
-	int c = memcmp(a.begin(), b.begin(), std::min(a.size(), b.size()));
-	if (c < 0)
-		return -1;
-	if (c > 0)
-		return +1;
-	if (a.size() < b.size())
-		return -1;
-	if (a.size() == b.size())
-		return 0;
-	return +1;
+	int c = keycompare::compare(a.begin(), a.size(), b.begin(), b.size());
+	return (c > 0) - (c < 0);
 }
 
 struct ReadConflictRange {
@@ -308,13 +306,9 @@ private:
 		int nPointers, valueLength;
 	};
 
+	// Level traversal compares keys that usually share long prefixes, so use the vectorized kernel
 	static force_inline bool less(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
-		int c = memcmp(a, b, std::min(aLen, bLen));
-		if (c < 0)
-			return true;
-		if (c > 0)
-			return false;
-		return aLen < bLen;
+		return keycompare::less(a, aLen, b, bLen);
 	}
 
 	Node* header;
@@ -388,7 +382,7 @@ public:
 		force_inline Node* found() const {
 			// valid after finished returns true
 			Node* n = finger[0]->getNext(0); // or alreadyChecked, but that is more easily invalidated
-			if (n && n->length() == value.size() && !memcmp(n->value(), value.begin(), value.size()))
+			if (n && keycompare::equal(n->value(), n->length(), value.begin(), value.size()))
 				return n;
 			else
 				return nullptr;
@@ -490,7 +484,7 @@ public:
 	//   partitions.  In between, operations on each partition must not touch any keys outside
 	//   the partition.  Specifically, the partition to the left of 'key' must not have a range
 	//	 [...,key) inserted, since that would insert an entry at 'key'.
-	// Note this function is not used.
+	// Used by ConflictBatch::mergeWriteConflictRanges() when the conflict set has worker threads.
 	void partition(StringRef* begin, int splitCount, SkipList* output) {
 		for (int i = splitCount - 1; i >= 0; i--) {
 			Finger f(header, begin[i]);
@@ -502,7 +496,6 @@ public:
 	}
 
 	// Concatenates multiple SkipList objects into one and stores in input[0].
-	// Note this function is not used.
 	void concatenate(SkipList* input, int count) {
 		std::vector<Finger> ends(count - 1);
 		for (int i = 0; i < ends.size(); i++)
@@ -744,8 +737,7 @@ private:
 						return noConflict();
 					s = nextS;
 					if (start.finished()) {
-						if (nextS->length() == start.value.size() &&
-						    !memcmp(nextS->value(), start.value.begin(), start.value.size()))
+						if (keycompare::equal(nextS->value(), nextS->length(), start.value.begin(), start.value.size()))
 							return noConflict();
 						else
 							return conflict();
@@ -782,17 +774,94 @@ private:
 	}
 };
 
+namespace {
+
+// Runs pieces of a ConflictBatch on a conflict set worker thread and signals the caller when done.
+struct ConflictSetWorker final : IThreadPoolReceiver {
+	void init() override {}
+
+	struct RunPartition final : TypedAction<ConflictSetWorker, RunPartition> {
+		std::function<void()> work;
+		Event* done;
+		Optional<Error>* error;
+
+		RunPartition(std::function<void()> work, Event* done, Optional<Error>* error)
+		  : work(std::move(work)), done(done), error(error) {}
+		double getTimeEstimate() const override { return 0; }
+	};
+
+	void action(RunPartition& a) {
+		try {
+			a.work();
+		} catch (Error& e) {
+			*a.error = e;
+		}
+		a.done->set();
+	}
+};
+
+} // namespace
+
 struct ConflictSet {
-	ConflictSet() : removalKey(makeString(0)), oldestVersion(0) {}
-	~ConflictSet() {}
+	explicit ConflictSet(int workerThreads)
+	  : removalKey(makeString(0)), oldestVersion(0), workerCount(workerThreads) {
+		// Partitioned work runs inline in simulation, which must stay single threaded
+		if (workerCount > 0 && !g_network->isSimulated()) {
+			workers = createGenericThreadPool();
+			for (int i = 0; i < workerCount; i++) {
+				workers->addThread(new ConflictSetWorker, "fdb-conflictset");
+			}
+		}
+	}
+	~ConflictSet() {
+		if (workers) {
+			workers->stop();
+		}
+	}
+
+	// Number of partitions a batch of the given number of ranges should be split into
+	int partitionCount(int rangeCount) const {
+		if (workerCount <= 0 || rangeCount < SERVER_KNOBS->CONFLICT_SET_PARALLEL_MIN_RANGES)
+			return 1;
+		return std::min(workerCount + 1, rangeCount);
+	}
+
+	// Calls work(i) for each i in [0, count) and returns once all calls have finished.  Partition 0 runs on the
+	// calling thread and the others on the worker threads, or all of them on the calling thread without workers.
+	void parallelFor(int count, std::function<void(int)> const& work) {
+		if (!workers) {
+			for (int i = 0; i < count; i++)
+				work(i);
+			return;
+		}
+
+		Event done;
+		std::vector<Optional<Error>> errors(count);
+		for (int i = 1; i < count; i++) {
+			workers->post(new ConflictSetWorker::RunPartition([&work, i]() { work(i); }, &done, &errors[i]));
+		}
+		try {
+			work(0);
+		} catch (Error& e) {
+			errors[0] = e;
+		}
+		for (int i = 1; i < count; i++)
+			done.block();
+		for (const auto& e : errors) {
+			if (e.present())
+				throw e.get();
+		}
+	}
 
 	SkipList versionHistory;
 	Key removalKey;
 	Version oldestVersion;
+	int workerCount;
+	Reference<IThreadPool> workers;
 };
 
-ConflictSet* newConflictSet() {
-	return new ConflictSet;
+ConflictSet* newConflictSet(int workerThreads) {
+	return new ConflictSet(workerThreads);
 }
 void clearConflictSet(ConflictSet* cs, Version v) {
 	SkipList(v).swap(cs->versionHistory);
@@ -804,7 +873,7 @@ void destroyConflictSet(ConflictSet* cs) {
 ConflictBatch::ConflictBatch(ConflictSet* cs,
                              std::map<int, VectorRef<int>>* conflictingKeyRangeMap,
                              Arena* resolveBatchReplyArena)
-  : cs(cs), transactionCount(0), conflictingKeyRangeMap(conflictingKeyRangeMap),
+  : cs(cs), transactionCount(0), sorted(false), conflictingKeyRangeMap(conflictingKeyRangeMap),
     resolveBatchReplyArena(resolveBatchReplyArena) {}
 
 ConflictBatch::~ConflictBatch() {}
@@ -817,6 +886,7 @@ struct TransactionInfo {
 };
 
 void ConflictBatch::addTransaction(const CommitTransactionRef& tr, Version newOldestVersion) {
+	ASSERT(!sorted);
 	const int t = transactionCount++;
 
 	Arena& arena = transactionInfo.arena();
@@ -910,14 +980,12 @@ void ConflictBatch::detectConflicts(Version now,
                                     Version newOldestVersion,
                                     std::vector<int>& nonConflicting,
                                     std::vector<int>* tooOldTransactions) {
-	double t = timer();
-	sortPoints(points);
-	g_sort += timer() - t;
+	sortConflictRanges();
 
+	double t = timer();
 	transactionConflictStatus = new bool[transactionCount];
 	memset(transactionConflictStatus, 0, transactionCount * sizeof(bool));
 
-	t = timer();
 	checkReadConflictRanges();
 	g_checkRead += timer() - t;
 
@@ -955,12 +1023,48 @@ void ConflictBatch::detectConflicts(Version now,
 	g_removeBefore += timer() - t;
 }
 
+void ConflictBatch::sortConflictRanges() {
+	if (sorted)
+		return;
+	double t = timer();
+	sortPoints(points);
+	sorted = true;
+	g_sort += timer() - t;
+}
+
 void ConflictBatch::checkReadConflictRanges() {
 	if (combinedReadConflictRanges.empty())
 		return;
 
-	cs->versionHistory.detectConflicts(
-	    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
+	// Reporting conflicting keys appends to the reply arena, which is not thread safe
+	const int rangeCount = combinedReadConflictRanges.size();
+	const int partitions = conflictingKeyRangeMap && !conflictingKeyRangeMap->empty()
+	                           ? 1
+	                           : cs->partitionCount(rangeCount);
+	if (partitions == 1) {
+		cs->versionHistory.detectConflicts(&combinedReadConflictRanges[0], rangeCount, transactionConflictStatus);
+		return;
+	}
+
+	// The version history is only read here, so each partition checks a slice of the read ranges against the whole
+	// skip list.  Partitions other than the first record conflicts separately, since ranges of one transaction can be
+	// split between partitions.
+	std::vector<std::unique_ptr<bool[]>> partitionStatus(partitions);
+	cs->parallelFor(partitions, [&](int p) {
+		const int begin = int64_t(rangeCount) * p / partitions;
+		const int end = int64_t(rangeCount) * (p + 1) / partitions;
+		bool* status = transactionConflictStatus;
+		if (p > 0) {
+			partitionStatus[p].reset(new bool[transactionCount]());
+			status = partitionStatus[p].get();
+		}
+		cs->versionHistory.detectConflicts(&combinedReadConflictRanges[begin], end - begin, status);
+	});
+
+	for (int p = 1; p < partitions; p++) {
+		for (int t = 0; t < transactionCount; t++)
+			transactionConflictStatus[t] |= partitionStatus[p][t];
+	}
 }
 
 void ConflictBatch::addConflictRanges(Version now,
@@ -990,7 +1094,48 @@ void ConflictBatch::mergeWriteConflictRanges(Version now) {
 	if (combinedWriteConflictRanges.empty())
 		return;
 
-	addConflictRanges(now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
+	const int rangeCount = combinedWriteConflictRanges.size();
+	const int partitions = cs->partitionCount(rangeCount);
+	if (partitions == 1) {
+		addConflictRanges(
+		    now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
+		return;
+	}
+
+	// Split the version history at the beginning of write ranges so that every partition gets a similar number of
+	// ranges.  A split key must not be the end of the preceding range, since inserting that range into the left
+	// partition would create an entry at the split key.
+	std::vector<int> firstRange;
+	std::vector<StringRef> splitKeys;
+	firstRange.push_back(0);
+	for (int p = 1; p < partitions; p++) {
+		int r = std::max<int>(int64_t(rangeCount) * p / partitions, firstRange.back() + 1);
+		while (r < rangeCount &&
+		       compare(combinedWriteConflictRanges[r - 1].second, combinedWriteConflictRanges[r].first) >= 0)
+			r++;
+		if (r >= rangeCount)
+			break;
+		firstRange.push_back(r);
+		splitKeys.push_back(combinedWriteConflictRanges[r].first);
+	}
+	firstRange.push_back(rangeCount);
+
+	if (splitKeys.empty()) {
+		addConflictRanges(
+		    now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
+		return;
+	}
+
+	std::vector<SkipList> parts(splitKeys.size() + 1);
+	cs->versionHistory.partition(&splitKeys[0], splitKeys.size(), &parts[0]);
+	cs->parallelFor(parts.size(), [&](int p) {
+		addConflictRanges(now,
+		                  combinedWriteConflictRanges.begin() + firstRange[p],
+		                  combinedWriteConflictRanges.begin() + firstRange[p + 1],
+		                  &parts[p]);
+	});
+	// Leaves the recombined version history in cs->versionHistory
+	cs->versionHistory.concatenate(&parts[0], parts.size());
 }
 
 void ConflictBatch::combineWriteConflictRanges() {
@@ -1175,3 +1320,49 @@ void skipListTest() {
 
 	printf("%d entries in version history\n", cs->versionHistory.count());
 }
+
+// Resolves the same random batches with a serial and a partitioned conflict set and checks that they agree.
+TEST_CASE("/fdbserver/ConflictSet/Partitioned") {
+	const int workerThreads = deterministicRandom()->randomInt(1, 5);
+	ConflictSet* serial = newConflictSet();
+	ConflictSet* partitioned = newConflictSet(workerThreads);
+
+	Version version = 0;
+	for (int b = 0; b < 50; b++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs;
+		const int transactions = deterministicRandom()->randomInt(1, 3000);
+		for (int t = 0; t < transactions; t++) {
+			CommitTransactionRef tr;
+			tr.read_snapshot = version - deterministicRandom()->randomInt(0, 5);
+			for (int r = deterministicRandom()->randomInt(0, 3); r > 0; r--) {
+				int key = deterministicRandom()->randomInt(0, 100000);
+				tr.read_conflict_ranges.push_back(
+				    arena, KeyRangeRef(setK(arena, key), setK(arena, key + deterministicRandom()->randomInt(1, 20))));
+			}
+			for (int r = deterministicRandom()->randomInt(0, 3); r > 0; r--) {
+				int key = deterministicRandom()->randomInt(0, 100000);
+				tr.write_conflict_ranges.push_back(
+				    arena, KeyRangeRef(setK(arena, key), setK(arena, key + deterministicRandom()->randomInt(1, 20))));
+			}
+			trs.push_back(tr);
+		}
+
+		std::vector<int> serialCommitted, partitionedCommitted;
+		ConflictBatch serialBatch(serial);
+		ConflictBatch partitionedBatch(partitioned);
+		for (const auto& tr : trs) {
+			serialBatch.addTransaction(tr, version - 3);
+			partitionedBatch.addTransaction(tr, version - 3);
+		}
+		version += deterministicRandom()->randomInt(1, 3);
+		serialBatch.detectConflicts(version, version - 3, serialCommitted);
+		partitionedBatch.detectConflicts(version, version - 3, partitionedCommitted);
+		ASSERT(serialCommitted == partitionedCommitted);
+	}
+
+	ASSERT_EQ(serial->versionHistory.count(), partitioned->versionHistory.count());
+	destroyConflictSet(serial);
+	destroyConflictSet(partitioned);
+	return Void();
+}
@@ -466,6 +466,17 @@ struct MachineMemoryInfo {
 	void invalidate() { memoryUsage = -1; }
 };
 
+// The latency metrics events of each commit proxy pipeline stage, and the status field each is reported under
+static const std::vector<std::pair<std::string, std::string>> commitStageLatencyMetrics = {
+	{ "CommitBatchQueuingLatencyMetrics", "batch_queuing" },
+	{ "CommitGetCommitVersionLatencyMetrics", "get_commit_version" },
+	{ "CommitResolutionLatencyMetrics", "resolution" },
+	{ "CommitPostResolutionQueuingLatencyMetrics", "post_resolution_queuing" },
+	{ "CommitProcessingMutationLatencyMetrics", "processing_mutation" },
+	{ "CommitTLogLoggingLatencyMetrics", "tlog_logging" },
+	{ "CommitReplyLatencyMetrics", "reply_commit" },
+};
+
 struct RolesInfo {
 	std::multimap<NetworkAddress, JsonBuilderObject> roles;
 
@@ -621,6 +632,20 @@ struct RolesInfo {
 				}
 			}
 
+			TraceEventFields const& busiestReadKeyPrefix = metrics.at("BusiestReadKeyPrefix");
+			if (busiestReadKeyPrefix.size()) {
+				double cost = busiestReadKeyPrefix.getDouble("Cost");
+				if (cost > 0) {
+					JsonBuilderObject busiestReadKeyPrefixObj;
+					busiestReadKeyPrefixObj["prefix"] = busiestReadKeyPrefix.getValue("Prefix");
+					busiestReadKeyPrefixObj["fractional_cost"] = busiestReadKeyPrefix.getDouble("FractionalBusyness");
+					JsonBuilderObject estimatedCostObj;
+					estimatedCostObj["hz"] = cost;
+					busiestReadKeyPrefixObj["estimated_cost"] = estimatedCostObj;
+					obj["busiest_read_key_prefix"] = busiestReadKeyPrefixObj;
+				}
+			}
+
 		} catch (Error& e) {
 			if (e.code() != error_code_attribute_not_found)
 				throw e;
@@ -685,6 +710,17 @@ struct RolesInfo {
 			if (commitBatchingWindowSize.size()) {
 				obj["commit_batching_window_size"] = addLatencyStatistics(commitBatchingWindowSize);
 			}
+
+			JsonBuilderObject stageLatencies;
+			for (auto const& [eventName, stage] : commitStageLatencyMetrics) {
+				TraceEventFields const& stageMetrics = metrics.at(eventName);
+				if (stageMetrics.size()) {
+					stageLatencies[stage] = addLatencyStatistics(stageMetrics);
+				}
+			}
+			if (stageLatencies.size()) {
+				obj["commit_stage_latency_statistics"] = stageLatencies;
+			}
 		} catch (Error& e) {
 			if (e.code() != error_code_attribute_not_found) {
 				throw e;
@@ -1112,6 +1148,22 @@ ACTOR static Future<JsonBuilderObject> processStatusFetcher(
 				incomplete_reasons->insert("Cannot retrieve run loop busyness.");
 			}
 
+			// Only present when the process was built with -DACTOR_PROFILER=ON
+			JsonBuilderArray busiestActors;
+			std::string actorName;
+			for (int i = 0; networkMetrics.tryGetValue(format("BusiestActor%d", i), actorName); i++) {
+				JsonBuilderObject actorObj;
+				actorObj["name"] = actorName;
+				actorObj["busy"] = networkMetrics.getDouble(format("BusiestActor%dRunTime", i)) / networkMetricsElapsed;
+				actorObj["wakeups_hz"] = networkMetrics.getDouble(format("BusiestActor%dRuns", i)) / networkMetricsElapsed;
+				actorObj["instances"] = networkMetrics.getInt64(format("BusiestActor%dInstances", i));
+				actorObj["frame_bytes"] = networkMetrics.getInt64(format("BusiestActor%dFrameBytes", i));
+				busiestActors.push_back(actorObj);
+			}
+			if (busiestActors.size()) {
+				statusObj["busiest_actors"] = busiestActors;
+			}
+
 		} catch (Error& e) {
 			if (e.code() == error_code_actor_cancelled) {
 				throw;
@@ -1215,10 +1267,14 @@ ACTOR static Future<JsonBuilderObject> recoveryStateStatusFetcher(Database cx,
 		    timeoutError(ccWorker.interf.eventLogRequest.getReply(EventLogRequest(StringRef(
 		                     getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_AVAILABLE_EVENT_NAME)))),
 		                 1.0);
+		state Future<TraceEventFields> mDurationF =
+		    timeoutError(ccWorker.interf.eventLogRequest.getReply(EventLogRequest(StringRef(
+		                     getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME)))),
+		                 1.0);
 		tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
 		state Future<ErrorOr<Version>> rvF = errorOr(timeoutError(tr.getReadVersion(), 1.0));
 
-		wait(success(mdActiveGensF) && success(mdF) && success(rvF) && success(mDBAvailableF));
+		wait(success(mdActiveGensF) && success(mdF) && success(rvF) && success(mDBAvailableF) && success(mDurationF));
 
 		const TraceEventFields& md = mdF.get();
 		int mStatusCode = md.getInt("StatusCode");
@@ -1268,6 +1324,19 @@ ACTOR static Future<JsonBuilderObject> recoveryStateStatusFetcher(Database cx,
 			message["active_generations"] = activeGenerations;
 		}
 
+		// How long the last recovery to reach accepting_commits spent in each phase
+		const TraceEventFields& mDuration = mDurationF.get();
+		if (mDuration.size()) {
+			JsonBuilderObject phaseSeconds;
+			for (int phase = 0; phase < RecoveryStatus::accepting_commits; phase++) {
+				std::string seconds;
+				if (mDuration.tryGetValue(RecoveryStatus::names[phase], seconds)) {
+					phaseSeconds[RecoveryStatus::names[phase]] = atof(seconds.c_str());
+				}
+			}
+			message["last_recovery_phase_seconds"] = phaseSeconds;
+		}
+
 	} catch (Error& e) {
 		if (e.code() == error_code_actor_cancelled)
 			throw;
@@ -1802,6 +1871,10 @@ ACTOR static Future<JsonBuilderObject> dataStatusFetcher(WorkerDetails ddWorker,
 		    timeoutError(ddWorker.interf.eventLogRequest.getReply(EventLogRequest("TotalDataInFlight"_sr)), 1.0));
 		futures.push_back(
 		    timeoutError(ddWorker.interf.eventLogRequest.getReply(EventLogRequest("TotalDataInFlightRemote"_sr)), 1.0));
+		futures.push_back(
+		    timeoutError(ddWorker.interf.eventLogRequest.getReply(EventLogRequest("TeamBuilding"_sr)), 1.0));
+		futures.push_back(
+		    timeoutError(ddWorker.interf.eventLogRequest.getReply(EventLogRequest("TeamBuildingRemote"_sr)), 1.0));
 
 		std::vector<TraceEventFields> dataInfo = wait(getAll(futures));
 
@@ -1868,6 +1941,16 @@ ACTOR static Future<JsonBuilderObject> dataStatusFetcher(WorkerDetails ddWorker,
 			team_tracker.setKeyRawNumber("in_flight_bytes", inFlight.getValue("TotalBytes"));
 			team_tracker.setKeyRawNumber("unhealthy_servers", inFlight.getValue("UnhealthyServers"));
 
+			// TeamBuilding and TeamBuildingRemote follow TotalDataInFlight and TotalDataInFlightRemote
+			const TraceEventFields& teamBuilding = dataInfo[i + 2];
+			if (teamBuilding.size()) {
+				JsonBuilderObject teamBuildingObj;
+				teamBuildingObj.setKeyRawNumber("builds", teamBuilding.getValue("Builds"));
+				teamBuildingObj.setKeyRawNumber("last_seconds", teamBuilding.getValue("LastSeconds"));
+				teamBuildingObj.setKeyRawNumber("max_seconds", teamBuilding.getValue("MaxSeconds"));
+				team_tracker["team_building"] = teamBuildingObj;
+			}
+
 			JsonBuilderObject stateSectionObj;
 			if (highestPriority >= SERVER_KNOBS->PRIORITY_TEAM_0_LEFT) {
 				stateSectionObj["healthy"] = false;
@@ -2022,7 +2105,8 @@ const std::vector<std::string> STORAGE_SERVER_METRICS_LIST{ "StorageMetrics",
 	                                                        "ReadLatencyMetrics",
 	                                                        "ReadLatencyBands",
 	                                                        "BusiestReadTag",
-	                                                        "BusiestWriteTag" };
+	                                                        "BusiestWriteTag",
+	                                                        "BusiestReadKeyPrefix" };
 
 } // namespace
 
@@ -2054,10 +2138,12 @@ ACTOR static Future<std::vector<std::pair<TLogInterface, EventMap>>> getTLogsAnd
 ACTOR static Future<std::vector<std::pair<CommitProxyInterface, EventMap>>> getCommitProxiesAndMetrics(
     Reference<AsyncVar<ServerDBInfo>> db,
     std::unordered_map<NetworkAddress, WorkerInterface> address_workers) {
-	std::vector<std::pair<CommitProxyInterface, EventMap>> results = wait(getServerMetrics(
-	    db->get().client.commitProxies,
-	    address_workers,
-	    std::vector<std::string>{ "CommitLatencyMetrics", "CommitLatencyBands", "CommitBatchingWindowSize" }));
+	std::vector<std::string> eventNames{ "CommitLatencyMetrics", "CommitLatencyBands", "CommitBatchingWindowSize" };
+	for (auto const& [eventName, stage] : commitStageLatencyMetrics) {
+		eventNames.push_back(eventName);
+	}
+	std::vector<std::pair<CommitProxyInterface, EventMap>> results =
+	    wait(getServerMetrics(db->get().client.commitProxies, address_workers, eventNames));
 
 	return results;
 }
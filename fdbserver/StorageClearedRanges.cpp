@@ -0,0 +1,175 @@
+/*
+ * StorageClearedRanges.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbserver/StorageClearedRanges.h"
+#include "fdbclient/SystemData.h"
+#include "flow/UnitTest.h"
+
+void StorageClearedRanges::cleared(KeyRangeRef range, Version version) {
+	// Only the normal key space is recorded, which keeps the storage server's own metadata out of the index
+	range = range & normalKeys;
+	if (!enabled() || range.empty()) {
+		return;
+	}
+	written(range);
+	insert(range.begin, range.end, version);
+	while (ranges.size() > capacity) {
+		erase(ranges.find(byVersion.begin()->second));
+	}
+}
+
+void StorageClearedRanges::written(KeyRangeRef range) {
+	if (ranges.empty() || range.empty()) {
+		return;
+	}
+	// The range beginning at or before range.begin is the only one beginning outside range that can overlap it
+	auto it = ranges.upper_bound(range.begin);
+	if (it != ranges.begin() && std::prev(it)->second.end > range.begin) {
+		--it;
+	}
+	std::vector<std::pair<Key, Entry>> overlapping;
+	while (it != ranges.end() && it->first < range.end) {
+		overlapping.emplace_back(it->first, it->second);
+		erase(it++);
+	}
+	// Keep the parts of the ranges outside of what was written
+	if (!overlapping.empty() && overlapping.front().first < range.begin) {
+		insert(overlapping.front().first, range.begin, overlapping.front().second.version);
+	}
+	if (!overlapping.empty() && overlapping.back().second.end > range.end) {
+		insert(range.end, overlapping.back().second.end, overlapping.back().second.version);
+	}
+}
+
+void StorageClearedRanges::written(KeyRef key) {
+	if (rangeContaining(key) != ranges.end()) {
+		written(singleKeyRange(key));
+	}
+}
+
+void StorageClearedRanges::clear() {
+	ranges.clear();
+	byVersion.clear();
+}
+
+bool StorageClearedRanges::isEmpty(KeyRef key, Version version) const {
+	auto it = rangeContaining(key);
+	return it != ranges.end() && it->second.version <= version;
+}
+
+KeyRange StorageClearedRanges::trim(KeyRangeRef range, Version version) const {
+	KeyRef begin = range.begin;
+	KeyRef end = range.end;
+	// Adjacent ranges are not merged, so follow them while they stay empty at version
+	for (auto it = rangeContaining(begin); begin < end && it != ranges.end() && it->second.version <= version;
+	     it = rangeContaining(begin)) {
+		begin = it->second.end;
+	}
+	while (begin < end) {
+		auto it = ranges.lower_bound(end);
+		if (it == ranges.begin() || std::prev(it)->second.end < end || std::prev(it)->second.version > version) {
+			break;
+		}
+		end = std::prev(it)->first;
+	}
+	if (begin >= end) {
+		return KeyRange(KeyRangeRef(range.begin, range.begin));
+	}
+	return KeyRange(KeyRangeRef(begin, end));
+}
+
+std::map<Key, StorageClearedRanges::Entry>::const_iterator StorageClearedRanges::rangeContaining(KeyRef key) const {
+	auto it = ranges.upper_bound(key);
+	if (it == ranges.begin() || std::prev(it)->second.end <= key) {
+		return ranges.end();
+	}
+	return std::prev(it);
+}
+
+void StorageClearedRanges::erase(std::map<Key, Entry>::iterator it) {
+	byVersion.erase(std::make_pair(it->second.version, it->first));
+	ranges.erase(it);
+}
+
+void StorageClearedRanges::insert(KeyRef begin, KeyRef end, Version version) {
+	Key b(begin);
+	ranges.emplace(b, Entry{ Key(end), version });
+	byVersion.emplace(version, b);
+}
+
+TEST_CASE("/fdbserver/StorageClearedRanges/trim") {
+	StorageClearedRanges index(100);
+	index.cleared(KeyRangeRef("b"_sr, "d"_sr), 10);
+	index.cleared(KeyRangeRef("d"_sr, "f"_sr), 20);
+	index.cleared(KeyRangeRef("x"_sr, "z"_sr), 10);
+	ASSERT_EQ(index.size(), 3);
+
+	// Reads at older versions than a clear do not skip it
+	ASSERT(!index.isEmpty("c"_sr, 9));
+	ASSERT(index.isEmpty("c"_sr, 10));
+	ASSERT(!index.isEmpty("d"_sr, 10));
+	ASSERT(index.isEmpty("e"_sr, 20));
+	ASSERT(!index.isEmpty("f"_sr, 20));
+
+	ASSERT(index.trim(KeyRangeRef("b"_sr, "y"_sr), 5) == KeyRangeRef("b"_sr, "y"_sr));
+	ASSERT(index.trim(KeyRangeRef("b"_sr, "y"_sr), 10) == KeyRangeRef("d"_sr, "x"_sr));
+	ASSERT(index.trim(KeyRangeRef("b"_sr, "y"_sr), 20) == KeyRangeRef("f"_sr, "x"_sr));
+	ASSERT(index.trim(KeyRangeRef("a"_sr, "e"_sr), 20) == KeyRangeRef("a"_sr, "b"_sr));
+	ASSERT(index.trim(KeyRangeRef("c"_sr, "e"_sr), 20).empty());
+	ASSERT(index.trim(KeyRangeRef("x"_sr, "z"_sr), 10).empty());
+
+	// A write splits the range it lands in
+	index.written("c"_sr);
+	ASSERT_EQ(index.size(), 4);
+	ASSERT(index.isEmpty("b"_sr, 10));
+	ASSERT(!index.isEmpty("c"_sr, 10));
+	ASSERT(index.isEmpty("c\x01"_sr, 10));
+	ASSERT(index.trim(KeyRangeRef("b"_sr, "e"_sr), 20) == KeyRangeRef("c"_sr, "c\x00"_sr));
+
+	index.written(KeyRangeRef("a"_sr, "y"_sr));
+	ASSERT_EQ(index.size(), 1);
+	ASSERT(!index.isEmpty("x"_sr, 10));
+	ASSERT(index.isEmpty("y"_sr, 10));
+
+	// Nothing outside the normal key space is recorded
+	index.cleared(KeyRangeRef("\xff\xff"_sr, "\xff\xff\xff"_sr), 30);
+	ASSERT_EQ(index.size(), 1);
+	index.clear();
+	ASSERT_EQ(index.size(), 0);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/StorageClearedRanges/capacity") {
+	StorageClearedRanges index(2);
+	index.cleared(KeyRangeRef("c"_sr, "d"_sr), 3);
+	index.cleared(KeyRangeRef("a"_sr, "b"_sr), 1);
+	index.cleared(KeyRangeRef("e"_sr, "f"_sr), 2);
+
+	// The range cleared longest ago is forgotten first
+	ASSERT_EQ(index.size(), 2);
+	ASSERT(!index.isEmpty("a"_sr, 10));
+	ASSERT(index.isEmpty("c"_sr, 10));
+	ASSERT(index.isEmpty("e"_sr, 10));
+
+	StorageClearedRanges disabled(0);
+	disabled.cleared(KeyRangeRef("a"_sr, "b"_sr), 1);
+	ASSERT_EQ(disabled.size(), 0);
+	return Void();
+}
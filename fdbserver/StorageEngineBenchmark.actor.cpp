@@ -0,0 +1,332 @@
+/*
+ * StorageEngineBenchmark.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/JsonBuilder.h"
+#include "fdbserver/IKeyValueStore.h"
+#include "flow/DeterministicRandom.h"
+#include "flow/Platform.h"
+#include "flow/UnitTest.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "flow/actorcompiler.h" // has to be last include
+
+// A reproducible benchmark of the storage engines, which runs the same phases with the same seeded keys and values
+// against each engine and reports throughput, latency and, for Redwood, page cache hit rates as JSON so that results
+// can be compared across releases.  Run it with
+//
+//   fdbserver -r unittests -f :/storage/benchmark/suite --test_engines=ssd-redwood-1,ssd-2 --test_outputFile=out.json
+
+namespace {
+
+struct BenchmarkConfig {
+	std::string directory;
+	int64_t seed;
+	int records;
+	int keyPrefixLen;
+	int valueSize;
+	int commitBytes;
+	int pointReads;
+	int rangeScans;
+	int rangeRows;
+	int concurrency;
+};
+
+// The key of record index of a phase, so that the keys of each phase are sorted by index and a range of them can be
+// scanned
+Key benchmarkKey(const BenchmarkConfig& config, char phase, uint64_t index) {
+	std::string key(config.keyPrefixLen, 'p');
+	key.push_back(phase);
+	uint64_t bigEndian = bigEndian64(index);
+	key.append((const char*)&bigEndian, sizeof(bigEndian));
+	return Key(key);
+}
+
+KeyRef phaseEnd(const BenchmarkConfig& config, char phase, Arena& arena) {
+	std::string end(config.keyPrefixLen, 'p');
+	end.push_back(phase + 1);
+	return StringRef(arena, end);
+}
+
+struct PhaseResult {
+	std::string name;
+	int64_t ops = 0;
+	int64_t bytes = 0;
+	double seconds = 0;
+	// Seconds taken by each read, or by each commit for write phases
+	std::vector<double> latencies;
+	Optional<std::pair<int64_t, int64_t>> cacheHitsAndMisses;
+
+	static double percentile(const std::vector<double>& sorted, double p) {
+		return sorted.empty() ? 0 : sorted[std::min<size_t>(sorted.size() - 1, p * sorted.size())];
+	}
+
+	JsonBuilderObject toJson() const {
+		std::vector<double> sorted = latencies;
+		std::sort(sorted.begin(), sorted.end());
+
+		JsonBuilderObject latency;
+		latency["count"] = (int64_t)sorted.size();
+		latency["p50"] = percentile(sorted, 0.5);
+		latency["p90"] = percentile(sorted, 0.9);
+		latency["p99"] = percentile(sorted, 0.99);
+		latency["max"] = sorted.empty() ? 0 : sorted.back();
+
+		JsonBuilderObject obj;
+		obj["name"] = name;
+		obj["ops"] = ops;
+		obj["bytes"] = bytes;
+		obj["seconds"] = seconds;
+		obj["ops_per_second"] = seconds > 0 ? ops / seconds : 0;
+		obj["mb_per_second"] = seconds > 0 ? bytes / seconds / 1e6 : 0;
+		obj["latency_seconds"] = latency;
+		if (cacheHitsAndMisses.present()) {
+			int64_t hits = cacheHitsAndMisses.get().first;
+			int64_t lookups = hits + cacheHitsAndMisses.get().second;
+			obj["page_cache_hits"] = hits;
+			obj["page_cache_lookups"] = lookups;
+			obj["page_cache_hit_rate"] = lookups > 0 ? (double)hits / lookups : 0;
+		}
+		return obj;
+	}
+};
+
+// Measures the time and page cache activity of a phase
+struct PhaseTimer {
+	PhaseTimer(PhaseResult* result, IKeyValueStore* kvs)
+	  : result(result), redwood(kvs->getType() == KeyValueStoreType::SSD_REDWOOD_V1), start(timer()) {
+		if (redwood) {
+			cacheStart = getRedwoodPageCacheHitsAndMisses();
+		}
+	}
+
+	void finish() {
+		result->seconds = timer() - start;
+		if (redwood) {
+			std::pair<int64_t, int64_t> cacheEnd = getRedwoodPageCacheHitsAndMisses();
+			result->cacheHitsAndMisses =
+			    std::make_pair(cacheEnd.first - cacheStart.first, cacheEnd.second - cacheStart.second);
+		}
+	}
+
+	PhaseResult* result;
+	bool redwood;
+	double start;
+	std::pair<int64_t, int64_t> cacheStart;
+};
+
+// Sets config.records records, with sequential keys or random keys, committing every config.commitBytes
+ACTOR Future<PhaseResult> insertPhase(IKeyValueStore* kvs, BenchmarkConfig config, bool sequential) {
+	state PhaseResult result;
+	result.name = sequential ? "sequential_insert" : "random_insert";
+	state DeterministicRandom random(config.seed + (sequential ? 1 : 2));
+	state std::string value = random.randomAlphaNumeric(config.valueSize);
+	state PhaseTimer phaseTimer(&result, kvs);
+	state int64_t uncommitted = 0;
+	state int i = 0;
+
+	for (i = 0; i < config.records; ++i) {
+		uint64_t index = sequential ? i : random.randomInt64(0, std::numeric_limits<int64_t>::max());
+		Key key = benchmarkKey(config, sequential ? 's' : 'r', index);
+		KeyValueRef kv(key, StringRef(value));
+		kvs->set(kv);
+		++result.ops;
+		result.bytes += kv.expectedSize();
+		uncommitted += kv.expectedSize();
+
+		if (uncommitted >= config.commitBytes || i + 1 == config.records) {
+			state double commitStart = timer();
+			wait(kvs->commit());
+			result.latencies.push_back(timer() - commitStart);
+			uncommitted = 0;
+		}
+	}
+
+	phaseTimer.finish();
+	return result;
+}
+
+ACTOR Future<Void> pointReader(IKeyValueStore* kvs,
+                               BenchmarkConfig config,
+                               int reader,
+                               int count,
+                               PhaseResult* result) {
+	state DeterministicRandom random(config.seed + 100 + reader);
+	state int i = 0;
+	for (i = 0; i < count; ++i) {
+		state Key key = benchmarkKey(config, 's', random.randomInt(0, config.records));
+		state double start = timer();
+		Optional<Value> v = wait(kvs->readValue(key));
+		result->latencies.push_back(timer() - start);
+		++result->ops;
+		result->bytes += key.size() + (v.present() ? v.get().size() : 0);
+	}
+	return Void();
+}
+
+ACTOR Future<Void> rangeScanner(IKeyValueStore* kvs,
+                                BenchmarkConfig config,
+                                int reader,
+                                int count,
+                                PhaseResult* result) {
+	state DeterministicRandom random(config.seed + 200 + reader);
+	state Arena arena;
+	state KeyRef end = phaseEnd(config, 's', arena);
+	state int i = 0;
+	for (i = 0; i < count; ++i) {
+		state Key begin = benchmarkKey(config, 's', random.randomInt(0, config.records));
+		state double start = timer();
+		RangeResult rows = wait(kvs->readRange(KeyRangeRef(begin, end), config.rangeRows, 1 << 30));
+		result->latencies.push_back(timer() - start);
+		++result->ops;
+		result->bytes += rows.expectedSize();
+	}
+	return Void();
+}
+
+ACTOR Future<PhaseResult> readPhase(IKeyValueStore* kvs, BenchmarkConfig config, bool scans) {
+	state PhaseResult result;
+	result.name = scans ? "range_scan" : "point_read";
+	state PhaseTimer phaseTimer(&result, kvs);
+	state int total = scans ? config.rangeScans : config.pointReads;
+	state std::vector<Future<Void>> readers;
+	for (int r = 0; r < config.concurrency; ++r) {
+		int count = total / config.concurrency + (r < total % config.concurrency ? 1 : 0);
+		readers.push_back(scans ? rangeScanner(kvs, config, r, count, &result)
+		                        : pointReader(kvs, config, r, count, &result));
+	}
+	wait(waitForAll(readers));
+	phaseTimer.finish();
+	return result;
+}
+
+void removeStoreFiles(const std::string& path) {
+	if (directoryExists(path)) {
+		platform::eraseDirectoryRecursive(path);
+	}
+	deleteFile(path);
+	deleteFile(path + "-wal");
+}
+
+ACTOR Future<JsonBuilderObject> benchmarkEngine(KeyValueStoreType storeType, BenchmarkConfig config) {
+	state std::string path = joinPath(config.directory, "storage-benchmark-" + storeType.toString());
+	state JsonBuilderObject engine;
+	state JsonBuilderArray phases;
+	state IKeyValueStore* kvs = nullptr;
+	engine["engine"] = storeType.toString();
+
+	removeStoreFiles(path);
+	try {
+		kvs = openKVStore(storeType, path, UID(), 1e9);
+		wait(kvs->init());
+
+		state PhaseResult r;
+		wait(store(r, insertPhase(kvs, config, true)));
+		phases.push_back(r.toJson());
+		wait(store(r, insertPhase(kvs, config, false)));
+		phases.push_back(r.toJson());
+		wait(store(r, readPhase(kvs, config, false)));
+		phases.push_back(r.toJson());
+		wait(store(r, readPhase(kvs, config, true)));
+		phases.push_back(r.toJson());
+
+		StorageBytes sb = kvs->getStorageBytes();
+		engine["storage_bytes_used"] = sb.used;
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarn, "StorageBenchmarkEngineError").error(e).detail("Engine", storeType);
+		engine["error"] = e.name();
+	}
+	engine["phases"] = phases;
+
+	if (kvs != nullptr) {
+		Future<Void> closed = kvs->onClosed();
+		kvs->dispose();
+		wait(closed);
+	}
+	removeStoreFiles(path);
+	return engine;
+}
+
+KeyValueStoreType parseEngine(const std::string& name) {
+	for (int t = 0; t < KeyValueStoreType::END; ++t) {
+		KeyValueStoreType storeType((KeyValueStoreType::StoreType)t);
+		// Accept Redwood by its configuration name as well as its full name
+		if (storeType.toString() == name || (t == KeyValueStoreType::SSD_REDWOOD_V1 && name == "ssd-redwood-1")) {
+			return storeType;
+		}
+	}
+	fmt::print(stderr, "Unknown storage engine {}\n", name);
+	throw invalid_option_value();
+}
+
+} // namespace
+
+TEST_CASE(":/storage/benchmark/suite") {
+	state BenchmarkConfig config;
+	config.directory = params.get("directory").orDefault(".");
+	config.seed = params.getInt("seed").orDefault(1);
+	config.records = params.getInt("records").orDefault(1e6);
+	config.keyPrefixLen = params.getInt("keyPrefixLen").orDefault(16);
+	config.valueSize = params.getInt("valueSize").orDefault(100);
+	config.commitBytes = params.getInt("commitBytes").orDefault(5e6);
+	config.pointReads = params.getInt("pointReads").orDefault(1e5);
+	config.rangeScans = params.getInt("rangeScans").orDefault(1e4);
+	config.rangeRows = params.getInt("rangeRows").orDefault(100);
+	config.concurrency = std::max<int64_t>(1, params.getInt("concurrency").orDefault(8));
+	state std::string engines =
+	    params.get("engines").orDefault("ssd-redwood-1,ssd-2,ssd-rocksdb-v1,ssd-sharded-rocksdb");
+	state std::string outputFile = params.get("outputFile").orDefault("");
+
+	state std::vector<KeyValueStoreType> storeTypes;
+	std::stringstream names(engines);
+	std::string name;
+	while (std::getline(names, name, ',')) {
+		storeTypes.push_back(parseEngine(name));
+	}
+
+	state JsonBuilderArray results;
+	state int i = 0;
+	for (i = 0; i < storeTypes.size(); ++i) {
+		JsonBuilderObject engine = wait(benchmarkEngine(storeTypes[i], config));
+		results.push_back(engine);
+	}
+
+	JsonBuilderObject out;
+	out["seed"] = config.seed;
+	out["records"] = config.records;
+	out["key_prefix_length"] = config.keyPrefixLen;
+	out["value_size"] = config.valueSize;
+	out["concurrency"] = config.concurrency;
+	out["engines"] = results;
+
+	std::string json = out.getJson();
+	if (outputFile.empty()) {
+		fmt::print("{}\n", json);
+	} else {
+		std::ofstream(outputFile) << json << "\n";
+	}
+	return Void();
+}
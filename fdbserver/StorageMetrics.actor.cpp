@@ -83,6 +83,15 @@ StorageMetrics StorageServerMetrics::getMetrics(KeyRangeRef const& keys) const {
 	return result;
 }
 
+StorageMetrics StorageServerMetrics::withRecentWrites(KeyRangeRef const& keys, StorageMetrics metrics) const {
+	if (SERVER_KNOBS->DD_WRITE_HOT_SHARD_DETECTION) {
+		int64_t recent =
+		    bytesWriteRecentSample.getEstimate(keys) * 1000.0 / SERVER_KNOBS->DD_WRITE_HOT_SHARD_REACTION_TIME;
+		metrics.bytesWrittenPerKSecond = std::max(metrics.bytesWrittenPerKSecond, recent);
+	}
+	return metrics;
+}
+
 // Called when metrics should change (IO for a given key)
 // Notifies waiting WaitMetricsRequests through waitMetricsMap, and updates metricsAverageQueue and metricsSampleMap
 void StorageServerMetrics::notify(KeyRef key, StorageMetrics& metrics) {
@@ -97,10 +106,15 @@ void StorageServerMetrics::notify(KeyRef key, StorageMetrics& metrics) {
 
 	StorageMetrics notifyMetrics;
 
-	if (metrics.bytesWrittenPerKSecond)
+	if (metrics.bytesWrittenPerKSecond) {
 		notifyMetrics.bytesWrittenPerKSecond =
 		    bytesWriteSample.addAndExpire(key, metrics.bytesWrittenPerKSecond, expire) *
 		    SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL_PER_KSECONDS;
+		if (SERVER_KNOBS->DD_WRITE_HOT_SHARD_DETECTION) {
+			bytesWriteRecentSample.addAndExpire(
+			    key, metrics.bytesWrittenPerKSecond, now() + SERVER_KNOBS->DD_WRITE_HOT_SHARD_REACTION_TIME);
+		}
+	}
 	if (metrics.iosPerKSecond)
 		notifyMetrics.iosPerKSecond = iopsSample.addAndExpire(key, metrics.iosPerKSecond, expire) *
 		                              SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL_PER_KSECONDS;
@@ -191,6 +205,8 @@ void StorageServerMetrics::poll() {
 		m.bytesReadPerKSecond = SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL_PER_KSECONDS;
 		bytesReadSample.poll(waitMetricsMap, m);
 	}
+	// Nothing waits on the recent writes themselves, waitMetrics() reads them when the average changes
+	bytesWriteRecentSample.poll();
 	// bytesSample doesn't need polling because we never call addExpire() on it
 }
 
@@ -436,7 +452,7 @@ std::vector<KeyRef> StorageServerMetrics::getSplitPoints(KeyRangeRef range,
                                                          Optional<KeyRef> prefixToRemove) const {
 	std::vector<KeyRef> toReturn;
 	KeyRef beginKey = range.begin;
-	IndexedSet<Key, int64_t>::const_iterator endKey =
+	StorageMetricSampleSet::const_iterator endKey =
 	    byteSample.sample.index(byteSample.sample.sumTo(byteSample.sample.lower_bound(beginKey)) + chunkSize);
 	while (endKey != byteSample.sample.end()) {
 		if (*endKey > range.end) {
@@ -750,3 +766,31 @@ TEST_CASE("/fdbserver/StorageMetricSample/readHotDetect/consecutiveRanges") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/StorageMetricSample/recentWrites") {
+	bool detection = SERVER_KNOBS->DD_WRITE_HOT_SHARD_DETECTION;
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_write_hot_shard_detection",
+	                                                          KnobValueRef::create(bool{ true }));
+
+	StorageServerMetrics ssm;
+	double perKSecond = 1000.0 / SERVER_KNOBS->DD_WRITE_HOT_SHARD_REACTION_TIME;
+	ssm.bytesWriteRecentSample.sample.insert("Apple"_sr, 1000);
+	ssm.bytesWriteRecentSample.sample.insert("Banana"_sr, 3000);
+
+	StorageMetrics average;
+	average.bytesWrittenPerKSecond = 2000 * perKSecond;
+	// A range written faster lately than on average reports its recent bandwidth, and the rest stays as it was
+	StorageMetrics m = ssm.withRecentWrites(KeyRangeRef("A"_sr, "C"_sr), average);
+	ASSERT_EQ(m.bytesWrittenPerKSecond, int64_t(4000 * perKSecond));
+	m = ssm.withRecentWrites(KeyRangeRef("A"_sr, "B"_sr), average);
+	ASSERT_EQ(m.bytesWrittenPerKSecond, average.bytesWrittenPerKSecond);
+
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_write_hot_shard_detection",
+	                                                          KnobValueRef::create(bool{ false }));
+	m = ssm.withRecentWrites(KeyRangeRef("A"_sr, "C"_sr), average);
+	ASSERT_EQ(m.bytesWrittenPerKSecond, average.bytesWrittenPerKSecond);
+
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("dd_write_hot_shard_detection",
+	                                                          KnobValueRef::create(bool{ detection }));
+	return Void();
+}
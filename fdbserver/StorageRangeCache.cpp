@@ -0,0 +1,186 @@
+/*
+ * StorageRangeCache.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbserver/StorageRangeCache.h"
+#include "flow/UnitTest.h"
+
+Optional<RangeResult> StorageRangeCache::get(KeyRangeRef range, int rowLimit, int byteLimit) {
+	auto it = entries.find(range.begin);
+	if (it == entries.end() || it->second.end != range.end || it->second.rowLimit != rowLimit ||
+	    it->second.byteLimit != byteLimit) {
+		return Optional<RangeResult>();
+	}
+	lru.splice(lru.end(), lru, it->second.lru);
+	return it->second.result;
+}
+
+void StorageRangeCache::insert(KeyRangeRef range,
+                               int rowLimit,
+                               int byteLimit,
+                               const RangeResult& result,
+                               uint64_t readGeneration) {
+	if (!enabled() || readGeneration != generation || range.empty()) {
+		return;
+	}
+
+	// Copy the result so the entry does not hold on to the rest of the engine's arena
+	RangeResult copy;
+	copy.contents() = RangeResultRef(copy.arena(), result);
+	int64_t entryBytes = copy.arena().getSize() + 2 * range.expectedSize();
+	if (entryBytes > maxEntryBytes || entryBytes > capacityBytes) {
+		return;
+	}
+
+	eraseOverlapping(range);
+	Key begin(range.begin);
+	auto lruIt = lru.insert(lru.end(), begin);
+	entries.emplace(begin, Entry{ Key(range.end), rowLimit, byteLimit, copy, entryBytes, lruIt });
+	bytes += entryBytes;
+
+	while (bytes > capacityBytes) {
+		erase(entries.find(lru.front()));
+	}
+}
+
+void StorageRangeCache::invalidate(KeyRangeRef range) {
+	++generation;
+	if (!entries.empty()) {
+		eraseOverlapping(range);
+	}
+}
+
+void StorageRangeCache::invalidate(KeyRef key) {
+	++generation;
+	auto it = entries.upper_bound(key);
+	if (it != entries.begin() && key < (--it)->second.end) {
+		erase(it);
+	}
+}
+
+void StorageRangeCache::clear() {
+	++generation;
+	entries.clear();
+	lru.clear();
+	bytes = 0;
+}
+
+void StorageRangeCache::erase(std::map<Key, Entry>::iterator it) {
+	bytes -= it->second.bytes;
+	lru.erase(it->second.lru);
+	entries.erase(it);
+}
+
+void StorageRangeCache::eraseOverlapping(KeyRangeRef range) {
+	if (range.empty()) {
+		return;
+	}
+	// The entry beginning at or before range.begin is the only one beginning outside range that can overlap it
+	auto it = entries.upper_bound(range.begin);
+	if (it != entries.begin() && std::prev(it)->second.end > range.begin) {
+		--it;
+	}
+	while (it != entries.end() && it->first < range.end) {
+		erase(it++);
+	}
+}
+
+namespace {
+
+RangeResult makeRangeResult(std::vector<std::pair<std::string, std::string>> const& kvs, bool more) {
+	RangeResult result;
+	for (const auto& [key, value] : kvs) {
+		result.push_back_deep(result.arena(), KeyValueRef(StringRef(key), StringRef(value)));
+	}
+	result.more = more;
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("/fdbserver/StorageRangeCache/getAndInvalidate") {
+	StorageRangeCache cache(1000000, 1000000);
+	RangeResult ab = makeRangeResult({ { "a", "1" }, { "b", "2" } }, false);
+
+	uint64_t generation = cache.getGeneration();
+	cache.insert(KeyRangeRef("a"_sr, "c"_sr), 100, 1000, ab, generation);
+	ASSERT_EQ(cache.size(), 1);
+
+	// Only a read of the same range with the same limits is served
+	ASSERT(cache.get(KeyRangeRef("a"_sr, "c"_sr), 100, 1000).present());
+	ASSERT_EQ(cache.get(KeyRangeRef("a"_sr, "c"_sr), 100, 1000).get().size(), 2);
+	ASSERT(!cache.get(KeyRangeRef("a"_sr, "b"_sr), 100, 1000).present());
+	ASSERT(!cache.get(KeyRangeRef("a"_sr, "c"_sr), 10, 1000).present());
+
+	// Writes outside the range leave it cached
+	cache.invalidate(singleKeyRange("c"_sr));
+	cache.invalidate(KeyRangeRef("0"_sr, "a"_sr));
+	ASSERT(cache.get(KeyRangeRef("a"_sr, "c"_sr), 100, 1000).present());
+
+	cache.invalidate("c"_sr);
+	ASSERT_EQ(cache.size(), 1);
+	cache.invalidate("b"_sr);
+	ASSERT_EQ(cache.size(), 0);
+	ASSERT(!cache.get(KeyRangeRef("a"_sr, "c"_sr), 100, 1000).present());
+
+	// A read issued before a write is not cached
+	generation = cache.getGeneration();
+	cache.invalidate(singleKeyRange("z"_sr));
+	cache.insert(KeyRangeRef("a"_sr, "c"_sr), 100, 1000, ab, generation);
+	ASSERT_EQ(cache.size(), 0);
+
+	// A range overlapping a cached range replaces it
+	cache.insert(KeyRangeRef("a"_sr, "c"_sr), 100, 1000, ab, cache.getGeneration());
+	cache.insert(KeyRangeRef("b"_sr, "d"_sr), 100, 1000, ab, cache.getGeneration());
+	ASSERT_EQ(cache.size(), 1);
+	ASSERT(cache.get(KeyRangeRef("b"_sr, "d"_sr), 100, 1000).present());
+
+	cache.clear();
+	ASSERT_EQ(cache.size(), 0);
+	ASSERT_EQ(cache.getBytes(), 0);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/StorageRangeCache/eviction") {
+	RangeResult r = makeRangeResult({ { "k", std::string(100, 'v') } }, true);
+	RangeResult copy;
+	copy.contents() = RangeResultRef(copy.arena(), r);
+	const int64_t entryBytes = copy.arena().getSize() + 2 * KeyRangeRef("a"_sr, "b"_sr).expectedSize();
+
+	StorageRangeCache cache(3 * entryBytes, entryBytes);
+	cache.insert(KeyRangeRef("a"_sr, "b"_sr), 1, 1 << 30, r, cache.getGeneration());
+	cache.insert(KeyRangeRef("c"_sr, "d"_sr), 1, 1 << 30, r, cache.getGeneration());
+	cache.insert(KeyRangeRef("e"_sr, "f"_sr), 1, 1 << 30, r, cache.getGeneration());
+	ASSERT_EQ(cache.size(), 3);
+	ASSERT_EQ(cache.getBytes(), 3 * entryBytes);
+
+	// Touch the oldest entry, so the next insert evicts the second one
+	ASSERT(cache.get(KeyRangeRef("a"_sr, "b"_sr), 1, 1 << 30).present());
+	cache.insert(KeyRangeRef("g"_sr, "h"_sr), 1, 1 << 30, r, cache.getGeneration());
+	ASSERT_EQ(cache.size(), 3);
+	ASSERT(cache.get(KeyRangeRef("a"_sr, "b"_sr), 1, 1 << 30).present());
+	ASSERT(!cache.get(KeyRangeRef("c"_sr, "d"_sr), 1, 1 << 30).present());
+	ASSERT(cache.get(KeyRangeRef("g"_sr, "h"_sr), 1, 1 << 30).present());
+
+	// Results over the entry size limit are not cached
+	RangeResult big = makeRangeResult({ { "k", std::string(1000, 'v') } }, true);
+	cache.insert(KeyRangeRef("x"_sr, "y"_sr), 1, 1 << 30, big, cache.getGeneration());
+	ASSERT(!cache.get(KeyRangeRef("x"_sr, "y"_sr), 1, 1 << 30).present());
+	return Void();
+}
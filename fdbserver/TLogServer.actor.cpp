@@ -285,6 +285,49 @@ struct SpilledData {
 	uint32_t mutationBytes = 0;
 };
 
+// Caches recently read disk queue entries by their location, so that several storage servers catching up on the same
+// spilled versions read them from disk once. Disk queue locations are never reused, so an entry never goes stale.
+class SpilledReadCache : NonCopyable {
+public:
+	explicit SpilledReadCache(int64_t capacityBytes) : capacityBytes(capacityBytes) {}
+
+	Optional<Standalone<StringRef>> get(IDiskQueue::location loc) {
+		auto it = entries.find(loc);
+		if (it == entries.end()) {
+			return Optional<Standalone<StringRef>>();
+		}
+		lru.splice(lru.end(), lru, it->second.second);
+		return it->second.first;
+	}
+
+	bool contains(IDiskQueue::location loc) const { return entries.count(loc) != 0; }
+
+	void insert(IDiskQueue::location loc, StringRef entry) {
+		if (entry.size() > capacityBytes || contains(loc)) {
+			return;
+		}
+		// Copy the entry, so the cache does not hold on to the rest of the read it came from
+		entries.emplace(loc, std::make_pair(Standalone<StringRef>(entry), lru.insert(lru.end(), loc)));
+		bytes += entry.size();
+		while (bytes > capacityBytes) {
+			auto it = entries.find(lru.front());
+			bytes -= it->second.first.size();
+			entries.erase(it);
+			lru.pop_front();
+		}
+	}
+
+	bool enabled() const { return capacityBytes > 0; }
+	int64_t getBytes() const { return bytes; }
+	int size() const { return entries.size(); }
+
+private:
+	int64_t capacityBytes;
+	int64_t bytes = 0;
+	std::map<IDiskQueue::location, std::pair<Standalone<StringRef>, std::list<IDiskQueue::location>::iterator>> entries;
+	std::list<IDiskQueue::location> lru; // Least recently used first
+};
+
 struct TLogData : NonCopyable {
 	AsyncTrigger newLogData;
 	// A process has only 1 SharedTLog, which holds data for multiple logs, so that it obeys its assigned memory limit.
@@ -319,7 +362,11 @@ struct TLogData : NonCopyable {
 
 	std::deque<std::tuple<Version, int>> unknownCommittedVersions;
 
+	SpilledReadCache spilledReadCache; // Disk queue entries recently read for peeks of spilled data, shared by all tags
+
 	int64_t diskQueueCommitBytes;
+	int64_t diskQueueCommitPushes; // Versions pushed to persistentQueue since the last commit, by any generation
+	int64_t lastQueueCommitPushes; // Versions made durable by the last commit
 	AsyncVar<bool>
 	    largeDiskQueueCommitBytes; // becomes true when diskQueueCommitBytes is greater than MAX_QUEUE_COMMIT_BYTES
 
@@ -368,8 +415,10 @@ struct TLogData : NonCopyable {
 	         Reference<AsyncVar<bool>> degraded,
 	         std::string folder)
 	  : dbgid(dbgid), workerID(workerID), persistentData(persistentData), rawPersistentQueue(persistentQueue),
-	    persistentQueue(new TLogQueue(persistentQueue, dbgid)), diskQueueCommitBytes(0),
-	    largeDiskQueueCommitBytes(false), dbInfo(dbInfo), queueCommitEnd(0), queueCommitBegin(0),
+	    persistentQueue(new TLogQueue(persistentQueue, dbgid)),
+	    spilledReadCache(SERVER_KNOBS->TLOG_SPILLED_READ_CACHE_BYTES), diskQueueCommitBytes(0),
+	    diskQueueCommitPushes(0), lastQueueCommitPushes(0), largeDiskQueueCommitBytes(false), dbInfo(dbInfo),
+	    queueCommitEnd(0), queueCommitBegin(0),
 	    instanceID(deterministicRandom()->randomUniqueID().first()), bytesInput(0), bytesDurable(0),
 	    targetVolatileBytes(SERVER_KNOBS->TLOG_SPILL_THRESHOLD), overheadBytesInput(0), overheadBytesDurable(0),
 	    peekMemoryLimiter(SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES),
@@ -494,6 +543,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	VersionMetricHandle persistentDataVersion,
 	    persistentDataDurableVersion; // The last version number in the portion of the log (written|durable) to
 	                                  // persistentData
+	int64_t bytesInputAtLastSpill = 0; // bytesInput when updateStorage last chose what to spill
 	NotifiedVersion version;
 	NotifiedVersion queueCommittedVersion; // The disk queue has committed up until the queueCommittedVersion version.
 	Version queueCommittingVersion;
@@ -545,6 +595,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Counter blockingPeekTimeouts;
 	Counter emptyPeeks;
 	Counter nonEmptyPeeks;
+	Counter queueCommits; // Commits (fsyncs) of the shared disk queue issued while this generation was active
+	Counter queueCommitPushes; // Versions, of any generation, made durable by those commits
 	std::map<Tag, LatencySample> blockingPeekLatencies;
 	std::map<Tag, LatencySample> peekVersionCounts;
 
@@ -634,7 +686,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	    unpoppedRecoveredTagCount(0), cc("TLog", interf.id().toString()), bytesInput("BytesInput", cc),
 	    bytesDurable("BytesDurable", cc), blockingPeeks("BlockingPeeks", cc),
 	    blockingPeekTimeouts("BlockingPeekTimeouts", cc), emptyPeeks("EmptyPeeks", cc),
-	    nonEmptyPeeks("NonEmptyPeeks", cc), logId(interf.id()), protocolVersion(protocolVersion),
+	    nonEmptyPeeks("NonEmptyPeeks", cc), queueCommits("QueueCommits", cc),
+	    queueCommitPushes("QueueCommitPushes", cc), logId(interf.id()), protocolVersion(protocolVersion),
 	    newPersistentDataVersion(invalidVersion), tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1),
 	    recoveryTxnVersion(1), logSystem(new AsyncVar<Reference<ILogSystem>>()), remoteTag(remoteTag),
 	    isPrimary(isPrimary), logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0),
@@ -673,6 +726,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 		specialCounter(cc, "PeekMemoryRequestsStalled", [tLogData]() { return tLogData->peekMemoryLimiter.waiters(); });
 		specialCounter(cc, "Generation", [this]() { return this->recoveryCount; });
 		specialCounter(cc, "ActivePeekStreams", [tLogData]() { return tLogData->activePeekStreams; });
+		specialCounter(cc, "QueueCommitBatchSize", [tLogData]() { return tLogData->lastQueueCommitPushes; });
 	}
 
 	~LogData() {
@@ -767,6 +821,7 @@ void TLogQueue::push(T const& qe, Reference<LogData> logData) {
 	const IDiskQueue::location endloc = queue->push(wr.toValue());
 	//TraceEvent("TLogQueueVersionWritten", dbgid).detail("Size", wr.getLength() - sizeof(uint32_t) - sizeof(uint8_t)).detail("Loc", loc);
 	logData->versionLocation[qe.version] = std::make_pair(startloc, endloc);
+	logData->tLogData->diskQueueCommitPushes++;
 }
 
 void TLogQueue::forgetBefore(Version upToVersion, Reference<LogData> logData) {
@@ -1395,11 +1450,31 @@ ACTOR Future<Void> updateStorage(TLogData* self) {
 		} else {
 			// Double check that a running TLog wasn't wrongly affected by spilling locked SharedTLogs.
 			ASSERT_WE_THINK(self->targetVolatileBytes == SERVER_KNOBS->TLOG_SPILL_THRESHOLD);
+			// Everything not yet spilled is replayed from the disk queue when the TLog restarts, so bounding the
+			// unspilled tail also bounds recovery time and the memory recovery needs.
+			int64_t volatileBytesLimit = self->targetVolatileBytes;
+			if (SERVER_KNOBS->TLOG_MAX_RECOVERY_REPLAY_BYTES > 0) {
+				volatileBytesLimit = std::min(volatileBytesLimit, SERVER_KNOBS->TLOG_MAX_RECOVERY_REPLAY_BYTES);
+			}
+			// Between the soft limit and the threshold, spill only what arrived since the last pass. Memory then
+			// levels off near the soft limit with small, steady spills, instead of the threshold being hit under load
+			// and spilling back-to-back batches.
+			int64_t spillBudget = SERVER_KNOBS->REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT;
+			const int64_t unspilledBytes = logData->bytesInput.getValue() - logData->bytesDurable.getValue();
+			if (SERVER_KNOBS->TLOG_INCREMENTAL_SPILL_FRACTION > 0 && unspilledBytes < volatileBytesLimit) {
+				const int64_t softLimit = volatileBytesLimit * SERVER_KNOBS->TLOG_INCREMENTAL_SPILL_FRACTION;
+				if (unspilledBytes >= softLimit) {
+					const int64_t bytesSinceLastSpill = logData->bytesInput.getValue() - logData->bytesInputAtLastSpill;
+					spillBudget = std::min(spillBudget, std::max<int64_t>(1, bytesSinceLastSpill));
+					volatileBytesLimit = softLimit;
+				}
+			}
+			logData->bytesInputAtLastSpill = logData->bytesInput.getValue();
 			Map<Version, std::pair<int, int>>::iterator sizeItr = logData->version_sizes.begin();
-			while (totalSize < SERVER_KNOBS->REFERENCE_SPILL_UPDATE_STORAGE_BYTE_LIMIT &&
+			while (totalSize < spillBudget &&
 			       sizeItr != logData->version_sizes.end() &&
 			       (logData->bytesInput.getValue() - logData->bytesDurable.getValue() - totalSize >=
-			            self->targetVolatileBytes ||
+			            volatileBytesLimit ||
 			        sizeItr->value.first == 0)) {
 				totalSize += sizeItr->value.first + sizeItr->value.second;
 				++sizeItr;
@@ -1633,7 +1708,7 @@ void peekMessagesFromMemory(Reference<LogData> self,
 	                           [](const auto& l, const auto& r) -> bool { return l.first < r.first; });
 
 	Version currentVersion = -1;
-	for (; it != deque.end(); ++it) {
+	while (it != deque.end()) {
 		if (it->first != currentVersion) {
 			if (messages.getLength() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
 				endVersion = currentVersion + 1;
@@ -1645,15 +1720,31 @@ void peekMessagesFromMemory(Reference<LogData> self,
 			messages << VERSION_HEADER << currentVersion;
 		}
 
-		// We need the 4 byte length prefix to be a TagsAndMessage format, but that prefix is added as part of StringRef
-		// serialization.
+		// Messages are stored with the 4 byte length prefix a TagsAndMessage needs, and the messages of a version are
+		// copied into its message block one after another, so a tag's messages for a version are usually adjacent.
+		// Copy each run of adjacent messages with one write instead of one per message.
+		const uint8_t* runBegin = (const uint8_t*)it->second.getLengthPtr();
+		const uint8_t* runEnd = runBegin;
+		auto runStart = it;
+		for (; it != deque.end() && it->first == currentVersion && (const uint8_t*)it->second.getLengthPtr() == runEnd;
+		     ++it) {
+			runEnd += sizeof(uint32_t) + it->second.expectedSize();
+			versionCount++;
+		}
 		int offset = messages.getLength();
-		messages << it->second.toStringRef();
-		void* data = messages.getData();
-		DEBUG_TAGS_AND_MESSAGE(
-		    "TLogPeek", currentVersion, StringRef((uint8_t*)data + offset, messages.getLength() - offset), self->logId)
-		    .detail("PeekTag", tag);
-		versionCount++;
+		messages.serializeBytes(runBegin, runEnd - runBegin);
+
+		if (MUTATION_TRACKING_ENABLED) {
+			for (; runStart != it; ++runStart) {
+				int size = sizeof(uint32_t) + runStart->second.expectedSize();
+				DEBUG_TAGS_AND_MESSAGE("TLogPeek",
+				                       currentVersion,
+				                       StringRef((uint8_t*)messages.getData() + offset, size),
+				                       self->logId)
+				    .detail("PeekTag", tag);
+				offset += size;
+			}
+		}
 	}
 
 	if (versionCount == 0) {
@@ -1673,6 +1764,55 @@ void peekMessagesFromMemory(Reference<LogData> self,
 	}
 }
 
+// Reads the disk queue entries at locations, which must be in increasing order. Entries in the spilled read cache are
+// not read again, and each run of adjacent entries is read with one disk queue read instead of a read per entry.
+ACTOR Future<std::vector<Standalone<StringRef>>> readSpilledEntries(
+    TLogData* self,
+    std::vector<std::pair<IDiskQueue::location, IDiskQueue::location>> locations) {
+	state std::vector<Standalone<StringRef>> entries(locations.size());
+	state std::vector<std::pair<int, int>> batches; // The [begin, end) range of locations each read covers
+	state std::vector<Future<Standalone<StringRef>>> reads;
+
+	int i = 0;
+	while (i < locations.size()) {
+		Optional<Standalone<StringRef>> cached = self->spilledReadCache.get(locations[i].first);
+		if (cached.present()) {
+			entries[i++] = cached.get();
+			continue;
+		}
+		int64_t bytes = locations[i].second.lo - locations[i].first.lo;
+		int j = i + 1;
+		for (; j < locations.size() && locations[j].first == locations[j - 1].second &&
+		       !self->spilledReadCache.contains(locations[j].first);
+		     ++j) {
+			bytes += locations[j].second.lo - locations[j].first.lo;
+			if (bytes > SERVER_KNOBS->TLOG_SPILLED_READ_MAX_BATCH_BYTES) {
+				break;
+			}
+		}
+		batches.emplace_back(i, j);
+		reads.push_back(self->rawPersistentQueue->read(locations[i].first, locations[j - 1].second, CheckHashes::True));
+		i = j;
+	}
+	wait(waitForAll(reads));
+
+	for (int b = 0; b < batches.size(); b++) {
+		// The disk queue returns the payload of the pages read, which is the entries one after another
+		StringRef data = reads[b].get();
+		for (int k = batches[b].first; k < batches[b].second; k++) {
+			ASSERT(data.size() >= sizeof(uint32_t));
+			const int entrySize = sizeof(uint32_t) + *(uint32_t*)data.begin() + sizeof(uint8_t);
+			entries[k] = Standalone<StringRef>(data.substr(0, entrySize), reads[b].get().arena());
+			data = data.substr(entrySize);
+			if (self->spilledReadCache.enabled()) {
+				self->spilledReadCache.insert(locations[k].first, entries[k]);
+			}
+		}
+		ASSERT(data.empty());
+	}
+	return entries;
+}
+
 ACTOR Future<std::vector<StringRef>> parseMessagesForTag(StringRef commitBlob, Tag tag, int logRouters) {
 	// See the comment in LogSystem.cpp for the binary format of commitBlob.
 	state std::vector<StringRef> relevantMessages;
@@ -1980,20 +2120,17 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				earlyEnd = earlyEnd || (kvrefs.size() >= SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK + 1);
 				wait(self->peekMemoryLimiter.take(TaskPriority::TLogSpilledPeekReply, commitBytes));
 				state FlowLock::Releaser memoryReservation(self->peekMemoryLimiter, commitBytes);
-				state std::vector<Future<Standalone<StringRef>>> messageReads;
-				messageReads.reserve(commitLocations.size());
-				for (const auto& pair : commitLocations) {
-					messageReads.push_back(self->rawPersistentQueue->read(pair.first, pair.second, CheckHashes::True));
-				}
+				state std::vector<Standalone<StringRef>> messageReads;
+				std::sort(commitLocations.begin(), commitLocations.end());
+				wait(store(messageReads, readSpilledEntries(self, std::move(commitLocations))));
 				commitLocations.clear();
-				wait(waitForAll(messageReads));
 
 				state Version lastRefMessageVersion = 0;
 				state int index = 0;
 				loop {
 					if (index >= messageReads.size())
 						break;
-					Standalone<StringRef> queueEntryData = messageReads[index].get();
+					Standalone<StringRef> queueEntryData = messageReads[index];
 					uint8_t valid;
 					const uint32_t length = *(uint32_t*)queueEntryData.begin();
 					queueEntryData = queueEntryData.substr(4, queueEntryData.size() - 4);
@@ -2180,6 +2317,10 @@ ACTOR Future<Void> doQueueCommit(TLogData* self,
 	Future<Void> c = self->persistentQueue->commit();
 	self->diskQueueCommitBytes = 0;
 	self->largeDiskQueueCommitBytes.set(false);
+	++logData->queueCommits;
+	logData->queueCommitPushes += self->diskQueueCommitPushes;
+	self->lastQueueCommitPushes = self->diskQueueCommitPushes;
+	self->diskQueueCommitPushes = 0;
 
 	wait(ioDegradedOrTimeoutError(
 	    c, SERVER_KNOBS->MAX_STORAGE_COMMIT_TIME, self->degraded, SERVER_KNOBS->TLOG_DEGRADED_DURATION, "TLogCommit"));
@@ -2279,6 +2420,13 @@ ACTOR Future<Void> commitQueue(TLogData* self) {
 						wait(self->queueCommitEnd.whenAtLeast(self->queueCommitBegin) ||
 						     self->largeDiskQueueCommitBytes.onChange());
 					}
+					// Give more pushes the chance to join this commit, so that a burst of small versions pays for
+					// one fsync instead of one each. Pushes from stopped generations are already part of it, since
+					// every generation shares persistentQueue.
+					if (SERVER_KNOBS->TLOG_GROUP_COMMIT_MAX_LINGER > 0 && !self->largeDiskQueueCommitBytes.get()) {
+						wait(delay(SERVER_KNOBS->TLOG_GROUP_COMMIT_MAX_LINGER, TaskPriority::TLogCommit) ||
+						     self->largeDiskQueueCommitBytes.onChange());
+					}
 					if (logData->queueCommittedVersion.get() == std::numeric_limits<Version>::max()) {
 						break;
 					}
@@ -2295,6 +2443,7 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
                               TLogCommitRequest req,
                               Reference<LogData> logData,
                               PromiseStream<Void> warningCollectorInput) {
+	req.decompressMessages();
 	state Span span("TLog:tLogCommit"_loc, req.spanContext);
 	state Optional<UID> tlogDebugID;
 	if (req.debugID.present()) {
@@ -3747,6 +3896,30 @@ struct DequeAllocator : std::allocator<T> {
 	}
 };
 
+TEST_CASE("/fdbserver/tlogserver/SpilledReadCache") {
+	SpilledReadCache cache(30);
+	cache.insert(IDiskQueue::location(0), StringRef(std::string(10, 'a')));
+	cache.insert(IDiskQueue::location(10), StringRef(std::string(10, 'b')));
+	cache.insert(IDiskQueue::location(20), StringRef(std::string(10, 'c')));
+	ASSERT_EQ(cache.size(), 3);
+	ASSERT_EQ(cache.getBytes(), 30);
+	ASSERT(cache.get(IDiskQueue::location(10)).get() == StringRef(std::string(10, 'b')));
+
+	// Touch the oldest entry, so the next insert evicts the one at 10
+	ASSERT(cache.get(IDiskQueue::location(0)).present());
+	cache.insert(IDiskQueue::location(30), StringRef(std::string(10, 'd')));
+	ASSERT_EQ(cache.size(), 3);
+	ASSERT(cache.contains(IDiskQueue::location(0)));
+	ASSERT(!cache.get(IDiskQueue::location(10)).present());
+	ASSERT(cache.contains(IDiskQueue::location(30)));
+
+	// Entries larger than the cache are not cached
+	cache.insert(IDiskQueue::location(40), StringRef(std::string(31, 'e')));
+	ASSERT(!cache.contains(IDiskQueue::location(40)));
+	ASSERT_EQ(cache.getBytes(), 30);
+	return Void();
+}
+
 TEST_CASE("Lfdbserver/tlogserver/VersionMessagesOverheadFactor") {
 
 	typedef std::pair<Version, LengthPrefixedStringRef> TestType; // type used by versionMessages
@@ -533,6 +533,8 @@ Future<Version> TagPartitionedLogSystem::push(Version prevVersion,
 			logGroupLocal++;
 		}
 	}
+	const CompressionFilter pushCompression =
+	    CompressionUtils::fromFilterString(SERVER_KNOBS->TLOG_PUSH_COMPRESSION_FILTER);
 	int logGroupLocal = 0;
 	for (auto& it : tLogs) {
 		if (it->isLocal && it->logServers.size()) {
@@ -561,20 +563,24 @@ Future<Version> TagPartitionedLogSystem::push(Version prevVersion,
 				}
 				Standalone<StringRef> msg = data.getMessages(location);
 				data.recordEmptyMessage(location, msg);
+				TLogCommitRequest req(spanContext,
+				                      msg.arena(),
+				                      prevVersion,
+				                      version,
+				                      knownCommittedVersion,
+				                      minKnownCommittedVersion,
+				                      msg,
+				                      tLogCount[logGroupLocal],
+				                      debugID);
+				if (pushCompression != CompressionFilter::NONE &&
+				    msg.size() >= SERVER_KNOBS->TLOG_PUSH_COMPRESSION_MIN_BYTES) {
+					req.compressMessages(pushCompression);
+				}
 				allReplies.push_back(recordPushMetrics(
 				    it->connectionResetTrackers[loc],
 				    it->tlogPushDistTrackers[loc],
 				    it->logServers[loc]->get().interf().address(),
-				    it->logServers[loc]->get().interf().commit.getReply(TLogCommitRequest(spanContext,
-				                                                                          msg.arena(),
-				                                                                          prevVersion,
-				                                                                          version,
-				                                                                          knownCommittedVersion,
-				                                                                          minKnownCommittedVersion,
-				                                                                          msg,
-				                                                                          tLogCount[logGroupLocal],
-				                                                                          debugID),
-				                                                        TaskPriority::ProxyTLogCommitReply)));
+				    it->logServers[loc]->get().interf().commit.getReply(req, TaskPriority::ProxyTLogCommitReply)));
 				Future<Void> commitSuccess = success(allReplies.back());
 				addActor.get().send(commitSuccess);
 				tLogCommitResults.push_back(commitSuccess);
@@ -1249,7 +1255,7 @@ Reference<ILogSystem::IPeekCursor> TagPartitionedLogSystem::peekLogRouter(UID db
 			// FIXME: do this merge on one of the logs in the other data center to avoid sending multiple copies
 			// across the WAN
 			return makeReference<ILogSystem::SetPeekCursor>(
-			    localSets, bestSet, localSets[bestSet]->bestLocationFor(tag), tag, begin, getPeekEnd(), true);
+			    localSets, bestSet, localSets[bestSet]->bestPeekLocationFor(tag), tag, begin, getPeekEnd(), true);
 		} else {
 			int bestPrimarySet = -1;
 			int bestSatelliteSet = -1;
@@ -1270,13 +1276,29 @@ Reference<ILogSystem::IPeekCursor> TagPartitionedLogSystem::peekLogRouter(UID db
 			    tLogs[bestSatelliteSet]->tLogVersion >= TLogVersion::V4) {
 				bestSet = bestSatelliteSet;
 			}
+			// Both the primary and the satellite TLogs hold the tag, so peek from whichever is measurably closer
+			if (SERVER_KNOBS->LOG_ROUTER_PEEK_USE_MEASURED_LATENCY && bestPrimarySet != -1 && bestSatelliteSet != -1 &&
+			    tLogs[bestSatelliteSet]->tLogVersion >= TLogVersion::V4) {
+				int otherSet = bestSet == bestSatelliteSet ? bestPrimarySet : bestSatelliteSet;
+				Optional<double> latency =
+				    tLogs[bestSet]->measuredPeekLatency(tLogs[bestSet]->bestPeekLocationFor(tag));
+				Optional<double> otherLatency =
+				    tLogs[otherSet]->measuredPeekLatency(tLogs[otherSet]->bestPeekLocationFor(tag));
+				if (latency.present() && otherLatency.present() &&
+				    otherLatency.get() < latency.get() * SERVER_KNOBS->LOG_ROUTER_PEEK_SWITCH_LATENCY_RATIO) {
+					CODE_PROBE(otherSet == bestSatelliteSet, "Log router peeks satellite for lower measured latency");
+					CODE_PROBE(otherSet == bestPrimarySet, "Log router peeks primary for lower measured latency");
+					bestSet = otherSet;
+				}
+			}
 			const auto& log = tLogs[bestSet];
+			int bestLocation = log->bestPeekLocationFor(tag);
 			TraceEvent("TLogPeekLogRouterBestOnly", dbgid)
 			    .detail("Tag", tag.toString())
 			    .detail("Begin", begin)
-			    .detail("LogId", log->logServers[log->bestLocationFor(tag)]->get().id());
+			    .detail("LogId", log->logServers[bestLocation]->get().id());
 			return makeReference<ILogSystem::ServerPeekCursor>(
-			    log->logServers[log->bestLocationFor(tag)], tag, begin, getPeekEnd(), false, true);
+			    log->logServers[bestLocation], tag, begin, getPeekEnd(), false, true);
 		}
 	}
 	bool firstOld = true;
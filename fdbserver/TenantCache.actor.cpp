@@ -321,6 +321,21 @@ Optional<Reference<TCTenantInfo>> TenantCache::tenantOwning(KeyRef key) const {
 	return it->value;
 }
 
+Key TenantCache::alignToTenantBoundary(KeyRef key, KeyRangeRef within) const {
+	auto it = tenantCache.lastLessOrEqual(key);
+	if (it == tenantCache.end() || !key.startsWith(it->key)) {
+		return key;
+	}
+	if (it->key > within.begin) {
+		return it->key;
+	}
+	Key tenantEnd = strinc(it->key);
+	if (tenantEnd < within.end) {
+		return tenantEnd;
+	}
+	return key;
+}
+
 std::unordered_set<int64_t> TenantCache::getTenantsOverQuota() const {
 	std::unordered_set<int64_t> tenantsOverQuota;
 	for (const auto& [tenantGroup, storage] : tenantStorageMap) {
@@ -429,6 +444,37 @@ public:
 
 		return Void();
 	}
+
+	ACTOR static Future<Void> AlignToTenantBoundary() {
+		wait(Future<Void>(Void()));
+
+		Database cx;
+		TenantCache tenantCache(cx, UID(1, 0));
+
+		TenantMapEntry tenant1(1, "ddtc_test_tenant_1"_sr, TenantState::READY);
+		TenantMapEntry tenant2(2, "ddtc_test_tenant_2"_sr, TenantState::READY);
+		tenantCache.insert(tenant1);
+		tenantCache.insert(tenant2);
+
+		Key prefix1 = TenantAPI::idToPrefix(1), prefix2 = TenantAPI::idToPrefix(2);
+		KeyRangeRef everything(""_sr, "\xff"_sr);
+
+		// Keys in a tenant move to its beginning, or to its end when the beginning is the start of the range
+		ASSERT(tenantCache.alignToTenantBoundary(prefix1.withSuffix("a"_sr), everything) == prefix1);
+		ASSERT(tenantCache.alignToTenantBoundary(prefix1.withSuffix("a"_sr), KeyRangeRef(prefix1, "\xff"_sr)) ==
+		       strinc(prefix1));
+		ASSERT(strinc(prefix1) == prefix2);
+
+		// Tenants that cover the whole range cannot be aligned to
+		KeyRangeRef insideTenant2(prefix2.withSuffix("a"_sr), prefix2.withSuffix("z"_sr));
+		ASSERT(tenantCache.alignToTenantBoundary(prefix2.withSuffix("m"_sr), insideTenant2) ==
+		       prefix2.withSuffix("m"_sr));
+
+		// Keys outside of tenants stay put
+		ASSERT(tenantCache.alignToTenantBoundary("a"_sr, everything) == "a"_sr);
+
+		return Void();
+	}
 };
 
 TEST_CASE("/TenantCache/InsertAndTestPresence") {
@@ -440,3 +486,8 @@ TEST_CASE("/TenantCache/RefreshAndTestPresence") {
 	wait(TenantCacheUnitTest::RefreshAndTestPresence());
 	return Void();
 }
+
+TEST_CASE("/TenantCache/AlignToTenantBoundary") {
+	wait(TenantCacheUnitTest::AlignToTenantBoundary());
+	return Void();
+}
@@ -0,0 +1,309 @@
+/*
+ * TenantIndex.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "fdbserver/TenantIndex.h"
+#include "fdbclient/VersionedMap.h"
+#include "flow/UnitTest.h"
+
+#include "fmt/format.h"
+
+namespace {
+
+// Whether the last of the changes at or before version created the tenant, if any of them is
+Optional<bool> lastChangeAt(std::vector<std::pair<Version, bool>> const& changes, Version version) {
+	if (version == latestVersion) {
+		return changes.back().second;
+	}
+	for (auto c = changes.rbegin(); c != changes.rend(); ++c) {
+		if (c->first <= version) {
+			return c->second;
+		}
+	}
+	return Optional<bool>();
+}
+
+} // namespace
+
+void TenantIndex::insert(int64_t tenantId, Version version) {
+	addChange(tenantId, version, true);
+}
+
+void TenantIndex::erase(int64_t tenantId, Version version) {
+	addChange(tenantId, version, false);
+}
+
+void TenantIndex::addChange(int64_t tenantId, Version version, bool exists) {
+	ASSERT(version >= latestVersion);
+	latestVersion = std::max(latestVersion, version);
+	changes[tenantId].emplace_back(version, exists);
+	changeLog.emplace_back(version, tenantId);
+	if (version <= oldestVersion) {
+		++foldableChanges;
+	}
+}
+
+bool TenantIndex::existsAt(int64_t tenantId, bool isFolded, Version version) const {
+	auto c = changes.find(tenantId);
+	if (c == changes.end()) {
+		return isFolded;
+	}
+	return lastChangeAt(c->second, version).orDefault(isFolded);
+}
+
+bool TenantIndex::contains(int64_t tenantId, Version version) const {
+	if (!changes.empty()) {
+		auto c = changes.find(tenantId);
+		if (c != changes.end()) {
+			Optional<bool> exists = lastChangeAt(c->second, version);
+			if (exists.present()) {
+				return exists.get();
+			}
+		}
+	}
+	return std::binary_search(folded.begin(), folded.end(), tenantId);
+}
+
+bool TenantIndex::containsAnyInRange(int64_t beginId, int64_t endId, Version version) const {
+	if (beginId > endId) {
+		return false;
+	}
+	// Only folded tenants removed since the last fold are skipped here, so this stops within a few of them
+	for (auto f = std::lower_bound(folded.begin(), folded.end(), beginId); f != folded.end() && *f <= endId; ++f) {
+		if (existsAt(*f, true, version)) {
+			return true;
+		}
+	}
+	for (auto c = changes.lower_bound(beginId); c != changes.end() && c->first <= endId; ++c) {
+		if (lastChangeAt(c->second, version).orDefault(false)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::vector<int64_t> TenantIndex::getRange(int64_t beginId, int64_t endId, Version version) const {
+	std::vector<int64_t> result;
+	auto f = std::lower_bound(folded.begin(), folded.end(), beginId);
+	auto c = changes.lower_bound(beginId);
+	while (true) {
+		bool hasFolded = f != folded.end() && *f < endId;
+		bool hasChanged = c != changes.end() && c->first < endId;
+		if (!hasFolded && !hasChanged) {
+			break;
+		}
+		int64_t id = !hasChanged || (hasFolded && *f < c->first) ? *f : c->first;
+		bool isFolded = hasFolded && *f == id;
+		if (existsAt(id, isFolded, version)) {
+			result.push_back(id);
+		}
+		if (isFolded) {
+			++f;
+		}
+		if (hasChanged && c->first == id) {
+			++c;
+		}
+	}
+	return result;
+}
+
+void TenantIndex::forgetVersionsBefore(Version newOldestVersion) {
+	ASSERT(newOldestVersion >= oldestVersion);
+	oldestVersion = newOldestVersion;
+	while (foldableChanges < changeLog.size() && changeLog[foldableChanges].first <= oldestVersion) {
+		++foldableChanges;
+	}
+	// Folding copies the array, so it waits until that is cheap per change folded
+	if (foldableChanges > 0 && foldableChanges * 256 >= folded.size()) {
+		fold();
+	}
+}
+
+void TenantIndex::fold() {
+	// Whether each tenant with foldable changes exists as of oldestVersion, in id order
+	std::map<int64_t, bool> states;
+	for (size_t i = 0; i < foldableChanges; i++) {
+		auto c = changes.find(changeLog[i].second);
+		if (c == changes.end()) {
+			continue;
+		}
+		auto& tenantChanges = c->second;
+		auto end = std::upper_bound(
+		    tenantChanges.begin(), tenantChanges.end(), oldestVersion, [](Version v, auto const& change) {
+			    return v < change.first;
+		    });
+		if (end == tenantChanges.begin()) {
+			continue;
+		}
+		states[c->first] = std::prev(end)->second;
+		tenantChanges.erase(tenantChanges.begin(), end);
+		if (tenantChanges.empty()) {
+			changes.erase(c);
+		}
+	}
+	changeLog.erase(changeLog.begin(), changeLog.begin() + foldableChanges);
+	foldableChanges = 0;
+
+	std::vector<int64_t> merged;
+	merged.reserve(folded.size() + states.size());
+	auto f = folded.begin();
+	for (auto const& [tenantId, exists] : states) {
+		auto next = std::lower_bound(f, folded.end(), tenantId);
+		merged.insert(merged.end(), f, next);
+		f = next;
+		if (f != folded.end() && *f == tenantId) {
+			++f;
+		}
+		if (exists) {
+			merged.push_back(tenantId);
+		}
+	}
+	merged.insert(merged.end(), f, folded.end());
+	folded = std::move(merged);
+}
+
+TEST_CASE("/fdbserver/TenantIndex/randomized") {
+	// Every change made, checked against reads at every version still readable
+	std::map<int64_t, std::vector<std::pair<Version, bool>>> model;
+	TenantIndex index;
+	Version version = 0;
+	Version oldest = 0;
+	for (int i = 0; i < 2000; i++) {
+		version += deterministicRandom()->randomInt(0, 3);
+		int64_t tenantId = deterministicRandom()->randomInt(0, 100);
+		bool exists = deterministicRandom()->coinflip();
+		if (exists) {
+			index.insert(tenantId, version);
+		} else {
+			index.erase(tenantId, version);
+		}
+		model[tenantId].emplace_back(version, exists);
+
+		if (deterministicRandom()->random01() < 0.05) {
+			oldest = deterministicRandom()->randomInt64(oldest, version + 1);
+			index.forgetVersionsBefore(oldest);
+		}
+
+		Version readVersion =
+		    deterministicRandom()->coinflip() ? latestVersion : deterministicRandom()->randomInt64(oldest, version + 1);
+		std::vector<int64_t> expected;
+		for (auto const& [id, changes] : model) {
+			if (lastChangeAt(changes, readVersion).orDefault(false)) {
+				expected.push_back(id);
+			}
+		}
+		int64_t lookup = deterministicRandom()->randomInt(0, 100);
+		ASSERT(index.contains(lookup, readVersion) ==
+		       std::binary_search(expected.begin(), expected.end(), lookup));
+
+		int64_t beginId = deterministicRandom()->randomInt(0, 100);
+		int64_t endId = deterministicRandom()->randomInt(0, 100);
+		auto first = std::lower_bound(expected.begin(), expected.end(), beginId);
+		ASSERT(index.containsAnyInRange(beginId, endId, readVersion) ==
+		       (first != expected.end() && *first <= endId));
+		ASSERT(index.getRange(beginId, endId, readVersion) ==
+		       std::vector<int64_t>(first, std::lower_bound(first, expected.end(), std::max(beginId, endId))));
+	}
+	return Void();
+}
+
+// Compares lookups in a TenantIndex with those in the VersionedMap storage servers used to keep tenants in
+TEST_CASE(":/fdbserver/TenantIndex/performance") {
+	int tenants = params.getInt("tenants").orDefault(1000000);
+	int recentChanges = params.getInt("recentChanges").orDefault(1000);
+	int lookups = params.getInt("lookups").orDefault(1000000);
+
+	std::vector<int64_t> ids;
+	for (int i = 0; i < tenants; i++) {
+		ids.push_back(deterministicRandom()->randomInt64(0, std::numeric_limits<int64_t>::max()));
+	}
+	VersionedMap<int64_t, Void> versionedMap;
+	TenantIndex index;
+	versionedMap.createNewVersion(1);
+	for (int64_t id : ids) {
+		versionedMap.insert(id, Void());
+		index.insert(id, 1);
+	}
+	index.forgetVersionsBefore(1);
+	// Changes within the MVCC window, which the index keeps apart from its array
+	for (int i = 0; i < recentChanges; i++) {
+		Version version = 2 + i;
+		int64_t id = ids[deterministicRandom()->randomInt(0, ids.size())];
+		versionedMap.createNewVersion(version);
+		if (i % 2) {
+			versionedMap.erase(id);
+			index.erase(id, version);
+		} else {
+			id = deterministicRandom()->randomInt64(0, std::numeric_limits<int64_t>::max());
+			versionedMap.insert(id, Void());
+			index.insert(id, version);
+		}
+	}
+
+	// Half of the lookups are for tenants that exist
+	std::vector<int64_t> queries;
+	for (int i = 0; i < lookups; i++) {
+		queries.push_back(i % 2 ? ids[deterministicRandom()->randomInt(0, ids.size())]
+		                        : deterministicRandom()->randomInt64(0, std::numeric_limits<int64_t>::max()));
+	}
+	Version readVersion = versionedMap.getLatestVersion();
+
+	double start = timer_monotonic();
+	int found = 0;
+	for (int64_t id : queries) {
+		auto view = versionedMap.at(readVersion);
+		found += view.find(id) != view.end();
+	}
+	double versionedMapTime = timer_monotonic() - start;
+
+	start = timer_monotonic();
+	int indexFound = 0;
+	for (int64_t id : queries) {
+		indexFound += index.contains(id, readVersion);
+	}
+	double indexTime = timer_monotonic() - start;
+	ASSERT_EQ(found, indexFound);
+
+	start = timer_monotonic();
+	int intersecting = 0;
+	for (int64_t id : queries) {
+		auto view = versionedMap.at(readVersion);
+		auto it = view.lower_bound(id);
+		intersecting += it != view.end() && it.key() <= id + (1 << 20);
+	}
+	double versionedMapRangeTime = timer_monotonic() - start;
+
+	start = timer_monotonic();
+	int indexIntersecting = 0;
+	for (int64_t id : queries) {
+		indexIntersecting += index.containsAnyInRange(id, id + (1 << 20), readVersion);
+	}
+	double indexRangeTime = timer_monotonic() - start;
+	ASSERT_EQ(intersecting, indexIntersecting);
+
+	fmt::print("tenants={} recentChanges={} lookups={}\n", tenants, recentChanges, lookups);
+	fmt::print("contains: VersionedMap {:.1f} ns, TenantIndex {:.1f} ns\n",
+	           versionedMapTime / lookups * 1e9,
+	           indexTime / lookups * 1e9);
+	fmt::print("range: VersionedMap {:.1f} ns, TenantIndex {:.1f} ns\n",
+	           versionedMapRangeTime / lookups * 1e9,
+	           indexRangeTime / lookups * 1e9);
+	return Void();
+}
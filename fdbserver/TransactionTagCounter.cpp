@@ -79,6 +79,54 @@ public:
 	void clear() { topTags.clear(); }
 };
 
+// Space-saving heavy hitters sketch: counts at most limit key prefixes, and a prefix seen while full takes the
+// place of the least counted one, inheriting its count. Any prefix with more than 1/limit of the total cost is
+// kept, and a count overestimates the cost of its prefix by at most the inherited part.
+class HeavyKeyPrefixes {
+public:
+	struct PrefixAndCount {
+		Key prefix;
+		double count;
+		double inherited;
+		bool operator<(PrefixAndCount const& other) const { return count < other.count; }
+	};
+
+private:
+	std::vector<PrefixAndCount> counts;
+	int limit;
+
+public:
+	explicit HeavyKeyPrefixes(int limit) : limit(limit) {
+		ASSERT_GT(limit, 0);
+		counts.reserve(limit);
+	}
+
+	void add(KeyRef prefix, double cost) {
+		auto iter =
+		    std::find_if(counts.begin(), counts.end(), [prefix](auto const& pc) { return pc.prefix == prefix; });
+		if (iter != counts.end()) {
+			iter->count += cost;
+		} else if (counts.size() < limit) {
+			counts.push_back({ Key(prefix), cost, 0 });
+		} else {
+			auto toReplace = std::min_element(counts.begin(), counts.end());
+			*toReplace = { Key(prefix), toReplace->count + cost, toReplace->count };
+		}
+	}
+
+	// The k prefixes with the highest counts, highest first
+	std::vector<PrefixAndCount> top(int k) const {
+		std::vector<PrefixAndCount> result = counts;
+		std::sort(result.begin(), result.end(), [](auto const& a, auto const& b) { return b < a; });
+		if (result.size() > k) {
+			result.resize(k);
+		}
+		return result;
+	}
+
+	void clear() { counts.clear(); }
+};
+
 } // namespace
 
 class TransactionTagCounterImpl {
@@ -91,13 +139,68 @@ class TransactionTagCounterImpl {
 	std::vector<StorageQueuingMetricsReply::TagInfo> previousBusiestTags;
 	Reference<EventCacheHolder> busiestReadTagEventHolder;
 
+	HeavyKeyPrefixes keyPrefixes;
+	double intervalUntaggedCost = 0;
+	std::vector<StorageQueuingMetricsReply::TagInfo> previousBusiestKeyPrefixes;
+	Reference<EventCacheHolder> busiestReadKeyPrefixEventHolder;
+
+	void addUntaggedRequest(KeyRef key, int64_t bytes) {
+		int const prefixLength = SERVER_KNOBS->SS_BUSY_KEY_PREFIX_LENGTH;
+		if (prefixLength <= 0) {
+			return;
+		}
+		// Sampling in proportion to cost and counting each sample as at least the sample cost keeps the estimate
+		// unbiased while skipping most small reads
+		double const cost = getReadOperationCost(std::max<int64_t>(bytes, 1));
+		double const sampleCost = SERVER_KNOBS->SS_BUSY_KEY_PREFIX_SAMPLE_COST;
+		intervalUntaggedCost += cost;
+		if (cost >= sampleCost || deterministicRandom()->random01() < cost / sampleCost) {
+			keyPrefixes.add(key.substr(0, std::min(key.size(), prefixLength)), std::max(cost, sampleCost));
+		}
+	}
+
+	void updateBusiestKeyPrefixes(double elapsed) {
+		previousBusiestKeyPrefixes.clear();
+		for (auto const& pc : keyPrefixes.top(SERVER_KNOBS->SS_THROTTLE_TAGS_TRACKED)) {
+			double const rate = pc.count / elapsed;
+			if (rate > SERVER_KNOBS->MIN_TAG_READ_PAGES_RATE && intervalUntaggedCost > 0) {
+				double const fraction = std::min(1.0, pc.count / intervalUntaggedCost);
+				previousBusiestKeyPrefixes.emplace_back(pc.prefix, rate, fraction);
+			}
+		}
+
+		if (previousBusiestKeyPrefixes.empty()) {
+			TraceEvent("BusiestReadKeyPrefix", thisServerID)
+			    .detail("Cost", 0)
+			    .trackLatest(busiestReadKeyPrefixEventHolder->trackingKey);
+		} else {
+			auto const& busiest = previousBusiestKeyPrefixes[0];
+			TraceEvent("BusiestReadKeyPrefix", thisServerID)
+			    .detail("Prefix", printable(busiest.tag))
+			    .detail("Cost", busiest.rate)
+			    .detail("FractionalBusyness", busiest.fractionalBusyness)
+			    .trackLatest(busiestReadKeyPrefixEventHolder->trackingKey);
+		}
+		for (auto const& info : previousBusiestKeyPrefixes) {
+			TraceEvent("BusyReadKeyPrefix", thisServerID)
+			    .detail("Prefix", printable(info.tag))
+			    .detail("Cost", info.rate)
+			    .detail("FractionalBusyness", info.fractionalBusyness);
+		}
+	}
+
 public:
 	TransactionTagCounterImpl(UID thisServerID)
 	  : thisServerID(thisServerID), topTags(SERVER_KNOBS->SS_THROTTLE_TAGS_TRACKED),
-	    busiestReadTagEventHolder(makeReference<EventCacheHolder>(thisServerID.toString() + "/BusiestReadTag")) {}
+	    busiestReadTagEventHolder(makeReference<EventCacheHolder>(thisServerID.toString() + "/BusiestReadTag")),
+	    keyPrefixes(SERVER_KNOBS->SS_BUSY_KEY_PREFIXES_SKETCHED),
+	    busiestReadKeyPrefixEventHolder(
+	        makeReference<EventCacheHolder>(thisServerID.toString() + "/BusiestReadKeyPrefix")) {}
 
-	void addRequest(Optional<TagSet> const& tags, int64_t bytes) {
-		if (tags.present()) {
+	void addRequest(Optional<TagSet> const& tags, KeyRef key, int64_t bytes) {
+		if (!tags.present()) {
+			addUntaggedRequest(key, bytes);
+		} else {
 			CODE_PROBE(true, "Tracking transaction tag in counter");
 			auto const cost = getReadOperationCost(bytes);
 			for (auto& tag : tags.get()) {
@@ -140,14 +243,22 @@ public:
 				    .detail("FractionalBusyness", tagInfo.fractionalBusyness);
 			}
 		}
+		if (intervalStart > 0 && elapsed > 0) {
+			updateBusiestKeyPrefixes(elapsed);
+		}
 
 		intervalCounts.clear();
 		intervalTotalSampledCount = 0;
 		topTags.clear();
+		keyPrefixes.clear();
+		intervalUntaggedCost = 0;
 		intervalStart = now();
 	}
 
 	std::vector<StorageQueuingMetricsReply::TagInfo> const& getBusiestTags() const { return previousBusiestTags; }
+	std::vector<StorageQueuingMetricsReply::TagInfo> const& getBusiestKeyPrefixes() const {
+		return previousBusiestKeyPrefixes;
+	}
 };
 
 TransactionTagCounter::TransactionTagCounter(UID thisServerID)
@@ -155,8 +266,8 @@ TransactionTagCounter::TransactionTagCounter(UID thisServerID)
 
 TransactionTagCounter::~TransactionTagCounter() = default;
 
-void TransactionTagCounter::addRequest(Optional<TagSet> const& tags, int64_t bytes) {
-	return impl->addRequest(tags, bytes);
+void TransactionTagCounter::addRequest(Optional<TagSet> const& tags, KeyRef key, int64_t bytes) {
+	return impl->addRequest(tags, key, bytes);
 }
 
 void TransactionTagCounter::startNewInterval() {
@@ -167,6 +278,10 @@ std::vector<StorageQueuingMetricsReply::TagInfo> const& TransactionTagCounter::g
 	return impl->getBusiestTags();
 }
 
+std::vector<StorageQueuingMetricsReply::TagInfo> const& TransactionTagCounter::getBusiestKeyPrefixes() const {
+	return impl->getBusiestKeyPrefixes();
+}
+
 TEST_CASE("/TransactionTagCounter/TopKTags") {
 	TopKTags topTags(2);
 
@@ -223,3 +338,37 @@ TEST_CASE("/TransactionTagCounter/TopKTags") {
 	ASSERT_EQ(topTags.getBusiestTags(1.0, 0).size(), 0);
 	return Void();
 }
+
+TEST_CASE("/TransactionTagCounter/HeavyKeyPrefixes") {
+	HeavyKeyPrefixes prefixes(2);
+	ASSERT(prefixes.top(2).empty());
+
+	prefixes.add("a"_sr, 5);
+	prefixes.add("b"_sr, 1);
+	prefixes.add("a"_sr, 5);
+	{
+		auto const top = prefixes.top(2);
+		ASSERT_EQ(top.size(), 2);
+		ASSERT(top[0].prefix == "a"_sr && top[0].count == 10);
+		ASSERT(top[1].prefix == "b"_sr && top[1].count == 1);
+	}
+
+	// A new prefix replaces the least counted one and inherits its count
+	prefixes.add("c"_sr, 3);
+	{
+		auto const top = prefixes.top(2);
+		ASSERT_EQ(top.size(), 2);
+		ASSERT(top[0].prefix == "a"_sr);
+		ASSERT(top[1].prefix == "c"_sr && top[1].count == 4 && top[1].inherited == 1);
+	}
+	ASSERT_EQ(prefixes.top(1).size(), 1);
+
+	// A prefix with most of the cost is found among many light ones
+	prefixes.clear();
+	for (int i = 0; i < 1000; ++i) {
+		prefixes.add(StringRef(std::to_string(i)), 1);
+		prefixes.add("hot"_sr, 2);
+	}
+	ASSERT(prefixes.top(1)[0].prefix == "hot"_sr);
+	return Void();
+}
@@ -23,6 +23,7 @@
 #include "fdbclient/Tuple.h"
 #include "fdbrpc/DDSketch.h"
 #include "fdbrpc/simulator.h"
+#include "fdbserver/CoroFlow.h"
 #include "fdbserver/DeltaTree.h"
 #include "fdbserver/IKeyValueStore.h"
 #include "fdbserver/IPager.h"
@@ -30,6 +31,7 @@
 #include "fdbserver/VersionedBTreeDebug.h"
 #include "fdbserver/WorkerInterface.actor.h"
 #include "flow/ActorCollection.h"
+#include "flow/CompressionUtils.h"
 #include "flow/Error.h"
 #include "flow/FastRef.h"
 #include "flow/flow.h"
@@ -37,17 +39,20 @@
 #include "flow/Histogram.h"
 #include "flow/IAsyncFile.h"
 #include "flow/IRandom.h"
+#include "flow/IThreadPool.h"
 #include "flow/Knobs.h"
 #include "flow/ObjectSerializer.h"
 #include "flow/PriorityMultiLock.actor.h"
 #include "flow/serialize.h"
 #include "flow/Trace.h"
 #include "flow/UnitTest.h"
+#include "flow/xxhash.h"
 #include "fmt/format.h"
 
 #include <boost/intrusive/list.hpp>
 #include <cinttypes>
 #include <limits>
+#include <list>
 #include <map>
 #include <random>
 #include <string>
@@ -1444,19 +1449,34 @@ struct RedwoodMetrics {
 		unsigned int opCommit;
 		unsigned int opGet;
 		unsigned int opGetRange;
+		unsigned int opBulkLoadRecords;
+		unsigned int opBulkLoadLeaves;
 		unsigned int pagerDiskWrite;
 		unsigned int pagerDiskRead;
+		unsigned int pagerDiskReadCoalesced;
+		unsigned int pagerSecondaryHit;
+		unsigned int pagerSecondaryMiss;
+		unsigned int pagerSecondaryInvalid;
 		unsigned int pagerRemapFree;
 		unsigned int pagerRemapCopy;
 		unsigned int pagerRemapSkip;
+		unsigned int pagerRemapThrottled;
 		unsigned int pagerCacheHit;
 		unsigned int pagerCacheMiss;
 		unsigned int pagerProbeHit;
 		unsigned int pagerProbeMiss;
 		unsigned int pagerEvictUnhit;
+		unsigned int pagerEvictUnused;
+		unsigned int pagerEvictProtected;
 		unsigned int pagerEvictFail;
 		unsigned int btreeLeafPreload;
 		unsigned int btreeLeafPreloadExt;
+		unsigned int btreePageCompress;
+		unsigned int btreePageCompressSavedBlocks;
+		unsigned int btreePageDecompress;
+		unsigned int btreePageDecompressBytes;
+		unsigned int btreeLeafFilterSkip;
+		unsigned int btreeLeafFilterFalsePositive;
 	};
 
 	RedwoodMetrics() {
@@ -1505,6 +1525,8 @@ struct RedwoodMetrics {
 		for (RedwoodMetrics::Level& level : levels) {
 			level.clear();
 		}
+		pagerCacheHitsCleared += metric.pagerCacheHit;
+		pagerCacheMissesCleared += metric.pagerCacheMiss;
 		metric = {};
 		startTime = g_network ? now() : 0;
 	}
@@ -1519,6 +1541,9 @@ struct RedwoodMetrics {
 	Reference<Histogram> kvSizeReadByGet;
 	Reference<Histogram> kvSizeReadByGetRange;
 	double startTime;
+	// Page cache hits and misses counted before the last clear()
+	int64_t pagerCacheHitsCleared = 0;
+	int64_t pagerCacheMissesCleared = 0;
 
 	// Return number of pages read or written, from cache or disk
 	unsigned int pageOps() const {
@@ -1588,6 +1613,11 @@ int RedwoodMetrics::maxRecordCount = 315;
 RedwoodMetrics g_redwoodMetrics = {};
 Future<Void> g_redwoodMetricsActor;
 
+std::pair<int64_t, int64_t> getRedwoodPageCacheHitsAndMisses() {
+	const RedwoodMetrics& m = g_redwoodMetrics;
+	return { m.pagerCacheHitsCleared + m.metric.pagerCacheHit, m.pagerCacheMissesCleared + m.metric.pagerCacheMiss };
+}
+
 ACTOR Future<Void> redwoodHistogramsLogger(double interval) {
 	state double currTime;
 	loop {
@@ -1631,12 +1661,17 @@ class ObjectCache : NonCopyable {
 	typedef std::unordered_map<IndexType, Entry> CacheT;
 
 	struct Entry : public boost::intrusive::list_base_hook<> {
-		Entry() : hits(0), size(0) {}
+		Entry() : hits(0), size(0), used(false), isProtected(false) {}
 		IndexType index;
 		ObjectType item;
 		int hits;
 		int size;
 		bool ownedByEvictor;
+		// Whether the entry has been accessed as a hit or by the miss that created it, as opposed to only being
+		// created without a hit, such as by a prefetch
+		bool used;
+		// Whether the entry is in the Evictor's protected segment rather than its probationary one
+		bool isProtected;
 		CacheT* pCache;
 	};
 
@@ -1647,9 +1682,16 @@ public:
 	// Not all objects tracked by the Evictor are in its evictionOrder, as ObjectCaches
 	// using this Evictor can temporarily remove entries to an external order but they
 	// must eventually give them back with moveIn() or remove them with reclaim().
+	//
+	// If protectedFraction is nonzero the eviction order is segmented. New entries start in the probationary
+	// evictionOrder and move to the protectedOrder when they are hit after their first use, so an entry read once by a
+	// scan or loaded by a prefetch can't displace entries that are read repeatedly. The protectedOrder holds at most
+	// protectedFraction of sizeLimit, its least recently used entries fall back to the probationary order, and it is
+	// only evicted from when the probationary order is empty.
 	class Evictor : NonCopyable {
 	public:
-		Evictor(int64_t sizeLimit = 0) : sizeLimit(sizeLimit) {}
+		Evictor(int64_t sizeLimit = 0)
+		  : sizeLimit(sizeLimit), protectedFraction(SERVER_KNOBS->REDWOOD_PAGECACHE_PROTECTED_FRACTION) {}
 
 		// Evictors are normally singletons, either one per real process or one per virtual process in simulation
 		static Evictor* getEvictor() {
@@ -1667,15 +1709,31 @@ public:
 		// but the entry size is still counted against the evictor
 		void moveOut(Entry& e, EvictionOrderT& dest) {
 			ASSERT(e.ownedByEvictor);
-			dest.splice(dest.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			dest.splice(dest.end(), orderOf(e), EvictionOrderT::s_iterator_to(e));
+			unprotect(e);
 			e.ownedByEvictor = false;
 			++movedOutCount;
 		}
 
-		// Move an entry to the back of the eviction order if it is in the eviction order
+		// Move an entry that is in the eviction order to the back of it, on a cache hit. A hit on an entry that was
+		// already used promotes it to the protected segment, if there is one.
 		void moveToBack(Entry& e) {
 			ASSERT(e.ownedByEvictor);
-			evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			if (e.isProtected) {
+				protectedOrder.splice(protectedOrder.end(), protectedOrder, EvictionOrderT::s_iterator_to(e));
+			} else if (e.used && protectedFraction > 0) {
+				protectedOrder.splice(protectedOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+				e.isProtected = true;
+				protectedSize += e.size;
+				// Demote the least recently used protected entries to the back of the probationary order
+				while (protectedSize > sizeLimit * protectedFraction && protectedOrder.size() > 1) {
+					Entry& demoted = protectedOrder.front();
+					evictionOrder.splice(evictionOrder.end(), protectedOrder, protectedOrder.begin());
+					unprotect(demoted);
+				}
+			} else {
+				evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			}
 		}
 
 		// Move entire contents of an external eviction order containing entries whose size is part of
@@ -1694,6 +1752,7 @@ public:
 			sizeUsed += e.size;
 			evictionOrder.push_back(e);
 			e.ownedByEvictor = true;
+			e.isProtected = false;
 		}
 
 		// Claim ownership of an entry, removing its size from the current size and removing it
@@ -1702,7 +1761,8 @@ public:
 			sizeUsed -= e.size;
 			// If e is in evictionOrder then remove it
 			if (e.ownedByEvictor) {
-				evictionOrder.erase(EvictionOrderT::s_iterator_to(e));
+				orderOf(e).erase(EvictionOrderT::s_iterator_to(e));
+				unprotect(e);
 				e.ownedByEvictor = false;
 			} else {
 				// Otherwise, it wasn't so it had to be a movedOut item so decrement the count
@@ -1713,9 +1773,11 @@ public:
 		void trim(int additionalSpaceNeeded = 0) {
 			int attemptsLeft = FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
 			// While the cache is too big, evict the oldest entry until the oldest entry can't be evicted.
+			// Protected entries are only evicted once there are no probationary entries left.
 			while (attemptsLeft-- > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
-			       !evictionOrder.empty()) {
-				Entry& toEvict = evictionOrder.front();
+			       !(evictionOrder.empty() && protectedOrder.empty())) {
+				EvictionOrderT& order = evictionOrder.empty() ? protectedOrder : evictionOrder;
+				Entry& toEvict = order.front();
 
 				debug_printf("Evictor count=%d sizeUsed=%" PRId64 " sizeLimit=%" PRId64 " sizePenalty=%" PRId64
 				             " needed=%d  Trying to evict %s evictable %d\n",
@@ -1729,22 +1791,31 @@ public:
 
 				if (!toEvict.item.evictable()) {
 					// shift the front to the back
-					evictionOrder.shift_forward(1);
+					order.shift_forward(1);
 					++g_redwoodMetrics.metric.pagerEvictFail;
 					break;
 				} else {
 					if (toEvict.hits == 0) {
 						++g_redwoodMetrics.metric.pagerEvictUnhit;
 					}
+					if (!toEvict.used) {
+						++g_redwoodMetrics.metric.pagerEvictUnused;
+					}
+					if (toEvict.isProtected) {
+						++g_redwoodMetrics.metric.pagerEvictProtected;
+					}
 					sizeUsed -= toEvict.size;
 					debug_printf("Evicting %s\n", ::toString(toEvict.index).c_str());
-					evictionOrder.pop_front();
+					order.pop_front();
+					unprotect(toEvict);
 					toEvict.pCache->erase(toEvict.index);
 				}
 			}
 		}
 
-		int64_t getCountUsed() const { return evictionOrder.size() + movedOutCount; }
+		int64_t getCountUsed() const { return evictionOrder.size() + protectedOrder.size() + movedOutCount; }
+		int64_t getCountProtected() const { return protectedOrder.size(); }
+		int64_t getSizeProtected() const { return protectedSize; }
 		int64_t getCountMoved() const { return movedOutCount; }
 		int64_t getSizeUsed() const { return sizeUsed + reservedSize; }
 
@@ -1753,17 +1824,21 @@ public:
 
 		std::string toString() const {
 			std::string s = format("Evictor {sizeLimit=%" PRId64 " sizeUsed=%" PRId64 " countUsed=%" PRId64
-			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64,
+			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64 " protectedSize=%" PRId64,
 			                       sizeLimit,
 			                       sizeUsed,
 			                       getCountUsed(),
 			                       reservedSize,
-			                       movedOutCount);
-			for (auto& entry : evictionOrder) {
-				s += format("\n\tindex %s  size %d  evictable %d\n",
-				            ::toString(entry.index).c_str(),
-				            entry.size,
-				            entry.item.evictable());
+			                       movedOutCount,
+			                       protectedSize);
+			for (auto* order : { &evictionOrder, &protectedOrder }) {
+				for (auto& entry : *order) {
+					s += format("\n\tindex %s  size %d  evictable %d  protected %d\n",
+					            ::toString(entry.index).c_str(),
+					            entry.size,
+					            entry.item.evictable(),
+					            entry.isProtected);
+				}
 			}
 			s += "}\n";
 			return s;
@@ -1773,9 +1848,24 @@ public:
 		// budget should add their usage to this total and keep it updated.
 		int64_t reservedSize = 0;
 		int64_t sizeLimit;
+		// Fraction of sizeLimit that the protected segment may hold, 0 for a single LRU order
+		double protectedFraction;
 
 	private:
+		EvictionOrderT& orderOf(Entry& e) { return e.isProtected ? protectedOrder : evictionOrder; }
+
+		void unprotect(Entry& e) {
+			if (e.isProtected) {
+				protectedSize -= e.size;
+				e.isProtected = false;
+			}
+		}
+
+		// The probationary eviction order, which new entries start in
 		EvictionOrderT evictionOrder;
+		// Entries hit again after their first use, least recently used first
+		EvictionOrderT protectedOrder;
+		int64_t protectedSize = 0;
 		// Size of all entries in the eviction order or held in external eviction orders
 		int64_t sizeUsed = 0;
 		// Number of items that have been moveOut()'d to other evictionOrders and aren't back yet
@@ -1805,6 +1895,9 @@ public:
 		return nullptr;
 	}
 
+	// Returns true if index is in the cache, without counting as a hit
+	bool exists(const IndexType& index) const { return cache.find(index) != cache.end(); }
+
 	// If index is in cache and not on the prioritized eviction order list, move it there.
 	void prioritizeEviction(const IndexType& index) {
 		auto i = cache.find(index);
@@ -1829,6 +1922,7 @@ public:
 				if (entry.ownedByEvictor) {
 					pEvictor->moveToBack(entry);
 				}
+				entry.used = true;
 			}
 		} else {
 			// Otherwise it was a cache miss
@@ -1838,6 +1932,7 @@ public:
 			entry.pCache = &cache;
 			entry.hits = 0;
 			entry.size = size;
+			entry.used = !noHit;
 
 			pEvictor->trim(entry.size);
 			pEvictor->addNew(entry);
@@ -1894,6 +1989,165 @@ Future<T> forwardError(Future<T> f, Promise<Void> target) {
 
 constexpr int initialVersion = invalidVersion;
 
+// A second tier of the pager's page cache in a file on a local device that is faster than the page file.  It holds
+// copies of recently read physical pages exactly as they were read from the page file, so a copy is verified with the
+// page's checksum like the original would be.  Each page has one slot, chosen by a hash of its ID, and replaces the
+// page already there.  Which page is in which slot is only known in memory, so the file is recreated when opened.
+class SecondaryPageCache : public ReferenceCounted<SecondaryPageCache> {
+public:
+	SecondaryPageCache(std::string filename, Reference<IAsyncFile> file, int pageSize, int64_t slots, int maxWrites)
+	  : filename(filename), file(file), pageSize(pageSize), maxWrites(maxWrites), owners(slots, invalidPhysicalPageID),
+	    generations(slots, 0) {}
+
+	ACTOR static Future<Reference<SecondaryPageCache>> open(std::string filename,
+	                                                        int pageSize,
+	                                                        int64_t capacityBytes,
+	                                                        int maxWrites) {
+		if (fileExists(filename)) {
+			wait(IAsyncFileSystem::filesystem()->deleteFile(filename, true));
+		}
+		state int64_t slots = std::max<int64_t>(1, capacityBytes / pageSize);
+		state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+		    filename,
+		    IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE |
+		        IAsyncFile::OPEN_LOCK | IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE,
+		    0600));
+		wait(file->truncate(slots * pageSize));
+		wait(file->sync());
+		TraceEvent("RedwoodSecondaryCacheOpened").detail("Filename", filename).detail("Slots", slots);
+		return makeReference<SecondaryPageCache>(filename, file, pageSize, slots, maxWrites);
+	}
+
+	const std::string& getFilename() const { return filename; }
+
+	bool contains(PhysicalPageID id) const { return owners[slotOf(id)] == id; }
+
+	// Returns the value to pass to insert() for a page file read of id that is started now
+	uint64_t getGeneration(PhysicalPageID id) const { return generations[slotOf(id)]; }
+
+	// Reads the copy of id into page, returning false if there is no copy or it was replaced during the read
+	Future<bool> read(PhysicalPageID id, Reference<ArenaPage> page) {
+		if (!contains(id)) {
+			return false;
+		}
+		return read_impl(this, slotOf(id), id, page);
+	}
+
+	// Copies page, which was read from the page file as id, into its slot unless id has been written since the read
+	// was started at generation
+	void insert(PhysicalPageID id, Reference<ArenaPage> page, uint64_t generation) {
+		int64_t slot = slotOf(id);
+		if (generations[slot] != generation || owners[slot] == id || writes.size() >= maxWrites) {
+			return;
+		}
+		owners[slot] = invalidPhysicalPageID;
+		Reference<ArenaPage> copy = makeReference<ArenaPage>(pageSize, pageSize);
+		memcpy(copy->rawData(), page->rawData(), pageSize);
+		writes.add(insert_impl(this, slot, ++generations[slot], id, copy));
+	}
+
+	// Discards the copy of id, and any copy of it being read from the page file.  Must be called when id is written.
+	void invalidate(PhysicalPageID id) {
+		int64_t slot = slotOf(id);
+		if (owners[slot] == id) {
+			owners[slot] = invalidPhysicalPageID;
+		}
+		++generations[slot];
+	}
+
+private:
+	int64_t slotOf(PhysicalPageID id) const { return XXH3_64bits(&id, sizeof(id)) % owners.size(); }
+
+	ACTOR static Future<bool> read_impl(SecondaryPageCache* self,
+	                                    int64_t slot,
+	                                    PhysicalPageID id,
+	                                    Reference<ArenaPage> page) {
+		state uint64_t generation = self->generations[slot];
+		try {
+			int readBytes = wait(self->file->read(page->rawData(), self->pageSize, slot * self->pageSize));
+			return readBytes == self->pageSize && self->generations[slot] == generation && self->owners[slot] == id;
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			TraceEvent(SevWarn, "RedwoodSecondaryCacheReadError").error(e).detail("Filename", self->filename);
+			return false;
+		}
+	}
+
+	// The write can't be cancelled while the file is using the buffer
+	ACTOR static UNCANCELLABLE Future<Void> writeSlot(Reference<IAsyncFile> file,
+	                                                  Reference<ArenaPage> copy,
+	                                                  int64_t offset) {
+		wait(file->write(copy->rawData(), copy->rawSize(), offset));
+		return Void();
+	}
+
+	ACTOR static Future<Void> insert_impl(SecondaryPageCache* self,
+	                                      int64_t slot,
+	                                      uint64_t generation,
+	                                      PhysicalPageID id,
+	                                      Reference<ArenaPage> copy) {
+		try {
+			wait(writeSlot(self->file, copy, slot * self->pageSize));
+			if (self->generations[slot] == generation) {
+				self->owners[slot] = id;
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			TraceEvent(SevWarn, "RedwoodSecondaryCacheWriteError").error(e).detail("Filename", self->filename);
+		}
+		return Void();
+	}
+
+	std::string filename;
+	Reference<IAsyncFile> file;
+	int pageSize;
+	int maxWrites;
+	// The page in each slot, or invalidPhysicalPageID if the slot has no valid copy
+	std::vector<PhysicalPageID> owners;
+	// Incremented whenever the page in a slot is replaced or invalidated
+	std::vector<uint64_t> generations;
+	ActorCollectionNoErrors writes;
+};
+
+// Limits how many remap cleanup copies can be in progress at once, adjusting the limit to foreground IO.  The limit is
+// halved while page reads are slower than the target or too many IOs are waiting for the IO lock, doubled while the
+// IO lock is idle, and otherwise grows by one, so cleanup backs off during peaks and catches up when the disk is free.
+struct RemapCleanupThrottle : ReferenceCounted<RemapCleanupThrottle> {
+	RemapCleanupThrottle(int maxLimit, double targetReadLatency, int maxWaiters)
+	  : maxLimit(maxLimit), limit(maxLimit), targetReadLatency(targetReadLatency), maxWaiters(maxWaiters) {}
+
+	// A maxLimit of 0 means cleanup is not throttled
+	bool enabled() const { return maxLimit > 0; }
+
+	void addReadLatency(double seconds) { readLatency += (seconds - readLatency) * 0.1; }
+
+	// Updates the limit from the IO lock's current waiters and runners
+	void update(int waiters, int runners) {
+		if (readLatency > targetReadLatency || waiters > maxWaiters) {
+			limit = std::max(1, limit / 2);
+		} else if (waiters == 0 && runners == 0) {
+			limit = std::min(maxLimit, limit * 2);
+		} else {
+			limit = std::min(maxLimit, limit + 1);
+		}
+	}
+
+	int maxLimit;
+	int limit;
+	double targetReadLatency;
+	int maxWaiters;
+	// Moving average of page file read latency, including the wait for the IO lock
+	double readLatency = 0;
+	// Number of cleanup copies in progress
+	int inProgress = 0;
+	// Triggered when a copy finishes or the limit changes
+	AsyncTrigger changed;
+};
+
 class DWALPagerSnapshot;
 
 // An implementation of IPager2 that supports atomicUpdate() of a page without forcing a change to new page ID.
@@ -2021,7 +2275,10 @@ public:
 	  : ioLock(makeReference<PriorityMultiLock>(FLOW_KNOBS->MAX_OUTSTANDING, SERVER_KNOBS->REDWOOD_IO_PRIORITIES)),
 	    pageCacheBytes(pageCacheSizeBytes), desiredPageSize(desiredPageSize), desiredExtentSize(desiredExtentSize),
 	    filename(filename), memoryOnly(memoryOnly), errorPromise(errorPromise),
-	    remapCleanupWindowBytes(remapCleanupWindowBytes), concurrentExtentReads(new FlowLock(concurrentExtentReads)) {
+	    remapCleanupWindowBytes(remapCleanupWindowBytes), concurrentExtentReads(new FlowLock(concurrentExtentReads)),
+	    remapCleanupThrottle(makeReference<RemapCleanupThrottle>(SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_MAX_CONCURRENCY,
+	                                                             SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_TARGET_READ_LATENCY,
+	                                                             SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_MAX_IO_WAITERS)) {
 
 		// This sets the page cache size for all PageCacheT instances using the same evictor
 		pageCache.evictor().sizeLimit = pageCacheBytes;
@@ -2037,6 +2294,14 @@ public:
 
 	std::string getName() const override { return filename; }
 
+	std::string getSecondaryCacheFilename() const {
+		std::string directory = SERVER_KNOBS->REDWOOD_SECONDARY_CACHE_DIR;
+		if (directory.empty()) {
+			directory = parentDirectory(filename, false);
+		}
+		return joinPath(directory, basename(filename) + ".cache");
+	}
+
 	void setEncryptionKeyProvider(Reference<IPageEncryptionKeyProvider> kp) override {
 		keyProvider = kp;
 		keyProviderInitialized.send(Void());
@@ -2088,7 +2353,7 @@ public:
 
 		if (!self->memoryOnly) {
 			int64_t flags = IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE |
-			                IAsyncFile::OPEN_LOCK;
+			                IAsyncFile::OPEN_LOCK | IAsyncFile::OPEN_IO_URING;
 			exists = fileExists(self->filename);
 			if (!exists) {
 				flags |= IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE;
@@ -2329,6 +2594,14 @@ public:
 
 		if (!self->memoryOnly) {
 			wait(store(fileSize, self->pageFile->size()));
+
+			if (SERVER_KNOBS->REDWOOD_SECONDARY_CACHE_BYTES > 0) {
+				wait(store(self->secondaryCache,
+				           SecondaryPageCache::open(self->getSecondaryCacheFilename(),
+				                                    self->physicalPageSize,
+				                                    SERVER_KNOBS->REDWOOD_SECONDARY_CACHE_BYTES,
+				                                    SERVER_KNOBS->REDWOOD_SECONDARY_CACHE_MAX_WRITES)));
+			}
 		}
 
 		TraceEvent e(SevInfo, "RedwoodRecoveredPager");
@@ -2584,10 +2857,29 @@ public:
 			f = waitForAll(writers);
 		}
 
+		// Copies in the secondary cache are stale once the write starts, and so is anything read from the page file
+		// before the write completes
+		if (secondaryCache.isValid() && !header) {
+			for (PhysicalPageID id : pageIDs) {
+				secondaryCache->invalidate(id);
+			}
+			f = invalidateSecondaryCopies(this, f, pageIDs);
+		}
+
 		operations.push_back(f);
 		return f;
 	}
 
+	ACTOR static Future<Void> invalidateSecondaryCopies(DWALPager* self,
+	                                                    Future<Void> write,
+	                                                    Standalone<VectorRef<PhysicalPageID>> pageIDs) {
+		wait(write);
+		for (PhysicalPageID id : pageIDs) {
+			self->secondaryCache->invalidate(id);
+		}
+		return Void();
+	}
+
 	Future<Void> writeHeaderPage(PhysicalPageID pageID, Reference<ArenaPage> page) {
 		return writePhysicalPage(
 		    PagerEventReasons::MetaData, nonBtreeLevel, VectorRef<PhysicalPageID>(&pageID, 1), page, true);
@@ -2777,55 +3069,61 @@ public:
 	                                                         int blockSize,
 	                                                         int64_t offset,
 	                                                         int priority) {
+		state Reference<RemapCleanupThrottle> throttle = self->remapCleanupThrottle;
+		state double startTime = now();
 		state PriorityMultiLock::Lock lock = wait(self->ioLock->lock(std::min(priority, ioMaxPriority)));
 		++g_redwoodMetrics.metric.pagerDiskRead;
 		int bytes = wait(self->pageFile->read(pageBuffer->rawData() + pageOffset, blockSize, offset));
+		throttle->addReadLatency(now() - startTime);
 		return bytes;
 	}
 
-	// Read a physical page from the page file.  Note that header pages use a page size of smallestPhysicalBlock.
-	// If the user chosen physical page size is larger, then there will be a gap of unused space after the header pages
-	// and before the user-chosen sized pages.
-	ACTOR static Future<Reference<ArenaPage>> readPhysicalPage(DWALPager* self,
-	                                                           PhysicalPageID pageID,
-	                                                           int priority,
-	                                                           bool header) {
-		ASSERT(!self->memoryOnly);
-
-		state Reference<ArenaPage> page =
-		    header ? makeReference<ArenaPage>(smallestPhysicalBlock, smallestPhysicalBlock) : self->newPageBuffer();
-		debug_printf("DWALPager(%s) op=readPhysicalStart %s ptr=%p header=%d\n",
-		             self->filename.c_str(),
-		             toString(pageID).c_str(),
-		             page->rawData(),
-		             header);
-
-		int readBytes =
-		    wait(readPhysicalBlock(self, page, 0, page->rawSize(), (int64_t)pageID * page->rawSize(), priority));
-		debug_printf("DWALPager(%s) op=readPhysicalDiskReadComplete %s ptr=%p bytes=%d\n",
-		             self->filename.c_str(),
-		             toString(pageID).c_str(),
-		             page->rawData(),
-		             readBytes);
+	// Verifies and decrypts if necessary the page at pageID, throwing if it is not valid
+	ACTOR static Future<Void> decodePhysicalPage(DWALPager* self, Reference<ArenaPage> page, PhysicalPageID pageID) {
+		page->postReadHeader(pageID);
+		if (page->isEncrypted()) {
+			if (!self->keyProvider.isValid()) {
+				wait(self->keyProviderInitialized.getFuture());
+				ASSERT(self->keyProvider.isValid());
+			}
+			if (self->keyProvider->expectedEncodingType() != page->getEncodingType()) {
+				TraceEvent(SevWarnAlways, "RedwoodBTreeUnexpectedNodeEncoding")
+				    .detail("PhysicalPageID", page->getPhysicalPageID())
+				    .detail("EncodingTypeFound", page->getEncodingType())
+				    .detail("EncodingTypeExpected", self->keyProvider->expectedEncodingType());
+				throw unexpected_encoding_type();
+			}
+			ArenaPage::EncryptionKey k = wait(self->keyProvider->getEncryptionKey(page->getEncodingHeader()));
+			page->encryptionKey = k;
+		}
+		page->postReadPayload(pageID);
+		return Void();
+	}
 
+	// Verifies, and decrypts if necessary, a page copy read from the secondary cache, returning whether it is valid
+	ACTOR static Future<bool> verifySecondaryCopy(DWALPager* self, Reference<ArenaPage> page, PhysicalPageID pageID) {
 		try {
-			page->postReadHeader(pageID);
-			if (page->isEncrypted()) {
-				if (!self->keyProvider.isValid()) {
-					wait(self->keyProviderInitialized.getFuture());
-					ASSERT(self->keyProvider.isValid());
-				}
-				if (self->keyProvider->expectedEncodingType() != page->getEncodingType()) {
-					TraceEvent(SevWarnAlways, "RedwoodBTreeUnexpectedNodeEncoding")
-					    .detail("PhysicalPageID", page->getPhysicalPageID())
-					    .detail("EncodingTypeFound", page->getEncodingType())
-					    .detail("EncodingTypeExpected", self->keyProvider->expectedEncodingType());
-					throw unexpected_encoding_type();
-				}
-				ArenaPage::EncryptionKey k = wait(self->keyProvider->getEncryptionKey(page->getEncodingHeader()));
-				page->encryptionKey = k;
+			wait(decodePhysicalPage(self, page, pageID));
+			return true;
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
 			}
-			page->postReadPayload(pageID);
+			TraceEvent(SevWarn, "RedwoodSecondaryCachePageError")
+			    .error(e)
+			    .detail("Filename", self->filename.c_str())
+			    .detail("PageID", pageID);
+			return false;
+		}
+	}
+
+	// Verifies, and decrypts if necessary, a physical page that has been read from the page file
+	ACTOR static Future<Void> verifyPhysicalPage(DWALPager* self,
+	                                             Reference<ArenaPage> page,
+	                                             PhysicalPageID pageID,
+	                                             bool header) {
+		try {
+			wait(decodePhysicalPage(self, page, pageID));
 			debug_printf("DWALPager(%s) op=readPhysicalVerified %s ptr=%p\n",
 			             self->filename.c_str(),
 			             toString(pageID).c_str(),
@@ -2853,6 +3151,58 @@ public:
 			throw err;
 		}
 
+		return Void();
+	}
+
+	// Read a physical page from the page file.  Note that header pages use a page size of smallestPhysicalBlock.
+	// If the user chosen physical page size is larger, then there will be a gap of unused space after the header pages
+	// and before the user-chosen sized pages.
+	ACTOR static Future<Reference<ArenaPage>> readPhysicalPage(DWALPager* self,
+	                                                           PhysicalPageID pageID,
+	                                                           int priority,
+	                                                           bool header) {
+		ASSERT(!self->memoryOnly);
+
+		state Reference<ArenaPage> page =
+		    header ? makeReference<ArenaPage>(smallestPhysicalBlock, smallestPhysicalBlock) : self->newPageBuffer();
+		state bool useSecondary = !header && self->secondaryCache.isValid();
+		state uint64_t secondaryGeneration = 0;
+		debug_printf("DWALPager(%s) op=readPhysicalStart %s ptr=%p header=%d\n",
+		             self->filename.c_str(),
+		             toString(pageID).c_str(),
+		             page->rawData(),
+		             header);
+
+		if (useSecondary) {
+			bool hit = wait(self->secondaryCache->read(pageID, page));
+			if (hit) {
+				bool valid = wait(verifySecondaryCopy(self, page, pageID));
+				if (valid) {
+					++g_redwoodMetrics.metric.pagerSecondaryHit;
+					return page;
+				}
+				++g_redwoodMetrics.metric.pagerSecondaryInvalid;
+				self->secondaryCache->invalidate(pageID);
+				page = self->newPageBuffer();
+			}
+			++g_redwoodMetrics.metric.pagerSecondaryMiss;
+			secondaryGeneration = self->secondaryCache->getGeneration(pageID);
+		}
+
+		int readBytes =
+		    wait(readPhysicalBlock(self, page, 0, page->rawSize(), (int64_t)pageID * page->rawSize(), priority));
+		debug_printf("DWALPager(%s) op=readPhysicalDiskReadComplete %s ptr=%p bytes=%d\n",
+		             self->filename.c_str(),
+		             toString(pageID).c_str(),
+		             page->rawData(),
+		             readBytes);
+
+		// The copy is taken before verification, which can decrypt the page in place
+		if (useSecondary && self->secondaryCache.isValid()) {
+			self->secondaryCache->insert(pageID, page, secondaryGeneration);
+		}
+
+		wait(verifyPhysicalPage(self, page, pageID, header));
 		return page;
 	}
 
@@ -2874,9 +3224,16 @@ public:
 		// TODO:  Could a dispatched read try to write to page after it has been destroyed if this actor is cancelled?
 		state int blockSize = self->physicalPageSize;
 		std::vector<Future<int>> reads;
-		for (int i = 0; i < pageIDs.size(); ++i) {
-			reads.push_back(
-			    readPhysicalBlock(self, page, i * blockSize, blockSize, ((int64_t)pageIDs[i]) * blockSize, priority));
+		// Blocks that are physically adjacent are read with a single disk read
+		for (int i = 0; i < pageIDs.size();) {
+			int blocks = 1;
+			while (i + blocks < pageIDs.size() && pageIDs[i + blocks] == pageIDs[i] + blocks) {
+				++blocks;
+			}
+			reads.push_back(readPhysicalBlock(
+			    self, page, i * blockSize, blocks * blockSize, ((int64_t)pageIDs[i]) * blockSize, priority));
+			g_redwoodMetrics.metric.pagerDiskReadCoalesced += blocks - 1;
+			i += blocks;
 		}
 		// wait for all the parallel read futures
 		wait(waitForAll(reads));
@@ -2929,6 +3286,38 @@ public:
 		return page;
 	}
 
+	// Read count physically adjacent pages starting at firstPageID into one buffer with a single disk read
+	ACTOR static Future<Reference<ArenaPage>> readPhysicalPageRun(DWALPager* self,
+	                                                              PhysicalPageID firstPageID,
+	                                                              int count,
+	                                                              int priority) {
+		ASSERT(!self->memoryOnly);
+		state Reference<ArenaPage> buffer = self->newPageBuffer(count);
+		debug_printf("DWALPager(%s) op=readPhysicalRunStart %s count=%d\n",
+		             self->filename.c_str(),
+		             toString(firstPageID).c_str(),
+		             count);
+		wait(success(readPhysicalBlock(self,
+		                               buffer,
+		                               0,
+		                               count * self->physicalPageSize,
+		                               (int64_t)firstPageID * self->physicalPageSize,
+		                               priority)));
+		return buffer;
+	}
+
+	// Returns the page at index within a run read by readPhysicalPageRun()
+	ACTOR static Future<Reference<ArenaPage>> readPhysicalPageFromRun(DWALPager* self,
+	                                                                  Future<Reference<ArenaPage>> run,
+	                                                                  int index,
+	                                                                  PhysicalPageID pageID) {
+		state Reference<ArenaPage> page = self->newPageBuffer();
+		Reference<ArenaPage> buffer = wait(run);
+		memcpy(page->rawData(), buffer->rawData() + index * self->physicalPageSize, self->physicalPageSize);
+		wait(verifyPhysicalPage(self, page, pageID, false));
+		return page;
+	}
+
 	Future<Reference<ArenaPage>> readHeaderPage(PhysicalPageID pageID) {
 		debug_printf("DWALPager(%s) readHeaderPage %s\n", filename.c_str(), toString(pageID).c_str());
 		return readPhysicalPage(this, pageID, ioMaxPriority, true);
@@ -3035,6 +3424,58 @@ public:
 		return cacheEntry.readFuture;
 	}
 
+	void preLoadPages(PagerEventReasons reason,
+	                  unsigned int level,
+	                  VectorRef<PhysicalPageID> pageIDs,
+	                  int priority) override {
+		// Every page of a memory only pager is in the cache
+		if (memoryOnly) {
+			return;
+		}
+
+		std::vector<PhysicalPageID> toRead;
+		for (PhysicalPageID id : pageIDs) {
+			if (!pageCache.exists(id)) {
+				toRead.push_back(id);
+			}
+		}
+		std::sort(toRead.begin(), toRead.end());
+		toRead.erase(std::unique(toRead.begin(), toRead.end()), toRead.end());
+
+		auto& eventReasons = g_redwoodMetrics.level(level).metrics.events;
+		const int maxRun = std::max(1, SERVER_KNOBS->REDWOOD_PREFETCH_MAX_COALESCED_PAGES);
+		for (int i = 0; i < toRead.size();) {
+			int count = 1;
+			while (i + count < toRead.size() && count < maxRun && toRead[i + count] == toRead[i] + count) {
+				++count;
+			}
+
+			if (count == 1) {
+				readPage(reason, level, toRead[i], priority, true, true);
+			} else {
+				debug_printf("DWALPager(%s) op=preLoadRun %s count=%d\n",
+				             filename.c_str(),
+				             toString(toRead[i]).c_str(),
+				             count);
+				Future<Reference<ArenaPage>> run = readPhysicalPageRun(this, toRead[i], count, priority);
+				for (int j = 0; j < count; ++j) {
+					eventReasons.addEventReason(PagerEvents::CacheLookup, reason);
+					PageCacheEntry& cacheEntry = pageCache.get(toRead[i + j], physicalPageSize, true);
+					if (!cacheEntry.initialized()) {
+						cacheEntry.readFuture =
+						    forwardError(readPhysicalPageFromRun(this, run, j, toRead[i + j]), errorPromise);
+						cacheEntry.writeFuture = Void();
+
+						++g_redwoodMetrics.metric.pagerCacheMiss;
+						eventReasons.addEventReason(PagerEvents::CacheMiss, reason);
+					}
+				}
+				g_redwoodMetrics.metric.pagerDiskReadCoalesced += count - 1;
+			}
+			i += count;
+		}
+	}
+
 	PhysicalPageID getPhysicalPageID(LogicalPageID pageID, Version v) {
 		auto i = remappedPages.find(pageID);
 
@@ -3075,6 +3516,19 @@ public:
 		return readPage(reason, level, physicalID, priority, cacheable, noHit);
 	}
 
+	void preLoadPagesAtVersion(PagerEventReasons reason,
+	                           unsigned int level,
+	                           VectorRef<LogicalPageID> logicalIDs,
+	                           int priority,
+	                           Version v) {
+		Standalone<VectorRef<PhysicalPageID>> physicalIDs;
+		physicalIDs.reserve(physicalIDs.arena(), logicalIDs.size());
+		for (LogicalPageID id : logicalIDs) {
+			physicalIDs.push_back(physicalIDs.arena(), getPhysicalPageID(id, v));
+		}
+		preLoadPages(reason, level, physicalIDs, priority);
+	}
+
 	void releaseExtentReadLock() override { concurrentExtentReads->release(); }
 
 	// Read the physical extent at given pageID
@@ -3391,6 +3845,27 @@ public:
 		return Void();
 	}
 
+	ACTOR static Future<Void> countRemapCleanupCopy(DWALPager* self, Future<Void> copy) {
+		++self->remapCleanupThrottle->inProgress;
+		try {
+			wait(copy);
+		} catch (Error& e) {
+			--self->remapCleanupThrottle->inProgress;
+			throw;
+		}
+		--self->remapCleanupThrottle->inProgress;
+		self->remapCleanupThrottle->changed.trigger();
+		return Void();
+	}
+
+	ACTOR static Future<Void> updateRemapCleanupThrottle(DWALPager* self) {
+		loop {
+			wait(delay(SERVER_KNOBS->REDWOOD_REMAP_CLEANUP_THROTTLE_INTERVAL));
+			self->remapCleanupThrottle->update(self->ioLock->getWaitersCount(), self->ioLock->getRunnersCount());
+			self->remapCleanupThrottle->changed.trigger();
+		}
+	}
+
 	ACTOR static Future<Void> remapCleanup(DWALPager* self) {
 		state ActorCollection tasks(true);
 		state Promise<Void> signal;
@@ -3429,6 +3904,9 @@ public:
 			self->remapDestinationsSimOnly.clear();
 		}
 
+		state Future<Void> throttleUpdater =
+		    self->remapCleanupThrottle->enabled() ? updateRemapCleanupThrottle(self) : Never();
+
 		state int sinceYield = 0;
 		loop {
 			// Stop if we have cleanup enough remap entries, or if the stop flag is set and the remaining remap
@@ -3461,9 +3939,18 @@ public:
 
 			Future<Void> task = removeRemapEntry(self, p.get(), oldestRetainedVersion);
 			if (!task.isReady()) {
+				if (self->remapCleanupThrottle->enabled()) {
+					task = countRemapCleanupCopy(self, task);
+				}
 				tasks.add(task);
 			}
 
+			while (self->remapCleanupThrottle->inProgress >= self->remapCleanupThrottle->limit &&
+			       self->remapCleanupThrottle->enabled()) {
+				++g_redwoodMetrics.metric.pagerRemapThrottled;
+				wait(self->remapCleanupThrottle->changed.onTrigger());
+			}
+
 			// Yield to prevent slow task in case no IO waits are encountered
 			if (++sinceYield >= 100) {
 				sinceYield = 0;
@@ -3647,6 +4134,10 @@ public:
 
 		// Unreference the file and clear
 		self->pageFile.clear();
+		if (self->secondaryCache.isValid()) {
+			self->secondaryCache.clear();
+			wait(IAsyncFileSystem::filesystem()->deleteFile(self->getSecondaryCacheFilename(), true));
+		}
 		if (dispose) {
 			if (!self->memoryOnly) {
 				debug_printf("DWALPager(%s) shutdown deleting file\n", self->filename.c_str());
@@ -3887,6 +4378,7 @@ private:
 	bool remapCleanupStop;
 
 	Reference<IAsyncFile> pageFile;
+	Reference<SecondaryPageCache> secondaryCache;
 
 	LogicalPageQueueT freeList;
 
@@ -3899,6 +4391,8 @@ private:
 	ExtentUsedListQueueT extentUsedList;
 	uint64_t remapCleanupWindowBytes;
 	Reference<FlowLock> concurrentExtentReads;
+	// Shared with reads, which can outlive the pager
+	Reference<RemapCleanupThrottle> remapCleanupThrottle;
 	std::unordered_set<PhysicalPageID> remapDestinationsSimOnly;
 
 	struct SnapshotEntry {
@@ -3948,6 +4442,13 @@ public:
 		           [=](Reference<ArenaPage> p) { return Reference<const ArenaPage>(std::move(p)); });
 	}
 
+	void preLoadPages(PagerEventReasons reason,
+	                  unsigned int level,
+	                  VectorRef<LogicalPageID> pageIDs,
+	                  int priority) override {
+		pager->preLoadPagesAtVersion(reason, level, pageIDs, priority, version);
+	}
+
 	Key getMetaKey() const override { return metaKey; }
 
 	Version getVersion() const override { return version; }
@@ -4145,6 +4646,16 @@ struct RedwoodRecordRef {
 		return skipLen + commonPrefixLength(key, other.key, skipLen);
 	}
 
+	// The first 8 bytes of the key as a big endian integer, zero padded, so that keys which differ within them order
+	// the same way as their prefixes
+	uint64_t fencePrefix() const {
+		uint64_t prefix = 0;
+		if (key.size() > 0) {
+			memcpy(&prefix, key.begin(), std::min(key.size(), (int)sizeof(prefix)));
+		}
+		return bigEndian64(prefix);
+	}
+
 	// Compares and orders by key, version, chunk.total, chunk.start, value
 	// This is the same order that delta compression uses for prefix borrowing
 	int compare(const RedwoodRecordRef& rhs, int skip = 0) const {
@@ -4640,6 +5151,43 @@ struct BTreePage {
 	}
 };
 
+// Payload of a BTree node page written with a pageFormat of CompressedBTreePage::format.  The node's BTreePage is
+// stored compressed and is expanded into a page of logicalBlocks blocks before it is read or modified.
+struct CompressedBTreePage {
+	static constexpr uint8_t format = 1;
+
+#pragma pack(push, 1)
+	struct {
+		uint8_t filter; // CompressionFilter
+		uint16_t logicalBlocks;
+		uint32_t uncompressedSize;
+		uint32_t compressedSize;
+	};
+#pragma pack(pop)
+
+	uint8_t* data() const { return (uint8_t*)(this + 1); }
+};
+
+// The expanded form of a compressed BTree node, kept as the extra object of the cached compressed page.  Its size is
+// charged to the page cache while it exists.
+struct ExpandedBTreePage : ReferenceCounted<ExpandedBTreePage>, FastAllocated<ExpandedBTreePage> {
+	ExpandedBTreePage(Reference<ArenaPage> page, int64_t* pMemoryTracker)
+	  : page(page), pMemoryTracker(pMemoryTracker) {
+		if (pMemoryTracker != nullptr) {
+			*pMemoryTracker += page->rawSize();
+		}
+	}
+
+	~ExpandedBTreePage() {
+		if (pMemoryTracker != nullptr) {
+			*pMemoryTracker -= page->rawSize();
+		}
+	}
+
+	Reference<ArenaPage> page;
+	int64_t* pMemoryTracker;
+};
+
 struct BoundaryRefAndPage {
 	Standalone<RedwoodRecordRef> lowerBound;
 	Reference<ArenaPage> firstPage;
@@ -4839,6 +5387,96 @@ public:
 	}
 };
 
+// Bloom filters of the keys in recently written leaf nodes, kept in memory by the node's first logical page ID, so that
+// point reads of absent keys can be answered without reading the leaf.  A filter describes the node as it was written
+// at the filter's version, so it is only used by reads at that version or later.  The node must be erased from the
+// cache whenever it is modified or freed, and replaced when it is rewritten.
+class LeafFilterCache {
+public:
+	enum class Result { NoFilter, Absent, MayContain };
+
+	LeafFilterCache(int64_t capacityBytes, int bitsPerKey)
+	  : capacityBytes(capacityBytes), bitsPerKey(std::max(bitsPerKey, 1)),
+	    numHashes(std::clamp((int)(bitsPerKey * 0.69 + 0.5), 1, 16)) {}
+
+	bool enabled() const { return capacityBytes > 0; }
+
+	// Sets the filter of the node at id, as written at version v with the records from begin to end
+	void insert(LogicalPageID id, Version v, const RedwoodRecordRef* begin, const RedwoodRecordRef* end) {
+		if (!enabled()) {
+			return;
+		}
+		erase(id);
+
+		Entry& e = entries[id];
+		e.version = v;
+		e.bits.assign((std::max<int64_t>(64, (end - begin) * bitsPerKey) + 7) / 8, 0);
+		const uint32_t numBits = e.bits.size() * 8;
+		for (const RedwoodRecordRef* r = begin; r != end; ++r) {
+			uint64_t h = XXH3_64bits(r->key.begin(), r->key.size());
+			uint32_t h1 = h, h2 = (h >> 32) | 1;
+			for (int i = 0; i < numHashes; ++i) {
+				uint32_t bit = (h1 + i * h2) % numBits;
+				e.bits[bit / 8] |= 1 << (bit % 8);
+			}
+		}
+		e.lru = lru.insert(lru.end(), id);
+		bytes += e.bits.size();
+
+		while (bytes > capacityBytes) {
+			erase(lru.front());
+		}
+	}
+
+	// Returns whether key can be in the node at id as of version v, if the node has a filter that such a read can use
+	Result lookup(LogicalPageID id, Version v, KeyRef key) {
+		auto it = entries.find(id);
+		if (it == entries.end() || v < it->second.version) {
+			return Result::NoFilter;
+		}
+		Entry& e = it->second;
+		lru.splice(lru.end(), lru, e.lru);
+
+		const uint32_t numBits = e.bits.size() * 8;
+		uint64_t h = XXH3_64bits(key.begin(), key.size());
+		uint32_t h1 = h, h2 = (h >> 32) | 1;
+		for (int i = 0; i < numHashes; ++i) {
+			uint32_t bit = (h1 + i * h2) % numBits;
+			if (!(e.bits[bit / 8] & (1 << (bit % 8)))) {
+				return Result::Absent;
+			}
+		}
+		return Result::MayContain;
+	}
+
+	void erase(LogicalPageID id) {
+		auto it = entries.find(id);
+		if (it != entries.end()) {
+			bytes -= it->second.bits.size();
+			lru.erase(it->second.lru);
+			entries.erase(it);
+		}
+	}
+
+	int64_t getBytes() const { return bytes; }
+	int size() const { return entries.size(); }
+
+private:
+	struct Entry {
+		Version version;
+		std::vector<uint8_t> bits;
+		std::list<LogicalPageID>::iterator lru;
+	};
+
+	int64_t capacityBytes;
+	int bitsPerKey;
+	int numHashes;
+	int64_t bytes = 0;
+	std::unordered_map<LogicalPageID, Entry> entries;
+	// Least recently used first
+	std::list<LogicalPageID> lru;
+};
+
 class VersionedBTree {
 public:
 	// The first possible internal record possible in the tree
@@ -4964,6 +5602,7 @@ public:
 	// Set key to value as of the next commit
 	// The new value is not readable until after the next commit is completed.
 	void set(KeyValueRef keyValue) {
+		ASSERT(!m_pendingBulkLoad.present());
 		++m_mutationCount;
 		++g_redwoodMetrics.metric.opSet;
 		g_redwoodMetrics.metric.opSetKeyBytes += keyValue.key.size();
@@ -4972,6 +5611,7 @@ public:
 	}
 
 	void clear(KeyRangeRef clearedRange) {
+		ASSERT(!m_pendingBulkLoad.present());
 		++m_mutationCount;
 		// Optimization for single key clears to create just one mutation boundary instead of two
 		if (clearedRange.begin.size() == clearedRange.end.size() - 1 &&
@@ -4991,12 +5631,26 @@ public:
 		m_pBuffer->erase(iBegin, iEnd);
 	}
 
+	// Sets the contents of the tree, which must be empty, to records as of the next commit.  The records must have
+	// values and be sorted by key with no duplicates.  Instead of applying them through the mutation buffer, the commit
+	// writes them into full leaf pages and builds the internal levels from the bottom up.  No other mutations can be
+	// made before that commit.
+	void bulkLoad(Standalone<VectorRef<RedwoodRecordRef>> records) {
+		ASSERT(m_mutationCount == 0 && !m_pendingBulkLoad.present());
+		m_mutationCount += records.size();
+		g_redwoodMetrics.metric.opBulkLoadRecords += records.size();
+		m_pendingBulkLoad = records;
+	}
+
 	void setOldestReadableVersion(Version v) { m_newOldestVersion = v; }
 
 	Version getOldestReadableVersion() const { return m_pager->getOldestReadableVersion(); }
 
 	Version getLastCommittedVersion() const { return m_pager->getLastCommittedVersion(); }
 
+	// Holding the returned snapshot keeps version readable, as long as it is readable when this is called
+	Reference<IPagerSnapshot> getReadSnapshot(Version version) { return m_pager->getReadSnapshot(version); }
+
 	// VersionedBTree takes ownership of pager
 	VersionedBTree(IPager2* pager,
 	               std::string name,
@@ -5007,8 +5661,21 @@ public:
 	               Reference<IPageEncryptionKeyProvider> keyProvider = {})
 	  : m_pager(pager), m_db(db), m_expectedEncryptionMode(expectedEncryptionMode), m_encodingType(encodingType),
 	    m_enforceEncodingType(false), m_keyProvider(keyProvider), m_pBuffer(nullptr), m_mutationCount(0), m_name(name),
-	    m_logID(logID), m_pBoundaryVerifier(DecodeBoundaryVerifier::getVerifier(name)) {
+	    m_logID(logID), m_pBoundaryVerifier(DecodeBoundaryVerifier::getVerifier(name)),
+	    m_leafFilters(SERVER_KNOBS->REDWOOD_LEAF_FILTER_CACHE_BYTES, SERVER_KNOBS->REDWOOD_LEAF_FILTER_BITS_PER_KEY) {
 		m_pDecodeCacheMemory = m_pager->getPageCachePenaltySource();
+		m_compressionFilter = CompressionUtils::fromFilterString(SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION_FILTER);
+		CompressionUtils::checkFilterSupported(m_compressionFilter);
+		m_compressedLeafBlocks = m_compressionFilter == CompressionFilter::NONE
+		                             ? 1
+		                             : std::max(1, SERVER_KNOBS->REDWOOD_COMPRESSED_LEAF_BLOCKS);
+		if (SERVER_KNOBS->REDWOOD_PAGE_BUILD_THREADS > 0) {
+			m_pageBuildPool =
+			    g_network->isSimulated() ? CoroThreadPool::createThreadPool() : createGenericThreadPool();
+			for (int i = 0; i < SERVER_KNOBS->REDWOOD_PAGE_BUILD_THREADS; ++i) {
+				m_pageBuildPool->addThread(new PageBuilder(), "fdb-redwood-build");
+			}
+		}
 		m_lazyClearActor = 0;
 		m_init = init_impl(this);
 		m_latestCommit = m_init;
@@ -5315,6 +5982,11 @@ public:
 	Future<Void> init() { return m_init; }
 
 	virtual ~VersionedBTree() {
+		// Wait for any page build running on a worker thread to finish
+		if (m_pageBuildPool) {
+			m_pageBuildPool->stop();
+		}
+
 		// DecodeBoundaryVerifier objects outlive simulated processes.
 		// Thus, if we did not clear the key providers here, each DecodeBoundaryVerifier object might
 		// maintain references to untracked peers through its key provider. This would result in
@@ -5606,6 +6278,64 @@ private:
 	// Counter to update with DecodeCache memory usage
 	int64_t* m_pDecodeCacheMemory = nullptr;
 
+	// Compression applied to leaf nodes as they are written, and the number of blocks leaf nodes are built to fill
+	// before compression
+	CompressionFilter m_compressionFilter;
+	int m_compressedLeafBlocks;
+
+	// Builds the DeltaTrees of new pages on worker threads, so that the network thread is free to serve reads and to
+	// work on other subtrees of the commit meanwhile.  Null if pages are built on the network thread.
+	Reference<IThreadPool> m_pageBuildPool;
+
+	struct PageBuilder : IThreadPoolReceiver {
+		void init() override {}
+
+		// The action owns the page and copies of the records going into it, so that it does not depend on memory which
+		// the commit would free if it were cancelled while the page is being built.
+		struct BuildAction final : TypedAction<PageBuilder, BuildAction>, FastAllocated<BuildAction> {
+			Reference<ArenaPage> page;
+			Standalone<VectorRef<RedwoodRecordRef>> entries;
+			RedwoodRecordRef lowerBound;
+			RedwoodRecordRef upperBound;
+			// The page, and the size of the tree built in it
+			ThreadReturnPromise<std::pair<Reference<ArenaPage>, ErrorOr<int>>> result;
+
+			double getTimeEstimate() const override { return 0; }
+		};
+
+		void action(BuildAction& a) {
+			ErrorOr<int> written;
+			try {
+				BTreePage* btPage = (BTreePage*)a.page->mutateData();
+				written = btPage->tree()->build(a.page->dataSize() - sizeof(BTreePage),
+				                                a.entries.begin(),
+				                                a.entries.end(),
+				                                &a.lowerBound,
+				                                &a.upperBound);
+			} catch (Error& e) {
+				written = e;
+			}
+			// Hand the only reference to the page back, so it is never released on this thread
+			a.result.send(std::make_pair(std::move(a.page), written));
+		}
+	};
+
+	// Builds the DeltaTree of an initialized BTreePage from count records starting at begin on a worker thread
+	Future<std::pair<Reference<ArenaPage>, ErrorOr<int>>> buildPageOnWorker(Reference<ArenaPage> page,
+	                                                                      const RedwoodRecordRef* begin,
+	                                                                      int count,
+	                                                                      const RedwoodRecordRef& lowerBound,
+	                                                                      const RedwoodRecordRef& upperBound) {
+		auto* action = new PageBuilder::BuildAction();
+		action->entries.append_deep(action->entries.arena(), begin, count);
+		action->lowerBound = RedwoodRecordRef(action->entries.arena(), lowerBound);
+		action->upperBound = RedwoodRecordRef(action->entries.arena(), upperBound);
+		action->page = std::move(page);
+		auto result = action->result.getFuture();
+		m_pageBuildPool->post(action);
+		return result;
+	}
+
 	// The mutation buffer currently being written to
 	std::unique_ptr<MutationBuffer> m_pBuffer;
 	int64_t m_mutationCount;
@@ -5617,6 +6347,7 @@ private:
 		Version newOldestVersion;
 		std::unique_ptr<MutationBuffer> mutations;
 		int64_t mutationCount;
+		Optional<Standalone<VectorRef<RedwoodRecordRef>>> bulkLoad;
 		Reference<IPagerSnapshot> snapshot;
 	};
 
@@ -5624,6 +6355,8 @@ private:
 	Future<Void> m_latestCommit;
 	Future<Void> m_init;
 	std::string m_name;
+	// Records to load into the empty tree at the next commit
+	Optional<Standalone<VectorRef<RedwoodRecordRef>>> m_pendingBulkLoad;
 	UID m_logID;
 	int m_blockSize;
 	ParentInfoMapT childUpdateTracker;
@@ -5633,28 +6366,39 @@ private:
 	Future<int> m_lazyClearActor;
 	bool m_lazyClearStop;
 
+	// Filters of recently written leaves, checked by point reads before reading a leaf
+	LeafFilterCache m_leafFilters;
+
 	// Describes a range of a vector of records that should be built into a single BTreePage
 	struct PageToBuild {
 		PageToBuild(int index,
 		            int blockSize,
+		            int initialBlockCount,
 		            EncodingType encodingType,
 		            unsigned int height,
 		            bool enableEncryptionDomain,
 		            bool splitByDomain,
 		            IPageEncryptionKeyProvider* keyProvider)
-		  : startIndex(index), count(0), pageSize(blockSize),
-		    largeDeltaTree(pageSize > BTreePage::BinaryTree::SmallSizeLimit), blockSize(blockSize), blockCount(1),
-		    kvBytes(0), encodingType(encodingType), height(height), enableEncryptionDomain(enableEncryptionDomain),
-		    splitByDomain(splitByDomain), keyProvider(keyProvider) {
+		  : startIndex(index), count(0), pageSize(blockSize * initialBlockCount),
+		    largeDeltaTree(pageSize > BTreePage::BinaryTree::SmallSizeLimit), blockSize(blockSize),
+		    blockCount(initialBlockCount), initialBlockCount(initialBlockCount), kvBytes(0), encodingType(encodingType),
+		    height(height), enableEncryptionDomain(enableEncryptionDomain), splitByDomain(splitByDomain),
+		    keyProvider(keyProvider) {
 
 			// Subtrace Page header overhead, BTreePage overhead, and DeltaTree (BTreePage::BinaryTree) overhead.
 			bytesLeft =
-			    ArenaPage::getUsableSize(blockSize, encodingType) - sizeof(BTreePage) - sizeof(BTreePage::BinaryTree);
+			    ArenaPage::getUsableSize(pageSize, encodingType) - sizeof(BTreePage) - sizeof(BTreePage::BinaryTree);
 		}
 
 		PageToBuild next() {
-			return PageToBuild(
-			    endIndex(), blockSize, encodingType, height, enableEncryptionDomain, splitByDomain, keyProvider);
+			return PageToBuild(endIndex(),
+			                   blockSize,
+			                   initialBlockCount,
+			                   encodingType,
+			                   height,
+			                   enableEncryptionDomain,
+			                   splitByDomain,
+			                   keyProvider);
 		}
 
 		int startIndex; // Index of the first record
@@ -5665,6 +6409,7 @@ private:
 		bool largeDeltaTree; // Whether or not the tree in the generated page is in the 'large' size range
 		int blockSize; // Base block size by which pageSize can be incremented
 		int blockCount; // The number of blocks in pageSize
+		int initialBlockCount; // The number of blocks the page starts with, more than 1 if it will be compressed
 		int kvBytes; // The amount of user key/value bytes added to the page
 
 		EncodingType encodingType;
@@ -5872,8 +6617,16 @@ private:
 			deltaSizes[i] = records[i].deltaSize(records[i - 1], prefixLen, true);
 		}
 
-		PageToBuild p(
-		    0, m_blockSize, m_encodingType, height, enableEncryptionDomain, splitByDomain, m_keyProvider.getPtr());
+		// Leaves that will be compressed are built to fill several blocks so that compression can reduce the number of
+		// blocks written
+		PageToBuild p(0,
+		              m_blockSize,
+		              height == 1 ? m_compressedLeafBlocks : 1,
+		              m_encodingType,
+		              height,
+		              enableEncryptionDomain,
+		              splitByDomain,
+		              m_keyProvider.getPtr());
 
 		for (int i = 0; i < records.size();) {
 			bool force = p.count < minRecords || p.slackFraction() > maxSlack;
@@ -6068,13 +6821,24 @@ private:
 			             pageLowerBound.toString(false).c_str(),
 			             pageUpperBound.toString(false).c_str());
 
-			int deltaTreeSpace = page->dataSize() - sizeof(BTreePage);
+			state int deltaTreeSpace = page->dataSize() - sizeof(BTreePage);
 			debug_printf("Building tree at %p deltaTreeSpace %d p.usedBytes=%d\n",
 			             btPage->tree(),
 			             deltaTreeSpace,
 			             p->usedBytes());
-			state int written = btPage->tree()->build(
-			    deltaTreeSpace, &entries[p->startIndex], &entries[p->endIndex()], &pageLowerBound, &pageUpperBound);
+			state int written;
+			if (self->m_pageBuildPool) {
+				std::pair<Reference<ArenaPage>, ErrorOr<int>> built = wait(self->buildPageOnWorker(
+				    std::move(page), &entries[p->startIndex], p->count, pageLowerBound, pageUpperBound));
+				page = std::move(built.first);
+				if (built.second.isError()) {
+					throw built.second.getError();
+				}
+				written = built.second.get();
+			} else {
+				written = btPage->tree()->build(
+				    deltaTreeSpace, &entries[p->startIndex], &entries[p->endIndex()], &pageLowerBound, &pageUpperBound);
+			}
 
 			if (written > deltaTreeSpace) {
 				debug_printf("ERROR:  Wrote %d bytes to page %s deltaTreeSpace=%d\n",
@@ -6097,9 +6861,12 @@ private:
 			// Write this btree page, which is made of 1 or more pager pages.
 			state BTreeNodeLinkRef childPageID;
 
+			page = self->compressPage(page, height);
+			state int blockCount = self->getBlockCount(page.getPtr());
+
 			// If we are only writing 1 BTree node and its block count is 1 and the original node also had 1 block
 			// then try to update the page atomically so its logical page ID does not change
-			if (pagesToBuild.size() == 1 && p->blockCount == 1 && previousID.size() == 1) {
+			if (pagesToBuild.size() == 1 && blockCount == 1 && previousID.size() == 1) {
 				page->setLogicalPageInfo(previousID.front(), parentID);
 				LogicalPageID id = wait(
 				    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, previousID.front(), page, v));
@@ -6133,7 +6900,7 @@ private:
 					self->freeBTreePage(height, previousID, v);
 				}
 
-				childPageID.resize(records.arena(), p->blockCount);
+				childPageID.resize(records.arena(), blockCount);
 				state int i = 0;
 				for (i = 0; i < childPageID.size(); ++i) {
 					LogicalPageID id = wait(self->m_pager->newPageID());
@@ -6146,6 +6913,11 @@ private:
 				self->m_pager->updatePage(PagerEventReasons::Commit, height, childPageID, page);
 			}
 
+			if (height == 1) {
+				self->m_leafFilters.insert(
+				    childPageID.front(), v, entries.begin() + p->startIndex, entries.begin() + p->endIndex());
+			}
+
 			if (self->m_pBoundaryVerifier != nullptr) {
 				ASSERT(self->m_pBoundaryVerifier->update(
 				    childPageID, v, pageLowerBound.key, pageUpperBound.key, height, p->domainId));
@@ -6257,6 +7029,7 @@ private:
 			page = std::move(p);
 		}
 		debug_printf("readPage() op=readComplete %s @%" PRId64 " \n", toString(id).c_str(), snapshot->getVersion());
+		page = self->expandPage(page);
 		const BTreePage* btPage = (const BTreePage*)page->data();
 		auto& metrics = g_redwoodMetrics.level(btPage->height).metrics;
 		metrics.pageRead += 1;
@@ -6320,6 +7093,12 @@ private:
 		}
 	}
 
+	// Start reading single page nodes into the page cache, with physically adjacent pages read together
+	static void preLoadPages(IPagerSnapshot* snapshot, VectorRef<LogicalPageID> pageIDs, int priority) {
+		g_redwoodMetrics.metric.btreeLeafPreload += pageIDs.size();
+		snapshot->preLoadPages(PagerEventReasons::RangePrefetch, nonBtreeLevel, pageIDs, priority);
+	}
+
 	void freeBTreePage(int height, BTreeNodeLinkRef btPageID, Version v) {
 		// Free individual pages at v
 		for (LogicalPageID id : btPageID) {
@@ -6330,6 +7109,9 @@ private:
 		if (height > 1 && !btPageID.empty()) {
 			childUpdateTracker.erase(btPageID.front());
 		}
+		if (height == 1 && !btPageID.empty()) {
+			m_leafFilters.erase(btPageID.front());
+		}
 	}
 
 	// Write new version of pageID at version v using page as its data.
@@ -6343,7 +7125,6 @@ private:
 	                                                      Reference<ArenaPage> page,
 	                                                      Version writeVersion) {
 		state BTreeNodeLinkRef newID;
-		newID.resize(*arena, oldID.size());
 
 		if (REDWOOD_DEBUG) {
 			const BTreePage* btPage = (const BTreePage*)page->mutateData();
@@ -6360,7 +7141,18 @@ private:
 		}
 
 		state unsigned int height = (unsigned int)((const BTreePage*)page->data())->height;
-		if (oldID.size() == 1) {
+
+		// The filter of a leaf does not cover the records added to it in place
+		if (height == 1) {
+			self->m_leafFilters.erase(oldID.front());
+		}
+
+		// An expanded compressed page is larger than the node it was read from, so it is compressed again and the
+		// number of blocks written can change
+		page = self->compressPage(page, height);
+		newID.resize(*arena, self->getBlockCount(page.getPtr()));
+
+		if (oldID.size() == 1 && newID.size() == 1) {
 			page->setLogicalPageInfo(oldID.front(), parentID);
 			LogicalPageID id = wait(
 			    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, oldID.front(), page, writeVersion));
@@ -6369,7 +7161,7 @@ private:
 		}
 
 		state int i = 0;
-		for (i = 0; i < oldID.size(); ++i) {
+		for (i = 0; i < newID.size(); ++i) {
 			LogicalPageID id = wait(self->m_pager->newPageID());
 			newID[i] = id;
 		}
@@ -6390,6 +7182,93 @@ private:
 		return newID;
 	}
 
+	// Returns the number of blocks in a page buffer
+	int getBlockCount(const ArenaPage* page) const { return page->rawSize() / m_pager->getPhysicalPageSize(); }
+
+	// Returns a new page holding the BTreePage of a leaf page compressed, or the page itself if compression is
+	// disabled or would not reduce the number of blocks the page is written to
+	Reference<ArenaPage> compressPage(Reference<ArenaPage> page, unsigned int height) {
+		int blocks = getBlockCount(page.getPtr());
+		if (height != 1 || m_compressionFilter == CompressionFilter::NONE || blocks == 1) {
+			return page;
+		}
+
+		const BTreePage* btPage = (const BTreePage*)page->data();
+		Arena arena;
+		StringRef compressed =
+		    CompressionUtils::compress(m_compressionFilter, StringRef(page->data(), btPage->size()), arena);
+
+		EncodingType encodingType = page->getEncodingType();
+		int compressedPageSize = sizeof(CompressedBTreePage) + compressed.size();
+		int newBlocks = 1;
+		while (newBlocks < blocks &&
+		       ArenaPage::getUsableSize(newBlocks * m_blockSize, encodingType) < compressedPageSize) {
+			++newBlocks;
+		}
+		if (newBlocks == blocks) {
+			return page;
+		}
+
+		Reference<ArenaPage> newPage = m_pager->newPageBuffer(newBlocks);
+		newPage->init(encodingType,
+		              (newBlocks == 1) ? PageType::BTreeNode : PageType::BTreeSuperNode,
+		              height,
+		              CompressedBTreePage::format);
+		newPage->encryptionKey = page->encryptionKey;
+
+		CompressedBTreePage* c = (CompressedBTreePage*)newPage->mutateData();
+		c->filter = (uint8_t)m_compressionFilter;
+		c->logicalBlocks = blocks;
+		c->uncompressedSize = btPage->size();
+		c->compressedSize = compressed.size();
+		memcpy(c->data(), compressed.begin(), compressed.size());
+		memset(newPage->mutateData() + compressedPageSize, 0, newPage->dataSize() - compressedPageSize);
+
+		// The page being compressed is what the new page expands to, so it does not need to be decompressed while cached
+		newPage->extra = makeReference<ExpandedBTreePage>(page, m_pDecodeCacheMemory);
+
+		++g_redwoodMetrics.metric.btreePageCompress;
+		g_redwoodMetrics.metric.btreePageCompressSavedBlocks += blocks - newBlocks;
+		return newPage;
+	}
+
+	// Returns the expanded page for a compressed BTree node, or page itself if it is not compressed.  The expanded
+	// page is kept with the compressed page so that a cached page is only decompressed once.
+	Reference<const ArenaPage> expandPage(Reference<const ArenaPage> page) {
+		if (page->getPageFormat() != CompressedBTreePage::format) {
+			return page;
+		}
+		if (page->extra.valid()) {
+			return page->extra.getPtr<ExpandedBTreePage>()->page;
+		}
+
+		const CompressedBTreePage* c = (const CompressedBTreePage*)page->data();
+		Arena arena;
+		StringRef data = CompressionUtils::decompress(
+		    (CompressionFilter)c->filter, StringRef(c->data(), c->compressedSize), arena);
+
+		Reference<ArenaPage> expanded = m_pager->newPageBuffer(c->logicalBlocks);
+		if (data.size() != c->uncompressedSize || data.size() > expanded->dataSize()) {
+			TraceEvent(SevError, "RedwoodPageDecompressFailed")
+			    .detail("PhysicalPageID", page->getPhysicalPageID())
+			    .detail("UncompressedSize", c->uncompressedSize)
+			    .detail("DecompressedSize", data.size());
+			throw page_decoding_failed();
+		}
+
+		expanded->init(page->getEncodingType(),
+		               (c->logicalBlocks == 1) ? PageType::BTreeNode : PageType::BTreeSuperNode,
+		               ((const BTreePage*)data.begin())->height);
+		expanded->encryptionKey = page->encryptionKey;
+		memcpy(expanded->mutateData(), data.begin(), data.size());
+		memset(expanded->mutateData() + data.size(), 0, expanded->dataSize() - data.size());
+
+		page->extra = makeReference<ExpandedBTreePage>(expanded, m_pDecodeCacheMemory);
+		++g_redwoodMetrics.metric.btreePageDecompress;
+		g_redwoodMetrics.metric.btreePageDecompressBytes += data.size();
+		return expanded;
+	}
+
 	// Copy page to a new page which shares the same DecodeCache with the old page
 	static Reference<ArenaPage> clonePageForUpdate(Reference<const ArenaPage> page) {
 		Reference<ArenaPage> newPage = page->clone();
@@ -7091,7 +7970,7 @@ private:
 					                                       update->decodeLowerBound,
 					                                       update->decodeUpperBound)));
 
-					update->updatedInPlace(newID, btPage, newID.size() * self->m_blockSize);
+					update->updatedInPlace(newID, btPage, self->getBlockCount(pageCopy.getPtr()) * self->m_blockSize);
 					debug_printf("%s Leaf node updated in-place, returning slice:\n", context.c_str());
 					debug_print(addPrefix(context, update->toString()));
 				}
@@ -7503,6 +8382,42 @@ private:
 		}
 	}
 
+	// Replaces the empty root of the tree with a tree built from the bottom up from the batch's bulk load records,
+	// returning the link to the new root
+	ACTOR static Future<BTreeNodeLink> commitBulkLoad(VersionedBTree* self, CommitBatch* batch) {
+		state BTreeNodeLink oldRoot = self->m_header.root;
+		state Standalone<VectorRef<RedwoodRecordRef>> records = batch->bulkLoad.get();
+		if (records.empty()) {
+			return oldRoot;
+		}
+
+		Reference<const ArenaPage> rootPage = wait(self->readPage(self,
+		                                                           PagerEventReasons::Commit,
+		                                                           self->m_header.height,
+		                                                           batch->snapshot.getPtr(),
+		                                                           oldRoot,
+		                                                           ioMaxPriority,
+		                                                           false,
+		                                                           true));
+		const BTreePage* btPage = (const BTreePage*)rootPage->data();
+		ASSERT(btPage->height == 1 && btPage->tree()->numItems == 0);
+		for (int i = 1; i < records.size(); ++i) {
+			ASSERT(records[i - 1].key < records[i].key);
+		}
+
+		// Leaves are packed as full as the normal page split allows, then each level above is built from the links to
+		// the level below it until there is a single root
+		Standalone<VectorRef<RedwoodRecordRef>> leafLinks = wait(writePages(
+		    self, &dbBegin, &dbEnd, records, 1, batch->writeVersion, BTreeNodeLinkRef(), invalidLogicalPageID));
+		g_redwoodMetrics.metric.opBulkLoadLeaves += leafLinks.size();
+		self->m_header.height = 1;
+		Standalone<VectorRef<RedwoodRecordRef>> rootLinks =
+		    wait(buildNewRootsIfNeeded(self, batch->writeVersion, leafLinks, 1));
+
+		self->freeBTreePage(1, oldRoot, batch->writeVersion);
+		return rootLinks.front().getChildPage();
+	}
+
 	ACTOR static Future<Void> commit_impl(VersionedBTree* self, Version writeVersion, Future<Void> previousCommit) {
 		// Take ownership of the current mutation buffer and make a new one
 		state CommitBatch batch;
@@ -7510,6 +8425,8 @@ private:
 		self->m_pBuffer.reset(new MutationBuffer());
 		batch.mutationCount = self->m_mutationCount;
 		self->m_mutationCount = 0;
+		batch.bulkLoad = std::move(self->m_pendingBulkLoad);
+		self->m_pendingBulkLoad.reset();
 
 		batch.writeVersion = writeVersion;
 		batch.newOldestVersion = self->m_newOldestVersion;
@@ -7547,12 +8464,17 @@ private:
 		all.decodeUpperBound = dbEnd;
 		all.skipLen = 0;
 
-		MutationBuffer::const_iterator mBegin = batch.mutations->upper_bound(all.subtreeLowerBound.key);
-		--mBegin;
-		MutationBuffer::const_iterator mEnd = batch.mutations->lower_bound(all.subtreeUpperBound.key);
+		if (batch.bulkLoad.present()) {
+			BTreeNodeLink newRoot = wait(commitBulkLoad(self, &batch));
+			rootNodeLink = newRoot;
+		} else {
+			MutationBuffer::const_iterator mBegin = batch.mutations->upper_bound(all.subtreeLowerBound.key);
+			--mBegin;
+			MutationBuffer::const_iterator mEnd = batch.mutations->lower_bound(all.subtreeUpperBound.key);
 
-		wait(
-		    commitSubtree(self, &batch, rootNodeLink, invalidLogicalPageID, self->m_header.height, mBegin, mEnd, &all));
+			wait(commitSubtree(
+			    self, &batch, rootNodeLink, invalidLogicalPageID, self->m_header.height, mBegin, mEnd, &all));
+		}
 
 		// If the old root was deleted, write a new empty tree root node and free the old roots
 		if (all.childrenChanged) {
@@ -7779,6 +8701,47 @@ public:
 
 		Future<int> seek(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query); }
 
+		// Seeks cursor to the record with query's key and returns whether there is one.  If there is not, the cursor
+		// is left invalid, and the leaf is not read at all if its filter shows that the key is not in it.
+		ACTOR Future<bool> seekEqual_impl(BTreeCursor* self, RedwoodRecordRef query) {
+			state RedwoodRecordRef internalPageQuery = query.withMaxPageID();
+			state bool filtered = false;
+			self->path.resize(1);
+
+			loop {
+				auto& entry = self->path.back();
+				if (entry.btPage()->isLeaf()) {
+					entry.cursor.seek(query);
+					self->valid =
+					    entry.cursor.valid() && !entry.cursor.isErased() && entry.cursor.get().key == query.key;
+					if (filtered && !self->valid) {
+						++g_redwoodMetrics.metric.btreeLeafFilterFalsePositive;
+					}
+					return self->valid;
+				}
+
+				if (entry.cursor.seekLessThan(internalPageQuery) && entry.cursor.get().value.present()) {
+					if (entry.btPage()->height == 2) {
+						LeafFilterCache::Result r = self->btree->m_leafFilters.lookup(
+						    entry.cursor.get().getChildPage().front(), self->pager->getVersion(), query.key);
+						if (r == LeafFilterCache::Result::Absent) {
+							++g_redwoodMetrics.metric.btreeLeafFilterSkip;
+							self->valid = false;
+							return false;
+						}
+						filtered = r == LeafFilterCache::Result::MayContain;
+					}
+					Future<Void> f = self->pushPage(entry.cursor);
+					wait(f);
+				} else {
+					self->valid = false;
+					return false;
+				}
+			}
+		}
+
+		Future<bool> seekEqual(RedwoodRecordRef query) { return path.empty() ? false : seekEqual_impl(this, query); }
+
 		ACTOR Future<Void> seekGTE_impl(BTreeCursor* self, RedwoodRecordRef query) {
 			debug_printf("seekGTE(%s) start\n", query.toString().c_str());
 			int cmp = wait(self->seek(query));
@@ -7810,6 +8773,10 @@ public:
 			// Use actual KVBytes stored for the first leaf, but use node capacity for siblings below
 			int bytesRead = firstLeaf->kvBytes;
 
+			// Single page siblings are collected and loaded together so that physically adjacent pages can be read with
+			// a single disk read.
+			Standalone<VectorRef<LogicalPageID>> singlePages;
+
 			// Cursor for moving through siblings.
 			// Note that only immediate siblings under the same parent are considered for prefetch so far.
 			BTreePage::BinaryTree::Cursor c = path[path.size() - 2].cursor;
@@ -7837,13 +8804,20 @@ public:
 				// Prefetch the sibling if the link is not null
 				if (c.get().value.present()) {
 					BTreeNodeLinkRef childPage = c.get().getChildPage();
-					if (childPage.size() > 0)
+					if (childPage.size() == 1) {
+						singlePages.push_back(singlePages.arena(), childPage.front());
+					} else if (childPage.size() > 1) {
 						preLoadPage(pager.getPtr(), childPage, ioLeafPriority);
+					}
 					recordsRead += estRecordsPerPage;
 					// Use sibling node capacity as an estimate of bytes read.
 					bytesRead += childPage.size() * this->btree->m_blockSize;
 				}
 			}
+
+			if (!singlePages.empty()) {
+				preLoadPages(pager.getPtr(), singlePages, ioLeafPriority);
+			}
 		}
 
 		ACTOR Future<Void> seekLT_impl(BTreeCursor* self, RedwoodRecordRef query) {
@@ -8074,15 +9048,29 @@ public:
 		m_tree->set(keyValue);
 	}
 
+	// Sets the contents of the store, which must be empty, to sorted key value pairs with unique keys as of the next
+	// commit, writing the pages directly instead of applying each pair as a mutation.  No other mutations can be made
+	// before that commit.
+	void bulkLoad(Standalone<VectorRef<KeyValueRef>> sortedData) {
+		Standalone<VectorRef<RedwoodRecordRef>> records;
+		records.arena().dependsOn(sortedData.arena());
+		records.reserve(records.arena(), sortedData.size());
+		for (const KeyValueRef& kv : sortedData) {
+			records.push_back(records.arena(), RedwoodRecordRef(kv.key, kv.value));
+		}
+		m_tree->bulkLoad(records);
+	}
+
 	Future<RangeResult> readRange(KeyRangeRef keys,
 	                              int rowLimit,
 	                              int byteLimit,
 	                              Optional<ReadOptions> options) override {
 		debug_printf("READRANGE %s\n", printable(keys).c_str());
-		return catchError(readRange_impl(this, keys, rowLimit, byteLimit, options));
+		return catchError(readRange_impl(this, m_tree->getLastCommittedVersion(), keys, rowLimit, byteLimit, options));
 	}
 
 	ACTOR static Future<RangeResult> readRange_impl(KeyValueStoreRedwood* self,
+	                                                Version version,
 	                                                KeyRange keys,
 	                                                int rowLimit,
 	                                                int byteLimit,
@@ -8092,7 +9080,7 @@ public:
 		if (options.present() && options.get().type == ReadType::FETCH) {
 			reason = PagerEventReasons::FetchRange;
 		}
-		wait(self->m_tree->initBTreeCursor(&cur, self->m_tree->getLastCommittedVersion(), reason, options));
+		wait(self->m_tree->initBTreeCursor(&cur, version, reason, options));
 
 		state PriorityMultiLock::Lock lock;
 		state Future<Void> f;
@@ -8228,15 +9216,15 @@ public:
 	}
 
 	ACTOR static Future<Optional<Value>> readValue_impl(KeyValueStoreRedwood* self,
+	                                                    Version version,
 	                                                    Key key,
 	                                                    Optional<ReadOptions> options) {
 		state VersionedBTree::BTreeCursor cur;
-		wait(self->m_tree->initBTreeCursor(
-		    &cur, self->m_tree->getLastCommittedVersion(), PagerEventReasons::PointRead, options));
+		wait(self->m_tree->initBTreeCursor(&cur, version, PagerEventReasons::PointRead, options));
 
 		++g_redwoodMetrics.metric.opGet;
-		wait(cur.seekGTE(key));
-		if (cur.isValid() && cur.get().key == key) {
+		bool found = wait(cur.seekEqual(key));
+		if (found) {
 			// Return a Value whose arena depends on the source page arena
 			Value v;
 			v.arena().dependsOn(cur.back().page->getArena());
@@ -8249,11 +9237,12 @@ public:
 	}
 
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override {
-		return catchError(readValue_impl(this, key, options));
+		return catchError(readValue_impl(this, m_tree->getLastCommittedVersion(), key, options));
 	}
 
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
-		return catchError(map(readValue_impl(this, key, options), [maxLength](Optional<Value> v) {
+		Future<Optional<Value>> read = readValue_impl(this, m_tree->getLastCommittedVersion(), key, options);
+		return catchError(map(read, [maxLength](Optional<Value> v) {
 			if (v.present() && v.get().size() > maxLength) {
 				v.get().contents() = v.get().substr(0, maxLength);
 			}
@@ -8261,6 +9250,36 @@ public:
 		}));
 	}
 
+	// Reads at the version of the tree that was last committed when it was pinned. The pager keeps the pages of a
+	// version from being reused while its pager snapshot is referenced.
+	class Snapshot final : public IKeyValueStoreSnapshot, public ReferenceCounted<Snapshot> {
+	public:
+		explicit Snapshot(KeyValueStoreRedwood* store)
+		  : store(store), version(store->m_tree->getLastCommittedVersion()),
+		    pagerSnapshot(store->m_tree->getReadSnapshot(version)) {}
+
+		Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override {
+			return store->catchError(readValue_impl(store, version, key, options));
+		}
+
+		Future<RangeResult> readRange(KeyRangeRef keys,
+		                              int rowLimit,
+		                              int byteLimit,
+		                              Optional<ReadOptions> options) override {
+			return store->catchError(readRange_impl(store, version, keys, rowLimit, byteLimit, options));
+		}
+
+		void addref() override { ReferenceCounted<Snapshot>::addref(); }
+		void delref() override { ReferenceCounted<Snapshot>::delref(); }
+
+	private:
+		KeyValueStoreRedwood* store;
+		Version version;
+		Reference<IPagerSnapshot> pagerSnapshot;
+	};
+
+	Reference<IKeyValueStoreSnapshot> pinSnapshot() override { return makeReference<Snapshot>(this); }
+
 	~KeyValueStoreRedwood() override{};
 
 private:
@@ -8781,6 +9800,12 @@ RedwoodRecordRef randomRedwoodRecordRef(const std::string& keyBuffer, const std:
 void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 	std::pair<const char*, unsigned int> metrics[] = { { "BTreePreload", metric.btreeLeafPreload },
 		                                               { "BTreePreloadExt", metric.btreeLeafPreloadExt },
+		                                               { "BTreeCompress", metric.btreePageCompress },
+		                                               { "BTreeCompressSaved", metric.btreePageCompressSavedBlocks },
+		                                               { "BTreeDecompress", metric.btreePageDecompress },
+		                                               { "BTreeDecompressBytes", metric.btreePageDecompressBytes },
+		                                               { "BTreeFilterSkip", metric.btreeLeafFilterSkip },
+		                                               { "BTreeFilterFalsePos", metric.btreeLeafFilterFalsePositive },
 		                                               { "", 0 },
 		                                               { "OpSet", metric.opSet },
 		                                               { "OpSetKeyBytes", metric.opSetKeyBytes },
@@ -8790,21 +9815,30 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "", 0 },
 		                                               { "OpGet", metric.opGet },
 		                                               { "OpGetRange", metric.opGetRange },
+		                                               { "OpBulkLoadRecords", metric.opBulkLoadRecords },
+		                                               { "OpBulkLoadLeaves", metric.opBulkLoadLeaves },
 		                                               { "OpCommit", metric.opCommit },
 		                                               { "", 0 },
 		                                               { "PagerDiskWrite", metric.pagerDiskWrite },
 		                                               { "PagerDiskRead", metric.pagerDiskRead },
+		                                               { "PagerDiskReadCoalesced", metric.pagerDiskReadCoalesced },
+		                                               { "PagerSecondaryHit", metric.pagerSecondaryHit },
+		                                               { "PagerSecondaryMiss", metric.pagerSecondaryMiss },
+		                                               { "PagerSecondaryInvalid", metric.pagerSecondaryInvalid },
 		                                               { "PagerCacheHit", metric.pagerCacheHit },
 		                                               { "PagerCacheMiss", metric.pagerCacheMiss },
 		                                               { "", 0 },
 		                                               { "PagerProbeHit", metric.pagerProbeHit },
 		                                               { "PagerProbeMiss", metric.pagerProbeMiss },
 		                                               { "PagerEvictUnhit", metric.pagerEvictUnhit },
+		                                               { "PagerEvictUnused", metric.pagerEvictUnused },
+		                                               { "PagerEvictProtected", metric.pagerEvictProtected },
 		                                               { "PagerEvictFail", metric.pagerEvictFail },
 		                                               { "", 0 },
 		                                               { "PagerRemapFree", metric.pagerRemapFree },
 		                                               { "PagerRemapCopy", metric.pagerRemapCopy },
 		                                               { "PagerRemapSkip", metric.pagerRemapSkip },
+		                                               { "PagerRemapThrottled", metric.pagerRemapThrottled },
 		                                               { "", 0 } };
 
 	double elapsed = now() - startTime;
@@ -8935,6 +9969,166 @@ void RedwoodMetrics::getIOLockFields(TraceEvent* e, std::string* s) {
 	}
 }
 
+namespace {
+struct TestCacheObject {
+	bool evictable() const { return true; }
+	Future<Void> onEvictable() const { return Void(); }
+	Future<Void> cancel() const { return Void(); }
+};
+} // namespace
+
+TEST_CASE("/redwood/correctness/unit/ObjectCache/scanResistance") {
+	typedef ObjectCache<LogicalPageID, TestCacheObject> TestCacheT;
+	TestCacheT::Evictor evictor(10);
+	evictor.protectedFraction = 0.5;
+	TestCacheT cache(&evictor);
+
+	// Pages read twice are protected
+	for (LogicalPageID id = 0; id < 4; ++id) {
+		cache.get(id, 1);
+		cache.get(id, 1);
+	}
+	ASSERT_EQ(evictor.getCountProtected(), 4);
+
+	// A scan reading many pages once does not evict them
+	for (LogicalPageID id = 100; id < 200; ++id) {
+		cache.get(id, 1);
+	}
+	ASSERT(evictor.getCountUsed() <= 10);
+	for (LogicalPageID id = 0; id < 4; ++id) {
+		ASSERT(cache.getIfExists(id) != nullptr);
+	}
+
+	// A prefetched page is only protected once it has been read twice
+	cache.get(300, 1, true);
+	cache.get(300, 1);
+	ASSERT_EQ(evictor.getCountProtected(), 4);
+	cache.get(300, 1);
+	ASSERT_EQ(evictor.getCountProtected(), 5);
+
+	// Promoting past the protected limit demotes the least recently used protected page
+	cache.get(199, 1);
+	cache.get(199, 1);
+	ASSERT_EQ(evictor.getCountProtected(), 5);
+	ASSERT_EQ(evictor.getSizeProtected(), 5);
+
+	Future<Void> cleared = cache.clear();
+	ASSERT(cleared.isReady());
+	ASSERT_EQ(evictor.getCountUsed(), 0);
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/unit/LeafFilterCache") {
+	Arena arena;
+	std::vector<RedwoodRecordRef> records;
+	for (int i = 0; i < 100; ++i) {
+		records.push_back(RedwoodRecordRef(StringRef(arena, format("key%04d", i * 2))));
+	}
+
+	LeafFilterCache filters(1 << 20, 10);
+	filters.insert(1, 10, records.data(), records.data() + records.size());
+	ASSERT_EQ(filters.size(), 1);
+
+	// Every key in the node may be present, and reads before the filter's version do not use it
+	for (auto& r : records) {
+		ASSERT(filters.lookup(1, 10, r.key) == LeafFilterCache::Result::MayContain);
+		ASSERT(filters.lookup(1, 9, r.key) == LeafFilterCache::Result::NoFilter);
+	}
+	ASSERT(filters.lookup(2, 10, records[0].key) == LeafFilterCache::Result::NoFilter);
+
+	// Most absent keys are filtered out
+	int absent = 0;
+	for (int i = 0; i < 100; ++i) {
+		if (filters.lookup(1, 11, StringRef(format("key%04d", i * 2 + 1))) == LeafFilterCache::Result::Absent) {
+			++absent;
+		}
+	}
+	ASSERT(absent > 80);
+
+	filters.erase(1);
+	ASSERT_EQ(filters.size(), 0);
+	ASSERT_EQ(filters.getBytes(), 0);
+
+	// The least recently used filters are evicted once over capacity
+	LeafFilterCache small(40, 10);
+	small.insert(1, 1, records.data(), records.data() + 20);
+	small.insert(2, 1, records.data(), records.data() + 20);
+	ASSERT_EQ(small.size(), 1);
+	ASSERT(small.lookup(1, 1, records[0].key) == LeafFilterCache::Result::NoFilter);
+	ASSERT(small.lookup(2, 1, records[0].key) == LeafFilterCache::Result::MayContain);
+
+	ASSERT(!LeafFilterCache(0, 10).enabled());
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/unit/SecondaryPageCache") {
+	state const int pageSize = 4096;
+	state Reference<SecondaryPageCache> cache =
+	    wait(SecondaryPageCache::open("test.redwood-cache", pageSize, 16 * pageSize, 4));
+	state Reference<ArenaPage> page = makeReference<ArenaPage>(pageSize, pageSize);
+	memset(page->rawData(), 'a', pageSize);
+
+	// A page is cached once its copy has been written
+	cache->insert(7, page, cache->getGeneration(7));
+	while (!cache->contains(7)) {
+		wait(delay(0.01));
+	}
+	state Reference<ArenaPage> copy = makeReference<ArenaPage>(pageSize, pageSize);
+	bool hit = wait(cache->read(7, copy));
+	ASSERT(hit);
+	ASSERT(memcmp(copy->rawData(), page->rawData(), pageSize) == 0);
+
+	// Writing the page discards the copy, and a page file read started before the write is not cached
+	uint64_t generation = cache->getGeneration(7);
+	cache->invalidate(7);
+	ASSERT(!cache->contains(7));
+	cache->insert(7, page, generation);
+	wait(delay(0.1));
+	ASSERT(!cache->contains(7));
+	bool miss = wait(cache->read(7, copy));
+	ASSERT(!miss);
+
+	cache.clear();
+	wait(IAsyncFileSystem::filesystem()->deleteFile("test.redwood-cache", true));
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/unit/RemapCleanupThrottle") {
+	RemapCleanupThrottle throttle(16, 0.01, 4);
+	ASSERT(throttle.enabled());
+	ASSERT_EQ(throttle.limit, 16);
+
+	// Slow reads or a deep IO queue halve the limit, down to 1
+	for (int i = 0; i < 100; ++i) {
+		throttle.addReadLatency(0.1);
+	}
+	throttle.update(0, 1);
+	ASSERT_EQ(throttle.limit, 8);
+	for (int i = 0; i < 10; ++i) {
+		throttle.update(0, 1);
+	}
+	ASSERT_EQ(throttle.limit, 1);
+
+	for (int i = 0; i < 100; ++i) {
+		throttle.addReadLatency(0.001);
+	}
+	throttle.update(5, 10);
+	ASSERT_EQ(throttle.limit, 1);
+
+	// Fast reads with some IO in progress grow the limit by one, and an idle IO lock doubles it
+	throttle.update(1, 10);
+	ASSERT_EQ(throttle.limit, 2);
+	throttle.update(0, 0);
+	ASSERT_EQ(throttle.limit, 4);
+	for (int i = 0; i < 10; ++i) {
+		throttle.update(0, 0);
+	}
+	ASSERT_EQ(throttle.limit, 16);
+
+	ASSERT(!RemapCleanupThrottle(0, 0.01, 4).enabled());
+	return Void();
+}
+
 TEST_CASE("/redwood/correctness/unit/RedwoodRecordRef") {
 	ASSERT(RedwoodRecordRef::Delta::LengthFormatSizes[0] == 3);
 	ASSERT(RedwoodRecordRef::Delta::LengthFormatSizes[1] == 4);
@@ -8957,6 +10151,12 @@ TEST_CASE("/redwood/correctness/unit/RedwoodRecordRef") {
 		ASSERT(r2.getChildPage().begin() != id.begin());
 	}
 
+	ASSERT(RedwoodRecordRef("abc"_sr).fencePrefix() < RedwoodRecordRef("abd"_sr).fencePrefix());
+	ASSERT(RedwoodRecordRef("abc"_sr).fencePrefix() == RedwoodRecordRef("abc\x00"_sr).fencePrefix());
+	ASSERT(RedwoodRecordRef("abcdefgh1"_sr).fencePrefix() == RedwoodRecordRef("abcdefgh2"_sr).fencePrefix());
+	ASSERT(RedwoodRecordRef("\xff"_sr).fencePrefix() > RedwoodRecordRef("\x01\xff\xff"_sr).fencePrefix());
+	ASSERT(RedwoodRecordRef(""_sr).fencePrefix() == 0);
+
 	deltaTest(RedwoodRecordRef(""_sr, ""_sr), RedwoodRecordRef(""_sr, ""_sr));
 
 	deltaTest(RedwoodRecordRef("abc"_sr, ""_sr), RedwoodRecordRef("abc"_sr, ""_sr));
@@ -11477,4 +12677,42 @@ TEST_CASE("/redwood/correctness/EnforceEncodingType") {
 		wait(closeKVS(kvs, true /*dispose*/));
 	}
 	return Void();
-}
\ No newline at end of file
+}
+TEST_CASE("/redwood/correctness/bulkLoad") {
+	state std::string fileName = params.get("fileName").orDefault("unittest_bulkload.redwood-v1");
+	state int count = params.getInt("count").orDefault(20000);
+	deleteFile(fileName);
+
+	state KeyValueStoreRedwood* kvs = new KeyValueStoreRedwood(fileName, UID(), {}, EncryptionAtRestMode::DISABLED);
+	wait(kvs->init());
+
+	state Standalone<VectorRef<KeyValueRef>> data;
+	for (int i = 0; i < count; ++i) {
+		data.push_back_deep(data.arena(),
+		                    KeyValueRef(StringRef(format("key%08d", i)), StringRef(format("value%d", i * 7))));
+	}
+	kvs->bulkLoad(data);
+	wait(kvs->commit());
+
+	state int i = 0;
+	for (i = 0; i < 1000; ++i) {
+		state int index = deterministicRandom()->randomInt(0, count);
+		Optional<Value> v = wait(kvs->readValue(data[index].key, Optional<ReadOptions>()));
+		ASSERT(v.present() && v.get() == data[index].value);
+	}
+	RangeResult all = wait(kvs->readRange(KeyRangeRef(""_sr, "\xff"_sr), 1 << 30, 1 << 30, Optional<ReadOptions>()));
+	ASSERT_EQ(all.size(), count);
+	ASSERT(all.front() == data.front() && all.back() == data.back());
+
+	// The bulk loaded tree accepts normal mutations
+	kvs->set(KeyValueRef("key"_sr, "new"_sr));
+	kvs->clear(singleKeyRange(data[0].key));
+	wait(kvs->commit());
+	Optional<Value> added = wait(kvs->readValue("key"_sr, Optional<ReadOptions>()));
+	ASSERT(added.present() && added.get() == "new"_sr);
+	Optional<Value> cleared = wait(kvs->readValue(data[0].key, Optional<ReadOptions>()));
+	ASSERT(!cleared.present());
+
+	wait(closeKVS(kvs, true));
+	return Void();
+}
@@ -229,6 +229,20 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 
 	RecoveryState recoveryState;
 
+	// Seconds spent in each RecoveryStatus during this recovery, reported when it starts accepting commits
+	std::vector<double> recoveryPhaseSeconds;
+	int recoveryPhase;
+	double recoveryPhaseStart;
+
+	void enterRecoveryPhase(RecoveryStatus::RecoveryStatus status) {
+		double t = now();
+		if (recoveryPhase >= 0) {
+			recoveryPhaseSeconds[recoveryPhase] += t - recoveryPhaseStart;
+		}
+		recoveryPhase = status;
+		recoveryPhaseStart = t;
+	}
+
 	PromiseStream<Future<Void>> addActor;
 	Reference<AsyncVar<bool>> recruitmentStalled;
 	bool forceRecovery;
@@ -271,6 +285,7 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 	    coordinators(coordinators), lastVersionTime(0), txnStateStore(nullptr), memoryLimit(2e9), dbId(dbId),
 	    masterInterface(masterInterface), masterLifetime(masterLifetimeToken), clusterController(clusterController),
 	    cstate(coordinators, addActor, dbgid), dbInfo(dbInfo), registrationCount(0), addActor(addActor),
+	    recoveryPhaseSeconds(RecoveryStatus::END, 0.0), recoveryPhase(-1), recoveryPhaseStart(0),
 	    recruitmentStalled(makeReference<AsyncVar<bool>>(false)), forceRecovery(forceRecovery), neverCreated(false),
 	    safeLocality(tagLocalityInvalid), primaryLocality(tagLocalityInvalid),
 	    cc("ClusterRecoveryData", dbgid.toString()), changeCoordinatorsRequests("ChangeCoordinatorsRequests", cc),
@@ -28,7 +28,9 @@
 #include "fdbclient/CommitTransaction.h"
 
 struct ConflictSet;
-ConflictSet* newConflictSet();
+// When workerThreads > 0, large batches split their read conflict checks and write conflict range insertion across
+// that many worker threads in addition to the calling thread (see CONFLICT_SET_WORKER_THREADS).
+ConflictSet* newConflictSet(int workerThreads = 0);
 void clearConflictSet(ConflictSet*, Version);
 void destroyConflictSet(ConflictSet*);
 
@@ -46,6 +48,9 @@ struct ConflictBatch {
 	};
 
 	void addTransaction(const CommitTransactionRef& transaction, Version newOldestVersion);
+	// Sorts the conflict ranges of the transactions added so far. This does not touch the conflict set, so it can be
+	// done before the previous batch has been resolved. No transactions may be added afterwards.
+	void sortConflictRanges();
 	void detectConflicts(Version now,
 	                     Version newOldestVersion,
 	                     std::vector<int>& nonConflicting,
@@ -60,6 +65,7 @@ private:
 	std::vector<std::pair<StringRef, StringRef>> combinedWriteConflictRanges;
 	std::vector<struct ReadConflictRange> combinedReadConflictRanges;
 	bool* transactionConflictStatus;
+	bool sorted;
 	// Stores the map: a transaction -> conflicted transactions' indices
 	std::map<int, VectorRef<int>>* conflictingKeyRangeMap;
 	Arena* resolveBatchReplyArena;
@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include "fdbclient/FDBOptions.g.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/KeyBackedTypes.h"
@@ -168,6 +170,49 @@ public:
 };
 typedef AsyncMap<UID, ServerStatus> ServerStatusMap;
 
+// Servers or machines that may be picked for a new team, kept by the number of teams they are on, so that team building
+// finds a least used one without scanning all of them for every team it adds
+template <class T>
+class TeamCountIndex {
+public:
+	void add(Reference<T> const& item, int teamCount) {
+		ASSERT(!positions.count(item.getPtr()));
+		auto& bucket = byCount[teamCount];
+		positions[item.getPtr()] = { teamCount, bucket.size() };
+		bucket.push_back(item);
+	}
+
+	// Moves item to the bucket of its new team count; items that were never added are ignored
+	void update(Reference<T> const& item, int teamCount) {
+		auto it = positions.find(item.getPtr());
+		if (it == positions.end() || it->second.first == teamCount) {
+			return;
+		}
+		auto& bucket = byCount[it->second.first];
+		size_t index = it->second.second;
+		positions[bucket.back().getPtr()].second = index;
+		bucket[index] = bucket.back();
+		bucket.pop_back();
+		if (bucket.empty()) {
+			byCount.erase(it->second.first);
+		}
+		positions.erase(it);
+		add(item, teamCount);
+	}
+
+	// The items on the fewest teams
+	std::vector<Reference<T>> const& leastUsed() const {
+		static const std::vector<Reference<T>> none;
+		return byCount.empty() ? none : byCount.begin()->second;
+	}
+
+	int size() const { return positions.size(); }
+
+private:
+	std::map<int, std::vector<Reference<T>>> byCount;
+	std::unordered_map<T const*, std::pair<int, size_t>> positions; // team count and index in its bucket
+};
+
 FDB_DECLARE_BOOLEAN_PARAM(IsPrimary);
 FDB_DECLARE_BOOLEAN_PARAM(IsInitialTeam);
 FDB_DECLARE_BOOLEAN_PARAM(IsRedundantTeam);
@@ -204,6 +249,7 @@ struct DDTeamCollectionInitParams {
 class DDTeamCollection : public ReferenceCounted<DDTeamCollection> {
 	friend class DDTeamCollectionImpl;
 	friend class DDTeamCollectionUnitTest;
+	friend struct MockDDPlacementBenchmarkWorkload;
 
 protected:
 	enum class Status { NONE = 0, WIGGLING = 1, EXCLUDED = 2, FAILED = 3 };
@@ -214,6 +260,10 @@ protected:
 
 	bool doBuildTeams;
 	bool lastBuildTeamsFailed;
+	// How long team building passes took, reported in the TeamBuilding event and status
+	int64_t buildTeamsCount = 0;
+	double lastBuildTeamsSeconds = 0;
+	double maxBuildTeamsSeconds = 0;
 	Future<Void> teamBuilder;
 	AsyncTrigger restartTeamBuilder;
 	AsyncVar<bool> waitUntilRecruited; // make teambuilder wait until one new SS is recruited
@@ -279,6 +329,9 @@ protected:
 	Future<bool> clearHealthyZoneFuture;
 	double medianAvailableSpace;
 	double lastMedianAvailableSpaceUpdate;
+	// The storage queue, durability lag and CPU usage of each storage server as last reported by ratekeeper, only
+	// kept with DD_LOAD_AWARE_TEAM_SELECTION
+	std::map<UID, HealthMetrics::StorageStats> storageStats;
 
 	int lowestUtilizationTeam;
 	int highestUtilizationTeam;
@@ -295,6 +348,7 @@ protected:
 
 	Reference<EventCacheHolder> ddTrackerStartingEventHolder;
 	Reference<EventCacheHolder> teamCollectionInfoEventHolder;
+	Reference<EventCacheHolder> teamBuildingEventHolder;
 	Reference<EventCacheHolder> storageServerRecruitmentEventHolder;
 
 	bool primary;
@@ -374,6 +428,13 @@ protected:
 	// Return the healthy server with the least number of correct-size server teams
 	Reference<TCServerInfo> findOneLeastUsedServer() const;
 
+	// The healthy servers with a valid locality by their number of teams, for DD_INCREMENTAL_TEAM_BUILDING. Sets
+	// serversBelowTarget to the number of healthy servers on fewer teams than notEnoughTeamsForAServer() wants.
+	TeamCountIndex<TCServerInfo> indexServersByTeamCount(int* serversBelowTarget) const;
+
+	// The same for healthy machines with a valid locality and their machine teams
+	TeamCountIndex<TCMachineInfo> indexMachinesByTeamCount(int* machinesBelowTarget) const;
+
 	// A server team should always come from servers on a machine team
 	// Check if it is true
 	bool isOnSameMachineTeam(TCTeamInfo const& team) const;
@@ -403,10 +464,14 @@ protected:
 	// Each machine is expected to have targetMachineTeamNumPerMachine
 	// Return true if there exists a machine that does not have enough teams.
 	bool notEnoughMachineTeamsForAMachine() const;
+	int targetMachineTeamNumPerMachine() const;
 
 	// Each server is expected to have targetTeamNumPerServer teams.
 	// Return true if there exists a server that does not have enough teams.
 	bool notEnoughTeamsForAServer() const;
+	int targetTeamNumPerServer() const;
+
+	void recordBuildTeamsTime(double seconds);
 
 	// Use the current set of known processes (from server_info) to compute an optimized set of storage server teams.
 	// The following are guarantees of the process:
@@ -561,6 +626,16 @@ protected:
 
 	int64_t getDebugTotalDataInFlight() const;
 
+	// How close the busiest server of team is to being saturated by CPU, storage queue, durability lag or reads,
+	// from 0 to 1
+	double getLoadPressure(TCTeamInfo const& team) const;
+
+	// The load bytes of team that getTeam() compares, raised by its load pressure with DD_LOAD_AWARE_TEAM_SELECTION
+	int64_t getPlacementLoadBytes(TCTeamInfo const& team, double inflightPenalty) const;
+
+	// Keeps storageStats up to date
+	Future<Void> trackStorageLoadPressure();
+
 	void noHealthyTeams() const;
 
 	// To enable verbose debug info, set shouldPrint to true
@@ -24,6 +24,7 @@
 #include "flow/Arena.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbserver/Knobs.h"
+#include <array>
 #include <string.h>
 
 #define DELTATREE_DEBUG 0
@@ -70,13 +71,14 @@ static inline int perfectSubtreeSplitPoint(int subtree_size) {
 }
 
 static inline int perfectSubtreeSplitPointCached(int subtree_size) {
-	static uint16_t* points = nullptr;
 	static const int max = 500;
-	if (points == nullptr) {
-		points = new uint16_t[max];
+	// Initialized on first use in a thread safe way, as trees can be built on worker threads
+	static const std::array<uint16_t, max> points = [] {
+		std::array<uint16_t, max> p;
 		for (int i = 0; i < max; ++i)
-			points[i] = perfectSubtreeSplitPoint(i);
-	}
+			p[i] = perfectSubtreeSplitPoint(i);
+		return p;
+	}();
 
 	if (subtree_size < max)
 		return points[subtree_size];
@@ -914,6 +916,10 @@ private:
 //    // For debugging, return a useful human-readable string representation of *this
 //    std::string toString() const;
 //
+//    // Optional.  A prefix of *this such that a.fencePrefix() < b.fencePrefix() implies a < b, which seek()
+//    // compares against the top levels of the tree to avoid decoding those nodes.
+//    uint64_t fencePrefix() const;
+//
 // DeltaT requirements
 //
 //    DeltaT can be variable sized, larger than sizeof(DeltaT), and implement the following:
@@ -939,6 +945,12 @@ private:
 //    // For debugging, return a useful human-readable string representation of *this
 //    std::string toString() const;
 //
+template <typename T, typename = void>
+struct HasFencePrefix : std::false_type {};
+
+template <typename T>
+struct HasFencePrefix<T, std::void_t<decltype(std::declval<const T&>().fencePrefix())>> : std::true_type {};
+
 #pragma pack(push, 1)
 template <typename T, typename DeltaT = typename T::Delta>
 struct DeltaTree2 {
@@ -1063,7 +1075,7 @@ public:
 	struct DecodeCache : FastAllocated<DecodeCache>, ReferenceCounted<DecodeCache> {
 		DecodeCache(const T& lowerBound = T(), const T& upperBound = T(), int64_t* pMemoryTracker = nullptr)
 		  : lowerBound(arena, lowerBound), upperBound(arena, upperBound), lastKnownUsedMemory(0),
-		    pMemoryTracker(pMemoryTracker) {
+		    pMemoryTracker(pMemoryTracker), fencesKnown(0) {
 			decodedNodes.reserve(10);
 			deltatree_printf("DecodedNode size: %d\n", sizeof(DecodedNode));
 		}
@@ -1095,6 +1107,29 @@ public:
 
 		DecodedNode& get(int index) { return decodedNodes[index]; }
 
+		// Fence prefixes of the nodes in the top FenceLevels levels of the tree, by position in heap order where the
+		// children of position i are at 2i+1 and 2i+2.  They are filled in as seeks decode those nodes, and later
+		// seeks compare against them first so that the top of the tree is only decoded when prefixes are equal.
+		// Nodes are only ever added below existing ones, so a position refers to the same node in every version of
+		// the tree sharing this cache.
+		static constexpr int FenceLevels = 4;
+		static constexpr int FenceCount = (1 << FenceLevels) - 1;
+		uint64_t fences[FenceCount];
+		uint16_t fencesKnown;
+
+		// Compares prefix to the fence at position, returning 0 if it is unknown or does not decide the order
+		int compareFence(int position, uint64_t prefix) const {
+			if (!(fencesKnown & (1 << position)) || prefix == fences[position]) {
+				return 0;
+			}
+			return prefix < fences[position] ? -1 : 1;
+		}
+
+		void setFence(int position, uint64_t prefix) {
+			fences[position] = prefix;
+			fencesKnown |= (1 << position);
+		}
+
 		void updateUsedMemory() {
 			int usedNow = sizeof(DeltaTree2) + arena.getSize(FastInaccurateEstimate::True) +
 			              (decodedNodes.capacity() * sizeof(DecodedNode));
@@ -1115,6 +1150,7 @@ public:
 
 		void clear() {
 			decodedNodes.clear();
+			fencesKnown = 0;
 			Arena a;
 			lowerBound = T(a, lowerBound);
 			upperBound = T(a, upperBound);
@@ -1356,11 +1392,30 @@ public:
 			deltatree_printf("seek(%s) start %s\n", s.toString().c_str(), toString().c_str());
 			int nIndex = rootIndex();
 			int cmp = 0;
+			// Heap order position of nIndex, for looking up its fence while it is in the top levels of the tree
+			int fence = 0;
+			uint64_t prefix = 0;
+			if constexpr (HasFencePrefix<T>::value) {
+				prefix = s.fencePrefix();
+			}
 
 			while (nIndex != -1) {
 				nodeIndex = nIndex;
 				item.reset();
-				cmp = s.compare(get(), skipLen);
+				cmp = 0;
+				if constexpr (HasFencePrefix<T>::value) {
+					if (fence < DecodeCache::FenceCount) {
+						cmp = cache->compareFence(fence, prefix);
+					}
+				}
+				if (cmp == 0) {
+					cmp = s.compare(get(), skipLen);
+					if constexpr (HasFencePrefix<T>::value) {
+						if (fence < DecodeCache::FenceCount && !(cache->fencesKnown & (1 << fence))) {
+							cache->setFence(fence, get().fencePrefix());
+						}
+					}
+				}
 				deltatree_printf("seek(%s) loop cmp=%d %s\n", s.toString().c_str(), cmp, toString().c_str());
 				if (cmp == 0) {
 					break;
@@ -1368,8 +1423,10 @@ public:
 
 				if (cmp > 0) {
 					nIndex = getRightChildIndex(nIndex);
+					fence = 2 * fence + 2;
 				} else {
 					nIndex = getLeftChildIndex(nIndex);
+					fence = 2 * fence + 1;
 				}
 			}
 
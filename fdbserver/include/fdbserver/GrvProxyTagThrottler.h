@@ -34,6 +34,10 @@
 // Between each set of waits, releaseTransactions is run, releasing queued transactions
 // that have passed the tag throttling stage. Transactions that are not yet ready
 // are requeued during releaseTransactions.
+//
+// With PROXY_TAG_TOKEN_BUCKET, a tag must also have tokens in its TokenBucket to be released.
+// The bucket refills at the latest rate from ratekeeper, so a burst is clamped within the
+// release window it arrives in while the global tag throttler still sets the long-term rate.
 class GrvProxyTagThrottler {
 	class DelayedRequest {
 		static uint64_t lastSequenceNumber;
@@ -50,14 +54,35 @@ class GrvProxyTagThrottler {
 		bool isMaxThrottled(double maxThrottleDuration) const;
 	};
 
+	class TokenBucket {
+		double rate{ 0.0 };
+		double tokens{ 0.0 };
+
+		double capacity() const;
+
+	public:
+		TokenBucket() = default;
+		explicit TokenBucket(double rate);
+
+		void setRate(double rate) { this->rate = rate; }
+		void refill(double elapsed);
+		// A request for more transactions than the bucket holds is let through once the bucket is full,
+		// leaving it in debt
+		bool canTake(int64_t count) const;
+		void take(int64_t count) { tokens -= count; }
+	};
+
 	struct TagQueue {
 		Optional<GrvTransactionRateInfo> rateInfo;
+		TokenBucket tokenBucket;
 		Deque<DelayedRequest> requests;
 
 		TagQueue() = default;
-		explicit TagQueue(double rate) : rateInfo(rate) {}
+		explicit TagQueue(double rate) : rateInfo(rate), tokenBucket(rate) {}
 
 		void setRate(double rate);
+		// Whether rateInfo, and the token bucket if enabled, allow count more transactions after numReleased
+		bool canStart(uint32_t numReleased, int64_t count) const;
 		bool isMaxThrottled(double maxThrottleDuration) const;
 		void rejectRequests(LatencyBandsMap&);
 		void endReleaseWindow(int64_t numStarted, double elapsed);
@@ -47,6 +47,23 @@ struct CheckpointRequest {
 	  : version(version), ranges(ranges), format(format), checkpointID(id), checkpointDir(checkpointDir) {}
 };
 
+// The contents of a store as of the last commit that ended before it was pinned, which later commits do not change.
+// Keeping one may keep the store from reusing the space of the data it holds.
+class IKeyValueStoreSnapshot {
+public:
+	virtual Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
+
+	// Same as IKeyValueStore::readRange()
+	virtual Future<RangeResult> readRange(KeyRangeRef keys,
+	                                      int rowLimit = 1 << 30,
+	                                      int byteLimit = 1 << 30,
+	                                      Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
+
+	virtual void addref() = 0;
+	virtual void delref() = 0;
+	virtual ~IKeyValueStoreSnapshot() {}
+};
+
 class IKeyValueStore : public IClosable {
 public:
 	virtual KeyValueStoreType getType() const = 0;
@@ -114,6 +131,9 @@ public:
 	// Delete a checkpoint.
 	virtual Future<Void> deleteCheckpoint(const CheckpointMetaData& checkpoint) { throw not_implemented(); }
 
+	// Pins the committed contents of the store, or returns an empty reference if the store cannot keep them
+	virtual Reference<IKeyValueStoreSnapshot> pinSnapshot() { return Reference<IKeyValueStoreSnapshot>(); }
+
 	/*
 	Concurrency contract
 	    Causal consistency:
@@ -150,6 +170,8 @@ extern IKeyValueStore* keyValueStoreRedwoodV1(std::string const& filename,
                                               UID logID,
                                               Reference<AsyncVar<ServerDBInfo> const> db = {},
                                               Optional<EncryptionAtRestMode> encryptionMode = {});
+// Returns the number of page cache hits and misses of all Redwood stores in this process so far
+extern std::pair<int64_t, int64_t> getRedwoodPageCacheHitsAndMisses();
 extern IKeyValueStore* keyValueStoreRocksDB(std::string const& path,
                                             UID logID,
                                             KeyValueStoreType storeType,
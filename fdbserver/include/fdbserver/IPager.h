@@ -727,6 +727,14 @@ public:
 		}
 	}
 
+	uint8_t getPageFormat() const {
+		if (page->headerVersion == 1) {
+			return page->getMainHeader<RedwoodHeaderV1>()->pageFormat;
+		} else {
+			throw page_header_version_not_supported();
+		}
+	}
+
 	// Used by encodings that do encryption
 	EncryptionKey encryptionKey;
 
@@ -750,6 +758,11 @@ public:
 	                                                                int priority,
 	                                                                bool cacheable,
 	                                                                bool nohit) = 0;
+	// Start reading single page nodes into the page cache without counting as cache hits
+	virtual void preLoadPages(PagerEventReasons reason,
+	                          unsigned int level,
+	                          VectorRef<LogicalPageID> pageIDs,
+	                          int priority) = 0;
 	virtual Version getVersion() const = 0;
 
 	virtual Key getMetaKey() const = 0;
@@ -838,6 +851,13 @@ public:
 	                                                   bool cacheable,
 	                                                   bool noHit) = 0;
 
+	// Start reading the given pages into the page cache without counting as cache hits. Pages that are already
+	// cached are skipped and runs of physically adjacent pages are read with a single disk read.
+	virtual void preLoadPages(PagerEventReasons reason,
+	                          unsigned int level,
+	                          VectorRef<PhysicalPageID> pageIDs,
+	                          int priority) = 0;
+
 	virtual Future<Reference<ArenaPage>> readExtent(LogicalPageID pageID) = 0;
 	virtual void releaseExtentReadLock() = 0;
 
@@ -97,6 +97,14 @@ public:
 
 	int bestLocationFor(Tag tag);
 
+	// The measured cost in seconds of peeking from the TLog at location, from the ping latency and outstanding replies
+	// of our connection to it, or nothing if the connection has not been measured yet
+	Optional<double> measuredPeekLatency(int location) const;
+
+	// The location to peek tag from. Satellite sets hold each tag on several TLogs, and with
+	// LOG_ROUTER_PEEK_USE_MEASURED_LATENCY the one with the lowest measured latency is preferred to bestLocationFor().
+	int bestPeekLocationFor(Tag tag);
+
 	void updateLocalitySet(std::vector<LocalityData> const& localities);
 
 	bool satisfiesPolicy(const std::vector<LocalityEntry>& locations);
@@ -280,6 +288,8 @@ struct ILogSystem {
 		UID randomID;
 		int tLogReplicationFactor;
 		Future<Void> more;
+		// The version every server cursor was last advanced to while the best server had messages
+		Version advancedVersion = invalidVersion;
 
 		MergedPeekCursor(std::vector<Reference<ILogSystem::IPeekCursor>> const& serverCursors, Version begin);
 		MergedPeekCursor(std::vector<Reference<AsyncVar<OptionalInterface<TLogInterface>>>> const& logServers,
@@ -340,6 +350,8 @@ struct ILogSystem {
 		bool useBestSet;
 		UID randomID;
 		Future<Void> more;
+		// The version every server cursor was last advanced to while the best server had messages
+		Version advancedVersion = invalidVersion;
 
 		SetPeekCursor(std::vector<Reference<LogSet>> const& logSets,
 		              int bestSet,
@@ -832,21 +844,20 @@ private:
 	// true on a successful write, and false if the location has already been
 	// written.
 	bool writeTransactionInfo(int location, uint32_t subseq);
+
+	// Sets prev_tags to the tags of the next message and msg_locations to the TLogs it must be pushed to.  Consecutive
+	// mutations usually go to the same shard, so the locations of the previous message are reused when its tags are
+	// unchanged instead of running the replication policy again for every mutation.
+	void updateMessageLocations(bool allLocations);
+
+	// The tags and allLocations flag msg_locations was last computed for
+	std::vector<Tag> location_tags;
+	bool location_all_locations = false;
 };
 
 template <class T>
 void LogPushData::writeTypedMessage(T const& item, bool metadataMessage, bool allLocations) {
-	prev_tags.clear();
-	if (logSystem->hasRemoteLogs()) {
-		prev_tags.push_back(logSystem->getRandomRouterTag());
-	}
-	for (auto& tag : next_message_tags) {
-		prev_tags.push_back(tag);
-	}
-	msg_locations.clear();
-	logSystem->getPushLocations(prev_tags, msg_locations, allLocations);
-
-	BinaryWriter bw(AssumeVersion(g_network->protocolVersion()));
+	updateMessageLocations(allLocations);
 
 	// Metadata messages (currently LogProtocolMessage is the only metadata
 	// message) should be written before span information. If this isn't a
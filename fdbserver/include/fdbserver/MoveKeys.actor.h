@@ -29,6 +29,7 @@
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/NativeAPI.actor.h"
 #include "fdbserver/MasterInterface.h"
+#include "flow/ActorCollection.h"
 #include "flow/BooleanParam.h"
 #include "flow/actorcompiler.h"
 
@@ -56,6 +57,31 @@ public:
 	bool setDDEnabled(bool status, UID snapUID);
 };
 
+// Lets the startMoveKeys of concurrent relocations share transactions. Moves queue up while waiting for a permit of
+// the start move keys parallelism lock, and the holder of a permit starts up to START_MOVE_KEYS_BATCH_SIZE of them in
+// one transaction, one after another, as if their own transactions had committed in that order.
+struct StartMoveKeysBatcher {
+	struct Request {
+		Database occ;
+		KeyRange keys;
+		std::vector<UID> servers;
+		MoveKeysLock lock;
+		const DDEnabledState* ddEnabledState = nullptr;
+		// The end of the keys whose move was started, and the TSS mapping read by the transaction
+		Promise<std::pair<Key, std::map<UID, StorageServerInterface>>> reply;
+	};
+
+	FlowLock* parallelismLock;
+	std::deque<Request> pending;
+	bool collecting = false; // A worker is waiting for a permit and will take the pending requests
+	ActorCollection workers; // Destroyed first, so that workers never see the other members go away
+
+	explicit StartMoveKeysBatcher(FlowLock* parallelismLock) : parallelismLock(parallelismLock), workers(false) {}
+
+	Future<std::pair<Key, std::map<UID, StorageServerInterface>>> enqueue(Request request);
+	void startWorker();
+};
+
 struct MoveKeysParams {
 	UID dataMoveId;
 
@@ -73,6 +99,7 @@ struct MoveKeysParams {
 	UID relocationIntervalId;
 	const DDEnabledState* ddEnabledState = nullptr;
 	CancelConflictingDataMoves cancelConflictingDataMoves = CancelConflictingDataMoves::False;
+	StartMoveKeysBatcher* startMoveKeysBatcher = nullptr;
 
 	MoveKeysParams() {}
 
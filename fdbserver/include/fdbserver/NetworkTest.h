@@ -62,22 +62,28 @@ struct NetworkTestStreamingReply : ReplyPromiseStreamReply {
 	constexpr static FileIdentifier file_identifier = 3726830;
 
 	int index = 0;
+	Value value;
 	NetworkTestStreamingReply() = default;
-	explicit NetworkTestStreamingReply(int index) : index(index) {}
-	size_t expectedSize() const { return 4e6; /*sizeof(*this);*/ }
+	NetworkTestStreamingReply(int index, Value value) : index(index), value(value) {}
+	size_t expectedSize() const { return sizeof(*this) + value.size(); }
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, ReplyPromiseStreamReply::acknowledgeToken, ReplyPromiseStreamReply::sequence, index);
+		serializer(ar, ReplyPromiseStreamReply::acknowledgeToken, ReplyPromiseStreamReply::sequence, index, value);
 	}
 };
 
+// Asks for a stream of replies replySize bytes each, the way storage servers and log routers peek the logs
 struct NetworkTestStreamingRequest {
 	constexpr static FileIdentifier file_identifier = 2794452;
+	int replies = 0;
+	uint32_t replySize = 0;
 	ReplyPromiseStream<struct NetworkTestStreamingReply> reply;
+	NetworkTestStreamingRequest() {}
+	NetworkTestStreamingRequest(int replies, uint32_t replySize) : replies(replies), replySize(replySize) {}
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, reply);
+		serializer(ar, replies, replySize, reply);
 	}
 };
 
@@ -29,6 +29,7 @@
 
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/Tenant.h"
+#include "fdbrpc/DDSketch.h"
 #include "fdbrpc/Stats.h"
 #include "fdbserver/Knobs.h"
 #include "fdbserver/LogSystem.h"
@@ -68,6 +69,11 @@ struct ProxyStats {
 	Counter tenantIdRequestOut;
 	Counter tenantIdRequestErrors;
 	Counter txnExpensiveClearCostEstCount;
+	// Pushes of commit batches to local TLogs, and those skipped because version vector unicast found nothing the TLog
+	// needed from the batch
+	Counter tLogPushes, tLogPushesAvoided;
+	// Storage server lookups for single key mutations answered by the flat key info index
+	Counter keyInfoIndexHits;
 	Version lastCommitVersionAssigned;
 
 	LatencySample commitLatencySample;
@@ -80,6 +86,15 @@ struct ProxyStats {
 
 	LatencySample computeLatency;
 
+	// Time each commit batch spends in the stages of the commit pipeline, reported in status
+	LatencySample commitBatchQueuingLatency;
+	LatencySample getCommitVersionLatency;
+	LatencySample resolutionLatency;
+	LatencySample postResolutionQueuingLatency;
+	LatencySample processingMutationLatency;
+	LatencySample tlogLoggingLatency;
+	LatencySample replyCommitLatency;
+
 	Future<Void> logger;
 
 	int64_t maxComputeNS;
@@ -121,7 +136,9 @@ struct ProxyStats {
 	    keyServerLocationIn("KeyServerLocationIn", cc), keyServerLocationOut("KeyServerLocationOut", cc),
 	    keyServerLocationErrors("KeyServerLocationErrors", cc), tenantIdRequestIn("TenantIdRequestIn", cc),
 	    tenantIdRequestOut("TenantIdRequestOut", cc), tenantIdRequestErrors("TenantIdRequestErrors", cc),
-	    txnExpensiveClearCostEstCount("ExpensiveClearCostEstCount", cc), lastCommitVersionAssigned(0),
+	    txnExpensiveClearCostEstCount("ExpensiveClearCostEstCount", cc), tLogPushes("TLogPushes", cc),
+	    tLogPushesAvoided("TLogPushesAvoided", cc), keyInfoIndexHits("KeyInfoIndexHits", cc),
+	    lastCommitVersionAssigned(0),
 	    commitLatencySample("CommitLatencyMetrics",
 	                        id,
 	                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
@@ -139,6 +156,34 @@ struct ProxyStats {
 	                   id,
 	                   SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                   SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    commitBatchQueuingLatency("CommitBatchQueuingLatencyMetrics",
+	                              id,
+	                              SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                              SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    getCommitVersionLatency("CommitGetCommitVersionLatencyMetrics",
+	                            id,
+	                            SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                            SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    resolutionLatency("CommitResolutionLatencyMetrics",
+	                      id,
+	                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                      SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    postResolutionQueuingLatency("CommitPostResolutionQueuingLatencyMetrics",
+	                                 id,
+	                                 SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                                 SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    processingMutationLatency("CommitProcessingMutationLatencyMetrics",
+	                              id,
+	                              SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                              SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    tlogLoggingLatency("CommitTLogLoggingLatencyMetrics",
+	                       id,
+	                       SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                       SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    replyCommitLatency("CommitReplyLatencyMetrics",
+	                       id,
+	                       SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                       SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    maxComputeNS(0), minComputeNS(1e12),
 	    commitBatchQueuingDist(
 	        Histogram::getHistogram("CommitProxy"_sr, "CommitBatchQueuing"_sr, Histogram::Unit::milliseconds)),
@@ -164,14 +209,131 @@ struct ProxyStats {
 	}
 };
 
+// Bounds the commit batching interval so that batching plus the rest of the commit pipeline stays within
+// COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY. Every control window, the p99 of the batches' resolution and TLog push
+// latency is subtracted from the target, and whatever remains is the largest interval the batcher may wait.
+struct CommitBatchIntervalController {
+	DDSketch<double> pipelineLatency;
+	double windowStart = 0;
+	double maxInterval = SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX;
+
+	bool enabled() const { return SERVER_KNOBS->COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY > 0; }
+
+	// Records the time a batch spent being resolved and pushed to the TLogs
+	void addPipelineLatency(double seconds) {
+		pipelineLatency.addSample(seconds);
+		if (now() - windowStart < SERVER_KNOBS->COMMIT_BATCH_INTERVAL_CONTROL_WINDOW) {
+			return;
+		}
+		if (pipelineLatency.getPopulationSize() >= SERVER_KNOBS->COMMIT_BATCH_INTERVAL_CONTROL_MIN_SAMPLES) {
+			double budget = SERVER_KNOBS->COMMIT_BATCH_INTERVAL_TARGET_P99_LATENCY - pipelineLatency.percentile(0.99);
+			maxInterval = std::max(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MIN,
+			                       std::min(SERVER_KNOBS->COMMIT_TRANSACTION_BATCH_INTERVAL_MAX, budget));
+			pipelineLatency.clear();
+		}
+		windowStart = now();
+	}
+
+	// Applies the latency budget to the load based batching interval
+	double limit(double interval) const { return enabled() ? std::min(interval, maxInterval) : interval; }
+};
+
 struct ExpectedIdempotencyIdCountForKey {
 	Version commitVersion = invalidVersion;
 	int16_t idempotencyIdCount = 0;
 	uint8_t batchIndexHighByte = 0;
+	// The idempotency key directly before this one in the key space, if it is known that no other key lies between
+	Optional<std::pair<Version, uint8_t>> previousKey;
 
 	ExpectedIdempotencyIdCountForKey() {}
-	ExpectedIdempotencyIdCountForKey(Version commitVersion, int16_t idempotencyIdCount, uint8_t batchIndexHighByte)
-	  : commitVersion(commitVersion), idempotencyIdCount(idempotencyIdCount), batchIndexHighByte(batchIndexHighByte) {}
+	ExpectedIdempotencyIdCountForKey(Version commitVersion,
+	                                 int16_t idempotencyIdCount,
+	                                 uint8_t batchIndexHighByte,
+	                                 Optional<std::pair<Version, uint8_t>> previousKey)
+	  : commitVersion(commitVersion), idempotencyIdCount(idempotencyIdCount), batchIndexHighByte(batchIndexHighByte),
+	    previousKey(previousKey) {}
+};
+
+// A flat copy of the range boundaries of keyInfo, so that finding the storage servers for a mutation is a binary search
+// over contiguous key prefixes instead of a walk down keyInfo's tree. It is rebuilt periodically, and the ranges of
+// keyInfo changed since then are kept in a small overlay; keys whose range in the index touches one of them are looked
+// up in keyInfo instead.
+struct KeyInfoIndex {
+	// Begins of the ranges of keyInfo, the first 8 bytes of each as a big endian integer, and the ranges' values
+	Standalone<VectorRef<KeyRef>> begins;
+	std::vector<uint64_t> prefixes;
+	std::vector<ServerCacheInfo*> values;
+	// Ranges of keyInfo changed since the index was built
+	Standalone<VectorRef<KeyRangeRef>> changed;
+	bool valid = false;
+	// Counts changes to keyInfo, so that a rebuild can tell whether keyInfo changed while it was running
+	uint64_t changes = 0;
+
+	static uint64_t prefixOf(KeyRef key) {
+		uint64_t prefix = 0;
+		if (key.size() > 0) {
+			memcpy(&prefix, key.begin(), std::min(key.size(), (int)sizeof(prefix)));
+		}
+		return bigEndian64(prefix);
+	}
+
+	// Must be called whenever keyInfo's ranges within range are modified
+	void keyInfoChanged(KeyRangeRef range) {
+		++changes;
+		if (!valid) {
+			return;
+		}
+		if (changed.size() >= SERVER_KNOBS->PROXY_KEY_INFO_INDEX_MAX_CHANGED_RANGES) {
+			invalidate();
+			return;
+		}
+		changed.push_back_deep(changed.arena(), range);
+	}
+
+	void invalidate() {
+		++changes;
+		valid = false;
+		begins = Standalone<VectorRef<KeyRef>>();
+		prefixes.clear();
+		values.clear();
+		changed = Standalone<VectorRef<KeyRangeRef>>();
+	}
+
+	bool needsRebuild() const { return !valid || !changed.empty(); }
+
+	void install(Standalone<VectorRef<KeyRef>> newBegins, std::vector<ServerCacheInfo*>&& newValues) {
+		begins = newBegins;
+		values = std::move(newValues);
+		prefixes.clear();
+		prefixes.reserve(begins.size());
+		for (auto& b : begins) {
+			prefixes.push_back(prefixOf(b));
+		}
+		changed = Standalone<VectorRef<KeyRangeRef>>();
+		valid = true;
+	}
+
+	// Returns the value of the range of keyInfo containing key, or nullptr if it must be looked up in keyInfo
+	ServerCacheInfo* find(KeyRef key) const {
+		if (!valid) {
+			return nullptr;
+		}
+		// Begins with a smaller prefix are less than key and those with a larger one are greater, so only begins with
+		// the same prefix as key need to be compared in full
+		uint64_t prefix = prefixOf(key);
+		int lo = std::lower_bound(prefixes.begin(), prefixes.end(), prefix) - prefixes.begin();
+		int hi = std::upper_bound(prefixes.begin() + lo, prefixes.end(), prefix) - prefixes.begin();
+		int i = std::upper_bound(begins.begin() + lo, begins.begin() + hi, key) - begins.begin() - 1;
+		if (i < 0) {
+			return nullptr;
+		}
+		for (auto& r : changed) {
+			if (r.end >= begins[i] && (i + 1 == begins.size() || r.begin <= begins[i + 1])) {
+				return nullptr;
+			}
+		}
+		return values[i];
+	}
 };
 
 struct ProxyCommitData {
@@ -201,6 +363,7 @@ struct ProxyCommitData {
 	// only tracks normalKeys. This is used for tracking versions for systemKeys.
 	Deque<Version> systemKeyVersions;
 	KeyRangeMap<ServerCacheInfo> keyInfo; // keyrange -> all storage servers in all DCs for the keyrange
+	KeyInfoIndex keyInfoIndex;
 	KeyRangeMap<bool> cacheInfo;
 	std::map<Key, ApplyMutationsData> uid_applyMutationsData;
 	bool firstProxy;
@@ -208,6 +371,7 @@ struct ProxyCommitData {
 	bool locked;
 	Optional<Value> metadataVersion;
 	double commitBatchInterval;
+	CommitBatchIntervalController commitBatchIntervalController;
 	bool provisional;
 
 	int64_t localCommitBatchesStarted;
@@ -244,6 +408,10 @@ struct ProxyCommitData {
 
 	PromiseStream<ExpectedIdempotencyIdCountForKey> expectedIdempotencyIdCountForKey;
 	Standalone<VectorRef<MutationRef>> idempotencyClears;
+	// The last idempotency key written by this proxy, reset whenever another proxy's batch is given a commit version
+	// after it, since that batch may have written idempotency keys in between
+	Optional<std::pair<Version, uint8_t>> lastIdempotencyKey;
+	Version lastIdempotencyBatchVersion = invalidVersion;
 
 	AsyncVar<bool> triggerCommit;
 
@@ -251,13 +419,16 @@ struct ProxyCommitData {
 	// more CPU efficient. When a tag related to a storage server does change, we empty out all of these vectors to
 	// signify they must be repopulated. We do not repopulate them immediately to avoid a slow task.
 	const std::vector<Tag>& tagsForKey(StringRef key) {
-		auto& tags = keyInfo[key].tags;
-		if (!tags.size()) {
-			auto& r = keyInfo.rangeContaining(key).value();
-			r.populateTags();
-			return r.tags;
+		ServerCacheInfo* info = keyInfoIndex.find(key);
+		if (info) {
+			++stats.keyInfoIndexHits;
+		} else {
+			info = &keyInfo.rangeContaining(key).value();
+		}
+		if (!info->tags.size()) {
+			info->populateTags();
 		}
-		return tags;
+		return info->tags;
 	}
 
 	bool needsCacheTag(KeyRangeRef range) {
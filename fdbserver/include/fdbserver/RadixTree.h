@@ -61,15 +61,23 @@ StringRef radix_join(const StringRef& key1, const StringRef& key2, Arena& arena)
 	return StringRef(s, rsize);
 }
 
-StringRef radix_constructStr(const StringRef& key, int begin, int num, Arena& arena) {
-	int size = key.size();
-	if (begin > size) {
-		throw std::out_of_range("out of range in radix_substr<StringRef>");
-	}
-	if ((begin + num) > size) {
-		num = size - begin;
+// Keys and values too long to be stored inline get their own slab allocation, sized to fit and without the block
+// header and reference count an Arena would add to each of them. The node owning one frees it with radix_freeStr().
+StringRef radix_allocStr(const StringRef& content) {
+	uint8_t* s = (uint8_t*)allocateFast(content.size());
+	memcpy(s, content.begin(), content.size());
+	return StringRef(s, content.size());
+}
+
+void radix_freeStr(const StringRef& str) {
+	if (str.size() > 0) {
+		freeFast(str.size(), (void*)str.begin());
 	}
-	return StringRef(arena, key.substr(begin, num));
+}
+
+// The memory taken by an allocation from radix_allocStr()
+int radix_allocatedSize(const StringRef& str) {
+	return str.size() > 0 && str.size() <= 256 ? nextFastAllocatedSize(str.size()) : str.size();
 }
 
 class radix_tree {
@@ -87,34 +95,44 @@ private:
 
 	struct node {
 		// constructor for all kinds of node (root/internal/leaf)
-		node() : m_is_leaf(0), m_is_inline(0), m_inline_length(0), m_depth(0), key(), arena(), m_parent(nullptr) {}
+		node() : m_is_leaf(0), m_is_inline(0), m_inline_length(0), m_depth(0), key(), m_parent(nullptr) {}
+
+		~node() {
+			if (!m_is_inline) {
+				radix_freeStr(key.data);
+			}
+		}
 
 		node(const node&) = delete; // delete
-		node& operator=(const node& other) {
+		// Takes over the key of other, which is left empty
+		node& operator=(node&& other) {
+			if (!m_is_inline) {
+				radix_freeStr(key.data);
+			}
 			m_is_leaf = other.m_is_leaf;
 			m_is_inline = other.m_is_inline;
 			m_inline_length = other.m_inline_length;
 			m_depth = other.m_depth;
 			memcpy(key.inlineData, other.key.inlineData, INLINE_KEY_SIZE);
-			arena = other.arena;
 			m_parent = other.m_parent;
+			other.m_is_inline = 1;
+			other.m_inline_length = 0;
 
 			return *this;
 		}
 
 		void setKey(const StringRef& content, int start, int num) {
-			bool isInline = num <= INLINE_KEY_SIZE;
+			StringRef part = radix_substr(content, start, num);
+			StringRef old = m_is_inline ? StringRef() : key.data;
+			bool isInline = part.size() <= INLINE_KEY_SIZE;
 			if (isInline) {
-				memcpy(key.inlineData, content.begin() + start, num);
-				m_inline_length = num;
-				if (!m_is_inline)
-					arena = Arena();
+				memcpy(key.inlineData, part.begin(), part.size());
+				m_inline_length = part.size();
 			} else {
-				Arena new_arena(num);
-				key.data = radix_constructStr(content, start, num, new_arena);
-				arena = new_arena;
+				key.data = radix_allocStr(part);
 			}
 			m_is_inline = isInline;
+			radix_freeStr(old);
 		}
 
 		StringRef getKey() const {
@@ -135,7 +153,7 @@ private:
 			}
 		}
 
-		inline size_type getArenaSize() const { return m_is_inline ? 0 : arena.getSize(); }
+		inline size_type getArenaSize() const { return m_is_inline ? 0 : radix_allocatedSize(key.data); }
 
 		uint32_t m_is_leaf : 1;
 		uint32_t m_is_fixed : 1; // if true, then we have fixed number of children (3)
@@ -145,32 +163,32 @@ private:
 		uint32_t m_depth : 25;
 		// key is the prefix, a substring that shared by your children
 		inlineUnion key;
-		// arena assign memory for key
-		Arena arena;
 		node* m_parent;
 	};
 
 	struct leafNode : FastAllocated<leafNode> {
-		leafNode(const StringRef& content) : base(), is_inline(0), inline_length(0), arena() {
+		leafNode(const StringRef& content) : base(), is_inline(0), inline_length(0) {
 			base.m_is_leaf = 1;
 			setValue(content);
 		}
 
-		~leafNode() = default;
+		~leafNode() {
+			if (!is_inline) {
+				radix_freeStr(value.data);
+			}
+		}
 
 		void setValue(const StringRef& content) {
+			StringRef old = is_inline ? StringRef() : value.data;
 			bool isInline = content.size() <= INLINE_KEY_SIZE;
 			if (isInline) {
 				memcpy(value.inlineData, content.begin(), content.size());
 				inline_length = content.size();
-				if (!is_inline)
-					arena = Arena();
 			} else {
-				Arena new_arena(content.size());
-				value.data = StringRef(new_arena, content);
-				arena = new_arena;
+				value.data = radix_allocStr(content);
 			}
 			is_inline = isInline;
+			radix_freeStr(old);
 		}
 
 		StringRef getValue() {
@@ -181,14 +199,13 @@ private:
 			}
 		}
 
-		inline size_type getLeafArenaSize() { return is_inline ? 0 : arena.getSize(); }
+		inline size_type getLeafArenaSize() { return is_inline ? 0 : radix_allocatedSize(value.data); }
 
 		node base; // 32 bytes
 
 		uint32_t is_inline : 1;
 		uint32_t inline_length : 31;
 		inlineUnion value; // using the same data structure to store value
-		Arena arena;
 	};
 
 	struct internalNode : FastAllocated<internalNode> {
@@ -411,7 +428,9 @@ void radix_tree::add_child4(node* parent, node* child) {
 		ASSERT(parent_ref->num_children >= 3);
 
 		internalNode* new_node = new radix_tree::internalNode();
-		new_node->base = parent_ref->base; // equal operator
+		// The key moves to the new node, so it is no longer counted for the node being replaced below
+		total_bytes -= parent_ref->base.getArenaSize();
+		new_node->base = std::move(parent_ref->base);
 		for (int index = 0; index < parent_ref->num_children; index++) {
 			new_node->m_children.emplace_back(parent_ref->keys[index], parent_ref->m_children[index]);
 			parent_ref->m_children[index]->m_parent = (node*)new_node;
@@ -77,6 +77,8 @@ struct GetRateInfoReply {
 	double batchTransactionRate;
 	double leaseDuration;
 	HealthMetrics healthMetrics;
+	// The part of transactionRate that batch priority transactions may use ahead of default priority ones
+	double batchReservedRate = 0.0;
 
 	// Depending on the value of SERVER_KNOBS->ENFORCE_TAG_THROTTLING_ON_PROXIES,
 	// one of these fields may be populated
@@ -91,7 +93,8 @@ struct GetRateInfoReply {
 		           leaseDuration,
 		           healthMetrics,
 		           clientThrottledTags,
-		           proxyThrottledTags);
+		           proxyThrottledTags,
+		           batchReservedRate);
 	}
 };
 
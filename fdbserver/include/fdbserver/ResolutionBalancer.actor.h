@@ -36,6 +36,13 @@
 #include "flow/actorcompiler.h" // must be last include
 
 struct ResolutionBalancer {
+	// Load to move from one resolver to another in a round of balancing
+	struct Move {
+		int src;
+		int dest;
+		int64_t amount;
+	};
+
 	AsyncVar<Standalone<VectorRef<ResolverMoveRef>>> resolverChanges;
 	Version resolverChangesVersion = invalidVersion;
 	std::set<UID> resolverNeedingChanges;
@@ -61,5 +68,9 @@ struct ResolutionBalancer {
 	void setChangesInReply(UID requestingProxy, GetCommitVersionReply& rep);
 };
 
+// Pairs the resolvers with more than the mean of loads with those with less, and returns the moves that bring each pair
+// closer to the mean, so that one round of balancing evens out every resolver instead of only the hottest
+std::vector<ResolutionBalancer::Move> planResolutionMoves(std::vector<int64_t> const& loads);
+
 #include "flow/unactorcompiler.h"
 #endif
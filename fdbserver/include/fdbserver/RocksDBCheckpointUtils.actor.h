@@ -275,6 +275,14 @@ ACTOR Future<CheckpointMetaData> fetchRocksDBCheckpoint(Database cx,
                                                         std::string dir,
                                                         std::function<Future<Void>(const CheckpointMetaData&)> cFun);
 
+// Writes kvs, which must be non-empty, sorted and within range, to a single SST file under dir, and returns a complete
+// RocksDBKeyValues checkpoint of range. Restoring it into a shard ingests the file without going through commits, which
+// is how a bulk load hands data to a storage server.
+CheckpointMetaData buildRocksDBKeyValuesCheckpoint(const std::string& dir,
+                                                   KeyRange range,
+                                                   const Standalone<VectorRef<KeyValueRef>>& kvs,
+                                                   UID checkpointID);
+
 // Returns the total logical bytes of all *fetched* checkpoints.
 int64_t getTotalFetchedBytes(const std::vector<CheckpointMetaData>& checkpoints);
 
@@ -287,6 +295,11 @@ ICheckpointReader* newRocksDBCheckpointReader(const CheckpointMetaData& checkpoi
 
 RocksDBColumnFamilyCheckpoint getRocksCF(const CheckpointMetaData& checkpoint);
 
+// Returns the SST files of current that are not in base. SST files are immutable, so a file with the same number, size
+// and checksum in both holds the same data, and an incremental snapshot taken after base only has to copy the rest.
+std::vector<LiveFileMetaData> getChangedCheckpointFiles(const RocksDBColumnFamilyCheckpoint& base,
+                                                        const RocksDBColumnFamilyCheckpoint& current);
+
 RocksDBCheckpoint getRocksCheckpoint(const CheckpointMetaData& checkpoint);
 
 RocksDBCheckpointKeyValues getRocksKeyValuesCheckpoint(const CheckpointMetaData& checkpoint);
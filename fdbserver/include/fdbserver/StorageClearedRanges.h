@@ -0,0 +1,83 @@
+/*
+ * StorageClearedRanges.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_STORAGECLEAREDRANGES_H
+#define FDBSERVER_STORAGECLEAREDRANGES_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+// Remembers ranges of the storage engine that hold no keys, because a versioned clear of the range was applied to the
+// engine and nothing has been written to the range since. Engine reads can skip these ranges, which is most of the
+// cost of reading right after a mass delete on engines that keep cleared data around as tombstones until compaction.
+//
+// Each range carries the version of the clear that emptied it and is only skipped by reads at or after that version,
+// since a read at an older version may be served by an engine that has not committed the clear yet. The ranges are
+// disjoint, and the ones cleared longest ago are forgotten once there are more than the index's capacity.
+class StorageClearedRanges {
+public:
+	explicit StorageClearedRanges(int capacity) : capacity(capacity) {}
+
+	bool enabled() const { return capacity > 0; }
+
+	// Records that a clear of range at version has been applied to the engine
+	void cleared(KeyRangeRef range, Version version);
+
+	// Forgets the ranges overlapping range or containing key. Must be called whenever a write to them is applied to the
+	// engine.
+	void written(KeyRangeRef range);
+	void written(KeyRef key);
+
+	// Forgets every range
+	void clear();
+
+	// Returns whether the engine holds no value for key as of version
+	bool isEmpty(KeyRef key, Version version) const;
+
+	// Returns range without the empty ranges at its ends, as of version. The result is empty if all of range is.
+	KeyRange trim(KeyRangeRef range, Version version) const;
+
+	int size() const { return ranges.size(); }
+
+private:
+	struct Entry {
+		Key end;
+		Version version;
+	};
+
+	// Returns the range containing key, or ranges.end()
+	std::map<Key, Entry>::const_iterator rangeContaining(KeyRef key) const;
+
+	void erase(std::map<Key, Entry>::iterator it);
+	void insert(KeyRef begin, KeyRef end, Version version);
+
+	int capacity;
+
+	// Ranges by their begin key
+	std::map<Key, Entry> ranges;
+	// The begin keys of the ranges, by the version they were cleared at
+	std::set<std::pair<Version, Key>> byVersion;
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include "fdbclient/StorageServerInterface.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbserver/Knobs.h"
+#include "flow/MetricBTree.h"
 #include "flow/actorcompiler.h"
 
 const StringRef STORAGESERVER_HISTOGRAM_GROUP = "StorageServer"_sr;
@@ -48,8 +49,17 @@ const StringRef SS_READ_RANGE_BYTES_RETURNED_HISTOGRAM = "SSReadRangeBytesReturn
 const StringRef SS_READ_RANGE_BYTES_LIMIT_HISTOGRAM = "SSReadRangeBytesLimit"_sr;
 const StringRef SS_READ_RANGE_KV_PAIRS_RETURNED_HISTOGRAM = "SSReadRangeKVPairsReturned"_sr;
 
+// The samples hold millions of keys on a large storage server, and are searched by key and by metric for every
+// estimate and split, so they are kept in a B-tree with wide nodes. Define STORAGE_METRIC_SAMPLE_INDEXED_SET to use
+// the treap instead.
+#ifdef STORAGE_METRIC_SAMPLE_INDEXED_SET
+using StorageMetricSampleSet = IndexedSet<Key, int64_t>;
+#else
+using StorageMetricSampleSet = MetricBTree<Key, int64_t>;
+#endif
+
 struct StorageMetricSample {
-	IndexedSet<Key, int64_t> sample;
+	StorageMetricSampleSet sample;
 	int64_t metricUnitsPerSample;
 
 	explicit StorageMetricSample(int64_t metricUnitsPerSample) : metricUnitsPerSample(metricUnitsPerSample) {}
@@ -84,14 +94,25 @@ struct StorageServerMetrics {
 	// FIXME: iops is not effectively tested, and is not used by data distribution
 	TransientStorageMetricSample iopsSample, bytesWriteSample;
 	TransientStorageMetricSample bytesReadSample;
+	// The writes of the last DD_WRITE_HOT_SHARD_REACTION_TIME seconds, sampled as finely for its window as
+	// bytesWriteSample is for its own. Only kept with DD_WRITE_HOT_SHARD_DETECTION.
+	TransientStorageMetricSample bytesWriteRecentSample;
 
 	StorageServerMetrics()
 	  : byteSample(0), iopsSample(SERVER_KNOBS->IOPS_UNITS_PER_SAMPLE),
 	    bytesWriteSample(SERVER_KNOBS->BYTES_WRITTEN_UNITS_PER_SAMPLE),
-	    bytesReadSample(SERVER_KNOBS->BYTES_READ_UNITS_PER_SAMPLE) {}
+	    bytesReadSample(SERVER_KNOBS->BYTES_READ_UNITS_PER_SAMPLE),
+	    bytesWriteRecentSample(std::max<int64_t>(1,
+	                                             SERVER_KNOBS->BYTES_WRITTEN_UNITS_PER_SAMPLE *
+	                                                 SERVER_KNOBS->DD_WRITE_HOT_SHARD_REACTION_TIME /
+	                                                 SERVER_KNOBS->STORAGE_METRICS_AVERAGE_INTERVAL)) {}
 
 	StorageMetrics getMetrics(KeyRangeRef const& keys) const;
 
+	// Returns metrics, the metrics of keys, with the write bandwidth raised to the recent write bandwidth of keys if
+	// that is higher, so that a write-hot shard is reported as soon as it gets hot rather than once its average does
+	StorageMetrics withRecentWrites(KeyRangeRef const& keys, StorageMetrics metrics) const;
+
 	void notify(KeyRef key, StorageMetrics& metrics);
 
 	void notifyBytesReadPerKSecond(KeyRef key, int64_t in);
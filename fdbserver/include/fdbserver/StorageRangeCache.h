@@ -0,0 +1,90 @@
+/*
+ * StorageRangeCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_STORAGERANGECACHE_H
+#define FDBSERVER_STORAGERANGECACHE_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+#include <list>
+#include <map>
+
+// Caches the results of recent storage engine range reads, so that repeated scans of a read hot range do not go back
+// to the engine. A result depends only on the range and the limits it was read with, and stays valid until a write
+// to the range is applied to the engine, so entries carry no version. The cached ranges are disjoint, and the least
+// recently used entries are evicted once the cache holds more than its capacity.
+class StorageRangeCache {
+public:
+	StorageRangeCache(int64_t capacityBytes, int64_t maxEntryBytes)
+	  : capacityBytes(capacityBytes), maxEntryBytes(maxEntryBytes) {}
+
+	bool enabled() const { return capacityBytes > 0; }
+
+	// Returns the cached result of reading exactly range with the given limits, if there is one
+	Optional<RangeResult> get(KeyRangeRef range, int rowLimit, int byteLimit);
+
+	// The generation to pass to insert() for an engine read issued now
+	uint64_t getGeneration() const { return generation; }
+
+	// Caches result as the engine's result for range and the given limits. Nothing is cached if a write was applied to
+	// the engine after the read was issued at readGeneration, since the result might not reflect it.
+	void insert(KeyRangeRef range, int rowLimit, int byteLimit, const RangeResult& result, uint64_t readGeneration);
+
+	// Drops the entries overlapping range. Must be called whenever a write to range is applied to the engine.
+	void invalidate(KeyRangeRef range);
+	// Drops the entry containing key
+	void invalidate(KeyRef key);
+
+	// Keeps the results of the reads issued so far out of the cache. Must be called when a commit makes writes visible
+	// to engines whose reads only see committed data.
+	void invalidateReads() { ++generation; }
+
+	// Drops every entry
+	void clear();
+
+	int64_t getBytes() const { return bytes; }
+	int size() const { return entries.size(); }
+
+private:
+	struct Entry {
+		Key end;
+		int rowLimit;
+		int byteLimit;
+		RangeResult result;
+		int64_t bytes;
+		std::list<Key>::iterator lru;
+	};
+
+	void erase(std::map<Key, Entry>::iterator it);
+	void eraseOverlapping(KeyRangeRef range);
+
+	int64_t capacityBytes;
+	int64_t maxEntryBytes;
+	int64_t bytes = 0;
+	uint64_t generation = 0;
+
+	// Entries by the begin key of their range
+	std::map<Key, Entry> entries;
+	// The begin keys of the entries, least recently used first
+	std::list<Key> lru;
+};
+
+#endif
@@ -37,6 +37,7 @@ class DDTeamCollection;
 class TCServerInfo : public ReferenceCounted<TCServerInfo> {
 	friend class TCServerInfoImpl;
 	friend class DDTeamCollectionUnitTest;
+	friend struct MockDDPlacementBenchmarkWorkload;
 	UID id;
 	bool inDesiredDC;
 	DDTeamCollection* collection;
@@ -26,6 +26,7 @@
 #include "fdbclient/CommitTransaction.h"
 #include "fdbclient/MutationList.h"
 #include "fdbclient/StorageServerInterface.h"
+#include "flow/CompressionUtils.h"
 #include <iterator>
 
 struct TLogInterface {
@@ -193,6 +194,11 @@ struct TLogPeekReply {
 	}
 };
 
+template <>
+struct payload_arena_traits<TLogPeekReply> {
+	static Arena const* arena(TLogPeekReply const& reply) { return &reply.arena; }
+};
+
 struct TLogPeekRequest {
 	constexpr static FileIdentifier file_identifier = 11001131;
 	Version begin;
@@ -305,6 +311,8 @@ struct TLogCommitRequest {
 	ReplyPromise<TLogCommitReply> reply;
 	int tLogCount;
 	Optional<UID> debugID;
+	// Set when messages is compressed with this filter, which the receiving TLog must undo with decompressMessages()
+	Optional<CompressionFilter> messagesCompression;
 
 	TLogCommitRequest() {}
 	TLogCommitRequest(const SpanContext& context,
@@ -319,6 +327,25 @@ struct TLogCommitRequest {
 	  : spanContext(context), arena(a), prevVersion(prevVersion), version(version),
 	    knownCommittedVersion(knownCommittedVersion), minKnownCommittedVersion(minKnownCommittedVersion),
 	    messages(messages), tLogCount(tLogCount), debugID(debugID) {}
+
+	// Compresses messages with filter, unless that does not make it smaller
+	void compressMessages(CompressionFilter filter) {
+		Arena compressedArena;
+		StringRef compressed = CompressionUtils::compress(filter, messages, compressedArena);
+		if (compressed.size() < messages.size()) {
+			arena.dependsOn(compressedArena);
+			messages = compressed;
+			messagesCompression = filter;
+		}
+	}
+
+	void decompressMessages() {
+		if (messagesCompression.present()) {
+			messages = CompressionUtils::decompress(messagesCompression.get(), messages, arena);
+			messagesCompression.reset();
+		}
+	}
+
 	template <class Ar>
 	void serialize(Ar& ar) {
 		serializer(ar,
@@ -331,6 +358,7 @@ struct TLogCommitRequest {
 		           debugID,
 		           tLogCount,
 		           spanContext,
+		           messagesCompression,
 		           arena);
 	}
 };
@@ -101,6 +101,10 @@ public:
 
 	Optional<Reference<TCTenantInfo>> tenantOwning(KeyRef key) const;
 
+	// Returns the boundary of the tenant owning key that lies strictly inside within, preferring the tenant's
+	// beginning, or key itself if it is not in a tenant or the tenant covers within
+	Key alignToTenantBoundary(KeyRef key, KeyRangeRef within) const;
+
 	// Get the list of tenants where the storage bytes currently used is greater than the quota allocated
 	std::unordered_set<int64_t> getTenantsOverQuota() const;
 };
\ No newline at end of file
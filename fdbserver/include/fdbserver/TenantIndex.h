@@ -0,0 +1,72 @@
+/*
+ * TenantIndex.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FDBSERVER_TENANTINDEX_H
+#define FDBSERVER_TENANTINDEX_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+
+#include <deque>
+#include <map>
+#include <vector>
+
+// The tenants a storage server knows of, for checking which tenants exist at the versions it can read. Tenants that
+// existed at the last fold sit in a sorted array, which a lookup binary searches without chasing pointers. Creations
+// and removals since are kept by tenant, and folded into the array once enough of them are older than the oldest
+// readable version, so lookups rarely have more than a few of them to look through.
+class TenantIndex {
+public:
+	// Creates the tenant for reads at version and later. Versions of changes must not decrease.
+	void insert(int64_t tenantId, Version version);
+	// Removes the tenant for reads at version and later
+	void erase(int64_t tenantId, Version version);
+
+	// Reads take a version at or after the oldest readable one, or latestVersion
+	bool contains(int64_t tenantId, Version version) const;
+	// Whether any tenant with an id in [beginId, endId] exists at version
+	bool containsAnyInRange(int64_t beginId, int64_t endId, Version version) const;
+	// The ids in [beginId, endId) of the tenants that exist at version, in order
+	std::vector<int64_t> getRange(int64_t beginId, int64_t endId, Version version) const;
+
+	// Reads at versions before oldestVersion will not be asked for again
+	void forgetVersionsBefore(Version oldestVersion);
+	Version getOldestVersion() const { return oldestVersion; }
+	Version getLatestVersion() const { return latestVersion; }
+
+private:
+	// Sorted ids of the tenants as of the last fold
+	std::vector<int64_t> folded;
+	// For each tenant changed since the last fold, the versions it was created (true) or removed at, in order
+	std::map<int64_t, std::vector<std::pair<Version, bool>>> changes;
+	// The changes in version order, to find the ones to fold
+	std::deque<std::pair<Version, int64_t>> changeLog;
+	size_t foldableChanges = 0; // The first changes in changeLog, at or before oldestVersion
+	Version oldestVersion = 0;
+	Version latestVersion = 0;
+
+	void addChange(int64_t tenantId, Version version, bool exists);
+	// Whether the tenant exists at version, given whether it is in folded
+	bool existsAt(int64_t tenantId, bool isFolded, Version version) const;
+	void fold();
+};
+
+#endif
@@ -31,12 +31,17 @@ public:
 	TransactionTagCounter(UID thisServerID);
 	~TransactionTagCounter();
 
-	// Update counters tracking the busyness of each tag in the current interval
-	void addRequest(Optional<TagSet> const& tags, int64_t bytes);
+	// Update counters tracking the busyness of each tag in the current interval. An untagged request
+	// is counted against the prefix of key instead.
+	void addRequest(Optional<TagSet> const& tags, KeyRef key, int64_t bytes);
 
 	// Save current set of busy tags and reset counters for next interval
 	void startNewInterval();
 
 	// Returns the set of busiest tags as of the end of the last interval
 	std::vector<StorageQueuingMetricsReply::TagInfo> const& getBusiestTags() const;
+
+	// Returns the key prefixes untagged requests were busiest on as of the end of the last interval,
+	// with the prefix in place of the tag
+	std::vector<StorageQueuingMetricsReply::TagInfo> const& getBusiestKeyPrefixes() const;
 };
@@ -29,6 +29,7 @@
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 constexpr int WLTOKEN_NETWORKTEST = WLTOKEN_FIRST_AVAILABLE;
+constexpr int WLTOKEN_NETWORKTEST_STREAM = WLTOKEN_FIRST_AVAILABLE + 1;
 
 struct LatencyStats {
 	using sample = double;
@@ -59,14 +60,19 @@ struct LatencyStats {
 };
 
 NetworkTestInterface::NetworkTestInterface(NetworkAddress remote)
-  : test(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST)) {}
+  : test(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST)),
+    testStream(Endpoint::wellKnown({ remote }, WLTOKEN_NETWORKTEST_STREAM)) {}
 
 NetworkTestInterface::NetworkTestInterface(INetwork* local) {
 	test.makeWellKnownEndpoint(WLTOKEN_NETWORKTEST, TaskPriority::DefaultEndpoint);
+	testStream.makeWellKnownEndpoint(WLTOKEN_NETWORKTEST_STREAM, TaskPriority::DefaultEndpoint);
 }
 
+ACTOR Future<Void> networkTestStreamingServer(NetworkTestInterface interf);
+
 ACTOR Future<Void> networkTestServer() {
 	state NetworkTestInterface interf(g_network);
+	state Future<Void> streaming = networkTestStreamingServer(interf);
 	state Future<Void> logging = delay(1.0);
 	state double lastTime = now();
 	state int sent = 0;
@@ -96,44 +102,55 @@ ACTOR Future<Void> networkTestServer() {
 	}
 }
 
-ACTOR Future<Void> networkTestStreamingServer() {
-	state NetworkTestInterface interf(g_network);
+ACTOR Future<Void> networkTestSendStream(NetworkTestStreamingRequest req, int* sent, LatencyStats* latency) {
+	state LatencyStats::sample sample = latency->tick();
+	state Value value(std::string(req.replySize, '.'));
+	state int i = 0;
+	try {
+		for (; i < req.replies; ++i) {
+			wait(req.reply.onReady());
+			req.reply.send(NetworkTestStreamingReply(i, value));
+		}
+		req.reply.sendError(end_of_stream());
+		latency->tock(sample);
+		(*sent)++;
+	} catch (Error& e) {
+		// The client went away
+		if (e.code() != error_code_operation_obsolete && e.code() != error_code_broken_promise) {
+			throw e;
+		}
+	}
+	return Void();
+}
+
+// Serves streams concurrently, each sending its replies as fast as the client's flow control allows
+ACTOR Future<Void> networkTestStreamingServer(NetworkTestInterface interf) {
+	state ActorCollection streams(false);
 	state Future<Void> logging = delay(1.0);
 	state double lastTime = now();
 	state int sent = 0;
 	state LatencyStats latency;
 
 	loop {
-		try {
-			choose {
-				when(state NetworkTestStreamingRequest req = waitNext(interf.testStream.getFuture())) {
-					state LatencyStats::sample sample = latency.tick();
-					state int i = 0;
-					for (; i < 100; ++i) {
-						wait(req.reply.onReady());
-						req.reply.send(NetworkTestStreamingReply{ i });
-					}
-					req.reply.sendError(end_of_stream());
-					latency.tock(sample);
-					sent++;
-				}
-				when(wait(logging)) {
+		choose {
+			when(NetworkTestStreamingRequest req = waitNext(interf.testStream.getFuture())) {
+				streams.add(networkTestSendStream(req, &sent, &latency));
+			}
+			when(wait(logging)) {
+				if (sent) {
 					auto spd = sent / (now() - lastTime);
 					if (FLOW_KNOBS->NETWORK_TEST_SCRIPT_MODE) {
 						fprintf(stderr, "%f\t%.3f\t%.3f\n", spd, latency.mean() * 1e6, latency.stddev() * 1e6);
 					} else {
-						fprintf(stderr, "responses per second: %f (%f us)\n", spd, latency.mean() * 1e6);
+						fprintf(stderr, "streams per second: %f (%f us)\n", spd, latency.mean() * 1e6);
 					}
-					latency.reset();
-					lastTime = now();
-					sent = 0;
-					logging = delay(1.0);
 				}
+				latency.reset();
+				lastTime = now();
+				sent = 0;
+				logging = delay(1.0);
 			}
-		} catch (Error& e) {
-			if (e.code() != error_code_operation_obsolete) {
-				throw e;
-			}
+			when(wait(streams.getResult())) {}
 		}
 	}
 }
@@ -186,7 +203,8 @@ ACTOR Future<Void> testClientStream(std::vector<NetworkTestInterface> interfs,
 		sample = latency->tick();
 		state ReplyPromiseStream<NetworkTestStreamingReply> stream =
 		    interfs[deterministicRandom()->randomInt(0, interfs.size())].testStream.getReplyStream(
-		        NetworkTestStreamingRequest{});
+		        NetworkTestStreamingRequest(FLOW_KNOBS->NETWORK_TEST_STREAM_REPLIES,
+		                                    FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE));
 		state int j = 0;
 		try {
 			loop {
@@ -203,6 +221,62 @@ ACTOR Future<Void> testClientStream(std::vector<NetworkTestInterface> interfs,
 	return Void();
 }
 
+// Sends each request to every server at once and waits for all of the replies, the way commit proxies send to every
+// resolver and log, and GRV proxies confirm their epoch with the logs
+ACTOR Future<Void> testClientFanout(std::vector<NetworkTestInterface> interfs,
+                                    int* sent,
+                                    int* completed,
+                                    LatencyStats* latency) {
+	state std::string request_payload(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE, '.');
+	state LatencyStats::sample sample;
+
+	while (moreRequestsPending(*sent)) {
+		(*sent)++;
+		sample = latency->tick();
+		std::vector<Future<NetworkTestReply>> replies;
+		replies.reserve(interfs.size());
+		for (auto& interf : interfs) {
+			replies.push_back(retryBrokenPromise(
+			    interf.test, NetworkTestRequest(StringRef(request_payload), FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE)));
+		}
+		wait(waitForAll(replies));
+		latency->tock(sample);
+		(*completed)++;
+	}
+	return Void();
+}
+
+// Resets the connection to a server after every NETWORK_TEST_CHURN_REQUESTS requests to it, so that connections (and
+// TLS handshakes, with TLS addresses) are made at the rate clients of a large cluster come and go
+ACTOR Future<Void> testClientChurn(std::vector<NetworkTestInterface> interfs,
+                                   int* sent,
+                                   int* completed,
+                                   LatencyStats* latency) {
+	state std::string request_payload(FLOW_KNOBS->NETWORK_TEST_REQUEST_SIZE, '.');
+	state LatencyStats::sample sample;
+	state int requests = 0;
+
+	while (moreRequestsPending(*sent)) {
+		(*sent)++;
+		state NetworkTestInterface interf = interfs[deterministicRandom()->randomInt(0, interfs.size())];
+		sample = latency->tick();
+		try {
+			wait(success(retryBrokenPromise(
+			    interf.test, NetworkTestRequest(StringRef(request_payload), FLOW_KNOBS->NETWORK_TEST_REPLY_SIZE))));
+		} catch (Error& e) {
+			if (e.code() != error_code_request_maybe_delivered) {
+				throw;
+			}
+		}
+		latency->tock(sample);
+		(*completed)++;
+		if (++requests % FLOW_KNOBS->NETWORK_TEST_CHURN_REQUESTS == 0) {
+			FlowTransport::transport().resetConnection(interf.test.getEndpoint().getPrimaryAddress());
+		}
+	}
+	return Void();
+}
+
 ACTOR Future<Void> logger(int* sent, int* completed, LatencyStats* latency) {
 	state double lastTime = now();
 	state int logged = 0;
@@ -301,10 +375,21 @@ ACTOR Future<Void> networkTestClient(std::string testServers) {
 		interfs.push_back(NetworkTestInterface(servers[i]));
 	}
 
+	// Large replies, of the size of range reads and log peeks, come from setting NETWORK_TEST_REPLY_SIZE with any
+	// pattern
 	state std::vector<Future<Void>> clients;
 	clients.reserve(FLOW_KNOBS->NETWORK_TEST_CLIENT_COUNT);
 	for (int i = 0; i < FLOW_KNOBS->NETWORK_TEST_CLIENT_COUNT; i++) {
-		clients.push_back(testClient(interfs, &sent, &completed, &latency));
+		if (FLOW_KNOBS->NETWORK_TEST_PATTERN == "fanout") {
+			clients.push_back(testClientFanout(interfs, &sent, &completed, &latency));
+		} else if (FLOW_KNOBS->NETWORK_TEST_PATTERN == "stream") {
+			clients.push_back(testClientStream(interfs, &sent, &completed, &latency));
+		} else if (FLOW_KNOBS->NETWORK_TEST_PATTERN == "churn") {
+			clients.push_back(testClientChurn(interfs, &sent, &completed, &latency));
+		} else {
+			ASSERT(FLOW_KNOBS->NETWORK_TEST_PATTERN == "request");
+			clients.push_back(testClient(interfs, &sent, &completed, &latency));
+		}
 	}
 	clients.push_back(logger(&sent, &completed, &latency));
 
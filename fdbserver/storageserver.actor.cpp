@@ -86,6 +86,9 @@
 #include "fdbserver/ServerDBInfo.h"
 #include "fdbserver/SpanContextMessage.h"
 #include "fdbserver/StorageMetrics.actor.h"
+#include "fdbserver/StorageClearedRanges.h"
+#include "fdbserver/StorageRangeCache.h"
+#include "fdbserver/TenantIndex.h"
 #include "fdbserver/TLogInterface.h"
 #include "fdbserver/TransactionTagCounter.h"
 #include "fdbserver/WaitFailure.h"
@@ -389,14 +392,14 @@ struct StorageServerDisk {
 
 	Future<Void> addRange(KeyRangeRef range, std::string id) { return storage->addRange(range, id); }
 
-	std::vector<std::string> removeRange(KeyRangeRef range) { return storage->removeRange(range); }
+	std::vector<std::string> removeRange(KeyRangeRef range);
 
 	void persistRangeMapping(KeyRangeRef range, bool isAdd) { storage->persistRangeMapping(range, isAdd); }
 
 	Future<Void> getError() { return storage->getError(); }
 	Future<Void> init() { return storage->init(); }
 	Future<Void> canCommit() { return storage->canCommit(); }
-	Future<Void> commit() { return storage->commit(); }
+	Future<Void> commit();
 
 	// SOMEDAY: Put readNextKeyInclusive in IKeyValueStore
 	// Read the key that is equal or greater then 'key' from the storage engine.
@@ -428,7 +431,9 @@ struct StorageServerDisk {
 
 	Future<CheckpointMetaData> checkpoint(const CheckpointRequest& request) { return storage->checkpoint(request); }
 
-	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints) { return storage->restore(checkpoints); }
+	Reference<IKeyValueStoreSnapshot> pinSnapshot() { return storage->pinSnapshot(); }
+
+	Future<Void> restore(const std::vector<CheckpointMetaData>& checkpoints);
 
 	Future<Void> deleteCheckpoint(const CheckpointMetaData& checkpoint) {
 		return storage->deleteCheckpoint(checkpoint);
@@ -451,7 +456,7 @@ struct StorageServerDisk {
 private:
 	struct StorageServer* data;
 	IKeyValueStore* storage;
-	void writeMutations(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
+	void writeMutations(const VectorRef<MutationRef>& mutations, Version version, const char* debugContext);
 
 	ACTOR static Future<Key> readFirstKey(IKeyValueStore* storage, KeyRangeRef range, Optional<ReadOptions> options) {
 		RangeResult r = wait(storage->readRange(range, 1, 1 << 30, options));
@@ -782,7 +787,8 @@ private:
 	VersionedData versionedData;
 	std::map<Version, Standalone<VerUpdateRef>> mutationLog; // versions (durableVersion, version]
 
-	using WatchMapKey = std::pair<int64_t, Key>;
+	// The key refers to the key of the ServerWatchMetadata in the entry, so that lookups do not copy the key
+	using WatchMapKey = std::pair<int64_t, KeyRef>;
 	using WatchMapKeyHasher = boost::hash<WatchMapKey>;
 	using WatchMapValue = Reference<ServerWatchMetadata>;
 	using WatchMap_t = std::unordered_map<WatchMapKey, WatchMapValue, WatchMapKeyHasher>;
@@ -805,7 +811,38 @@ public:
 	std::map<Version, std::vector<CheckpointMetaData>> pendingCheckpoints; // Pending checkpoint requests
 	std::unordered_map<UID, CheckpointMetaData> checkpoints; // Existing and deleting checkpoints
 	std::unordered_map<UID, ICheckpointReader*> liveCheckpointReaders; // Active checkpoint readers
-	VersionedMap<int64_t, Void> tenantMap;
+
+	// A storage engine snapshot taken when its version was durable, which serves reads at that version after it falls
+	// out of versionedData (see PinReadVersionRequest)
+	struct PinnedSnapshot {
+		Reference<IKeyValueStoreSnapshot> snapshot;
+		std::vector<KeyRange> readable; // The ranges readable at the version, sorted and coalesced
+		double leaseExpires;
+
+		// Returns the readable range containing key, or an empty range if there is none
+		KeyRangeRef readableRange(KeyRef key) const {
+			auto r = std::upper_bound(
+			    readable.begin(), readable.end(), key, [](KeyRef k, KeyRange const& range) { return k < range.begin; });
+			if (r == readable.begin() || !(--r)->contains(key)) {
+				return KeyRangeRef();
+			}
+			return *r;
+		}
+	};
+	std::map<Version, PinnedSnapshot> pinnedSnapshots;
+	// Versions to pin once they are durable. Storage commits stop at each of them.
+	std::map<Version, Promise<Void>> pendingPins;
+
+	// Returns the snapshot pinned at version, if any, and extends its lease
+	PinnedSnapshot* getPinnedSnapshot(Version version) {
+		auto pin = pinnedSnapshots.find(version);
+		if (pin == pinnedSnapshots.end()) {
+			return nullptr;
+		}
+		pin->second.leaseExpires = now() + SERVER_KNOBS->STORAGE_PINNED_SNAPSHOT_LEASE;
+		return &pin->second;
+	}
+	TenantIndex tenantMap;
 	std::map<Version, std::vector<PendingNewShard>>
 	    pendingAddRanges; // Pending requests to add ranges to physical shards
 	std::map<Version, std::vector<KeyRange>>
@@ -844,6 +881,40 @@ public:
 	Reference<Histogram> readRangeBytesLimitHistogram;
 	Reference<Histogram> readRangeKVPairsReturnedHistogram;
 
+	// Where the time of reads goes, by read priority: waiting for the read lock, waiting for their version, and
+	// reading the in-memory versioned data and the storage engine
+	struct ReadPhaseHistograms {
+		Reference<Histogram> queueWait;
+		Reference<Histogram> versionWait;
+		Reference<Histogram> read;
+
+		explicit ReadPhaseHistograms(std::string const& readType)
+		  : queueWait(Histogram::getHistogram(STORAGESERVER_HISTOGRAM_GROUP,
+		                                      StringRef("SSReadQueueWait" + readType),
+		                                      Histogram::Unit::milliseconds)),
+		    versionWait(Histogram::getHistogram(STORAGESERVER_HISTOGRAM_GROUP,
+		                                        StringRef("SSReadVersionWait" + readType),
+		                                        Histogram::Unit::milliseconds)),
+		    read(Histogram::getHistogram(STORAGESERVER_HISTOGRAM_GROUP,
+		                                 StringRef("SSRead" + readType),
+		                                 Histogram::Unit::milliseconds)) {}
+
+		// Indexed by ReadType
+		static std::vector<ReadPhaseHistograms> forReadTypes() {
+			std::vector<ReadPhaseHistograms> histograms;
+			for (auto readType : { "Eager", "Fetch", "Low", "Normal", "High" }) {
+				histograms.emplace_back(readType);
+			}
+			ASSERT(histograms.size() == (int)ReadType::MAX + 1);
+			return histograms;
+		}
+	};
+	std::vector<ReadPhaseHistograms> readPhaseHistograms = ReadPhaseHistograms::forReadTypes();
+
+	ReadPhaseHistograms& readPhases(Optional<ReadOptions> const& options) {
+		return readPhaseHistograms[(int)(options.present() ? options.get().type : ReadType::NORMAL)];
+	}
+
 	// watch map operations
 	Reference<ServerWatchMetadata> getWatchMetadata(KeyRef key, int64_t tenantId) const;
 	KeyRef setWatchMetadata(Reference<ServerWatchMetadata> metadata);
@@ -912,6 +983,11 @@ public:
 	std::map<Version, Arena>
 	    freeable; // for each version, an Arena that must be held until that version is < oldestVersion
 	Arena lastArena;
+	// Values of recent sets copied into lastArena, so that another set of one of them can share its bytes
+	std::unordered_set<StringRef> lastArenaValues;
+	// Bytes of keys and values copied into the arenas of each version in mutationLog, and their sum
+	std::map<Version, int64_t> mutationLogBytesByVersion;
+	int64_t mutationLogBytes = 0;
 	double cpuUsage;
 	double diskUsage;
 
@@ -988,8 +1064,10 @@ public:
 		// ...or create a new one
 		auto& u = mutationLog[v];
 		u.version = v;
-		if (lastArena.getSize() >= 65536)
+		if (lastArena.getSize() >= 65536) {
 			lastArena = Arena(4096);
+			lastArenaValues.clear();
+		}
 		u.arena() = lastArena;
 		counters.bytesInput += VERSION_OVERHEAD;
 		return u;
@@ -998,9 +1076,48 @@ public:
 	MutationRef addMutationToMutationLog(Standalone<VerUpdateRef>& mLV, MutationRef const& m) {
 		byteSampleApplyMutation(m, mLV.version);
 		counters.bytesInput += mvccStorageBytes(m);
+		int64_t& versionBytes = mutationLogBytesByVersion[mLV.version];
+		if (m.type == MutationRef::SetValue && m.param2.size() >= SERVER_KNOBS->STORAGE_DEDUPLICATE_VALUE_MIN_BYTES &&
+		    SERVER_KNOBS->STORAGE_DEDUPLICATE_VALUES_MAX > 0 && mLV.arena().sameArena(lastArena)) {
+			// The shared value is in the arena of this version, so it lives as long as this mutation
+			auto value = lastArenaValues.find(m.param2);
+			if (value != lastArenaValues.end()) {
+				++counters.deduplicatedValues;
+				counters.deduplicatedValueBytes += m.param2.size();
+				versionBytes += m.param1.size();
+				mutationLogBytes += m.param1.size();
+				MutationRef shared((MutationRef::Type)m.type, KeyRef(mLV.arena(), m.param1), *value);
+				mLV.mutations.push_back(mLV.arena(), shared);
+				return mLV.mutations.back();
+			}
+			MutationRef copied = mLV.push_back_deep(mLV.arena(), m);
+			if (lastArenaValues.size() >= (size_t)SERVER_KNOBS->STORAGE_DEDUPLICATE_VALUES_MAX) {
+				lastArenaValues.clear();
+			}
+			lastArenaValues.insert(copied.param2);
+			versionBytes += m.expectedSize();
+			mutationLogBytes += m.expectedSize();
+			return copied;
+		}
+		versionBytes += m.expectedSize();
+		mutationLogBytes += m.expectedSize();
 		return mLV.push_back_deep(mLV.arena(), m);
 	}
 
+	// Memory held by the arenas of the versions in mutationLog. Versions share an arena until it reaches 64KB, so an
+	// arena is held until the last of its versions is durable.
+	int64_t mutationLogArenaBytes() const {
+		int64_t bytes = 0;
+		const Arena* last = nullptr;
+		for (auto const& [version, update] : mutationLog) {
+			if (!last || !update.arena().sameArena(*last)) {
+				bytes += update.arena().getSize(FastInaccurateEstimate::True);
+				last = &update.arena();
+			}
+		}
+		return bytes;
+	}
+
 	void setTssPair(UID pairId) {
 		tssPairID = Optional<UID>(pairId);
 
@@ -1040,6 +1157,13 @@ public:
 
 	KeyRangeMap<bool> cachedRangeMap; // indicates if a key-range is being cached
 
+	// Results of recent storage engine reads of read hot ranges, invalidated as writes are applied to the engine
+	StorageRangeCache rangeReadCache{ SERVER_KNOBS->STORAGE_RANGE_CACHE_BYTES,
+		                              SERVER_KNOBS->STORAGE_RANGE_CACHE_MAX_ENTRY_BYTES };
+
+	// Engine ranges emptied by clears that have been made durable, which engine reads need not look at
+	StorageClearedRanges clearedRanges{ SERVER_KNOBS->STORAGE_CLEARED_RANGES };
+
 	KeyRangeMap<std::vector<Reference<ChangeFeedInfo>>> keyChangeFeed;
 	std::unordered_map<Key, Reference<ChangeFeedInfo>> uidChangeFeed;
 	Deque<std::pair<std::vector<Key>, Version>> changeFeedVersions;
@@ -1182,7 +1306,16 @@ public:
 		Counter allQueries, systemKeyQueries, getKeyQueries, getValueQueries, getRangeQueries, getRangeSystemKeyQueries,
 		    getRangeStreamQueries, finishedQueries, lowPriorityQueries, rowsQueried, bytesQueried, watchQueries,
 		    emptyQueries, feedRowsQueried, feedBytesQueried, feedStreamQueries, rejectedFeedStreamQueries,
-		    feedVersionQueries;
+		    feedStreamCoalescedReplies, feedVersionQueries, getValuesQueries, getRangeAggregateQueries;
+
+		// Sets stored in the mutation log sharing the bytes of an identical value already there, and the bytes saved
+		Counter deduplicatedValues, deduplicatedValueBytes;
+
+		// Range read replies compressed for clients that asked for it, and the bytes that saved
+		Counter compressedRangeReplies, rangeReplyBytesSavedByCompression;
+
+		// Reads served from a pinned storage engine snapshot
+		Counter pinnedSnapshotReads;
 
 		// counters related to getMappedRange queries
 		Counter getMappedRangeBytesQueried, finishedGetMappedRangeSecondaryQueries, getMappedRangeQueries,
@@ -1236,6 +1369,8 @@ public:
 		// means fallback if fallback is enabled, otherwise means failure (so that another layer could implement
 		// fallback).
 		Counter quickGetValueHit, quickGetValueMiss, quickGetKeyValuesHit, quickGetKeyValuesMiss;
+		// Secondary lookups of getMappedRangeQueries answered by another lookup of the same request for the same key
+		Counter mappedRangeDuplicateLookups;
 
 		// The number of logical bytes returned from storage engine, in response to readRange operations.
 		Counter kvScanBytes;
@@ -1243,6 +1378,8 @@ public:
 		Counter kvGetBytes;
 		// The number of keys read from storage engine by eagerReads.
 		Counter eagerReadsKeys;
+		// The number of atomic op base values eagerReads found in memory instead of reading them from storage engine.
+		Counter eagerReadsFromMemory;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
 		// The count of readValue operation to the storage engine.
@@ -1251,6 +1388,13 @@ public:
 		Counter kvCommits;
 		// The count of change feed reads that hit disk
 		Counter changeFeedDiskReads;
+		// The count of readRange operations served by the range read cache instead of the storage engine
+		Counter kvScanCacheHits;
+		// The count of readValue and readRange operations not sent to the storage engine because the engine was known
+		// to hold nothing there, and of readRange operations narrowed down for the same reason
+		Counter kvGetsSkipped;
+		Counter kvScansSkipped;
+		Counter kvScansTrimmed;
 
 		LatencySample readLatencySample;
 		LatencySample readKeyLatencySample;
@@ -1259,6 +1403,7 @@ public:
 		LatencySample readVersionWaitSample;
 		LatencySample readQueueWaitSample;
 		LatencySample kvReadRangeLatencySample;
+		LatencySample kvReadValueLatencySample;
 		LatencySample updateLatencySample;
 
 		LatencyBands readLatencyBands;
@@ -1276,7 +1421,13 @@ public:
 		    rowsQueried("RowsQueried", cc), bytesQueried("BytesQueried", cc), watchQueries("WatchQueries", cc),
 		    emptyQueries("EmptyQueries", cc), feedRowsQueried("FeedRowsQueried", cc),
 		    feedBytesQueried("FeedBytesQueried", cc), feedStreamQueries("FeedStreamQueries", cc),
-		    rejectedFeedStreamQueries("RejectedFeedStreamQueries", cc), feedVersionQueries("FeedVersionQueries", cc),
+		    rejectedFeedStreamQueries("RejectedFeedStreamQueries", cc),
+		    feedStreamCoalescedReplies("FeedStreamCoalescedReplies", cc), feedVersionQueries("FeedVersionQueries", cc),
+		    getValuesQueries("GetValuesQueries", cc), getRangeAggregateQueries("GetRangeAggregateQueries", cc),
+		    deduplicatedValues("DeduplicatedValues", cc), deduplicatedValueBytes("DeduplicatedValueBytes", cc),
+		    compressedRangeReplies("CompressedRangeReplies", cc),
+		    rangeReplyBytesSavedByCompression("RangeReplyBytesSavedByCompression", cc),
+		    pinnedSnapshotReads("PinnedSnapshotReads", cc),
 		    bytesInput("BytesInput", cc), logicalBytesInput("LogicalBytesInput", cc),
 		    logicalBytesMoveInOverhead("LogicalBytesMoveInOverhead", cc),
 		    kvCommitLogicalBytes("KVCommitLogicalBytes", cc), kvClearRanges("KVClearRanges", cc),
@@ -1293,9 +1444,13 @@ public:
 		    wrongShardServer("WrongShardServer", cc), fetchedVersions("FetchedVersions", cc),
 		    fetchesFromLogs("FetchesFromLogs", cc), quickGetValueHit("QuickGetValueHit", cc),
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
-		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
-		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
+		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc),
+		    mappedRangeDuplicateLookups("MappedRangeDuplicateLookups", cc), kvScanBytes("KVScanBytes", cc),
+		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc),
+		    eagerReadsFromMemory("EagerReadsFromMemory", cc), kvGets("KVGets", cc),
 		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
+		    kvScanCacheHits("KVScanCacheHits", cc), kvGetsSkipped("KVGetsSkipped", cc),
+		    kvScansSkipped("KVScansSkipped", cc), kvScansTrimmed("KVScansTrimmed", cc),
 		    getMappedRangeBytesQueried("GetMappedRangeBytesQueried", cc),
 		    finishedGetMappedRangeQueries("FinishedGetMappedRangeQueries", cc),
 		    finishedGetMappedRangeSecondaryQueries("FinishedGetMappedRangeSecondaryQueries", cc),
@@ -1340,6 +1495,10 @@ public:
 		                             self->thisServerID,
 		                             SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 		                             SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+		    kvReadValueLatencySample("KVGetValueMetrics",
+		                             self->thisServerID,
+		                             SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+		                             SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 		    updateLatencySample("UpdateLatencyMetrics",
 		                        self->thisServerID,
 		                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
@@ -1353,6 +1512,8 @@ public:
 			specialCounter(cc, "LocalRate", [self] { return int64_t(self->currentRate() * 100); });
 
 			specialCounter(cc, "BytesReadSampleCount", [self]() { return self->metrics.bytesReadSample.queue.size(); });
+			specialCounter(cc, "KVScanCacheBytes", [self]() { return self->rangeReadCache.getBytes(); });
+			specialCounter(cc, "ClearedRanges", [self]() { return self->clearedRanges.size(); });
 			specialCounter(
 			    cc, "FetchKeysFetchActive", [self]() { return self->fetchKeysParallelismLock.activePermits(); });
 			specialCounter(cc, "FetchKeysWaiting", [self]() { return self->fetchKeysParallelismLock.waiters(); });
@@ -1383,6 +1544,10 @@ public:
 			specialCounter(cc, "ActiveChangeFeeds", [self]() { return self->uidChangeFeed.size(); });
 			specialCounter(cc, "ActiveChangeFeedQueries", [self]() { return self->activeFeedQueries; });
 			specialCounter(cc, "ChangeFeedMemoryBytes", [self]() { return self->changeFeedMemoryBytes; });
+			specialCounter(cc, "MutationLogLiveBytes", [self]() { return self->mutationLogBytes; });
+			specialCounter(cc, "MutationLogFragmentedBytes", [self]() {
+				return std::max<int64_t>(0, self->mutationLogArenaBytes() - self->mutationLogBytes);
+			});
 		}
 	} counters;
 
@@ -1764,7 +1929,9 @@ KeyRef StorageServer::setWatchMetadata(Reference<ServerWatchMetadata> metadata)
 	int64_t tenantId = metadata->tenantId;
 	const WatchMapKey mapKey(tenantId, keyRef);
 
-	watchMap[mapKey] = metadata;
+	// An entry being replaced may have its key in the old metadata, so replace the key along with the value
+	watchMap.erase(mapKey);
+	watchMap.emplace(mapKey, metadata);
 	return keyRef;
 }
 
@@ -2079,10 +2246,9 @@ ACTOR Future<Version> waitForMinVersion(StorageServer* data, Version version) {
 
 void StorageServer::checkTenantEntry(Version version, TenantInfo tenantInfo) {
 	if (tenantInfo.hasTenant()) {
-		ASSERT(version == latestVersion || (version >= tenantMap.oldestVersion && version <= this->version.get()));
-		auto view = tenantMap.at(version);
-		auto itr = view.find(tenantInfo.tenantId);
-		if (itr == view.end()) {
+		ASSERT(version == latestVersion ||
+		       (version >= tenantMap.getOldestVersion() && version <= this->version.get()));
+		if (!tenantMap.contains(tenantInfo.tenantId, version)) {
 			TraceEvent(SevWarn, "StorageTenantNotFound", thisServerID)
 			    .detail("Tenant", tenantInfo.tenantId)
 			    .backtrace();
@@ -2099,6 +2265,18 @@ std::vector<StorageServerShard> StorageServer::getStorageServerShards(KeyRangeRe
 	return res;
 }
 
+// Reads key as of version from the storage engine, unless the engine is known to hold nothing for it as of version
+Future<Optional<Value>> readStorageValue(StorageServer* data,
+                                         KeyRef key,
+                                         Version version,
+                                         Optional<ReadOptions> options) {
+	if (data->clearedRanges.isEmpty(key, version)) {
+		++data->counters.kvGetsSkipped;
+		return Optional<Value>();
+	}
+	return data->storage.readValue(key, options);
+}
+
 ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	state int64_t resultSize = 0;
 	Span span("SS:getValue"_loc, req.spanContext);
@@ -2129,42 +2307,68 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			                      "getValueQ.DoRead"); //.detail("TaskID", g_network->getCurrentTask());
 
 		state Optional<Value> v;
-		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
-		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
-		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+		// Reads at a pinned version go to its snapshot, whether or not versionedData still holds the version
+		state Reference<IKeyValueStoreSnapshot> pinned;
+		StorageServer::PinnedSnapshot* pin = data->getPinnedSnapshot(req.version);
+		if (pin) {
+			Key key = req.tenantInfo.hasTenant() ? req.key.withPrefix(req.tenantInfo.prefix.get()) : req.key;
+			if (!pin->readableRange(key).empty()) {
+				pinned = pin->snapshot;
+			}
+		}
+		state Version version = req.version;
+		if (!pinned) {
+			Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+			Version readVersion = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+			version = readVersion;
+		}
+		state double versionWaitEnd = g_network->timer();
+		data->counters.readVersionWaitSample.addMeasurement(versionWaitEnd - queueWaitEnd);
+		data->readPhases(req.options).queueWait->sampleSeconds(queueWaitEnd - req.requestTime());
+		data->readPhases(req.options).versionWait->sampleSeconds(versionWaitEnd - queueWaitEnd);
 
 		if (req.options.present() && req.options.get().debugID.present())
 			g_traceBatch.addEvent("GetValueDebug",
 			                      req.options.get().debugID.get().first(),
 			                      "getValueQ.AfterVersion"); //.detail("TaskID", g_network->getCurrentTask());
 
-		data->checkTenantEntry(version, req.tenantInfo);
+		// Tenant IDs are never reused, so a tenant that exists now existed at a pinned version or had no data then
+		data->checkTenantEntry(pinned ? latestVersion : version, req.tenantInfo);
 		if (req.tenantInfo.hasTenant()) {
 			req.key = req.key.withPrefix(req.tenantInfo.prefix.get());
 		}
 		state uint64_t changeCounter = data->shardChangeCounter;
 
-		if (!data->shards[req.key]->isReadable()) {
+		if (!pinned && !data->shards[req.key]->isReadable()) {
 			//TraceEvent("WrongShardServer", data->thisServerID).detail("Key", req.key).detail("Version", version).detail("In", "getValueQ");
 			throw wrong_shard_server();
 		}
 
 		state int path = 0;
-		auto i = data->data().at(version).lastLessOrEqual(req.key);
-		if (i && i->isValue() && i.key() == req.key) {
-			v = (Value)i->getValue();
-			path = 1;
-		} else if (!i || !i->isClearTo() || i->getEndKey() <= req.key) {
+		if (pinned) {
 			path = 2;
-			Optional<Value> vv = wait(data->storage.readValue(req.key, req.options));
+			Optional<Value> vv = wait(pinned->readValue(req.key, req.options));
+			++data->counters.pinnedSnapshotReads;
 			data->counters.kvGetBytes += vv.expectedSize();
-			// Validate that while we were reading the data we didn't lose the version or shard
-			if (version < data->storageVersion()) {
-				CODE_PROBE(true, "transaction_too_old after readValue");
-				throw transaction_too_old();
-			}
-			data->checkChangeCounter(changeCounter, req.key);
 			v = vv;
+		} else {
+			auto i = data->data().at(version).lastLessOrEqual(req.key);
+			if (i && i->isValue() && i.key() == req.key) {
+				v = (Value)i->getValue();
+				path = 1;
+			} else if (!i || !i->isClearTo() || i->getEndKey() <= req.key) {
+				path = 2;
+				Optional<Value> vv = wait(readStorageValue(data, req.key, version, req.options));
+				data->counters.kvGetBytes += vv.expectedSize();
+				data->counters.kvReadValueLatencySample.addMeasurement(g_network->timer() - versionWaitEnd);
+				// Validate that while we were reading the data we didn't lose the version or shard
+				if (version < data->storageVersion()) {
+					CODE_PROBE(true, "transaction_too_old after readValue");
+					throw transaction_too_old();
+				}
+				data->checkChangeCounter(changeCounter, req.key);
+				v = vv;
+			}
 		}
 
 		DEBUG_MUTATION("ShardGetValue",
@@ -2203,6 +2407,8 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			data->metrics.notifyBytesReadPerKSecond(req.key, bytesReadPerKSecond);
 		}
 
+		data->readPhases(req.options).read->sampleSeconds(g_network->timer() - versionWaitEnd);
+
 		if (req.options.present() && req.options.get().debugID.present())
 			g_traceBatch.addEvent("GetValueDebug",
 			                      req.options.get().debugID.get().first(),
@@ -2224,7 +2430,7 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 
 	// Key size is not included in "BytesQueried", but still contributes to cost,
 	// so it must be accounted for here.
-	data->transactionTagCounter.addRequest(req.tags, req.key.size() + resultSize);
+	data->transactionTagCounter.addRequest(req.tags, req.key, req.key.size() + resultSize);
 
 	++data->counters.finishedQueries;
 
@@ -2240,6 +2446,128 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	return Void();
 }
 
+ACTOR Future<Void> getValuesQ(StorageServer* data, GetValuesRequest req) {
+	state int64_t resultSize = 0;
+	state int64_t keySize = 0;
+	Span span("SS:getValues"_loc, req.spanContext);
+
+	try {
+		++data->counters.getValuesQueries;
+		++data->counters.allQueries;
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
+		// so we need to downgrade here
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+
+		// Track time from requestTime through now as read queueing wait time
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readQueueWaitSample.addMeasurement(queueWaitEnd - req.requestTime());
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+
+		data->checkTenantEntry(version, req.tenantInfo);
+		if (req.tenantInfo.hasTenant()) {
+			for (auto& key : req.keys) {
+				key = key.withPrefix(req.tenantInfo.prefix.get(), req.arena);
+			}
+		}
+		state uint64_t changeCounter = data->shardChangeCounter;
+
+		// Keys are looked up in order, so that consecutive searches of the versioned data and the engine reads go over
+		// neighboring data
+		std::vector<std::pair<KeyRef, int>> order;
+		order.reserve(req.keys.size());
+		for (int i = 0; i < req.keys.size(); i++) {
+			order.emplace_back(req.keys[i], i);
+		}
+		std::sort(order.begin(), order.end());
+
+		state std::vector<Optional<Value>> values(req.keys.size());
+		state std::vector<int> engineReadIndexes;
+		state std::vector<Future<Optional<Value>>> engineReads;
+		auto view = data->data().at(version);
+		for (const auto& [key, i] : order) {
+			if (!data->shards[key]->isReadable()) {
+				throw wrong_shard_server();
+			}
+			auto it = view.lastLessOrEqual(key);
+			if (it && it->isValue() && it.key() == key) {
+				values[i] = (Value)it->getValue();
+			} else if (!it || !it->isClearTo() || it->getEndKey() <= key) {
+				engineReadIndexes.push_back(i);
+				engineReads.push_back(readStorageValue(data, key, version, req.options));
+			}
+		}
+
+		// The engine reads are all issued before waiting on any of them, so they are served as one batch
+		wait(waitForAll(engineReads));
+		// Validate that while we were reading the data we didn't lose the version or shard
+		if (version < data->storageVersion()) {
+			CODE_PROBE(true, "transaction_too_old after getValues engine reads");
+			throw transaction_too_old();
+		}
+		for (int j = 0; j < engineReadIndexes.size(); j++) {
+			int i = engineReadIndexes[j];
+			data->checkChangeCounter(changeCounter, req.keys[i]);
+			values[i] = engineReads[j].get();
+			data->counters.kvGetBytes += values[i].expectedSize();
+		}
+
+		for (int i = 0; i < values.size(); i++) {
+			keySize += req.keys[i].size();
+			if (values[i].present()) {
+				++data->counters.rowsQueried;
+				resultSize += values[i].get().size();
+				data->counters.bytesQueried += values[i].get().size();
+			} else {
+				++data->counters.emptyQueries;
+			}
+
+			if (SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+				// If the read yields no value, randomly sample the empty read.
+				int64_t bytesRead = req.keys[i].size() + (values[i].present() ? values[i].get().size() : 0);
+				int64_t bytesReadPerKSecond = values[i].present()
+				                                  ? std::max(bytesRead, SERVER_KNOBS->EMPTY_READ_PENALTY)
+				                                  : SERVER_KNOBS->EMPTY_READ_PENALTY;
+				data->metrics.notifyBytesReadPerKSecond(req.keys[i], bytesReadPerKSecond);
+			}
+		}
+
+		GetValuesReply reply;
+		reply.values = std::move(values);
+		for (int i = 0; i < req.keys.size() && !reply.cached; i++) {
+			reply.cached = data->cachedRangeMap[req.keys[i]];
+		}
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	// Key size is not included in "BytesQueried", but still contributes to cost,
+	// so it must be accounted for here.
+	data->transactionTagCounter.addRequest(req.tags, req.keys.empty() ? KeyRef() : req.keys[0], keySize + resultSize);
+
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySample.addMeasurement(duration);
+	if (data->latencyBandConfig.present()) {
+		int maxReadBytes =
+		    data->latencyBandConfig.get().readConfig.maxReadBytes.orDefault(std::numeric_limits<int>::max());
+		data->counters.readLatencyBands.addMeasurement(duration, 1, Filtered(resultSize > maxReadBytes));
+	}
+
+	return Void();
+}
+
 // Pessimistic estimate the number of overhead bytes used by each
 // watch. Watch key references are stored in an AsyncMap<Key,bool>, and actors
 // must be kept alive until the watch is finished.
@@ -2269,8 +2597,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 	loop {
 		try {
 			if (tenantId != TenantInfo::INVALID_TENANT) {
-				auto view = data->tenantMap.at(latestVersion);
-				if (view.find(tenantId) == view.end()) {
+				if (!data->tenantMap.contains(tenantId, latestVersion)) {
 					throw tenant_removed();
 				}
 			}
@@ -2999,12 +3326,21 @@ ACTOR Future<std::pair<ChangeFeedStreamReply, bool>> getChangeFeedMutations(Stor
 		// The delay(0) is technically only necessary if we did not immediately acquire the lock, but isn't a big deal
 		// to do always
 		wait(delay(0));
+		// A feed's durable mutations are contiguous in version order, and a consumer that has fallen behind scans them
+		// once. Its pages are not worth keeping in the storage engine's cache, where they would push out user data.
+		Optional<ReadOptions> diskReadOptions = req.options;
+		if (!SERVER_KNOBS->CHANGE_FEED_DISK_READS_CACHE) {
+			if (!diskReadOptions.present()) {
+				diskReadOptions = ReadOptions();
+			}
+			diskReadOptions.get().cacheResult = false;
+		}
 		state RangeResult res = wait(
 		    data->storage.readRange(KeyRangeRef(changeFeedDurableKey(req.rangeID, std::max(req.begin, emptyVersion)),
 		                                        changeFeedDurableKey(req.rangeID, req.end)),
 		                            1 << 30,
 		                            remainingDurableBytes,
-		                            req.options));
+		                            diskReadOptions));
 		ssReadLock.release();
 
 		data->counters.kvScanBytes += res.logicalSize();
@@ -3375,6 +3711,40 @@ ACTOR Future<Void> stopChangeFeedOnMove(StorageServer* data, ChangeFeedStreamReq
 	return Void();
 }
 
+// Returns the bytes of in-memory mutations at or after version, counting no further than the coalescing minimum
+int64_t newFeedMutationBytes(Reference<ChangeFeedInfo> feedInfo, Version version) {
+	int64_t bytes = 0;
+	for (auto it = feedInfo->mutations.rbegin();
+	     it != feedInfo->mutations.rend() && it->version >= version &&
+	     bytes < SERVER_KNOBS->CHANGEFEEDSTREAM_COALESCE_MIN_BYTES;
+	     ++it) {
+		bytes += it->expectedSize();
+	}
+	return bytes;
+}
+
+// Waits until the feed has CHANGEFEEDSTREAM_COALESCE_MIN_BYTES of mutations at or after version, or for the max delay
+ACTOR Future<Void> coalesceFeedMutations(Reference<ChangeFeedInfo> feedInfo,
+                                         Version version,
+                                         Future<Void> streamEndReached) {
+	state Future<Void> timeout = delay(SERVER_KNOBS->CHANGEFEEDSTREAM_COALESCE_MAX_DELAY);
+	loop {
+		choose {
+			when(wait(feedInfo->newMutations.onTrigger())) {}
+			when(wait(timeout)) {
+				return Void();
+			}
+			when(wait(streamEndReached)) {
+				return Void();
+			}
+		}
+		if (feedInfo->removing ||
+		    newFeedMutationBytes(feedInfo, version) >= SERVER_KNOBS->CHANGEFEEDSTREAM_COALESCE_MIN_BYTES) {
+			return Void();
+		}
+	}
+}
+
 ACTOR Future<Void> changeFeedStreamQ(StorageServer* data, ChangeFeedStreamRequest req) {
 	state Span span("SS:getChangeFeedStream"_loc, req.spanContext);
 	state bool atLatest = false;
@@ -3558,6 +3928,16 @@ ACTOR Future<Void> changeFeedStreamQ(StorageServer* data, ChangeFeedStreamReques
 					when(wait(feedInfo->newMutations.onTrigger())) {}
 					when(wait(streamEndReached)) {}
 				}
+				if (SERVER_KNOBS->CHANGEFEEDSTREAM_COALESCE_MIN_BYTES > 0 && !streamEndReached.isReady() &&
+				    !feedInfo->removing && newFeedMutationBytes(feedInfo, req.begin) <
+				                               SERVER_KNOBS->CHANGEFEEDSTREAM_COALESCE_MIN_BYTES) {
+					// Other streams to this client must not report a minimum version past what this one has sent
+					// while it waits, the same as when it is blocked on the client
+					data->changeFeedClientVersions[req.reply.getEndpoint().getPrimaryAddress()][req.id] = req.begin - 1;
+					removeUID = true;
+					wait(coalesceFeedMutations(feedInfo, req.begin, streamEndReached));
+					++data->counters.feedStreamCoalescedReplies;
+				}
 				if (feedInfo->removing) {
 					req.reply.sendError(unknown_change_feed());
 					// throw to delete from changeFeedClientVersions if present
@@ -3785,8 +4165,150 @@ ACTOR Future<GetValueReqAndResultRef> quickGetValue(StorageServer* data,
 	}
 }
 
+// Reads the given secondary point lookups of a mapped range read with one GetValuesRequest, so that they share a read
+// lock and version wait and their engine reads are all issued together. Lookups outside the readable shards of this
+// server, or a batch that fails, fall back to quickGetValue.
+ACTOR Future<Void> quickGetValues(StorageServer* data,
+                                  std::vector<std::pair<KeyRef, MappedKeyValueRef*>> lookups,
+                                  Version version,
+                                  Arena* a,
+                                  // To provide span context, tags, debug ID to underlying lookups.
+                                  GetMappedKeyValuesRequest* pOriginalReq) {
+	state double getValuesStart = g_network->timer();
+	state std::vector<std::pair<KeyRef, MappedKeyValueRef*>> fallbacks;
+	state GetValuesRequest req;
+	req.spanContext = pOriginalReq->spanContext;
+	req.tenantInfo = pOriginalReq->tenantInfo;
+	req.version = version;
+	req.tags = pOriginalReq->tags;
+	req.options = pOriginalReq->options;
+	// getValuesQ adds the tenant prefix to the keys of the request in place, so the keys are kept here too
+	state std::vector<std::pair<KeyRef, MappedKeyValueRef*>> batched;
+	for (const auto& [key, kvm] : lookups) {
+		if (data->shards[addPrefix(key, pOriginalReq->tenantInfo.prefix, req.arena)]->isReadable()) {
+			req.keys.push_back(req.arena, key);
+			batched.emplace_back(key, kvm);
+		} else {
+			fallbacks.emplace_back(key, kvm);
+		}
+	}
+
+	if (!batched.empty()) {
+		state bool batchRead = false;
+		try {
+			// Like quickGetValue, this does not use readGuard, since throttling is enforced on the original request
+			data->actors.add(getValuesQ(data, req));
+			GetValuesReply reply = wait(req.reply.getFuture());
+			if (!reply.error.present()) {
+				for (int i = 0; i < batched.size(); i++) {
+					GetValueReqAndResultRef getValue;
+					getValue.key = batched[i].first;
+					copyOptionalValue(a, getValue, reply.values[i]);
+					batched[i].second->reqAndResult = getValue;
+				}
+				data->counters.quickGetValueHit += batched.size();
+				data->counters.mappedRangeLocalSample.addMeasurement(g_network->timer() - getValuesStart);
+				batchRead = true;
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+		}
+		if (!batchRead) {
+			fallbacks.insert(fallbacks.end(), batched.begin(), batched.end());
+		}
+	}
+
+	state std::vector<Future<GetValueReqAndResultRef>> fallbackReads;
+	for (const auto& [key, kvm] : fallbacks) {
+		fallbackReads.push_back(quickGetValue(data, key, version, a, pOriginalReq));
+	}
+	wait(waitForAll(fallbackReads));
+	for (int i = 0; i < fallbacks.size(); i++) {
+		fallbacks[i].second->reqAndResult = fallbackReads[i].get();
+	}
+	return Void();
+}
+
 // If limit>=0, it returns the first rows in the range (sorted ascending), otherwise the last rows (sorted descending).
 // readRange has O(|result|) + O(log |data|) cost
+// True if the shard containing range is read hot, by the same read density test used to find read hot sub ranges
+static bool admitToRangeReadCache(StorageServer* data, KeyRangeRef range) {
+	if (BUGGIFY_WITH_PROB(0.1)) {
+		return true;
+	}
+	KeyRangeRef shard = data->shards.rangeContaining(range.begin)->range();
+	int64_t bytesRead = data->metrics.bytesReadSample.getEstimate(shard);
+	int64_t bytes =
+	    std::max<int64_t>(SERVER_KNOBS->READ_HOT_SUB_RANGE_CHUNK_SIZE, data->metrics.byteSample.getEstimate(shard));
+	return bytesRead > SERVER_KNOBS->SHARD_MAX_READ_DENSITY_RATIO * bytes;
+}
+
+ACTOR static Future<RangeResult> readStorageRangeAndCache(StorageServer* data,
+                                                          KeyRange range,
+                                                          int rowLimit,
+                                                          int byteLimit,
+                                                          Optional<ReadOptions> options) {
+	state uint64_t generation = data->rangeReadCache.getGeneration();
+	RangeResult result = wait(data->storage.readRange(range, rowLimit, byteLimit, options));
+	data->rangeReadCache.insert(range, rowLimit, byteLimit, result, generation);
+	return result;
+}
+
+// Reads range from the storage engine, or from the range read cache if the same read was cached since the last write
+// to the range. Reads of read hot shards are admitted to the cache.
+static Future<RangeResult> readStorageOrCachedRange(StorageServer* data,
+                                                    KeyRangeRef range,
+                                                    int rowLimit,
+                                                    int byteLimit,
+                                                    Optional<ReadOptions> options) {
+	if (!data->rangeReadCache.enabled()) {
+		return data->storage.readRange(range, rowLimit, byteLimit, options);
+	}
+	Optional<RangeResult> cached = data->rangeReadCache.get(range, rowLimit, byteLimit);
+	if (cached.present()) {
+		++data->counters.kvScanCacheHits;
+		return cached.get();
+	}
+	if ((options.present() && !options.get().cacheResult) || !admitToRangeReadCache(data, range)) {
+		return data->storage.readRange(range, rowLimit, byteLimit, options);
+	}
+	return readStorageRangeAndCache(data, range, rowLimit, byteLimit, options);
+}
+
+// Keeps the trimmed range alive for as long as the engine reads it
+ACTOR static Future<RangeResult> readTrimmedStorageRange(StorageServer* data,
+                                                         KeyRange range,
+                                                         int rowLimit,
+                                                         int byteLimit,
+                                                         Optional<ReadOptions> options) {
+	RangeResult result = wait(readStorageOrCachedRange(data, range, rowLimit, byteLimit, options));
+	return result;
+}
+
+// Reads range as of version from the storage engine, leaving out the ends of range that the engine is known to hold
+// nothing in as of version
+Future<RangeResult> readStorageRange(StorageServer* data,
+                                     KeyRangeRef range,
+                                     Version version,
+                                     int rowLimit,
+                                     int byteLimit,
+                                     Optional<ReadOptions> options) {
+	if (data->clearedRanges.size()) {
+		KeyRange trimmed = data->clearedRanges.trim(range, version);
+		if (trimmed.empty()) {
+			++data->counters.kvScansSkipped;
+			return RangeResult();
+		}
+		if (trimmed != range) {
+			++data->counters.kvScansTrimmed;
+			return readTrimmedStorageRange(data, trimmed, rowLimit, byteLimit, options);
+		}
+	}
+	return readStorageOrCachedRange(data, range, rowLimit, byteLimit, options);
+}
+
 ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
                                           Version version,
                                           KeyRange range,
@@ -3870,7 +4392,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			// Read the data on disk up to vCurrent (or the end of the range)
 			readEnd = vCurrent ? std::min(vCurrent.key(), range.end) : range.end;
 			RangeResult atStorageVersion =
-			    wait(data->storage.readRange(KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
+			    wait(readStorageRange(data, KeyRangeRef(readBegin, readEnd), version, limit, *pLimitBytes, options));
 			logicalSize = atStorageVersion.logicalSize();
 			data->counters.kvScanBytes += logicalSize;
 			resultLogicalSize += logicalSize;
@@ -3972,7 +4494,7 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 			readBegin = vCurrent ? std::max(vCurrent->isClearTo() ? vCurrent->getEndKey() : vCurrent.key(), range.begin)
 			                     : range.begin;
 			RangeResult atStorageVersion =
-			    wait(data->storage.readRange(KeyRangeRef(readBegin, readEnd), limit, *pLimitBytes, options));
+			    wait(readStorageRange(data, KeyRangeRef(readBegin, readEnd), version, limit, *pLimitBytes, options));
 			logicalSize = atStorageVersion.logicalSize();
 			data->counters.kvScanBytes += logicalSize;
 			resultLogicalSize += logicalSize;
@@ -4036,6 +4558,29 @@ ACTOR Future<GetKeyValuesReply> readRange(StorageServer* data,
 	return result;
 }
 
+// Reads a range from a pinned snapshot, which holds exactly the data at its version, in the form readRange() returns
+ACTOR Future<GetKeyValuesReply> readPinnedRange(Reference<IKeyValueStoreSnapshot> snapshot,
+                                                Version version,
+                                                KeyRange range,
+                                                int limit,
+                                                int* pLimitBytes,
+                                                Optional<ReadOptions> options,
+                                                Optional<KeyRef> tenantPrefix) {
+	state GetKeyValuesReply result;
+	RangeResult atVersion = wait(snapshot->readRange(range, limit, *pLimitBytes, options));
+	result.arena.dependsOn(atVersion.arena());
+	result.data.reserve(result.arena, atVersion.size());
+	for (auto const& kv : atVersion) {
+		KeyValueRef row = tenantPrefix.present() ? KeyValueRef(kv.key.removePrefix(tenantPrefix.get()), kv.value) : kv;
+		result.data.push_back(result.arena, row);
+		*pLimitBytes -= sizeof(KeyValueRef) + row.expectedSize();
+	}
+	result.more = atVersion.more;
+	result.cached = false;
+	result.version = version;
+	return result;
+}
+
 KeyRangeRef StorageServer::clampRangeToTenant(KeyRangeRef range, TenantInfo const& tenantInfo, Arena& arena) {
 	if (tenantInfo.hasTenant()) {
 		return KeyRangeRef(range.begin.startsWith(tenantInfo.prefix.get()) ? range.begin : tenantInfo.prefix.get(),
@@ -4211,8 +4756,24 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			g_traceBatch.addEvent(
 			    "TransactionDebug", req.options.get().debugID.get().first(), "storageserver.getKeyValues.Before");
 
-		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
-		state Version version = wait(waitForVersion(data, commitVersion, req.version, span.context));
+		// Scans at a pinned version go to its snapshot, which can only resolve key selectors that need no other keys
+		state Reference<IKeyValueStoreSnapshot> pinned;
+		state KeyRange pinnedRange;
+		StorageServer::PinnedSnapshot* pin = data->getPinnedSnapshot(req.version);
+		if (pin && req.begin.isFirstGreaterOrEqual() && req.end.isFirstGreaterOrEqual()) {
+			pinnedRange = pin->readableRange(
+			    req.tenantInfo.hasTenant() ? req.begin.getKey().withPrefix(req.tenantInfo.prefix.get(), req.arena)
+			                               : req.begin.getKey());
+			if (!pinnedRange.empty()) {
+				pinned = pin->snapshot;
+			}
+		}
+		state Version version = req.version;
+		if (!pinned) {
+			Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+			Version readVersion = wait(waitForVersion(data, commitVersion, req.version, span.context));
+			version = readVersion;
+		}
 		DisabledTraceEvent("VVV", data->thisServerID)
 		    .detail("Version", version)
 		    .detail("ReqVersion", req.version)
@@ -4222,8 +4783,10 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 		            req.options.present() && req.options.get().debugID.present() ? req.options.get().debugID.get()
 		                                                                         : UID());
 		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+		data->readPhases(req.options).queueWait->sampleSeconds(queueWaitEnd - req.requestTime());
+		data->readPhases(req.options).versionWait->sampleSeconds(g_network->timer() - queueWaitEnd);
 
-		data->checkTenantEntry(version, req.tenantInfo);
+		data->checkTenantEntry(pinned ? latestVersion : version, req.tenantInfo);
 		if (req.tenantInfo.hasTenant()) {
 			req.begin.setKeyUnlimited(req.begin.getKey().withPrefix(req.tenantInfo.prefix.get(), req.arena));
 			req.end.setKeyUnlimited(req.end.getKey().withPrefix(req.tenantInfo.prefix.get(), req.arena));
@@ -4231,7 +4794,8 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 
 		state uint64_t changeCounter = data->shardChangeCounter;
 		//		try {
-		state KeyRange shard = getShardKeyRange(data, req.begin);
+		// The snapshot does not change when shards move, so the range readable at its version stands in for the shard
+		state KeyRange shard = pinned ? pinnedRange : getShardKeyRange(data, req.begin);
 
 		if (req.options.present() && req.options.get().debugID.present())
 			g_traceBatch.addEvent(
@@ -4293,24 +4857,37 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			none.more = false;
 			none.penalty = data->getPenalty();
 
-			data->checkChangeCounter(changeCounter,
-			                         KeyRangeRef(std::min<KeyRef>(req.begin.getKey(), req.end.getKey()),
-			                                     std::max<KeyRef>(req.begin.getKey(), req.end.getKey())));
+			if (!pinned) {
+				data->checkChangeCounter(changeCounter,
+				                         KeyRangeRef(std::min<KeyRef>(req.begin.getKey(), req.end.getKey()),
+				                                     std::max<KeyRef>(req.begin.getKey(), req.end.getKey())));
+			}
 			req.reply.send(none);
 		} else {
 			state int remainingLimitBytes = req.limitBytes;
 
 			state double kvReadRange = g_network->timer();
-			GetKeyValuesReply _r = wait(readRange(data,
-			                                      version,
-			                                      KeyRangeRef(begin, end),
-			                                      req.limit,
-			                                      &remainingLimitBytes,
-			                                      span.context,
-			                                      req.options,
-			                                      req.tenantInfo.prefix));
+			GetKeyValuesReply _r = wait(pinned ? readPinnedRange(pinned,
+			                                                     version,
+			                                                     KeyRangeRef(begin, end),
+			                                                     req.limit,
+			                                                     &remainingLimitBytes,
+			                                                     req.options,
+			                                                     req.tenantInfo.prefix)
+			                                   : readRange(data,
+			                                               version,
+			                                               KeyRangeRef(begin, end),
+			                                               req.limit,
+			                                               &remainingLimitBytes,
+			                                               span.context,
+			                                               req.options,
+			                                               req.tenantInfo.prefix));
+			if (pinned) {
+				++data->counters.pinnedSnapshotReads;
+			}
 			const double duration = g_network->timer() - kvReadRange;
 			data->counters.kvReadRangeLatencySample.addMeasurement(duration);
+			data->readPhases(req.options).read->sampleSeconds(duration);
 			GetKeyValuesReply r = _r;
 
 			if (req.options.present() && req.options.get().debugID.present())
@@ -4318,10 +4895,12 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 				                      req.options.get().debugID.get().first(),
 				                      "storageserver.getKeyValues.AfterReadRange");
 			//.detail("Begin",begin).detail("End",end).detail("SizeOf",r.data.size());
-			data->checkChangeCounter(
-			    changeCounter,
-			    KeyRangeRef(std::min<KeyRef>(begin, std::min<KeyRef>(req.begin.getKey(), req.end.getKey())),
-			                std::max<KeyRef>(end, std::max<KeyRef>(req.begin.getKey(), req.end.getKey()))));
+			if (!pinned) {
+				data->checkChangeCounter(
+				    changeCounter,
+				    KeyRangeRef(std::min<KeyRef>(begin, std::min<KeyRef>(req.begin.getKey(), req.end.getKey())),
+				                std::max<KeyRef>(end, std::max<KeyRef>(req.begin.getKey(), req.end.getKey()))));
+			}
 			if (EXPENSIVE_VALIDATION) {
 				for (int i = 0; i < r.data.size(); i++) {
 					if (req.tenantInfo.prefix.present()) {
@@ -4347,13 +4926,42 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 				    addPrefix(r.data[r.data.size() - 1].key, req.tenantInfo.prefix, req.arena), bytesReadPerKSecond);
 			}
 
+			if (req.checksumOnly) {
+				r.checksum = keyValuesChecksum(r.data);
+				if (!r.data.empty()) {
+					r.lastScannedKey = r.data.back().key;
+				}
+				r.data = VectorRef<KeyValueRef, VecSerStrategy::String>();
+			}
+
+			// The limits and the read cost were charged on the rows read, so only the reply shrinks
+			if (req.filter.present() && !r.data.empty()) {
+				r.lastScannedKey = r.data.back().key;
+				int matched = 0;
+				for (int i = 0; i < r.data.size(); i++) {
+					if (req.filter.get().matches(r.data[i])) {
+						r.data[matched++] = r.data[i];
+					}
+				}
+				r.data.resize(r.arena, matched);
+			}
+
+			int rowsReturned = r.data.size();
+			if (req.compressReply) {
+				int64_t saved = compressKeyValuesReply(r, SERVER_KNOBS->STORAGE_COMPRESS_RANGE_REPLY_MIN_BYTES);
+				if (saved > 0) {
+					++data->counters.compressedRangeReplies;
+					data->counters.rangeReplyBytesSavedByCompression += saved;
+				}
+			}
+
 			r.penalty = data->getPenalty();
 			req.reply.send(r);
 
 			resultSize = req.limitBytes - remainingLimitBytes;
 			data->counters.bytesQueried += resultSize;
-			data->counters.rowsQueried += r.data.size();
-			if (r.data.size() == 0) {
+			data->counters.rowsQueried += rowsReturned;
+			if (rowsReturned == 0) {
 				++data->counters.emptyQueries;
 			}
 		}
@@ -4363,7 +4971,7 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
 	}
 
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	data->transactionTagCounter.addRequest(req.tags, req.begin.getKey(), resultSize);
 	++data->counters.finishedQueries;
 
 	double duration = g_network->timer() - req.requestTime();
@@ -4384,6 +4992,185 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 	return Void();
 }
 
+ACTOR Future<Void> getRangeAggregateQ(StorageServer* data, GetRangeAggregateRequest req) {
+	state int64_t resultSize = 0;
+	state Span span("SS:getRangeAggregate"_loc, req.spanContext);
+
+	try {
+		++data->counters.getRangeAggregateQueries;
+		++data->counters.allQueries;
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
+		// so we need to downgrade here
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+
+		// Track time from requestTime through now as read queueing wait time
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readQueueWaitSample.addMeasurement(queueWaitEnd - req.requestTime());
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, span.context));
+		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+
+		data->checkTenantEntry(version, req.tenantInfo);
+		state KeyRange range = req.tenantInfo.hasTenant() ? req.keys.withPrefix(req.tenantInfo.prefix.get()) : req.keys;
+		state uint64_t changeCounter = data->shardChangeCounter;
+		if (!getShardKeyRange(data, firstGreaterOrEqual(range.begin)).contains(range)) {
+			throw wrong_shard_server();
+		}
+
+		// The range is read in passes of RANGE_AGGREGATE_READ_BYTES, so that only one pass of rows is held in memory
+		state RangeAggregate aggregate;
+		state Key begin = range.begin;
+		state Key lastKey;
+		state int remainingBytes = SERVER_KNOBS->RANGE_AGGREGATE_BYTES_LIMIT;
+		while (begin < range.end && remainingBytes > 0) {
+			state int limitBytes = std::min(remainingBytes, SERVER_KNOBS->RANGE_AGGREGATE_READ_BYTES);
+			state int readLimitBytes = limitBytes;
+			GetKeyValuesReply r = wait(readRange(data,
+			                                     version,
+			                                     KeyRangeRef(begin, range.end),
+			                                     CLIENT_KNOBS->TOO_MANY,
+			                                     &limitBytes,
+			                                     span.context,
+			                                     req.options,
+			                                     Optional<KeyRef>()));
+			remainingBytes -= readLimitBytes - limitBytes;
+			for (const auto& kv : r.data) {
+				aggregate.add(kv.value);
+			}
+			if (r.more && !r.data.empty()) {
+				lastKey = r.data.back().key;
+				begin = keyAfter(lastKey);
+			} else {
+				if (!r.data.empty()) {
+					lastKey = r.data.back().key;
+				}
+				begin = range.end;
+			}
+		}
+		data->checkChangeCounter(changeCounter, range);
+
+		resultSize = SERVER_KNOBS->RANGE_AGGREGATE_BYTES_LIMIT - remainingBytes;
+		if (resultSize > 0 && SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+			// As for range reads, the cost is billed to the first and last keys that were read
+			int64_t bytesReadPerKSecond = std::max(resultSize, SERVER_KNOBS->EMPTY_READ_PENALTY) / 2;
+			data->metrics.notifyBytesReadPerKSecond(range.begin, bytesReadPerKSecond);
+			data->metrics.notifyBytesReadPerKSecond(lastKey, bytesReadPerKSecond);
+		}
+		data->counters.bytesQueried += resultSize;
+		data->counters.rowsQueried += aggregate.rows;
+		if (aggregate.rows == 0) {
+			++data->counters.emptyQueries;
+		}
+
+		GetRangeAggregateReply reply;
+		reply.aggregate = aggregate;
+		if (begin < range.end) {
+			reply.readThrough =
+			    Key(req.tenantInfo.hasTenant() ? begin.removePrefix(req.tenantInfo.prefix.get()) : KeyRef(begin));
+		}
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	data->transactionTagCounter.addRequest(req.tags, req.keys.begin, resultSize);
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySample.addMeasurement(duration);
+	data->counters.readRangeLatencySample.addMeasurement(duration);
+
+	return Void();
+}
+
+// Checksums the rows of each sub-range of req.range split at req.boundaries. It stops once it has read
+// RANGE_CHECKSUM_BYTES_LIMIT bytes, so a reply may cover only the first sub-ranges.
+ACTOR Future<Void> getRangeChecksumQ(StorageServer* data, GetRangeChecksumRequest req) {
+	try {
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(Optional<ReadOptions>()));
+		state Version version = wait(waitForVersion(data, req.version, SpanContext()));
+
+		state uint64_t changeCounter = data->shardChangeCounter;
+		if (!getShardKeyRange(data, firstGreaterOrEqual(req.range.begin)).contains(req.range)) {
+			throw wrong_shard_server();
+		}
+
+		state GetRangeChecksumReply reply;
+		state int remainingBytes = SERVER_KNOBS->RANGE_CHECKSUM_BYTES_LIMIT;
+		state int i = 0;
+		for (; i <= req.boundaries.size() && remainingBytes > 0; i++) {
+			state Key begin = i == 0 ? req.range.begin : req.boundaries[i - 1];
+			state KeyRef end = i == req.boundaries.size() ? req.range.end : req.boundaries[i];
+			state uint64_t checksum = 0;
+			state bool complete = false;
+			while (!complete && remainingBytes > 0) {
+				state int limitBytes = std::min(remainingBytes, CLIENT_KNOBS->REPLY_BYTE_LIMIT);
+				state int readLimitBytes = limitBytes;
+				GetKeyValuesReply r = wait(readRange(data,
+				                                     version,
+				                                     KeyRangeRef(begin, end),
+				                                     CLIENT_KNOBS->TOO_MANY,
+				                                     &limitBytes,
+				                                     SpanContext(),
+				                                     Optional<ReadOptions>(),
+				                                     Optional<KeyRef>()));
+				remainingBytes -= readLimitBytes - limitBytes;
+				checksum = keyValuesChecksum(r.data, checksum);
+				if (r.more && !r.data.empty()) {
+					begin = keyAfter(r.data.back().key);
+				} else {
+					complete = true;
+				}
+			}
+			if (!complete) {
+				break;
+			}
+			reply.checksums.push_back(checksum);
+		}
+		data->checkChangeCounter(changeCounter, req.range);
+
+		data->counters.bytesQueried += SERVER_KNOBS->RANGE_CHECKSUM_BYTES_LIMIT - remainingBytes;
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		req.reply.sendError(e);
+	}
+	return Void();
+}
+
+ACTOR Future<Void> pinReadVersionQ(StorageServer* data, PinReadVersionRequest req) {
+	try {
+		if (!data->getPinnedSnapshot(req.version)) {
+			if (req.version <= data->storageVersion()) {
+				throw transaction_too_old();
+			}
+			if (!data->pendingPins.count(req.version) &&
+			    data->pinnedSnapshots.size() + data->pendingPins.size() >= SERVER_KNOBS->STORAGE_MAX_PINNED_SNAPSHOTS) {
+				CODE_PROBE(true, "Too many pinned snapshots");
+				throw operation_failed();
+			}
+			wait(data->pendingPins[req.version].getFuture());
+		}
+		req.reply.send(Void());
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled)
+			throw;
+		// Only errors of this request get here, and clients read without the pin when it cannot be made
+		req.reply.sendError(e);
+	}
+	return Void();
+}
+
 ACTOR Future<GetRangeReqAndResultRef> quickGetKeyValues(
     StorageServer* data,
     StringRef prefix,
@@ -4605,6 +5392,60 @@ Key constructMappedKey(KeyValueRef* keyValue, std::vector<Optional<Tuple>>& vec,
 	return mappedKeyTuple.pack();
 }
 
+// Compares the checksums of sub-ranges of range, which holds the given local rows, with those of remoteServer, and
+// narrows a difference down by asking again for the first differing sub-range split more finely. Returns the first
+// differing sub-range of at most AUDIT_STORAGE_CHECKSUM_FANOUT local rows, if any.
+ACTOR Future<Optional<KeyRange>> findChecksumMismatch(StorageServer* data,
+                                                      StorageServerInterface remoteServer,
+                                                      Version version,
+                                                      KeyRange range,
+                                                      Standalone<VectorRef<KeyValueRef, VecSerStrategy::String>> rows) {
+	state int fanout = SERVER_KNOBS->AUDIT_STORAGE_CHECKSUM_FANOUT;
+	loop {
+		// Split the rows into sub-ranges of about the same number of rows, each starting at a row
+		state GetRangeChecksumRequest req;
+		state std::vector<int> starts = { 0 };
+		req.arena.dependsOn(range.arena());
+		req.arena.dependsOn(rows.arena());
+		req.range = range;
+		req.version = version;
+		for (int k = 1; k < fanout; k++) {
+			int start = int64_t(k) * rows.size() / fanout;
+			if (start > starts.back()) {
+				starts.push_back(start);
+				req.boundaries.push_back(req.arena, rows[start].key);
+			}
+		}
+		starts.push_back(rows.size());
+
+		ErrorOr<GetRangeChecksumReply> reply = wait(remoteServer.getRangeChecksum.getReplyUnlessFailedFor(req, 2, 0));
+		if (reply.isError()) {
+			throw reply.getError();
+		}
+		int mismatch = -1;
+		for (int k = 0; k + 1 < starts.size() && mismatch == -1; k++) {
+			VectorRef<KeyValueRef, VecSerStrategy::String> subRows(rows.begin() + starts[k], starts[k + 1] - starts[k]);
+			if (k >= reply.get().checksums.size() || reply.get().checksums[k] != keyValuesChecksum(subRows)) {
+				mismatch = k;
+			}
+		}
+		if (mismatch == -1) {
+			return Optional<KeyRange>();
+		}
+
+		// A sub-range the remote server stopped before counts as differing, and is narrowed down the same way
+		KeyRangeRef sub(mismatch == 0 ? range.begin : req.boundaries[mismatch - 1],
+		                mismatch == req.boundaries.size() ? range.end : req.boundaries[mismatch]);
+		int count = starts[mismatch + 1] - starts[mismatch];
+		if (count <= fanout) {
+			return KeyRange(sub);
+		}
+		rows = Standalone<VectorRef<KeyValueRef, VecSerStrategy::String>>(
+		    VectorRef<KeyValueRef, VecSerStrategy::String>(rows.begin() + starts[mismatch], count), rows.arena());
+		range = KeyRange(sub);
+	}
+}
+
 ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
                                               AuditStorageState auditState,
                                               Version version,
@@ -4617,10 +5458,60 @@ ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
 
 	state KeyRange range = auditState.range;
 	state Key originBegin = range.begin;
+	// Where to go back to comparing checksums after comparing the rows of a range whose checksums differed
+	state Key checksumsResumeAt = range.end;
+	state bool compareChecksums = SERVER_KNOBS->AUDIT_STORAGE_COMPARE_CHECKSUMS;
 	state int validatedKeys = 0;
 	state std::string error;
 	loop {
 		try {
+			if (compareChecksums) {
+				// Only checksums of the remote server's rows are transferred, unless they differ from the local ones
+				GetKeyValuesRequest localReq;
+				localReq.begin = firstGreaterOrEqual(range.begin);
+				localReq.end = firstGreaterOrEqual(range.end);
+				localReq.limit = 1e4;
+				localReq.limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+				localReq.version = version;
+				localReq.tags = TagSet();
+				data->actors.add(getKeyValuesQ(data, localReq));
+				state GetKeyValuesReply localBatch = wait(localReq.reply.getFuture());
+				if (localBatch.error.present()) {
+					throw localBatch.error.get();
+				}
+
+				state KeyRange batch =
+				    KeyRangeRef(range.begin,
+				                localBatch.more && !localBatch.data.empty() ? keyAfter(localBatch.data.back().key)
+				                                                            : range.end);
+				Optional<KeyRange> mismatch = wait(findChecksumMismatch(
+				    data,
+				    remoteServer,
+				    version,
+				    batch,
+				    Standalone<VectorRef<KeyValueRef, VecSerStrategy::String>>(localBatch.data, localBatch.arena)));
+				if (mismatch.present()) {
+					CODE_PROBE(true, "Audit compares the rows of a range whose checksums differ");
+					TraceEvent(SevInfo, "ValidateRangeChecksumMismatch", data->thisServerID)
+					    .detail("Range", mismatch.get())
+					    .detail("RemoteServer", remoteServer.toString());
+					checksumsResumeAt = range.end;
+					range = mismatch.get();
+					compareChecksums = false;
+					continue;
+				}
+
+				validatedKeys += localBatch.data.size();
+				range = KeyRangeRef(batch.end, range.end);
+				auditState.range = KeyRangeRef(originBegin, range.begin);
+				auditState.setPhase(AuditPhase::Complete);
+				wait(persistAuditStateMap(data->cx, auditState));
+				if (range.empty()) {
+					break;
+				}
+				continue;
+			}
+
 			std::vector<Future<ErrorOr<GetKeyValuesReply>>> fs;
 			int limit = 1e4;
 			int limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
@@ -4705,7 +5596,14 @@ ACTOR Future<Void> validateRangeAgainstServer(StorageServer* data,
 			}
 
 			if (!local.more && !remote.more && local.data.size() == remote.data.size()) {
-				break;
+				if (range.end == checksumsResumeAt) {
+					break;
+				}
+				// The rows of a range whose checksums differed all matched, which happens when the remote server
+				// stopped short of it
+				range = KeyRangeRef(range.end, checksumsResumeAt);
+				compareChecksums = true;
+				continue;
 			} else if (i >= local.data.size() && !local.more && i < remote.data.size()) {
 				error = format("Missing key(s) form local server (%lld), next key: %s, remote server(%016llx) ",
 				               data->thisServerID.first(),
@@ -5043,6 +5941,12 @@ TEST_CASE("/fdbserver/storageserver/constructMappedKey") {
 	return Void();
 }
 
+// Whether a mapped range read returns the index entry that a secondary range read was made for
+static bool keepMappedIndexEntry(int matchIndex, const GetRangeReqAndResultRef& getRange) {
+	return (!getRange.result.empty() && matchIndex == MATCH_INDEX_MATCHED_ONLY) ||
+	       (getRange.result.empty() && matchIndex == MATCH_INDEX_UNMATCHED_ONLY) || matchIndex == MATCH_INDEX_ALL;
+}
+
 // Issues a secondary query (either range and point read) and fills results into "kvm".
 ACTOR Future<Void> mapSubquery(StorageServer* data,
                                Version version,
@@ -5056,8 +5960,7 @@ ACTOR Future<Void> mapSubquery(StorageServer* data,
 	if (isRangeQuery) {
 		// Use the mappedKey as the prefix of the range query.
 		GetRangeReqAndResultRef getRange = wait(quickGetKeyValues(data, mappedKey, version, pArena, pOriginalReq));
-		if ((!getRange.result.empty() && matchIndex == MATCH_INDEX_MATCHED_ONLY) ||
-		    (getRange.result.empty() && matchIndex == MATCH_INDEX_UNMATCHED_ONLY) || matchIndex == MATCH_INDEX_ALL) {
+		if (keepMappedIndexEntry(matchIndex, getRange)) {
 			kvm->key = it->key;
 			kvm->value = it->value;
 		}
@@ -5113,8 +6016,16 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 	preprocessMappedKey(mappedKeyFormatTuple, vt, isRangeQuery);
 
 	state int sz = input.data.size();
-	const int k = std::min(sz, SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE);
-	state std::vector<MappedKeyValueRef> kvms(k);
+	state int parallelism = SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE;
+	if (pOriginalReq->maxParallelLookups.present()) {
+		parallelism =
+		    std::clamp(pOriginalReq->maxParallelLookups.get(), 1, SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE_LIMIT);
+	}
+	state std::vector<MappedKeyValueRef> kvms(sz);
+	// The index of the first entry with the same mapped key, if it is not the entry itself. Index entries often map to
+	// the same record, which is then read once.
+	state std::vector<int> firstWithMappedKey(sz);
+	state std::unordered_map<KeyRef, int> mappedKeyIndex;
 	state std::vector<Future<Void>> subqueries;
 	state int offset = 0;
 	if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
@@ -5122,10 +6033,11 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 		                      pOriginalReq->options.get().debugID.get().first(),
 		                      "storageserver.mapKeyValues.BeforeLoop");
 
-	for (; offset<sz&& * remainingLimitBytes> 0; offset += SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE) {
-		// Divide into batches of MAX_PARALLEL_QUICK_GET_VALUE subqueries
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
-			KeyValueRef* it = &input.data[i + offset];
+	for (; offset<sz&& * remainingLimitBytes> 0; offset += parallelism) {
+		// Divide into batches of parallelism subqueries
+		std::vector<std::pair<KeyRef, MappedKeyValueRef*>> pointLookups;
+		for (int i = offset; i < sz && i < offset + parallelism; i++) {
+			KeyValueRef* it = &input.data[i];
 			MappedKeyValueRef* kvm = &kvms[i];
 			// Clear key value to the default.
 			kvm->key = ""_sr;
@@ -5137,8 +6049,20 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 			// std::cout << "key:" << printable(kvm->key) << ", value:" << printable(kvm->value)
 			//          << ", mappedKey:" << printable(mappedKey) << std::endl;
 
-			subqueries.push_back(mapSubquery(
-			    data, input.version, pOriginalReq, &result.arena, matchIndex, isRangeQuery, it, kvm, mappedKey));
+			auto [mapped, inserted] = mappedKeyIndex.emplace(mappedKey, i);
+			firstWithMappedKey[i] = mapped->second;
+			if (!inserted) {
+				++data->counters.mappedRangeDuplicateLookups;
+			} else if (isRangeQuery) {
+				subqueries.push_back(mapSubquery(
+				    data, input.version, pOriginalReq, &result.arena, matchIndex, isRangeQuery, it, kvm, mappedKey));
+			} else {
+				pointLookups.emplace_back(mappedKey, kvm);
+			}
+		}
+		if (!pointLookups.empty()) {
+			subqueries.push_back(
+			    quickGetValues(data, std::move(pointLookups), input.version, &result.arena, pOriginalReq));
 		}
 		wait(waitForAll(subqueries));
 		if (pOriginalReq->options.present() && pOriginalReq->options.get().debugID.present())
@@ -5146,9 +6070,17 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 			                      pOriginalReq->options.get().debugID.get().first(),
 			                      "storageserver.mapKeyValues.AfterBatch");
 		subqueries.clear();
-		for (int i = 0; i + offset < sz && i < SERVER_KNOBS->MAX_PARALLEL_QUICK_GET_VALUE; i++) {
+		for (int i = offset; i < sz && i < offset + parallelism; i++) {
+			if (firstWithMappedKey[i] != i) {
+				kvms[i].reqAndResult = kvms[firstWithMappedKey[i]].reqAndResult;
+				if (isRangeQuery &&
+				    keepMappedIndexEntry(matchIndex, std::get<GetRangeReqAndResultRef>(kvms[i].reqAndResult))) {
+					kvms[i].key = input.data[i].key;
+					kvms[i].value = input.data[i].value;
+				}
+			}
 			// since we always read the index, so always consider the index size
-			int indexSize = sizeof(KeyValueRef) + input.data[i + offset].expectedSize();
+			int indexSize = sizeof(KeyValueRef) + input.data[i].expectedSize();
 			int size = indexSize + getMappedKeyValueSize(kvms[i]);
 			*remainingLimitBytes -= size;
 			result.data.push_back(result.arena, kvms[i]);
@@ -5175,14 +6107,7 @@ ACTOR Future<GetMappedKeyValuesReply> mapKeyValues(StorageServer* data,
 	return result;
 }
 
-bool rangeIntersectsAnyTenant(VersionedMap<int64_t, Void>& tenantMap, KeyRangeRef range, Version ver) {
-	auto view = tenantMap.at(ver);
-
-	// There are no tenants, so we don't need to do any work
-	if (view.begin() == view.end()) {
-		return false;
-	}
-
+bool rangeIntersectsAnyTenant(TenantIndex const& tenantMap, KeyRangeRef range, Version ver) {
 	if (range.begin >= "\x80"_sr) {
 		return false;
 	}
@@ -5216,19 +6141,15 @@ bool rangeIntersectsAnyTenant(VersionedMap<int64_t, Void>& tenantMap, KeyRangeRe
 		endId = TenantAPI::prefixToId(prefix) - 1;
 	}
 
-	auto beginItr = view.lower_bound(beginId);
-
-	// If beginItr has a value less than or equal to endId, then it points to a tenant intersecting the range
-	return beginItr != view.end() && beginItr.key() <= endId;
+	return tenantMap.containsAnyInRange(beginId, endId, ver);
 }
 
 TEST_CASE("/fdbserver/storageserver/rangeIntersectsAnyTenant") {
 	std::set<int64_t> entries = { 0, 2, 3, 4, 6 };
 
-	VersionedMap<int64_t, Void> tenantMap;
-	tenantMap.createNewVersion(1);
+	TenantIndex tenantMap;
 	for (auto entry : entries) {
-		tenantMap.insert(entry, Void());
+		tenantMap.insert(entry, 1);
 	}
 
 	// Before all tenants
@@ -5313,13 +6234,12 @@ TEST_CASE("/fdbserver/storageserver/rangeIntersectsAnyTenant") {
 }
 
 TEST_CASE("/fdbserver/storageserver/randomRangeIntersectsAnyTenant") {
-	VersionedMap<int64_t, Void> tenantMap;
+	TenantIndex tenantMap;
 	std::set<Key> tenantPrefixes;
-	tenantMap.createNewVersion(1);
 	int numEntries = deterministicRandom()->randomInt(0, 20);
 	for (int i = 0; i < numEntries; ++i) {
 		int64_t tenantId = deterministicRandom()->randomInt64(0, std::numeric_limits<int64_t>::max());
-		tenantMap.insert(tenantId, Void());
+		tenantMap.insert(tenantId, 1);
 		tenantPrefixes.insert(TenantAPI::idToPrefix(tenantId));
 	}
 
@@ -5539,7 +6459,7 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
 	}
 
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	data->transactionTagCounter.addRequest(req.tags, req.begin.getKey(), resultSize);
 	++data->counters.finishedGetMappedRangeQueries;
 
 	double duration = g_network->timer() - req.requestTime();
@@ -5754,7 +6674,7 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 					end = lastKey;
 				}
 
-				data->transactionTagCounter.addRequest(req.tags, resultSize);
+				data->transactionTagCounter.addRequest(req.tags, req.begin.getKey(), resultSize);
 				// lock.release();
 			}
 		}
@@ -5766,7 +6686,7 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 		}
 	}
 
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	data->transactionTagCounter.addRequest(req.tags, req.begin.getKey(), resultSize);
 	++data->counters.finishedQueries;
 
 	return Void();
@@ -5853,7 +6773,7 @@ ACTOR Future<Void> getKeyQ(StorageServer* data, GetKeyRequest req) {
 	// SOMEDAY: The size reported here is an undercount of the bytes read due to the fact that we have to scan for the
 	// key It would be more accurate to count all the read bytes, but it's not critical because this function is only
 	// used if read-your-writes is disabled
-	data->transactionTagCounter.addRequest(req.tags, resultSize);
+	data->transactionTagCounter.addRequest(req.tags, req.sel.getKey(), resultSize);
 
 	++data->counters.finishedQueries;
 
@@ -5906,13 +6826,42 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 	eager->finishKeyBegin();
 	state ReadOptions options;
 	options.type = ReadType::EAGER;
+
+	// Both kinds of reads are issued before waiting on either, so that the engine serves them as one batch
+	state Future<std::vector<Key>> futureKeyEnds;
 	if (eager->enableClearRangeEagerReads) {
 		std::vector<Future<Key>> keyEnd(eager->keyBegin.size());
 		for (int i = 0; i < keyEnd.size(); i++)
 			keyEnd[i] = data->storage.readNextKeyInclusive(eager->keyBegin[i], options);
 		data->counters.eagerReadsKeys += keyEnd.size();
+		futureKeyEnds = getAll(keyEnd);
+	}
+
+	// Counters and other hot keys usually still have their latest value, or a clear of it, in memory, which is what
+	// convertAtomicOp() uses ahead of the eager read. Those need no engine read. The durableVersionLock held by
+	// update() keeps that data from being dropped before the mutations are applied, and the value is copied anyway
+	// so that eager stands on its own.
+	eager->value.resize(eager->keys.size());
+	state std::vector<int> engineReadIndexes;
+	std::vector<Future<Optional<Value>>> value;
+	auto view = data->data().atLatest();
+	for (int i = 0; i < eager->keys.size(); i++) {
+		KeyRef key = eager->keys[i].first;
+		auto it = view.lastLessOrEqual(key);
+		if (it && it->isValue() && it.key() == key) {
+			eager->value[i] = (Value)it->getValue();
+			++data->counters.eagerReadsFromMemory;
+		} else if (it && it->isClearTo() && it->getEndKey() > key) {
+			++data->counters.eagerReadsFromMemory;
+		} else {
+			engineReadIndexes.push_back(i);
+			value.push_back(data->storage.readValuePrefix(key, eager->keys[i].second, options));
+		}
+	}
+	data->counters.eagerReadsKeys += value.size();
+	state Future<std::vector<Optional<Value>>> futureValues = getAll(value);
 
-		state Future<std::vector<Key>> futureKeyEnds = getAll(keyEnd);
+	if (eager->enableClearRangeEagerReads) {
 		state std::vector<Key> keyEndVal = wait(futureKeyEnds);
 		for (const auto& key : keyEndVal) {
 			data->counters.kvScanBytes += key.expectedSize();
@@ -5920,19 +6869,13 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 		eager->keyEnd = keyEndVal;
 	}
 
-	std::vector<Future<Optional<Value>>> value(eager->keys.size());
-	for (int i = 0; i < value.size(); i++)
-		value[i] = data->storage.readValuePrefix(eager->keys[i].first, eager->keys[i].second, options);
-
-	state Future<std::vector<Optional<Value>>> futureValues = getAll(value);
 	std::vector<Optional<Value>> optionalValues = wait(futureValues);
-	for (const auto& value : optionalValues) {
-		if (value.present()) {
-			data->counters.kvGetBytes += value.expectedSize();
+	for (int i = 0; i < optionalValues.size(); i++) {
+		if (optionalValues[i].present()) {
+			data->counters.kvGetBytes += optionalValues[i].expectedSize();
 		}
+		eager->value[engineReadIndexes[i]] = optionalValues[i];
 	}
-	data->counters.eagerReadsKeys += eager->keys.size();
-	eager->value = optionalValues;
 
 	return Void();
 }
@@ -6003,6 +6946,11 @@ bool changeDurableVersion(StorageServer* data, Version desiredDurableVersion) {
 	}
 	data->getMutableMutationLog().erase(data->getMutationLog().begin(),
 	                                    data->getMutationLog().upper_bound(nextDurableVersion));
+	auto durableBytesEnd = data->mutationLogBytesByVersion.upper_bound(nextDurableVersion);
+	for (auto b = data->mutationLogBytesByVersion.begin(); b != durableBytesEnd; ++b) {
+		data->mutationLogBytes -= b->second;
+	}
+	data->mutationLogBytesByVersion.erase(data->mutationLogBytesByVersion.begin(), durableBytesEnd);
 	data->freeable.erase(data->freeable.begin(), data->freeable.lower_bound(nextDurableVersion));
 
 	Future<Void> checkFatalError = data->otherError.getFuture();
@@ -6508,12 +7456,99 @@ public:
 	}
 };
 
+// Reads all of keys in FETCH_BLOCK_BYTES blocks, the last of which reads through keys.end
+ACTOR Future<std::vector<RangeResult>> tryGetSubRange(Transaction* tr, KeyRange keys) {
+	state std::vector<RangeResult> blocks;
+	state KeySelectorRef begin = firstGreaterOrEqual(keys.begin);
+	state KeySelectorRef end = firstGreaterOrEqual(keys.end);
+
+	loop {
+		GetRangeLimits limits(GetRangeLimits::ROW_LIMIT_UNLIMITED, SERVER_KNOBS->FETCH_BLOCK_BYTES);
+		limits.minRows = 0;
+		RangeResult rep = wait(tr->getRange(begin, end, limits, Snapshot::True));
+		if (!rep.more) {
+			rep.readThrough = keys.end;
+		}
+		blocks.push_back(rep);
+
+		if (!rep.more) {
+			return blocks;
+		}
+
+		if (rep.readThrough.present()) {
+			begin = firstGreaterOrEqual(rep.readThrough.get());
+		} else {
+			begin = firstGreaterThan(rep.end()[-1].key);
+		}
+	}
+}
+
+// Splits keys at the byte sample split points of the source servers and reads FETCH_KEYS_PARALLEL_RANGES sub-ranges at
+// a time, so that a large shard is not fetched one block round trip at a time from a single replica. Blocks are
+// delivered in key order, as fetchKeys expects. A sub-range is only delivered once fetchKeys has consumed the previous
+// one, so at most FETCH_KEYS_PARALLEL_RANGES + 1 sub-ranges are buffered when fetchKeys is throttled.
+ACTOR Future<Void> tryGetRangeParallel(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
+	state Standalone<VectorRef<KeyRef>> splitPoints;
+	state std::deque<Future<std::vector<RangeResult>>> subRanges;
+	state int nextSplit = 1;
+
+	try {
+		try {
+			Standalone<VectorRef<KeyRef>> points =
+			    wait(tr->getRangeSplitPoints(keys, SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGE_BYTES));
+			splitPoints = points;
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			// The split points only spread out the work, so fetch the range whole if we could not get them
+			splitPoints = Standalone<VectorRef<KeyRef>>();
+		}
+		if (splitPoints.size() < 2) {
+			splitPoints = Standalone<VectorRef<KeyRef>>();
+			splitPoints.push_back_deep(splitPoints.arena(), keys.begin);
+			splitPoints.push_back_deep(splitPoints.arena(), keys.end);
+		}
+
+		loop {
+			while (subRanges.size() < SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGES && nextSplit < splitPoints.size()) {
+				KeyRangeRef subRange(splitPoints[nextSplit - 1], splitPoints[nextSplit]);
+				subRanges.push_back(tryGetSubRange(tr, subRange));
+				++nextSplit;
+			}
+			if (subRanges.empty()) {
+				results.sendError(end_of_stream());
+				return Void();
+			}
+
+			state std::vector<RangeResult> blocks = wait(subRanges.front());
+			subRanges.pop_front();
+			wait(results.onEmpty());
+			for (auto& block : blocks) {
+				results.send(block);
+			}
+			blocks.clear();
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		results.sendError(e);
+		throw;
+	}
+}
+
 ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
 	if (SERVER_KNOBS->FETCH_USING_STREAMING) {
 		wait(tr->getRangeStream(results, keys, GetRangeLimits(), Snapshot::True));
 		return Void();
 	}
 
+	if (SERVER_KNOBS->FETCH_KEYS_PARALLEL_RANGES > 1) {
+		wait(tryGetRangeParallel(results, tr, keys));
+		return Void();
+	}
+
 	state KeySelectorRef begin = firstGreaterOrEqual(keys.begin);
 	state KeySelectorRef end = firstGreaterOrEqual(keys.end);
 
@@ -9042,8 +10077,7 @@ private:
 void StorageServer::insertTenant(StringRef tenantPrefix, TenantName tenantName, Version version, bool persist) {
 	if (version >= tenantMap.getLatestVersion()) {
 		int64_t tenantId = TenantAPI::prefixToId(tenantPrefix);
-		tenantMap.createNewVersion(version);
-		tenantMap.insert(tenantId, Void());
+		tenantMap.insert(tenantId, version);
 
 		if (persist) {
 			auto& mLV = addVersionToMutationLog(version);
@@ -9058,21 +10092,18 @@ void StorageServer::insertTenant(StringRef tenantPrefix, TenantName tenantName,
 
 void StorageServer::clearTenants(StringRef startTenant, StringRef endTenant, Version version) {
 	if (version >= tenantMap.getLatestVersion()) {
-		tenantMap.createNewVersion(version);
-
-		auto view = tenantMap.at(version);
 		auto& mLV = addVersionToMutationLog(version);
-		std::set<int64_t> tenantsToClear;
+		std::vector<int64_t> tenantsToClear;
 		Optional<int64_t> startId = TenantIdCodec::lowerBound(startTenant);
 		Optional<int64_t> endId = TenantIdCodec::lowerBound(endTenant);
-		auto startItr = startId.present() ? view.lower_bound(startId.get()) : view.end();
-		auto endItr = endId.present() ? view.lower_bound(endId.get()) : view.end();
-		for (auto itr = startItr; itr != endItr; ++itr) {
-			auto mapKey = itr.key();
+		if (startId.present()) {
+			tenantsToClear = tenantMap.getRange(
+			    startId.get(), endId.orDefault(std::numeric_limits<int64_t>::max()), latestVersion);
+		}
+		for (auto mapKey : tenantsToClear) {
 			// Trigger any watches on the prefix associated with the tenant.
 			TraceEvent("EraseTenant", thisServerID).detail("TenantID", mapKey).detail("Version", version);
 			tenantWatches.sendError(mapKey, mapKey + 1, tenant_removed());
-			tenantsToClear.insert(mapKey);
 		}
 		addMutationToMutationLog(mLV,
 		                         MutationRef(MutationRef::ClearRange,
@@ -9080,7 +10111,7 @@ void StorageServer::clearTenants(StringRef startTenant, StringRef endTenant, Ver
 		                                     endTenant.withPrefix(persistTenantMapKeys.begin)));
 
 		for (auto tenantId : tenantsToClear) {
-			tenantMap.erase(tenantId);
+			tenantMap.erase(tenantId, version);
 		}
 	}
 }
@@ -9660,6 +10691,50 @@ ACTOR Future<Void> createCheckpoint(StorageServer* data, CheckpointMetaData meta
 	return Void();
 }
 
+ACTOR Future<Void> expirePinnedSnapshot(StorageServer* data, Version version) {
+	loop {
+		auto pin = data->pinnedSnapshots.find(version);
+		if (pin == data->pinnedSnapshots.end()) {
+			return Void();
+		}
+		if (now() >= pin->second.leaseExpires) {
+			TraceEvent("PinnedSnapshotExpired", data->thisServerID).detail("Version", version);
+			data->pinnedSnapshots.erase(pin);
+			return Void();
+		}
+		wait(delayUntil(pin->second.leaseExpires));
+	}
+}
+
+// Pins a snapshot of the storage engine for a pending pin request at version, which must have just been committed
+void pinSnapshot(StorageServer* data, Version version) {
+	ASSERT(version == data->storageVersion());
+	auto pending = data->pendingPins.find(version);
+	Promise<Void> pinned = pending->second;
+	data->pendingPins.erase(pending);
+
+	Reference<IKeyValueStoreSnapshot> snapshot = data->storage.pinSnapshot();
+	if (!snapshot) {
+		pinned.sendError(unsupported_operation());
+		return;
+	}
+	StorageServer::PinnedSnapshot& pin = data->pinnedSnapshots[version];
+	pin.snapshot = snapshot;
+	pin.leaseExpires = now() + SERVER_KNOBS->STORAGE_PINNED_SNAPSHOT_LEASE;
+	// Ranges that are being fetched or were never assigned may be missing from the engine, or only partly there
+	for (auto r : data->newestAvailableVersion.ranges()) {
+		if (r.value() == latestVersion) {
+			pin.readable.push_back(r.range());
+		}
+	}
+	data->actors.add(expirePinnedSnapshot(data, version));
+	TraceEvent("PinnedSnapshot", data->thisServerID)
+	    .detail("Version", version)
+	    .detail("ReadableRanges", pin.readable.size())
+	    .detail("Pinned", data->pinnedSnapshots.size());
+	pinned.send(Void());
+}
+
 ACTOR Future<Void> updateStorage(StorageServer* data) {
 	state UnlimitedCommitBytes unlimitedCommitBytes = UnlimitedCommitBytes::False;
 	loop {
@@ -9711,6 +10786,17 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 			}
 		}
 
+		// Pins are requested at read versions, which may have become durable before a request arrived
+		while (!data->pendingPins.empty() && data->pendingPins.begin()->first <= startOldestVersion) {
+			data->pendingPins.begin()->second.sendError(transaction_too_old());
+			data->pendingPins.erase(data->pendingPins.begin());
+		}
+
+		// Like checkpoints, a snapshot can only be pinned after a commit of exactly its version
+		if (!data->pendingPins.empty() && data->pendingPins.begin()->first <= desiredVersion) {
+			desiredVersion = data->pendingPins.begin()->first;
+		}
+
 		state bool removeKVSRanges = false;
 		if (!data->pendingRemoveRanges.empty()) {
 			const Version aVer = data->pendingRemoveRanges.begin()->first;
@@ -9761,15 +10847,12 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		loop {
 			state bool done = data->storage.makeVersionMutationsDurable(
 			    newOldestVersion, desiredVersion, bytesLeft, unlimitedCommitBytes);
-			if (data->tenantMap.getLatestVersion() < newOldestVersion) {
-				data->tenantMap.createNewVersion(newOldestVersion);
-			}
 			// We want to forget things from these data structures atomically with changing oldestVersion (and "before",
 			// since oldestVersion.set() may trigger waiting actors) forgetVersionsBeforeAsync visibly forgets
 			// immediately (without waiting) but asynchronously frees memory.
 			Future<Void> finishedForgetting =
-			    data->mutableData().forgetVersionsBeforeAsync(newOldestVersion, TaskPriority::UpdateStorage) &&
-			    data->tenantMap.forgetVersionsBeforeAsync(newOldestVersion, TaskPriority::UpdateStorage);
+			    data->mutableData().forgetVersionsBeforeAsync(newOldestVersion, TaskPriority::UpdateStorage);
+			data->tenantMap.forgetVersionsBefore(newOldestVersion);
 			data->oldestVersion.set(newOldestVersion);
 			wait(finishedForgetting);
 			wait(yield(TaskPriority::UpdateStorage));
@@ -9929,6 +11012,10 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 			requireCheckpoint = false;
 		}
 
+		if (data->pendingPins.count(newOldestVersion)) {
+			pinSnapshot(data, newOldestVersion);
+		}
+
 		if (newOldestVersion > data->rebootAfterDurableVersion) {
 			TraceEvent("RebootWhenDurableTriggered", data->thisServerID)
 			    .detail("NewOldestVersion", newOldestVersion)
@@ -10069,9 +11156,8 @@ void StorageServerDisk::makeNewStorageServerDurable(const bool shardAware) {
 		storage->set(KeyValueRef(persistShardAvailableKeys.begin.toString(), "0"_sr));
 	}
 
-	auto view = data->tenantMap.atLatest();
-	for (auto itr = view.begin(); itr != view.end(); ++itr) {
-		storage->set(KeyValueRef(TenantAPI::idToPrefix(itr.key()).withPrefix(persistTenantMapKeys.begin), ""_sr));
+	for (int64_t tenantId : data->tenantMap.getRange(0, std::numeric_limits<int64_t>::max(), latestVersion)) {
+		storage->set(KeyValueRef(TenantAPI::idToPrefix(tenantId).withPrefix(persistTenantMapKeys.begin), ""_sr));
 	}
 }
 
@@ -10173,6 +11259,7 @@ void setAssignedStatus(StorageServer* self, KeyRangeRef keys, bool nowAssigned)
 }
 
 void StorageServerDisk::clearRange(KeyRangeRef keys) {
+	data->rangeReadCache.invalidate(keys);
 	storage->clear(keys, &data->metrics);
 	++(*kvClearRanges);
 	if (keys.singleKeyRange()) {
@@ -10180,16 +11267,46 @@ void StorageServerDisk::clearRange(KeyRangeRef keys) {
 	}
 }
 
+ACTOR static Future<Void> commitStorage(StorageServer* data, Future<Void> commit) {
+	wait(commit);
+	data->rangeReadCache.invalidateReads();
+	return Void();
+}
+
+Future<Void> StorageServerDisk::commit() {
+	if (!data->rangeReadCache.enabled()) {
+		return storage->commit();
+	}
+	return commitStorage(data, storage->commit());
+}
+
+std::vector<std::string> StorageServerDisk::removeRange(KeyRangeRef range) {
+	data->rangeReadCache.invalidate(range);
+	data->clearedRanges.written(range);
+	return storage->removeRange(range);
+}
+
+Future<Void> StorageServerDisk::restore(const std::vector<CheckpointMetaData>& checkpoints) {
+	data->rangeReadCache.clear();
+	data->clearedRanges.clear();
+	return storage->restore(checkpoints);
+}
+
 void StorageServerDisk::writeKeyValue(KeyValueRef kv) {
+	data->rangeReadCache.invalidate(kv.key);
+	data->clearedRanges.written(kv.key);
 	storage->set(kv);
 	*kvCommitLogicalBytes += kv.expectedSize();
 }
 
 void StorageServerDisk::writeMutation(MutationRef mutation) {
 	if (mutation.type == MutationRef::SetValue) {
+		data->rangeReadCache.invalidate(mutation.param1);
+		data->clearedRanges.written(mutation.param1);
 		storage->set(KeyValueRef(mutation.param1, mutation.param2));
 		*kvCommitLogicalBytes += mutation.expectedSize();
 	} else if (mutation.type == MutationRef::ClearRange) {
+		data->rangeReadCache.invalidate(KeyRangeRef(mutation.param1, mutation.param2));
 		storage->clear(KeyRangeRef(mutation.param1, mutation.param2), &data->metrics);
 		++(*kvClearRanges);
 		if (KeyRangeRef(mutation.param1, mutation.param2).singleKeyRange()) {
@@ -10200,14 +11317,18 @@ void StorageServerDisk::writeMutation(MutationRef mutation) {
 }
 
 void StorageServerDisk::writeMutations(const VectorRef<MutationRef>& mutations,
-                                       Version debugVersion,
+                                       Version version,
                                        const char* debugContext) {
 	for (const auto& m : mutations) {
-		DEBUG_MUTATION(debugContext, debugVersion, m, data->thisServerID);
+		DEBUG_MUTATION(debugContext, version, m, data->thisServerID);
 		if (m.type == MutationRef::SetValue) {
+			data->rangeReadCache.invalidate(m.param1);
+			data->clearedRanges.written(m.param1);
 			storage->set(KeyValueRef(m.param1, m.param2));
 			*kvCommitLogicalBytes += m.expectedSize();
 		} else if (m.type == MutationRef::ClearRange) {
+			data->rangeReadCache.invalidate(KeyRangeRef(m.param1, m.param2));
+			data->clearedRanges.cleared(KeyRangeRef(m.param1, m.param2), version);
 			storage->clear(KeyRangeRef(m.param1, m.param2), &data->metrics);
 			++(*kvClearRanges);
 			if (KeyRangeRef(m.param1, m.param2).singleKeyRange()) {
@@ -10328,6 +11449,17 @@ ACTOR Future<Void> applyByteSampleResult(StorageServer* data,
 	return Void();
 }
 
+ACTOR Future<Void> applyByteSampleResultLimited(StorageServer* data,
+                                                IKeyValueStore* storage,
+                                                FlowLock* readLock,
+                                                Key begin,
+                                                Key end) {
+	wait(readLock->take());
+	state FlowLock::Releaser releaser(*readLock);
+	wait(applyByteSampleResult(data, storage, begin, end));
+	return Void();
+}
+
 ACTOR Future<Void> restoreByteSample(StorageServer* data,
                                      IKeyValueStore* storage,
                                      Promise<Void> byteSampleSampleRecovered,
@@ -10338,6 +11470,7 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 	byteSampleSampleRecovered.send(Void());
 	wait(startRestore);
 	wait(delay(SERVER_KNOBS->BYTE_SAMPLE_START_DELAY));
+	state double startTime = now();
 
 	size_t bytes_per_fetch = 0;
 	// Since the expected size also includes (as of now) the space overhead of the container, we calculate our own
@@ -10347,8 +11480,13 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 			bytes_per_fetch += BinaryReader::fromStringRef<int32_t>(kv.value, Unversioned());
 		}
 	}
-	bytes_per_fetch = (bytes_per_fetch / SERVER_KNOBS->BYTE_SAMPLE_LOAD_PARALLELISM) + 1;
+	// More ranges than reads at a time, so that a range that reads slowly does not hold up the whole restore
+	bytes_per_fetch =
+	    (bytes_per_fetch /
+	     std::max(SERVER_KNOBS->BYTE_SAMPLE_LOAD_CHUNKS, SERVER_KNOBS->BYTE_SAMPLE_LOAD_PARALLELISM)) +
+	    1;
 
+	state FlowLock readLock(SERVER_KNOBS->BYTE_SAMPLE_LOAD_PARALLELISM);
 	state std::vector<Future<Void>> sampleRanges;
 	int accumulatedSize = 0;
 	Key lastStart =
@@ -10358,17 +11496,20 @@ ACTOR Future<Void> restoreByteSample(StorageServer* data,
 			if (accumulatedSize >= bytes_per_fetch) {
 				accumulatedSize = 0;
 				Key realKey = kv.key.removePrefix(persistByteSampleKeys.begin);
-				sampleRanges.push_back(applyByteSampleResult(data, storage, lastStart, realKey));
+				sampleRanges.push_back(applyByteSampleResultLimited(data, storage, &readLock, lastStart, realKey));
 				lastStart = realKey;
 			}
 			accumulatedSize += BinaryReader::fromStringRef<int32_t>(kv.value, Unversioned());
 		}
 	}
 	// make sure that the last range goes all the way to the end of the byte sample
-	sampleRanges.push_back(applyByteSampleResult(data, storage, lastStart, persistByteSampleKeys.end));
+	sampleRanges.push_back(
+	    applyByteSampleResultLimited(data, storage, &readLock, lastStart, persistByteSampleKeys.end));
 
 	wait(waitForAll(sampleRanges));
-	TraceEvent("RecoveredByteSampleChunkedRead", data->thisServerID).detail("Ranges", sampleRanges.size());
+	TraceEvent("RecoveredByteSampleChunkedRead", data->thisServerID)
+	    .detail("Ranges", sampleRanges.size())
+	    .detail("Duration", now() - startTime);
 
 	if (BUGGIFY)
 		wait(delay(deterministicRandom()->random01() * 10.0));
@@ -10408,12 +11549,15 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	                             fCheckpoints,
 	                             fTenantMap,
 	                             fStorageShards }));
-	wait(byteSampleSampleRecovered.getFuture());
+	// The byte sample's own sample is read alongside the rest of the restore rather than before it. Like the rest of
+	// the byte sample, it is applied safely while mutations are already changing the sample.
 	TraceEvent("RestoringDurableState", data->thisServerID).log();
 
 	if (!fFormat.get().present()) {
 		// The DB was never initialized
 		TraceEvent("DBNeverInitialized", data->thisServerID).log();
+		// Don't dispose of the engine under a read
+		wait(byteSampleSampleRecovered.getFuture() || data->byteSampleRecovery);
 		storage->dispose();
 		data->thisServerID = UID();
 		data->sk = Key();
@@ -10566,7 +11710,7 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 		auto const& result = tenantMap[tenantMapLoc];
 		int64_t tenantId = TenantAPI::prefixToId(result.key.substr(persistTenantMapKeys.begin.size()));
 
-		data->tenantMap.insert(tenantId, Void());
+		data->tenantMap.insert(tenantId, data->tenantMap.getLatestVersion());
 
 		TraceEvent("RestoringTenant", data->thisServerID)
 		    .detail("Key", tenantMap[tenantMapLoc].key)
@@ -10721,12 +11865,14 @@ void StorageServer::byteSampleApplyClear(KeyRangeRef range, Version ver) {
 ACTOR Future<Void> waitMetrics(StorageServerMetrics* self, WaitMetricsRequest req, Future<Void> timeout) {
 	state PromiseStream<StorageMetrics> change;
 	state StorageMetrics metrics = self->getMetrics(req.keys);
+	// What is compared and replied, which also counts recent writes; metrics keeps the plain averages
+	state StorageMetrics reported = self->withRecentWrites(req.keys, metrics);
 	state Error error = success();
 	state bool timedout = false;
 
-	if (!req.min.allLessOrEqual(metrics) || !metrics.allLessOrEqual(req.max)) {
+	if (!req.min.allLessOrEqual(reported) || !reported.allLessOrEqual(req.max)) {
 		CODE_PROBE(true, "ShardWaitMetrics return case 1 (quickly)");
-		req.reply.send(metrics);
+		req.reply.send(reported);
 		return Void();
 	}
 
@@ -10776,14 +11922,17 @@ ACTOR Future<Void> waitMetrics(StorageServerMetrics* self, WaitMetricsRequest re
 				if (deterministicRandom()->random01() < SERVER_KNOBS->WAIT_METRICS_WRONG_SHARD_CHANCE) {
 					req.reply.sendError(wrong_shard_server());
 				} else {
-					req.reply.send(metrics);
+					req.reply.send(self->withRecentWrites(req.keys, metrics));
 				}
 				break;
 			}
 
-			if (!req.min.allLessOrEqual(metrics) || !metrics.allLessOrEqual(req.max)) {
+			reported = self->withRecentWrites(req.keys, metrics);
+			if (!req.min.allLessOrEqual(reported) || !reported.allLessOrEqual(req.max)) {
 				CODE_PROBE(true, "ShardWaitMetrics return case 2 (delayed)");
-				req.reply.send(metrics);
+				CODE_PROBE(reported.bytesWrittenPerKSecond > metrics.bytesWrittenPerKSecond,
+				           "ShardWaitMetrics return on recent writes");
+				req.reply.send(reported);
 				break;
 			}
 		}
@@ -10960,6 +12109,27 @@ ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetVa
 	}
 }
 
+ACTOR Future<Void> serveGetValuesRequests(StorageServer* self, FutureStream<GetValuesRequest> getValues) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
+	loop {
+		GetValuesRequest req = waitNext(getValues);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		self->actors.add(self->readGuard(req, getValuesQ));
+	}
+}
+
+ACTOR Future<Void> serveGetRangeAggregateRequests(StorageServer* self,
+                                                  FutureStream<GetRangeAggregateRequest> getRangeAggregate) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
+	loop {
+		GetRangeAggregateRequest req = waitNext(getRangeAggregate);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		self->actors.add(self->readGuard(req, getRangeAggregateQ));
+	}
+}
+
 ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<GetKeyValuesRequest> getKeyValues) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
 	loop {
@@ -11214,6 +12384,8 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	self->actors.add(logLongByteSampleRecovery(self->byteSampleRecovery));
 	self->actors.add(checkBehind(self));
 	self->actors.add(serveGetValueRequests(self, ssi.getValue.getFuture()));
+	self->actors.add(serveGetValuesRequests(self, ssi.getValues.getFuture()));
+	self->actors.add(serveGetRangeAggregateRequests(self, ssi.getRangeAggregate.getFuture()));
 	self->actors.add(serveGetKeyValuesRequests(self, ssi.getKeyValues.getFuture()));
 	self->actors.add(serveGetMappedKeyValuesRequests(self, ssi.getMappedKeyValues.getFuture()));
 	self->actors.add(serveGetKeyValuesStreamRequests(self, ssi.getKeyValuesStream.getFuture()));
@@ -11352,6 +12524,12 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 			when(AuditStorageRequest req = waitNext(ssi.auditStorage.getFuture())) {
 				self->actors.add(auditStorageQ(self, req));
 			}
+			when(GetRangeChecksumRequest req = waitNext(ssi.getRangeChecksum.getFuture())) {
+				self->actors.add(getRangeChecksumQ(self, req));
+			}
+			when(PinReadVersionRequest req = waitNext(ssi.pinReadVersion.getFuture())) {
+				self->actors.add(pinReadVersionQ(self, req));
+			}
 			when(wait(updateProcessStatsTimer)) {
 				updateProcessStats(self);
 				updateProcessStatsTimer = delay(SERVER_KNOBS->FASTRESTORE_UPDATE_PROCESS_STATS_INTERVAL);
@@ -11898,3 +13076,212 @@ void versionedMapTest() {
 	printf("%d distinct after %d insertions\n", count, 1000 * 1000);
 	printf("Memory used: %f MB\n", (after - before) / 1e6);
 }
+
+// A storage engine that serves reads from memory, so that the read path benchmark below measures the storage server
+// rather than the engine
+class ReadPathBenchmarkEngine final : public IKeyValueStore {
+public:
+	KeyValueStoreType getType() const override { return KeyValueStoreType::MEMORY; }
+	void set(KeyValueRef keyValue, const Arena* arena = nullptr) override { data[keyValue.key] = keyValue.value; }
+	void clear(KeyRangeRef range, const StorageServerMetrics* storageMetrics, const Arena* arena) override {
+		data.erase(data.lower_bound(range.begin), data.lower_bound(range.end));
+	}
+	Future<Void> commit(bool sequential) override { return Void(); }
+
+	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override {
+		auto it = data.find(key);
+		return it == data.end() ? Optional<Value>() : Optional<Value>(it->second);
+	}
+	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
+		auto it = data.find(key);
+		if (it == data.end()) {
+			return Optional<Value>();
+		}
+		return Optional<Value>(it->second.substr(0, std::min(maxLength, it->second.size())));
+	}
+	Future<RangeResult> readRange(KeyRangeRef keys,
+	                              int rowLimit,
+	                              int byteLimit,
+	                              Optional<ReadOptions> options) override {
+		RangeResult result;
+		bool forward = rowLimit > 0;
+		rowLimit = std::abs(rowLimit);
+		auto add = [&](auto const& kv) {
+			byteLimit -= sizeof(KeyValueRef) + kv.first.size() + kv.second.size();
+			result.push_back_deep(result.arena(), KeyValueRef(kv.first, kv.second));
+			--rowLimit;
+		};
+		if (forward) {
+			for (auto it = data.lower_bound(keys.begin); it != data.end() && it->first < keys.end; ++it) {
+				if (!rowLimit || byteLimit <= 0) {
+					break;
+				}
+				add(*it);
+			}
+		} else {
+			for (auto it = data.lower_bound(keys.end); it != data.begin() && std::prev(it)->first >= keys.begin; --it) {
+				if (!rowLimit || byteLimit <= 0) {
+					break;
+				}
+				add(*std::prev(it));
+			}
+		}
+		result.more = rowLimit == 0 || byteLimit <= 0;
+		if (result.more && !result.empty()) {
+			result.readThrough = result.back().key;
+		}
+		return result;
+	}
+
+	StorageBytes getStorageBytes() const override { return StorageBytes(0, 0, 0, 0); }
+	Future<EncryptionAtRestMode> encryptionMode() override {
+		return EncryptionAtRestMode(EncryptionAtRestMode::DISABLED);
+	}
+	Future<Void> getError() const override { return Never(); }
+	Future<Void> onClosed() const override { return Void(); }
+	void dispose() override { delete this; }
+	void close() override { delete this; }
+
+private:
+	std::map<Key, Value, std::less<>> data;
+};
+
+enum class ReadPathRequest { GetValue, GetKeyValues, GetMappedKeyValues };
+
+static Key readPathRecordKey(int64_t id) {
+	return Tuple::makeTuple("r"_sr, id).pack();
+}
+
+static Key readPathIndexKey(int64_t id) {
+	return Tuple::makeTuple("i"_sr, id).pack();
+}
+
+// Issues requests of one type back to back, each at a random version of the MVCC window
+ACTOR static Future<Void> readPathBenchmarkClient(StorageServer* data,
+                                                  ReadPathRequest type,
+                                                  int requests,
+                                                  int records,
+                                                  int rangeSize) {
+	state int i = 0;
+	for (; i < requests; ++i) {
+		state Version version = deterministicRandom()->randomInt64(data->oldestVersion.get(), data->version.get() + 1);
+		state int64_t id = deterministicRandom()->randomInt(0, records - rangeSize);
+		if (type == ReadPathRequest::GetValue) {
+			GetValueRequest req(SpanContext(),
+			                    TenantInfo(),
+			                    readPathRecordKey(id),
+			                    version,
+			                    Optional<TagSet>(),
+			                    Optional<ReadOptions>(),
+			                    VersionVector());
+			data->actors.add(getValueQ(data, req));
+			GetValueReply reply = wait(req.reply.getFuture());
+			ASSERT(!reply.error.present());
+		} else if (type == ReadPathRequest::GetKeyValues) {
+			GetKeyValuesRequest req;
+			req.begin = firstGreaterOrEqual(KeyRef(req.arena, readPathRecordKey(id)));
+			req.end = firstGreaterOrEqual(KeyRef(req.arena, readPathRecordKey(id + rangeSize)));
+			req.version = version;
+			req.limit = rangeSize;
+			req.limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+			data->actors.add(getKeyValuesQ(data, req));
+			GetKeyValuesReply reply = wait(req.reply.getFuture());
+			ASSERT(!reply.error.present());
+		} else {
+			GetMappedKeyValuesRequest req;
+			req.begin = firstGreaterOrEqual(KeyRef(req.arena, readPathIndexKey(id)));
+			req.end = firstGreaterOrEqual(KeyRef(req.arena, readPathIndexKey(id + rangeSize)));
+			req.mapper = KeyRef(req.arena, Tuple::makeTuple("r"_sr, "{K[1]}"_sr).pack());
+			req.version = version;
+			req.limit = rangeSize;
+			req.limitBytes = CLIENT_KNOBS->REPLY_BYTE_LIMIT;
+			req.matchIndex = MATCH_INDEX_ALL;
+			data->actors.add(getMappedKeyValuesQ(data, req));
+			GetMappedKeyValuesReply reply = wait(req.reply.getFuture());
+			ASSERT(!reply.error.present());
+		}
+	}
+	return Void();
+}
+
+// Measures the CPU time and FastAllocator allocations per read request of the storage server's read path, with the
+// records in an in-memory engine at the oldest version and a window of newer versions of them in VersionedData.
+// Everything runs on this thread, so the per thread counters cover only the storage server's work.
+TEST_CASE(":/fdbserver/storageserver/performance/readPath") {
+	state int records = params.getInt("records").orDefault(100000);
+	state int valueSize = params.getInt("valueSize").orDefault(100);
+	state int versions = params.getInt("versions").orDefault(500);
+	state int updatesPerVersion = params.getInt("updatesPerVersion").orDefault(100);
+	state int concurrency = params.getInt("concurrency").orDefault(200);
+	state int requests = params.getInt("requests").orDefault(200000);
+	state int rangeSize = params.getInt("rangeSize").orDefault(20);
+	state Version oldestVersion = 1e6;
+	// Versions as far apart as they would be in the 5 seconds of the MVCC window
+	state Version versionStep = SERVER_KNOBS->MAX_READ_TRANSACTION_LIFE_VERSIONS / std::max(versions, 1);
+
+	state ReadPathBenchmarkEngine* engine = new ReadPathBenchmarkEngine();
+	state StorageServerInterface ssi;
+	state Reference<AsyncVar<ServerDBInfo> const> db = makeReference<AsyncVar<ServerDBInfo>>();
+	state StorageServer data(engine, db, ssi);
+	state Arena arena;
+
+	data.setInitialVersion(oldestVersion);
+	data.addShard(ShardInfo::newReadWrite(normalKeys, &data));
+	for (int64_t id = 0; id < records; ++id) {
+		engine->set(KeyValueRef(readPathIndexKey(id), ""_sr));
+		engine->set(KeyValueRef(readPathRecordKey(id), deterministicRandom()->randomAlphaNumeric(valueSize)));
+	}
+	for (int v = 1; v <= versions; ++v) {
+		data.mutableData().createNewVersion(oldestVersion + v * versionStep);
+		for (int u = 0; u < updatesPerVersion; ++u) {
+			KeyRef key(arena, readPathRecordKey(deterministicRandom()->randomInt(0, records)));
+			if (deterministicRandom()->random01() < 0.1) {
+				data.mutableData().insert(key, ValueOrClearToRef::clearTo(keyAfter(key, arena)));
+			} else {
+				ValueRef value(arena, deterministicRandom()->randomAlphaNumeric(valueSize));
+				data.mutableData().insert(key, ValueOrClearToRef::value(value));
+			}
+		}
+	}
+	data.version.set(data.mutableData().getLatestVersion());
+	data.desiredOldestVersion.set(oldestVersion);
+
+	fmt::print("records={} valueSize={} versions={} updatesPerVersion={} concurrency={} requests={} rangeSize={}\n",
+	           records,
+	           valueSize,
+	           versions,
+	           updatesPerVersion,
+	           concurrency,
+	           requests,
+	           rangeSize);
+
+	state std::vector<std::pair<ReadPathRequest, const char*>> types = {
+		{ ReadPathRequest::GetValue, "getValue" },
+		{ ReadPathRequest::GetKeyValues, "getKeyValues" },
+		{ ReadPathRequest::GetMappedKeyValues, "getMappedKeyValues" }
+	};
+	state int t = 0;
+	for (; t < types.size(); ++t) {
+		state double startTime = timer();
+		state double startCpu = getProcessorTimeThread();
+		state long long startAllocations = getThreadFastAllocations();
+		state std::vector<Future<Void>> clients;
+		for (int c = 0; c < concurrency; ++c) {
+			clients.push_back(
+			    readPathBenchmarkClient(&data, types[t].first, requests / concurrency, records, rangeSize));
+		}
+		wait(waitForAll(clients));
+		int issued = requests / concurrency * concurrency;
+		double elapsed = timer() - startTime;
+		fmt::print("{}: {:.0f} requests/s, {:.2f} CPU us/request, {:.1f} allocations/request\n",
+		           types[t].second,
+		           issued / elapsed,
+		           (getProcessorTimeThread() - startCpu) * 1e6 / issued,
+		           double(getThreadFastAllocations() - startAllocations) / issued);
+	}
+
+	data.actors.clear(true);
+	data.ssLock->halt();
+	engine->dispose();
+	return Void();
+}
@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 
+#include "fdbclient/Atomic.h"
 #include "fdbserver/TesterInterface.actor.h"
 #include "fdbclient/ReadYourWrites.h"
 #include "fdbclient/RunRYWTransaction.actor.h"
@@ -48,7 +49,7 @@ public:
 
 	Future<Void> start(Database const& cx) override {
 		if (opType == -1)
-			opType = sharedRandomNumber % 9;
+			opType = sharedRandomNumber % 10;
 
 		switch (opType) {
 		case 0:
@@ -78,6 +79,9 @@ public:
 		case 8:
 			CODE_PROBE(true, "Testing atomic CompareAndClear");
 			return testCompareAndClear(cx->clone(), this);
+		case 9:
+			CODE_PROBE(true, "Testing atomic AppendVersionstamped");
+			return testAppendVersionstamped(cx->clone(), this);
 		default:
 			ASSERT(false);
 		}
@@ -606,6 +610,88 @@ public:
 		return Void();
 	}
 
+	// Appends from several transactions must be read back in the order they were committed and made. A commit that is
+	// retried after commit_unknown_result may append twice, so values can repeat but never go backwards.
+	ACTOR Future<Void> testAppendVersionstamped(Database cx, AtomicOpsApiCorrectnessWorkload* self) {
+		state Key prefix = self->getTestKey("test_key_append_").withSuffix("/"_sr);
+		state int transactions = deterministicRandom()->randomInt(1, 5);
+		state int appendsPerTransaction = deterministicRandom()->randomInt(1, 20);
+		state int i = 0;
+
+		TraceEvent(SevInfo, "Running Atomic Op APPEND_VERSIONSTAMPED Correctness Current Api Version").log();
+		for (; i < transactions; i++) {
+			loop {
+				try {
+					wait(runRYWTransactionNoRetry(cx, [=](Reference<ReadYourWritesTransaction> tr) -> Future<Void> {
+						for (int j = 0; j < appendsPerTransaction; j++) {
+							tr->atomicOp(prefix,
+							             BinaryWriter::toValue(std::make_pair(i, j), Unversioned()),
+							             MutationRef::AppendVersionstamped);
+						}
+						return Void();
+					}));
+					break;
+				} catch (Error& e) {
+					TraceEvent(SevInfo, "AtomicOpApiThrow").detail("ErrCode", e.code());
+					wait(delay(1));
+				}
+			}
+		}
+
+		// The keys that appends might set are unreadable in the transaction making them
+		state Reference<ReadYourWritesTransaction> tr = makeReference<ReadYourWritesTransaction>(cx);
+		loop {
+			try {
+				tr->atomicOp(prefix, ""_sr, MutationRef::AppendVersionstamped);
+				wait(success(tr->getRange(prefixRange(prefix), CLIENT_KNOBS->TOO_MANY)));
+				TraceEvent(SevError, "AtomicOpAppendReadable").log();
+				self->testFailed = true;
+				break;
+			} catch (Error& e) {
+				if (e.code() == error_code_accessed_unreadable) {
+					break;
+				}
+				wait(tr->onError(e));
+			}
+		}
+
+		RangeResult appended =
+		    wait(runRYWTransaction(cx, [=](Reference<ReadYourWritesTransaction> tr) -> Future<RangeResult> {
+			    return tr->getRange(prefixRange(prefix), CLIENT_KNOBS->TOO_MANY);
+		    }));
+		std::pair<int, int> last(0, -1);
+		std::set<std::pair<int, int>> seen;
+		for (auto const& kv : appended) {
+			auto appendedValue = BinaryReader::fromStringRef<std::pair<int, int>>(kv.value, Unversioned());
+			uint16_t sequence = 0;
+			if (kv.key.size() == prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE) {
+				memcpy(&sequence, kv.key.end() - sizeof(sequence), sizeof(sequence));
+				sequence = bigEndian16(sequence);
+			}
+			// Only a transaction committed again may start over
+			bool ordered = last < appendedValue || (appendedValue.first == last.first && appendedValue.second == 0);
+			if (kv.key.size() != prefix.size() + APPEND_VERSIONSTAMP_SUFFIX_SIZE || sequence != appendedValue.second ||
+			    !ordered) {
+				TraceEvent(SevError, "AtomicOpAppendUnexpectedOrder")
+				    .detail("Key", kv.key)
+				    .detail("Transaction", appendedValue.first)
+				    .detail("Append", appendedValue.second)
+				    .detail("LastTransaction", last.first)
+				    .detail("LastAppend", last.second);
+				self->testFailed = true;
+			}
+			last = appendedValue;
+			seen.insert(appendedValue);
+		}
+		if (seen.size() != (size_t)(transactions * appendsPerTransaction)) {
+			TraceEvent(SevError, "AtomicOpAppendMissing")
+			    .detail("Expected", transactions * appendsPerTransaction)
+			    .detail("Found", seen.size());
+			self->testFailed = true;
+		}
+		return Void();
+	}
+
 	ACTOR Future<Void> testByteMin(Database cx, AtomicOpsApiCorrectnessWorkload* self) {
 		state Key key = self->getTestKey("test_key_byte_min_");
 
@@ -0,0 +1,197 @@
+/*
+ * CommitPipeline.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/CommitProxyInterface.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/StatusClient.h"
+#include "fdbrpc/DDSketch.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Drives the commit path with synthetic CommitTransactionRequests sent straight to the commit proxies, skipping the
+// client's transaction machinery and sharing one read version per refresh, so that a profile of the cluster shows the
+// proxies, master, resolvers and TLogs. Run against a single process cluster (memory storage engine) to profile the
+// whole pipeline on one machine. Reports the commit latency seen by the workload and, from status, the latency of
+// each stage of the commit proxies' pipeline over their last logging interval.
+struct CommitPipelineWorkload : TestWorkload {
+	static constexpr auto NAME = "CommitPipeline";
+
+	double testDuration;
+	int actorCount, mutationsPerTransaction, readConflictRangesPerTransaction, keyBytes, valueBytes, nodeCount;
+	double readVersionRefreshDelay;
+	Value value;
+
+	Version readVersion = invalidVersion;
+	std::vector<Future<Void>> clients;
+	PerfIntCounter transactions, conflicts, errors;
+	DDSketch<double> commitLatencies;
+	// Stage name and the mean and p99 latency, in seconds, of each commit proxy
+	std::vector<std::tuple<std::string, double, double>> stageLatencies;
+
+	CommitPipelineWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), transactions("Transactions"), conflicts("Conflicts"), errors("Errors") {
+		testDuration = getOption(options, "testDuration"_sr, 60.0);
+		actorCount = getOption(options, "actorCount"_sr, 200);
+		mutationsPerTransaction = getOption(options, "mutationsPerTransaction"_sr, 10);
+		readConflictRangesPerTransaction = getOption(options, "readConflictRangesPerTransaction"_sr, 1);
+		keyBytes = std::max(getOption(options, "keyBytes"_sr, 16), 16);
+		valueBytes = getOption(options, "valueBytes"_sr, 100);
+		nodeCount = getOption(options, "nodeCount"_sr, 1000000);
+		readVersionRefreshDelay = getOption(options, "readVersionRefreshDelay"_sr, 0.1);
+		value = Value(std::string(valueBytes, 'v'));
+	}
+
+	Future<Void> setup(Database const& cx) override { return Void(); }
+
+	Future<Void> start(Database const& cx) override { return _start(cx, this); }
+
+	Future<bool> check(Database const& cx) override { return errors.getValue() == 0; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.emplace_back("Transactions/sec", transactions.getValue() / testDuration, Averaged::False);
+		m.emplace_back(
+		    "Mutations/sec", transactions.getValue() * mutationsPerTransaction / testDuration, Averaged::False);
+		m.push_back(transactions.getMetric());
+		m.push_back(conflicts.getMetric());
+		m.push_back(errors.getMetric());
+		m.emplace_back("Mean Commit Latency (ms)", 1000 * commitLatencies.mean(), Averaged::True);
+		m.emplace_back("Median Commit Latency (ms, averaged)", 1000 * commitLatencies.median(), Averaged::True);
+		m.emplace_back("99% Commit Latency (ms, averaged)", 1000 * commitLatencies.percentile(0.99), Averaged::True);
+		for (auto const& [stage, mean, p99] : stageLatencies) {
+			m.emplace_back("Mean " + stage + " Latency (ms)", 1000 * mean, Averaged::True);
+			m.emplace_back("99% " + stage + " Latency (ms, averaged)", 1000 * p99, Averaged::True);
+		}
+	}
+
+	Key keyForIndex(int index) const {
+		std::string key = format("%016d", index);
+		return Key(key + std::string(keyBytes - key.size(), 'k'));
+	}
+
+	ACTOR static Future<Void> refreshReadVersion(Database cx, CommitPipelineWorkload* self) {
+		loop {
+			state Transaction tr(cx);
+			try {
+				Version v = wait(tr.getReadVersion());
+				self->readVersion = v;
+				wait(delay(self->readVersionRefreshDelay));
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+
+	ACTOR static Future<Void> commitClient(Database cx, CommitPipelineWorkload* self) {
+		loop {
+			state CommitTransactionRequest req;
+			req.transaction.read_snapshot = self->readVersion;
+			for (int i = 0; i < self->readConflictRangesPerTransaction; i++) {
+				Key key = self->keyForIndex(deterministicRandom()->randomInt(0, self->nodeCount));
+				req.transaction.read_conflict_ranges.push_back(req.arena, singleKeyRange(key, req.arena));
+			}
+			for (int i = 0; i < self->mutationsPerTransaction; i++) {
+				Key key = self->keyForIndex(deterministicRandom()->randomInt(0, self->nodeCount));
+				KeyRangeRef range = singleKeyRange(key, req.arena);
+				req.transaction.mutations.push_back(req.arena,
+				                                    MutationRef(MutationRef::SetValue, range.begin, self->value));
+				req.transaction.write_conflict_ranges.push_back(req.arena, range);
+			}
+			state double start = now();
+			try {
+				wait(success(basicLoadBalance(cx->getCommitProxies(UseProvisionalProxies::False),
+				                              &CommitProxyInterface::commit,
+				                              req,
+				                              TaskPriority::DefaultPromiseEndpoint,
+				                              AtMostOnce::False)));
+				self->commitLatencies.addSample(now() - start);
+				++self->transactions;
+			} catch (Error& e) {
+				if (e.code() == error_code_actor_cancelled) {
+					throw;
+				}
+				if (e.code() == error_code_not_committed) {
+					++self->conflicts;
+				} else if (e.code() != error_code_transaction_too_old &&
+				           e.code() != error_code_commit_proxy_memory_limit_exceeded) {
+					TraceEvent(SevWarn, "CommitPipelineError").error(e);
+					++self->errors;
+				}
+				wait(delay(0.001));
+			}
+		}
+	}
+
+	// Reads each commit proxy's stage latencies out of status
+	ACTOR static Future<Void> readStageLatencies(Database cx, CommitPipelineWorkload* self) {
+		StatusObject status = wait(StatusClient::statusFetcher(cx));
+		StatusObjectReader statusObj(status);
+		StatusObjectReader processes;
+		if (!statusObj.get("cluster.processes", processes)) {
+			return Void();
+		}
+		for (auto const& [processId, process] : processes.obj()) {
+			StatusObjectReader processObj(process.get_obj());
+			if (!processObj.has("roles")) {
+				continue;
+			}
+			for (StatusObjectReader role : processObj["roles"].get_array()) {
+				std::string roleName, id;
+				StatusObjectReader stages;
+				if (!role.get("role", roleName) || roleName != "commit_proxy" || !role.get("id", id) ||
+				    !role.get("commit_stage_latency_statistics", stages)) {
+					continue;
+				}
+				for (auto const& [stage, stats] : stages.obj()) {
+					StatusObjectReader statsObj(stats.get_obj());
+					double mean = 0, p99 = 0;
+					statsObj.get("mean", mean);
+					statsObj.get("p99", p99);
+					self->stageLatencies.emplace_back(id + " " + stage, mean, p99);
+				}
+			}
+		}
+		return Void();
+	}
+
+	ACTOR static Future<Void> _start(Database cx, CommitPipelineWorkload* self) {
+		state Future<Void> readVersionRefresher = refreshReadVersion(cx, self);
+		while (self->readVersion == invalidVersion) {
+			wait(delay(0.01));
+		}
+		for (int i = 0; i < self->actorCount; i++) {
+			self->clients.push_back(commitClient(cx, self));
+		}
+		wait(delay(self->testDuration));
+		self->clients.clear();
+		readVersionRefresher.cancel();
+
+		if (self->clientId == 0) {
+			try {
+				wait(readStageLatencies(cx, self));
+			} catch (Error& e) {
+				TraceEvent(SevWarn, "CommitPipelineStatusError").error(e);
+			}
+		}
+		return Void();
+	}
+};
+
+WorkloadFactory<CommitPipelineWorkload> CommitPipelineWorkloadFactory;
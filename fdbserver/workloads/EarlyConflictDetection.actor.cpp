@@ -0,0 +1,126 @@
+/*
+ * EarlyConflictDetection.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Holds transactions with early_conflict_detection open while another transaction writes to what one of them read and
+// not to what the other read. The first must fail with not_committed before it commits, and the second must not.
+struct EarlyConflictDetectionWorkload : TestWorkload {
+	static constexpr auto NAME = "EarlyConflictDetection";
+
+	double testDuration;
+	Key keyPrefix;
+
+	PerfIntCounter rounds, earlyConflicts, missedConflicts, falseConflicts;
+
+	EarlyConflictDetectionWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), rounds("Rounds"), earlyConflicts("EarlyConflicts"), missedConflicts("MissedConflicts"),
+	    falseConflicts("FalseConflicts") {
+		testDuration = getOption(options, "testDuration"_sr, 20.0);
+		keyPrefix =
+		    getOption(options, "keyPrefix"_sr, "EarlyConflictDetection"_sr).withSuffix(format("/%d/", clientId));
+	}
+
+	Future<Void> setup(Database const& cx) override { return Void(); }
+
+	Future<Void> start(Database const& cx) override {
+		return timeout(runRounds(cx->clone(), this), testDuration, Void());
+	}
+
+	// Every round that reaches commit must have noticed its conflict first, at least once the conflicts could be
+	// checked at all; failures of the check itself are allowed to miss some
+	Future<bool> check(Database const& cx) override {
+		return falseConflicts.getValue() == 0 && (rounds.getValue() < 5 || earlyConflicts.getValue() > 0);
+	}
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.push_back(rounds.getMetric());
+		m.push_back(earlyConflicts.getMetric());
+		m.push_back(missedConflicts.getMetric());
+		m.push_back(falseConflicts.getMetric());
+	}
+
+	// Returns true if the transaction has been failed early
+	static bool failedEarly(Reference<ReadYourWritesTransaction> tr) {
+		try {
+			tr->checkDeferredError();
+			return false;
+		} catch (Error& e) {
+			ASSERT(e.code() == error_code_not_committed);
+			return true;
+		}
+	}
+
+	ACTOR static Future<Void> runRounds(Database cx, EarlyConflictDetectionWorkload* self) {
+		state int round = 0;
+		loop {
+			state Key conflicting = self->keyPrefix.withSuffix(format("%d/conflicting", round));
+			state Key unrelated = self->keyPrefix.withSuffix(format("%d/unrelated", round));
+			state Reference<ReadYourWritesTransaction> doomed = makeReference<ReadYourWritesTransaction>(cx);
+			state Reference<ReadYourWritesTransaction> other = makeReference<ReadYourWritesTransaction>(cx);
+			state Reference<ReadYourWritesTransaction> writer = makeReference<ReadYourWritesTransaction>(cx);
+			++round;
+			try {
+				doomed->setOption(FDBTransactionOptions::EARLY_CONFLICT_DETECTION);
+				other->setOption(FDBTransactionOptions::EARLY_CONFLICT_DETECTION);
+				wait(success(doomed->get(conflicting)) && success(other->get(unrelated)));
+				state double start = now();
+
+				loop {
+					try {
+						writer->set(conflicting, "x"_sr);
+						wait(writer->commit());
+						break;
+					} catch (Error& e) {
+						wait(writer->onError(e));
+					}
+				}
+
+				// Stay well inside the MVCC window, past which every check fails
+				state double deadline = start + 3.0;
+				while (now() < deadline && !failedEarly(doomed)) {
+					wait(delay(std::min(0.1, CLIENT_KNOBS->EARLY_CONFLICT_CHECK_INTERVAL)));
+				}
+				// Before the MVCC window has passed, nothing but the write can fail a check
+				if (failedEarly(other) && now() - start < 4.0) {
+					TraceEvent(SevError, "EarlyConflictDetectionFalseConflict").detail("Key", unrelated);
+					++self->falseConflicts;
+				}
+				if (failedEarly(doomed)) {
+					++self->earlyConflicts;
+				} else {
+					++self->missedConflicts;
+				}
+				++self->rounds;
+			} catch (Error& e) {
+				if (e.code() == error_code_actor_cancelled) {
+					throw;
+				}
+				wait(doomed->onError(e));
+			}
+		}
+	}
+};
+
+WorkloadFactory<EarlyConflictDetectionWorkload> EarlyConflictDetectionWorkloadFactory;
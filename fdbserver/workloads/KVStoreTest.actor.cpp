@@ -21,9 +21,11 @@
 #include <ctime>
 #include <cinttypes>
 #include "fmt/format.h"
+#include "fdbclient/zipf.h"
 #include "fdbserver/workloads/workloads.actor.h"
 #include "fdbserver/IKeyValueStore.h"
 #include "flow/ActorCollection.h"
+#include "flow/Histogram.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 extern IKeyValueStore* makeDummyKeyValueStore();
@@ -100,6 +102,21 @@ private:
 	uint64_t N;
 };
 
+// Latencies of one kind of operation: summarized for the workload's metrics, and bucketed in a flow Histogram written
+// to the trace log when the test ends
+struct KVTestLatency {
+	TestHistogram<float> summary;
+	Reference<Histogram> histogram;
+
+	explicit KVTestLatency(StringRef op)
+	  : histogram(Histogram::getHistogram("KVStoreTest"_sr, op, Histogram::Unit::milliseconds)) {}
+
+	void addSample(double seconds) {
+		summary.addSample(seconds);
+		histogram->sampleSeconds(seconds);
+	}
+};
+
 struct KVTest {
 	IKeyValueStore* store;
 	Version startVersion;
@@ -109,6 +126,7 @@ struct KVTest {
 	Map<Key, IndexedSet<Version, NoMetric>> allSets;
 	int nodeCount, keyBytes;
 	bool dispose;
+	bool zipf = false; // Pick keys from a zipfian distribution, set up with zipfian_generator3()
 
 	explicit KVTest(int nodeCount, bool dispose, int keyBytes)
 	  : store(nullptr), startVersion(Version(time(nullptr)) << 30), lastSet(startVersion), lastCommit(startVersion),
@@ -143,7 +161,7 @@ struct KVTest {
 		s->value.insert(lastSet, NoMetric());
 	}
 
-	Key randomKey() { return makeKey(deterministicRandom()->randomInt(0, nodeCount)); }
+	Key randomKey() { return makeKey(zipf ? zipfian_next() : deterministicRandom()->randomInt(0, nodeCount)); }
 	Key makeKey(Version value) {
 		Key k;
 		((KeyRef&)k) = KeyRef(new (k.arena()) uint8_t[keyBytes], keyBytes);
@@ -153,7 +171,7 @@ struct KVTest {
 	}
 };
 
-ACTOR Future<Void> testKVRead(KVTest* test, Key key, TestHistogram<float>* latency, PerfIntCounter* count) {
+ACTOR Future<Void> testKVRead(KVTest* test, Key key, KVTestLatency* latency, PerfIntCounter* count) {
 	// state Version s1 = test->lastCommit;
 	state Version s2 = test->lastDurable;
 
@@ -172,7 +190,7 @@ ACTOR Future<Void> testKVRead(KVTest* test, Key key, TestHistogram<float>* laten
 	return Void();
 }
 
-ACTOR Future<Void> testKVReadSaturation(KVTest* test, TestHistogram<float>* latency, PerfIntCounter* count) {
+ACTOR Future<Void> testKVReadSaturation(KVTest* test, KVTestLatency* latency, PerfIntCounter* count) {
 	while (true) {
 		state double begin = timer();
 		Optional<Value> val = wait(test->store->readValue(test->randomKey()));
@@ -182,7 +200,24 @@ ACTOR Future<Void> testKVReadSaturation(KVTest* test, TestHistogram<float>* late
 	}
 }
 
-ACTOR Future<Void> testKVCommit(KVTest* test, TestHistogram<float>* latency, PerfIntCounter* count) {
+// Reads up to rows keys from a random key on, like a YCSB workload E scan
+ACTOR Future<Void> testKVScan(KVTest* test, int rows, KVTestLatency* latency, PerfIntCounter* count) {
+	state Key begin = test->randomKey();
+	state double start = timer();
+	RangeResult result = wait(test->store->readRange(KeyRangeRef(begin, "\xff\xff\xff\xff"_sr), rows));
+	latency->addSample(timer() - start);
+	++*count;
+	return Void();
+}
+
+ACTOR Future<Void> testKVScanSaturation(KVTest* test, int rows, KVTestLatency* latency, PerfIntCounter* count) {
+	loop {
+		wait(testKVScan(test, rows, latency, count));
+		wait(delay(0));
+	}
+}
+
+ACTOR Future<Void> testKVCommit(KVTest* test, KVTestLatency* latency, PerfIntCounter* count) {
 	state Version v = test->lastSet;
 	test->lastCommit = v;
 	state double begin = timer();
@@ -199,22 +234,34 @@ struct KVStoreTestWorkload : TestWorkload {
 	static constexpr auto NAME = "KVStoreTest";
 	bool enabled, saturation;
 	double testDuration, operationsPerSecond;
-	double commitFraction, setFraction;
-	int nodeCount, keyBytes, valueBytes;
+	double commitFraction, setFraction, scanFraction;
+	int nodeCount, keyBytes, valueBytes, scanRows, concurrency;
+	bool zipf;
+	double zipfConstant;
 	bool doSetup, doClear, doCount;
 	std::string filename;
-	PerfIntCounter reads, sets, commits;
-	TestHistogram<float> readLatency, commitLatency;
+	PerfIntCounter reads, sets, commits, scans;
+	KVTestLatency readLatency, commitLatency, scanLatency;
 	double setupTook;
+	int64_t storageBytesUsed;
 	std::string storeType;
 
 	KVStoreTestWorkload(WorkloadContext const& wcx)
-	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0) {
+	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), scans("Scans"),
+	    readLatency("ReadLatency"_sr), commitLatency("CommitLatency"_sr), scanLatency("ScanLatency"_sr), setupTook(0),
+	    storageBytesUsed(0) {
 		enabled = !clientId; // only do this on the "first" client
 		testDuration = getOption(options, "testDuration"_sr, 10.0);
 		operationsPerSecond = getOption(options, "operationsPerSecond"_sr, 100e3);
 		commitFraction = getOption(options, "commitFraction"_sr, .001);
 		setFraction = getOption(options, "setFraction"_sr, .1);
+		// Range reads of scanRows keys, taken out of the reads
+		scanFraction = getOption(options, "scanFraction"_sr, 0.0);
+		scanRows = getOption(options, "scanRows"_sr, 100);
+		// Concurrent readers in saturation mode
+		concurrency = getOption(options, "concurrency"_sr, 100);
+		zipf = getOption(options, "zipf"_sr, false);
+		zipfConstant = getOption(options, "zipfConstant"_sr, ZIPFIAN_CONSTANT);
 		nodeCount = getOption(options, "nodeCount"_sr, 100000);
 		keyBytes = getOption(options, "keyBytes"_sr, 8);
 		valueBytes = getOption(options, "valueBytes"_sr, 8);
@@ -246,8 +293,19 @@ struct KVStoreTestWorkload : TestWorkload {
 		m.push_back(reads.getMetric());
 		m.push_back(sets.getMetric());
 		m.push_back(commits.getMetric());
-		metricsFromHistogram(m, "Read Latency (ms)", readLatency);
-		metricsFromHistogram(m, "Commit Latency (ms)", commitLatency);
+		m.push_back(scans.getMetric());
+		metricsFromHistogram(m, "Read Latency (ms)", readLatency.summary);
+		metricsFromHistogram(m, "Commit Latency (ms)", commitLatency.summary);
+		if (scanFraction > 0) {
+			metricsFromHistogram(m, "Scan Latency (ms)", scanLatency.summary);
+		}
+		if (storageBytesUsed) {
+			// Space on disk for each byte of the keys and values loaded by setup
+			m.emplace_back("Storage Bytes Used", storageBytesUsed, Averaged::False);
+			m.emplace_back("Space Amplification",
+			               double(storageBytesUsed) / (double(nodeCount) * (keyBytes + valueBytes)),
+			               Averaged::False);
+		}
 	}
 };
 
@@ -320,9 +378,16 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 			}
 		} else {
 			std::vector<Future<Void>> actors;
-			actors.reserve(100);
-			for (int a = 0; a < 100; a++)
-				actors.push_back(testKVReadSaturation(&test, &workload->readLatency, &workload->reads));
+			actors.reserve(workload->concurrency);
+			int scanners = workload->concurrency * workload->scanFraction;
+			for (int a = 0; a < workload->concurrency; a++) {
+				if (a < scanners) {
+					actors.push_back(
+					    testKVScanSaturation(&test, workload->scanRows, &workload->scanLatency, &workload->scans));
+				} else {
+					actors.push_back(testKVReadSaturation(&test, &workload->readLatency, &workload->reads));
+				}
+			}
 			wait(timeout(waitForAll(actors), workload->testDuration, Void()));
 		}
 	} else {
@@ -345,6 +410,9 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 					wr.serializeBytes(extraValue, extraBytes);
 					test.set(KeyValueRef(test.randomKey(), wr.toValue()));
 					++workload->sets;
+				} else if (deterministicRandom()->random01() < workload->scanFraction) {
+					// Scan
+					ac.add(testKVScan(&test, workload->scanRows, &workload->scanLatency, &workload->scans));
 				} else {
 					// Read
 					ac.add(testKVRead(&test, test.randomKey(), &workload->readLatency, &workload->reads));
@@ -356,6 +424,13 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 		}
 	}
 
+	workload->readLatency.histogram->writeToLog(workload->testDuration);
+	workload->commitLatency.histogram->writeToLog(workload->testDuration);
+	workload->scanLatency.histogram->writeToLog(workload->testDuration);
+	if (workload->doSetup) {
+		workload->storageBytesUsed = test.store->getStorageBytes().used;
+	}
+
 	if (workload->doClear) {
 		state int chunk = 1000000;
 		t = timer();
@@ -372,6 +447,10 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 ACTOR Future<Void> testKVStore(KVStoreTestWorkload* workload) {
 	state KVTest test(workload->nodeCount, !workload->filename.size(), workload->keyBytes);
 	state Error err;
+	if (workload->zipf) {
+		zipfian_generator3(0, workload->nodeCount - 1, workload->zipfConstant);
+		test.zipf = true;
+	}
 
 	// wait( delay(1) );
 	TraceEvent("GO").log();
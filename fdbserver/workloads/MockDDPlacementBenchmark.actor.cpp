@@ -0,0 +1,424 @@
+/*
+ * MockDDPlacementBenchmark.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+
+#include "fdbrpc/Replication.h"
+#include "fdbserver/DDTeamCollection.h"
+#include "fdbserver/workloads/MockDDTest.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Replays a shard map with its traffic through the team collection's placement decisions, the way the relocation
+// queue's background rebalancers would make them, and reports how long the cluster takes to become balanced, how many
+// bytes were moved to get there and how long some storage server stayed a read hotspot.
+//
+// Nothing is written to a database: shards only live in the MockGlobalState, and each move takes the time it would
+// need at moveBytesPerSecond, so a replay of a large cluster finishes in a few seconds of wall clock time.
+//
+// shardFile holds one shard per line, in key order, as exported from the shard metrics of a real cluster:
+//   <bytes> <bytesWrittenPerKSecond> <bytesReadPerKSecond> [<server index>,<server index>,...]
+// Server indexes are in [1, serverCount]; shards without them are placed on a random team. Without a file a synthetic
+// map of shardCount shards is used, with a fraction skewedPlacement of them on a single team and a fraction
+// hotShardFraction of them read hot.
+struct MockDDPlacementBenchmarkWorkload : public MockDDTestWorkload {
+	static constexpr auto NAME = "MockDDPlacementBenchmark";
+
+	struct ReplayShard {
+		KeyRange range;
+		StorageMetrics metrics;
+		std::vector<UID> team; // sorted
+	};
+
+	struct Move {
+		int shard;
+		std::vector<UID> dest; // sorted
+	};
+
+	// --- test configs ---
+	std::string shardFile;
+	int serverCount = 12;
+	int teamSize = 3;
+	int shardCount = 1000;
+	double skewedPlacement = 0.5;
+	double hotShardFraction = 0.01;
+	int64_t shardReadBytesPerKSecond = 100 * 1000;
+	int64_t hotShardReadBytesPerKSecond = 20e6 * 1000;
+	int64_t moveBytesPerSecond = 50e6;
+	double pollingInterval = SERVER_KNOBS->BG_REBALANCE_POLLING_INTERVAL;
+	// Balanced when the fullest server holds at most this many times the mean bytes and no server serves more than
+	// hotspotRatio times the mean read bandwidth
+	double imbalanceRatio = 1.1;
+	double hotspotRatio = 2.0;
+
+	UID distributorId;
+	MoveKeysLock lock;
+	PromiseStream<RelocateShard> output;
+	std::unique_ptr<DDTeamCollection> collection;
+	std::vector<ReplayShard> shards;
+
+	// --- results ---
+	double convergenceTime = -1;
+	double hotspotDuration = 0;
+	int64_t bytesMoved = 0;
+	int diskMoves = 0, readMoves = 0;
+	double finalImbalance = 0;
+
+	MockDDPlacementBenchmarkWorkload(WorkloadContext const& wcx)
+	  : MockDDTestWorkload(wcx), distributorId(deterministicRandom()->randomUniqueID()) {
+		// Bounds the simulated time a replay may take to converge
+		testDuration = getOption(options, "testDuration"_sr, 3600.0);
+		shardFile = getOption(options, "shardFile"_sr, ""_sr).toString();
+		serverCount = getOption(options, "serverCount"_sr, serverCount);
+		teamSize = getOption(options, "teamSize"_sr, teamSize);
+		shardCount = getOption(options, "shardCount"_sr, shardCount);
+		skewedPlacement = getOption(options, "skewedPlacement"_sr, skewedPlacement);
+		hotShardFraction = getOption(options, "hotShardFraction"_sr, hotShardFraction);
+		shardReadBytesPerKSecond = getOption(options, "shardReadBytesPerKSecond"_sr, shardReadBytesPerKSecond);
+		hotShardReadBytesPerKSecond = getOption(options, "hotShardReadBytesPerKSecond"_sr, hotShardReadBytesPerKSecond);
+		moveBytesPerSecond = getOption(options, "moveBytesPerSecond"_sr, moveBytesPerSecond);
+		pollingInterval = getOption(options, "pollingInterval"_sr, pollingInterval);
+		imbalanceRatio = getOption(options, "imbalanceRatio"_sr, imbalanceRatio);
+		hotspotRatio = getOption(options, "hotspotRatio"_sr, hotspotRatio);
+		ASSERT(serverCount >= teamSize && moveBytesPerSecond > 0);
+	}
+
+	Key shardBoundary(int i, int count) const {
+		if (i == 0) {
+			return allKeys.begin;
+		}
+		return i == count ? allKeys.end : doubleToTestKey((double)i / count);
+	}
+
+	void loadShardFile() {
+		std::istringstream lines(readFileBytes(shardFile, 1 << 30));
+		std::vector<std::string> rows;
+		for (std::string line; std::getline(lines, line);) {
+			if (!line.empty() && line[0] != '#') {
+				rows.push_back(line);
+			}
+		}
+		for (int i = 0; i < rows.size(); ++i) {
+			std::istringstream row(rows[i]);
+			ReplayShard shard;
+			shard.range = KeyRangeRef(shardBoundary(i, rows.size()), shardBoundary(i + 1, rows.size()));
+			std::string servers;
+			row >> shard.metrics.bytes >> shard.metrics.bytesWrittenPerKSecond >> shard.metrics.bytesReadPerKSecond >>
+			    servers;
+			std::istringstream ids(servers);
+			for (std::string id; std::getline(ids, id, ',');) {
+				int index = std::stoi(id);
+				ASSERT(index >= 1 && index <= serverCount);
+				shard.team.push_back(MockGlobalState::indexToUID(index));
+			}
+			std::sort(shard.team.begin(), shard.team.end());
+			shards.push_back(shard);
+		}
+	}
+
+	void generateShards() {
+		for (int i = 0; i < shardCount; ++i) {
+			ReplayShard shard;
+			shard.range = KeyRangeRef(shardBoundary(i, shardCount), shardBoundary(i + 1, shardCount));
+			shard.metrics.bytes =
+			    deterministicRandom()->randomInt64(SERVER_KNOBS->MIN_SHARD_BYTES, SERVER_KNOBS->MAX_SHARD_BYTES);
+			shard.metrics.bytesReadPerKSecond = deterministicRandom()->random01() < hotShardFraction
+			                                        ? hotShardReadBytesPerKSecond
+			                                        : shardReadBytesPerKSecond;
+			shards.push_back(shard);
+		}
+	}
+
+	void buildTeamCollection() {
+		collection.reset(new DDTeamCollection(DDTeamCollectionInitParams{ mock,
+		                                                                  distributorId,
+		                                                                  lock,
+		                                                                  output,
+		                                                                  mgs->shardMapping,
+		                                                                  mgs->configuration,
+		                                                                  {},
+		                                                                  {},
+		                                                                  Future<Void>(Void()),
+		                                                                  makeReference<AsyncVar<bool>>(true),
+		                                                                  IsPrimary::True,
+		                                                                  makeReference<AsyncVar<bool>>(false),
+		                                                                  makeReference<AsyncVar<bool>>(false),
+		                                                                  PromiseStream<GetMetricsRequest>(),
+		                                                                  Promise<UID>(),
+		                                                                  PromiseStream<Promise<int>>(),
+		                                                                  PromiseStream<Promise<int64_t>>() }));
+		// Every server is a machine and fault zone of its own
+		for (auto& [id, server] : mgs->allServers) {
+			StorageServerInterface interface;
+			interface.uniqueID = id;
+			Standalone<StringRef> name(std::to_string(id.first()));
+			interface.locality.set("processid"_sr, name);
+			interface.locality.set("machineid"_sr, name);
+			interface.locality.set("zoneid"_sr, name);
+			interface.locality.set("data_hall"_sr, name);
+			collection->server_info[id] = makeReference<TCServerInfo>(
+			    interface, collection.get(), ProcessClass(), true, collection->storageServerSet);
+			collection->server_status.set(id, ServerStatus(false, false, false, interface.locality));
+		}
+		collection->constructMachinesFromServers();
+		int desiredTeams = SERVER_KNOBS->DESIRED_TEAMS_PER_SERVER * serverCount;
+		int maxTeams = SERVER_KNOBS->MAX_TEAMS_PER_SERVER * serverCount;
+		collection->addBestMachineTeams(desiredTeams);
+		collection->addTeamsBestOf(desiredTeams, desiredTeams, maxTeams);
+		collection->disableBuildingTeams();
+		collection->setCheckTeamDelay();
+	}
+
+	void placeShard(ReplayShard& shard, std::vector<UID> const& team) {
+		for (auto const& id : shard.team) {
+			mgs->allServers.at(id).serverKeys.insert(shard.range, { MockShardStatus::EMPTY, 0 });
+		}
+		for (auto const& id : team) {
+			mgs->allServers.at(id).serverKeys.insert(shard.range, { MockShardStatus::COMPLETED, shard.metrics.bytes });
+		}
+		mgs->shardMapping->assignRangeToTeams(shard.range, { ShardsAffectedByTeamFailure::Team(team, true) });
+		shard.team = team;
+	}
+
+	void placeInitialShards() {
+		ASSERT(!collection->teams.empty());
+		std::vector<UID> skewedTeam = collection->teams[0]->getServerIDs();
+		std::sort(skewedTeam.begin(), skewedTeam.end());
+		for (auto& shard : shards) {
+			std::vector<UID> team;
+			team.swap(shard.team);
+			if (!team.empty()) {
+				if (!collection->findTeamFromServers(team, false).present()) {
+					collection->addTeam(std::set<UID>(team.begin(), team.end()), IsInitialTeam::True);
+				}
+			} else if (deterministicRandom()->random01() < skewedPlacement) {
+				team = skewedTeam;
+			} else {
+				team = deterministicRandom()->randomChoice(collection->teams)->getServerIDs();
+				std::sort(team.begin(), team.end());
+			}
+			placeShard(shard, team);
+		}
+	}
+
+	Future<Void> setup(Database const& cx) override {
+		if (!enabled)
+			return Void();
+		MockDDTestWorkload::setup(cx);
+
+		mgs->configuration.storageTeamSize = teamSize;
+		mgs->configuration.storagePolicy = makeReference<PolicyAcross>(teamSize, "zoneid", makeReference<PolicyOne>());
+		for (int i = 1; i <= serverCount; ++i) {
+			UID id = MockGlobalState::indexToUID(i);
+			if (!mgs->allServers.count(id)) {
+				mgs->addStorageServer(StorageServerInterface(id));
+			}
+			mgs->allServers.at(id).serverKeys.insert(allKeys, { MockShardStatus::EMPTY, 0 });
+		}
+
+		if (shardFile.empty()) {
+			generateShards();
+		} else {
+			loadShardFile();
+		}
+		buildTeamCollection();
+		placeInitialShards();
+		TraceEvent("MockDDPlacementBenchmarkSetup")
+		    .detail("Servers", serverCount)
+		    .detail("Teams", collection->teams.size())
+		    .detail("Shards", shards.size())
+		    .detail("ShardFile", shardFile);
+		return Void();
+	}
+
+	// Refreshes the metrics the team collection sees from the shards each server holds
+	void updateServerMetrics(double* imbalance, bool* hotspot) {
+		std::map<UID, StorageMetrics> load;
+		for (auto const& shard : shards) {
+			for (auto const& id : shard.team) {
+				load[id] += shard.metrics;
+			}
+		}
+		int64_t maxBytes = 0, totalBytes = 0, maxRead = 0, totalRead = 0;
+		for (auto& [id, server] : collection->server_info) {
+			GetStorageMetricsReply reply;
+			reply.load = load[id];
+			reply.capacity.bytes = mgs->allServers.at(id).totalDiskSpace;
+			reply.available.bytes = std::max<int64_t>(0, reply.capacity.bytes - reply.load.bytes);
+			server->setMetrics(reply);
+			maxBytes = std::max(maxBytes, reply.load.bytes);
+			totalBytes += reply.load.bytes;
+			maxRead = std::max(maxRead, reply.load.bytesReadPerKSecond);
+			totalRead += reply.load.bytesReadPerKSecond;
+		}
+		int servers = collection->server_info.size();
+		*imbalance = totalBytes > 0 ? (double)maxBytes * servers / totalBytes : 1.0;
+		*hotspot = totalRead > 0 && maxRead > hotspotRatio * totalRead / servers;
+	}
+
+	int shardIndex(KeyRangeRef range) const {
+		auto it = std::lower_bound(shards.begin(), shards.end(), range.begin, [](ReplayShard const& s, KeyRef k) {
+			return s.range.begin < k;
+		});
+		ASSERT(it != shards.end() && it->range == range);
+		return it - shards.begin();
+	}
+
+	// Picks the shard rebalanceTeams() or rebalanceReadLoad() would move from sourceTeam to destTeam, or -1
+	int pickShard(Reference<IDataDistributionTeam> sourceTeam,
+	              Reference<IDataDistributionTeam> destTeam,
+	              bool readRebalance) const {
+		std::vector<KeyRange> ranges =
+		    mgs->shardMapping->getShardsFor(ShardsAffectedByTeamFailure::Team(sourceTeam->getServerIDs(), true));
+		if (ranges.empty() || (readRebalance && ranges.size() <= 1)) {
+			return -1;
+		}
+		if (readRebalance) {
+			double srcLoad = sourceTeam->getLoadReadBandwidth(false), destLoad = destTeam->getLoadReadBandwidth();
+			if ((1.0 - SERVER_KNOBS->READ_REBALANCE_DIFF_FRAC) * srcLoad <= destLoad) {
+				return -1;
+			}
+			// The hottest shard that does not just move the hotspot to the destination
+			double maxShardLoad = (srcLoad - destLoad) * SERVER_KNOBS->READ_REBALANCE_MAX_SHARD_FRAC;
+			int best = -1;
+			for (auto const& range : ranges) {
+				int i = shardIndex(range);
+				int64_t read = shards[i].metrics.bytesReadPerKSecond;
+				if (read <= maxShardLoad && (best < 0 || read > shards[best].metrics.bytesReadPerKSecond)) {
+					best = i;
+				}
+			}
+			return best;
+		}
+
+		int best = -1;
+		for (int retries = 0; retries < SERVER_KNOBS->REBALANCE_MAX_RETRIES; ++retries) {
+			int i = shardIndex(deterministicRandom()->randomChoice(ranges));
+			if (best < 0 || shards[i].metrics.bytes > shards[best].metrics.bytes) {
+				best = i;
+			}
+		}
+		int64_t sourceBytes = sourceTeam->getLoadBytes(false), destBytes = destTeam->getLoadBytes();
+		bool sourceAndDestTooSimilar =
+		    sourceBytes - destBytes <= 3 * std::max<int64_t>(SERVER_KNOBS->MIN_SHARD_BYTES, shards[best].metrics.bytes);
+		return sourceAndDestTooSimilar ? -1 : best;
+	}
+
+	// One round of the background mountain chopper: the most loaded team gives a shard to a random team
+	ACTOR static Future<Optional<Move>> rebalanceOnce(MockDDPlacementBenchmarkWorkload* self, bool readRebalance) {
+		state GetTeamRequest srcReq(WantNewServers::True,
+		                            WantTrueBest::True,
+		                            PreferLowerDiskUtil::False,
+		                            TeamMustHaveShards::True,
+		                            ForReadBalance(readRebalance),
+		                            PreferLowerReadUtil::False);
+		state GetTeamRequest destReq(WantNewServers::True,
+		                             WantTrueBest::False,
+		                             PreferLowerDiskUtil::True,
+		                             TeamMustHaveShards::False,
+		                             ForReadBalance(readRebalance),
+		                             PreferLowerReadUtil::True);
+		wait(self->collection->getTeam(srcReq) && self->collection->getTeam(destReq));
+		Optional<Reference<IDataDistributionTeam>> sourceTeam = srcReq.reply.getFuture().get().first;
+		Optional<Reference<IDataDistributionTeam>> destTeam = destReq.reply.getFuture().get().first;
+		if (!sourceTeam.present() || !destTeam.present() ||
+		    sourceTeam.get()->getServerIDs() == destTeam.get()->getServerIDs()) {
+			return Optional<Move>();
+		}
+		int shard = self->pickShard(sourceTeam.get(), destTeam.get(), readRebalance);
+		if (shard < 0) {
+			return Optional<Move>();
+		}
+		Move move{ shard, destTeam.get()->getServerIDs() };
+		std::sort(move.dest.begin(), move.dest.end());
+		return move;
+	}
+
+	ACTOR static Future<Void> replay(MockDDPlacementBenchmarkWorkload* self) {
+		state double start = now();
+		state double lastCheck = start;
+		state bool hotspot = false;
+		state double imbalance = 0;
+		loop {
+			if (hotspot) {
+				self->hotspotDuration += now() - lastCheck;
+			}
+			lastCheck = now();
+			self->updateServerMetrics(&imbalance, &hotspot);
+			self->finalImbalance = imbalance;
+			if (imbalance <= self->imbalanceRatio && !hotspot) {
+				self->convergenceTime = now() - start;
+				return Void();
+			}
+			if (now() - start >= self->testDuration) {
+				return Void();
+			}
+
+			state bool readMove = hotspot;
+			state Optional<Move> move = wait(rebalanceOnce(self, readMove));
+			if (!move.present() && readMove) {
+				// The hotspot cannot be spread out any further, so keep rebalancing the disk space
+				readMove = false;
+				wait(store(move, rebalanceOnce(self, readMove)));
+			}
+			if (!move.present()) {
+				wait(delay(self->pollingInterval));
+				continue;
+			}
+
+			// The source keeps serving the shard until the destination has a copy of it
+			state int64_t bytes = self->shards[move.get().shard].metrics.bytes;
+			wait(delay((double)bytes / self->moveBytesPerSecond));
+			self->placeShard(self->shards[move.get().shard], move.get().dest);
+			self->bytesMoved += bytes;
+			++(readMove ? self->readMoves : self->diskMoves);
+		}
+	}
+
+	Future<Void> start(Database const& cx) override {
+		if (!enabled)
+			return Void();
+		return replay(this);
+	}
+
+	Future<bool> check(Database const& cx) override {
+		if (enabled) {
+			TraceEvent("MockDDPlacementBenchmarkResult")
+			    .detail("ConvergenceTime", convergenceTime)
+			    .detail("BytesMoved", bytesMoved)
+			    .detail("HotspotDuration", hotspotDuration)
+			    .detail("DiskMoves", diskMoves)
+			    .detail("ReadMoves", readMoves)
+			    .detail("FinalImbalance", finalImbalance);
+			collection.reset();
+		}
+		return true;
+	}
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.emplace_back("Convergence Time", convergenceTime, Averaged::False);
+		m.emplace_back("Bytes Moved", bytesMoved, Averaged::False);
+		m.emplace_back("Hotspot Duration", hotspotDuration, Averaged::False);
+		m.emplace_back("Disk Rebalance Moves", diskMoves, Averaged::False);
+		m.emplace_back("Read Rebalance Moves", readMoves, Averaged::False);
+		m.emplace_back("Final Imbalance", finalImbalance, Averaged::False);
+	}
+};
+
+WorkloadFactory<MockDDPlacementBenchmarkWorkload> MockDDPlacementBenchmarkWorkloadFactory;
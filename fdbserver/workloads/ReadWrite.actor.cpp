@@ -447,6 +447,8 @@ struct ReadWriteWorkload : ReadWriteCommon {
 			m.emplace_back("Median Latency (ms, averaged)", 1000 * latencies.median(), Averaged::True);
 			m.emplace_back("90% Latency (ms, averaged)", 1000 * latencies.percentile(0.90), Averaged::True);
 			m.emplace_back("98% Latency (ms, averaged)", 1000 * latencies.percentile(0.98), Averaged::True);
+			m.emplace_back("99% Latency (ms, averaged)", 1000 * latencies.percentile(0.99), Averaged::True);
+			m.emplace_back("99.9% Latency (ms, averaged)", 1000 * latencies.percentile(0.999), Averaged::True);
 			m.emplace_back("Max Latency (ms, averaged)", 1000 * latencies.max(), Averaged::True);
 
 			m.emplace_back("Mean Row Read Latency (ms)", 1000 * readLatencies.mean(), Averaged::True);
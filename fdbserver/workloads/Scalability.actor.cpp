@@ -0,0 +1,213 @@
+/*
+ * Scalability.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/ManagementAPI.actor.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbserver/ServerDBInfo.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Measures how throughput and latency change with the size of the transaction subsystem. For each of the given
+// configurations in turn, the workload reconfigures the database, waits for the recovery that follows, and runs the
+// probe workload on every tester at each of the given rates, stopping at the first rate the cluster cannot reach. The
+// saturation throughput of each configuration relative to the first shows which roles stop scaling.
+//
+// Like Performance, all options not consumed here are passed on to the probe workload.
+struct ScalabilityWorkload : TestWorkload {
+	static constexpr auto NAME = "Scalability";
+
+	Value probeWorkload;
+	// Configuration changes, e.g. "commit_proxies=2 resolvers=1 logs=4", each of which is applied in turn
+	std::vector<std::string> configurations;
+	std::vector<int> rates;
+	double recoveryTimeout, settleTime;
+	Standalone<VectorRef<KeyValueRef>> savedOptions;
+
+	std::vector<PerfMetric> metrics;
+	std::vector<TesterInterface> testers;
+
+	ScalabilityWorkload(WorkloadContext const& wcx) : TestWorkload(wcx) {
+		probeWorkload = getOption(options, "probeWorkload"_sr, "ReadWrite"_sr);
+		configurations = getOption(options, "configurations"_sr, std::vector<std::string>{ "" });
+		rates = getOption(options, "transactionsPerSecond"_sr, std::vector<int>{ 1000, 2000, 5000, 10000, 20000 });
+		recoveryTimeout = getOption(options, "recoveryTimeout"_sr, 300.0);
+		settleTime = getOption(options, "settleTime"_sr, 10.0);
+
+		// "Consume" all remaining options and save them for the probe workload
+		for (int i = 0; i < options.size(); i++) {
+			if (options[i].value.size()) {
+				savedOptions.push_back_deep(savedOptions.arena(), KeyValueRef(options[i].key, options[i].value));
+				options[i].value = ""_sr;
+			}
+		}
+	}
+
+	void disableFailureInjectionWorkloads(std::set<std::string>& out) const override { out.insert("all"); }
+
+	Future<Void> start(Database const& cx) override {
+		if (!clientId)
+			return _start(cx, this);
+		return Void();
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override { m.insert(m.end(), metrics.begin(), metrics.end()); }
+
+	Standalone<VectorRef<VectorRef<KeyValueRef>>> getOpts(int transactionsPerSecond) {
+		Standalone<VectorRef<KeyValueRef>> options;
+		Standalone<VectorRef<VectorRef<KeyValueRef>>> opts;
+		options.push_back_deep(options.arena(), KeyValueRef("testName"_sr, probeWorkload));
+		options.push_back_deep(options.arena(),
+		                       KeyValueRef("transactionsPerSecond"_sr, format("%d", transactionsPerSecond)));
+		for (int i = 0; i < savedOptions.size(); i++) {
+			options.push_back_deep(options.arena(), savedOptions[i]);
+		}
+		opts.push_back_deep(opts.arena(), options);
+		return opts;
+	}
+
+	static double getNamedMetric(std::string const& name, std::vector<PerfMetric> const& metrics) {
+		for (auto const& m : metrics) {
+			if (m.name() == name) {
+				return m.value();
+			}
+		}
+		return 0;
+	}
+
+	ACTOR static Future<std::vector<TesterInterface>> getTesters(ScalabilityWorkload* self) {
+		loop {
+			state GetWorkersRequest req(GetWorkersRequest::TESTER_CLASS_ONLY |
+			                            GetWorkersRequest::NON_EXCLUDED_PROCESSES_ONLY);
+			choose {
+				when(std::vector<WorkerDetails> workers =
+				         wait(brokenPromiseToNever(self->dbInfo->get().clusterInterface.getWorkers.getReply(req)))) {
+					std::vector<TesterInterface> ts;
+					for (auto const& w : workers) {
+						ts.push_back(w.interf.testerInterface);
+					}
+					return ts;
+				}
+				when(wait(self->dbInfo->onChange())) {}
+			}
+		}
+	}
+
+	// Waits for a recovery after recoveryCount to complete
+	ACTOR static Future<bool> waitForRecovery(ScalabilityWorkload* self, DBRecoveryCount recoveryCount) {
+		while (self->dbInfo->get().recoveryCount <= recoveryCount ||
+		       self->dbInfo->get().recoveryState < RecoveryState::FULLY_RECOVERED) {
+			wait(self->dbInfo->onChange());
+		}
+		return true;
+	}
+
+	ACTOR static Future<Void> configure(Database cx, ScalabilityWorkload* self, std::string configuration) {
+		if (configuration.empty()) {
+			return Void();
+		}
+		state DBRecoveryCount recoveryCount = self->dbInfo->get().recoveryCount;
+		ConfigurationResult result = wait(ManagementAPI::changeConfig(cx.getReference(), configuration, true));
+		TraceEvent("ScalabilityConfigure")
+		    .detail("Configuration", configuration)
+		    .detail("Result", static_cast<int>(result));
+		if (result != ConfigurationResult::SUCCESS) {
+			throw operation_failed();
+		}
+		// A configuration that changes nothing is not followed by a recovery
+		bool recovered = wait(timeout(waitForRecovery(self, recoveryCount), self->recoveryTimeout, false));
+		if (!recovered) {
+			TraceEvent(SevWarnAlways, "ScalabilityNoRecovery").detail("Configuration", configuration);
+		}
+		return Void();
+	}
+
+	// Runs the probe workload at increasing rates until the cluster falls behind, returning the highest throughput
+	// reached
+	ACTOR static Future<double> measure(Database cx, ScalabilityWorkload* self, int step) {
+		state double maxTPS = 0;
+		state int r = 0;
+		for (; r < self->rates.size(); r++) {
+			state int rate = self->rates[r];
+			TestSpec spec("ScalabilityRun"_sr, false, false);
+			spec.phases = TestWorkload::EXECUTION | TestWorkload::METRICS;
+			spec.options = self->getOpts(rate);
+			DistributedTestResults results = wait(runWorkload(cx, self->testers, spec, Optional<TenantName>()));
+
+			double tps = getNamedMetric("Transactions/sec", results.metrics);
+			double median = getNamedMetric("Median Latency (ms, averaged)", results.metrics);
+			double p98 = getNamedMetric("98% Latency (ms, averaged)", results.metrics);
+			maxTPS = std::max(maxTPS, tps);
+
+			std::string name = format("Step %d at %d/sec ", step, rate);
+			self->metrics.emplace_back(name + "Transactions/sec", tps, Averaged::False);
+			self->metrics.emplace_back(name + "Median Latency (ms)", median, Averaged::False);
+			self->metrics.emplace_back(name + "98% Latency (ms)", p98, Averaged::False);
+			TraceEvent("ScalabilityStep")
+			    .detail("Step", step)
+			    .detail("Configuration", self->configurations[step])
+			    .detail("RateTarget", rate)
+			    .detail("AchievedRate", tps)
+			    .detail("MedianLatency", median)
+			    .detail("Latency98", p98);
+
+			// The same saturation test as Performance
+			if (tps < (rate * .95) - 100) {
+				break;
+			}
+		}
+		return maxTPS;
+	}
+
+	ACTOR static Future<Void> _start(Database cx, ScalabilityWorkload* self) {
+		std::vector<TesterInterface> testers = wait(getTesters(self));
+		self->testers = testers;
+
+		state TestSpec setup("ScalabilitySetup"_sr, false, false);
+		setup.options = self->getOpts(self->rates.front());
+		setup.phases = TestWorkload::SETUP;
+		wait(success(runWorkload(cx, self->testers, setup, Optional<TenantName>())));
+
+		state double baseline = 0;
+		state int step = 0;
+		for (; step < self->configurations.size(); step++) {
+			wait(configure(cx, self, self->configurations[step]));
+			wait(delay(self->settleTime));
+			double saturation = wait(measure(cx, self, step));
+			if (step == 0) {
+				baseline = saturation;
+			}
+			double scaling = baseline > 0 ? saturation / baseline : 0;
+			self->metrics.emplace_back(
+			    format("Step %d Saturation Transactions/sec", step), saturation, Averaged::False);
+			self->metrics.emplace_back(format("Step %d Relative Throughput", step), scaling, Averaged::False);
+			TraceEvent("ScalabilitySaturation")
+			    .detail("Step", step)
+			    .detail("Configuration", self->configurations[step])
+			    .detail("SaturationRate", saturation)
+			    .detail("RelativeThroughput", scaling);
+		}
+		return Void();
+	}
+};
+
+WorkloadFactory<ScalabilityWorkload> ScalabilityWorkloadFactory;
@@ -225,6 +225,8 @@ struct MeasureSinglePeriod : IMeasurer {
 		m.emplace_back("Median Latency (ms, averaged)", 1000 * totalLatency.median(), Averaged::True);
 		m.emplace_back("90% Latency (ms, averaged)", 1000 * totalLatency.percentile(0.90), Averaged::True);
 		m.emplace_back("98% Latency (ms, averaged)", 1000 * totalLatency.percentile(0.98), Averaged::True);
+		m.emplace_back("99% Latency (ms, averaged)", 1000 * totalLatency.percentile(0.99), Averaged::True);
+		m.emplace_back("99.9% Latency (ms, averaged)", 1000 * totalLatency.percentile(0.999), Averaged::True);
 
 		m.emplace_back("Mean Row Read Latency (ms)", 1000 * rowReadLatency.mean(), Averaged::True);
 		m.emplace_back("Median Row Read Latency (ms, averaged)", 1000 * rowReadLatency.median(), Averaged::True);
@@ -0,0 +1,123 @@
+/*
+ * WriteBatcher.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/WriteBatcher.h"
+#include "fdbserver/TesterInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Submits many small writes through a WriteBatcher, each setting its own key and adding one to a counter, and checks
+// that exactly the writes reported as committed are in the database. One write in every invalidWriteInterval has a
+// key that is too large, and must fail without taking the rest of its batch with it.
+struct WriteBatcherWorkload : TestWorkload {
+	static constexpr auto NAME = "WriteBatcher";
+	int writes;
+	double writesPerSecond;
+	int invalidWriteInterval;
+
+	int committed = 0;
+	int unknown = 0;
+
+	WriteBatcherWorkload(WorkloadContext const& wcx) : TestWorkload(wcx) {
+		writes = getOption(options, "writes"_sr, 1000);
+		writesPerSecond = getOption(options, "writesPerSecond"_sr, 1000.0);
+		invalidWriteInterval = getOption(options, "invalidWriteInterval"_sr, 100);
+	}
+
+	Key prefix() const { return StringRef(format("writeBatcher/%d/", clientId)); }
+	Key counterKey() const { return prefix().withSuffix("count"_sr); }
+	Key writeKey(int i) const { return prefix().withSuffix(format("%08d", i)); }
+
+	Future<Void> setup(Database const& cx) override { return Void(); }
+
+	Future<Void> start(Database const& cx) override { return _start(cx, this); }
+
+	Future<bool> check(Database const& cx) override { return _check(cx, this); }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.emplace_back("Committed writes", committed, Averaged::False);
+		m.emplace_back("Unknown writes", unknown, Averaged::False);
+	}
+
+	ACTOR static Future<Void> write(WriteBatcherWorkload* self, Reference<WriteBatcher> batcher, int i) {
+		state bool invalid = self->invalidWriteInterval > 0 && i % self->invalidWriteInterval == 0;
+		state Standalone<VectorRef<MutationRef>> mutations;
+		Key key = invalid ? Key(std::string(CLIENT_KNOBS->KEY_SIZE_LIMIT + 1, 'k')) : self->writeKey(i);
+		mutations.push_back_deep(mutations.arena(), MutationRef(MutationRef::SetValue, key, "1"_sr));
+		int64_t one = 1;
+		mutations.push_back_deep(
+		    mutations.arena(),
+		    MutationRef(MutationRef::AddValue, self->counterKey(), StringRef((uint8_t*)&one, sizeof(one))));
+		try {
+			wait(success(batcher->write(mutations)));
+			ASSERT(!invalid);
+			++self->committed;
+		} catch (Error& e) {
+			if (e.code() == error_code_key_too_large) {
+				ASSERT(invalid);
+			} else if (e.code() == error_code_commit_unknown_result) {
+				++self->unknown;
+			} else {
+				throw;
+			}
+		}
+		return Void();
+	}
+
+	ACTOR static Future<Void> _start(Database cx, WriteBatcherWorkload* self) {
+		state Reference<WriteBatcher> batcher = makeReference<WriteBatcher>(cx);
+		state std::vector<Future<Void>> writes;
+		state int i = 0;
+		for (; i < self->writes; i++) {
+			writes.push_back(write(self, batcher, i));
+			wait(delay(deterministicRandom()->random01() * 2 / self->writesPerSecond));
+		}
+		wait(waitForAll(writes));
+		return Void();
+	}
+
+	ACTOR static Future<bool> _check(Database cx, WriteBatcherWorkload* self) {
+		state Transaction tr(cx);
+		loop {
+			try {
+				state Optional<Value> count = wait(tr.get(self->counterKey()));
+				RangeResult keys = wait(tr.getRange(prefixRange(self->prefix()), CLIENT_KNOBS->TOO_MANY));
+				int64_t counted = 0;
+				if (count.present()) {
+					ASSERT(count.get().size() <= sizeof(counted));
+					memcpy(&counted, count.get().begin(), count.get().size());
+				}
+				// The counter is in the range as well
+				int written = keys.size() - count.present();
+				TraceEvent("WriteBatcherCheck")
+				    .detail("Committed", self->committed)
+				    .detail("Unknown", self->unknown)
+				    .detail("Counted", counted)
+				    .detail("Written", written);
+				return counted == written && written >= self->committed &&
+				       written <= self->committed + self->unknown;
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+	}
+};
+
+WorkloadFactory<WriteBatcherWorkload> WriteBatcherWorkloadFactory;
@@ -0,0 +1,156 @@
+/*
+ * ActorProfiler.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/ActorProfiler.h"
+#include "flow/Platform.h"
+#include "flow/UnitTest.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+std::atomic<ActorProfile*> firstProfile{ nullptr };
+thread_local ActorProfileScope* currentScope = nullptr;
+
+double bucketLimit(int bucket) {
+	return std::ldexp(1e-6, bucket);
+}
+
+// The limit of the bucket holding the run at rank, counting from the shortest
+double runTimeAt(int64_t const* buckets, int64_t rank) {
+	for (int i = 0; i < ActorProfile::RUN_TIME_BUCKETS; i++) {
+		if (rank < buckets[i]) {
+			return bucketLimit(i);
+		}
+		rank -= buckets[i];
+	}
+	return bucketLimit(ActorProfile::RUN_TIME_BUCKETS - 1);
+}
+
+} // namespace
+
+ActorProfile::ActorProfile(const char* name, const char* location) : name(name), location(location) {
+	next = firstProfile.load(std::memory_order_relaxed);
+	while (!firstProfile.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+}
+
+void ActorProfile::ran(double seconds) {
+	runs.fetch_add(1, std::memory_order_relaxed);
+	runNanoseconds.fetch_add(static_cast<int64_t>(seconds * 1e9), std::memory_order_relaxed);
+	int bucket = 0;
+	while (bucket < RUN_TIME_BUCKETS - 1 && seconds >= bucketLimit(bucket)) {
+		bucket++;
+	}
+	runTimeBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+ActorProfileScope::ActorProfileScope(ActorProfile& profile)
+  : profile(profile), parent(currentScope), start(timer_monotonic()) {
+	currentScope = this;
+}
+
+ActorProfileScope::~ActorProfileScope() {
+	double elapsed = timer_monotonic() - start;
+	profile.ran(std::max(0.0, elapsed - nested));
+	if (parent) {
+		parent->nested += elapsed;
+	}
+	currentScope = parent;
+}
+
+std::vector<ActorProfileSample> sampleActorProfiles() {
+	std::vector<ActorProfileSample> samples;
+	for (ActorProfile* p = firstProfile.load(std::memory_order_acquire); p; p = p->next) {
+		int64_t runs = p->runs.load(std::memory_order_relaxed);
+		if (runs == p->sampledRuns) {
+			continue;
+		}
+		int64_t runNanoseconds = p->runNanoseconds.load(std::memory_order_relaxed);
+		int64_t buckets[ActorProfile::RUN_TIME_BUCKETS];
+		int64_t bucketRuns = 0;
+		int longest = 0;
+		for (int i = 0; i < ActorProfile::RUN_TIME_BUCKETS; i++) {
+			int64_t count = p->runTimeBuckets[i].load(std::memory_order_relaxed);
+			buckets[i] = count - p->sampledRunTimeBuckets[i];
+			p->sampledRunTimeBuckets[i] = count;
+			bucketRuns += buckets[i];
+			if (buckets[i]) {
+				longest = i;
+			}
+		}
+
+		ActorProfileSample& sample = samples.emplace_back();
+		sample.name = p->name;
+		sample.location = p->location;
+		// Destructions are read before creations, so an actor created and destroyed in between is not missing
+		int64_t destructions = p->destructions.load(std::memory_order_relaxed);
+		sample.instances = std::max<int64_t>(0, p->creations.load(std::memory_order_relaxed) - destructions);
+		sample.frameBytes = p->frameBytes.load(std::memory_order_relaxed);
+		sample.liveBytes = sample.instances * sample.frameBytes;
+		sample.runs = runs - p->sampledRuns;
+		sample.runTime = (runNanoseconds - p->sampledRunNanoseconds) / 1e9;
+		sample.runTimeP50 = runTimeAt(buckets, bucketRuns / 2);
+		sample.runTimeP99 = runTimeAt(buckets, bucketRuns * 99 / 100);
+		sample.runTimeMax = bucketLimit(longest);
+		p->sampledRuns = runs;
+		p->sampledRunNanoseconds = runNanoseconds;
+	}
+	std::sort(samples.begin(), samples.end(), [](auto const& a, auto const& b) { return a.runTime > b.runTime; });
+	return samples;
+}
+
+TEST_CASE("/flow/ActorProfiler/nestedScopes") {
+	static ActorProfile outer("actorProfilerTestOuter", "ActorProfiler.cpp");
+	static ActorProfile inner("actorProfilerTestInner", "ActorProfiler.cpp");
+	sampleActorProfiles();
+
+	outer.created(128);
+	{
+		ActorProfileScope outerScope(outer);
+		for (int i = 0; i < 3; i++) {
+			ActorProfileScope innerScope(inner);
+			double start = timer_monotonic();
+			while (timer_monotonic() - start < 1e-3) {
+			}
+		}
+	}
+
+	bool sawOuter = false, sawInner = false;
+	for (auto const& sample : sampleActorProfiles()) {
+		if (sample.name == outer.name) {
+			sawOuter = true;
+			ASSERT_EQ(sample.runs, 1);
+			ASSERT_EQ(sample.instances, 1);
+			ASSERT_EQ(sample.liveBytes, 128);
+			// The inner scopes' time is not counted again
+			ASSERT_LT(sample.runTime, 3e-3);
+		} else if (sample.name == inner.name) {
+			sawInner = true;
+			ASSERT_EQ(sample.runs, 3);
+			ASSERT_GE(sample.runTime, 3e-3);
+			ASSERT_GE(sample.runTimeP50, 1e-3);
+		}
+	}
+	ASSERT(sawOuter && sawInner);
+	outer.destroyed();
+	return Void();
+}
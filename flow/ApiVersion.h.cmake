@@ -74,6 +74,7 @@ public: // introduced features
     API_VERSION_FEATURE(@FDB_AV_GET_TOTAL_COST@, GetTotalCost);
 	API_VERSION_FEATURE(@FDB_AV_FAIL_ON_EXTERNAL_CLIENT_ERRORS@, FailOnExternalClientErrors);
 	API_VERSION_FEATURE(@FDB_AV_GET_CLIENT_STATUS@, GetClientStatus);
+	API_VERSION_FEATURE(@FDB_AV_GET_CLIENT_METRICS@, GetClientMetrics);
 	API_VERSION_FEATURE(@FDB_AV_INITIALIZE_TRACE_ON_SETUP@, InitializeTraceOnSetup);
 };
 
@@ -15,4 +15,5 @@ set(FDB_AV_TENANT_BLOB_RANGE_API            "720")
 set(FDB_AV_GET_TOTAL_COST                   "730")
 set(FDB_AV_FAIL_ON_EXTERNAL_CLIENT_ERRORS   "730")
 set(FDB_AV_GET_CLIENT_STATUS                "730")
+set(FDB_AV_GET_CLIENT_METRICS               "730")
 set(FDB_AV_INITIALIZE_TRACE_ON_SETUP        "730")
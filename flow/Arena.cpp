@@ -22,6 +22,9 @@
 
 #include "flow/UnitTest.h"
 
+#include <unordered_map>
+#include <vector>
+
 // We don't align memory properly, and we need to tell lsan about that.
 extern "C" const char* __lsan_default_options(void) {
 	return "use_unaligned=1";
@@ -102,6 +105,71 @@ void makeNoAccess(void*, size_t) {}
 void makeDefined(void*, size_t) {}
 void makeUndefined(void*, size_t) {}
 #endif
+
+int64_t hugeArenaPoolLimit() {
+	return FLOW_KNOBS ? FLOW_KNOBS->HUGE_ARENA_POOL_BYTES : 0;
+}
+
+// Rounds a huge block size up to a multiple of a quarter of the power of two below it, so that a freed block can be
+// reused for any arena that needs a block of the same size class
+int hugeArenaBlockSize(int size) {
+	int step = 1 << (63 - clzll(size - 1) - 2);
+	return (size + step - 1) & ~(step - 1);
+}
+
+// The huge blocks freed on this thread, by size. Blocks are kept until the thread exits, up to
+// FLOW_KNOBS->HUGE_ARENA_POOL_BYTES in all.
+struct HugeArenaBlockPool {
+	std::unordered_map<int, std::vector<uint8_t*>> blocks;
+	int64_t bytes = 0;
+
+	~HugeArenaBlockPool();
+};
+
+// Blocks can be freed by thread local destructors that run after the pool's, and then they are not kept
+thread_local bool hugeArenaBlockPoolDestroyed = false;
+thread_local HugeArenaBlockPool hugeArenaBlockPool;
+
+HugeArenaBlockPool::~HugeArenaBlockPool() {
+	for (auto& [size, pooled] : blocks) {
+		for (uint8_t* block : pooled) {
+			makeDefined(block, size);
+			delete[] block;
+		}
+	}
+	g_hugeArenaPoolMemory.fetch_sub(bytes);
+	hugeArenaBlockPoolDestroyed = true;
+}
+
+uint8_t* takePooledHugeBlock(int size) {
+	if (hugeArenaBlockPoolDestroyed) {
+		return nullptr;
+	}
+	auto it = hugeArenaBlockPool.blocks.find(size);
+	if (it == hugeArenaBlockPool.blocks.end() || it->second.empty()) {
+		g_hugeArenaPoolMisses.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	uint8_t* block = it->second.back();
+	it->second.pop_back();
+	hugeArenaBlockPool.bytes -= size;
+	g_hugeArenaPoolMemory.fetch_sub(size, std::memory_order_relaxed);
+	g_hugeArenaPoolHits.fetch_add(1, std::memory_order_relaxed);
+	makeDefined(block, size);
+	return block;
+}
+
+// Returns false if the block was not kept, and should be freed
+bool poolHugeBlock(uint8_t* block, int size) {
+	if (hugeArenaBlockPoolDestroyed || hugeArenaBlockPool.bytes + size > hugeArenaPoolLimit()) {
+		return false;
+	}
+	hugeArenaBlockPool.blocks[size].push_back(block);
+	hugeArenaBlockPool.bytes += size;
+	g_hugeArenaPoolMemory.fetch_add(size, std::memory_order_relaxed);
+	makeNoAccess(block, size);
+	return true;
+}
 } // namespace
 
 Arena::Arena() : impl(nullptr) {}
@@ -133,6 +201,44 @@ void* Arena::allocate4kAlignedBuffer(uint32_t size) {
 	return ArenaBlock::dependOn4kAlignedBuffer(impl, size);
 }
 
+void Arena::reserveContiguous(size_t size) {
+	UNSTOPPABLE_ASSERT(size < std::numeric_limits<int>::max());
+	if (size == 0) {
+		return;
+	}
+	ArenaBlock* b = impl.getPtr();
+	allowAccess(b);
+	if (!impl || size_t(impl->unused()) < size) {
+		ArenaBlock::create((int)size, impl);
+		disallowAccess(b);
+		b = impl.getPtr();
+	}
+	disallowAccess(b);
+}
+
+void Arena::reset(size_t reservedSize) {
+	UNSTOPPABLE_ASSERT(reservedSize < std::numeric_limits<int>::max());
+	ArenaBlock* b = impl.getPtr();
+	if (b) {
+		allowAccess(b);
+		if (b->isSoleOwner() && !b->isTiny() && b->nextBlockOffset == 0 &&
+		    size_t(b->size()) >= reservedSize + sizeof(ArenaBlock)) {
+			if (b->secure) {
+				b->wipeUsed();
+				b->secure = 0;
+			}
+			makeNoAccess((uint8_t*)b->getData() + sizeof(ArenaBlock), b->used() - sizeof(ArenaBlock));
+			b->bigUsed = sizeof(ArenaBlock);
+			b->totalSizeEstimate = b->bigSize;
+			disallowAccess(b);
+			return;
+		}
+		disallowAccess(b);
+		impl = Reference<ArenaBlock>();
+	}
+	reserveContiguous(reservedSize);
+}
+
 FDB_DEFINE_BOOLEAN_PARAM(FastInaccurateEstimate);
 FDB_DEFINE_BOOLEAN_PARAM(IsSecureMem);
 
@@ -411,10 +517,15 @@ ArenaBlock* ArenaBlock::create(int dataSize, Reference<ArenaBlock>& next) {
 			b->bigUsed = sizeof(ArenaBlock);
 			b->secure = 0;
 		} else {
+			uint8_t* mem = nullptr;
+			if (reqSize <= hugeArenaPoolLimit()) {
+				reqSize = hugeArenaBlockSize(reqSize);
+				mem = takePooledHugeBlock(reqSize);
+			}
 #ifdef ALLOC_INSTRUMENTATION
 			allocInstr["ArenaHugeKB"].alloc((reqSize + 1023) >> 10);
 #endif
-			b = (ArenaBlock*)new uint8_t[reqSize];
+			b = (ArenaBlock*)(mem ? mem : new uint8_t[reqSize]);
 			b->tinySize = b->tinyUsed = NOT_TINY;
 			b->bigSize = reqSize;
 			b->totalSizeEstimate = b->bigSize;
@@ -525,7 +636,9 @@ void ArenaBlock::destroyLeaf() {
 			allocInstr["ArenaHugeKB"].dealloc((bigSize + 1023) >> 10);
 #endif
 			g_hugeArenaMemory.fetch_sub(bigSize);
-			delete[] reinterpret_cast<uint8_t*>(this);
+			if (!poolHugeBlock(reinterpret_cast<uint8_t*>(this), bigSize)) {
+				delete[] reinterpret_cast<uint8_t*>(this);
+			}
 		}
 	}
 }
@@ -997,6 +1110,34 @@ TEST_CASE("/flow/Arena/OptionalMap") {
 	return Void();
 }
 
+TEST_CASE("/flow/Arena/Reset") {
+	const int size = deterministicRandom()->randomInt(ArenaBlock::SMALL, 3 * ArenaBlock::LARGE);
+	Arena arena(size);
+	uint8_t* first = new (arena) uint8_t[size];
+	size_t reserved = arena.getSize();
+
+	// The arena is the only owner of its one block, so the block is kept
+	arena.reset(size);
+	ASSERT(new (arena) uint8_t[size] == first);
+	ASSERT(arena.getSize() == reserved);
+
+	// Memory shared with another arena must not be reused
+	Arena copy = arena;
+	arena.reset(size);
+	ASSERT(!copy.sameArena(arena));
+	ASSERT(new (arena) uint8_t[size] != first);
+
+	arena.reset();
+	ASSERT(arena.getSize() == 0);
+	arena.reserveContiguous(size);
+	reserved = arena.getSize();
+	for (int i = 0; i < size; i++) {
+		new (arena) uint8_t;
+	}
+	ASSERT(arena.getSize() == reserved);
+	return Void();
+}
+
 TEST_CASE("/flow/Arena/Secure") {
 #ifndef ADDRESS_SANITIZER
 	// Note: Assumptions underlying this unit test are speculative.
@@ -0,0 +1,75 @@
+/*
+ * BucketedReadyQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// At the moment, this file just contains tests. BucketedReadyQueue<> is a template
+// and so all the important implementation is in the header file
+
+#include "flow/BucketedReadyQueue.h"
+#include "flow/IRandom.h"
+#include "flow/UnitTest.h"
+
+#include <queue>
+#include <vector>
+
+namespace {
+
+struct TestTask {
+	int64_t priority;
+	TaskPriority taskID;
+	bool operator<(TestTask const& rhs) const { return priority < rhs.priority; }
+};
+
+} // namespace
+
+// Checks that the queue pops tasks in the same order as a heap ordered by priority and then by the order of pushes
+TEST_CASE("/flow/BucketedReadyQueue/random ops") {
+	BucketedReadyQueue<TestTask> queue;
+	std::priority_queue<TestTask, std::vector<TestTask>> heap;
+	// A few priorities, as a process uses, and sometimes any value up to TaskPriority::Max
+	std::vector<int> priorities = { 0, 1, 63, 64, 4095, 4096, 7000, 7010, 8545, 262143, 262144, 1000000 };
+	int64_t issued = 0;
+
+	for (int step = 0; step < 100000; step++) {
+		if (deterministicRandom()->random01() < 0.55) {
+			int priority = deterministicRandom()->random01() < 0.9
+			                   ? deterministicRandom()->randomChoice(priorities)
+			                   : deterministicRandom()->randomInt(0, static_cast<int>(TaskPriority::Max) + 1);
+			TestTask t{ (int64_t(priority) << 32) - (++issued), static_cast<TaskPriority>(priority) };
+			queue.push(t);
+			heap.push(t);
+		} else if (!heap.empty()) {
+			ASSERT(queue.top().priority == heap.top().priority);
+			queue.pop();
+			heap.pop();
+		}
+		ASSERT(queue.size() == heap.size());
+		if (deterministicRandom()->random01() < 0.0001) {
+			queue.clear();
+			heap = {};
+		}
+	}
+	while (!heap.empty()) {
+		ASSERT(queue.top().priority == heap.top().priority);
+		queue.pop();
+		heap.pop();
+	}
+	ASSERT(queue.empty());
+	return Void();
+}
@@ -0,0 +1,80 @@
+/*
+ * Coroutines.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/Coroutines.h"
+#include "flow/UnitTest.h"
+
+namespace {
+
+Future<int> addWhenReady(Future<int> a, Future<int> b) {
+	int x = co_await a;
+	co_return x + co_await b;
+}
+
+Future<Void> waitAndCount(Future<Void> f, int* waits, int* cancels) {
+	try {
+		co_await f;
+		++*waits;
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			++*cancels;
+		}
+		throw;
+	}
+}
+
+} // namespace
+
+TEST_CASE("/flow/coroutines/values") {
+	// Ready futures do not suspend
+	ASSERT_EQ(addWhenReady(1, 2).get(), 3);
+
+	Promise<int> a, b;
+	Future<int> sum = addWhenReady(a.getFuture(), b.getFuture());
+	ASSERT(!sum.isReady());
+	a.send(3);
+	ASSERT(!sum.isReady());
+	b.send(4);
+	ASSERT_EQ(sum.get(), 7);
+
+	Promise<int> c;
+	Future<int> failed = addWhenReady(c.getFuture(), 1);
+	c.sendError(io_error());
+	ASSERT(failed.isError() && failed.getError().code() == error_code_io_error);
+	return Void();
+}
+
+TEST_CASE("/flow/coroutines/cancel") {
+	int waits = 0, cancels = 0;
+	Promise<Void> trigger;
+	Future<Void> f = waitAndCount(trigger.getFuture(), &waits, &cancels);
+	Future<Void> g = waitAndCount(trigger.getFuture(), &waits, &cancels);
+	f = Future<Void>();
+	ASSERT_EQ(cancels, 1);
+	trigger.send(Void());
+	ASSERT(g.isReady() && !g.isError());
+	ASSERT_EQ(waits, 1);
+
+	// Discarding the returned future cancels the coroutine right away, as with an ACTOR
+	Promise<Void> other;
+	waitAndCount(other.getFuture(), &waits, &cancels);
+	ASSERT_EQ(cancels, 2);
+	return Void();
+}
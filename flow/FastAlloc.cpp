@@ -113,6 +113,12 @@ template <int Size>
 void* FastAllocator<Size>::freelist = nullptr;
 
 std::atomic<int64_t> g_hugeArenaMemory(0);
+std::atomic<int64_t> g_hugeArenaPoolMemory(0);
+std::atomic<int64_t> g_hugeArenaPoolHits(0);
+std::atomic<int64_t> g_hugeArenaPoolMisses(0);
+std::atomic<int64_t> g_alignedBufferPoolMemory(0);
+std::atomic<int64_t> g_alignedBufferPoolHits(0);
+std::atomic<int64_t> g_alignedBufferPoolMisses(0);
 
 double hugeArenaLastLogged = 0;
 std::map<std::string, std::pair<int, int64_t>> hugeArenaTraces;
@@ -248,7 +254,15 @@ struct FastAllocator<Size>::GlobalData {
 	std::atomic<long long> totalMemory;
 	long long partialMagazineUnallocatedMemory;
 	std::atomic<long long> activeThreads;
-	GlobalData() : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0) {
+	std::atomic<long long> magazineFetches;
+	std::atomic<double> magazineFetchSeconds;
+	std::atomic<long long> hugePageMemory;
+	// The rest of the huge page region that new magazines are taken from, and how many magazines it has left
+	void* hugePageRegion;
+	int hugePageRegionMagazines;
+	GlobalData()
+	  : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0), magazineFetches(0),
+	    magazineFetchSeconds(0), hugePageMemory(0), hugePageRegion(nullptr), hugePageRegionMagazines(0) {
 		InitializeCriticalSection(&mutex);
 	}
 };
@@ -273,6 +287,26 @@ long long FastAllocator<Size>::getActiveThreads() {
 	return globalData()->activeThreads.load();
 }
 
+template <int Size>
+long long FastAllocator<Size>::getMagazineFetches() {
+	return globalData()->magazineFetches.load();
+}
+
+template <int Size>
+long long FastAllocator<Size>::getThreadAllocations() {
+	return threadData().allocations;
+}
+
+template <int Size>
+double FastAllocator<Size>::getMagazineFetchSeconds() {
+	return globalData()->magazineFetchSeconds.load();
+}
+
+template <int Size>
+long long FastAllocator<Size>::getHugePageMemory() {
+	return globalData()->hugePageMemory.load();
+}
+
 #if FAST_ALLOCATOR_DEBUG
 static int64_t getSizeCode(int i) {
 	switch (i) {
@@ -332,6 +366,7 @@ void* FastAllocator<Size>::allocate() {
 		}
 	}
 	--thr.count;
+	++thr.allocations;
 	void* p = thr.freelist;
 #if VALGRIND
 	VALGRIND_MAKE_MEM_DEFINED(p, sizeof(void*));
@@ -457,10 +492,74 @@ FastAllocator<Size>::ThreadData::ThreadData() {
 	freelist = nullptr;
 	alternate = nullptr;
 	count = 0;
+	allocations = 0;
 }
 
 template <int Size>
 void FastAllocator<Size>::getMagazine() {
+	double start = timer_monotonic();
+	getMagazineImpl();
+	globalData()->magazineFetches.fetch_add(1, std::memory_order_relaxed);
+	double elapsed = timer_monotonic() - start;
+	double total = globalData()->magazineFetchSeconds.load(std::memory_order_relaxed);
+	while (!globalData()->magazineFetchSeconds.compare_exchange_weak(total, total + elapsed, std::memory_order_relaxed))
+		;
+}
+
+// Maps an aligned region of kFastAllocHugePageBytes and asks for it to be backed by a transparent huge page. Returns
+// nullptr where that is not supported.
+static void* allocateHugePageRegion() {
+#ifdef __linux__
+	const size_t bytes = kFastAllocHugePageBytes;
+	// Map twice the size and unmap the ends, since mmap only aligns to the page size
+	void* mapped = mmap(nullptr, 2 * bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapped == MAP_FAILED) {
+		return nullptr;
+	}
+	uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+	uintptr_t aligned = (begin + bytes - 1) & ~(uintptr_t(bytes) - 1);
+	if (aligned > begin) {
+		munmap(mapped, aligned - begin);
+	}
+	if (aligned + bytes < begin + 2 * bytes) {
+		munmap(reinterpret_cast<void*>(aligned + bytes), begin + 2 * bytes - aligned - bytes);
+	}
+	madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+	return reinterpret_cast<void*>(aligned);
+#else
+	return nullptr;
+#endif
+}
+
+// Returns a new magazine from a huge page region, or nullptr if huge pages are disabled or cannot be mapped. A huge
+// page holds many magazines, so they are taken from it one at a time as a size class grows instead of stranding the
+// rest of the page. There are no guard pages between them.
+template <int Size>
+void* FastAllocator<Size>::getHugePageMagazine() {
+	if (!FLOW_KNOBS || !FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES) {
+		return nullptr;
+	}
+	static_assert(kFastAllocHugePageBytes % kFastAllocMagazineBytes == 0);
+	void* magazine = nullptr;
+	EnterCriticalSection(&globalData()->mutex);
+	if (globalData()->hugePageRegionMagazines == 0) {
+		globalData()->hugePageRegion = allocateHugePageRegion();
+		if (globalData()->hugePageRegion) {
+			globalData()->hugePageRegionMagazines = kFastAllocHugePageBytes / kFastAllocMagazineBytes;
+			globalData()->hugePageMemory.fetch_add(kFastAllocHugePageBytes);
+		}
+	}
+	if (globalData()->hugePageRegionMagazines > 0) {
+		magazine = globalData()->hugePageRegion;
+		globalData()->hugePageRegion = static_cast<uint8_t*>(globalData()->hugePageRegion) + kFastAllocMagazineBytes;
+		--globalData()->hugePageRegionMagazines;
+	}
+	LeaveCriticalSection(&globalData()->mutex);
+	return magazine;
+}
+
+template <int Size>
+void FastAllocator<Size>::getMagazineImpl() {
 	ThreadData& thr = threadData();
 	ASSERT(!thr.freelist && !thr.alternate && thr.count == 0);
 
@@ -524,7 +623,10 @@ void FastAllocator<Size>::getMagazine() {
 #else
 	const bool includeGuardPages = true;
 #endif
-	block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	block = (void**)getHugePageMagazine();
+	if (!block) {
+		block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	}
 #endif
 
 	// void** block = new void*[ magazine_size * PSize ];
@@ -582,6 +684,132 @@ int64_t getTotalUnusedAllocatedMemory() {
 	return unusedMemory;
 }
 
+FastAllocMagazineStats getFastAllocMagazineStats() {
+	FastAllocMagazineStats stats;
+	auto add = [&stats](long long fetches, double fetchSeconds, long long hugePageMemory) {
+		stats.fetches += fetches;
+		stats.fetchSeconds += fetchSeconds;
+		stats.hugePageMemory += hugePageMemory;
+	};
+#define ADD_MAGAZINE_STATS(size)                                                                                       \
+	add(FastAllocator<size>::getMagazineFetches(),                                                                     \
+	    FastAllocator<size>::getMagazineFetchSeconds(),                                                                \
+	    FastAllocator<size>::getHugePageMemory())
+	ADD_MAGAZINE_STATS(16);
+	ADD_MAGAZINE_STATS(32);
+	ADD_MAGAZINE_STATS(64);
+	ADD_MAGAZINE_STATS(96);
+	ADD_MAGAZINE_STATS(128);
+	ADD_MAGAZINE_STATS(256);
+	ADD_MAGAZINE_STATS(512);
+	ADD_MAGAZINE_STATS(1024);
+	ADD_MAGAZINE_STATS(2048);
+	ADD_MAGAZINE_STATS(4096);
+	ADD_MAGAZINE_STATS(8192);
+	ADD_MAGAZINE_STATS(16384);
+#undef ADD_MAGAZINE_STATS
+	return stats;
+}
+
+long long getThreadFastAllocations() {
+	return FastAllocator<16>::getThreadAllocations() + FastAllocator<32>::getThreadAllocations() +
+	       FastAllocator<64>::getThreadAllocations() + FastAllocator<96>::getThreadAllocations() +
+	       FastAllocator<128>::getThreadAllocations() + FastAllocator<256>::getThreadAllocations() +
+	       FastAllocator<512>::getThreadAllocations() + FastAllocator<1024>::getThreadAllocations() +
+	       FastAllocator<2048>::getThreadAllocations() + FastAllocator<4096>::getThreadAllocations() +
+	       FastAllocator<8192>::getThreadAllocations() + FastAllocator<16384>::getThreadAllocations();
+}
+
+namespace {
+// The large 4k aligned buffers freed on this thread, by size. Redwood pages and DiskQueue write buffers come in a few
+// fixed sizes, so buffers are reused for exactly the size they were allocated with. Buffers are kept until the thread
+// exits, up to FLOW_KNOBS->ALIGNED_BUFFER_POOL_BYTES in all.
+struct AlignedBufferPool {
+	std::unordered_map<int, std::vector<void*>> buffers;
+	int64_t bytes = 0;
+
+	~AlignedBufferPool();
+};
+
+// Buffers can be freed by thread local destructors that run after the pool's, and then they are not kept
+thread_local bool alignedBufferPoolDestroyed = false;
+thread_local AlignedBufferPool alignedBufferPool;
+
+AlignedBufferPool::~AlignedBufferPool() {
+	for (auto& [size, pooled] : buffers) {
+		for (void* buffer : pooled) {
+			aligned_free(buffer);
+		}
+	}
+	g_alignedBufferPoolMemory.fetch_sub(bytes);
+	alignedBufferPoolDestroyed = true;
+}
+
+int64_t alignedBufferPoolLimit() {
+	return FLOW_KNOBS ? FLOW_KNOBS->ALIGNED_BUFFER_POOL_BYTES : 0;
+}
+} // namespace
+
+void* allocatePooled4kAligned(int size) {
+	if (!alignedBufferPoolDestroyed && alignedBufferPoolLimit() > 0) {
+		auto it = alignedBufferPool.buffers.find(size);
+		if (it != alignedBufferPool.buffers.end() && !it->second.empty()) {
+			void* buffer = it->second.back();
+			it->second.pop_back();
+			alignedBufferPool.bytes -= size;
+			g_alignedBufferPoolMemory.fetch_sub(size, std::memory_order_relaxed);
+			g_alignedBufferPoolHits.fetch_add(1, std::memory_order_relaxed);
+			return buffer;
+		}
+		g_alignedBufferPoolMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void* result;
+#ifdef __linux__
+	// Buffers of whole huge pages are aligned to them so that they can be backed by huge pages
+	if (FLOW_KNOBS && FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES && size % kFastAllocHugePageBytes == 0) {
+		result = aligned_alloc(kFastAllocHugePageBytes, size);
+		if (result) {
+			madvise(result, size, MADV_HUGEPAGE);
+		}
+	} else
+#endif
+	{
+		result = aligned_alloc(4096, size);
+	}
+	if (result == nullptr) {
+		platform::outOfMemory();
+	}
+	return result;
+}
+
+void freePooled4kAligned(int size, void* ptr) {
+	if (alignedBufferPoolDestroyed || alignedBufferPool.bytes + size > alignedBufferPoolLimit()) {
+		aligned_free(ptr);
+		return;
+	}
+	alignedBufferPool.buffers[size].push_back(ptr);
+	alignedBufferPool.bytes += size;
+	g_alignedBufferPoolMemory.fetch_add(size, std::memory_order_relaxed);
+}
+
+TEST_CASE("/flow/FastAlloc/AlignedBufferPool") {
+	const int size = 64 << 10;
+	int64_t hits = g_alignedBufferPoolHits.load();
+	void* a = allocatePooled4kAligned(size);
+	ASSERT(reinterpret_cast<uintptr_t>(a) % 4096 == 0);
+	memset(a, 0, size);
+	freePooled4kAligned(size, a);
+	void* b = allocatePooled4kAligned(size);
+	ASSERT(reinterpret_cast<uintptr_t>(b) % 4096 == 0);
+	if (FLOW_KNOBS->ALIGNED_BUFFER_POOL_BYTES >= size) {
+		ASSERT(b == a);
+		ASSERT(g_alignedBufferPoolHits.load() == hits + 1);
+	}
+	freePooled4kAligned(size, b);
+	return Void();
+}
+
 template class FastAllocator<16>;
 template class FastAllocator<32>;
 template class FastAllocator<64>;
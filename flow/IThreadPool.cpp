@@ -19,14 +19,13 @@
  */
 
 #include "flow/IThreadPool.h"
+#include "flow/Histogram.h"
 
 #include <algorithm>
-#ifndef BOOST_SYSTEM_NO_LIB
-#define BOOST_SYSTEM_NO_LIB
-#endif
-#define BOOST_DATE_TIME_NO_LIB
-#define BOOST_REGEX_NO_LIB
-#include "boost/asio.hpp"
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool> {
 	struct Thread {
@@ -42,8 +41,9 @@ class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool>
 			threadUserObject = userObject;
 			try {
 				userObject->init();
-				while (pool->ios.run_one() && (pool->mode == Mode::Run))
-					;
+				while (PThreadAction action = pool->next()) {
+					dispatch(action);
+				}
 			} catch (Error& e) {
 				TraceEvent(SevError, "ThreadPoolError").error(e);
 			}
@@ -57,45 +57,94 @@ class ThreadPool final : public IThreadPool, public ReferenceCounted<ThreadPool>
 		THREAD_RETURN;
 	}
 
+	// Queued actions run from the highest priority lane that has any, so that background work such as fetches
+	// cannot hold up foreground reads queued behind it
+	enum Lane { High = 0, Normal, Background, LaneCount };
+	static Lane laneFor(TaskPriority priority) {
+		if (priority >= TaskPriority::DiskRead) {
+			return High;
+		}
+		return priority > TaskPriority::FetchKeys ? Normal : Background;
+	}
+
+	struct QueuedAction {
+		PThreadAction action;
+		double queuedAt;
+	};
+
 	std::vector<Thread*> threads;
-	boost::asio::io_service ios;
-	boost::asio::io_service::work dontstop;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::array<std::deque<QueuedAction>, LaneCount> lanes;
+	int queued = 0;
+	// Shared by every pool in the process, so samples are taken under histogramMutex
+	std::array<Reference<Histogram>, LaneCount> queueWait;
+	static std::mutex histogramMutex;
 	enum Mode { Run = 0, Shutdown = 2 };
-	volatile int mode;
+	int mode;
 	int stackSize;
 	int pri;
 
-	struct ActionWrapper {
-		PThreadAction action;
-		ActionWrapper(PThreadAction action) : action(action) {}
-		// HACK: Boost won't use move constructors, so we just assume the last copy made is the one that will be called
-		// or cancelled
-		ActionWrapper(ActionWrapper const& r) : action(r.action) { const_cast<ActionWrapper&>(r).action = nullptr; }
-		void operator()() {
-			Thread::dispatch(action);
-			action = nullptr;
+	// Blocks until there is an action to run, or returns nullptr once the pool is stopped
+	PThreadAction next() {
+		std::unique_lock<std::mutex> lock(mutex);
+		wake.wait(lock, [this] { return mode == Shutdown || queued > 0; });
+		if (mode == Shutdown) {
+			return nullptr;
+		}
+		double t = timer();
+		int lane = High;
+		while (lanes[lane].empty()) {
+			lane++;
 		}
-		~ActionWrapper() {
-			if (action) {
-				action->cancel();
+		// Lower priority work that has waited long enough goes first, so it is delayed but never starved
+		for (int lower = lane + 1; lower < LaneCount; lower++) {
+			if (!lanes[lower].empty() &&
+			    t - lanes[lower].front().queuedAt > FLOW_KNOBS->THREAD_POOL_LANE_STARVATION_TIME) {
+				lane = lower;
+				break;
 			}
 		}
-		ActionWrapper& operator=(ActionWrapper const&) = delete;
-	};
+		QueuedAction a = lanes[lane].front();
+		lanes[lane].pop_front();
+		queued--;
+		lock.unlock();
+
+		std::lock_guard<std::mutex> histogramLock(histogramMutex);
+		queueWait[lane]->sampleSeconds(t - a.queuedAt);
+		return a.action;
+	}
 
 public:
-	ThreadPool(int stackSize, int pri) : dontstop(ios), mode(Run), stackSize(stackSize), pri(pri) {}
+	ThreadPool(int stackSize, int pri) : mode(Run), stackSize(stackSize), pri(pri) {
+		queueWait[High] = Histogram::getHistogram("ThreadPoolQueueWait"_sr, "High"_sr, Histogram::Unit::milliseconds);
+		queueWait[Normal] =
+		    Histogram::getHistogram("ThreadPoolQueueWait"_sr, "Normal"_sr, Histogram::Unit::milliseconds);
+		queueWait[Background] =
+		    Histogram::getHistogram("ThreadPoolQueueWait"_sr, "Background"_sr, Histogram::Unit::milliseconds);
+	}
 	~ThreadPool() override {}
 	Future<Void> stop(Error const& e = success()) override {
 		if (mode == Shutdown)
 			return Void();
 		ReferenceCounted<ThreadPool>::addref();
-		ios.stop(); // doesn't work?
-		mode = Shutdown;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			mode = Shutdown;
+		}
+		wake.notify_all();
 		for (int i = 0; i < threads.size(); i++) {
 			waitThread(threads[i]->handle);
 			delete threads[i];
 		}
+		// Actions that never ran are cancelled, as they were when the pool was built on an io_service
+		for (auto& lane : lanes) {
+			for (auto& a : lane) {
+				a.action->cancel();
+			}
+			lane.clear();
+		}
+		queued = 0;
 		ReferenceCounted<ThreadPool>::delref();
 		return Void();
 	}
@@ -112,10 +161,27 @@ public:
 		threads.push_back(new Thread(this, userData));
 		threads.back()->handle = g_network->startThread(start, threads.back(), stackSize, name);
 	}
-	void post(PThreadAction action) override { ios.post(ActionWrapper(action)); }
+	void post(PThreadAction action) override { postWithPriority(action, TaskPriority::DefaultEndpoint); }
+	void postWithPriority(PThreadAction action, TaskPriority priority) override {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (mode != Shutdown) {
+				lanes[laneFor(priority)].push_back(QueuedAction{ action, timer() });
+				queued++;
+				action = nullptr;
+			}
+		}
+		if (action) {
+			action->cancel();
+		} else {
+			wake.notify_one();
+		}
+	}
 	int priority() const { return pri; }
 };
 
+std::mutex ThreadPool::histogramMutex;
+
 Reference<IThreadPool> createGenericThreadPool(int stackSize, int pri) {
 	return Reference<IThreadPool>(new ThreadPool(stackSize, pri));
 }
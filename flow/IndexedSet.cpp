@@ -23,6 +23,7 @@
 
 #include "fmt/format.h"
 #include "flow/IndexedSet.h"
+#include "flow/MetricBTree.h"
 #include "flow/IRandom.h"
 #include "flow/ThreadPrimitives.h"
 #include <cinttypes>
@@ -580,4 +581,65 @@ TEST_CASE("/flow/IndexedSet/const_iterator") {
 
 	return Void();
 }
+
+TEST_CASE("/flow/MetricBTree/comparison to IndexedSet") {
+	for (int t = 0; t < 20; t++) {
+		MetricBTree<int, int64_t> bt;
+		IndexedSet<int, int64_t> is;
+		int keySpace = deterministicRandom()->randomInt(1, 100000);
+		int ops = deterministicRandom()->randomInt(0, 20000);
+		for (int n = 0; n < ops; n++) {
+			int k = deterministicRandom()->randomInt(0, keySpace);
+			int op = deterministicRandom()->randomInt(0, 10);
+			if (op < 5) {
+				int64_t m = deterministicRandom()->randomInt(0, 1000);
+				bool replace = deterministicRandom()->coinflip();
+				ASSERT(*bt.insert(k, m, replace) == *is.insert(k, m, replace));
+			} else if (op < 7) {
+				int64_t m = deterministicRandom()->randomInt(0, 100);
+				ASSERT(bt.addMetric(k, m) == is.addMetric(k, m));
+			} else if (op < 9) {
+				bt.erase(k);
+				is.erase(k);
+			} else {
+				int e = k + deterministicRandom()->randomInt(0, keySpace / 10 + 1);
+				bt.erase(k, e);
+				is.erase(k, e);
+			}
+		}
+
+		int count = 0;
+		auto i = is.begin();
+		for (auto b = bt.begin(); b != bt.end(); ++b, ++i, ++count) {
+			ASSERT(*b == *i && bt.getMetric(b) == is.getMetric(i));
+		}
+		ASSERT(i == is.end() && bt.size() == count);
+
+		int64_t total = is.sumTo(is.end());
+		ASSERT(bt.sumTo(bt.end()) == total);
+		for (int n = 0; n < 100; n++) {
+			int k = deterministicRandom()->randomInt(0, keySpace);
+			int e = deterministicRandom()->randomInt(k, keySpace + 1);
+			ASSERT(bt.sumRange(k, e) == is.sumRange(k, e));
+			ASSERT(bt.sumTo(bt.lower_bound(k)) == is.sumTo(is.lower_bound(k)));
+			auto lb = bt.lastLessOrEqual(k);
+			auto li = is.lastLessOrEqual(k);
+			ASSERT((lb == bt.end()) == (li == is.end()) && (lb == bt.end() || *lb == *li));
+		}
+		for (int n = 0; n < 100; n++) {
+			int64_t m = deterministicRandom()->randomInt64(0, total + 2);
+			auto b = bt.index(m);
+			auto x = is.index(m);
+			ASSERT((b == bt.end()) == (x == is.end()) && (b == bt.end() || *b == *x));
+		}
+
+		int k = deterministicRandom()->randomInt(0, keySpace);
+		bt.eraseAsync(k, keySpace);
+		is.erase(k, keySpace);
+		ASSERT(bt.sumTo(bt.end()) == is.sumTo(is.end()));
+		ASSERT(bt.lower_bound(k) == bt.end() && is.lower_bound(k) == is.end());
+	}
+	return Void();
+}
+
 void forceLinkIndexedSetTests() {}
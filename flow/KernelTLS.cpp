@@ -0,0 +1,263 @@
+/*
+ * KernelTLS.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/KernelTLS.h"
+#include "flow/UnitTest.h"
+
+#include <cstring>
+
+#if defined(HAVE_WOLFSSL)
+#include <wolfssl/options.h>
+#endif
+#include <openssl/hmac.h>
+
+#if defined(__linux__) && !defined(HAVE_WOLFSSL) && __has_include(<linux/tls.h>)
+#define KERNEL_TLS_SUPPORTED 1
+#include <openssl/kdf.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
+namespace {
+
+int exDataIndex() {
+	static int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+std::string fromHex(const char* begin, const char* end) {
+	auto digit = [](char c) { return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10; };
+	std::string result;
+	for (const char* p = begin; p + 1 < end; p += 2) {
+		result.push_back(static_cast<char>(digit(p[0]) << 4 | digit(p[1])));
+	}
+	return result;
+}
+
+#ifdef KERNEL_TLS_SUPPORTED
+void storeBigEndian(uint64_t value, uint8_t* out) {
+	for (int i = 7; i >= 0; i--) {
+		out[i] = value & 0xff;
+		value >>= 8;
+	}
+}
+
+// The TLS 1.2 PRF from RFC 5246
+bool prf(const EVP_MD* md,
+         const uint8_t* secret,
+         size_t secretLength,
+         std::string const& label,
+         const uint8_t* seed,
+         size_t seedLength,
+         uint8_t* out,
+         size_t length) {
+	EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr);
+	bool ok = ctx && EVP_PKEY_derive_init(ctx) > 0 && EVP_PKEY_CTX_set_tls1_prf_md(ctx, md) > 0 &&
+	          EVP_PKEY_CTX_set1_tls1_prf_secret(ctx, secret, secretLength) > 0 &&
+	          EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, reinterpret_cast<const uint8_t*>(label.data()), label.size()) > 0 &&
+	          EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, seed, seedLength) > 0 && EVP_PKEY_derive(ctx, out, &length) > 0;
+	EVP_PKEY_CTX_free(ctx);
+	return ok;
+}
+#endif
+
+} // namespace
+
+void KernelTLS::prepareContext(SSL_CTX* context) {
+#ifdef KERNEL_TLS_SUPPORTED
+	SSL_CTX_set_keylog_callback(context, &KernelTLS::keyLog);
+#endif
+}
+
+void KernelTLS::prepare(SSL* ssl) {
+#ifdef KERNEL_TLS_SUPPORTED
+	SSL_set_ex_data(ssl, exDataIndex(), this);
+	SSL_set_num_tickets(ssl, 0);
+#endif
+}
+
+// Called on the thread doing the handshake, with lines of the form "<label> <client random> <secret>" in hex
+void KernelTLS::keyLog(const SSL* ssl, const char* line) {
+	KernelTLS* self = static_cast<KernelTLS*>(SSL_get_ex_data(ssl, exDataIndex()));
+	if (!self) {
+		return;
+	}
+	const char* random = strchr(line, ' ');
+	const char* secret = random ? strchr(random + 1, ' ') : nullptr;
+	if (!secret) {
+		return;
+	}
+	std::string label(line, random);
+	if (label == "CLIENT_TRAFFIC_SECRET_0") {
+		self->clientSecret = fromHex(secret + 1, secret + strlen(secret));
+	} else if (label == "SERVER_TRAFFIC_SECRET_0") {
+		self->serverSecret = fromHex(secret + 1, secret + strlen(secret));
+	}
+}
+
+void KernelTLS::expandLabel(const EVP_MD* md,
+                            std::string const& secret,
+                            std::string const& label,
+                            uint8_t* out,
+                            int length) {
+	ASSERT(length <= EVP_MD_size(md));
+	// HkdfLabel = length, "tls13 " + label, an empty context; and the single block of HKDF-Expand it fits in
+	std::string info;
+	info.push_back(static_cast<char>(length >> 8));
+	info.push_back(static_cast<char>(length));
+	info.push_back(static_cast<char>(6 + label.size()));
+	info += "tls13 " + label;
+	info.push_back(0);
+	info.push_back(1);
+
+	uint8_t block[EVP_MAX_MD_SIZE];
+	unsigned int blockLength = 0;
+	HMAC(md,
+	     secret.data(),
+	     secret.size(),
+	     reinterpret_cast<const uint8_t*>(info.data()),
+	     info.size(),
+	     block,
+	     &blockLength);
+	memcpy(out, block, length);
+	OPENSSL_cleanse(block, sizeof(block));
+}
+
+bool KernelTLS::enableSend(SSL* ssl, int fd) {
+#ifdef KERNEL_TLS_SUPPORTED
+	const int version = SSL_version(ssl);
+	if (version != TLS1_2_VERSION && version != TLS1_3_VERSION) {
+		failure = "Version";
+		return false;
+	}
+	const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+	int keyLength;
+	switch (cipher ? SSL_CIPHER_get_cipher_nid(cipher) : NID_undef) {
+	case NID_aes_128_gcm:
+		keyLength = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+		break;
+	case NID_aes_256_gcm:
+		keyLength = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+		break;
+	default:
+		failure = "Cipher";
+		return false;
+	}
+	const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+	const bool isServer = SSL_is_server(ssl);
+
+	// The key, then the 4 byte salt and 8 byte nonce that make up the iv
+	uint8_t key[TLS_CIPHER_AES_GCM_256_KEY_SIZE];
+	uint8_t iv[TLS_CIPHER_AES_GCM_128_SALT_SIZE + TLS_CIPHER_AES_GCM_128_IV_SIZE];
+	uint64_t sequence;
+	if (version == TLS1_3_VERSION) {
+		std::string const& secret = isServer ? serverSecret : clientSecret;
+		if (secret.empty()) {
+			failure = "Secret";
+			return false;
+		}
+		expandLabel(md, secret, "key", key, keyLength);
+		expandLabel(md, secret, "iv", iv, sizeof(iv));
+		sequence = 0;
+	} else {
+		// The key block is the client and server keys, then their 4 byte salts. The Finished message was the first
+		// record sent under them.
+		uint8_t master[SSL_MAX_MASTER_KEY_LENGTH];
+		size_t masterLength = SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+		uint8_t random[2 * SSL3_RANDOM_SIZE];
+		SSL_get_server_random(ssl, random, SSL3_RANDOM_SIZE);
+		SSL_get_client_random(ssl, random + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+		uint8_t block[2 * TLS_CIPHER_AES_GCM_256_KEY_SIZE + 2 * TLS_CIPHER_AES_GCM_128_SALT_SIZE];
+		const int salt = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+		bool ok = prf(md, master, masterLength, "key expansion", random, sizeof(random), block, 2 * (keyLength + salt));
+		OPENSSL_cleanse(master, sizeof(master));
+		if (!ok) {
+			OPENSSL_cleanse(block, sizeof(block));
+			failure = "KeyExpansion";
+			return false;
+		}
+		memcpy(key, block + (isServer ? keyLength : 0), keyLength);
+		memcpy(iv, block + 2 * keyLength + (isServer ? salt : 0), salt);
+		OPENSSL_cleanse(block, sizeof(block));
+		sequence = 1;
+		// The explicit part of each nonce only has to be unique, and the kernel increments it with each record
+		storeBigEndian(sequence, iv + salt);
+	}
+
+	int result = setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls"));
+	if (result == 0) {
+		const uint16_t tlsVersion = version == TLS1_3_VERSION ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+		if (keyLength == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+			tls12_crypto_info_aes_gcm_128 info{};
+			info.info.version = tlsVersion;
+			info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+			memcpy(info.key, key, sizeof(info.key));
+			memcpy(info.salt, iv, sizeof(info.salt));
+			memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+			storeBigEndian(sequence, info.rec_seq);
+			result = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+			OPENSSL_cleanse(&info, sizeof(info));
+		} else {
+			tls12_crypto_info_aes_gcm_256 info{};
+			info.info.version = tlsVersion;
+			info.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+			memcpy(info.key, key, sizeof(info.key));
+			memcpy(info.salt, iv, sizeof(info.salt));
+			memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+			storeBigEndian(sequence, info.rec_seq);
+			result = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+			OPENSSL_cleanse(&info, sizeof(info));
+		}
+		// A socket with the tls ULP but no TX state passes writes through, so OpenSSL can keep sending on it
+		if (result != 0) {
+			failure = "Kernel";
+		}
+	} else {
+		failure = "Module";
+	}
+	OPENSSL_cleanse(key, sizeof(key));
+	OPENSSL_cleanse(iv, sizeof(iv));
+	return result == 0;
+#else
+	failure = "Platform";
+	return false;
+#endif
+}
+
+// The server application traffic key from the simple 1-RTT handshake in RFC 8448
+TEST_CASE("/flow/KernelTLS/expandLabel") {
+	auto hex = [](const char* s) { return fromHex(s, s + strlen(s)); };
+	std::string secret = hex("a11af9f05531f856ad47116b45a950328204b4f44bfb6b3a4b4f1f3fcb631643");
+	uint8_t key[16];
+	uint8_t iv[12];
+	KernelTLS::expandLabel(EVP_sha256(), secret, "key", key, sizeof(key));
+	KernelTLS::expandLabel(EVP_sha256(), secret, "iv", iv, sizeof(iv));
+	ASSERT(std::string(reinterpret_cast<char*>(key), sizeof(key)) == hex("9f02283b6c9c07efc26bb9f2ac92e356"));
+	ASSERT(std::string(reinterpret_cast<char*>(iv), sizeof(iv)) == hex("cf782b88dd83549aadf1e984"));
+	return Void();
+}
@@ -67,14 +67,18 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SLOWTASK_PROFILING_MAX_LOG_INTERVAL,                 1.0 );
 	init( SLOWTASK_PROFILING_LOG_BACKOFF,                      2.0 );
 	init( SLOWTASK_BLOCKED_INTERVAL,                          60.0 );
+	init( THREAD_POOL_LANE_STARVATION_TIME,                    0.1 ); if( randomize && BUGGIFY ) THREAD_POOL_LANE_STARVATION_TIME = 0.001;
 	init( SATURATION_PROFILING_LOG_INTERVAL,                   0.5 ); // A value of 0 means use RUN_LOOP_PROFILING_INTERVAL
 	init( SATURATION_PROFILING_MAX_LOG_INTERVAL,               5.0 );
 	init( SATURATION_PROFILING_LOG_BACKOFF,                    2.0 );
 
 	init( FAST_ALLOC_LOGGING_BYTES,                           10e6 );
 	init( FAST_ALLOC_ALLOW_GUARD_PAGES,                      false );
+	init( FAST_ALLOC_HUGE_PAGES,                             false );
 	init( HUGE_ARENA_LOGGING_BYTES,                          100e6 );
 	init( HUGE_ARENA_LOGGING_INTERVAL,                         5.0 );
+	init( HUGE_ARENA_POOL_BYTES,                                 0 ); if( randomize && BUGGIFY ) HUGE_ARENA_POOL_BYTES = deterministicRandom()->randomInt(0, 10e6);
+	init( ALIGNED_BUFFER_POOL_BYTES,                             0 ); if( randomize && BUGGIFY ) ALIGNED_BUFFER_POOL_BYTES = deterministicRandom()->randomInt(0, 50e6);
 
 	init( MEMORY_USAGE_CHECK_INTERVAL,                         1.0 );
 
@@ -103,6 +107,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( CONNECTION_MONITOR_IDLE_TIMEOUT,                   180.0 ); if( randomize && BUGGIFY ) CONNECTION_MONITOR_IDLE_TIMEOUT = 5.0;
 	init( CONNECTION_MONITOR_INCOMING_IDLE_MULTIPLIER,         1.2 );
 	init( CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY,         2.0 );
+	init( CONNECTION_MONITOR_SKIP_PING_ON_TRAFFIC,            true ); if( randomize && BUGGIFY ) CONNECTION_MONITOR_SKIP_PING_ON_TRAFFIC = false;
 
 	//FlowTransport
 	init( CONNECTION_REJECTED_MESSAGE_DELAY,                   1.0 );
@@ -131,12 +136,16 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( TLS_HANDSHAKE_THREAD_STACKSIZE,                64 * 1024 );
 	init( TLS_MALLOC_ARENA_MAX,                                  6 );
 	init( TLS_HANDSHAKE_LIMIT,                                1000 );
+	init( TLS_KERNEL_SEND,                                   false );
 
 	init( NETWORK_TEST_CLIENT_COUNT,                            30 );
 	init( NETWORK_TEST_REPLY_SIZE,                           600e3 );
 	init( NETWORK_TEST_REQUEST_COUNT,                            0 ); // 0 -> run forever
 	init( NETWORK_TEST_REQUEST_SIZE,                             1 );
 	init( NETWORK_TEST_SCRIPT_MODE,                          false );
+	init( NETWORK_TEST_PATTERN,                          "request" ); // request, fanout, stream or churn
+	init( NETWORK_TEST_STREAM_REPLIES,                         100 );
+	init( NETWORK_TEST_CHURN_REQUESTS,                          10 );
 
 	//Authorization
 	init( ALLOW_TOKENLESS_TENANT_ACCESS,                     false );
@@ -170,16 +179,29 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( ENCRYPTION_BLOCK_SIZE,                              4096 );
 	init( MAX_DECRYPTED_BLOCKS,                                 10 );
 
+	//AsyncFileReadAhead
+	init( READ_AHEAD_MAX_BYTES,                              64<<20 ); if( randomize && BUGGIFY ) READ_AHEAD_MAX_BYTES = deterministicRandom()->randomInt(0, 1<<20);
+
 	//AsyncFileKAIO
 	init( MAX_OUTSTANDING,                                      64 );
 	init( MIN_SUBMIT,                                           10 );
 	init( SQLITE_DISK_METRIC_LOGGING_INTERVAL,                 5.0 );
 	init( KAIO_LATENCY_LOGGING_INTERVAL,                      30.0 );
 	init( KAIO_LATENCY_SKETCH_ACCURACY,                       0.01 );
+	init( KAIO_COMMIT_MAX_OUTSTANDING,                          48 );
+	init( KAIO_BACKGROUND_MAX_OUTSTANDING,                      32 );
+	init( KAIO_STARVATION_TIME,                               0.05 );
 
 	init( PAGE_WRITE_CHECKSUM_HISTORY,                           0 ); if( randomize && BUGGIFY ) PAGE_WRITE_CHECKSUM_HISTORY = 10000000;
 	init( DISABLE_POSIX_KERNEL_AIO,                              0 );
 
+	//AsyncFileIOUring
+	init( ENABLE_IO_URING,                                   false );
+	init( IO_URING_ENTRIES,                                    256 );
+	init( IO_URING_SQPOLL,                                   false );
+	init( IO_URING_SQPOLL_IDLE_MS,                            1000 );
+	init( IO_URING_REGISTERED_FILES,                            64 );
+
 	//AsyncFileNonDurable
 	init( NON_DURABLE_MAX_WRITE_DELAY,                         2.0 ); if( randomize && BUGGIFY ) NON_DURABLE_MAX_WRITE_DELAY = 5.0;
 	init( MAX_PRIOR_MODIFICATION_DELAY,                        1.0 ); if( randomize && BUGGIFY ) MAX_PRIOR_MODIFICATION_DELAY = 10.0;
@@ -206,9 +228,17 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SLOW_LOOP_CUTOFF,                          15.0 / 1000.0 );
 	init( SLOW_LOOP_SAMPLING_RATE,                             0.1 );
 	init( TSC_YIELD_TIME,                                  1000000 );
+	init( BACKGROUND_TASK_PRIORITY,                           3500 ); // Tasks below DataDistributionVeryLow, e.g. blob workers, fetchKeys and restore
+	init( BACKGROUND_TSC_YIELD_TIME,                        250000 ); if( randomize && BUGGIFY ) BACKGROUND_TSC_YIELD_TIME = deterministicRandom()->randomInt(1000, 1000000);
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
+	init( ACTOR_PROFILE_TRACE_COUNT,                            20 );
+	init( ACTOR_PROFILE_STATUS_COUNT,                            5 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( BUCKETED_READY_QUEUE_ENABLED,                      false ); if( randomize && BUGGIFY ) BUCKETED_READY_QUEUE_ENABLED = true;
+	init( TIMER_WHEEL_ENABLED,                               false ); if( randomize && BUGGIFY ) TIMER_WHEEL_ENABLED = true;
+	init( TIMER_WHEEL_RESOLUTION,                            0.001 ); if( randomize && BUGGIFY ) TIMER_WHEEL_RESOLUTION = deterministicRandom()->coinflip() ? 1e-5 : 0.1;
+	init( THREAD_READY_RING_SIZE,                                0 ); if( randomize && BUGGIFY ) THREAD_READY_RING_SIZE = 1 << deterministicRandom()->randomInt(1, 13);
 	init( TASKS_PER_REACTOR_CHECK,                             100 );
 
 	//Network
@@ -216,6 +246,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( PACKET_WARNING,                                  2LL<<20 );  // 2MB packet warning quietly allows for 1MB system messages
 	init( TIME_OFFSET_LOGGING_INTERVAL,                       60.0 );
 	init( MAX_PACKET_SEND_BYTES,                        128 * 1024 );
+	init( PACKET_ATTACH_MIN_BYTES,                      256 * 1024 ); if( randomize && BUGGIFY ) PACKET_ATTACH_MIN_BYTES = deterministicRandom()->randomInt(1, 1000);
 	init( MIN_PACKET_BUFFER_BYTES,                        4 * 1024 );
 	init( MIN_PACKET_BUFFER_FREE_BYTES,                        256 );
 	init( FLOW_TCP_NODELAY,                                      1 );
@@ -249,6 +280,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MAX_TRACE_EVENT_LENGTH,                             4000 ); // If the value of this is changed, the corresponding default in Trace.cpp should be changed as well
 	init( ALLOCATION_TRACING_ENABLED,                         true );
 	init( SIM_SPEEDUP_AFTER_SECONDS,                           450 );
+	init( SIM_PROFILE_RUN_LOOP,                              false );
 	init( MAX_TRACE_LINES,                               1'000'000 );
 	init( CODE_COV_TRACE_EVENT_SEVERITY,                        10 ); // Code coverage TraceEvent severity level
 
@@ -273,6 +305,10 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SECOND_REQUEST_MULTIPLIER_DECAY,                 0.00025 );
 	init( SECOND_REQUEST_BUDGET_GROWTH,                       0.05 );
 	init( SECOND_REQUEST_MAX_BUDGET,                         100.0 );
+	init( LOAD_BALANCE_HEDGING,                              false ); if( randomize && BUGGIFY ) LOAD_BALANCE_HEDGING = true; // Send the second request once the first has taken longer than most requests to its server
+	init( LOAD_BALANCE_HEDGE_QUANTILE,                        0.95 ); if( randomize && BUGGIFY ) LOAD_BALANCE_HEDGE_QUANTILE = deterministicRandom()->random01();
+	init( LOAD_BALANCE_HEDGE_WINDOW,                           100 ); if( randomize && BUGGIFY ) LOAD_BALANCE_HEDGE_WINDOW = 5;
+	init( LOAD_BALANCE_HEDGE_DISTANT_MULTIPLIER,               2.0 ); // A second request to another DC waits this much longer
 	init( ALTERNATIVES_FAILURE_RESET_TIME,                     5.0 );
 	init( ALTERNATIVES_FAILURE_MIN_DELAY,                     0.05 );
 	init( ALTERNATIVES_FAILURE_DELAY_RATIO,                    0.2 );
@@ -308,6 +344,8 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	if ( randomize && BUGGIFY) { ENCRYPT_CIPHER_KEY_CACHE_TTL = deterministicRandom()->randomInt(2, 10) * 60; }
 	init( ENCRYPT_KEY_REFRESH_INTERVAL,   isSimulated ? 60 : 8 * 60 );
 	if ( randomize && BUGGIFY) { ENCRYPT_KEY_REFRESH_INTERVAL = deterministicRandom()->randomInt(2, 10); }
+	init( ENCRYPT_KEY_REFRESH_AHEAD,      ENCRYPT_KEY_REFRESH_INTERVAL / 2 );
+	if ( randomize && BUGGIFY) { ENCRYPT_KEY_REFRESH_AHEAD = deterministicRandom()->coinflip() ? 0 : ENCRYPT_CIPHER_KEY_CACHE_TTL; }
 	init( ENCRYPT_KEY_CACHE_LOGGING_INTERVAL,                  5.0 );
 	init( ENCRYPT_KEY_CACHE_LOGGING_SKETCH_ACCURACY,          0.01 );
 	// Refer to EncryptUtil::EncryptAuthTokenAlgo for more details
@@ -49,6 +49,7 @@
 #include "flow/ChaosMetrics.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/AsioReactor.h"
+#include "flow/KernelTLS.h"
 #include "flow/Profiler.h"
 #include "flow/ProtocolVersion.h"
 #include "flow/SendBufferIterator.h"
@@ -233,7 +234,7 @@ public:
 
 	INetworkConnections* network; // initially this, but can be changed
 
-	int64_t tscBegin, tscEnd;
+	int64_t tscBegin, tscEnd, tscBackgroundEnd;
 	double taskBegin;
 	TaskPriority currentTaskID;
 	TDMetricCollection tdmetrics;
@@ -297,11 +298,13 @@ public:
 	Int64MetricHandle countTasks;
 	Int64MetricHandle countYields;
 	Int64MetricHandle countYieldBigStack;
+	Int64MetricHandle countBackgroundYields;
 	Int64MetricHandle countYieldCalls;
 	Int64MetricHandle countYieldCallsTrue;
 	Int64MetricHandle countASIOEvents;
 	Int64MetricHandle countRunLoopProfilingSignals;
 	Int64MetricHandle countTLSPolicyFailures;
+	Int64MetricHandle countKernelTLSConnections;
 	Int64MetricHandle priorityMetric;
 	DoubleMetricHandle countLaunchTime;
 	DoubleMetricHandle countReactTime;
@@ -893,6 +896,9 @@ public:
 			ConfigureSSLStream(N2::g_net2->activeTlsPolicy, self->ssl_sock, [conn = self.getPtr()](bool verifyOk) {
 				conn->has_trusted_peer = verifyOk;
 			});
+			if (FLOW_KNOBS->TLS_KERNEL_SEND) {
+				self->kernelTLS.prepare(self->ssl_sock.native_handle());
+			}
 
 			// If the background handshakers are not all busy, use one
 			if (N2::g_net2->sslPoolHandshakesInProgress < N2::g_net2->sslHandshakerThreadsStarted) {
@@ -908,6 +914,9 @@ public:
 				self->ssl_sock.async_handshake(boost::asio::ssl::stream_base::server, std::move(p));
 			}
 			wait(onHandshook);
+			if (FLOW_KNOBS->TLS_KERNEL_SEND) {
+				self->enableKernelSend();
+			}
 			wait(delay(0, TaskPriority::Handshake));
 			connected.send(Void());
 		} catch (...) {
@@ -975,6 +984,9 @@ public:
 			ConfigureSSLStream(N2::g_net2->activeTlsPolicy, self->ssl_sock, [conn = self.getPtr()](bool verifyOk) {
 				conn->has_trusted_peer = verifyOk;
 			});
+			if (FLOW_KNOBS->TLS_KERNEL_SEND) {
+				self->kernelTLS.prepare(self->ssl_sock.native_handle());
+			}
 
 			// If the background handshakers are not all busy, use one
 			if (N2::g_net2->sslPoolHandshakesInProgress < N2::g_net2->sslHandshakerThreadsStarted) {
@@ -990,6 +1002,9 @@ public:
 				self->ssl_sock.async_handshake(boost::asio::ssl::stream_base::client, std::move(p));
 			}
 			wait(onHandshook);
+			if (FLOW_KNOBS->TLS_KERNEL_SEND) {
+				self->enableKernelSend();
+			}
 			wait(delay(0, TaskPriority::Handshake));
 			connected.send(Void());
 		} catch (...) {
@@ -1083,8 +1098,9 @@ public:
 		boost::system::error_code err;
 		++g_net2->countWrites;
 
-		size_t sent = ssl_sock.write_some(
-		    boost::iterator_range<SendBufferIterator>(SendBufferIterator(data, limit), SendBufferIterator()), err);
+		auto buffers = boost::iterator_range<SendBufferIterator>(SendBufferIterator(data, limit), SendBufferIterator());
+		// Once the kernel encrypts what is sent, the socket is written directly
+		size_t sent = kernelSend ? socket.write_some(buffers, err) : ssl_sock.write_some(buffers, err);
 
 		if (err) {
 			// Since there was an error, sent's value can't be used to infer that the buffer has data and the limit is
@@ -1128,6 +1144,8 @@ private:
 	NetworkAddress peer_address;
 	Reference<ReferencedObject<boost::asio::ssl::context>> sslContext;
 	bool has_trusted_peer;
+	KernelTLS kernelTLS;
+	bool kernelSend = false;
 
 	void init() {
 		// Socket settings that have to be set after connect or accept succeeds
@@ -1136,6 +1154,18 @@ private:
 		platform::setCloseOnExec(socket.native_handle());
 	}
 
+	void enableKernelSend() {
+		kernelSend = kernelTLS.enableSend(ssl_sock.native_handle(), socket.native_handle());
+		if (kernelSend) {
+			++g_net2->countKernelTLSConnections;
+		} else {
+			TraceEvent("N2_KernelTLSUnavailable", id)
+			    .suppressFor(60.0)
+			    .detail("PeerAddr", peer_address)
+			    .detail("Reason", kernelTLS.failure);
+		}
+	}
+
 	void closeSocket() {
 		boost::system::error_code cancelError;
 		socket.cancel(cancelError);
@@ -1225,8 +1255,8 @@ Net2::Net2(const TLSConfig& tlsConfig, bool useThreadPool, bool useMetrics)
     sslContextVar({ ReferencedObject<boost::asio::ssl::context>::from(
         boost::asio::ssl::context(boost::asio::ssl::context::tls)) }),
     sslHandshakerThreadsStarted(0), sslPoolHandshakesInProgress(0), tlsConfig(tlsConfig),
-    tlsInitializedState(ETLSInitState::NONE), network(this), tscBegin(0), tscEnd(0), taskBegin(0),
-    currentTaskID(TaskPriority::DefaultYield), stopped(false), started(false), numYields(0),
+    tlsInitializedState(ETLSInitState::NONE), network(this), tscBegin(0), tscEnd(0), tscBackgroundEnd(0),
+    taskBegin(0), currentTaskID(TaskPriority::DefaultYield), stopped(false), started(false), numYields(0),
     lastPriorityStats(nullptr) {
 	// Until run() is called, yield() will always yield
 	TraceEvent("Net2Starting").log();
@@ -1245,6 +1275,7 @@ Net2::Net2(const TLSConfig& tlsConfig, bool useThreadPool, bool useMetrics)
 
 #ifdef __linux__
 	setGlobal(INetwork::enEventFD, (flowGlobalType)N2::ASIOReactor::newEventFD(reactor));
+	setGlobal(INetwork::enIOUringEventFD, (flowGlobalType)N2::ASIOReactor::newEventFD(reactor));
 #endif
 
 	updateNow();
@@ -1385,11 +1416,13 @@ void Net2::initMetrics() {
 	countTasks.init("Net2.CountTasks"_sr);
 	countYields.init("Net2.CountYields"_sr);
 	countYieldBigStack.init("Net2.CountYieldBigStack"_sr);
+	countBackgroundYields.init("Net2.CountBackgroundYields"_sr);
 	countYieldCalls.init("Net2.CountYieldCalls"_sr);
 	countASIOEvents.init("Net2.CountASIOEvents"_sr);
 	countYieldCallsTrue.init("Net2.CountYieldCallsTrue"_sr);
 	countRunLoopProfilingSignals.init("Net2.CountRunLoopProfilingSignals"_sr);
 	countTLSPolicyFailures.init("Net2.CountTLSPolicyFailures"_sr);
+	countKernelTLSConnections.init("Net2.CountKernelTLSConnections"_sr);
 	priorityMetric.init("Net2.Priority"_sr);
 	awakeMetric.init("Net2.Awake"_sr);
 	slowTaskMetric.init("Net2.SlowTask"_sr);
@@ -1494,6 +1527,7 @@ void Net2::run() {
 
 		tscBegin = timestampCounter();
 		tscEnd = tscBegin + FLOW_KNOBS->TSC_YIELD_TIME;
+		tscBackgroundEnd = tscBegin + FLOW_KNOBS->BACKGROUND_TSC_YIELD_TIME;
 		taskBegin = timer_monotonic();
 		numYields = 0;
 		TaskPriority minTaskID = TaskPriority::Max;
@@ -1717,6 +1751,13 @@ bool Net2::check_yield(TaskPriority taskID, int64_t tscNow) {
 		return true;
 	}
 
+	// Checked against the running task rather than taskID, which the run loop passes as Max
+	if (tscNow > tscBackgroundEnd && static_cast<int>(currentTaskID) < FLOW_KNOBS->BACKGROUND_TASK_PRIORITY) {
+		++numYields;
+		++countBackgroundYields;
+		return true;
+	}
+
 	return false;
 }
 
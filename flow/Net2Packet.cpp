@@ -25,6 +25,7 @@ void PacketWriter::init(PacketBuffer* buf, ReliablePacket* reliable) {
 	this->reliable = reliable;
 	this->length = 0;
 	length -= buffer->bytes_written;
+	this->attachMinBytes = FLOW_KNOBS->PACKET_ATTACH_MIN_BYTES;
 	if (reliable) {
 		reliable->buffer = buffer;
 		buffer->addref();
@@ -56,10 +57,14 @@ void PacketWriter::serializeBytesAcrossBoundary(const void* data, int bytes) {
 }
 
 void PacketWriter::nextBuffer(size_t size) {
+	appendBuffer(PacketBuffer::create(size));
+}
+
+void PacketWriter::appendBuffer(PacketBuffer* next) {
 	auto last_buffer_bytes_written = buffer->bytes_written;
 	length += last_buffer_bytes_written;
 
-	buffer->next = PacketBuffer::create(size);
+	buffer->next = next;
 	buffer = buffer->nextPacketBuffer();
 
 	if (reliable) {
@@ -72,6 +77,41 @@ void PacketWriter::nextBuffer(size_t size) {
 	}
 }
 
+bool PacketWriter::packetWriterAttach(uint8_t* out, const uint8_t* data, size_t size, void* self) {
+	PacketWriter* writer = static_cast<PacketWriter*>(self);
+	if (!writer->payloadArena || writer->attachMinBytes <= 0 || size < (size_t)writer->attachMinBytes) {
+		return false;
+	}
+	writer->attached.emplace_back(out, StringRef(data, size));
+	return true;
+}
+
+void PacketWriter::attachPayloads() {
+	if (attached.empty()) {
+		return;
+	}
+	// The object serializer allocates a message all at once, so every payload belongs somewhere in the current buffer
+	PacketBuffer* message = buffer;
+	int end = message->bytes_written;
+	std::sort(attached.begin(), attached.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+
+	int begin = 0;
+	for (auto const& [out, bytes] : attached) {
+		int at = out - message->data();
+		ASSERT(at >= begin && at + bytes.size() <= end);
+		if (buffer == message) {
+			message->bytes_written = at;
+		} else if (at > begin) {
+			appendBuffer(PacketBuffer::slice(message, begin, at));
+		}
+		appendBuffer(PacketBuffer::attach(bytes, *payloadArena));
+		begin = at + bytes.size();
+	}
+	// The rest of the message, and the space after it for whatever is written next
+	appendBuffer(PacketBuffer::slice(message, begin, end));
+	attached.clear();
+}
+
 // Adds exactly bytes of unwritten length to the buffer, possibly across packet buffer boundaries,
 // and initializes buf to point to the packet buffer(s) that contain the unwritten space
 void PacketWriter::writeAhead(int bytes, struct SplitBuffer* buf) {
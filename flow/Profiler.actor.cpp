@@ -57,6 +57,11 @@ struct SignalClosure {
 struct SyncFileForSim : ReferenceCounted<SyncFileForSim> {
 	FILE* f;
 	SyncFileForSim(std::string const& filename) { f = fopen(filename.c_str(), "wb"); }
+	~SyncFileForSim() {
+		if (f) {
+			fclose(f);
+		}
+	}
 
 	bool isOpen() const { return f != nullptr; }
 
@@ -127,10 +132,10 @@ struct Profiler {
 	timer_t periodicTimer;
 	bool timerInitialized;
 
-	Profiler(int period, std::string const& outfn, INetwork* network)
+	Profiler(int period, std::string const& outfn, double rotateSeconds, INetwork* network)
 	  : signalClosure(signal_handler_for_closure, this), environmentInfoWriter(Unversioned()), network(network),
 	    timerInitialized(false) {
-		actor = profile(this, period, outfn);
+		actor = profile(this, period, outfn, rotateSeconds);
 	}
 
 	~Profiler() {
@@ -149,6 +154,7 @@ struct Profiler {
 		if (profilingEnabled) {
 			double t = timer();
 			output_buffer->push(*(void**)&t);
+			output_buffer->push((void*)(intptr_t)network->getCurrentTask());
 			size_t n = platform::raw_backtrace(addresses, 256);
 			for (int i = 0; i < n; i++)
 				output_buffer->push(addresses[i]);
@@ -180,11 +186,26 @@ struct Profiler {
 		return 0;
 	}
 
-	ACTOR static Future<Void> profile(Profiler* self, int period, std::string outfn) {
+	static Reference<SyncFileForSim> openOutputFile(std::string const& outfn) {
+		std::string filename = outfn;
+		auto i = filename.find("%TIME%");
+		if (i != std::string::npos) {
+			filename.replace(i, 6, format("%lld", (long long)timer()));
+		}
+		auto file = makeReference<SyncFileForSim>(filename);
+		if (!file->isOpen()) {
+			TraceEvent(SevWarn, "FailedToOpenProfilingOutputFile").detail("Filename", filename).GetLastError();
+		}
+		return file;
+	}
+
+	// Samples are written to outfn, or if rotateSeconds is positive, to a new file every rotateSeconds, each with its
+	// own environment header so that it can be symbolized on its own
+	ACTOR static Future<Void> profile(Profiler* self, int period, std::string outfn, double rotateSeconds) {
 		// Open and truncate output file
-		state Reference<SyncFileForSim> outFile = makeReference<SyncFileForSim>(outfn);
+		state Reference<SyncFileForSim> outFile = openOutputFile(outfn);
+		state double outFileStart = timer();
 		if (!outFile->isOpen()) {
-			TraceEvent(SevWarn, "FailedToOpenProfilingOutputFile").detail("Filename", outfn).GetLastError();
 			return Void();
 		}
 
@@ -194,8 +215,9 @@ struct Profiler {
 
 		// Write environment information header
 		// At the moment this consists of the output of dl_iterate_phdr, the locations of
-		// all shared objects loaded into this process (to help locate symbols) and the period in ns
-		self->environmentInfoWriter << int64_t(0x101) << int64_t(period * 1000);
+		// all shared objects loaded into this process (to help locate symbols) and the period in ns.
+		// In version 0x102 each sample is the time, the TaskPriority running, the stack and then -1.
+		self->environmentInfoWriter << int64_t(0x102) << int64_t(period * 1000);
 		dl_iterate_phdr(phdr_callback, self);
 		self->environmentInfoWriter << int64_t(0);
 		while (self->environmentInfoWriter.getLength() % sizeof(void*))
@@ -251,6 +273,18 @@ struct Profiler {
 			std::swap(self->output_buffer, otherBuffer);
 			self->enableSignal(true);
 
+			if (rotateSeconds > 0 && timer() - outFileStart >= rotateSeconds) {
+				Reference<SyncFileForSim> nextFile = openOutputFile(outfn);
+				outFileStart = timer();
+				if (nextFile->isOpen()) {
+					outFile = nextFile;
+					outOffset = 0;
+					wait(outFile->write(
+					    self->environmentInfoWriter.getData(), self->environmentInfoWriter.getLength(), outOffset));
+					outOffset += self->environmentInfoWriter.getLength();
+				}
+			}
+
 			wait(otherBuffer->writeTo(outFile, outOffset));
 			wait(outFile->flush());
 			otherBuffer->clear();
@@ -285,6 +319,12 @@ void startProfiling(INetwork* network,
 		const char* outfn = getenv("FLOW_PROFILER_OUTPUT");
 		outputFile = (outfn ? outfn : "profile.bin");
 	}
+	// Continuous profiling at a low rate can start a new file periodically, named by its start time
+	const char* rotateEnv = getenv("FLOW_PROFILER_ROTATE_SECONDS");
+	double rotateSeconds = rotateEnv ? atof(rotateEnv) : 0;
+	if (rotateSeconds > 0 && outputFile.find("%TIME%") == std::string::npos) {
+		outputFile += ".%TIME%";
+	}
 	outputFile = findAndReplace(
 	    findAndReplace(
 	        findAndReplace(outputFile, "%ADDRESS%", findAndReplace(network->getLocalAddress().toString(), ":", ".")),
@@ -294,7 +334,7 @@ void startProfiling(INetwork* network,
 	    format("%llx", (long long)sys_gettid()));
 
 	if (!Profiler::active_profiler)
-		Profiler::active_profiler = new Profiler(period, outputFile, network);
+		Profiler::active_profiler = new Profiler(period, outputFile, rotateSeconds, network);
 }
 
 void stopProfiling() {
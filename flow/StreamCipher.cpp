@@ -120,6 +120,10 @@ EncryptionStreamCipher::EncryptionStreamCipher(const StreamCipherKey* key, const
 	EVP_EncryptInit_ex(cipher.getCtx(), nullptr, nullptr, key->data(), iv.data());
 }
 
+void EncryptionStreamCipher::reset(const StreamCipher::IV& iv) {
+	EVP_EncryptInit_ex(cipher.getCtx(), nullptr, nullptr, nullptr, iv.data());
+}
+
 StringRef EncryptionStreamCipher::encrypt(unsigned char const* plaintext, int len, Arena& arena) {
 	CODE_PROBE(true, "Encrypting data with StreamCipher");
 	auto ciphertext = new (arena) unsigned char[len + AES_BLOCK_SIZE];
@@ -142,6 +146,10 @@ DecryptionStreamCipher::DecryptionStreamCipher(const StreamCipherKey* key, const
 	EVP_DecryptInit_ex(cipher.getCtx(), nullptr, nullptr, key->data(), iv.data());
 }
 
+void DecryptionStreamCipher::reset(const StreamCipher::IV& iv) {
+	EVP_DecryptInit_ex(cipher.getCtx(), nullptr, nullptr, nullptr, iv.data());
+}
+
 StringRef DecryptionStreamCipher::decrypt(unsigned char const* ciphertext, int len, Arena& arena) {
 	CODE_PROBE(true, "Decrypting data with StreamCipher");
 	auto plaintext = new (arena) unsigned char[len];
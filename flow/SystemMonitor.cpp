@@ -20,6 +20,7 @@
 
 #include <fstream>
 
+#include "flow/ActorProfiler.h"
 #include "flow/flow.h"
 #include "flow/Histogram.h"
 #include "flow/Platform.h"
@@ -182,6 +183,9 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .detail("TLSPolicyFailures",
 			            (netData.countTLSPolicyFailures - statState->networkState.countTLSPolicyFailures) /
 			                currentStats.elapsed)
+			    .detail("KernelTLSConnections",
+			            (netData.countKernelTLSConnections - statState->networkState.countKernelTLSConnections) /
+			                currentStats.elapsed)
 			    .trackLatest(eventName);
 
 			TraceEvent("MemoryMetrics")
@@ -198,6 +202,12 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .DETAILALLOCATORMEMUSAGE(8192)
 			    .DETAILALLOCATORMEMUSAGE(16384)
 			    .detail("HugeArenaMemory", g_hugeArenaMemory.load())
+			    .detail("HugeArenaPoolMemory", g_hugeArenaPoolMemory.load())
+			    .detail("HugeArenaPoolHits", g_hugeArenaPoolHits.load())
+			    .detail("HugeArenaPoolMisses", g_hugeArenaPoolMisses.load())
+			    .detail("AlignedBufferPoolMemory", g_alignedBufferPoolMemory.load())
+			    .detail("AlignedBufferPoolHits", g_alignedBufferPoolHits.load())
+			    .detail("AlignedBufferPoolMisses", g_alignedBufferPoolMisses.load())
 			    .detail("DCID", machineState.dcId)
 			    .detail("ZoneID", machineState.zoneId)
 			    .detail("MachineID", machineState.machineId);
@@ -231,10 +241,15 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			unused_memory += FastAllocator<16384>::getApproximateMemoryUnused();
 
 			if (total_memory > 0) {
+				FastAllocMagazineStats magazineStats = getFastAllocMagazineStats();
 				TraceEvent("FastAllocMemoryUsage")
 				    .detail("TotalMemory", total_memory)
 				    .detail("UnusedMemory", unused_memory)
-				    .detail("Utilization", format("%f%%", (total_memory - unused_memory) * 100.0 / total_memory));
+				    .detail("Utilization", format("%f%%", (total_memory - unused_memory) * 100.0 / total_memory))
+				    .detail("HugePageMemory", magazineStats.hugePageMemory)
+				    .detail("MagazineFetches", magazineStats.fetches)
+				    .detail("MagazineFetchLatency",
+				            magazineStats.fetches ? magazineStats.fetchSeconds / magazineStats.fetches : 0.0);
 			}
 
 			TraceEvent n("NetworkMetrics");
@@ -247,6 +262,8 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .detail("RunLoopProfilingSignals",
 			            netData.countRunLoopProfilingSignals - statState->networkState.countRunLoopProfilingSignals)
 			    .detail("YieldBigStack", netData.countYieldBigStack - statState->networkState.countYieldBigStack)
+			    .detail("BackgroundYields",
+			            netData.countBackgroundYields - statState->networkState.countBackgroundYields)
 			    .detail("RunLoopIterations", netData.countRunLoop - statState->networkState.countRunLoop)
 			    .detail("TimersExecuted", netData.countTimers - statState->networkState.countTimers)
 			    .detail("TasksExecuted", netData.countTasks - statState->networkState.countTasks)
@@ -316,6 +333,33 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 				itr.maxDuration = 0;
 			}
 
+			// Only actors built with -DACTOR_PROFILER=ON are profiled
+			std::vector<ActorProfileSample> actorSamples = sampleActorProfiles();
+			for (int i = 0; i < std::min<int>(actorSamples.size(), FLOW_KNOBS->ACTOR_PROFILE_STATUS_COUNT); i++) {
+				auto const& sample = actorSamples[i];
+				n.detail(format("BusiestActor%d", i).c_str(), sample.name)
+				    .detail(format("BusiestActor%dRunTime", i).c_str(), sample.runTime)
+				    .detail(format("BusiestActor%dRuns", i).c_str(), sample.runs)
+				    .detail(format("BusiestActor%dInstances", i).c_str(), sample.instances)
+				    .detail(format("BusiestActor%dFrameBytes", i).c_str(), sample.frameBytes);
+			}
+			for (int i = 0; i < std::min<int>(actorSamples.size(), FLOW_KNOBS->ACTOR_PROFILE_TRACE_COUNT); i++) {
+				auto const& sample = actorSamples[i];
+				TraceEvent("ActorProfile")
+				    .detail("Rank", i)
+				    .detail("Name", sample.name)
+				    .detail("Location", sample.location)
+				    .detail("Elapsed", currentStats.elapsed)
+				    .detail("Runs", sample.runs)
+				    .detail("RunTime", sample.runTime)
+				    .detail("RunTimeP50", sample.runTimeP50)
+				    .detail("RunTimeP99", sample.runTimeP99)
+				    .detail("RunTimeMax", sample.runTimeMax)
+				    .detail("Instances", sample.instances)
+				    .detail("FrameBytes", sample.frameBytes)
+				    .detail("LiveBytes", sample.liveBytes);
+			}
+
 			n.trackLatest("NetworkMetrics");
 		}
 
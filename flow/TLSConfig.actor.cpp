@@ -46,6 +46,7 @@ TLSPolicy::~TLSPolicy() {}
 #include <utility>
 #include <boost/asio/ssl/context.hpp>
 
+#include "flow/KernelTLS.h"
 #include "flow/Platform.h"
 #include "flow/IAsyncFile.h"
 
@@ -136,6 +137,10 @@ void ConfigureSSLContext(const LoadedTLSConfig& loaded, boost::asio::ssl::contex
 		if (certBytes.size()) {
 			context.use_certificate_chain(boost::asio::buffer(certBytes.data(), certBytes.size()));
 		}
+
+		if (FLOW_KNOBS->TLS_KERNEL_SEND) {
+			KernelTLS::prepareContext(context.native_handle());
+		}
 	} catch (boost::system::system_error& e) {
 		TraceEvent("TLSContextConfigureError")
 		    .detail("What", e.what())
@@ -0,0 +1,83 @@
+/*
+ * ThreadSafeRing.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// At the moment, this file just contains tests. ThreadSafeRing<> is a template
+// and so all the important implementation is in the header file
+
+#include "flow/ThreadSafeRing.h"
+#include "flow/IRandom.h"
+#include "flow/UnitTest.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("/flow/ThreadSafeRing/single thread") {
+	ThreadSafeRing<int> ring(4);
+	std::vector<int> out;
+	auto take = [&out](int&& i) { out.push_back(i); };
+
+	ASSERT(ring.canSleep());
+	bool wake = false;
+	ASSERT(ring.tryPush(0, wake) && wake);
+	ASSERT(!ring.canSleep());
+	for (int i = 1; i < 4; i++) {
+		ASSERT(ring.tryPush(i, wake) && !wake);
+	}
+	ASSERT(!ring.tryPush(4, wake));
+
+	ASSERT(ring.drain(take, 3) == 3);
+	ASSERT(ring.tryPush(4, wake) && !wake);
+	ASSERT(ring.drain(take, 10) == 2);
+	ASSERT(ring.drain(take, 10) == 0);
+	ASSERT(out == std::vector<int>({ 0, 1, 2, 3, 4 }));
+	return Void();
+}
+
+// Producers wait when the ring is full, so each producer's items must come out in the order it pushed them
+TEST_CASE("/flow/ThreadSafeRing/producers") {
+	const int producers = deterministicRandom()->randomInt(1, 9);
+	const int perProducer = 20000;
+	ThreadSafeRing<std::pair<int, int>> ring(1 << deterministicRandom()->randomInt(1, 8));
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++) {
+		threads.emplace_back([&ring, p, perProducer]() {
+			for (int i = 0; i < perProducer; i++) {
+				ring.push(std::make_pair(p, i));
+			}
+		});
+	}
+
+	std::vector<int> next(producers, 0);
+	int taken = 0;
+	while (taken < producers * perProducer) {
+		taken += ring.drain(
+		    [&next](std::pair<int, int>&& item) {
+			    ASSERT(next[item.first] == item.second);
+			    ++next[item.first];
+		    },
+		    ring.capacity());
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+	ASSERT(ring.canSleep());
+	return Void();
+}
@@ -0,0 +1,123 @@
+/*
+ * TimerWheel.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// At the moment, this file just contains tests. TimerWheel<> is a template
+// and so all the important implementation is in the header file
+
+#include "flow/TimerWheel.h"
+#include "flow/IRandom.h"
+#include "flow/UnitTest.h"
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+namespace {
+
+struct TestTimer {
+	double at;
+	int id;
+	bool operator<(TestTimer const& rhs) const { return at > rhs.at; }
+};
+
+} // namespace
+
+// Checks that the wheel returns the same timers as a heap at each step, for delays from far below a tick to past the
+// range of the top level
+TEST_CASE("/flow/TimerWheel/random ops") {
+	const double resolution = deterministicRandom()->randomChoice(std::vector<double>{ 1e-5, 0.001, 0.5 });
+	TimerWheel<TestTimer> wheel(resolution);
+	std::priority_queue<TestTimer, std::vector<TestTimer>> heap;
+	double now = deterministicRandom()->coinflip() ? 0 : deterministicRandom()->random01() * 1e6;
+	const std::vector<double> maxDelays = { 1e-4, 0.3, 100, 1e5, 1e7 };
+	int id = 0;
+
+	for (int step = 0; step < 20000; step++) {
+		int timers = deterministicRandom()->randomInt(0, 4);
+		for (int i = 0; i < timers; i++) {
+			double delay = deterministicRandom()->random01() * deterministicRandom()->randomChoice(maxDelays);
+			TestTimer t{ now + delay, id++ };
+			wheel.push(t);
+			heap.push(t);
+		}
+		ASSERT(wheel.size() == heap.size());
+		if (!heap.empty()) {
+			ASSERT(wheel.nextDeadline() <= heap.top().at);
+		}
+
+		if (!heap.empty() && deterministicRandom()->random01() < 0.02) {
+			now = std::max(now, wheel.nextDeadline());
+		} else if (deterministicRandom()->random01() < 0.1) {
+			now += deterministicRandom()->random01() * 1e5;
+		} else {
+			now += deterministicRandom()->random01() * 0.05;
+		}
+
+		wheel.advance(now);
+		std::vector<int> fromWheel, fromHeap;
+		while (wheel.hasDue(now)) {
+			fromWheel.push_back(wheel.top().id);
+			wheel.pop();
+		}
+		while (!heap.empty() && heap.top().at <= now) {
+			fromHeap.push_back(heap.top().id);
+			heap.pop();
+		}
+		std::sort(fromWheel.begin(), fromWheel.end());
+		std::sort(fromHeap.begin(), fromHeap.end());
+		ASSERT(fromWheel == fromHeap);
+	}
+
+	wheel.clear();
+	ASSERT(wheel.empty());
+	return Void();
+}
+
+TEST_CASE("/flow/TimerWheel/deadline order") {
+	TimerWheel<TestTimer> wheel(1.0);
+	wheel.push({ 10.7, 0 });
+	wheel.push({ 10.2, 1 });
+	wheel.push({ 3.5, 2 });
+	wheel.advance(0);
+	ASSERT(wheel.nextDeadline() == 3.5);
+	wheel.advance(10.5);
+	ASSERT(wheel.hasDue(10.5));
+	ASSERT(wheel.top().id == 2);
+	wheel.pop();
+	ASSERT(wheel.top().id == 1);
+	wheel.pop();
+	// 10.7 is in the tick the wheel has advanced to, but is not due yet
+	ASSERT(!wheel.hasDue(10.5));
+	ASSERT(wheel.nextDeadline() == 10.7);
+	wheel.advance(10.7);
+	ASSERT(wheel.hasDue(10.7) && wheel.top().id == 0);
+	wheel.pop();
+	ASSERT(wheel.empty());
+
+	// Past the span of the lowest level, the wheel only knows the start of the slot
+	wheel.push({ 700.5, 3 });
+	ASSERT(wheel.nextDeadline() == 512.0);
+	wheel.advance(700.4);
+	ASSERT(!wheel.hasDue(700.4));
+	ASSERT(wheel.nextDeadline() == 700.5);
+	wheel.advance(700.5);
+	ASSERT(wheel.hasDue(700.5) && wheel.top().id == 3);
+	return Void();
+}
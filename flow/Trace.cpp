@@ -393,10 +393,17 @@ public:
 			return;
 		}
 
+		if (trackError) {
+			latestEventCache.setLatestError(fields);
+		}
+		if (!trackLatestKey.empty()) {
+			latestEventCache.set(trackLatestKey, fields);
+		}
+
 		// FIXME: What if we are using way too much memory for buffer?
 		ASSERT(!isOpen() || fields.isAnnotated());
-		eventBuffer.push_back(fields);
 		bufferLength += fields.sizeBytes();
+		eventBuffer.push_back(std::move(fields));
 
 		if (g_network && g_network->isSimulated()) {
 			// Throw an error if we have queued up a large number of events in simulation. This makes it easier to
@@ -405,7 +412,7 @@ public:
 			// identify where the process is actually stuck.
 			if (bufferLength > 1e8) {
 				fprintf(stderr, "Trace log buffer overflow\n");
-				fprintf(stderr, "Last event: %s\n", fields.toString().c_str());
+				fprintf(stderr, "Last event: %s\n", eventBuffer.back().toString().c_str());
 				// Setting this to 0 avoids a recurse from the assertion trace event and also prevents a situation where
 				// we roll the trace log only to log the single assertion event when using --crash.
 				bufferLength = 0;
@@ -415,13 +422,6 @@ public:
 				failedLineOverflow = 1; // we only want to do this once
 			}
 		}
-
-		if (trackError) {
-			latestEventCache.setLatestError(fields);
-		}
-		if (!trackLatestKey.empty()) {
-			latestEventCache.set(trackLatestKey, fields);
-		}
 	}
 
 	void log(int severity, const char* name, UID id, uint64_t event_ts) {
@@ -1291,7 +1291,8 @@ void BaseTraceEvent::log() {
 					TraceEvent::eventCounts[severity / 10]++;
 				}
 
-				g_traceLog.writeEvent(fields, trackingKey, severity > SevWarnAlways);
+				// The fields are not used once the event is logged, so hand them to the writer without a copy
+				g_traceLog.writeEvent(std::move(fields), trackingKey, severity > SevWarnAlways);
 
 				if (g_traceLog.isOpen()) {
 					// Log Metrics
@@ -1374,6 +1375,12 @@ std::string BaseTraceEvent::printRealTime(double time) {
 		// The clock is simulated, so return the real time
 		ts = Clock::to_time_t(Clock::now());
 	}
+	// Most events on a thread fall within the same second, so format each second only once
+	thread_local time_t lastTs = -1;
+	thread_local std::string lastRealTime;
+	if (ts == lastTs) {
+		return lastRealTime;
+	}
 	std::stringstream ss;
 #ifdef _WIN32
 	// MSVC gmtime is threadsafe
@@ -1383,7 +1390,9 @@ std::string BaseTraceEvent::printRealTime(double time) {
 	struct tm result;
 	ss << std::put_time(::gmtime_r(&ts, &result), "%Y-%m-%dT%H:%M:%SZ");
 #endif
-	return ss.str();
+	lastTs = ts;
+	lastRealTime = ss.str();
+	return lastRealTime;
 }
 
 TraceInterval& TraceInterval::begin() {
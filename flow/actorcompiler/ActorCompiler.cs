@@ -406,6 +406,7 @@ namespace actorcompiler
             LineNumber(writer, actor.SourceLine);
             WriteStateConstructor(writer);
             WriteStateDestructor(writer);
+            WriteProfileAccessor(writer);
             WriteFunctions(writer);
             foreach (var st in state)
             {
@@ -490,6 +491,12 @@ namespace actorcompiler
             }
         }
 
+        void ProfileScope(Function fun, string profile) {
+            fun.WriteLine("#ifdef ACTOR_PROFILER");
+            fun.WriteLine("ActorProfileScope actorProfileScope_({0});", profile);
+            fun.WriteLine("#endif");
+        }
+
         void ProbeCreate(Function fun, string name) {
             if (generateProbes) {
                 fun.WriteLine("fdb_probe_actor_create(\"{0}\", {1});", name, thisAddress);
@@ -878,6 +885,7 @@ namespace actorcompiler
                 functions.Add(string.Format("{0}#{1}", cbFunc.name, ch.Index), cbFunc);
                 cbFunc.Indent(codeIndent);
                 ProbeEnter(cbFunc, actor.name, ch.Index);
+                ProfileScope(cbFunc, "actorProfile_()");
                 cbFunc.WriteLine("{0};", exitFunc.call());
 
                 Function _overload = cbFunc.popOverload();
@@ -905,6 +913,7 @@ namespace actorcompiler
                 functions.Add(string.Format("{0}#{1}", errFunc.name, ch.Index), errFunc);
                 errFunc.Indent(codeIndent);
                 ProbeEnter(errFunc, actor.name, ch.Index);
+                ProfileScope(errFunc, "actorProfile_()");
                 errFunc.WriteLine("{0};", exitFunc.call());
                 TryCatch(cx.WithTarget(errFunc), cx.catchFErr, cx.tryLoopDepth, () =>
                 {
@@ -1302,6 +1311,10 @@ namespace actorcompiler
             constructor.WriteLine("this->lineage.setActorName(\"{0}\");", actor.name);
             constructor.WriteLine("LineageScope _(&this->lineage);");
             constructor.WriteLine("#endif");
+            constructor.WriteLine("#ifdef ACTOR_PROFILER");
+            constructor.WriteLine("this->actorProfile_().created(sizeof(*this));");
+            constructor.WriteLine("#endif");
+            ProfileScope(constructor, "this->actorProfile_()");
             // constructor.WriteLine("getCurrentLineage()->modify(&StackLineage::actorName) = \"{0}\"_sr;", actor.name);
             constructor.WriteLine("this->{0};", body.call());
             ProbeExit(constructor, actor.name);
@@ -1363,9 +1376,22 @@ namespace actorcompiler
             destructor.WriteLine("{");
             destructor.Indent(+1);
             ProbeDestroy(destructor, actor.name);
+            destructor.WriteLine("#ifdef ACTOR_PROFILER");
+            destructor.WriteLine("actorProfile_().destroyed();");
+            destructor.WriteLine("#endif");
             WriteFunction(writer, destructor, destructor.BodyText);
         }
 
+        // With -DACTOR_PROFILER=ON, the counters shared by every instance of the actor
+        void WriteProfileAccessor(TextWriter writer) {
+            writer.WriteLine("#ifdef ACTOR_PROFILER");
+            writer.WriteLine("\tstatic ActorProfile& actorProfile_() {");
+            writer.WriteLine("\t\tstatic ActorProfile profile(\"{0}\", \"{1}:{2}\");", actor.name, Path.GetFileName(sourceFile), actor.SourceLine);
+            writer.WriteLine("\t\treturn profile;");
+            writer.WriteLine("\t}");
+            writer.WriteLine("#endif");
+        }
+
         IEnumerable<Statement> Flatten(Statement stmt)
         {
             if (stmt == null) return new Statement[] { };
@@ -1,4 +1,5 @@
 #cmakedefine ALLOC_INSTRUMENTATION
+#cmakedefine ACTOR_PROFILER
 #cmakedefine NDEBUG
 #cmakedefine FDB_RELEASE
 #ifdef FDB_RELEASE
@@ -0,0 +1,107 @@
+/*
+ * ActorProfiler.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_ACTOR_PROFILER_H
+#define FLOW_ACTOR_PROFILER_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct ActorProfileSample;
+
+// Counters for one ACTOR, kept when FDB is built with -DACTOR_PROFILER=ON. The actor compiler then gives each ACTOR a
+// static ActorProfile, counts its instances as they are created and destroyed, and opens an ActorProfileScope around
+// every run of its code: the first one from the constructor and one for each callback that wakes it up.
+//
+// Profiles are only ever added, to a lock free list, and their counters are relaxed atomics, so actors on any thread
+// can update them while sampleActorProfiles() reads them.
+class ActorProfile {
+public:
+	// Run times are counted in buckets of powers of two microseconds, the last one holding everything longer
+	static constexpr int RUN_TIME_BUCKETS = 20;
+
+	ActorProfile(const char* name, const char* location);
+
+	void created(int frameBytes) {
+		this->frameBytes.store(frameBytes, std::memory_order_relaxed);
+		creations.fetch_add(1, std::memory_order_relaxed);
+	}
+	void destroyed() { destructions.fetch_add(1, std::memory_order_relaxed); }
+	void ran(double seconds);
+
+	const char* const name;
+	const char* const location;
+
+private:
+	friend std::vector<ActorProfileSample> sampleActorProfiles();
+
+	std::atomic<int> frameBytes{ 0 };
+	std::atomic<int64_t> creations{ 0 };
+	std::atomic<int64_t> destructions{ 0 };
+	std::atomic<int64_t> runs{ 0 };
+	std::atomic<int64_t> runNanoseconds{ 0 };
+	std::atomic<int64_t> runTimeBuckets[RUN_TIME_BUCKETS] = {};
+
+	// What the last sample saw, only touched by sampleActorProfiles()
+	int64_t sampledRuns = 0;
+	int64_t sampledRunNanoseconds = 0;
+	int64_t sampledRunTimeBuckets[RUN_TIME_BUCKETS] = {};
+
+	ActorProfile* next = nullptr;
+};
+
+// Attributes the time until it is destroyed to profile, less the time of any scopes opened inside it
+class ActorProfileScope {
+public:
+	explicit ActorProfileScope(ActorProfile& profile);
+	~ActorProfileScope();
+
+	ActorProfileScope(ActorProfileScope const&) = delete;
+	ActorProfileScope& operator=(ActorProfileScope const&) = delete;
+
+private:
+	ActorProfile& profile;
+	ActorProfileScope* parent;
+	double start;
+	double nested = 0;
+};
+
+// What an ACTOR did since the previous sample
+struct ActorProfileSample {
+	const char* name;
+	const char* location;
+	int64_t instances;
+	int64_t liveBytes;
+	int frameBytes;
+	int64_t runs;
+	double runTime;
+	// The upper bounds of the buckets that the median and 99th percentile runs fell in, and of the longest one
+	double runTimeP50;
+	double runTimeP99;
+	double runTimeMax;
+};
+
+// Returns a sample for each ACTOR that ran since the previous call, the longest running first. Only one thread should
+// take samples.
+std::vector<ActorProfileSample> sampleActorProfiles();
+
+#endif
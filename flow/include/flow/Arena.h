@@ -116,6 +116,13 @@ public:
 	void dependsOn(const Arena& p);
 	void* allocate4kAlignedBuffer(uint32_t size);
 
+	// Makes sure that the next size bytes allocated from this arena fit in its current block
+	void reserveContiguous(size_t size);
+	// Drops everything allocated from this arena, like assigning Arena(reservedSize) to it. If no other arena shares
+	// its memory and that memory is one block of at least reservedSize, the block is kept and reused instead, so an
+	// actor that fills an arena per batch can stop allocating once it has reserved enough.
+	void reset(size_t reservedSize = 0);
+
 	// If fastInaccurateEstimate is true this operation is O(1) but it is inaccurate in that it
 	// will omit memory added to this Arena's block tree using Arena handles which reference
 	// non-root nodes in this Arena's block tree.
@@ -751,8 +758,10 @@ struct dynamic_size_traits<StringRef> : std::true_type {
 		return t.size();
 	}
 	template <class Context>
-	static void save(uint8_t* out, const StringRef& t, Context&) {
-		std::copy(t.begin(), t.end(), out);
+	static void save(uint8_t* out, const StringRef& t, Context& context) {
+		if (!tryAttach(context, out, t.begin(), t.size())) {
+			std::copy(t.begin(), t.end(), out);
+		}
 	}
 
 	template <class Context>
@@ -1536,4 +1545,109 @@ struct dynamic_size_traits<VectorRef<V, VecSerStrategy::String>> : std::true_typ
 	}
 };
 
+// A read-only view of a VectorRef<V, VecSerStrategy::String> that keeps it in its serialized form. It has the same
+// wire format, so a message type can declare a SerializedVectorRef<V> where the sender has a VectorRef<V,
+// VecSerStrategy::String>. Loading it only records where the elements are, and saving it copies them as one block, so
+// a receiver that forwards the vector or reads only some of its elements does not decode the rest. Elements are
+// decoded one at a time as it is iterated.
+//
+// Like a deserialized StringRef, it points into the memory of the message it was loaded from.
+template <class V>
+class SerializedVectorRef {
+public:
+	SerializedVectorRef() : count(0) {}
+
+	int size() const { return count; }
+	bool empty() const { return count == 0; }
+	// The serialized vector, including its element count
+	StringRef serialized() const { return bytes; }
+
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = V;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const V*;
+		using reference = const V&;
+
+		const V& operator*() const { return current; }
+		const V* operator->() const { return &current; }
+		const_iterator& operator++() {
+			ptr += currentSize;
+			--remaining;
+			decode();
+			return *this;
+		}
+		bool operator==(const const_iterator& rhs) const { return remaining == rhs.remaining; }
+		bool operator!=(const const_iterator& rhs) const { return remaining != rhs.remaining; }
+
+	private:
+		friend class SerializedVectorRef;
+		// The elements point into the view's memory, which is already in place
+		struct Context {
+			const uint8_t* tryReadZeroCopy(const uint8_t* ptr, unsigned) { return ptr; }
+		};
+
+		const_iterator(const uint8_t* ptr, int remaining) : ptr(ptr), remaining(remaining) { decode(); }
+		void decode() {
+			if (remaining > 0) {
+				Context context;
+				currentSize = string_serialized_traits<V>().load(ptr, current, context);
+			}
+		}
+
+		const uint8_t* ptr;
+		int remaining;
+		V current;
+		uint32_t currentSize = 0;
+	};
+
+	const_iterator begin() const { return const_iterator(bytes.begin() + sizeof(uint32_t), count); }
+	const_iterator end() const { return const_iterator(nullptr, 0); }
+
+	// Decodes every element into a VectorRef in arena. The elements point into the view's memory.
+	VectorRef<V, VecSerStrategy::String> toVectorRef(Arena& arena) const {
+		VectorRef<V, VecSerStrategy::String> result;
+		result.reserve(arena, count);
+		for (const auto& v : *this) {
+			result.push_back(arena, v);
+		}
+		return result;
+	}
+
+private:
+	friend struct dynamic_size_traits<SerializedVectorRef<V>>;
+	StringRef bytes;
+	int count;
+};
+
+template <class V>
+struct dynamic_size_traits<SerializedVectorRef<V>> : std::true_type {
+	using T = SerializedVectorRef<V>;
+
+	template <class Context>
+	static size_t size(const T& t, Context&) {
+		return t.empty() ? sizeof(uint32_t) : t.bytes.size();
+	}
+
+	template <class Context>
+	static void save(uint8_t* out, const T& t, Context&) {
+		if (t.empty()) {
+			uint32_t length = 0;
+			memcpy(out, &length, sizeof(length));
+		} else {
+			memcpy(out, t.bytes.begin(), t.bytes.size());
+		}
+	}
+
+	template <class Context>
+	static void load(const uint8_t* data, size_t size, T& t, Context& context) {
+		ASSERT(size >= sizeof(uint32_t));
+		t.bytes = StringRef(context.tryReadZeroCopy(data, size), size);
+		uint32_t count;
+		memcpy(&count, t.bytes.begin(), sizeof(count));
+		t.count = count;
+	}
+};
+
 #endif
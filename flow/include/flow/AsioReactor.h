@@ -98,6 +98,9 @@ private:
 
 public:
 	static IEventFD* getEventFD() { return static_cast<IEventFD*>((void*)g_network->global(INetwork::enEventFD)); }
+	static IEventFD* getIOUringEventFD() {
+		return static_cast<IEventFD*>((void*)g_network->global(INetwork::enIOUringEventFD));
+	}
 	static EventFD* newEventFD(ASIOReactor& reactor) { return new EventFD(&reactor); }
 #endif
 };
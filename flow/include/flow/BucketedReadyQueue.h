@@ -0,0 +1,147 @@
+/*
+ * BucketedReadyQueue.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_BUCKETED_READY_QUEUE_H
+#define FLOW_BUCKETED_READY_QUEUE_H
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+#include "flow/Error.h"
+#include "flow/Deque.h"
+#include "flow/Platform.h"
+#include "flow/TaskPriority.h"
+
+// A queue of tasks with a T::taskID, which pops the task with the highest TaskPriority first and tasks of the same
+// TaskPriority in the order they were pushed.
+//
+// Each TaskPriority in use has its own FIFO, and a bitmap with a bit per TaskPriority, in four levels of 64-bit words,
+// finds the highest priority that has tasks. push() and pop() therefore take constant time however many tasks are
+// queued, where a heap takes time logarithmic in their number.
+template <class T>
+class BucketedReadyQueue {
+public:
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	void push(T const& t) {
+		uint32_t priority = bucketOf(t.taskID);
+		Deque<T>& bucket = buckets[priority];
+		if (bucket.empty()) {
+			setBit(priority);
+		}
+		bucket.push_back(t);
+		++count;
+		if (!topBucket || priority > topPriority) {
+			topBucket = &bucket;
+			topPriority = priority;
+		}
+	}
+
+	T const& top() const { return topBucket->front(); }
+
+	void pop() {
+		topBucket->pop_front();
+		--count;
+		if (topBucket->empty()) {
+			clearBit(topPriority);
+			if (count == 0) {
+				topBucket = nullptr;
+			} else {
+				topPriority = highestBit();
+				topBucket = &buckets[topPriority];
+			}
+		}
+	}
+
+	void clear() {
+		for (auto& [priority, bucket] : buckets) {
+			if (!bucket.empty()) {
+				clearBit(priority);
+				bucket.clear();
+			}
+		}
+		count = 0;
+		topBucket = nullptr;
+	}
+
+	void swap(BucketedReadyQueue& other) {
+		std::swap(buckets, other.buckets);
+		std::swap(bits0, other.bits0);
+		std::swap(bits1, other.bits1);
+		std::swap(bits2, other.bits2);
+		std::swap(bits3, other.bits3);
+		std::swap(count, other.count);
+		std::swap(topBucket, other.topBucket);
+		std::swap(topPriority, other.topPriority);
+	}
+
+private:
+	static constexpr int priorityBits = 20;
+	static_assert(static_cast<uint32_t>(TaskPriority::Max) < (1u << priorityBits));
+
+	static uint32_t bucketOf(TaskPriority taskID) {
+		uint32_t priority = static_cast<uint32_t>(taskID);
+		ASSERT(priority <= static_cast<uint32_t>(TaskPriority::Max));
+		return priority;
+	}
+
+	void setBit(uint32_t p) {
+		bits0[p >> 6] |= uint64_t(1) << (p & 63);
+		bits1[p >> 12] |= uint64_t(1) << ((p >> 6) & 63);
+		bits2[p >> 18] |= uint64_t(1) << ((p >> 12) & 63);
+		bits3 |= uint64_t(1) << (p >> 18);
+	}
+
+	void clearBit(uint32_t p) {
+		if ((bits0[p >> 6] &= ~(uint64_t(1) << (p & 63))) != 0) {
+			return;
+		}
+		if ((bits1[p >> 12] &= ~(uint64_t(1) << ((p >> 6) & 63))) != 0) {
+			return;
+		}
+		if ((bits2[p >> 18] &= ~(uint64_t(1) << ((p >> 12) & 63))) != 0) {
+			return;
+		}
+		bits3 &= ~(uint64_t(1) << (p >> 18));
+	}
+
+	// Must not be called when no bit is set
+	uint32_t highestBit() const {
+		uint32_t i = 63 - clzll(bits3);
+		i = i * 64 + 63 - clzll(bits2[i]);
+		i = i * 64 + 63 - clzll(bits1[i]);
+		return i * 64 + 63 - clzll(bits0[i]);
+	}
+
+	// Buckets are kept once created, since a process only uses a few hundred priorities
+	std::unordered_map<uint32_t, Deque<T>> buckets;
+	std::array<uint64_t, (1 << priorityBits) / 64> bits0{};
+	std::array<uint64_t, (1 << priorityBits) / 64 / 64> bits1{};
+	std::array<uint64_t, (1 << priorityBits) / 64 / 64 / 64> bits2{};
+	uint64_t bits3 = 0;
+	size_t count = 0;
+	Deque<T>* topBucket = nullptr;
+	uint32_t topPriority = 0;
+};
+
+#endif /* FLOW_BUCKETED_READY_QUEUE_H */
@@ -0,0 +1,205 @@
+/*
+ * Coroutines.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_COROUTINES_H
+#define FLOW_COROUTINES_H
+#pragma once
+
+#include <coroutine>
+
+#include "flow/flow.h"
+
+// C++20 coroutines returning Future<T>, usable alongside ACTORs without going through the actor compiler:
+//
+//   Future<int> add(Future<int> a, Future<int> b) {
+//       int x = co_await a;
+//       co_return x + co_await b;
+//   }
+//
+// As with an ACTOR, the coroutine runs until its first wait when called, the returned future is the coroutine's own
+// SAV, and dropping every reference to it cancels the coroutine by throwing actor_cancelled() from the pending
+// co_await. Arguments are copied into the coroutine frame, but references stay references, so as with ACTORs only
+// pass by value what must outlive the first wait. Only Futures can be awaited; a Future<Void> coroutine ends with
+// `co_return;`.
+
+namespace coro {
+
+template <class T>
+struct Promise;
+
+// A co_await the coroutine is suspended on, so that cancelling the coroutine can interrupt it
+struct Wait {
+	virtual void cancelWait() = 0;
+};
+
+template <class U, class T>
+struct FutureAwaiter final : Callback<U>, Wait {
+	Future<U> future;
+	Promise<T>* promise;
+	std::coroutine_handle<> handle;
+	U const* value = nullptr;
+	Optional<Error> err;
+
+	FutureAwaiter(Future<U> future, Promise<T>* promise) : future(std::move(future)), promise(promise) {}
+
+	bool await_ready() {
+		if (promise->cancelled) {
+			err = actor_cancelled();
+			return true;
+		}
+		return future.isReady();
+	}
+
+	void await_suspend(std::coroutine_handle<> h) {
+		handle = h;
+		promise->waiting = this;
+		future.addCallbackAndClear(this);
+	}
+
+	// The value is only guaranteed to live until fire() returns, which is after the coroutine has copied it
+	U await_resume() {
+		if (err.present()) {
+			throw err.get();
+		}
+		if (value) {
+			return *value;
+		}
+		return future.get();
+	}
+
+	void fire(U const& v) override {
+		promise->waiting = nullptr;
+		this->remove();
+		value = &v;
+		handle.resume();
+	}
+
+	void error(Error e) override {
+		promise->waiting = nullptr;
+		this->remove();
+		err = e;
+		handle.resume();
+	}
+
+	void cancelWait() override {
+		this->remove();
+		err = actor_cancelled();
+		handle.resume();
+	}
+};
+
+template <class T>
+struct PromiseBase : SAV<T> {
+	Wait* waiting = nullptr;
+	bool cancelled = false;
+	bool hasValue = false;
+	Optional<Error> thrown;
+
+	PromiseBase() : SAV<T>(1, 1) {}
+
+	// Coroutine frames vary in size, so they come from the size classes of the fast allocator
+	static void* operator new(size_t size) { return allocateFast(size); }
+	static void operator delete(void* p, size_t size) { freeFast(size, p); }
+
+	Future<T> get_return_object() { return Future<T>(this); }
+	std::suspend_never initial_suspend() noexcept { return {}; }
+
+	struct FinalAwaiter {
+		bool await_ready() noexcept { return false; }
+		void await_suspend(std::coroutine_handle<Promise<T>> h) noexcept { h.promise().finish(); }
+		void await_resume() noexcept {}
+	};
+	FinalAwaiter final_suspend() noexcept { return {}; }
+
+	void unhandled_exception() {
+		try {
+			throw;
+		} catch (Error& e) {
+			thrown = e;
+		} catch (...) {
+			thrown = unknown_error();
+		}
+	}
+
+	template <class U>
+	FutureAwaiter<U, T> await_transform(Future<U> const& future) {
+		return FutureAwaiter<U, T>(future, static_cast<Promise<T>*>(this));
+	}
+	template <class U>
+	FutureAwaiter<U, T> await_transform(Future<U>&& future) {
+		return FutureAwaiter<U, T>(std::move(future), static_cast<Promise<T>*>(this));
+	}
+
+	// Called once the frame's locals are gone, like an ACTOR destroying its state before sending its result
+	void finish() {
+		if (!this->futures) {
+			if (hasValue) {
+				this->value().~T();
+			}
+			destroy();
+		} else if (thrown.present()) {
+			this->sendErrorAndDelPromiseRef(thrown.get());
+		} else {
+			ASSERT(hasValue);
+			this->finishSendAndDelPromiseRef();
+		}
+	}
+
+	void cancel() override {
+		cancelled = true;
+		if (waiting) {
+			Wait* w = waiting;
+			waiting = nullptr;
+			w->cancelWait();
+		}
+	}
+
+	void destroy() override {
+		std::coroutine_handle<Promise<T>>::from_promise(*static_cast<Promise<T>*>(this)).destroy();
+	}
+};
+
+template <class T>
+struct Promise : PromiseBase<T> {
+	template <class U>
+	void return_value(U&& value) {
+		if (this->futures) {
+			new (&this->value()) T(std::forward<U>(value));
+			this->hasValue = true;
+		}
+	}
+};
+
+template <>
+struct Promise<Void> : PromiseBase<Void> {
+	void return_void() {
+		new (&this->value()) Void();
+		this->hasValue = true;
+	}
+};
+
+} // namespace coro
+
+template <class T, class... Args>
+struct std::coroutine_traits<Future<T>, Args...> {
+	using promise_type = coro::Promise<T>;
+};
+
+#endif
@@ -104,6 +104,9 @@ void recordDeallocation(void* ptr);
 #endif
 
 inline constexpr auto kFastAllocMagazineBytes = 128 << 10;
+// With FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES, magazines are carved out of aligned regions of this size, so that each can be
+// backed by one transparent huge page
+inline constexpr auto kFastAllocHugePageBytes = 2 << 20;
 
 template <int Size>
 class FastAllocator {
@@ -115,6 +118,13 @@ public:
 	static long long getTotalMemory();
 	static long long getApproximateMemoryUnused();
 	static long long getActiveThreads();
+	// The number of times a thread ran out of memory in its magazines and had to get another one, and the time spent
+	// doing it, including faulting in the new magazine's pages
+	static long long getMagazineFetches();
+	static double getMagazineFetchSeconds();
+	static long long getHugePageMemory();
+	// The number of blocks the calling thread has allocated, for measuring the allocations made by a piece of code
+	static long long getThreadAllocations();
 
 #ifdef ALLOC_INSTRUMENTATION
 	static volatile int32_t pageCount;
@@ -134,6 +144,7 @@ private:
 		void* freelist;
 		int count; // there are count items on freelist
 		void* alternate; // alternate is either a full magazine, or an empty one
+		long long allocations;
 		ThreadData();
 		~ThreadData();
 	};
@@ -169,14 +180,35 @@ private:
 	static void* freelist;
 
 	static void getMagazine();
+	static void getMagazineImpl();
+	static void* getHugePageMagazine();
 	static void releaseMagazine(void*);
 };
 
 extern std::atomic<int64_t> g_hugeArenaMemory;
+// Huge arena blocks kept for reuse by the threads that freed them (see FLOW_KNOBS->HUGE_ARENA_POOL_BYTES), and how
+// often a huge block was taken from them or had to be allocated
+extern std::atomic<int64_t> g_hugeArenaPoolMemory;
+extern std::atomic<int64_t> g_hugeArenaPoolHits;
+extern std::atomic<int64_t> g_hugeArenaPoolMisses;
+// The same for 4k aligned buffers too large for FastAllocator (see FLOW_KNOBS->ALIGNED_BUFFER_POOL_BYTES)
+extern std::atomic<int64_t> g_alignedBufferPoolMemory;
+extern std::atomic<int64_t> g_alignedBufferPoolHits;
+extern std::atomic<int64_t> g_alignedBufferPoolMisses;
 void hugeArenaSample(int size);
 void releaseAllThreadMagazines();
 int64_t getTotalUnusedAllocatedMemory();
 
+struct FastAllocMagazineStats {
+	long long fetches = 0;
+	double fetchSeconds = 0;
+	long long hugePageMemory = 0;
+};
+// Totals of the magazine statistics of all sizes of FastAllocator
+FastAllocMagazineStats getFastAllocMagazineStats();
+// Blocks of all sizes allocated by the calling thread
+long long getThreadFastAllocations();
+
 inline constexpr int nextFastAllocatedSize(int x) {
 	assert(x > 0 && x <= 16384);
 	if (x <= 16)
@@ -268,6 +300,11 @@ inline void freeFast(int size, void* ptr) {
 	delete[] (uint8_t*)ptr;
 }
 
+// Allocate and free 4k aligned buffers of sizes FastAllocator does not support, reusing buffers of the same size
+// freed on this thread
+[[nodiscard]] void* allocatePooled4kAligned(int size);
+void freePooled4kAligned(int size, void* ptr);
+
 // Allocate a block of memory aligned to 4096 bytes. Size must be a multiple of
 // 4096. Guaranteed not to return null. Use freeFast4kAligned to free.
 [[nodiscard]] inline void* allocateFast4kAligned(int size) {
@@ -280,11 +317,7 @@ inline void freeFast(int size, void* ptr) {
 	if (size <= 16384)
 		return FastAllocator<16384>::allocate();
 #endif
-	auto* result = aligned_alloc(4096, size);
-	if (result == nullptr) {
-		platform::outOfMemory();
-	}
-	return result;
+	return allocatePooled4kAligned(size);
 }
 
 // Free a pointer returned from allocateFast4kAligned(size)
@@ -298,7 +331,7 @@ inline void freeFast4kAligned(int size, void* ptr) {
 	if (size <= 16384)
 		return FastAllocator<16384>::release(ptr);
 #endif
-	aligned_free(ptr);
+	freePooled4kAligned(size, ptr);
 }
 
 #endif
@@ -51,6 +51,7 @@ public:
 	}
 	void setrefCountUnsafe(int32_t count) const { referenceCount.store(count); }
 	int32_t debugGetReferenceCount() const { return referenceCount.load(); }
+	bool isSoleOwner() const { return referenceCount.load() == 1; }
 
 private:
 	ThreadSafeReferenceCounted(const ThreadSafeReferenceCounted&) /* = delete*/;
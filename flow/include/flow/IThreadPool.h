@@ -37,7 +37,8 @@
 // of IThreadPoolReceiver that will do the work.  init() is called on it on the new thread
 
 // Then the caller calls post() as many times as desired.  Each call will invoke the given thread action on
-// any one of the thread pool receivers passed to addThread().
+// any one of the thread pool receivers passed to addThread().  Actions passed to postWithPriority() may be run ahead
+// of queued actions with a lower priority; implementations are free to ignore it.
 
 // TypedAction<> is a utility subclass to make it easier to create thread actions and receivers.
 
@@ -62,6 +63,7 @@ public:
 	virtual Future<Void> getError() const = 0; // asynchronously throws an error if there is an internal error
 	virtual void addThread(IThreadPoolReceiver* userData, const char* name = nullptr) = 0;
 	virtual void post(PThreadAction action) = 0;
+	virtual void postWithPriority(PThreadAction action, TaskPriority priority) { post(action); }
 	virtual Future<Void> stop(Error const& e = success()) = 0;
 	virtual bool isCoro() const { return false; }
 	virtual void addref() = 0;
@@ -71,5 +71,18 @@ ACTOR template <class Node>
 	return Void();
 }
 
+ACTOR template <class T>
+[[flow_allow_discard]] Future<Void> ISFreeItems(std::vector<T> toFree) {
+	// Destroys the items erased from a MetricBTree, yielding periodically so that clearing a large range does not
+	// stall the run loop
+	while (!toFree.empty()) {
+		toFree.resize(toFree.size() - std::min<size_t>(toFree.size(), 1000));
+		if (!toFree.empty())
+			wait(yield());
+	}
+
+	return Void();
+}
+
 #include "flow/unactorcompiler.h"
 #endif
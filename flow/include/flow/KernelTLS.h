@@ -0,0 +1,70 @@
+/*
+ * KernelTLS.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_KERNEL_TLS_H
+#define FLOW_KERNEL_TLS_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <openssl/ssl.h>
+
+// KernelTLS hands the sending half of an established TLS session to the kernel (kTLS on Linux). Once it is enabled,
+// the kernel encrypts whatever is written to the socket, so a write is a plain send() on the network thread. Reads are
+// still decrypted by OpenSSL.
+//
+// OpenSSL does not expose the TLS 1.3 traffic secrets, so they are taken from the key log callback that
+// prepareContext() installs. prepare() must be called on each connection before its handshake. It also turns off
+// TLS 1.3 session tickets, which a server would otherwise send under the traffic key, leaving the record sequence
+// number the kernel starts from unknown.
+//
+// After enableSend() succeeds nothing but application data may be written: OpenSSL's own state is not advanced, so an
+// alert or key update it sent would be out of sequence. FDB peers never renegotiate or request key updates.
+class KernelTLS {
+public:
+	// Must be called on a context before its connections' handshakes for them to be able to use TLS 1.3
+	static void prepareContext(SSL_CTX* context);
+
+	// Must be called before the handshake of ssl
+	void prepare(SSL* ssl);
+
+	// Installs the sending key of the established session ssl into the socket fd. Returns false, with the reason in
+	// failure, if the platform, kernel, TLS version or cipher does not support it; ssl then keeps sending as before.
+	bool enableSend(SSL* ssl, int fd);
+
+	const char* failure = nullptr;
+
+	// HKDF-Expand-Label from RFC 8446, for outputs no longer than md's digest
+	static void expandLabel(const EVP_MD* md,
+	                        std::string const& secret,
+	                        std::string const& label,
+	                        uint8_t* out,
+	                        int length);
+
+private:
+	static void keyLog(const SSL* ssl, const char* line);
+
+	// The TLS 1.3 application traffic secrets, from the key log
+	std::string clientSecret;
+	std::string serverSecret;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * KeyCompare.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_KEYCOMPARE_H
+#define FLOW_KEYCOMPARE_H
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define FLOW_KEYCOMPARE_SIMD 1
+#elif defined(__aarch64__)
+#include "flow/sse2neon.h"
+#define FLOW_KEYCOMPARE_SIMD 1
+#else
+#define FLOW_KEYCOMPARE_SIMD 0
+#endif
+
+// Byte-wise key comparison kernels for hot ordered-key paths such as the resolver's skip list.  Database keys are
+// frequently tuple encoded and share long prefixes, so the first mismatching byte is located a vector at a time
+// instead of going through an out-of-line memcmp() call for every comparison.
+
+namespace keycompare {
+
+inline int countTrailingZeros(uint32_t x) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return index;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+// Returns the index of the first byte that differs between a and b, or n if the first n bytes are equal
+inline int mismatch(const uint8_t* a, const uint8_t* b, int n) {
+	int i = 0;
+#if FLOW_KEYCOMPARE_SIMD
+#ifdef __AVX2__
+	for (; i + 32 <= n; i += 32) {
+		__m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+		uint32_t eq = _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+		if (eq != 0xffffffff)
+			return i + countTrailingZeros(~eq);
+	}
+#endif
+	for (; i + 16 <= n; i += 16) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+		uint32_t eq = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+		if (eq != 0xffff)
+			return i + countTrailingZeros(~eq & 0xffff);
+	}
+#endif
+	for (; i + 8 <= n; i += 8) {
+		uint64_t wa, wb;
+		memcpy(&wa, a + i, 8);
+		memcpy(&wb, b + i, 8);
+		if (wa != wb)
+			break;
+	}
+	for (; i < n; i++) {
+		if (a[i] != b[i])
+			return i;
+	}
+	return n;
+}
+
+// Three way comparison of two byte strings with the same ordering as StringRef::compare: negative if a < b, zero if
+// they are equal and positive if a > b.
+inline int compare(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
+	const int n = std::min(aLen, bLen);
+	const int i = mismatch(a, b, n);
+	if (i < n)
+		return int(a[i]) - int(b[i]);
+	return (aLen > bLen) - (aLen < bLen);
+}
+
+// Returns true if a sorts strictly before b
+inline bool less(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
+	return compare(a, aLen, b, bLen) < 0;
+}
+
+// Returns true if a and b are equal
+inline bool equal(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
+	return aLen == bLen && mismatch(a, b, aLen) == aLen;
+}
+
+} // namespace keycompare
+
+#endif
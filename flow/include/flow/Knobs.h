@@ -131,8 +131,15 @@ public:
 
 	double FAST_ALLOC_LOGGING_BYTES;
 	bool FAST_ALLOC_ALLOW_GUARD_PAGES;
+	bool FAST_ALLOC_HUGE_PAGES; // Take FastAllocator magazines from regions backed by transparent huge pages
 	double HUGE_ARENA_LOGGING_BYTES;
 	double HUGE_ARENA_LOGGING_INTERVAL;
+	// If nonzero, each thread keeps up to this many bytes of the huge arena blocks it frees for reuse, and huge blocks
+	// are rounded up to a quarter of a power of two so that they can be reused for arenas of similar sizes
+	int64_t HUGE_ARENA_POOL_BYTES;
+	// If nonzero, each thread keeps up to this many bytes of the 4k aligned buffers larger than 16KB it frees, such as
+	// Redwood pages and DiskQueue write buffers, for reuse by allocations of the same size
+	int64_t ALIGNED_BUFFER_POOL_BYTES;
 
 	double MEMORY_USAGE_CHECK_INTERVAL;
 
@@ -160,6 +167,7 @@ public:
 	double SLOWTASK_PROFILING_MAX_LOG_INTERVAL;
 	double SLOWTASK_PROFILING_LOG_BACKOFF;
 	double SLOWTASK_BLOCKED_INTERVAL;
+	double THREAD_POOL_LANE_STARVATION_TIME; // Queued thread pool work this old runs before higher priority work
 	double SATURATION_PROFILING_LOG_INTERVAL;
 	double SATURATION_PROFILING_MAX_LOG_INTERVAL;
 	double SATURATION_PROFILING_LOG_BACKOFF;
@@ -170,6 +178,7 @@ public:
 	double CONNECTION_MONITOR_IDLE_TIMEOUT;
 	double CONNECTION_MONITOR_INCOMING_IDLE_MULTIPLIER;
 	double CONNECTION_MONITOR_UNREFERENCED_CLOSE_DELAY;
+	bool CONNECTION_MONITOR_SKIP_PING_ON_TRAFFIC; // Data received since the last ping proves the peer alive
 
 	// FlowTransport
 	double CONNECTION_REJECTED_MESSAGE_DELAY;
@@ -195,12 +204,16 @@ public:
 	int TLS_HANDSHAKE_THREAD_STACKSIZE;
 	int TLS_MALLOC_ARENA_MAX;
 	int TLS_HANDSHAKE_LIMIT;
+	bool TLS_KERNEL_SEND; // Hand encryption of sent data to the kernel after the handshake, where it is supported
 
 	int NETWORK_TEST_CLIENT_COUNT;
 	int NETWORK_TEST_REPLY_SIZE;
 	int NETWORK_TEST_REQUEST_COUNT;
 	int NETWORK_TEST_REQUEST_SIZE;
 	bool NETWORK_TEST_SCRIPT_MODE;
+	std::string NETWORK_TEST_PATTERN;
+	int NETWORK_TEST_STREAM_REPLIES;
+	int NETWORK_TEST_CHURN_REQUESTS;
 
 	// Authorization
 	bool ALLOW_TOKENLESS_TENANT_ACCESS;
@@ -217,7 +230,7 @@ public:
 	int64_t SIM_PAGE_CACHE_64K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_4K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_64K;
-	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", are supported
+	std::string CACHE_EVICTION_POLICY; // "random", "lru" and "clock" are supported
 	int MAX_EVICT_ATTEMPTS;
 	double PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION;
 	double TOO_MANY_CONNECTIONS_CLOSED_RESET_DELAY;
@@ -233,16 +246,29 @@ public:
 	int ENCRYPTION_BLOCK_SIZE;
 	int MAX_DECRYPTED_BLOCKS;
 
+	// AsyncFileReadAhead
+	int64_t READ_AHEAD_MAX_BYTES; // Largest window a file read sequentially grows its read ahead to
+
 	// AsyncFileKAIO
 	int MAX_OUTSTANDING;
 	int MIN_SUBMIT;
 	double SQLITE_DISK_METRIC_LOGGING_INTERVAL;
 	double KAIO_LATENCY_LOGGING_INTERVAL;
 	double KAIO_LATENCY_SKETCH_ACCURACY;
+	int KAIO_COMMIT_MAX_OUTSTANDING; // Most commit (high priority write) I/Os outstanding at once
+	int KAIO_BACKGROUND_MAX_OUTSTANDING; // Most background (low priority) I/Os outstanding at once
+	double KAIO_STARVATION_TIME; // A class of I/O that has not launched for this long goes ahead of the others
 
 	int PAGE_WRITE_CHECKSUM_HISTORY;
 	int DISABLE_POSIX_KERNEL_AIO;
 
+	// AsyncFileIOUring
+	bool ENABLE_IO_URING;
+	int IO_URING_ENTRIES;
+	bool IO_URING_SQPOLL;
+	int IO_URING_SQPOLL_IDLE_MS;
+	int IO_URING_REGISTERED_FILES;
+
 	// AsyncFileNonDurable
 	double NON_DURABLE_MAX_WRITE_DELAY;
 	double MAX_PRIOR_MODIFICATION_DELAY;
@@ -269,10 +295,22 @@ public:
 	double SLOW_LOOP_CUTOFF;
 	double SLOW_LOOP_SAMPLING_RATE;
 	int64_t TSC_YIELD_TIME;
+	// Tasks below BACKGROUND_TASK_PRIORITY yield once the run loop has been busy for BACKGROUND_TSC_YIELD_TIME, so
+	// that the background work of one role cannot hold off the network reads of the others in the same process
+	int BACKGROUND_TASK_PRIORITY;
+	int64_t BACKGROUND_TSC_YIELD_TIME;
 	int64_t REACTOR_FLAGS;
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
+	int ACTOR_PROFILE_TRACE_COUNT; // ActorProfile events logged per system monitor interval, with -DACTOR_PROFILER=ON
+	int ACTOR_PROFILE_STATUS_COUNT; // Busiest actors added to NetworkMetrics for status
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	bool BUCKETED_READY_QUEUE_ENABLED; // Keep ready tasks in a BucketedReadyQueue instead of a heap
+	bool TIMER_WHEEL_ENABLED; // Keep timers in a TimerWheel instead of a heap
+	double TIMER_WHEEL_RESOLUTION; // The width of a tick of the TimerWheel, in seconds
+	// If nonzero, tasks scheduled from other threads go through a ThreadSafeRing of this size, a power of two, instead
+	// of a ThreadSafeQueue
+	int THREAD_READY_RING_SIZE;
 	int TASKS_PER_REACTOR_CHECK;
 
 	// Network
@@ -280,6 +318,7 @@ public:
 	int64_t PACKET_WARNING; // 2MB packet warning quietly allows for 1MB system messages
 	double TIME_OFFSET_LOGGING_INTERVAL;
 	int MAX_PACKET_SEND_BYTES;
+	int PACKET_ATTACH_MIN_BYTES; // Payloads this large are sent from their arena instead of copied into the packet; 0 never
 	int MIN_PACKET_BUFFER_BYTES;
 	int MIN_PACKET_BUFFER_FREE_BYTES;
 	int FLOW_TCP_NODELAY;
@@ -299,6 +338,7 @@ public:
 	double MAX_RUNLOOP_SLEEP_DELAY;
 	int SIM_CONNECT_ERROR_MODE;
 	double SIM_SPEEDUP_AFTER_SECONDS;
+	bool SIM_PROFILE_RUN_LOOP; // Measure the wall clock time simulation spends in tasks of each priority
 	int MAX_TRACE_LINES;
 
 	// Tracefiles
@@ -338,6 +378,10 @@ public:
 	double SECOND_REQUEST_MULTIPLIER_DECAY;
 	double SECOND_REQUEST_BUDGET_GROWTH;
 	double SECOND_REQUEST_MAX_BUDGET;
+	bool LOAD_BALANCE_HEDGING;
+	double LOAD_BALANCE_HEDGE_QUANTILE;
+	int LOAD_BALANCE_HEDGE_WINDOW;
+	double LOAD_BALANCE_HEDGE_DISTANT_MULTIPLIER;
 	double ALTERNATIVES_FAILURE_RESET_TIME;
 	double ALTERNATIVES_FAILURE_MIN_DELAY;
 	double ALTERNATIVES_FAILURE_DELAY_RATIO;
@@ -371,6 +415,8 @@ public:
 	// Encryption
 	int64_t ENCRYPT_CIPHER_KEY_CACHE_TTL;
 	int64_t ENCRYPT_KEY_REFRESH_INTERVAL;
+	// How long before a cached latest cipher key needs a refresh that its role starts fetching it in the background
+	int64_t ENCRYPT_KEY_REFRESH_AHEAD;
 	double ENCRYPT_KEY_CACHE_LOGGING_INTERVAL;
 	double ENCRYPT_KEY_CACHE_LOGGING_SKETCH_ACCURACY;
 	bool ENCRYPT_HEADER_AUTH_TOKEN_ENABLED;
@@ -0,0 +1,755 @@
+/*
+ * MetricBTree.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_METRICBTREE_H
+#define FLOW_METRICBTREE_H
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T>
+class Future;
+
+class Void;
+
+// MetricBTree<T, Metric> is a B+ tree with the same interface and semantics as IndexedSet<T, Metric> for the operations
+// below: each element has a Metric, and sumTo(), sumRange() and index() work in O(lg N) using the sums of the metrics
+// of each subtree kept in the inner nodes.
+//
+// Elements are kept in wide leaves linked in order, so a search touches a handful of nodes instead of the dozens of a
+// treap's path, and iteration is mostly sequential memory access.  Unlike IndexedSet, inserting or erasing elements
+// invalidates iterators to other elements.
+template <class T, class Metric>
+class MetricBTree {
+	static constexpr int LeafCapacity = 32;
+	static constexpr int InnerCapacity = 32;
+
+	struct Inner;
+
+	struct Node {
+		Inner* parent = nullptr;
+		int count = 0;
+		bool leaf;
+		Metric total = Metric();
+
+		explicit Node(bool leaf) : leaf(leaf) {}
+	};
+
+	struct Leaf : Node {
+		Leaf* prev = nullptr;
+		Leaf* next = nullptr;
+		T keys[LeafCapacity];
+		Metric metrics[LeafCapacity];
+
+		Leaf() : Node(true) {}
+
+		// Index of the first key not less than key
+		template <class Key>
+		int lowerBound(const Key& key) const {
+			int lo = 0, hi = this->count;
+			while (lo < hi) {
+				int mid = (lo + hi) / 2;
+				if (keys[mid] < key) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		// Index of the first key greater than key
+		template <class Key>
+		int upperBound(const Key& key) const {
+			int lo = 0, hi = this->count;
+			while (lo < hi) {
+				int mid = (lo + hi) / 2;
+				if (key < keys[mid]) {
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo;
+		}
+	};
+
+	// Child i holds the keys which are not less than keys[i] (for i > 0) and less than keys[i + 1]
+	struct Inner : Node {
+		Node* children[InnerCapacity];
+		Metric sums[InnerCapacity];
+		T keys[InnerCapacity];
+
+		Inner() : Node(false) {}
+
+		// The child to search for key
+		template <class Key>
+		int childFor(const Key& key) const {
+			int lo = 1, hi = this->count;
+			while (lo < hi) {
+				int mid = (lo + hi) / 2;
+				if (key < keys[mid]) {
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo - 1;
+		}
+
+		int slotOf(const Node* child) const {
+			int slot = 0;
+			while (children[slot] != child) {
+				++slot;
+			}
+			return slot;
+		}
+	};
+
+	template <bool isConst>
+	struct IteratorImpl {
+		std::conditional_t<isConst, const Leaf, Leaf>* leaf;
+		int pos;
+
+		explicit IteratorImpl(const IteratorImpl<!isConst>& nonConstIter)
+		  : leaf(nonConstIter.leaf), pos(nonConstIter.pos) {
+			static_assert(isConst);
+		}
+
+		explicit IteratorImpl(decltype(leaf) leaf = nullptr, int pos = 0) : leaf(leaf), pos(pos) {}
+
+		std::conditional_t<isConst, const T, T>& operator*() const { return leaf->keys[pos]; }
+		std::conditional_t<isConst, const T, T>* operator->() const { return &leaf->keys[pos]; }
+
+		void operator++() {
+			if (++pos == leaf->count) {
+				leaf = leaf->next;
+				pos = 0;
+			}
+		}
+
+		// Decrementing begin() gives end(), as in IndexedSet
+		void decrementNonEnd() {
+			if (pos > 0) {
+				--pos;
+			} else if ((leaf = leaf->prev)) {
+				pos = leaf->count - 1;
+			}
+		}
+
+		bool operator==(const IteratorImpl& r) const { return leaf == r.leaf && pos == r.pos; }
+		bool operator!=(const IteratorImpl& r) const { return !(*this == r); }
+	};
+
+public:
+	typedef T value_type;
+	typedef T key_type;
+	using iterator = IteratorImpl<false>;
+	using const_iterator = IteratorImpl<true>;
+
+	MetricBTree() = default;
+	~MetricBTree() { clear(); }
+	MetricBTree(MetricBTree&& r) noexcept { swap(r); }
+	MetricBTree& operator=(MetricBTree&& r) noexcept {
+		clear();
+		swap(r);
+		return *this;
+	}
+	MetricBTree(const MetricBTree&) = delete;
+	MetricBTree& operator=(const MetricBTree&) = delete;
+
+	const_iterator begin() const { return const_iterator(first); }
+	iterator begin() { return iterator(first); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator end() const { return const_iterator(); }
+	iterator end() { return iterator(); }
+	const_iterator cend() const { return end(); }
+
+	const_iterator lastItem() const { return last ? const_iterator(last, last->count - 1) : end(); }
+	iterator lastItem() { return last ? iterator(last, last->count - 1) : end(); }
+
+	// Returns the item before i, or end() if i is begin()
+	const_iterator previous(const_iterator i) const {
+		if (i == end()) {
+			return lastItem();
+		}
+		if (i == begin()) {
+			return end();
+		}
+		i.decrementNonEnd();
+		return i;
+	}
+	iterator previous(iterator i) {
+		if (i == end()) {
+			return lastItem();
+		}
+		if (i == begin()) {
+			return end();
+		}
+		i.decrementNonEnd();
+		return i;
+	}
+
+	bool empty() const { return !root; }
+	int size() const { return itemCount; }
+
+	void clear() {
+		destroy(root);
+		root = nullptr;
+		first = last = nullptr;
+		itemCount = 0;
+	}
+
+	void swap(MetricBTree& r) {
+		std::swap(root, r.root);
+		std::swap(first, r.first);
+		std::swap(last, r.last);
+		std::swap(itemCount, r.itemCount);
+	}
+
+	// Place data in the set with the given metric.  If an item equal to data is already in the set and
+	// replaceExisting == true, it will be overwritten (and its metric will be replaced)
+	template <class T_, class Metric_>
+	iterator insert(T_&& data, Metric_&& metric, bool replaceExisting = true) {
+		if (!root) {
+			root = first = last = new Leaf();
+		}
+		Leaf* leaf = findLeaf(data);
+		int pos = leaf->lowerBound(data);
+		if (pos < leaf->count && !(data < leaf->keys[pos])) {
+			if (replaceExisting) {
+				leaf->keys[pos] = std::forward<T_>(data);
+				Metric delta = Metric(metric) - leaf->metrics[pos];
+				leaf->metrics[pos] = std::forward<Metric_>(metric);
+				propagate(leaf, delta);
+			}
+			return iterator(leaf, pos);
+		}
+
+		if (leaf->count == LeafCapacity) {
+			Leaf* right = splitLeaf(leaf);
+			if (pos > leaf->count) {
+				pos -= leaf->count;
+				leaf = right;
+			}
+		}
+		for (int i = leaf->count; i > pos; --i) {
+			leaf->keys[i] = std::move(leaf->keys[i - 1]);
+			leaf->metrics[i] = leaf->metrics[i - 1];
+		}
+		leaf->keys[pos] = std::forward<T_>(data);
+		leaf->metrics[pos] = std::forward<Metric_>(metric);
+		++leaf->count;
+		++itemCount;
+		propagate(leaf, leaf->metrics[pos]);
+		return iterator(leaf, pos);
+	}
+
+	// Increase the metric for the given item by the given amount.  Inserts data into the set if it doesn't exist.
+	// Returns the new metric of the item.
+	template <class T_, class Metric_>
+	Metric addMetric(T_&& data, Metric_&& metric) {
+		iterator i = find(data);
+		if (i == end()) {
+			insert(std::forward<T_>(data), std::forward<Metric_>(metric));
+			return metric;
+		}
+		Leaf* leaf = i.leaf;
+		leaf->metrics[i.pos] = leaf->metrics[i.pos] + metric;
+		propagate(leaf, metric);
+		return leaf->metrics[i.pos];
+	}
+
+	// Remove the data item, if any, which is equal to key
+	template <class Key>
+	void erase(const Key& key) {
+		erase(find(key));
+	}
+
+	// Erase the indicated item.  No effect if item == end().
+	void erase(iterator item) {
+		if (item == end()) {
+			return;
+		}
+		eraseFromLeaf(item.leaf, item.pos, item.pos + 1);
+	}
+
+	// Erase all data items x for which begin<=x<end
+	template <class Key>
+	void erase(const Key& begin, const Key& end) {
+		erase(lower_bound(begin), lower_bound(end));
+	}
+
+	// Erase the items in the indicated range
+	void erase(iterator begin, iterator end) { erase(begin, end, nullptr); }
+
+	// Erase data items with a deferred (async) free process. The data structure has the items removed
+	//  synchronously with the invocation of this method so any subsequent call will see this new state.
+	template <class Key>
+	Future<Void> eraseAsync(const Key& begin, const Key& end);
+
+	// Erase data items with a deferred (async) free process. The data structure has the items removed
+	//  synchronously with the invocation of this method so any subsequent call will see this new state.
+	Future<Void> eraseAsync(iterator begin, iterator end);
+
+	// Returns the number of items equal to key (either 0 or 1)
+	template <class Key>
+	int count(const Key& key) const {
+		return find(key) != end();
+	}
+
+	// Returns x such that key==*x, or end()
+	template <class Key>
+	const_iterator find(const Key& key) const {
+		const_iterator i = lower_bound(key);
+		return i != end() && !(key < *i) ? i : end();
+	}
+	template <class Key>
+	iterator find(const Key& key) {
+		iterator i = lower_bound(key);
+		return i != end() && !(key < *i) ? i : end();
+	}
+
+	// Returns the smallest x such that *x>=key, or end()
+	template <class Key>
+	const_iterator lower_bound(const Key& key) const {
+		if (!root) {
+			return end();
+		}
+		Leaf* leaf = findLeaf(key);
+		return normalize<true>(leaf, leaf->lowerBound(key));
+	}
+	template <class Key>
+	iterator lower_bound(const Key& key) {
+		if (!root) {
+			return end();
+		}
+		Leaf* leaf = findLeaf(key);
+		return normalize<false>(leaf, leaf->lowerBound(key));
+	}
+
+	// Returns the smallest x such that *x>key, or end()
+	template <class Key>
+	const_iterator upper_bound(const Key& key) const {
+		if (!root) {
+			return end();
+		}
+		Leaf* leaf = findLeaf(key);
+		return normalize<true>(leaf, leaf->upperBound(key));
+	}
+	template <class Key>
+	iterator upper_bound(const Key& key) {
+		if (!root) {
+			return end();
+		}
+		Leaf* leaf = findLeaf(key);
+		return normalize<false>(leaf, leaf->upperBound(key));
+	}
+
+	// Returns the largest x such that *x<=key, or end()
+	template <class Key>
+	const_iterator lastLessOrEqual(const Key& key) const {
+		return previous(upper_bound(key));
+	}
+	template <class Key>
+	iterator lastLessOrEqual(const Key& key) {
+		return previous(upper_bound(key));
+	}
+
+	// Returns smallest x such that sumTo(x+1) > metric, or end()
+	template <class M>
+	const_iterator index(M const& metric) const {
+		auto [leaf, pos] = findIndex(metric);
+		return const_iterator(leaf, pos);
+	}
+	template <class M>
+	iterator index(M const& metric) {
+		auto [leaf, pos] = findIndex(metric);
+		return iterator(leaf, pos);
+	}
+
+	// Return the metric inserted with item x
+	Metric getMetric(const_iterator x) const { return x.leaf->metrics[x.pos]; }
+	Metric getMetric(iterator x) const { return x.leaf->metrics[x.pos]; }
+
+	// Return the sum of getMetric(x) for begin()<=x<to
+	Metric sumTo(const_iterator to) const {
+		if (!to.leaf) {
+			return root ? root->total : Metric();
+		}
+		Metric m = Metric();
+		for (int i = 0; i < to.pos; ++i) {
+			m = m + to.leaf->metrics[i];
+		}
+		const Node* n = to.leaf;
+		for (const Inner* p = n->parent; p; n = p, p = p->parent) {
+			for (int i = 0, slot = p->slotOf(n); i < slot; ++i) {
+				m = m + p->sums[i];
+			}
+		}
+		return m;
+	}
+	Metric sumTo(iterator to) const { return sumTo(const_iterator(to)); }
+
+	// Return the sum of getMetric(x) for begin<=x<end
+	Metric sumRange(const_iterator begin, const_iterator end) const { return sumTo(end) - sumTo(begin); }
+	Metric sumRange(iterator begin, iterator end) const { return sumTo(end) - sumTo(begin); }
+
+	// Return the sum of getMetric(x) for all x s.t. begin <= *x && *x < end
+	template <class Key>
+	Metric sumRange(const Key& begin, const Key& end) const {
+		return sumRange(lower_bound(begin), lower_bound(end));
+	}
+
+	// Return the amount of memory used per entry in the tree, assuming half full leaves
+	constexpr static int getElementBytes() { return 2 * sizeof(Leaf) / LeafCapacity; }
+
+private:
+	Node* root = nullptr;
+	Leaf* first = nullptr;
+	Leaf* last = nullptr;
+	int itemCount = 0;
+
+	static void destroy(Node* n) {
+		if (!n) {
+			return;
+		}
+		if (n->leaf) {
+			delete static_cast<Leaf*>(n);
+		} else {
+			Inner* inner = static_cast<Inner*>(n);
+			for (int i = 0; i < inner->count; ++i) {
+				destroy(inner->children[i]);
+			}
+			delete inner;
+		}
+	}
+
+	template <class Key>
+	Leaf* findLeaf(const Key& key) const {
+		Node* n = root;
+		while (!n->leaf) {
+			Inner* inner = static_cast<Inner*>(n);
+			n = inner->children[inner->childFor(key)];
+		}
+		return static_cast<Leaf*>(n);
+	}
+
+	// An iterator to position pos of leaf, moving past its end to the next leaf
+	template <bool isConst>
+	static IteratorImpl<isConst> normalize(Leaf* leaf, int pos) {
+		if (pos == leaf->count) {
+			return IteratorImpl<isConst>(leaf->next, 0);
+		}
+		return IteratorImpl<isConst>(leaf, pos);
+	}
+
+	template <class M>
+	std::pair<Leaf*, int> findIndex(const M& metric) const {
+		if (!root) {
+			return { nullptr, 0 };
+		}
+		M m = metric;
+		Node* n = root;
+		while (!n->leaf) {
+			Inner* inner = static_cast<Inner*>(n);
+			int i = 0;
+			while (i < inner->count - 1 && !(m < inner->sums[i])) {
+				m = m - inner->sums[i];
+				++i;
+			}
+			n = inner->children[i];
+		}
+		Leaf* leaf = static_cast<Leaf*>(n);
+		for (int i = 0; i < leaf->count; ++i) {
+			m = m - leaf->metrics[i];
+			if (m < M()) {
+				return { leaf, i };
+			}
+		}
+		// Only reached at the last leaf, or when earlier sums were exhausted by the metric
+		return { leaf->next, 0 };
+	}
+
+	// Adds delta to the total of n and all its ancestors
+	static void propagate(Node* n, Metric delta) {
+		n->total = n->total + delta;
+		for (Inner* p = n->parent; p; n = p, p = p->parent) {
+			int slot = p->slotOf(n);
+			p->sums[slot] = p->sums[slot] + delta;
+			p->total = p->total + delta;
+		}
+	}
+
+	// Moves the upper half of a full leaf into a new leaf after it, which is returned
+	Leaf* splitLeaf(Leaf* leaf) {
+		Leaf* right = new Leaf();
+		int keep = leaf->count / 2;
+		for (int i = keep; i < leaf->count; ++i) {
+			right->keys[i - keep] = std::move(leaf->keys[i]);
+			right->metrics[i - keep] = leaf->metrics[i];
+			right->total = right->total + leaf->metrics[i];
+			leaf->keys[i] = T();
+		}
+		right->count = leaf->count - keep;
+		leaf->count = keep;
+		leaf->total = leaf->total - right->total;
+
+		right->prev = leaf;
+		right->next = leaf->next;
+		if (leaf->next) {
+			leaf->next->prev = right;
+		} else {
+			last = right;
+		}
+		leaf->next = right;
+
+		insertChild(leaf, right, right->keys[0]);
+		return right;
+	}
+
+	// Inserts right into the parent of left, just after it, with the given separator.  left and right must hold what
+	// left held before, so the parent's total is unchanged.
+	void insertChild(Node* left, Node* right, const T& separator) {
+		Inner* parent = left->parent;
+		if (!parent) {
+			Inner* newRoot = new Inner();
+			newRoot->children[0] = left;
+			newRoot->children[1] = right;
+			newRoot->sums[0] = left->total;
+			newRoot->sums[1] = right->total;
+			newRoot->keys[1] = separator;
+			newRoot->count = 2;
+			newRoot->total = left->total + right->total;
+			left->parent = right->parent = newRoot;
+			root = newRoot;
+			return;
+		}
+
+		// Until right is inserted, left's slot still holds the total of both, so a split of the parent leaves every
+		// total above it correct
+		int slot = parent->slotOf(left);
+		if (parent->count == InnerCapacity) {
+			Inner* parentRight = splitInner(parent);
+			if (slot >= parent->count) {
+				slot -= parent->count;
+				parent = parentRight;
+			}
+		}
+		for (int i = parent->count; i > slot + 1; --i) {
+			parent->children[i] = parent->children[i - 1];
+			parent->sums[i] = parent->sums[i - 1];
+			parent->keys[i] = std::move(parent->keys[i - 1]);
+		}
+		parent->children[slot + 1] = right;
+		parent->sums[slot] = left->total;
+		parent->sums[slot + 1] = right->total;
+		parent->keys[slot + 1] = separator;
+		++parent->count;
+		right->parent = parent;
+	}
+
+	// Moves the upper half of a full inner node into a new inner node after it, which is returned
+	Inner* splitInner(Inner* inner) {
+		Inner* right = new Inner();
+		int keep = inner->count / 2;
+		for (int i = keep; i < inner->count; ++i) {
+			right->children[i - keep] = inner->children[i];
+			right->sums[i - keep] = inner->sums[i];
+			right->keys[i - keep] = std::move(inner->keys[i]);
+			inner->keys[i] = T();
+			right->children[i - keep]->parent = right;
+		}
+		right->count = inner->count - keep;
+		inner->count = keep;
+		recomputeTotal(inner);
+		recomputeTotal(right);
+		T separator = right->keys[0];
+		right->keys[0] = T();
+		insertChild(inner, right, separator);
+		return right;
+	}
+
+	static void recomputeTotal(Inner* inner) {
+		Metric m = Metric();
+		for (int i = 0; i < inner->count; ++i) {
+			m = m + inner->sums[i];
+		}
+		inner->total = m;
+	}
+
+	// Erases the items in [begin, end), moving them to toFree rather than destroying them if it is given
+	void erase(iterator begin, iterator end, std::vector<T>* toFree) {
+		if (begin == end || begin == this->end()) {
+			return;
+		}
+		// Erasing restructures the tree, so each step finds its place again by key
+		T beginKey = *begin;
+		bool toEnd = end == this->end();
+		T endKey = toEnd ? T() : *end;
+		while (true) {
+			iterator i = lower_bound(beginKey);
+			if (i == this->end() || (!toEnd && !(*i < endKey))) {
+				break;
+			}
+			eraseFromLeaf(i.leaf, i.pos, toEnd ? i.leaf->count : i.leaf->lowerBound(endKey), toFree);
+		}
+	}
+
+	// Erases positions [from, to) of leaf, then merges or removes the leaf if it has become small
+	void eraseFromLeaf(Leaf* leaf, int from, int to, std::vector<T>* toFree = nullptr) {
+		Metric removed = Metric();
+		for (int i = from; i < to; ++i) {
+			removed = removed + leaf->metrics[i];
+			if (toFree) {
+				toFree->push_back(std::move(leaf->keys[i]));
+			}
+		}
+		int n = to - from;
+		for (int i = from; i + n < leaf->count; ++i) {
+			leaf->keys[i] = std::move(leaf->keys[i + n]);
+			leaf->metrics[i] = leaf->metrics[i + n];
+		}
+		for (int i = leaf->count - n; i < leaf->count; ++i) {
+			leaf->keys[i] = T();
+		}
+		leaf->count -= n;
+		itemCount -= n;
+		propagate(leaf, Metric() - removed);
+		rebalance(leaf);
+	}
+
+	// Removes an empty node, or merges a node less than a quarter full into an adjacent sibling when they fit in three
+	// quarters of a node, so that heavy erasing does not leave a tree of nearly empty nodes
+	void rebalance(Node* n) {
+		Inner* parent = n->parent;
+		if (n->count == 0) {
+			if (!parent) {
+				clear();
+				return;
+			}
+			removeChild(parent, parent->slotOf(n));
+			return;
+		}
+		if (!parent) {
+			// Collapse a root with a single child
+			if (!n->leaf && n->count == 1) {
+				Inner* inner = static_cast<Inner*>(n);
+				root = inner->children[0];
+				root->parent = nullptr;
+				delete inner;
+			}
+			return;
+		}
+		int capacity = n->leaf ? LeafCapacity : InnerCapacity;
+		if (n->count >= capacity / 4) {
+			return;
+		}
+		int slot = parent->slotOf(n);
+		int leftSlot = slot > 0 ? slot - 1 : slot;
+		if (leftSlot + 1 >= parent->count) {
+			return;
+		}
+		Node* left = parent->children[leftSlot];
+		Node* right = parent->children[leftSlot + 1];
+		if (left->count + right->count > capacity * 3 / 4) {
+			return;
+		}
+		if (n->leaf) {
+			mergeLeaves(static_cast<Leaf*>(left), static_cast<Leaf*>(right));
+		} else {
+			mergeInners(static_cast<Inner*>(left), static_cast<Inner*>(right), parent->keys[leftSlot + 1]);
+		}
+		parent->sums[leftSlot] = left->total;
+		// right is empty now, so removing it leaves the parent's total unchanged
+		parent->sums[leftSlot + 1] = Metric();
+		removeChild(parent, leftSlot + 1);
+	}
+
+	void mergeLeaves(Leaf* left, Leaf* right) {
+		for (int i = 0; i < right->count; ++i) {
+			left->keys[left->count + i] = std::move(right->keys[i]);
+			left->metrics[left->count + i] = right->metrics[i];
+		}
+		left->count += right->count;
+		left->total = left->total + right->total;
+		right->count = 0;
+		right->total = Metric();
+	}
+
+	void mergeInners(Inner* left, Inner* right, const T& separator) {
+		for (int i = 0; i < right->count; ++i) {
+			left->children[left->count + i] = right->children[i];
+			left->sums[left->count + i] = right->sums[i];
+			left->keys[left->count + i] = i == 0 ? separator : std::move(right->keys[i]);
+			left->children[left->count + i]->parent = left;
+		}
+		left->count += right->count;
+		left->total = left->total + right->total;
+		right->count = 0;
+		right->total = Metric();
+	}
+
+	// Removes and frees the empty child at slot of parent
+	void removeChild(Inner* parent, int slot) {
+		Node* child = parent->children[slot];
+		if (child->leaf) {
+			Leaf* leaf = static_cast<Leaf*>(child);
+			(leaf->prev ? leaf->prev->next : first) = leaf->next;
+			(leaf->next ? leaf->next->prev : last) = leaf->prev;
+			delete leaf;
+		} else {
+			delete static_cast<Inner*>(child);
+		}
+		for (int i = slot; i + 1 < parent->count; ++i) {
+			parent->children[i] = parent->children[i + 1];
+			parent->sums[i] = parent->sums[i + 1];
+			parent->keys[i] = std::move(parent->keys[i + 1]);
+		}
+		--parent->count;
+		parent->keys[parent->count] = T();
+		// The first child has no lower bound
+		parent->keys[0] = T();
+		rebalance(parent);
+	}
+};
+
+#include "flow/flow.h"
+#include "flow/IndexedSet.actor.h"
+
+template <class T, class Metric>
+template <class Key>
+Future<Void> MetricBTree<T, Metric>::eraseAsync(const Key& begin, const Key& end) {
+	return eraseAsync(lower_bound(begin), lower_bound(end));
+}
+
+template <class T, class Metric>
+Future<Void> MetricBTree<T, Metric>::eraseAsync(typename MetricBTree<T, Metric>::iterator begin,
+                                                typename MetricBTree<T, Metric>::iterator end) {
+	std::vector<T> toFree;
+	erase(begin, end, &toFree);
+
+	return uncancellable(ISFreeItems(std::move(toFree)));
+}
+
+#endif
@@ -223,11 +223,20 @@ class ObjectWriter {
 
 		uint8_t* allocate(size_t s) { return allocator(s); }
 
+		static constexpr bool can_attach = true;
+
+		bool attach(uint8_t* out, const uint8_t* data, size_t size) {
+			return ar->customAttach != nullptr && ar->customAttach(out, data, size, ar->customAllocatorContext);
+		}
+
 		SaveContext& context() { return *this; }
 	};
 
 public:
 	typedef uint8_t* (*CustomAllocatorFunc_t)(const size_t, void*);
+	// Offered each blob written into the memory from the custom allocator: where it belongs, its bytes and their length.
+	// Returning true leaves out unwritten, and makes the callee responsible for sending the bytes in its place.
+	typedef bool (*CustomAttachFunc_t)(uint8_t*, const uint8_t*, size_t, void*);
 
 	template <class VersionOptions>
 	explicit ObjectWriter(VersionOptions vo) : customAllocator(nullptr), customAllocatorContext(nullptr) {
@@ -243,6 +252,15 @@ public:
 		vo.write(*this);
 	}
 
+	template <class VersionOptions>
+	explicit ObjectWriter(CustomAllocatorFunc_t customAllocator_,
+	                      CustomAttachFunc_t customAttach_,
+	                      void* customAllocatorContext_,
+	                      VersionOptions vo)
+	  : customAllocator(customAllocator_), customAttach(customAttach_), customAllocatorContext(customAllocatorContext_) {
+		vo.write(*this);
+	}
+
 	template <class... Items>
 	void serialize(FileIdentifier file_identifier, Items const&... items) {
 		ASSERT(data == nullptr); // object serializer can only serialize one object
@@ -280,6 +298,7 @@ public:
 private:
 	Arena arena;
 	CustomAllocatorFunc_t customAllocator = nullptr;
+	CustomAttachFunc_t customAttach = nullptr;
 	void* customAllocatorContext = nullptr;
 	uint8_t* data = nullptr;
 	int size = 0;
@@ -37,6 +37,23 @@ struct is_fb_function_t<T, typename std::enable_if<T::is_fb_visitor>::type> : st
 template <class T>
 constexpr bool is_fb_function = is_fb_function_t<T>::value;
 
+template <class T, typename = void>
+struct can_attach_t : std::false_type {};
+
+template <class T>
+struct can_attach_t<T, typename std::enable_if<T::can_attach>::type> : std::true_type {};
+
+// Offers a save context the size bytes at data that belong at out, for it to send from where they are. Returns false
+// if the context did not take them, and the caller must copy them to out.
+template <class Context>
+bool tryAttach(Context& context, uint8_t* out, const uint8_t* data, size_t size) {
+	if constexpr (can_attach_t<Context>::value) {
+		return context.attach(out, data, size);
+	} else {
+		return false;
+	}
+}
+
 template <class... Ts>
 struct pack {};
 
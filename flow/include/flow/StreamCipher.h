@@ -86,6 +86,8 @@ class EncryptionStreamCipher final : NonCopyable, public ReferenceCounted<Encryp
 
 public:
 	EncryptionStreamCipher(const StreamCipherKey* key, const StreamCipher::IV& iv);
+	// Starts a new stream with the given IV, keeping the expanded key
+	void reset(const StreamCipher::IV& iv);
 	StringRef encrypt(unsigned char const* plaintext, int len, Arena&);
 	StringRef finish(Arena&);
 };
@@ -95,6 +97,8 @@ class DecryptionStreamCipher final : NonCopyable, public ReferenceCounted<Decryp
 
 public:
 	DecryptionStreamCipher(const StreamCipherKey* key, const StreamCipher::IV& iv);
+	// Starts a new stream with the given IV, keeping the expanded key
+	void reset(const StreamCipher::IV& iv);
 	StringRef decrypt(unsigned char const* ciphertext, int len, Arena&);
 	StringRef finish(Arena&);
 };
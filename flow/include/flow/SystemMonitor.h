@@ -71,6 +71,7 @@ struct NetworkData {
 	int64_t countTasks;
 	int64_t countYields;
 	int64_t countYieldBigStack;
+	int64_t countBackgroundYields;
 	int64_t countYieldCalls;
 	int64_t countASIOEvents;
 	int64_t countYieldCallsTrue;
@@ -93,6 +94,7 @@ struct NetworkData {
 	int64_t countConnClosedWithError;
 	int64_t countConnClosedWithoutError;
 	int64_t countTLSPolicyFailures;
+	int64_t countKernelTLSConnections;
 	double countLaunchTime;
 	double countReactTime;
 
@@ -113,6 +115,7 @@ struct NetworkData {
 		countTasks = Int64Metric::getValueOrDefault("Net2.CountTasks"_sr);
 		countYields = Int64Metric::getValueOrDefault("Net2.CountYields"_sr);
 		countYieldBigStack = Int64Metric::getValueOrDefault("Net2.CountYieldBigStack"_sr);
+		countBackgroundYields = Int64Metric::getValueOrDefault("Net2.CountBackgroundYields"_sr);
 		countYieldCalls = Int64Metric::getValueOrDefault("Net2.CountYieldCalls"_sr);
 		countASIOEvents = Int64Metric::getValueOrDefault("Net2.CountASIOEvents"_sr);
 		countYieldCallsTrue = Int64Metric::getValueOrDefault("Net2.CountYieldCallsTrue"_sr);
@@ -121,6 +124,7 @@ struct NetworkData {
 		countConnClosedWithError = Int64Metric::getValueOrDefault("Net2.CountConnClosedWithError"_sr);
 		countConnClosedWithoutError = Int64Metric::getValueOrDefault("Net2.CountConnClosedWithoutError"_sr);
 		countTLSPolicyFailures = Int64Metric::getValueOrDefault("Net2.CountTLSPolicyFailures"_sr);
+		countKernelTLSConnections = Int64Metric::getValueOrDefault("Net2.CountKernelTLSConnections"_sr);
 		countLaunchTime = DoubleMetric::getValueOrDefault("Net2.CountLaunchTime"_sr);
 		countReactTime = DoubleMetric::getValueOrDefault("Net2.CountReactTime"_sr);
 		countFileLogicalWrites = Int64Metric::getValueOrDefault("AsyncFile.CountLogicalWrites"_sr);
@@ -22,24 +22,40 @@
 #define FLOW_TASK_QUEUE_H
 #pragma once
 
+#include <memory>
 #include <queue>
 #include <vector>
+#include "flow/BucketedReadyQueue.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
 #include "flow/ThreadSafeQueue.h"
+#include "flow/ThreadSafeRing.h"
+#include "flow/TimerWheel.h"
 
 template <typename Task>
 // A queue of ordered tasks, both ready to execute, and delayed for later execution.
 // All functions must be called on the main thread, except for addReadyThreadSafe() which can be called from any thread.
 class TaskQueue {
 public:
-	TaskQueue() : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
+	TaskQueue()
+	  : tasksIssued(0), useBucketedReadyQueue(FLOW_KNOBS->BUCKETED_READY_QUEUE_ENABLED),
+	    ready(useBucketedReadyQueue ? 0 : FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE),
+	    useTimerWheel(FLOW_KNOBS->TIMER_WHEEL_ENABLED), timerWheel(FLOW_KNOBS->TIMER_WHEEL_RESOLUTION) {
+		if (FLOW_KNOBS->THREAD_READY_RING_SIZE > 0) {
+			threadReadyRing = std::make_unique<ThreadSafeRing<std::pair<TaskPriority, Task*>>>(
+			    FLOW_KNOBS->THREAD_READY_RING_SIZE);
+		}
+	}
 
 	// Add a task that is ready to be executed.
-	void addReady(TaskPriority taskId, Task* t) { this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
+	void addReady(TaskPriority taskId, Task* t) { pushReady(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
 	// Add a task to be executed at a given future time instant (a "timer").
 	void addTimer(double at, TaskPriority taskId, Task* t) {
-		this->timers.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
+		if (useTimerWheel) {
+			this->timerWheel.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
+		} else {
+			this->timers.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
+		}
 	}
 	// Add a task that is ready to be executed, potentially called from a thread that is different from main.
 	// Returns true iff the main thread need to be woken up to execute this task.
@@ -47,6 +63,8 @@ public:
 		if (isMainThread) {
 			processThreadReady();
 			addReady(taskID, t);
+		} else if (threadReadyRing) {
+			return threadReadyRing->push(std::make_pair(taskID, t));
 		} else {
 			if (threadReady.push(std::make_pair(taskID, t)))
 				return true;
@@ -55,38 +73,61 @@ public:
 	}
 	// Returns true if the there are no tasks that are ready to be executed.
 	bool canSleep() {
-		bool b = ready.empty();
+		bool b = !hasReadyTask();
 		if (b) {
-			b = threadReady.canSleep();
+			b = threadReadyRing ? threadReadyRing->canSleep() : threadReady.canSleep();
 			if (!b)
 				++countCantSleep;
 		} else
 			++countWontSleep;
 		return b;
 	}
-	// Returns a time interval a caller should sleep from now until the next timer.
+	// Returns a time interval a caller should sleep from now until the next timer. With the timer wheel it can be
+	// shorter, since the wheel only knows the earliest deadline to within the slot it is in.
 	double getSleepTime(double now) const {
+		if (useTimerWheel) {
+			return timerWheel.empty() ? 0 : timerWheel.nextDeadline() - now;
+		}
 		if (!timers.empty()) {
 			return timers.top().at - now;
 		}
 		return 0;
 	}
 
-	// Moves all timers that are scheduled to be executed at or before now to the ready queue.
+	// Moves all timers that are scheduled to be executed at or before now to the ready queue. Timers that become ready
+	// together run in the order of their priority, whether they are kept in the heap or the timer wheel.
 	void processReadyTimers(double now) {
 		[[maybe_unused]] int numTimers = 0;
+		if (useTimerWheel) {
+			timerWheel.advance(now + INetwork::TIME_EPS);
+			while (timerWheel.hasDue(now + INetwork::TIME_EPS)) {
+				++numTimers;
+				++countTimers;
+				pushReady(timerWheel.top());
+				timerWheel.pop();
+			}
+		}
 		while (!timers.empty() && timers.top().at <= now + INetwork::TIME_EPS) {
 			++numTimers;
 			++countTimers;
-			ready.push(timers.top());
+			pushReady(timers.top());
 			timers.pop();
 		}
 		FDB_TRACE_PROBE(run_loop_ready_timers, numTimers);
 	}
 
-	// Moves all tasks scheduled from a different thread to the ready queue.
+	// Moves all tasks scheduled from a different thread to the ready queue. With the ring, it moves at most one ring's
+	// worth, so that producers that keep it full cannot hold up the run loop.
 	void processThreadReady() {
 		[[maybe_unused]] int numReady = 0;
+		if (threadReadyRing) {
+			numReady = threadReadyRing->drain(
+			    [this](std::pair<TaskPriority, Task*>&& t) {
+				    ASSERT(t.second != nullptr);
+				    addReady(t.first, t.second);
+			    },
+			    threadReadyRing->capacity());
+		}
 		while (true) {
 			Optional<std::pair<TaskPriority, Task*>> t = threadReady.pop();
 			if (!t.present())
@@ -98,12 +139,18 @@ public:
 		FDB_TRACE_PROBE(run_loop_thread_ready, numReady);
 	}
 
-	bool hasReadyTask() const { return !ready.empty(); }
-	size_t getNumReadyTasks() const { return ready.size(); }
-	TaskPriority getReadyTaskID() const { return ready.top().taskID; }
-	int64_t getReadyTaskPriority() const { return ready.top().priority; }
-	Task* getReadyTask() const { return ready.top().task; }
-	void popReadyTask() { ready.pop(); }
+	bool hasReadyTask() const { return useBucketedReadyQueue ? !bucketedReady.empty() : !ready.empty(); }
+	size_t getNumReadyTasks() const { return useBucketedReadyQueue ? bucketedReady.size() : ready.size(); }
+	TaskPriority getReadyTaskID() const { return readyTop().taskID; }
+	int64_t getReadyTaskPriority() const { return readyTop().priority; }
+	Task* getReadyTask() const { return readyTop().task; }
+	void popReadyTask() {
+		if (useBucketedReadyQueue) {
+			bucketedReady.pop();
+		} else {
+			ready.pop();
+		}
+	}
 
 	void initMetrics() {
 		countTimers.init("Net2.CountTimers"_sr);
@@ -114,8 +161,10 @@ public:
 	void clear() {
 		decltype(ready) _1;
 		ready.swap(_1);
+		bucketedReady.clear();
 		decltype(timers) _2;
 		timers.swap(_2);
+		timerWheel.clear();
 	}
 
 private:
@@ -148,10 +197,27 @@ private:
 	int64_t getFIFOPriority(TaskPriority taskId) { return (int64_t(taskId) << 32) - (++tasksIssued); }
 	uint64_t tasksIssued;
 
+	void pushReady(OrderedTask const& t) {
+		if (useBucketedReadyQueue) {
+			bucketedReady.push(t);
+		} else {
+			ready.push(t);
+		}
+	}
+	OrderedTask const& readyTop() const { return useBucketedReadyQueue ? bucketedReady.top() : ready.top(); }
+
+	bool useBucketedReadyQueue;
 	ReadyQueue<OrderedTask> ready;
+	// Replaces ready when FLOW_KNOBS->BUCKETED_READY_QUEUE_ENABLED is set. Tasks of the same priority then run in the
+	// order they became ready, rather than the order they were scheduled in.
+	BucketedReadyQueue<OrderedTask> bucketedReady;
 	ThreadSafeQueue<std::pair<TaskPriority, Task*>> threadReady;
+	// Replaces threadReady when FLOW_KNOBS->THREAD_READY_RING_SIZE is set
+	std::unique_ptr<ThreadSafeRing<std::pair<TaskPriority, Task*>>> threadReadyRing;
 
 	std::priority_queue<DelayedTask, std::vector<DelayedTask>> timers;
+	bool useTimerWheel;
+	TimerWheel<DelayedTask> timerWheel;
 
 	Int64MetricHandle countTimers;
 	Int64MetricHandle countCantSleep;
@@ -0,0 +1,156 @@
+/*
+ * ThreadSafeRing.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_THREAD_SAFE_RING_H
+#define FLOW_THREAD_SAFE_RING_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "flow/Arena.h"
+#include "flow/Error.h"
+#include "flow/ThreadPrimitives.h"
+
+// ThreadSafeRing<T> is a bounded multi-producer, single-consumer queue, kept in a ring of preallocated cells. Unlike
+// ThreadSafeQueue it does not allocate a node per push, and the consumer takes a batch of items in one call.
+//
+// Each cell holds a sequence number that says whether it is free for the producer that claimed its position or holds
+// an item for the consumer, as in Dmitry Vyukov's bounded queue at
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue. Producers claim positions with a
+// compare and swap on a shared index; the consumer's index is only touched by the consumer. The two indices are on
+// separate cache lines, so producers and the consumer do not invalidate each other's lines on every operation.
+//
+// canSleep() and the return value of push() work as they do for ThreadSafeQueue: after canSleep() returns true, the
+// next push() returns true and its caller must wake the consumer.
+template <class T>
+class ThreadSafeRing : NonCopyable {
+public:
+	// capacity must be a power of two
+	explicit ThreadSafeRing(size_t capacity) : mask(capacity - 1), cells(new Cell[capacity]) {
+		ASSERT(capacity >= 2 && (capacity & mask) == 0);
+		for (size_t i = 0; i < capacity; i++) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	size_t capacity() const { return mask + 1; }
+
+	// Adds data, unless the ring is full. Returns false if it was full, and otherwise sets wake to whether the consumer
+	// may be sleeping and should be woken.
+	template <class U>
+	bool tryPush(U&& data, bool& wake) {
+		uint64_t pos = enqueuePos.value.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &cells[pos & mask];
+			uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+			int64_t diff = static_cast<int64_t>(sequence - pos);
+			if (diff == 0) {
+				if (enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				// The consumer has not taken the item a full ring ago yet
+				return false;
+			} else {
+				pos = enqueuePos.value.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = std::forward<U>(data);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+
+		// Pairs with the fence in canSleep(): either the consumer sees this item, or this sees that it went to sleep
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		wake = sleeping.value.load(std::memory_order_relaxed) && sleeping.value.exchange(false);
+		return true;
+	}
+
+	// Adds data, waiting for the consumer to make room if the ring is full, so that the items of one producer are
+	// always taken in the order they were pushed. If push() returns true, the consumer may be sleeping and should be
+	// woken.
+	template <class U>
+	bool push(U&& data) {
+		bool wake = false;
+		while (!tryPush(std::forward<U>(data), wake)) {
+			std::this_thread::yield();
+		}
+		return wake;
+	}
+
+	///////////// The below functions may only be called by a single, consumer thread //////////////////
+
+	// If canSleep returns true, then the ring is empty and the next push() will return true
+	bool canSleep() {
+		if (hasNext()) {
+			return false;
+		}
+		sleeping.value.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (hasNext()) {
+			// There is no need for a producer to wake us, since we will take what it pushed
+			sleeping.value.store(false, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	// Calls f on each item in the order they were pushed, stopping after maxItems or when the ring is empty. Returns
+	// the number of items taken.
+	template <class F>
+	size_t drain(F&& f, size_t maxItems) {
+		size_t count = 0;
+		while (count < maxItems && hasNext()) {
+			Cell& cell = cells[dequeuePos.value & mask];
+			T data = std::move(cell.data);
+			// Frees the cell for the producer that claims the position one ring ahead
+			cell.sequence.store(dequeuePos.value + mask + 1, std::memory_order_release);
+			++dequeuePos.value;
+			++count;
+			f(std::move(data));
+		}
+		return count;
+	}
+
+private:
+	struct Cell {
+		std::atomic<uint64_t> sequence;
+		T data;
+	};
+
+	template <class V>
+	struct alignas(MAX_CACHE_LINE_SIZE) Padded {
+		V value{};
+	};
+
+	bool hasNext() const {
+		return cells[dequeuePos.value & mask].sequence.load(std::memory_order_acquire) == dequeuePos.value + 1;
+	}
+
+	const uint64_t mask;
+	std::unique_ptr<Cell[]> cells;
+	Padded<std::atomic<uint64_t>> enqueuePos;
+	Padded<std::atomic<bool>> sleeping;
+	Padded<uint64_t> dequeuePos;
+};
+
+#endif /* FLOW_THREAD_SAFE_RING_H */
@@ -0,0 +1,228 @@
+/*
+ * TimerWheel.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_TIMER_WHEEL_H
+#define FLOW_TIMER_WHEEL_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+// A hierarchical timing wheel of tasks with a deadline T::at, in seconds. T is ordered as for a std::priority_queue
+// that pops the earliest deadline first.
+//
+// Deadlines are grouped into ticks of the given resolution. Each level of the wheel has one slot per tick, or per span
+// of ticks of the level below, so a task is added in constant time and moves down at most once per level before it is
+// due. The tasks of ticks the wheel has advanced past are kept in a heap, so they come out in deadline order and a
+// task is only returned once its exact deadline has passed.
+template <class T>
+class TimerWheel {
+public:
+	explicit TimerWheel(double resolution) : resolution(resolution) {}
+
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	void push(T const& t) {
+		++count;
+		place(t);
+	}
+
+	// Moves the tasks with a deadline at or before until into the heap of due tasks. until must not decrease between
+	// calls.
+	void advance(double until) {
+		int64_t target = tickOf(until);
+		if (!started) {
+			started = true;
+			current = target;
+			placeFar();
+			return;
+		}
+		while (current < target) {
+			int level = 0;
+			while (level < levels && levelSizes[level] == 0) {
+				++level;
+			}
+			if (level == levels) {
+				// The wheel is empty, and the tasks past its range only have to be placed again if it moved past the
+				// range of the top level
+				bool pastTopLevel = (target >> (slotBits * levels)) != (current >> (slotBits * levels));
+				current = target;
+				if (pastTopLevel) {
+					placeFar();
+				}
+				break;
+			}
+			// The levels below are empty, so skip to the next slot of this level that has tasks, or to the end of its
+			// span
+			int shift = slotBits * level;
+			int64_t slot = ((current >> shift) & slotMask) + 1;
+			while (slot < slotsPerLevel && wheel[level][slot].empty()) {
+				++slot;
+			}
+			int64_t spanStart = (current >> (shift + slotBits)) << (shift + slotBits);
+			current = std::min(target, spanStart + (slot << shift));
+			if ((current & slotMask) == 0) {
+				cascade();
+			}
+			auto& tasks = wheel[0][current & slotMask];
+			for (auto const& t : tasks) {
+				due.push(t);
+			}
+			levelSizes[0] -= tasks.size();
+			tasks.clear();
+		}
+	}
+
+	// True if the earliest task is due at until. advance() must have been called with at least until.
+	bool hasDue(double until) const { return !due.empty() && due.top().at <= until; }
+	T const& top() const { return due.top(); }
+	void pop() {
+		due.pop();
+		--count;
+	}
+
+	// Returns a time no later than the earliest deadline. It is the deadline itself unless the earliest task is in a
+	// slot above the lowest level, in which case it is the start of that slot. Must not be called when empty.
+	double nextDeadline() const {
+		if (!due.empty()) {
+			return due.top().at;
+		}
+		if (started) {
+			for (int level = 0; level < levels; level++) {
+				if (levelSizes[level] == 0) {
+					continue;
+				}
+				int shift = slotBits * level;
+				for (int64_t slot = ((current >> shift) & slotMask) + 1; slot < slotsPerLevel; slot++) {
+					auto const& tasks = wheel[level][slot];
+					if (tasks.empty()) {
+						continue;
+					}
+					if (level == 0) {
+						return minDeadline(tasks);
+					}
+					int64_t spanStart = (current >> (shift + slotBits)) << (shift + slotBits);
+					return (spanStart + (slot << shift)) * resolution;
+				}
+			}
+		}
+		return far.top().at;
+	}
+
+	void clear() {
+		for (auto& level : wheel) {
+			for (auto& slot : level) {
+				slot.clear();
+			}
+		}
+		levelSizes.fill(0);
+		decltype(due) _1;
+		due.swap(_1);
+		decltype(far) _2;
+		far.swap(_2);
+		count = 0;
+		started = false;
+	}
+
+private:
+	static constexpr int slotBits = 8;
+	static constexpr int64_t slotsPerLevel = int64_t(1) << slotBits;
+	static constexpr int64_t slotMask = slotsPerLevel - 1;
+	static constexpr int levels = 4;
+
+	int64_t tickOf(double at) const { return static_cast<int64_t>(std::floor(at / resolution)); }
+
+	void place(T const& t) {
+		if (!started) {
+			far.push(t);
+			return;
+		}
+		int64_t tick = tickOf(t.at);
+		if (tick <= current) {
+			due.push(t);
+			return;
+		}
+		// A task goes in the lowest level whose slots span current and the task's tick
+		for (int level = 0; level < levels; level++) {
+			int shift = slotBits * (level + 1);
+			if ((tick >> shift) == (current >> shift)) {
+				wheel[level][(tick >> (slotBits * level)) & slotMask].push_back(t);
+				++levelSizes[level];
+				return;
+			}
+		}
+		far.push(t);
+	}
+
+	// Called when current enters a new slot of level 1. Moves the tasks of the slots that current entered down, highest
+	// level first, so that no task is moved into a slot that has already been moved.
+	void cascade() {
+		int highest = 1;
+		while (highest < levels - 1 && ((current >> (slotBits * highest)) & slotMask) == 0) {
+			++highest;
+		}
+		if (highest == levels - 1 && ((current >> (slotBits * highest)) & slotMask) == 0) {
+			placeFar();
+		}
+		for (int level = highest; level >= 1; level--) {
+			std::vector<T> tasks;
+			tasks.swap(wheel[level][(current >> (slotBits * level)) & slotMask]);
+			levelSizes[level] -= tasks.size();
+			for (auto const& t : tasks) {
+				place(t);
+			}
+		}
+	}
+
+	// Places the tasks past the range of the top level that are now in its range
+	void placeFar() {
+		int shift = slotBits * levels;
+		while (!far.empty() && (tickOf(far.top().at) >> shift) <= (current >> shift)) {
+			T t = far.top();
+			far.pop();
+			place(t);
+		}
+	}
+
+	static double minDeadline(std::vector<T> const& tasks) {
+		double at = tasks.front().at;
+		for (auto const& t : tasks) {
+			at = std::min(at, t.at);
+		}
+		return at;
+	}
+
+	double resolution;
+	bool started = false;
+	int64_t current = 0; // The tick the wheel has advanced to
+	size_t count = 0;
+	std::array<std::array<std::vector<T>, slotsPerLevel>, levels> wheel;
+	std::array<size_t, levels> levelSizes{};
+	std::priority_queue<T, std::vector<T>> due;
+	// Tasks past the range of the top level, or added before the first advance()
+	std::priority_queue<T, std::vector<T>> far;
+};
+
+#endif /* FLOW_TIMER_WHEEL_H */
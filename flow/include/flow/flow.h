@@ -40,6 +40,7 @@
 #include <memory>
 #include <mutex>
 
+#include "flow/ActorProfiler.h"
 #include "flow/CodeProbe.h"
 #include "flow/Platform.h"
 #include "flow/FastAlloc.h"
@@ -386,6 +387,13 @@ struct union_like_traits<ErrorOr<T>> : std::true_type {
 	}
 };
 
+template <class T>
+struct payload_arena_traits<ErrorOr<T>> {
+	static Arena const* arena(ErrorOr<T> const& t) {
+		return t.present() ? payload_arena_traits<T>::arena(t.get()) : nullptr;
+	}
+};
+
 template <class T>
 class CachedSerialization {
 public:
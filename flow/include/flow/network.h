@@ -161,6 +161,7 @@ public:
 		enHistogram = 18,
 		enTokenCache = 19,
 		enMetrics = 20,
+		enIOUringEventFD = 21,
 		COUNT // Add new fields before this enumerator
 	};
 
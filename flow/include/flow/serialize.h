@@ -812,8 +812,11 @@ struct PacketBuffer : SendBuffer {
 private:
 	int reference_count;
 	uint32_t const size_;
+	// A PacketBuffer from attach() or slice() points at memory it does not own, which is kept alive by arena or by owner
+	Arena arena;
+	PacketBuffer* owner;
 	static constexpr size_t PACKET_BUFFER_MIN_SIZE = 16384;
-	static constexpr size_t PACKET_BUFFER_OVERHEAD = 40;
+	static constexpr size_t PACKET_BUFFER_OVERHEAD = 56;
 
 public:
 	double const enqueue_time;
@@ -821,10 +824,11 @@ public:
 	size_t size() const { return size_; }
 
 private:
-	explicit PacketBuffer(size_t size) : reference_count(1), size_(size), enqueue_time(g_network->now()) {
+	PacketBuffer(uint8_t* data, size_t size, PacketBuffer* owner)
+	  : reference_count(1), size_(size), owner(owner), enqueue_time(g_network->now()) {
 		next = nullptr;
 		bytes_written = bytes_sent = 0;
-		_data = reinterpret_cast<uint8_t*>(this + 1);
+		_data = data;
 		static_assert(sizeof(PacketBuffer) == PACKET_BUFFER_OVERHEAD);
 	}
 
@@ -832,13 +836,35 @@ public:
 	static PacketBuffer* create(size_t size = 0) {
 		size = std::max(size, PACKET_BUFFER_MIN_SIZE - PACKET_BUFFER_OVERHEAD);
 		uint8_t* mem = new uint8_t[size + PACKET_BUFFER_OVERHEAD];
-		return new (mem) PacketBuffer{ size };
+		return new (mem) PacketBuffer{ mem + PACKET_BUFFER_OVERHEAD, size, nullptr };
+	}
+	// Returns a full PacketBuffer that sends bytes from where they are, keeping arena alive until it is freed
+	static PacketBuffer* attach(StringRef bytes, Arena const& arena) {
+		uint8_t* mem = new uint8_t[PACKET_BUFFER_OVERHEAD];
+		PacketBuffer* pb = new (mem) PacketBuffer{ const_cast<uint8_t*>(bytes.begin()), (size_t)bytes.size(), nullptr };
+		pb->arena = arena;
+		pb->bytes_written = bytes.size();
+		return pb;
+	}
+	// Returns a PacketBuffer for the memory of buffer from offset begin, with the bytes up to offset end written
+	static PacketBuffer* slice(PacketBuffer* buffer, int begin, int end) {
+		ASSERT(begin <= end && end <= buffer->size());
+		buffer->addref();
+		uint8_t* mem = new uint8_t[PACKET_BUFFER_OVERHEAD];
+		PacketBuffer* pb = new (mem) PacketBuffer{ buffer->data() + begin, buffer->size() - begin, buffer };
+		pb->bytes_written = end - begin;
+		return pb;
 	}
 	PacketBuffer* nextPacketBuffer() { return static_cast<PacketBuffer*>(next); }
 	void addref() { ++reference_count; }
 	void delref() {
 		if (!--reference_count) {
+			PacketBuffer* o = owner;
+			this->~PacketBuffer();
 			delete[] reinterpret_cast<uint8_t*>(this);
+			if (o) {
+				o->delref();
+			}
 		}
 	}
 	int bytes_unwritten() const { return size_ - bytes_written; }
@@ -899,16 +925,41 @@ struct PacketWriter {
 		return result;
 	}
 
-	// This is used by MakeSerializeSource::serializePacketWriter
+	// These are used by MakeSerializeSource::serializePacketWriter
 	static uint8_t* packetWriterAlloc(const size_t size, void* self);
+	static bool packetWriterAttach(uint8_t* out, const uint8_t* data, size_t size, void* self);
+
+	// Splits the buffer around the payloads taken by packetWriterAttach(), and links buffers that send each of them from
+	// payloadArena in its place
+	void attachPayloads();
+
+	// Set while serializing a message whose StringRefs are all kept alive by this Arena. StringRefs of at least
+	// attachMinBytes are then sent from where they are instead of being copied into the packet.
+	Arena const* payloadArena = nullptr;
+	int attachMinBytes;
 
 private:
 	void serializeBytesAcrossBoundary(const void* data, int bytes);
 	void nextBuffer(size_t size = 0 /* downstream it will default to at least 4k minus some padding */);
+	void appendBuffer(PacketBuffer* next);
 	template <class, class>
 	friend class MakeSerializeSource;
 
 	void init(PacketBuffer* buf, ReliablePacket* reliable);
+
+	std::vector<std::pair<uint8_t*, StringRef>> attached; // Each payload taken by packetWriterAttach(), and where it goes
+};
+
+// Specialize payload_arena_traits for a message type whose StringRefs all point into memory kept alive by the Arena that
+// arena() returns, so that sending it can attach large payloads to the packet instead of copying them.
+template <class T>
+struct payload_arena_traits {
+	static Arena const* arena(T const&) { return nullptr; }
+};
+
+template <class T>
+struct payload_arena_traits<EnsureTable<T>> {
+	static Arena const* arena(EnsureTable<T> const& t) { return payload_arena_traits<T>::arena(t.asUnderlyingType()); }
 };
 
 struct ISerializeSource {
@@ -921,11 +972,16 @@ class MakeSerializeSource : public ISerializeSource {
 public:
 	using value_type = V;
 	void serializePacketWriter(PacketWriter& packetWriter) const override {
-		ObjectWriter objectWriter(
-		    PacketWriter::packetWriterAlloc, &packetWriter, AssumeVersion(packetWriter.protocolVersion()));
+		packetWriter.payloadArena = payload_arena_traits<V>::arena(get());
+		ObjectWriter objectWriter(PacketWriter::packetWriterAlloc,
+		                          packetWriter.payloadArena ? PacketWriter::packetWriterAttach : nullptr,
+		                          &packetWriter,
+		                          AssumeVersion(packetWriter.protocolVersion()));
 
 		// Writes directly into buffer supplied by packetWriter
 		objectWriter.serialize(get());
+		packetWriter.attachPayloads();
+		packetWriter.payloadArena = nullptr;
 	}
 	virtual value_type const& get() const = 0;
 };
@@ -130,3 +130,55 @@ TEST_CASE("flow/serialize/Downgrade/WriteNew") {
 	verifyData(writer.toStringRef(), numObjects);
 	return Void();
 }
+
+namespace {
+
+struct AttachStruct {
+	static constexpr FileIdentifier file_identifier = 5912305;
+	Arena arena;
+	StringRef small;
+	StringRef big;
+
+	template <class Archive>
+	void serialize(Archive& ar) {
+		serializer(ar, small, big, arena);
+	}
+};
+
+} // namespace
+
+template <>
+struct payload_arena_traits<AttachStruct> {
+	static Arena const* arena(AttachStruct const& s) { return &s.arena; }
+};
+
+// Verify that a payload attached to the packet, instead of copied into it, is sent as the same bytes
+TEST_CASE("flow/serialize/AttachPayloads") {
+	AttachStruct s;
+	s.small = StringRef(s.arena, "small"_sr);
+	s.big = makeString(deterministicRandom()->randomInt(1000, 100000), s.arena);
+	deterministicRandom()->randomBytes(mutateString(s.big), s.big.size());
+
+	auto protocolVersion = g_network->protocolVersion();
+	Standalone<StringRef> expected = ObjectWriter::toValue(s, AssumeVersion(protocolVersion));
+
+	PacketBuffer* first = PacketBuffer::create();
+	PacketWriter writer(first, nullptr, AssumeVersion(protocolVersion));
+	writer.attachMinBytes = 1000;
+	SerializeSource<AttachStruct>(s).serializePacketWriter(writer);
+	writer.finish();
+	ASSERT_EQ(writer.size(), expected.size());
+
+	std::string sent;
+	bool attached = false;
+	for (PacketBuffer* b = first; b;) {
+		attached = attached || b->data() == s.big.begin();
+		sent.append(reinterpret_cast<const char*>(b->data()), b->bytes_written);
+		PacketBuffer* next = b->nextPacketBuffer();
+		b->delref();
+		b = next;
+	}
+	ASSERT(attached);
+	ASSERT(StringRef(sent) == expected);
+	return Void();
+}
@@ -170,6 +170,45 @@ static void bench_sort_deltas(benchmark::State& state) {
 	state.SetBytesProcessed(static_cast<long>(state.iterations()) * targetBytes);
 }
 
+// Benchmark reading a granule made of several delta files. The main CPU cost should be decoding the files and merging
+// the files' sorted boundaries
+static void bench_merge_deltas(benchmark::State& state) {
+	int targetBytes = state.range(0);
+	int fileCount = state.range(1);
+
+	Standalone<GranuleDeltas> delta = deltaGen.getDelta(targetBytes);
+	KeyRange range = deltaGen.getRange();
+
+	Standalone<BlobGranuleChunkRef> chunk;
+	chunk.keyRange = range;
+	chunk.includedVersion = delta.back().version;
+	std::vector<Value> files;
+	int deltasPerFile = delta.size() / fileCount + 1;
+	for (int i = 0; i * deltasPerFile < delta.size(); i++) {
+		Standalone<GranuleDeltas> fileDeltas;
+		for (int j = i * deltasPerFile; j < (i + 1) * deltasPerFile && j < delta.size(); j++) {
+			fileDeltas.push_back_deep(fileDeltas.arena(), delta[j]);
+		}
+		std::string fileName = "testdelta" + std::to_string(i);
+		files.push_back(serializeChunkedDeltaFile(StringRef(fileName), fileDeltas, range, 32 * 1024, {}, {}));
+		chunk.deltaFiles.push_back(
+		    chunk.arena(),
+		    BlobFilePointerRef(
+		        chunk.arena(), fileName, 0, files.back().size(), files.back().size(), fileDeltas.back().version));
+	}
+	std::vector<StringRef> deltaData(files.begin(), files.end());
+
+	int64_t rows = 0;
+	for (auto _ : state) {
+		GranuleMaterializeStats stats;
+		RangeResult result =
+		    materializeBlobGranule(chunk, range, 0, chunk.includedVersion, Optional<StringRef>(), deltaData, stats);
+		rows += result.size();
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * targetBytes);
+	state.counters["rows"] = benchmark::Counter(rows, benchmark::Counter::kAvgIterations);
+}
+
 // Benchmark serialization for granule deltas 128KB, 512KB and 1024KB. Chunk size 32KB
 BENCHMARK(bench_serialize_deltas)
     ->Args({ 128 * 1024, 32 * 1024 })
@@ -177,4 +216,7 @@ BENCHMARK(bench_serialize_deltas)
     ->Args({ 1024 * 1024, 32 * 1024 });
 
 // Benchmark sorting for granule deltas 128KB, 512KB and 1024KB. Chunk size 32KB
-BENCHMARK(bench_sort_deltas)->Args({ 128 * 1024 })->Args({ 512 * 1024 })->Args({ 1024 * 1024 });
\ No newline at end of file
+BENCHMARK(bench_sort_deltas)->Args({ 128 * 1024 })->Args({ 512 * 1024 })->Args({ 1024 * 1024 });
+
+// Benchmark reading granule deltas 128KB, 512KB and 1024KB, split over 1, 4 and 16 delta files
+BENCHMARK(bench_merge_deltas)->ArgsProduct({ { 128 * 1024, 512 * 1024, 1024 * 1024 }, { 1, 4, 16 } });
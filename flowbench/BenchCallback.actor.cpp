@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "fdbclient/FDBTypes.h"
+#include "flow/Coroutines.h"
 #include "flow/flow.h"
 #include "flow/ThreadHelper.actor.h"
 
@@ -37,7 +38,16 @@ static Future<Void> increment(Future<Void> f, uint32_t* sum) {
 	return Void();
 }
 
-ACTOR template <size_t Size>
+// The same as increment, as a C++20 coroutine rather than an ACTOR
+template <size_t Size>
+static Future<Void> incrementCoro(Future<Void> f, uint32_t* sum) {
+	std::array<uint8_t, Size> arr;
+	co_await f;
+	benchmark::DoNotOptimize(arr);
+	++(*sum);
+}
+
+ACTOR template <size_t Size, bool Coro>
 static Future<Void> benchCallbackActor(benchmark::State* benchState) {
 	state size_t actorCount = benchState->range(0);
 	state uint32_t sum;
@@ -47,7 +57,8 @@ static Future<Void> benchCallbackActor(benchmark::State* benchState) {
 		std::vector<Future<Void>> futures;
 		futures.reserve(actorCount);
 		for (int i = 0; i < actorCount; ++i) {
-			futures.push_back(increment<Size>(trigger.getFuture(), &sum));
+			futures.push_back(Coro ? incrementCoro<Size>(trigger.getFuture(), &sum)
+			                       : increment<Size>(trigger.getFuture(), &sum));
 		}
 		trigger.send(Void());
 		wait(waitForAll(futures));
@@ -60,9 +71,17 @@ static Future<Void> benchCallbackActor(benchmark::State* benchState) {
 
 template <size_t Size>
 static void bench_callback(benchmark::State& benchState) {
-	onMainThread([&benchState]() { return benchCallbackActor<Size>(&benchState); }).blockUntilReady();
+	onMainThread([&benchState]() { return benchCallbackActor<Size, false>(&benchState); }).blockUntilReady();
+}
+
+template <size_t Size>
+static void bench_callback_coro(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchCallbackActor<Size, true>(&benchState); }).blockUntilReady();
 }
 
 BENCHMARK_TEMPLATE(bench_callback, 1)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_callback, 32)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_callback, 1024)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_callback_coro, 1)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_callback_coro, 32)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_callback_coro, 1024)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
@@ -0,0 +1,126 @@
+/*
+ * BenchConflictSet.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/zipf.h"
+#include "fdbserver/ConflictSet.h"
+
+#include <vector>
+
+enum class KeyDistribution {
+	Uniform,
+	Zipfian,
+	// Most transactions touch a small range of keys under one prefix, like a queue or counter layer
+	HotPrefix,
+};
+
+static constexpr int keySpace = 10000000;
+// Batches resolved before the generated ones are reused
+static constexpr int batchCount = 64;
+// Versions, in batches, that transactions may read behind the batch they commit in
+static constexpr int versionWindow = 50;
+
+template <KeyDistribution distribution>
+static int nextKeyIndex() {
+	if constexpr (distribution == KeyDistribution::Zipfian) {
+		return zipfian_next();
+	} else if constexpr (distribution == KeyDistribution::HotPrefix) {
+		if (deterministicRandom()->random01() < 0.8) {
+			return deterministicRandom()->randomInt(0, keySpace / 1000);
+		}
+	}
+	return deterministicRandom()->randomInt(0, keySpace);
+}
+
+// Keys share all but their last bytes, as keys built from a layer's prefix do
+static KeyRef makeKey(Arena& arena, int keyLength, int index) {
+	uint8_t* key = new (arena) uint8_t[keyLength];
+	memset(key, 'k', keyLength);
+	for (int i = keyLength - 1; i >= 0 && index > 0; i--, index /= 256) {
+		key[i] = index % 256;
+	}
+	return KeyRef(key, keyLength);
+}
+
+// Each transaction reads a short range and writes one key
+template <KeyDistribution distribution>
+static Standalone<VectorRef<CommitTransactionRef>> makeBatch(int transactions, int keyLength) {
+	Standalone<VectorRef<CommitTransactionRef>> batch;
+	for (int i = 0; i < transactions; i++) {
+		CommitTransactionRef tr;
+		int read = nextKeyIndex<distribution>();
+		tr.read_conflict_ranges.push_back(
+		    batch.arena(),
+		    KeyRangeRef(makeKey(batch.arena(), keyLength, read),
+		                makeKey(batch.arena(), keyLength, read + 1 + deterministicRandom()->randomInt(0, 10))));
+		KeyRef write = makeKey(batch.arena(), keyLength, nextKeyIndex<distribution>());
+		tr.write_conflict_ranges.push_back(batch.arena(), singleKeyRange(write, batch.arena()));
+		batch.push_back(batch.arena(), tr);
+	}
+	return batch;
+}
+
+template <KeyDistribution distribution>
+static void bench_conflict_set(benchmark::State& state) {
+	const int transactions = state.range(0);
+	const int keyLength = state.range(1);
+	if constexpr (distribution == KeyDistribution::Zipfian) {
+		zipfian_generator3(0, keySpace - 1, ZIPFIAN_CONSTANT);
+	}
+	std::vector<Standalone<VectorRef<CommitTransactionRef>>> batches;
+	for (int i = 0; i < batchCount; i++) {
+		batches.push_back(makeBatch<distribution>(transactions, keyLength));
+	}
+
+	ConflictSet* cs = newConflictSet();
+	Version version = versionWindow;
+	int64_t committed = 0;
+	std::vector<int> nonConflicting;
+	for (auto _ : state) {
+		auto& batch = batches[version % batchCount];
+		const Version oldestVersion = version - versionWindow;
+		for (auto& tr : batch) {
+			tr.read_snapshot = version - 1 - deterministicRandom()->randomInt(0, versionWindow / 2);
+		}
+		nonConflicting.clear();
+		ConflictBatch conflictBatch(cs);
+		for (const auto& tr : batch) {
+			conflictBatch.addTransaction(tr, oldestVersion);
+		}
+		conflictBatch.detectConflicts(version, oldestVersion, nonConflicting);
+		committed += nonConflicting.size();
+		version++;
+	}
+	destroyConflictSet(cs);
+
+	state.SetItemsProcessed(static_cast<long>(state.iterations() * transactions));
+	state.counters["CommitFraction"] = static_cast<double>(committed) / (state.iterations() * transactions);
+}
+
+BENCHMARK_TEMPLATE(bench_conflict_set, KeyDistribution::Uniform)
+    ->ArgsProduct({ { 100, 1000, 10000 }, { 16, 64 } })
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_conflict_set, KeyDistribution::Zipfian)
+    ->ArgsProduct({ { 100, 1000, 10000 }, { 16, 64 } })
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_conflict_set, KeyDistribution::HotPrefix)
+    ->ArgsProduct({ { 100, 1000, 10000 }, { 16, 64 } })
+    ->ReportAggregatesOnly(true);
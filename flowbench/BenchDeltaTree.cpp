@@ -0,0 +1,209 @@
+/*
+ * BenchDeltaTree.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbserver/DeltaTree.h"
+#include "flow/Arena.h"
+#include "flowbench/GlobalData.h"
+
+#include <algorithm>
+#include <vector>
+
+// A key stored in a DeltaTree2 as the length of the prefix it shares with its base and the remaining suffix, the way
+// Redwood pages store their keys. RedwoodRecordRef is private to the storage engine, so this is a minimal record with
+// the same prefix compression, leaving out values and versions.
+struct KeyRecord {
+	KeyRecord() {}
+	explicit KeyRecord(KeyRef key) : key(key) {}
+	KeyRecord(Arena& arena, const KeyRecord& toCopy) : key(arena, toCopy.key) {}
+
+	typedef KeyRecord Partial;
+
+	void updateCache(Optional<Partial> cache, Arena& arena) const {}
+
+#pragma pack(push, 1)
+	struct Delta {
+		bool prefixSource;
+		bool deleted;
+		uint16_t prefixLen;
+		uint16_t suffixLen;
+
+		uint8_t* suffix() { return (uint8_t*)(this + 1); }
+		const uint8_t* suffix() const { return (const uint8_t*)(this + 1); }
+
+		KeyRecord apply(const KeyRecord& base, Arena& arena) {
+			StringRef key = makeString(prefixLen + suffixLen, arena);
+			memcpy(mutateString(key), base.key.begin(), prefixLen);
+			memcpy(mutateString(key) + prefixLen, suffix(), suffixLen);
+			return KeyRecord(key);
+		}
+
+		KeyRecord apply(const Partial& cache) { return cache; }
+
+		KeyRecord apply(Arena& arena, const KeyRecord& base, Optional<Partial>& cache) {
+			cache = apply(base, arena);
+			return cache.get();
+		}
+
+		void setPrefixSource(bool val) { prefixSource = val; }
+		bool getPrefixSource() const { return prefixSource; }
+
+		void setDeleted(bool val) { deleted = val; }
+		bool getDeleted() const { return deleted; }
+
+		int size() const { return sizeof(Delta) + suffixLen; }
+
+		std::string toString() const {
+			return format("DELTA{prefixSource=%d deleted=%d prefixLen=%d suffix=%s}",
+			              prefixSource,
+			              deleted,
+			              prefixLen,
+			              StringRef(suffix(), suffixLen).printable().c_str());
+		}
+	};
+#pragma pack(pop)
+
+	int getCommonPrefixLen(const KeyRecord& other, int skip = 0) const {
+		return skip + commonPrefixLength(key, other.key, skip);
+	}
+
+	int compare(const KeyRecord& rhs, int skip = 0) const {
+		return key.compareSuffix(rhs.key, std::min(skip, key.size()));
+	}
+
+	bool operator==(const KeyRecord& rhs) const { return key == rhs.key; }
+	bool operator!=(const KeyRecord& rhs) const { return key != rhs.key; }
+
+	bool operator<(const KeyRecord& rhs) const { return key < rhs.key; }
+	bool operator>(const KeyRecord& rhs) const { return key > rhs.key; }
+	bool operator<=(const KeyRecord& rhs) const { return key <= rhs.key; }
+	bool operator>=(const KeyRecord& rhs) const { return key >= rhs.key; }
+
+	int deltaSize(const KeyRecord& base, int skipLen, bool worstcase) const {
+		int prefixLen = worstcase ? 0 : getCommonPrefixLen(base, skipLen);
+		return sizeof(Delta) + key.size() - prefixLen;
+	}
+
+	int writeDelta(Delta& d, const KeyRecord& base, int commonPrefix = -1) const {
+		if (commonPrefix < 0) {
+			commonPrefix = getCommonPrefixLen(base);
+		}
+		d.prefixSource = false;
+		d.deleted = false;
+		d.prefixLen = commonPrefix;
+		d.suffixLen = key.size() - commonPrefix;
+		memcpy(d.suffix(), key.begin() + commonPrefix, d.suffixLen);
+		return d.size();
+	}
+
+	KeyRef key;
+
+	std::string toString() const { return key.printable(); }
+};
+
+using KeyTree = DeltaTree2<KeyRecord>;
+
+static const KeyRecord lowerBound(""_sr);
+static const KeyRecord upperBound("\xff\xff"_sr);
+
+// A DeltaTree2 of state.range(0) distinct keys of a shape, in a buffer with just enough room for them
+struct KeyTreeData {
+	Arena arena;
+	std::vector<KeyRecord> records;
+	std::vector<uint8_t> buffer;
+
+	KeyTreeData(int count, KeyShape shape) {
+		int space = sizeof(KeyTree);
+		for (KeyRef key : getKeys(arena, count, shape)) {
+			records.emplace_back(key);
+			space += KeyTree::Node::headerSize(true) + records.back().deltaSize(lowerBound, 0, true);
+		}
+		std::sort(records.begin(), records.end());
+		buffer.resize(space);
+		build();
+	}
+
+	KeyTree* tree() { return (KeyTree*)buffer.data(); }
+	int build() {
+		return tree()->build(buffer.size(), &records.front(), &records.back() + 1, &lowerBound, &upperBound);
+	}
+	Reference<KeyTree::DecodeCache> newCache() { return makeReference<KeyTree::DecodeCache>(lowerBound, upperBound); }
+};
+
+// Builds a tree from sorted keys, as Redwood does when writing a page
+template <KeyShape shape>
+static void bench_delta_tree_build(benchmark::State& state) {
+	KeyTreeData data(state.range(0), shape);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(data.build());
+	}
+	state.SetItemsProcessed(data.records.size() * static_cast<long>(state.iterations()));
+	state.counters["TreeBytes"] = data.tree()->size();
+}
+
+// Seeks to keys in random order. With state.range(1) == 0 every seek decodes its path with a new DecodeCache, as the
+// first read of a page does; otherwise the seeks share one, as reads of a page held in the page cache do.
+template <KeyShape shape>
+static void bench_delta_tree_seek(benchmark::State& state) {
+	KeyTreeData data(state.range(0), shape);
+	std::vector<KeyRecord> records = data.records;
+	deterministicRandom()->randomShuffle(records);
+	bool shareCache = state.range(1);
+	KeyTree::Cursor shared(data.newCache(), data.tree());
+
+	int i = 0;
+	for (auto _ : state) {
+		if (shareCache) {
+			benchmark::DoNotOptimize(shared.seekGreaterThanOrEqual(records[i]));
+		} else {
+			KeyTree::Cursor c(data.newCache(), data.tree());
+			benchmark::DoNotOptimize(c.seekGreaterThanOrEqual(records[i]));
+		}
+		if (++i == records.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Decodes every key of the tree in order with a new DecodeCache
+template <KeyShape shape>
+static void bench_delta_tree_decode(benchmark::State& state) {
+	KeyTreeData data(state.range(0), shape);
+	for (auto _ : state) {
+		KeyTree::Cursor c(data.newCache(), data.tree());
+		int bytes = 0;
+		for (bool valid = c.moveFirst(); valid; valid = c.moveNext()) {
+			bytes += c.get().key.size();
+		}
+		benchmark::DoNotOptimize(bytes);
+	}
+	state.SetItemsProcessed(data.records.size() * static_cast<long>(state.iterations()));
+}
+
+#define DELTA_TREE_KEY_SHAPE_BENCHMARKS(shape)                                                                         \
+	BENCHMARK_TEMPLATE(bench_delta_tree_build, shape)->Arg(64)->Arg(512)->Arg(4096);                                   \
+	BENCHMARK_TEMPLATE(bench_delta_tree_seek, shape)->ArgsProduct({ { 64, 512, 4096 }, { 0, 1 } });                    \
+	BENCHMARK_TEMPLATE(bench_delta_tree_decode, shape)->Arg(64)->Arg(512)->Arg(4096)
+
+DELTA_TREE_KEY_SHAPE_BENCHMARKS(KeyShape::Random);
+DELTA_TREE_KEY_SHAPE_BENCHMARKS(KeyShape::SharedPrefix);
+DELTA_TREE_KEY_SHAPE_BENCHMARKS(KeyShape::Tuple);
@@ -20,9 +20,13 @@
 
 #include "benchmark/benchmark.h"
 
+#include "fdbclient/CommitTransaction.h"
 #include "flow/StreamCipher.h"
 #include "flowbench/GlobalData.h"
 
+#include <limits>
+#include <vector>
+
 static StreamCipher::IV getRandomIV() {
 	StreamCipher::IV iv;
 	deterministicRandom()->randomBytes(iv.data(), iv.size());
@@ -77,3 +81,56 @@ static void bench_decrypt(benchmark::State& state) {
 
 BENCHMARK(bench_encrypt)->Ranges({ { 1 << 12, 1 << 20 }, { 1, 1 << 12 } });
 BENCHMARK(bench_decrypt)->Ranges({ { 1 << 12, 1 << 20 }, { 1, 1 << 12 } });
+
+static Reference<BlobCipherKey> getRandomBlobCipherKey(EncryptCipherDomainId domainId) {
+	uint8_t baseCipher[AES_256_KEY_LENGTH];
+	deterministicRandom()->randomBytes(baseCipher, AES_256_KEY_LENGTH);
+	return makeReference<BlobCipherKey>(domainId,
+	                                    1,
+	                                    baseCipher,
+	                                    AES_256_KEY_LENGTH,
+	                                    deterministicRandom()->randomUInt64(),
+	                                    std::numeric_limits<int64_t>::max(),
+	                                    std::numeric_limits<int64_t>::max());
+}
+
+// Encrypts one commit batch worth of mutations the way the commit proxy does before pushing them to the TLogs, either
+// with a new cipher per mutation or with one cipher per batch that is restarted with a fresh IV for each mutation.
+template <bool ReuseCipher>
+static void bench_encrypt_mutations(benchmark::State& state) {
+	const int valueSize = state.range(0);
+	const int mutationCount = 1000;
+	std::unordered_map<EncryptCipherDomainId, Reference<BlobCipherKey>> cipherKeys;
+	cipherKeys[1] = getRandomBlobCipherKey(1);
+	cipherKeys[ENCRYPT_HEADER_DOMAIN_ID] = getRandomBlobCipherKey(ENCRYPT_HEADER_DOMAIN_ID);
+
+	Arena mutationArena;
+	std::vector<MutationRef> mutations;
+	for (int i = 0; i < mutationCount; i++) {
+		mutations.emplace_back(mutationArena, MutationRef::SetValue, getKey(32), getKey(valueSize));
+	}
+
+	for (auto _ : state) {
+		Arena arena;
+		Reference<EncryptBlobCipherAes265Ctr> cipher;
+		if constexpr (ReuseCipher) {
+			cipher = makeReference<EncryptBlobCipherAes265Ctr>(
+			    cipherKeys[1],
+			    cipherKeys[ENCRYPT_HEADER_DOMAIN_ID],
+			    getEncryptAuthTokenMode(EncryptAuthTokenMode::ENCRYPT_HEADER_AUTH_TOKEN_MODE_SINGLE),
+			    BlobCipherMetrics::TEST);
+		}
+		for (const auto& m : mutations) {
+			if constexpr (ReuseCipher) {
+				benchmark::DoNotOptimize(m.encrypt(*cipher, arena));
+			} else {
+				benchmark::DoNotOptimize(m.encrypt(cipherKeys, 1, arena, BlobCipherMetrics::TEST));
+			}
+		}
+	}
+	state.SetItemsProcessed(mutationCount * static_cast<long>(state.iterations()));
+	state.SetBytesProcessed(mutationCount * (32 + valueSize) * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_encrypt_mutations, false)->Arg(16)->Arg(128)->Arg(1024)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_encrypt_mutations, true)->Arg(16)->Arg(128)->Arg(1024)->ReportAggregatesOnly(true);
@@ -0,0 +1,134 @@
+/*
+ * BenchKeyCompare.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/Tuple.h"
+#include "flow/KeyCompare.h"
+#include "flow/DeterministicRandom.h"
+
+#include <algorithm>
+#include <vector>
+
+enum class CompareType {
+	Scalar,
+	Vectorized,
+};
+
+// The comparison previously used by the resolver's skip list
+static inline bool scalarLess(const uint8_t* a, int aLen, const uint8_t* b, int bLen) {
+	int c = memcmp(a, b, std::min(aLen, bLen));
+	if (c < 0)
+		return true;
+	if (c > 0)
+		return false;
+	return aLen < bLen;
+}
+
+template <CompareType compareType>
+static inline bool keyLess(const StringRef& a, const StringRef& b) {
+	if constexpr (compareType == CompareType::Scalar) {
+		return scalarLess(a.begin(), a.size(), b.begin(), b.size());
+	} else {
+		return keycompare::less(a.begin(), a.size(), b.begin(), b.size());
+	}
+}
+
+// Sorted tuple encoded keys shaped like a layer's index: a fixed directory prefix of the given length, a table name,
+// an integer id and a field name, so neighboring keys share most of their bytes.
+static std::vector<Standalone<StringRef>> getTupleKeys(int count, int prefixLength) {
+	DeterministicRandom random(1);
+	Standalone<StringRef> prefix = makeString(prefixLength);
+	memset(mutateString(prefix), 'p', prefixLength);
+	std::vector<Standalone<StringRef>> keys;
+	keys.reserve(count);
+	for (int i = 0; i < count; i++) {
+		keys.push_back(Tuple::makeTuple(prefix,
+		                                "users"_sr,
+		                                static_cast<int64_t>(random.randomInt(0, count * 8)),
+		                                random.coinflip() ? "email"_sr : "name"_sr)
+		                   .pack());
+	}
+	std::sort(keys.begin(), keys.end());
+	return keys;
+}
+
+// Binary searches of the sorted keys, which does the same sequence of ordered comparisons as a skip list descent
+template <CompareType compareType>
+static void bench_key_compare_search(benchmark::State& state) {
+	const int count = 1 << 14;
+	auto keys = getTupleKeys(count, state.range(0));
+	DeterministicRandom random(2);
+	std::vector<Standalone<StringRef>> probes;
+	for (int i = 0; i < 1024; i++) {
+		probes.push_back(keys[random.randomInt(0, count)]);
+	}
+
+	int64_t comparisons = 0;
+	int p = 0;
+	for (auto _ : state) {
+		const StringRef& probe = probes[p++ & 1023];
+		auto it = std::lower_bound(keys.begin(), keys.end(), probe, [&](const StringRef& a, const StringRef& b) {
+			++comparisons;
+			return keyLess<compareType>(a, b);
+		});
+		benchmark::DoNotOptimize(it);
+	}
+	state.SetItemsProcessed(comparisons);
+}
+
+// Comparisons of adjacent keys, where the first difference is near the end of the key
+template <CompareType compareType>
+static void bench_key_compare_adjacent(benchmark::State& state) {
+	const int count = 1 << 12;
+	auto keys = getTupleKeys(count, state.range(0));
+	int i = 0;
+	for (auto _ : state) {
+		int next = (i + 1) & (count - 1);
+		benchmark::DoNotOptimize(keyLess<compareType>(keys[i], keys[next]));
+		i = next;
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_key_compare_search, CompareType::Scalar)
+    ->Arg(0)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(128)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_key_compare_search, CompareType::Vectorized)
+    ->Arg(0)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(128)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_key_compare_adjacent, CompareType::Scalar)
+    ->Arg(0)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(128)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_key_compare_adjacent, CompareType::Vectorized)
+    ->Arg(0)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(128)
+    ->ReportAggregatesOnly(true);
@@ -0,0 +1,151 @@
+/*
+ * BenchMetricBTree.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/FDBTypes.h"
+#include "flow/DeterministicRandom.h"
+#include "flow/IndexedSet.h"
+#include "flow/MetricBTree.h"
+#include "flowbench/GlobalData.h"
+
+#include <vector>
+
+// The storage server's byte sample maps sampled keys to their sampled sizes, and is queried by key range for size
+// estimates and by cumulative size for split points. These benchmarks compare the treap it used to be kept in with the
+// wide node B-tree, on the operations StorageMetricSample performs.
+
+template <class Set>
+static void fillSample(Set& sample, std::vector<KeyRef> const& keys) {
+	for (int i = 0; i < keys.size(); ++i) {
+		sample.insert(Key(keys[i]), int64_t(100 + i % 1000));
+	}
+}
+
+// Inserts sampled keys in random order into an empty sample
+template <class Set>
+static void bench_metric_set_insert(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), KeyShape::Random);
+	for (auto _ : state) {
+		Set sample;
+		fillSample(sample, keys);
+		state.PauseTiming();
+		sample.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+// Looks up a sampled key and replaces its metric, as applying a set to the byte sample does
+template <class Set>
+static void bench_metric_set_update(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), KeyShape::Random);
+	Set sample;
+	fillSample(sample, keys);
+
+	int i = 0;
+	for (auto _ : state) {
+		auto it = sample.find(keys[i]);
+		int64_t delta = sample.getMetric(it);
+		sample.insert(Key(keys[i]), delta + 1);
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Sums the metric over the range between two random keys, as getEstimate() does
+template <class Set>
+static void bench_metric_set_sum_range(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), KeyShape::Random);
+	Set sample;
+	fillSample(sample, keys);
+
+	int i = 0;
+	for (auto _ : state) {
+		KeyRef a = keys[i], b = keys[(i + 1) % keys.size()];
+		benchmark::DoNotOptimize(sample.sumRange(std::min(a, b), std::max(a, b)));
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Finds the key a fixed number of bytes after a random key, as getSplitPoints() does for each split
+template <class Set>
+static void bench_metric_set_split(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), KeyShape::Random);
+	Set sample;
+	fillSample(sample, keys);
+	int64_t chunkSize = sample.sumTo(sample.end()) / 100;
+
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(sample.index(sample.sumTo(sample.lower_bound(keys[i])) + chunkSize));
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Erases the sampled keys in a range holding about 1% of the sample, as clearing a range does
+template <class Set>
+static void bench_metric_set_erase_range(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), KeyShape::Random);
+	int erased = 0;
+	for (auto _ : state) {
+		state.PauseTiming();
+		Set sample;
+		fillSample(sample, keys);
+		auto begin = sample.index(deterministicRandom()->randomInt64(0, sample.sumTo(sample.end())));
+		auto end = begin;
+		for (int n = 0; n < keys.size() / 100 && end != sample.end(); ++n) {
+			++end;
+			++erased;
+		}
+		state.ResumeTiming();
+		sample.erase(begin, end);
+		state.PauseTiming();
+		sample.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(erased);
+}
+
+#define METRIC_SET_BENCHMARKS(Set)                                                                                     \
+	BENCHMARK_TEMPLATE(bench_metric_set_insert, Set)->Range(1 << 10, 1 << 20);                                         \
+	BENCHMARK_TEMPLATE(bench_metric_set_update, Set)->Range(1 << 10, 1 << 20);                                         \
+	BENCHMARK_TEMPLATE(bench_metric_set_sum_range, Set)->Range(1 << 10, 1 << 20);                                      \
+	BENCHMARK_TEMPLATE(bench_metric_set_split, Set)->Range(1 << 10, 1 << 20);                                          \
+	BENCHMARK_TEMPLATE(bench_metric_set_erase_range, Set)->Range(1 << 10, 1 << 20)
+
+using IndexedSetSample = IndexedSet<Key, int64_t>;
+using MetricBTreeSample = MetricBTree<Key, int64_t>;
+
+METRIC_SET_BENCHMARKS(IndexedSetSample);
+METRIC_SET_BENCHMARKS(MetricBTreeSample);
@@ -0,0 +1,73 @@
+/*
+ * BenchReadyQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/BucketedReadyQueue.h"
+
+#include <queue>
+#include <vector>
+
+struct BenchReadyTask {
+	int64_t priority;
+	TaskPriority taskID;
+	bool operator<(BenchReadyTask const& rhs) const { return priority < rhs.priority; }
+};
+
+// Keeps state.range(0) tasks ready over 20 priorities. Each iteration adds a task and runs the highest priority one,
+// as the run loop does.
+template <bool useBuckets>
+static void bench_ready_queue(benchmark::State& state) {
+	const int ready = state.range(0);
+	std::vector<int> priorities;
+	for (int i = 0; i < 20; i++) {
+		priorities.push_back(static_cast<int>(TaskPriority::Low) + i * 350);
+	}
+	BucketedReadyQueue<BenchReadyTask> buckets;
+	std::priority_queue<BenchReadyTask, std::vector<BenchReadyTask>> heap;
+	int64_t issued = 0;
+	auto next = [&]() {
+		int priority = priorities[(issued * 7) % priorities.size()];
+		return BenchReadyTask{ (int64_t(priority) << 32) - (++issued), static_cast<TaskPriority>(priority) };
+	};
+	for (int i = 0; i < ready; i++) {
+		if constexpr (useBuckets) {
+			buckets.push(next());
+		} else {
+			heap.push(next());
+		}
+	}
+
+	for (auto _ : state) {
+		if constexpr (useBuckets) {
+			buckets.push(next());
+			benchmark::DoNotOptimize(buckets.top());
+			buckets.pop();
+		} else {
+			heap.push(next());
+			benchmark::DoNotOptimize(heap.top());
+			heap.pop();
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_ready_queue, false)->Range(1 << 4, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_ready_queue, true)->Range(1 << 4, 1 << 16)->ReportAggregatesOnly(true);
@@ -0,0 +1,148 @@
+/*
+ * BenchSerialization.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/CommitProxyInterface.h"
+#include "fdbclient/StorageServerInterface.h"
+#include "fdbserver/ResolverInterface.h"
+#include "fdbserver/TLogInterface.h"
+#include "flow/ThreadHelper.actor.h"
+
+// Round trips of the messages that proxies, resolvers, TLogs and storage servers spend the most time encoding, through
+// the same zero-copy readers FlowTransport uses. Each is sized by its number of mutations, rows or transactions.
+
+static StringRef randomBytes(Arena& arena, int length) {
+	return StringRef(arena, deterministicRandom()->randomAlphaNumeric(length));
+}
+
+static CommitTransactionRef makeTransaction(Arena& arena, int mutations) {
+	CommitTransactionRef tr;
+	tr.read_snapshot = 1000000;
+	for (int i = 0; i < mutations; i++) {
+		KeyRef key = randomBytes(arena, 32);
+		tr.mutations.push_back(arena, MutationRef(MutationRef::SetValue, key, randomBytes(arena, 100)));
+		tr.read_conflict_ranges.push_back(arena, singleKeyRange(key, arena));
+		tr.write_conflict_ranges.push_back(arena, singleKeyRange(key, arena));
+	}
+	return tr;
+}
+
+static CommitTransactionRequest makeCommitTransactionRequest(int mutations) {
+	CommitTransactionRequest req;
+	req.transaction = makeTransaction(req.arena, mutations);
+	return req;
+}
+
+// Some fields of the request can only be encoded by the ObjectSerializer; the transaction is the bulk of it
+static Standalone<CommitTransactionRef> makeCommitTransaction(int mutations) {
+	Arena arena;
+	CommitTransactionRef tr = makeTransaction(arena, mutations);
+	return Standalone<CommitTransactionRef>(tr, arena);
+}
+
+static GetKeyValuesReply makeGetKeyValuesReply(int rows) {
+	GetKeyValuesReply reply;
+	for (int i = 0; i < rows; i++) {
+		reply.data.push_back(reply.arena, KeyValueRef(randomBytes(reply.arena, 32), randomBytes(reply.arena, 100)));
+	}
+	reply.version = 1000000;
+	reply.more = true;
+	return reply;
+}
+
+// A peek reply carries already encoded messages; these are about the size of one tagged mutation each
+static TLogPeekReply makeTLogPeekReply(int messages) {
+	TLogPeekReply reply;
+	reply.messages = randomBytes(reply.arena, messages * 160);
+	reply.end = 1000000;
+	reply.maxKnownVersion = 1000000;
+	reply.minKnownCommittedVersion = 999000;
+	return reply;
+}
+
+static ResolveTransactionBatchRequest makeResolveTransactionBatchRequest(int transactions) {
+	ResolveTransactionBatchRequest req;
+	req.prevVersion = 999000;
+	req.version = 1000000;
+	req.lastReceivedVersion = 999000;
+	for (int i = 0; i < transactions; i++) {
+		req.transactions.push_back(req.arena, makeTransaction(req.arena, 4));
+	}
+	return req;
+}
+
+// A decoded request's reply promise would otherwise report broken_promise to the (nonexistent) sender
+template <class T>
+static void dropReply(T& msg) {
+	if constexpr (requires { msg.reply; }) {
+		msg.reply.sendError(never_reply());
+	}
+}
+
+// Reply promises are registered with FlowTransport, so the round trips run on the network thread
+template <class T>
+static void bench_object_serializer(benchmark::State& state, T (*make)(int)) {
+	onMainThread([&state, make]() {
+		T msg = make(state.range(0));
+		size_t size = 0;
+		for (auto _ : state) {
+			Standalone<StringRef> buf = ObjectWriter::toValue(msg, AssumeVersion(g_network->protocolVersion()));
+			ArenaObjectReader reader(buf.arena(), buf, AssumeVersion(g_network->protocolVersion()));
+			T decoded;
+			reader.deserialize(decoded);
+			dropReply(decoded);
+			size = buf.size();
+		}
+		state.SetBytesProcessed(static_cast<long>(state.iterations() * size));
+		state.counters["Size"] = size;
+		return Future<Void>(Void());
+	}).blockUntilReady();
+}
+
+template <class T>
+static void bench_binary_writer(benchmark::State& state, T (*make)(int)) {
+	onMainThread([&state, make]() {
+		T msg = make(state.range(0));
+		size_t size = 0;
+		for (auto _ : state) {
+			Standalone<StringRef> buf = BinaryWriter::toValue(msg, AssumeVersion(g_network->protocolVersion()));
+			ArenaReader reader(buf.arena(), buf, AssumeVersion(g_network->protocolVersion()));
+			T decoded;
+			reader >> decoded;
+			dropReply(decoded);
+			size = buf.size();
+		}
+		state.SetBytesProcessed(static_cast<long>(state.iterations() * size));
+		state.counters["Size"] = size;
+		return Future<Void>(Void());
+	}).blockUntilReady();
+}
+
+BENCHMARK_CAPTURE(bench_object_serializer, CommitTransactionRequest, &makeCommitTransactionRequest)->Range(1, 1 << 10);
+BENCHMARK_CAPTURE(bench_binary_writer, CommitTransactionRef, &makeCommitTransaction)->Range(1, 1 << 10);
+BENCHMARK_CAPTURE(bench_object_serializer, GetKeyValuesReply, &makeGetKeyValuesReply)->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(bench_binary_writer, GetKeyValuesReply, &makeGetKeyValuesReply)->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(bench_object_serializer, TLogPeekReply, &makeTLogPeekReply)->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(bench_binary_writer, TLogPeekReply, &makeTLogPeekReply)->Range(1, 1 << 12);
+BENCHMARK_CAPTURE(bench_object_serializer, ResolveTransactionBatchRequest, &makeResolveTransactionBatchRequest)
+    ->Range(1, 1 << 10);
+BENCHMARK_CAPTURE(bench_binary_writer, ResolveTransactionBatchRequest, &makeResolveTransactionBatchRequest)
+    ->Range(1, 1 << 10);
@@ -0,0 +1,84 @@
+/*
+ * BenchThreadSafeRing.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/flow.h"
+#include "flow/ThreadSafeQueue.h"
+#include "flow/ThreadSafeRing.h"
+
+#include <thread>
+#include <vector>
+
+// Each iteration has state.range(0) producer threads push state.range(1) items in total while this thread takes them,
+// as client threads do when they schedule work on the network thread.
+template <bool useRing>
+static void bench_thread_ready_queue(benchmark::State& state) {
+	const int producers = state.range(0);
+	const int64_t items = state.range(1);
+	const int64_t perProducer = items / producers;
+	ThreadSafeQueue<std::pair<int, void*>> queue;
+	ThreadSafeRing<std::pair<int, void*>> ring(1 << 12);
+
+	for (auto _ : state) {
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; p++) {
+			threads.emplace_back([&queue, &ring, p, perProducer]() {
+				for (int64_t i = 0; i < perProducer; i++) {
+					if constexpr (useRing) {
+						ring.push(std::make_pair(p, nullptr));
+					} else {
+						queue.push(std::make_pair(p, nullptr));
+					}
+				}
+			});
+		}
+		int64_t taken = 0;
+		while (taken < perProducer * producers) {
+			if constexpr (useRing) {
+				taken += ring.drain([](std::pair<int, void*>&& t) { benchmark::DoNotOptimize(t); }, ring.capacity());
+			} else {
+				while (true) {
+					Optional<std::pair<int, void*>> t = queue.pop();
+					if (!t.present()) {
+						break;
+					}
+					benchmark::DoNotOptimize(t);
+					++taken;
+				}
+			}
+		}
+		for (auto& t : threads) {
+			t.join();
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations() * perProducer * producers));
+}
+
+BENCHMARK_TEMPLATE(bench_thread_ready_queue, false)
+    ->Args({ 1, 1 << 20 })
+    ->Args({ 32, 1 << 20 })
+    ->UseRealTime()
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_thread_ready_queue, true)
+    ->Args({ 1, 1 << 20 })
+    ->Args({ 32, 1 << 20 })
+    ->UseRealTime()
+    ->ReportAggregatesOnly(true);
@@ -20,7 +20,12 @@
 
 #include "benchmark/benchmark.h"
 
+#include "flow/DeterministicRandom.h"
 #include "flow/Platform.h"
+#include "flow/TimerWheel.h"
+
+#include <queue>
+#include <vector>
 
 static void bench_timer(benchmark::State& state) {
 	for (auto _ : state) {
@@ -38,3 +43,64 @@ static void bench_timer_monotonic(benchmark::State& state) {
 
 BENCHMARK(bench_timer)->ReportAggregatesOnly(true);
 BENCHMARK(bench_timer_monotonic)->ReportAggregatesOnly(true);
+
+struct BenchTimerTask {
+	double at;
+	int64_t priority;
+	bool operator<(BenchTimerTask const& rhs) const { return at > rhs.at; }
+};
+
+// Keeps state.range(0) timers pending with deadlines up to a minute away, as a run loop with many timeouts does. Each
+// iteration adds a timer and fires the timers that are due.
+template <bool useTimerWheel>
+static void bench_timer_queue(benchmark::State& state) {
+	const int pending = state.range(0);
+	const double maxDelay = 60.0;
+	DeterministicRandom random(1);
+	std::vector<double> delays(1 << 16);
+	for (auto& delay : delays) {
+		delay = random.random01() * maxDelay;
+	}
+
+	TimerWheel<BenchTimerTask> wheel(0.001);
+	std::priority_queue<BenchTimerTask, std::vector<BenchTimerTask>> heap;
+	double now = 0;
+	wheel.advance(now);
+	int64_t i = 0;
+	for (; i < pending; i++) {
+		BenchTimerTask t{ delays[i % delays.size()], i };
+		if constexpr (useTimerWheel) {
+			wheel.push(t);
+		} else {
+			heap.push(t);
+		}
+	}
+
+	// Timers are added at the rate they fire, so that the number pending stays the same
+	const double step = maxDelay / 2 / pending;
+	int64_t fired = 0;
+	for (auto _ : state) {
+		now += step;
+		BenchTimerTask t{ now + delays[i % delays.size()], i };
+		++i;
+		if constexpr (useTimerWheel) {
+			wheel.push(t);
+			wheel.advance(now);
+			while (wheel.hasDue(now)) {
+				wheel.pop();
+				++fired;
+			}
+		} else {
+			heap.push(t);
+			while (!heap.empty() && heap.top().at <= now) {
+				heap.pop();
+				++fired;
+			}
+		}
+	}
+	benchmark::DoNotOptimize(fired);
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_timer_queue, false)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_timer_queue, true)->Range(1 << 10, 1 << 20)->ReportAggregatesOnly(true);
@@ -0,0 +1,157 @@
+/*
+ * BenchTuple.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/Tuple.h"
+
+static std::vector<int64_t> makeInts(int count) {
+	std::vector<int64_t> ints;
+	for (int i = 0; i < count; i++) {
+		// Spread the values over every encoded length
+		ints.push_back(deterministicRandom()->randomInt64(std::numeric_limits<int64_t>::min(), 0) >> (i % 64));
+	}
+	return ints;
+}
+
+// Every nullEvery-th byte of each string is a null, which the encoding escapes; 0 means no nulls
+static Tuple makeStringTuple(int elements, int length, int nullEvery) {
+	Tuple t;
+	for (int i = 0; i < elements; i++) {
+		std::string s = deterministicRandom()->randomAlphaNumeric(length);
+		for (int j = nullEvery - 1; nullEvery && j < length; j += nullEvery) {
+			s[j] = '\0';
+		}
+		t.append(StringRef(s));
+	}
+	return t;
+}
+
+// Tuples made of other tuples, the way layers build keys out of a prefix, an id and a field
+static Tuple makeNestedTuple(int elements) {
+	Tuple t;
+	for (int i = 0; i < elements; i++) {
+		t.append(Tuple::makeTuple("prefix"_sr, (int64_t)i)).append(makeStringTuple(1, 16, 5)).append(3.5);
+	}
+	return t;
+}
+
+static void bench_tuple_pack_int(benchmark::State& state) {
+	std::vector<int64_t> ints = makeInts(state.range(0));
+	for (auto _ : state) {
+		Tuple t;
+		for (int64_t i : ints) {
+			t.append(i);
+		}
+		benchmark::DoNotOptimize(t.pack());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bench_tuple_unpack_int(benchmark::State& state) {
+	Tuple ints;
+	for (int64_t i : makeInts(state.range(0))) {
+		ints.append(i);
+	}
+	Standalone<StringRef> packed = ints.pack();
+	for (auto _ : state) {
+		Tuple t = Tuple::unpack(packed);
+		int64_t sum = 0;
+		for (size_t i = 0; i < t.size(); i++) {
+			sum += t.getInt(i);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bench_tuple_pack_string(benchmark::State& state) {
+	std::vector<std::string> strs;
+	for (int i = 0; i < 16; i++) {
+		strs.push_back(makeStringTuple(1, state.range(0), state.range(1)).getString(0).toString());
+	}
+	for (auto _ : state) {
+		Tuple t;
+		for (auto const& s : strs) {
+			t.append(StringRef(s));
+		}
+		benchmark::DoNotOptimize(t.pack());
+	}
+	state.SetBytesProcessed(state.iterations() * strs.size() * state.range(0));
+}
+
+static void bench_tuple_unpack_string(benchmark::State& state) {
+	Standalone<StringRef> packed = makeStringTuple(16, state.range(0), state.range(1)).pack();
+	for (auto _ : state) {
+		Tuple t = Tuple::unpack(packed);
+		for (size_t i = 0; i < t.size(); i++) {
+			benchmark::DoNotOptimize(t.getString(i));
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * 16 * state.range(0));
+}
+
+// Decoding every string into one arena, rather than a Standalone each
+static void bench_tuple_unpack_string_arena(benchmark::State& state) {
+	Standalone<StringRef> packed = makeStringTuple(16, state.range(0), state.range(1)).pack();
+	for (auto _ : state) {
+		Tuple t = Tuple::unpack(packed);
+		Arena arena(packed.size());
+		for (size_t i = 0; i < t.size(); i++) {
+			benchmark::DoNotOptimize(t.getString(i, arena));
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * 16 * state.range(0));
+}
+
+static void bench_tuple_pack_nested(benchmark::State& state) {
+	Tuple field = makeStringTuple(1, 16, 5);
+	for (auto _ : state) {
+		Tuple t;
+		for (int i = 0; i < state.range(0); i++) {
+			t.append(Tuple::makeTuple("prefix"_sr, (int64_t)i)).append(field).append(3.5);
+		}
+		benchmark::DoNotOptimize(t.pack());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bench_tuple_unpack_nested(benchmark::State& state) {
+	Standalone<StringRef> packed = makeNestedTuple(state.range(0)).pack();
+	for (auto _ : state) {
+		Tuple t = Tuple::unpack(packed);
+		Arena arena;
+		for (size_t i = 0; i < t.size(); i += 4) {
+			benchmark::DoNotOptimize(t.getString(i, arena));
+			benchmark::DoNotOptimize(t.getInt(i + 1));
+			benchmark::DoNotOptimize(t.getString(i + 2, arena));
+			benchmark::DoNotOptimize(t.getDouble(i + 3));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(bench_tuple_pack_int)->Range(1, 1 << 8);
+BENCHMARK(bench_tuple_unpack_int)->Range(1, 1 << 8);
+BENCHMARK(bench_tuple_pack_string)->ArgsProduct({ benchmark::CreateRange(8, 1 << 14, 8), { 0, 1, 64 } });
+BENCHMARK(bench_tuple_unpack_string)->ArgsProduct({ benchmark::CreateRange(8, 1 << 14, 8), { 0, 1, 64 } });
+BENCHMARK(bench_tuple_unpack_string_arena)->ArgsProduct({ benchmark::CreateRange(8, 1 << 14, 8), { 0, 1, 64 } });
+BENCHMARK(bench_tuple_pack_nested)->Range(1, 1 << 8);
+BENCHMARK(bench_tuple_unpack_nested)->Range(1, 1 << 8);
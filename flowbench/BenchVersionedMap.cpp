@@ -0,0 +1,303 @@
+/*
+ * BenchVersionedMap.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/VersionedMap.h"
+#include "flow/Arena.h"
+#include "flow/DeterministicRandom.h"
+#include "flowbench/GlobalData.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// The storage server's MVCC window is a VersionedMap, a persistent treap with one node per key. These benchmarks
+// compare its point and short range lookups against a std::map, another node per key tree without versioning, and a
+// sorted vector, the lower bound for an index with wide, contiguous nodes.
+enum class IndexType {
+	VersionedMap,
+	StdMap,
+	SortedVector,
+};
+
+static constexpr int keySize = 16;
+static constexpr int keysPerVersion = 1000;
+static constexpr int rangeRows = 10;
+
+static std::vector<KeyRef> getRandomKeys(Arena& arena, int count) {
+	DeterministicRandom random(1);
+	std::vector<KeyRef> keys;
+	keys.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		StringRef key = makeString(keySize, arena);
+		random.randomBytes(mutateString(key), key.size());
+		keys.push_back(key);
+	}
+	return keys;
+}
+
+// Inserts keysPerVersion keys in each version after version, as the storage server does when applying mutations, and
+// returns the last version written
+static Version insertKeys(VersionedMap<KeyRef, int>& map, std::vector<KeyRef> const& keys, Version version) {
+	for (int i = 0; i < keys.size(); ++i) {
+		if (i % keysPerVersion == 0) {
+			map.createNewVersion(++version);
+		}
+		map.insert(keys[i], i);
+	}
+	return version;
+}
+
+template <IndexType indexType>
+struct KeyIndex;
+
+template <>
+struct KeyIndex<IndexType::VersionedMap> {
+	VersionedMap<KeyRef, int> map;
+
+	// Lookups go through nodes updated in place at later versions
+	explicit KeyIndex(std::vector<KeyRef> const& keys) { insertKeys(map, keys, 0); }
+
+	bool lookup(KeyRef key) const { return map.atLatest().lower_bound(key).key() == key; }
+
+	int scan(KeyRef key) const {
+		auto view = map.atLatest();
+		int sum = 0;
+		int rows = 0;
+		for (auto it = view.lower_bound(key); it && rows < rangeRows; ++it, ++rows) {
+			sum += *it;
+		}
+		return sum;
+	}
+};
+
+template <>
+struct KeyIndex<IndexType::StdMap> {
+	std::map<KeyRef, int> map;
+
+	explicit KeyIndex(std::vector<KeyRef> const& keys) {
+		for (int i = 0; i < keys.size(); ++i) {
+			map.emplace(keys[i], i);
+		}
+	}
+
+	bool lookup(KeyRef key) const { return map.lower_bound(key)->first == key; }
+
+	int scan(KeyRef key) const {
+		int sum = 0;
+		int rows = 0;
+		for (auto it = map.lower_bound(key); it != map.end() && rows < rangeRows; ++it, ++rows) {
+			sum += it->second;
+		}
+		return sum;
+	}
+};
+
+template <>
+struct KeyIndex<IndexType::SortedVector> {
+	std::vector<std::pair<KeyRef, int>> entries;
+
+	explicit KeyIndex(std::vector<KeyRef> const& keys) {
+		entries.reserve(keys.size());
+		for (int i = 0; i < keys.size(); ++i) {
+			entries.emplace_back(keys[i], i);
+		}
+		std::sort(entries.begin(), entries.end());
+	}
+
+	std::vector<std::pair<KeyRef, int>>::const_iterator lowerBound(KeyRef key) const {
+		return std::lower_bound(entries.begin(), entries.end(), key, [](auto const& entry, KeyRef const& k) {
+			return entry.first < k;
+		});
+	}
+
+	bool lookup(KeyRef key) const { return lowerBound(key)->first == key; }
+
+	int scan(KeyRef key) const {
+		int sum = 0;
+		int rows = 0;
+		for (auto it = lowerBound(key); it != entries.end() && rows < rangeRows; ++it, ++rows) {
+			sum += it->second;
+		}
+		return sum;
+	}
+};
+
+// Looks up keys present in the index, in random order
+template <IndexType indexType>
+static void bench_versioned_map_lookup(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getRandomKeys(arena, state.range(0));
+	KeyIndex<indexType> index(keys);
+	deterministicRandom()->randomShuffle(keys);
+
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index.lookup(keys[i]));
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Reads the rangeRows entries starting at random keys present in the index
+template <IndexType indexType>
+static void bench_versioned_map_scan(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getRandomKeys(arena, state.range(0));
+	KeyIndex<indexType> index(keys);
+	deterministicRandom()->randomShuffle(keys);
+
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index.scan(keys[i]));
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(rangeRows * static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_versioned_map_lookup, IndexType::VersionedMap)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bench_versioned_map_lookup, IndexType::StdMap)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bench_versioned_map_lookup, IndexType::SortedVector)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bench_versioned_map_scan, IndexType::VersionedMap)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bench_versioned_map_scan, IndexType::StdMap)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bench_versioned_map_scan, IndexType::SortedVector)->Range(1 << 10, 1 << 22);
+
+// Inserts keys of the given shape into an empty map
+template <KeyShape shape>
+static void bench_versioned_map_insert(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), shape);
+	VersionedMap<KeyRef, int> map;
+	for (auto _ : state) {
+		insertKeys(map, keys, 0);
+		state.PauseTiming();
+		map = VersionedMap<KeyRef, int>();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+// Erases every key of a map, keysPerVersion keys in each version
+template <KeyShape shape>
+static void bench_versioned_map_erase(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), shape);
+	for (auto _ : state) {
+		state.PauseTiming();
+		VersionedMap<KeyRef, int> map;
+		Version version = insertKeys(map, keys, 0);
+		deterministicRandom()->randomShuffle(keys);
+		state.ResumeTiming();
+		for (int i = 0; i < keys.size(); ++i) {
+			if (i % keysPerVersion == 0) {
+				map.createNewVersion(++version);
+			}
+			map.erase(keys[i]);
+		}
+		state.PauseTiming();
+		map = VersionedMap<KeyRef, int>();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+// Looks up keys at random versions of a map in which every key has been written state.range(1) times, the way reads
+// are spread over the storage server's MVCC window
+template <KeyShape shape>
+static void bench_versioned_map_lookup_at_version(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), shape);
+	VersionedMap<KeyRef, int> map;
+	Version version = 0;
+	for (int i = 0; i < state.range(1); ++i) {
+		version = insertKeys(map, keys, version);
+	}
+	std::vector<Version> versions;
+	for (int i = 0; i < keys.size(); ++i) {
+		versions.push_back(deterministicRandom()->randomInt64(map.getOldestVersion() + 1, version + 1));
+	}
+
+	int i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.at(versions[i]).lower_bound(keys[i]));
+		if (++i == keys.size()) {
+			i = 0;
+		}
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Iterates over every entry of the latest version
+template <KeyShape shape>
+static void bench_versioned_map_iterate(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), shape);
+	VersionedMap<KeyRef, int> map;
+	insertKeys(map, keys, 0);
+
+	for (auto _ : state) {
+		auto view = map.atLatest();
+		int sum = 0;
+		for (auto it = view.begin(); it; ++it) {
+			sum += *it;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(keys.size() * static_cast<long>(state.iterations()));
+}
+
+// Forgets all but the latest version of a map in which every key has been written state.range(1) times, freeing the
+// nodes only older versions reached
+template <KeyShape shape>
+static void bench_versioned_map_forget_versions(benchmark::State& state) {
+	Arena arena;
+	std::vector<KeyRef> keys = getKeys(arena, state.range(0), shape);
+	for (auto _ : state) {
+		state.PauseTiming();
+		VersionedMap<KeyRef, int> map;
+		Version version = 0;
+		for (int i = 0; i < state.range(1); ++i) {
+			version = insertKeys(map, keys, version);
+		}
+		state.ResumeTiming();
+		map.forgetVersionsBefore(version);
+		state.PauseTiming();
+		map = VersionedMap<KeyRef, int>();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(keys.size() * (state.range(1) - 1) * static_cast<long>(state.iterations()));
+}
+
+#define VERSIONED_MAP_KEY_SHAPE_BENCHMARKS(shape)                                                                      \
+	BENCHMARK_TEMPLATE(bench_versioned_map_insert, shape)->Range(1 << 10, 1 << 20);                                    \
+	BENCHMARK_TEMPLATE(bench_versioned_map_erase, shape)->Range(1 << 10, 1 << 20);                                     \
+	BENCHMARK_TEMPLATE(bench_versioned_map_lookup_at_version, shape)->ArgsProduct({ { 1 << 10, 1 << 16, 1 << 20 },     \
+	                                                                                { 1, 4, 16 } });                   \
+	BENCHMARK_TEMPLATE(bench_versioned_map_iterate, shape)->Range(1 << 10, 1 << 20);                                   \
+	BENCHMARK_TEMPLATE(bench_versioned_map_forget_versions, shape)->ArgsProduct({ { 1 << 10, 1 << 16 }, { 2, 8 } })
+
+VERSIONED_MAP_KEY_SHAPE_BENCHMARKS(KeyShape::Random);
+VERSIONED_MAP_KEY_SHAPE_BENCHMARKS(KeyShape::SharedPrefix);
+VERSIONED_MAP_KEY_SHAPE_BENCHMARKS(KeyShape::Tuple);
@@ -18,9 +18,12 @@
  * limitations under the License.
  */
 
-#include "fdbclient/FDBTypes.h"
+#include "flowbench/GlobalData.h"
+#include "fdbclient/Tuple.h"
 #include "flow/IRandom.h"
 
+#include <algorithm>
+
 static constexpr size_t globalDataSize = 1 << 20;
 static uint8_t* globalData = nullptr;
 
@@ -42,3 +45,36 @@ KeyRef getKey(size_t keySize) {
 	ASSERT(keySize);
 	return KeyRef(globalData, keySize);
 }
+
+static KeyRef makeKey(Arena& arena, KeyShape shape) {
+	switch (shape) {
+	case KeyShape::Random: {
+		StringRef key = makeString(16, arena);
+		deterministicRandom()->randomBytes(mutateString(key), key.size());
+		return key;
+	}
+	case KeyShape::SharedPrefix: {
+		StringRef key = makeString(40, arena);
+		memset(mutateString(key), 'p', 32);
+		deterministicRandom()->randomBytes(mutateString(key) + 32, 8);
+		return key;
+	}
+	case KeyShape::Tuple:
+		return KeyRef(arena,
+		              Tuple::makeTuple("users"_sr, deterministicRandom()->randomInt64(0, 1LL << 40), "email"_sr).pack());
+	}
+	UNREACHABLE();
+}
+
+std::vector<KeyRef> getKeys(Arena& arena, int count, KeyShape shape) {
+	std::vector<KeyRef> keys;
+	while (keys.size() < count) {
+		while (keys.size() < count) {
+			keys.push_back(makeKey(arena, shape));
+		}
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	}
+	deterministicRandom()->randomShuffle(keys);
+	return keys;
+}
@@ -28,6 +28,16 @@
 KeyValueRef getKV(size_t keySize, size_t valueSize);
 KeyRef getKey(size_t keySize);
 
+// The shapes of keys that index structures see
+enum class KeyShape {
+	Random, // 16 random bytes
+	SharedPrefix, // A 32 byte prefix common to all keys followed by 8 random bytes
+	Tuple, // Tuple encoded (string, integer, string) keys, as layers build them
+};
+
+// Returns count distinct keys of the given shape, in random order, allocated in arena
+std::vector<KeyRef> getKeys(Arena& arena, int count, KeyShape shape);
+
 // Pre-generate a vector of T using a lambda then return them
 // via next() one by one with wrap-around
 template <typename T>